@@ -1,4 +1,5 @@
 #include "base64.h"
+#include "module_hash.h"
 
 #include <jni.h>
 #include <jvmti.h>
@@ -43,7 +44,7 @@ struct ModuleInfo {
 	std::string path;
 	std::string hash;
 	std::string signerName;
-	std::string importedModules;
+	std::string encodedImports;
 };
 
 using PtrJNI_GetCreatedJavaVMs = jint(JNICALL*)(JavaVM**, jsize, jsize*);
@@ -62,6 +63,7 @@ static std::unordered_set<std::string> g_knownModules;
 static std::mutex g_knownModulesMutex;
 static std::unordered_set<std::string> g_seenHashes;
 static std::mutex g_seenHashesMutex;
+static liblogger::ModuleDigestCache g_moduleDigestCache;
 
 static std::thread g_initializationThread;
 static std::thread g_scannerThread;
@@ -329,224 +331,50 @@ void LogStatusToMinecraft(const std::string& message) {
 	LogToMinecraft(std::string("[LibLogger] ") + message);
 }
 
-static bool IsElfFile(const std::string& filePath) {
-	std::ifstream file(filePath, std::ios::binary);
-	if (!file.is_open()) {
-		return false;
-	}
-
-	char header[SELFMAG];
-	file.read(header, sizeof(header));
-	return file.good() || file.gcount() == static_cast<std::streamsize>(sizeof(header))
-		? std::memcmp(header, ELFMAG, SELFMAG) == 0
-		: false;
-}
-
-static std::string CalculateSHA512(const std::string& filePath) {
-	std::ifstream file(filePath, std::ios::binary);
-	if (!file.is_open()) {
-		return "[Hash Failed: File Open]";
-	}
-
-	SHA512_CTX sha512;
-	SHA512_Init(&sha512);
-
-	char buffer[4096];
-	while (file.read(buffer, sizeof(buffer))) {
-		SHA512_Update(&sha512, buffer, file.gcount());
-	}
-	if (file.gcount() > 0) {
-		SHA512_Update(&sha512, buffer, file.gcount());
-	}
-
-	unsigned char hash[SHA512_DIGEST_LENGTH];
-	SHA512_Final(hash, &sha512);
-
-	static constexpr char kHexDigits[] = "0123456789abcdef";
-	std::string result;
-	result.reserve(SHA512_DIGEST_LENGTH * 2);
-	for (int index = 0; index < SHA512_DIGEST_LENGTH; ++index) {
-		const unsigned char byte = hash[index];
-		result.push_back(kHexDigits[byte >> 4]);
-		result.push_back(kHexDigits[byte & 0x0F]);
-	}
-
-	return result;
-}
-
 static std::string GetSignerName() {
 	return "[Unsigned, Linux]";
 }
 
-static std::string GetImportedModules(const std::string& filePath) {
-#if defined(__x86_64__) || defined(__aarch64__)
-	using Elf_Ehdr_Local = Elf64_Ehdr;
-	using Elf_Phdr_Local = Elf64_Phdr;
-	using Elf_Dyn_Local = Elf64_Dyn;
-	using Elf_Addr_Local = Elf64_Addr;
-	using Elf_Off_Local = Elf64_Off;
-#elif defined(__i386__) || defined(__arm__)
-	using Elf_Ehdr_Local = Elf32_Ehdr;
-	using Elf_Phdr_Local = Elf32_Phdr;
-	using Elf_Dyn_Local = Elf32_Dyn;
-	using Elf_Addr_Local = Elf32_Addr;
-	using Elf_Off_Local = Elf32_Off;
-#else
-#error "Unsupported architecture for ELF parsing"
-#endif
-
-	std::ifstream file(filePath, std::ios::binary);
-	if (!file) {
-		return "";
-	}
-
-	file.seekg(0, std::ios::end);
-	if (file.tellg() < static_cast<std::streamoff>(sizeof(Elf_Ehdr_Local))) {
-		return "";
-	}
-
-	file.seekg(0, std::ios::beg);
-	Elf_Ehdr_Local elfHeader;
-	file.read(reinterpret_cast<char*>(&elfHeader), sizeof(elfHeader));
-	if (file.gcount() != static_cast<std::streamsize>(sizeof(elfHeader)) || std::memcmp(elfHeader.e_ident, ELFMAG, SELFMAG) != 0) {
-		return "";
-	}
-
-	if (elfHeader.e_phoff == 0 || elfHeader.e_phnum == 0) {
-		return "";
-	}
-
-	file.seekg(elfHeader.e_phoff, std::ios::beg);
-	std::vector<Elf_Phdr_Local> programHeaders(elfHeader.e_phnum);
-	file.read(reinterpret_cast<char*>(programHeaders.data()), elfHeader.e_phentsize * elfHeader.e_phnum);
-
-	const Elf_Phdr_Local* dynamicHeader = nullptr;
-	for (const auto& header : programHeaders) {
-		if (header.p_type == PT_DYNAMIC) {
-			dynamicHeader = &header;
-			break;
-		}
-	}
-	if (!dynamicHeader) {
-		return "";
-	}
-
-	file.seekg(dynamicHeader->p_offset, std::ios::beg);
-	std::vector<Elf_Dyn_Local> dynamicEntries(dynamicHeader->p_filesz / sizeof(Elf_Dyn_Local));
-	file.read(reinterpret_cast<char*>(dynamicEntries.data()), dynamicHeader->p_filesz);
-
-	Elf_Addr_Local stringTableAddress = 0;
-	for (const auto& entry : dynamicEntries) {
-		if (entry.d_tag == DT_STRTAB) {
-			stringTableAddress = entry.d_un.d_ptr;
-			break;
-		}
-	}
-	if (stringTableAddress == 0) {
-		return "";
-	}
-
-	Elf_Off_Local stringTableOffset = 0;
-	for (const auto& header : programHeaders) {
-		if (header.p_type == PT_LOAD && stringTableAddress >= header.p_vaddr && stringTableAddress < header.p_vaddr + header.p_memsz) {
-			stringTableOffset = (stringTableAddress - header.p_vaddr) + header.p_offset;
-			break;
-		}
-	}
-	if (stringTableOffset == 0) {
-		return "";
-	}
-
-	std::stringstream result;
-	bool firstModule = true;
-	for (const auto& entry : dynamicEntries) {
-		if (entry.d_tag != DT_NEEDED) {
-			continue;
-		}
-
-		file.seekg(stringTableOffset + entry.d_un.d_val, std::ios::beg);
-		std::string libraryName;
-		std::getline(file, libraryName, '\0');
-		if (libraryName.empty()) {
-			continue;
-		}
-
-		if (!firstModule) {
-			result << ',';
-		}
-		result << libraryName;
-		firstModule = false;
-	}
-
-	return result.str();
-}
-
-static ModuleInfo AnalyzeModule(const std::string& modulePath) {
-	ModuleInfo info;
-	info.path = modulePath;
-	info.hash = CalculateSHA512(modulePath);
-	info.signerName = GetSignerName();
-	info.importedModules = GetImportedModules(modulePath);
-	return info;
-}
-
-static std::string EncodeImportsList(const std::string& imports) {
-	if (imports.empty()) {
-		return "";
-	}
-
-	std::stringstream input(imports);
-	std::stringstream output;
-	std::string item;
-	bool firstItem = true;
-
-	while (std::getline(input, item, ',')) {
-		const size_t start = item.find_first_not_of(" \t");
-		if (start == std::string::npos) {
-			continue;
-		}
-
-		const size_t end = item.find_last_not_of(" \t");
-		const std::string trimmed = item.substr(start, end - start + 1);
-		if (!firstItem) {
-			output << ',';
-		}
-		output << Base64Encode(trimmed);
-		firstItem = false;
-	}
-
-	return output.str();
-}
-
 static void LogModuleToMinecraft(const ModuleInfo& info) {
 	if (g_fairplayDetected.load()) {
 		return;
 	}
 
 	const std::string formattedMessage =
-		"moduleLoaded " + Base64Encode(info.path) + " " + info.hash + " " + Base64Encode(info.signerName) + " " + EncodeImportsList(info.importedModules);
+		"moduleLoaded " + Base64Encode(info.path) + " " + info.hash + " " + Base64Encode(info.signerName) + " " + info.encodedImports;
 	LogToMinecraft(formattedMessage);
 }
 
-static void ProcessModulePath(const std::string& modulePath) {
-	if (modulePath.empty() || g_fairplayDetected.load() || !IsElfFile(modulePath)) {
+static void ProcessModulePaths(const std::vector<std::string>& modulePaths) {
+	if (modulePaths.empty() || g_fairplayDetected.load()) {
 		return;
 	}
 
-	const std::string hash = CalculateSHA512(modulePath);
-	{
-		std::lock_guard<std::mutex> lock(g_seenHashesMutex);
-		if (!g_seenHashes.insert(hash).second) {
+	const std::vector<liblogger::ModuleDigest> digests = liblogger::HashModuleFiles(modulePaths, g_moduleDigestCache);
+	for (size_t index = 0; index < modulePaths.size(); ++index) {
+		if (g_fairplayDetected.load()) {
 			return;
 		}
-	}
 
-	ModuleInfo info;
-	info.path = modulePath;
-	info.hash = hash;
-	info.signerName = GetSignerName();
-	info.importedModules = GetImportedModules(modulePath);
-	LogModuleToMinecraft(info);
+		const liblogger::ModuleDigest& digest = digests[index];
+		if (!digest.isElf) {
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_seenHashesMutex);
+			if (!g_seenHashes.insert(digest.sha512Hex).second) {
+				continue;
+			}
+		}
+
+		ModuleInfo info;
+		info.path = modulePaths[index];
+		info.hash = digest.sha512Hex;
+		info.signerName = GetSignerName();
+		info.encodedImports = digest.encodedImports;
+		LogModuleToMinecraft(info);
+	}
 }
 
 std::string GetProcessUID(pid_t pid) {
@@ -614,14 +442,14 @@ static void RecordBaselineModules() {
 		return 0;
 	}, &baselineModules);
 
-	std::lock_guard<std::mutex> lock(g_knownModulesMutex);
-	for (const auto& modulePath : baselineModules) {
-		g_knownModules.insert(modulePath);
+	{
+		std::lock_guard<std::mutex> lock(g_knownModulesMutex);
+		for (const auto& modulePath : baselineModules) {
+			g_knownModules.insert(modulePath);
+		}
 	}
 
-	for (const auto& modulePath : baselineModules) {
-		ProcessModulePath(modulePath);
-	}
+	ProcessModulePaths(baselineModules);
 }
 
 void WatchdogMain(pid_t parentPid) {
@@ -754,9 +582,7 @@ void ScannerThreadMain() {
 			}
 		}
 
-		for (const auto& modulePath : newModules) {
-			ProcessModulePath(modulePath);
-		}
+		ProcessModulePaths(newModules);
 	}
 }
 
@@ -871,6 +697,7 @@ void Cleanup() {
 		std::lock_guard<std::mutex> lock(g_seenHashesMutex);
 		g_seenHashes.clear();
 	}
+	g_moduleDigestCache.Clear();
 
 	g_fairplayDetected.store(false);
 	g_initializationStarted.store(false);
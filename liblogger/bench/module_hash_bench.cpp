@@ -0,0 +1,211 @@
+// Benchmarks the Linux scanner's module hashing on a synthetic module set.
+//
+// Build and run with ./build-bench.sh (Linux only). The set mixes small and large ELF-tagged files
+// plus symlinked aliases, roughly the shape of a modded JVM's loaded .so list, and compares the
+// old ifstream path against the mapped, pooled and cached paths in module_hash.h.
+
+#include "../module_hash.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+std::string LegacyCalculateSHA512(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open()) {
+		return "[Hash Failed: File Open]";
+	}
+
+	SHA512_CTX sha512;
+	SHA512_Init(&sha512);
+
+	char buffer[4096];
+	while (file.read(buffer, sizeof(buffer))) {
+		SHA512_Update(&sha512, buffer, file.gcount());
+	}
+	if (file.gcount() > 0) {
+		SHA512_Update(&sha512, buffer, file.gcount());
+	}
+
+	unsigned char hash[SHA512_DIGEST_LENGTH];
+	SHA512_Final(hash, &sha512);
+	return liblogger::FormatSHA512Hex(hash);
+}
+
+bool LegacyIsElfFile(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	char header[SELFMAG];
+	file.read(header, sizeof(header));
+	return file.gcount() == static_cast<std::streamsize>(sizeof(header)) && std::memcmp(header, ELFMAG, SELFMAG) == 0;
+}
+
+struct SyntheticModuleSet {
+	std::string directory;
+	std::vector<std::string> paths;
+	std::vector<std::string> files;
+	uint64_t uniqueBytes = 0;
+	uint64_t listedBytes = 0;
+};
+
+bool CreateModuleSet(size_t moduleCount, SyntheticModuleSet& set) {
+	char directoryTemplate[] = "/tmp/liblogger_hash_bench_XXXXXX";
+	if (!mkdtemp(directoryTemplate)) {
+		std::perror("mkdtemp");
+		return false;
+	}
+	set.directory = directoryTemplate;
+
+	std::mt19937_64 random(0x5EEDull);
+	std::vector<unsigned char> contents;
+	for (size_t index = 0; index < moduleCount; ++index) {
+		const std::string path = set.directory + "/lib" + std::to_string(index) + ".so";
+		const bool alias = index > 0 && index % 5 == 0;
+		if (alias) {
+			// Same file reached under a second name, as with versioned soname symlinks.
+			const std::string& target = set.files[random() % set.files.size()];
+			if (symlink(target.c_str(), path.c_str()) != 0) {
+				std::perror("symlink");
+				return false;
+			}
+			struct stat fileStat = {};
+			stat(path.c_str(), &fileStat);
+			set.listedBytes += static_cast<uint64_t>(fileStat.st_size);
+			set.paths.push_back(path);
+			continue;
+		}
+
+		// Mostly small libraries with a long tail of large natives (16 KiB .. 8 MiB).
+		const size_t size = static_cast<size_t>(16 * 1024) << (random() % 10);
+		contents.resize(size);
+		for (size_t offset = 0; offset < size; offset += 8) {
+			const uint64_t value = random();
+			std::memcpy(contents.data() + offset, &value, (std::min)(sizeof(value), size - offset));
+		}
+		std::memcpy(contents.data(), ELFMAG, SELFMAG);
+
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		if (!file || std::fwrite(contents.data(), 1, size, file) != size) {
+			std::perror("write");
+			if (file) {
+				std::fclose(file);
+			}
+			return false;
+		}
+		std::fclose(file);
+
+		set.files.push_back(path);
+		set.paths.push_back(path);
+		set.uniqueBytes += size;
+		set.listedBytes += size;
+	}
+	return true;
+}
+
+void RemoveModuleSet(const SyntheticModuleSet& set) {
+	for (const std::string& path : set.paths) {
+		unlink(path.c_str());
+	}
+	if (!set.directory.empty()) {
+		rmdir(set.directory.c_str());
+	}
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Report(const char* label, double milliseconds, uint64_t bytes, double baselineMs) {
+	const double mibPerSecond = milliseconds > 0.0 ? (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (milliseconds / 1000.0) : 0.0;
+	std::printf("%-28s %9.2f ms %9.1f MiB/s %6.2fx\n", label, milliseconds, mibPerSecond, milliseconds > 0.0 ? baselineMs / milliseconds : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	size_t moduleCount = 300;
+	unsigned workers = 0;
+	for (int index = 1; index < argc; ++index) {
+		if (std::strcmp(argv[index], "--modules") == 0 && index + 1 < argc) {
+			moduleCount = static_cast<size_t>(std::strtoul(argv[++index], nullptr, 10));
+		} else if (std::strcmp(argv[index], "--workers") == 0 && index + 1 < argc) {
+			workers = static_cast<unsigned>(std::strtoul(argv[++index], nullptr, 10));
+		} else {
+			std::fprintf(stderr, "Usage: %s [--modules N] [--workers N]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (workers == 0) {
+		workers = (std::max)(1u, std::thread::hardware_concurrency() / 2);
+	}
+
+	SyntheticModuleSet set;
+	if (moduleCount == 0 || !CreateModuleSet(moduleCount, set)) {
+		RemoveModuleSet(set);
+		return 1;
+	}
+	std::printf("%zu module paths, %zu unique files, %.1f MiB unique, %u worker(s)\n", set.paths.size(), set.files.size(),
+	            static_cast<double>(set.uniqueBytes) / (1024.0 * 1024.0), workers);
+
+	// Warm the page cache so every variant measures hashing rather than the first disk read.
+	for (const std::string& path : set.files) {
+		LegacyCalculateSHA512(path);
+	}
+
+	std::vector<std::string> legacyDigests;
+	const auto legacyStart = std::chrono::steady_clock::now();
+	for (const std::string& path : set.paths) {
+		legacyDigests.push_back(LegacyIsElfFile(path) ? LegacyCalculateSHA512(path) : std::string());
+	}
+	const double legacyMs = ElapsedMs(legacyStart);
+
+	liblogger::ModuleDigestCache serialCache;
+	const auto serialStart = std::chrono::steady_clock::now();
+	const std::vector<liblogger::ModuleDigest> serialDigests = liblogger::HashModuleFiles(set.paths, serialCache, 1);
+	const double serialMs = ElapsedMs(serialStart);
+
+	liblogger::ModuleDigestCache parallelCache;
+	liblogger::ModuleHashBatchStats parallelStats;
+	const auto parallelStart = std::chrono::steady_clock::now();
+	const std::vector<liblogger::ModuleDigest> parallelDigests = liblogger::HashModuleFiles(set.paths, parallelCache, workers, &parallelStats);
+	const double parallelMs = ElapsedMs(parallelStart);
+
+	liblogger::ModuleHashBatchStats warmStats;
+	const auto warmStart = std::chrono::steady_clock::now();
+	const std::vector<liblogger::ModuleDigest> warmDigests = liblogger::HashModuleFiles(set.paths, parallelCache, workers, &warmStats);
+	const double warmMs = ElapsedMs(warmStart);
+
+	size_t mismatches = 0;
+	for (size_t index = 0; index < set.paths.size(); ++index) {
+		const std::string& expected = legacyDigests[index];
+		if (serialDigests[index].sha512Hex != expected || parallelDigests[index].sha512Hex != expected || warmDigests[index].sha512Hex != expected) {
+			++mismatches;
+		}
+	}
+
+	std::printf("%-28s %12s %15s %7s\n", "variant", "time", "throughput", "speedup");
+	Report("ifstream, sequential", legacyMs, set.listedBytes, legacyMs);
+	Report("mmap + dedupe, 1 worker", serialMs, set.listedBytes, legacyMs);
+	Report("mmap + dedupe, pooled", parallelMs, set.listedBytes, legacyMs);
+	Report("identity cache, warm", warmMs, set.listedBytes, legacyMs);
+	std::printf("hashed %zu files (%zu deduplicated), warm pass: %zu cache hits, %zu hashed\n", parallelStats.filesHashed, parallelStats.cacheHits,
+	            warmStats.cacheHits, warmStats.filesHashed);
+
+	RemoveModuleSet(set);
+	if (mismatches != 0) {
+		std::fprintf(stderr, "%zu digest mismatch(es) against the ifstream reference\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
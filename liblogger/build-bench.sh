@@ -0,0 +1,23 @@
+#!/bin/bash
+set -euo pipefail
+
+# Builds and runs the module hashing benchmark on the host. Extra arguments are passed to the
+# benchmark, e.g. ./build-bench.sh --modules 600 --workers 4
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+OUTPUT_DIR="${SCRIPT_DIR}/dist/bench"
+PKG_CONFIG_BIN="${PKG_CONFIG_BIN:-pkg-config}"
+CXX_BIN="${CXX:-$(command -v clang++ || command -v g++ || command -v c++)}"
+
+OPENSSL_FLAGS=(-lcrypto)
+if command -v "${PKG_CONFIG_BIN}" >/dev/null 2>&1 && "${PKG_CONFIG_BIN}" --exists openssl; then
+  read -r -a OPENSSL_FLAGS <<< "$("${PKG_CONFIG_BIN}" --cflags --libs openssl) -lcrypto"
+fi
+
+mkdir -p "${OUTPUT_DIR}"
+"${CXX_BIN}" -std=c++17 -O2 -pthread -Wno-deprecated-declarations \
+  -o "${OUTPUT_DIR}/module_hash_bench" \
+  "${SCRIPT_DIR}/bench/module_hash_bench.cpp" \
+  "${OPENSSL_FLAGS[@]}"
+
+"${OUTPUT_DIR}/module_hash_bench" "$@"
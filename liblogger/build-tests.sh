@@ -0,0 +1,23 @@
+#!/bin/bash
+set -euo pipefail
+
+# Builds and runs the Linux scanner unit tests on the host. Extra arguments are passed to the test
+# binary, e.g. ./build-tests.sh --run reads_32bit_needed_entries
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+OUTPUT_DIR="${SCRIPT_DIR}/dist/tests"
+PKG_CONFIG_BIN="${PKG_CONFIG_BIN:-pkg-config}"
+CXX_BIN="${CXX:-$(command -v clang++ || command -v g++ || command -v c++)}"
+
+OPENSSL_FLAGS=(-lcrypto)
+if command -v "${PKG_CONFIG_BIN}" >/dev/null 2>&1 && "${PKG_CONFIG_BIN}" --exists openssl; then
+  read -r -a OPENSSL_FLAGS <<< "$("${PKG_CONFIG_BIN}" --cflags --libs openssl) -lcrypto"
+fi
+
+mkdir -p "${OUTPUT_DIR}"
+"${CXX_BIN}" -std=c++17 -O1 -g -pthread -Wall -Wextra -Wno-deprecated-declarations \
+  -o "${OUTPUT_DIR}/elf_module_view_tests" \
+  "${SCRIPT_DIR}/tests/elf_module_view_tests.cpp" \
+  "${OPENSSL_FLAGS[@]}"
+
+"${OUTPUT_DIR}/elf_module_view_tests" "$@"
@@ -0,0 +1,270 @@
+#pragma once
+
+// Read-only view of one ELF module for the Linux scanner. The file is opened and mapped once; the
+// same bytes feed the magic check, the digest and the DT_NEEDED walk, and import names are handed
+// out as string_views into the mapping rather than copied strings.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace liblogger {
+
+class ElfModuleView {
+public:
+	ElfModuleView() = default;
+	ElfModuleView(const ElfModuleView&) = delete;
+	ElfModuleView& operator=(const ElfModuleView&) = delete;
+	~ElfModuleView() { Reset(); }
+
+	// Maps an already opened file. Falls back to reading it into memory when it cannot be mapped
+	// (special files, exhausted address space on 32-bit builds). The descriptor can be closed after.
+	bool MapFile(int fd, uint64_t size) {
+		Reset();
+		if (size == 0 || size > static_cast<uint64_t>(SIZE_MAX)) {
+			return false;
+		}
+
+		void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED) {
+			madvise(mapping, static_cast<size_t>(size), MADV_SEQUENTIAL);
+			m_mapping = mapping;
+			m_data = static_cast<const unsigned char*>(mapping);
+			m_size = static_cast<size_t>(size);
+			return true;
+		}
+
+		m_buffer.resize(static_cast<size_t>(size));
+		size_t offset = 0;
+		while (offset < m_buffer.size()) {
+			const ssize_t bytesRead = pread(fd, m_buffer.data() + offset, m_buffer.size() - offset, static_cast<off_t>(offset));
+			if (bytesRead <= 0) {
+				break;
+			}
+			offset += static_cast<size_t>(bytesRead);
+		}
+		m_buffer.resize(offset);
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+		return m_size != 0;
+	}
+
+	bool Open(const char* path) {
+		Reset();
+		const int fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return false;
+		}
+
+		struct stat fileStat = {};
+		const bool mapped = fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && MapFile(fd, static_cast<uint64_t>(fileStat.st_size));
+		close(fd);
+		return mapped;
+	}
+
+	// Views caller-owned bytes, e.g. an in-memory fixture. The bytes must outlive the view.
+	void AssignMemory(const unsigned char* data, size_t size) {
+		Reset();
+		m_data = data;
+		m_size = size;
+	}
+
+	void Reset() {
+		if (m_mapping) {
+			munmap(m_mapping, m_size);
+			m_mapping = nullptr;
+		}
+		m_buffer.clear();
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	const unsigned char* Data() const { return m_data; }
+	size_t Size() const { return m_size; }
+
+	bool IsElf() const { return m_size >= SELFMAG && std::memcmp(m_data, ELFMAG, SELFMAG) == 0; }
+
+	// Appends the DT_NEEDED names in dynamic-section order. Returns false for anything that is not a
+	// well-formed native-endian ELF32/ELF64 file with a dynamic string table; every offset is checked
+	// against the file size, so truncated or hostile modules cannot read past the view.
+	bool CollectNeededModules(std::vector<std::string_view>& names) const {
+		if (!IsElf() || m_size < EI_NIDENT || m_data[EI_DATA] != NativeDataEncoding()) {
+			return false;
+		}
+
+		switch (m_data[EI_CLASS]) {
+		case ELFCLASS64:
+			return CollectNeededModulesFor<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(names);
+		case ELFCLASS32:
+			return CollectNeededModulesFor<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(names);
+		default:
+			return false;
+		}
+	}
+
+private:
+	static unsigned char NativeDataEncoding() {
+		const uint16_t probe = 1;
+		unsigned char firstByte = 0;
+		std::memcpy(&firstByte, &probe, 1);
+		return firstByte == 1 ? ELFDATA2LSB : ELFDATA2MSB;
+	}
+
+	template <typename T>
+	bool ReadAt(uint64_t offset, T& value) const {
+		if (offset > m_size || m_size - offset < sizeof(T)) {
+			return false;
+		}
+		std::memcpy(&value, m_data + offset, sizeof(T));
+		return true;
+	}
+
+	template <typename Ehdr, typename Phdr, typename Dyn>
+	bool CollectNeededModulesFor(std::vector<std::string_view>& names) const {
+		Ehdr header;
+		if (!ReadAt(0, header) || header.e_phoff == 0 || header.e_phnum == 0 || header.e_phentsize < sizeof(Phdr)) {
+			return false;
+		}
+
+		const uint64_t programHeaderBytes = static_cast<uint64_t>(header.e_phentsize) * header.e_phnum;
+		if (header.e_phoff > m_size || m_size - header.e_phoff < programHeaderBytes) {
+			return false;
+		}
+
+		Phdr dynamicHeader = {};
+		bool hasDynamic = false;
+		for (uint64_t index = 0; index < header.e_phnum; ++index) {
+			Phdr programHeader;
+			ReadAt(header.e_phoff + index * header.e_phentsize, programHeader);
+			if (programHeader.p_type == PT_DYNAMIC) {
+				dynamicHeader = programHeader;
+				hasDynamic = true;
+				break;
+			}
+		}
+		if (!hasDynamic || dynamicHeader.p_offset > m_size || m_size - dynamicHeader.p_offset < dynamicHeader.p_filesz) {
+			return false;
+		}
+
+		const uint64_t dynamicCount = dynamicHeader.p_filesz / sizeof(Dyn);
+		uint64_t stringTableAddress = 0;
+		uint64_t stringTableSize = 0;
+		for (uint64_t index = 0; index < dynamicCount; ++index) {
+			Dyn entry;
+			ReadAt(dynamicHeader.p_offset + index * sizeof(Dyn), entry);
+			if (entry.d_tag == DT_NULL) {
+				break;
+			}
+			if (entry.d_tag == DT_STRTAB && stringTableAddress == 0) {
+				stringTableAddress = entry.d_un.d_ptr;
+			} else if (entry.d_tag == DT_STRSZ) {
+				stringTableSize = entry.d_un.d_val;
+			}
+		}
+		if (stringTableAddress == 0) {
+			return false;
+		}
+
+		uint64_t stringTableOffset = 0;
+		for (uint64_t index = 0; index < header.e_phnum; ++index) {
+			Phdr programHeader;
+			ReadAt(header.e_phoff + index * header.e_phentsize, programHeader);
+			if (programHeader.p_type == PT_LOAD && stringTableAddress >= programHeader.p_vaddr &&
+				stringTableAddress - programHeader.p_vaddr < programHeader.p_filesz) {
+				stringTableOffset = (stringTableAddress - programHeader.p_vaddr) + programHeader.p_offset;
+				break;
+			}
+		}
+		if (stringTableOffset == 0 || stringTableOffset >= m_size) {
+			return false;
+		}
+
+		uint64_t stringTableEnd = m_size;
+		if (stringTableSize != 0 && stringTableSize < m_size - stringTableOffset) {
+			stringTableEnd = stringTableOffset + stringTableSize;
+		}
+
+		for (uint64_t index = 0; index < dynamicCount; ++index) {
+			Dyn entry;
+			ReadAt(dynamicHeader.p_offset + index * sizeof(Dyn), entry);
+			if (entry.d_tag == DT_NULL) {
+				break;
+			}
+			if (entry.d_tag != DT_NEEDED || entry.d_un.d_val >= stringTableEnd - stringTableOffset) {
+				continue;
+			}
+
+			const char* name = reinterpret_cast<const char*>(m_data + stringTableOffset + entry.d_un.d_val);
+			const size_t maxLength = static_cast<size_t>(stringTableEnd - stringTableOffset - entry.d_un.d_val);
+			const void* terminator = std::memchr(name, '\0', maxLength);
+			if (!terminator) {
+				continue;
+			}
+
+			const size_t length = static_cast<size_t>(static_cast<const char*>(terminator) - name);
+			if (length != 0) {
+				names.emplace_back(name, length);
+			}
+		}
+		return true;
+	}
+
+	void* m_mapping = nullptr;
+	std::vector<unsigned char> m_buffer;
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+inline void AppendBase64(std::string& output, std::string_view input) {
+	static constexpr char kEncodingTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(input.data());
+	const size_t length = input.size();
+	size_t index = 0;
+	output.reserve(output.size() + 4 * ((length + 2) / 3));
+	for (; index + 2 < length; index += 3) {
+		output.push_back(kEncodingTable[bytes[index] >> 2]);
+		output.push_back(kEncodingTable[((bytes[index] & 0x03) << 4) | (bytes[index + 1] >> 4)]);
+		output.push_back(kEncodingTable[((bytes[index + 1] & 0x0F) << 2) | (bytes[index + 2] >> 6)]);
+		output.push_back(kEncodingTable[bytes[index + 2] & 0x3F]);
+	}
+	if (index < length) {
+		output.push_back(kEncodingTable[bytes[index] >> 2]);
+		if (index + 1 == length) {
+			output.push_back(kEncodingTable[(bytes[index] & 0x03) << 4]);
+			output.push_back('=');
+		} else {
+			output.push_back(kEncodingTable[((bytes[index] & 0x03) << 4) | (bytes[index + 1] >> 4)]);
+			output.push_back(kEncodingTable[(bytes[index + 1] & 0x0F) << 2]);
+		}
+		output.push_back('=');
+	}
+}
+
+// Comma-separated base64 of each import name, the moduleLoaded wire format. Names are trimmed of
+// spaces and tabs and empty names are skipped, matching the old comma-joined round trip.
+inline void AppendEncodedImports(std::string& output, const std::vector<std::string_view>& names) {
+	bool firstItem = true;
+	for (std::string_view name : names) {
+		const size_t start = name.find_first_not_of(" \t");
+		if (start == std::string_view::npos) {
+			continue;
+		}
+		const size_t end = name.find_last_not_of(" \t");
+		if (!firstItem) {
+			output.push_back(',');
+		}
+		AppendBase64(output, name.substr(start, end - start + 1));
+		firstItem = false;
+	}
+}
+
+} // namespace liblogger
@@ -0,0 +1,248 @@
+#pragma once
+
+// Module hashing for the Linux scanner. Each file is analyzed from a single read-only mapping,
+// identical files (same device, inode, size and mtime) are analyzed once per process, and a batch
+// of modules is spread over a bounded set of worker threads.
+
+#include "elf_module_view.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <openssl/sha.h>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace liblogger {
+
+struct ModuleFileIdentity {
+	uint64_t device = 0;
+	uint64_t inode = 0;
+	uint64_t size = 0;
+	int64_t modifiedNs = 0;
+
+	bool operator==(const ModuleFileIdentity& other) const {
+		return device == other.device && inode == other.inode && size == other.size && modifiedNs == other.modifiedNs;
+	}
+};
+
+struct ModuleFileIdentityHasher {
+	size_t operator()(const ModuleFileIdentity& identity) const {
+		uint64_t value = identity.inode * 0x9E3779B97F4A7C15ull;
+		value ^= identity.device + 0x9E3779B97F4A7C15ull + (value << 6) + (value >> 2);
+		value ^= identity.size + 0x9E3779B97F4A7C15ull + (value << 6) + (value >> 2);
+		value ^= static_cast<uint64_t>(identity.modifiedNs) + 0x9E3779B97F4A7C15ull + (value << 6) + (value >> 2);
+		return static_cast<size_t>(value);
+	}
+};
+
+struct ModuleDigest {
+	// False when the file could not be read or does not start with the ELF magic; such paths are
+	// not reported.
+	bool isElf = false;
+	std::string sha512Hex;
+	// Comma-separated base64 DT_NEEDED names, ready for the moduleLoaded message.
+	std::string encodedImports;
+};
+
+inline ModuleFileIdentity MakeModuleFileIdentity(const struct stat& fileStat) {
+	ModuleFileIdentity identity;
+	identity.device = static_cast<uint64_t>(fileStat.st_dev);
+	identity.inode = static_cast<uint64_t>(fileStat.st_ino);
+	identity.size = static_cast<uint64_t>(fileStat.st_size);
+	identity.modifiedNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000ll + static_cast<int64_t>(fileStat.st_mtim.tv_nsec);
+	return identity;
+}
+
+inline std::string FormatSHA512Hex(const unsigned char (&digest)[SHA512_DIGEST_LENGTH]) {
+	static constexpr char kHexDigits[] = "0123456789abcdef";
+	std::string result;
+	result.reserve(SHA512_DIGEST_LENGTH * 2);
+	for (int index = 0; index < SHA512_DIGEST_LENGTH; ++index) {
+		const unsigned char byte = digest[index];
+		result.push_back(kHexDigits[byte >> 4]);
+		result.push_back(kHexDigits[byte & 0x0F]);
+	}
+	return result;
+}
+
+// Maps an already opened file once and derives everything the scanner reports from that view: the
+// ELF magic check, the SHA-512 digest and the encoded DT_NEEDED list.
+inline ModuleDigest AnalyzeOpenModuleFile(int fd, uint64_t size) {
+	ModuleDigest digest;
+	ElfModuleView view;
+	if (size < SELFMAG || !view.MapFile(fd, size) || !view.IsElf()) {
+		return digest;
+	}
+
+	digest.isElf = true;
+	unsigned char hash[SHA512_DIGEST_LENGTH];
+	SHA512(view.Data(), view.Size(), hash);
+	digest.sha512Hex = FormatSHA512Hex(hash);
+
+	std::vector<std::string_view> neededModules;
+	if (view.CollectNeededModules(neededModules)) {
+		AppendEncodedImports(digest.encodedImports, neededModules);
+	}
+	return digest;
+}
+
+// Process-wide (device, inode, size, mtime) -> digest cache. A module reached through several names
+// or reloaded unchanged is hashed once; a rewritten file gets a new mtime and is hashed again.
+class ModuleDigestCache {
+public:
+	bool Find(const ModuleFileIdentity& identity, ModuleDigest& digest) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto it = m_digests.find(identity);
+		if (it == m_digests.end()) {
+			return false;
+		}
+		digest = it->second;
+		return true;
+	}
+
+	void Store(const ModuleFileIdentity& identity, const ModuleDigest& digest) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_digests[identity] = digest;
+	}
+
+	size_t Size() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_digests.size();
+	}
+
+	void Clear() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_digests.clear();
+	}
+
+private:
+	mutable std::mutex m_mutex;
+	std::unordered_map<ModuleFileIdentity, ModuleDigest, ModuleFileIdentityHasher> m_digests;
+};
+
+struct ModuleHashBatchStats {
+	size_t filesHashed = 0;
+	size_t cacheHits = 0;
+	uint64_t bytesHashed = 0;
+};
+
+// Returns one digest per input path, in input order. Paths are stat'ed up front so duplicates and
+// cached files never reach the workers; the remaining unique files are hashed by at most
+// maxWorkers threads (0 picks half the hardware threads).
+inline std::vector<ModuleDigest> HashModuleFiles(const std::vector<std::string>& paths, ModuleDigestCache& cache, unsigned maxWorkers = 0,
+                                                 ModuleHashBatchStats* stats = nullptr) {
+	struct PendingFile {
+		ModuleFileIdentity identity;
+		const std::string* path = nullptr;
+		ModuleDigest digest;
+		bool read = false;
+	};
+
+	std::vector<ModuleDigest> results(paths.size());
+	std::vector<ModuleFileIdentity> identities(paths.size());
+	std::vector<bool> resolved(paths.size(), false);
+	std::vector<PendingFile> pending;
+	std::unordered_map<ModuleFileIdentity, size_t, ModuleFileIdentityHasher> pendingIndex;
+	ModuleHashBatchStats batchStats;
+
+	for (size_t index = 0; index < paths.size(); ++index) {
+		struct stat fileStat = {};
+		if (paths[index].empty() || stat(paths[index].c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+			resolved[index] = true;
+			continue;
+		}
+
+		identities[index] = MakeModuleFileIdentity(fileStat);
+		if (cache.Find(identities[index], results[index])) {
+			resolved[index] = true;
+			++batchStats.cacheHits;
+			continue;
+		}
+
+		if (pendingIndex.emplace(identities[index], pending.size()).second) {
+			PendingFile file;
+			file.identity = identities[index];
+			file.path = &paths[index];
+			pending.push_back(std::move(file));
+		} else {
+			++batchStats.cacheHits;
+		}
+	}
+
+	if (!pending.empty()) {
+		unsigned workerCount = maxWorkers;
+		if (workerCount == 0) {
+			workerCount = (std::max)(1u, std::thread::hardware_concurrency() / 2);
+		}
+		workerCount = static_cast<unsigned>((std::min)(static_cast<size_t>(workerCount), pending.size()));
+
+		std::atomic<size_t> nextFile(0);
+		auto worker = [&pending, &nextFile]() {
+			for (size_t fileIndex = nextFile.fetch_add(1); fileIndex < pending.size(); fileIndex = nextFile.fetch_add(1)) {
+				PendingFile& file = pending[fileIndex];
+				const int fd = open(file.path->c_str(), O_RDONLY | O_CLOEXEC);
+				if (fd < 0) {
+					continue;
+				}
+
+				// Hash what is actually on disk now; the identity only decides what is cached.
+				struct stat fileStat = {};
+				if (fstat(fd, &fileStat) == 0) {
+					file.digest = AnalyzeOpenModuleFile(fd, static_cast<uint64_t>(fileStat.st_size));
+					file.identity = MakeModuleFileIdentity(fileStat);
+					file.read = true;
+				}
+				close(fd);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(workerCount > 0 ? workerCount - 1 : 0);
+		for (unsigned workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (std::thread& thread : workers) {
+			thread.join();
+		}
+
+		for (const PendingFile& file : pending) {
+			if (!file.read) {
+				continue;
+			}
+			cache.Store(file.identity, file.digest);
+			if (file.digest.isElf) {
+				++batchStats.filesHashed;
+				batchStats.bytesHashed += file.identity.size;
+			}
+		}
+	}
+
+	for (size_t index = 0; index < paths.size(); ++index) {
+		if (resolved[index]) {
+			continue;
+		}
+
+		const auto it = pendingIndex.find(identities[index]);
+		if (it != pendingIndex.end()) {
+			results[index] = pending[it->second].digest;
+		}
+	}
+
+	if (stats) {
+		*stats = batchStats;
+	}
+	return results;
+}
+
+} // namespace liblogger
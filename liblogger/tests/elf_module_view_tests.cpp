@@ -0,0 +1,418 @@
+#include "../base64.h"
+#include "../elf_module_view.h"
+#include "../module_hash.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+	if (!condition) {
+		std::cerr << "  ASSERT FAILED: " << message << '\n';
+		++g_failures;
+	}
+}
+
+struct FixtureOptions {
+	bool includeDynamic = true;
+	bool includeStringTable = true;
+	bool includeStringTableSize = true;
+	// Appended as a DT_NEEDED entry whose offset points past the string table.
+	bool addOutOfRangeNeeded = false;
+	// Drops the final NUL so the last name runs off the end of the file.
+	bool truncateLastString = false;
+};
+
+template <typename T>
+void WriteAt(std::vector<unsigned char>& bytes, size_t offset, const T& value) {
+	if (bytes.size() < offset + sizeof(T)) {
+		bytes.resize(offset + sizeof(T));
+	}
+	std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+// Lays out a minimal shared object: header, PT_LOAD covering the file, PT_DYNAMIC, the dynamic
+// entries and a string table at the end, mapped at a non-zero virtual address like a real .so.
+template <typename Ehdr, typename Phdr, typename Dyn>
+std::vector<unsigned char> BuildFixture(unsigned char elfClass, const std::vector<std::string>& neededNames, const FixtureOptions& options = {}) {
+	constexpr uint64_t kBaseAddress = 0x10000;
+
+	std::string stringTable(1, '\0');
+	std::vector<uint64_t> nameOffsets;
+	for (const std::string& name : neededNames) {
+		nameOffsets.push_back(stringTable.size());
+		stringTable += name;
+		stringTable.push_back('\0');
+	}
+
+	std::vector<Dyn> dynamicEntries;
+	for (uint64_t nameOffset : nameOffsets) {
+		Dyn entry = {};
+		entry.d_tag = DT_NEEDED;
+		entry.d_un.d_val = nameOffset;
+		dynamicEntries.push_back(entry);
+	}
+	if (options.addOutOfRangeNeeded) {
+		Dyn entry = {};
+		entry.d_tag = DT_NEEDED;
+		entry.d_un.d_val = stringTable.size() + 4096;
+		dynamicEntries.push_back(entry);
+	}
+	const size_t stringTableAddressIndex = dynamicEntries.size();
+	if (options.includeStringTable) {
+		Dyn entry = {};
+		entry.d_tag = DT_STRTAB;
+		dynamicEntries.push_back(entry);
+	}
+	if (options.includeStringTableSize) {
+		Dyn entry = {};
+		entry.d_tag = DT_STRSZ;
+		entry.d_un.d_val = stringTable.size();
+		dynamicEntries.push_back(entry);
+	}
+	dynamicEntries.push_back(Dyn{});
+
+	const size_t programHeaderOffset = sizeof(Ehdr);
+	const size_t programHeaderCount = options.includeDynamic ? 2 : 1;
+	const size_t dynamicOffset = programHeaderOffset + programHeaderCount * sizeof(Phdr);
+	const size_t stringTableOffset = dynamicOffset + dynamicEntries.size() * sizeof(Dyn);
+	if (options.includeStringTable) {
+		dynamicEntries[stringTableAddressIndex].d_un.d_ptr = kBaseAddress + stringTableOffset;
+	}
+
+	std::vector<unsigned char> bytes(stringTableOffset + stringTable.size(), 0);
+
+	Ehdr header = {};
+	std::memcpy(header.e_ident, ELFMAG, SELFMAG);
+	header.e_ident[EI_CLASS] = elfClass;
+	header.e_ident[EI_DATA] = ELFDATA2LSB;
+	header.e_ident[EI_VERSION] = EV_CURRENT;
+	header.e_type = ET_DYN;
+	header.e_version = EV_CURRENT;
+	header.e_phoff = programHeaderOffset;
+	header.e_ehsize = sizeof(Ehdr);
+	header.e_phentsize = sizeof(Phdr);
+	header.e_phnum = static_cast<uint16_t>(programHeaderCount);
+	WriteAt(bytes, 0, header);
+
+	Phdr loadHeader = {};
+	loadHeader.p_type = PT_LOAD;
+	loadHeader.p_offset = 0;
+	loadHeader.p_vaddr = kBaseAddress;
+	loadHeader.p_filesz = bytes.size();
+	loadHeader.p_memsz = bytes.size();
+	WriteAt(bytes, programHeaderOffset, loadHeader);
+
+	if (options.includeDynamic) {
+		Phdr dynamicHeader = {};
+		dynamicHeader.p_type = PT_DYNAMIC;
+		dynamicHeader.p_offset = dynamicOffset;
+		dynamicHeader.p_vaddr = kBaseAddress + dynamicOffset;
+		dynamicHeader.p_filesz = dynamicEntries.size() * sizeof(Dyn);
+		dynamicHeader.p_memsz = dynamicHeader.p_filesz;
+		WriteAt(bytes, programHeaderOffset + sizeof(Phdr), dynamicHeader);
+	}
+
+	for (size_t index = 0; index < dynamicEntries.size(); ++index) {
+		WriteAt(bytes, dynamicOffset + index * sizeof(Dyn), dynamicEntries[index]);
+	}
+	std::memcpy(bytes.data() + stringTableOffset, stringTable.data(), stringTable.size());
+
+	if (options.truncateLastString) {
+		bytes.pop_back();
+	}
+	return bytes;
+}
+
+std::vector<unsigned char> Build64(const std::vector<std::string>& names, const FixtureOptions& options = {}) {
+	return BuildFixture<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(ELFCLASS64, names, options);
+}
+
+std::vector<unsigned char> Build32(const std::vector<std::string>& names, const FixtureOptions& options = {}) {
+	return BuildFixture<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(ELFCLASS32, names, options);
+}
+
+// The collected views point into bytes, which must outlive them.
+bool CollectFrom(const std::vector<unsigned char>& bytes, std::vector<std::string_view>& names) {
+	liblogger::ElfModuleView view;
+	view.AssignMemory(bytes.data(), bytes.size());
+	return view.CollectNeededModules(names);
+}
+
+bool NamesEqual(const std::vector<std::string_view>& actual, const std::vector<std::string>& expected) {
+	if (actual.size() != expected.size()) {
+		return false;
+	}
+	for (size_t index = 0; index < actual.size(); ++index) {
+		if (actual[index] != expected[index]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// The scanner's previous wire format: comma-joined names re-split and encoded one by one.
+std::string LegacyEncodeImports(const std::vector<std::string>& names) {
+	std::string output;
+	bool firstItem = true;
+	for (const std::string& item : names) {
+		const size_t start = item.find_first_not_of(" \t");
+		if (start == std::string::npos) {
+			continue;
+		}
+		const size_t end = item.find_last_not_of(" \t");
+		if (!firstItem) {
+			output += ',';
+		}
+		output += macaron::Base64::Encode(item.substr(start, end - start + 1));
+		firstItem = false;
+	}
+	return output;
+}
+
+const std::vector<std::string> kSampleImports = { "libc.so.6", "libm.so.6", "libjawt.so", "liblwjgl_opengl.so" };
+
+struct TempFile {
+	std::string path;
+
+	explicit TempFile(const std::vector<unsigned char>& bytes) {
+		char pathTemplate[] = "/tmp/liblogger_elf_fixture_XXXXXX";
+		const int fd = mkstemp(pathTemplate);
+		if (fd >= 0) {
+			path = pathTemplate;
+			const ssize_t written = write(fd, bytes.data(), bytes.size());
+			(void)written;
+			close(fd);
+		}
+	}
+
+	~TempFile() {
+		if (!path.empty()) {
+			unlink(path.c_str());
+		}
+	}
+};
+
+void Reads64BitNeededEntries() {
+	const std::vector<unsigned char> fixture = Build64(kSampleImports);
+	std::vector<std::string_view> names;
+	Check(CollectFrom(fixture, names), "64-bit fixture parses");
+	Check(NamesEqual(names, kSampleImports), "64-bit DT_NEEDED names come back in order");
+}
+
+void Reads32BitNeededEntries() {
+	const std::vector<unsigned char> fixture = Build32(kSampleImports);
+	std::vector<std::string_view> names;
+	Check(CollectFrom(fixture, names), "32-bit fixture parses");
+	Check(NamesEqual(names, kSampleImports), "32-bit DT_NEEDED names come back in order");
+
+	names.clear();
+	Check(CollectFrom(Build32({}), names) && names.empty(), "a module without imports parses to an empty list");
+}
+
+void RejectsNonElfAndForeignLayouts() {
+	std::vector<std::string_view> names;
+	liblogger::ElfModuleView view;
+
+	const std::vector<unsigned char> notElf = { 'M', 'Z', 0x90, 0x00, 0x03, 0x00 };
+	view.AssignMemory(notElf.data(), notElf.size());
+	Check(!view.IsElf(), "PE bytes are not ELF");
+	Check(!view.CollectNeededModules(names), "PE bytes yield no imports");
+
+	std::vector<unsigned char> bigEndian = Build64(kSampleImports);
+	bigEndian[EI_DATA] = ELFDATA2MSB;
+	Check(!CollectFrom(bigEndian, names), "foreign byte order is rejected");
+
+	std::vector<unsigned char> badClass = Build64(kSampleImports);
+	badClass[EI_CLASS] = ELFCLASSNONE;
+	Check(!CollectFrom(badClass, names), "unknown ELF class is rejected");
+
+	std::vector<unsigned char> truncatedHeader = Build64(kSampleImports);
+	truncatedHeader.resize(sizeof(Elf64_Ehdr) - 1);
+	Check(!CollectFrom(truncatedHeader, names), "truncated header is rejected");
+
+	std::vector<unsigned char> magicOnly(ELFMAG, ELFMAG + SELFMAG);
+	view.AssignMemory(magicOnly.data(), magicOnly.size());
+	Check(view.IsElf() && !view.CollectNeededModules(names), "bare magic is ELF but has no dynamic section");
+	Check(names.empty(), "rejected inputs add no names");
+}
+
+void BoundsChecksHostileOffsets() {
+	std::vector<std::string_view> names;
+
+	std::vector<unsigned char> farProgramHeaders = Build64(kSampleImports);
+	Elf64_Ehdr header;
+	std::memcpy(&header, farProgramHeaders.data(), sizeof(header));
+	header.e_phoff = farProgramHeaders.size() - 8;
+	std::memcpy(farProgramHeaders.data(), &header, sizeof(header));
+	Check(!CollectFrom(farProgramHeaders, names), "program headers past the end are rejected");
+
+	std::vector<unsigned char> farDynamic = Build32(kSampleImports);
+	Elf32_Phdr dynamicHeader;
+	std::memcpy(&dynamicHeader, farDynamic.data() + sizeof(Elf32_Ehdr) + sizeof(Elf32_Phdr), sizeof(dynamicHeader));
+	dynamicHeader.p_filesz = static_cast<Elf32_Word>(farDynamic.size());
+	std::memcpy(farDynamic.data() + sizeof(Elf32_Ehdr) + sizeof(Elf32_Phdr), &dynamicHeader, sizeof(dynamicHeader));
+	Check(!CollectFrom(farDynamic, names), "dynamic section past the end is rejected");
+
+	FixtureOptions outOfRange;
+	outOfRange.addOutOfRangeNeeded = true;
+	const std::vector<unsigned char> outOfRangeFixture = Build64(kSampleImports, outOfRange);
+	names.clear();
+	Check(CollectFrom(outOfRangeFixture, names), "fixture with a stray DT_NEEDED still parses");
+	Check(NamesEqual(names, kSampleImports), "out-of-range DT_NEEDED offsets are skipped");
+
+	FixtureOptions unterminated;
+	unterminated.truncateLastString = true;
+	unterminated.includeStringTableSize = false;
+	const std::vector<unsigned char> unterminatedFixture = Build32(kSampleImports, unterminated);
+	names.clear();
+	Check(CollectFrom(unterminatedFixture, names), "fixture with an unterminated string still parses");
+	Check(NamesEqual(names, std::vector<std::string>(kSampleImports.begin(), kSampleImports.end() - 1)),
+		  "a name running off the end of the file is dropped");
+}
+
+void MissingDynamicDataYieldsNoImports() {
+	std::vector<std::string_view> names;
+
+	FixtureOptions noDynamic;
+	noDynamic.includeDynamic = false;
+	Check(!CollectFrom(Build64(kSampleImports, noDynamic), names), "static executables report no imports");
+
+	FixtureOptions noStringTable;
+	noStringTable.includeStringTable = false;
+	Check(!CollectFrom(Build32(kSampleImports, noStringTable), names), "a dynamic section without DT_STRTAB reports no imports");
+	Check(names.empty(), "nothing is collected without a string table");
+}
+
+void EncodedImportsMatchLegacyFormat() {
+	const std::vector<std::string> names = { "a", "ab", "abc", "libstdc++.so.6", " padded.so\t", "   ", "\xC3\xA9t\xC3\xA9.so", "ld-linux-x86-64.so.2" };
+	std::vector<std::string_view> views(names.begin(), names.end());
+
+	std::string encoded;
+	liblogger::AppendEncodedImports(encoded, views);
+	Check(encoded == LegacyEncodeImports(names), "encoded import list matches the comma-joined base64 format");
+
+	std::string empty;
+	liblogger::AppendEncodedImports(empty, {});
+	Check(empty.empty(), "no imports encode to an empty field");
+
+	for (const std::string& name : names) {
+		std::string single;
+		liblogger::AppendBase64(single, name);
+		Check(single == macaron::Base64::Encode(name), "base64 matches the bundled encoder for '" + name + "'");
+	}
+}
+
+void AnalyzesFilesFromOneMapping() {
+	for (bool use32Bit : { false, true }) {
+		const std::vector<unsigned char> bytes = use32Bit ? Build32(kSampleImports) : Build64(kSampleImports);
+		TempFile file(bytes);
+		Check(!file.path.empty(), "fixture file is written");
+
+		liblogger::ElfModuleView view;
+		Check(view.Open(file.path.c_str()), "fixture file maps");
+		Check(view.Size() == bytes.size() && std::memcmp(view.Data(), bytes.data(), bytes.size()) == 0, "mapping exposes the file bytes");
+
+		unsigned char expectedHash[SHA512_DIGEST_LENGTH];
+		SHA512(bytes.data(), bytes.size(), expectedHash);
+
+		liblogger::ModuleDigestCache cache;
+		const std::vector<liblogger::ModuleDigest> digests = liblogger::HashModuleFiles({ file.path, file.path }, cache, 2);
+		Check(digests.size() == 2 && digests[0].isElf && digests[1].isElf, "both listings are reported as ELF");
+		Check(digests[0].sha512Hex == liblogger::FormatSHA512Hex(expectedHash), "digest is SHA-512 of the file");
+		Check(digests[0].encodedImports == LegacyEncodeImports(kSampleImports), "imports are encoded from the same mapping");
+		Check(digests[1].sha512Hex == digests[0].sha512Hex && digests[1].encodedImports == digests[0].encodedImports,
+			  "a duplicate listing reuses the same analysis");
+		Check(cache.Size() == 1, "the file is cached once by identity");
+	}
+}
+
+void ReadsOwnExecutable() {
+	liblogger::ElfModuleView view;
+	Check(view.Open("/proc/self/exe"), "the test binary maps");
+	Check(view.IsElf(), "the test binary is ELF");
+
+	std::vector<std::string_view> names;
+	Check(view.CollectNeededModules(names), "the test binary has a dynamic section");
+	bool foundLibc = false;
+	for (std::string_view name : names) {
+		foundLibc = foundLibc || name.substr(0, 7) == "libc.so";
+	}
+	Check(foundLibc, "the test binary imports libc");
+}
+
+struct TestCase {
+	const char* name;
+	std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+	static const std::vector<TestCase> cases = {
+		{ "reads_64bit_needed_entries", &Reads64BitNeededEntries },
+		{ "reads_32bit_needed_entries", &Reads32BitNeededEntries },
+		{ "rejects_non_elf_and_foreign_layouts", &RejectsNonElfAndForeignLayouts },
+		{ "bounds_checks_hostile_offsets", &BoundsChecksHostileOffsets },
+		{ "missing_dynamic_data_yields_no_imports", &MissingDynamicDataYieldsNoImports },
+		{ "encoded_imports_match_legacy_format", &EncodedImportsMatchLegacyFormat },
+		{ "analyzes_files_from_one_mapping", &AnalyzesFilesFromOneMapping },
+		{ "reads_own_executable", &ReadsOwnExecutable },
+	};
+	return cases;
+}
+
+int RunNamed(const std::string& name) {
+	for (const auto& testCase : Registry()) {
+		if (name == testCase.name) {
+			g_failures = 0;
+			std::cout << "RUN " << name << '\n';
+			testCase.run();
+			if (g_failures == 0) {
+				std::cout << "PASS " << name << '\n';
+				return 0;
+			}
+			std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+			return 1;
+		}
+	}
+	std::cerr << "Unknown test case: " << name << '\n';
+	return 2;
+}
+
+int RunAll() {
+	int failed = 0;
+	for (const auto& testCase : Registry()) {
+		if (RunNamed(testCase.name) != 0) {
+			++failed;
+		}
+	}
+	return failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+		return RunAll();
+	}
+	if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+		for (const auto& testCase : Registry()) {
+			std::cout << testCase.name << '\n';
+		}
+		return 0;
+	}
+	if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+		return RunNamed(argv[2]);
+	}
+	std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+	return 2;
+}
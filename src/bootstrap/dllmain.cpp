@@ -12,7 +12,12 @@
 #include "platform/resource.h"
 #include "common/i18n.h"
 #include "hooks/hook_chain.h"
+#include "hooks/sensitivity_state.h"
 #include "common/utils.h"
+#include "common/snapshot_recycler.h"
+#include "render/frame_pacer.h"
+#include "config/config_diff.h"
+#include "config/config_persistence.h"
 #include "version.h"
 #include "features/browser_overlay.h"
 #include "features/virtual_camera.h"
@@ -59,37 +64,55 @@ Config g_config;
 Config g_sharedConfig;
 std::atomic<bool> g_configIsDirty{ false };
 
+// Last generation stamped on a published snapshot (see Config::snapshotGeneration).
 std::atomic<uint64_t> g_configSnapshotVersion{ 0 };
 
 // CONFIG SNAPSHOT (RCU) - Lock-free immutable config for reader threads
 // The mutable g_config is only touched by the GUI/main thread.
 // Reader threads call GetConfigSnapshot() for a safe, lock-free snapshot.
 static std::atomic<std::shared_ptr<const Config>> g_configSnapshot;
+// Retired snapshots are copied into again once no reader holds them, so GUI edits that republish every frame
+// (slider drags) reuse the previous snapshots' string and vector buffers instead of reallocating the whole config.
+static SnapshotRecycler<Config> g_configSnapshotStorage;
+
+// Bumps the section versions for whatever differs from the snapshot being replaced, so consumers keyed on
+// GetConfigSectionsVersion() only rebuild for edits to the sections they read.
+static void PublishConfigSectionChanges(const Config* previous, const Config& current) {
+    BumpConfigSectionVersions(previous ? DiffConfigSections(*previous, current) : kAllConfigSections);
+}
 
 void PublishConfigSnapshot() {
     PublishConfigSnapshot(g_config);
 }
 
 void PublishConfigSnapshot(const Config& config) {
-    Config sanitizedConfig = config;
-    SanitizeConfigKeyRebindsForCannotTypeTriggers(sanitizedConfig);
-    auto snapshot = std::make_shared<const Config>(std::move(sanitizedConfig));
-    // Lock-free publish: atomic store of shared_ptr.
-    g_configSnapshot.store(std::move(snapshot), std::memory_order_release);
+    PROFILE_SCOPE_CAT("Publish Config Snapshot", "IO Operations");
+    std::shared_ptr<Config> storage = g_configSnapshotStorage.AcquireCopyOf(config);
+    SanitizeConfigKeyRebindsForCannotTypeTriggers(*storage);
+    storage->snapshotGeneration.value = g_configSnapshotVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+    std::shared_ptr<const Config> snapshot = std::move(storage);
+    PublishLogCategoryMask(snapshot->debug);
+    // Lock-free publish: atomic exchange of shared_ptr. The previous snapshot is only kept to diff against.
+    const std::shared_ptr<const Config> previous = g_configSnapshot.exchange(snapshot, std::memory_order_acq_rel);
 
-    g_configSnapshotVersion.fetch_add(1, std::memory_order_release);
+    PublishConfigSectionChanges(previous.get(), *snapshot);
+    RefreshSensitivityState();
 }
 
 bool PublishConfigSnapshotIfUnchanged(const std::shared_ptr<const Config>& expectedSnapshot, const Config& config) {
-    Config sanitizedConfig = config;
-    SanitizeConfigKeyRebindsForCannotTypeTriggers(sanitizedConfig);
-    auto snapshot = std::make_shared<const Config>(std::move(sanitizedConfig));
+    PROFILE_SCOPE_CAT("Publish Config Snapshot", "IO Operations");
+    std::shared_ptr<Config> storage = g_configSnapshotStorage.AcquireCopyOf(config);
+    SanitizeConfigKeyRebindsForCannotTypeTriggers(*storage);
+    storage->snapshotGeneration.value = g_configSnapshotVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+    std::shared_ptr<const Config> snapshot = std::move(storage);
     auto expected = expectedSnapshot;
-    if (!g_configSnapshot.compare_exchange_strong(expected, std::move(snapshot), std::memory_order_acq_rel, std::memory_order_acquire)) {
+    if (!g_configSnapshot.compare_exchange_strong(expected, snapshot, std::memory_order_acq_rel, std::memory_order_acquire)) {
         return false;
     }
+    PublishLogCategoryMask(snapshot->debug);
 
-    g_configSnapshotVersion.fetch_add(1, std::memory_order_release);
+    PublishConfigSectionChanges(expectedSnapshot.get(), *snapshot);
+    RefreshSensitivityState();
     return true;
 }
 
@@ -140,11 +163,44 @@ TempSensitivityOverride g_tempSensitivityOverride;
 std::mutex g_tempSensitivityMutex;
 
 void ClearTempSensitivityOverride() {
-    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-    g_tempSensitivityOverride.active = false;
-    g_tempSensitivityOverride.sensitivityX = 1.0f;
-    g_tempSensitivityOverride.sensitivityY = 1.0f;
-    g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+    {
+        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+        g_tempSensitivityOverride.active = false;
+        g_tempSensitivityOverride.sensitivityX = 1.0f;
+        g_tempSensitivityOverride.sensitivityY = 1.0f;
+        g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+    }
+    RefreshSensitivityState();
+}
+
+// Serializes refreshes so the last one to publish has read the latest inputs.
+static std::mutex s_sensitivityRefreshMutex;
+
+void RefreshSensitivityState() {
+    std::lock_guard<std::mutex> refreshLock(s_sensitivityRefreshMutex);
+    SensitivityInputs inputs;
+    {
+        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+        inputs.overrideActive = g_tempSensitivityOverride.active;
+        inputs.overrideX = g_tempSensitivityOverride.sensitivityX;
+        inputs.overrideY = g_tempSensitivityOverride.sensitivityY;
+    }
+
+    // During a transition the target mode's sensitivity already applies.
+    const ViewportTransitionSnapshot& transitionSnap = g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
+    const std::string modeId = transitionSnap.active ? transitionSnap.toModeId : g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+
+    auto cfgSnap = GetConfigSnapshot();
+    if (cfgSnap) {
+        inputs.globalSensitivity = cfgSnap->mouseSensitivity;
+        const ModeConfig* mode = GetModeFromSnapshotOrFallback(*cfgSnap, modeId);
+        if (mode && mode->sensitivityOverrideEnabled) {
+            inputs.modeOverrideEnabled = true;
+            inputs.modeX = mode->separateXYSensitivity ? mode->modeSensitivityX : mode->modeSensitivity;
+            inputs.modeY = mode->separateXYSensitivity ? mode->modeSensitivityY : mode->modeSensitivity;
+        }
+    }
+    PublishSensitivityState(ComputeSensitivityState(inputs));
 }
 
 std::atomic<bool> g_cursorsNeedReload{ false };
@@ -254,8 +310,6 @@ std::mutex g_pendingModeSwitchMutex;
 std::atomic<double> g_lastFrameTimeMs{ 0.0 };
 std::atomic<double> g_originalFrameTimeMs{ 0.0 };
 
-std::chrono::high_resolution_clock::time_point g_lastFrameEndTime = std::chrono::high_resolution_clock::now();
-std::mutex g_fpsLimitMutex;
 HANDLE g_highResTimer = NULL;
 int g_originalWindowsMouseSpeed = 0;                      // Original Windows mouse speed to restore on exit
 std::atomic<bool> g_windowsMouseSpeedApplied{ false };
@@ -507,7 +561,7 @@ template <typename T> bool CreateHookOrDie(LPVOID pTarget, LPVOID pDetour, T** p
         Log(errorMsg);
         return false;
     }
-    LogCategory("init", "Created hook for " + std::string(hookName));
+    LOG_CATEGORY(Init, "Created hook for " + std::string(hookName));
     return true;
 }
 
@@ -604,7 +658,7 @@ void SaveOriginalWindowsMouseSpeed() {
     int currentSpeed = 0;
     if (SystemParametersInfo(SPI_GETMOUSESPEED, 0, &currentSpeed, 0)) {
         g_originalWindowsMouseSpeed = currentSpeed;
-        LogCategory("init", "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
+        LOG_CATEGORY(Init, "Saved original Windows mouse speed: " + std::to_string(currentSpeed));
     } else {
         Log("WARNING: Failed to get current Windows mouse speed");
         g_originalWindowsMouseSpeed = 10;
@@ -666,7 +720,7 @@ void SaveOriginalKeyRepeatSettings() {
     g_originalFilterKeys.cbSize = sizeof(FILTERKEYS);
     if (SystemParametersInfo(SPI_GETFILTERKEYS, sizeof(FILTERKEYS), &g_originalFilterKeys, 0)) {
         g_originalFilterKeysCaptured.store(true);
-        LogCategory("init", "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
+        LOG_CATEGORY(Init, "Saved original FILTERKEYS: flags=0x" + std::to_string(g_originalFilterKeys.dwFlags) +
                                 ", iDelayMSec=" + std::to_string(g_originalFilterKeys.iDelayMSec) +
                                 ", iRepeatMSec=" + std::to_string(g_originalFilterKeys.iRepeatMSec));
     } else {
@@ -1467,7 +1521,7 @@ static std::atomic<int> lastViewportH{ 0 };
 static constexpr int kViewportHookRecentModeHistory = 6;
 
 struct ViewportHookCache {
-    uint64_t configVersion = UINT64_MAX;
+    uint64_t modesVersion = UINT64_MAX;
     std::string modeId;
     int screenW = 0;
     int screenH = 0;
@@ -1536,14 +1590,15 @@ static bool GetLatestViewportForHook(int& outModeW, int& outModeH, bool& outStre
                                      int& outStretchW, int& outStretchH) {
     ViewportHookCache& s_cache = GetViewportHookCache();
 
-    const uint64_t configVersion = g_configSnapshotVersion.load(std::memory_order_acquire);
+    // Only mode dimensions feed this cache, so edits to other sections keep it warm.
+    const uint64_t modesVersion = GetConfigSectionVersion(ConfigSection::Modes);
     const int modeIdx = g_currentModeIdIndex.load(std::memory_order_acquire);
     const std::string& currentModeId = g_modeIdBuffers[modeIdx];
 
     const int screenW = (std::max)(1, GetCachedWindowWidth());
     const int screenH = (std::max)(1, GetCachedWindowHeight());
 
-    if (s_cache.valid && s_cache.configVersion == configVersion && s_cache.screenW == screenW && s_cache.screenH == screenH &&
+    if (s_cache.valid && s_cache.modesVersion == modesVersion && s_cache.screenW == screenW && s_cache.screenH == screenH &&
         s_cache.modeId == currentModeId) {
         outModeW = s_cache.modeW;
         outModeH = s_cache.modeH;
@@ -1575,7 +1630,7 @@ static bool GetLatestViewportForHook(int& outModeW, int& outModeH, bool& outStre
 
     if (modeW < 1 || modeH < 1) { return false; }
 
-    s_cache.configVersion = configVersion;
+    s_cache.modesVersion = modesVersion;
     s_cache.modeId = currentModeId;
     s_cache.screenW = screenW;
     s_cache.screenH = screenH;
@@ -1943,7 +1998,7 @@ static void AttemptHookGlBlitNamedFramebufferViaGlew() {
     }
 
     s_hooked.store(true, std::memory_order_release);
-    LogCategory("init", "Successfully hooked glBlitNamedFramebuffer via GLEW");
+    LOG_CATEGORY(Init, "Successfully hooked glBlitNamedFramebuffer via GLEW");
 }
 
 static bool ShouldRetargetMinecraftBlitFramebuffer(GLint readFBO, GLint drawFBO) {
@@ -2011,7 +2066,7 @@ static void AttemptHookGlBlitFramebufferViaWgl() {
         reinterpret_cast<void*>(pBlitFramebufferWGL) != reinterpret_cast<void*>(&hkglBlitFramebuffer) &&
         reinterpret_cast<void*>(pBlitFramebufferWGL) != reinterpret_cast<void*>(&hkglBlitFramebuffer_Driver) &&
         reinterpret_cast<void*>(pBlitFramebufferWGL) != pBlitFramebufferExport) {
-        LogCategory("init", "Attempting glBlitFramebuffer hook via wglGetProcAddress: " +
+        LOG_CATEGORY(Init, "Attempting glBlitFramebuffer hook via wglGetProcAddress: " +
                    std::to_string(reinterpret_cast<uintptr_t>(pBlitFramebufferWGL)));
 
         MH_STATUS st = MH_CreateHook(reinterpret_cast<void*>(pBlitFramebufferWGL), reinterpret_cast<void*>(&hkglBlitFramebuffer_Driver),
@@ -2021,7 +2076,7 @@ static void AttemptHookGlBlitFramebufferViaWgl() {
             if (st == MH_OK || st == MH_ERROR_ENABLED) {
                 s_hooked.store(true, std::memory_order_release);
                 g_glBlitFramebufferHooked.store(true, std::memory_order_release);
-                LogCategory("init", "SUCCESS: glBlitFramebuffer hooked via wglGetProcAddress");
+                LOG_CATEGORY(Init, "SUCCESS: glBlitFramebuffer hooked via wglGetProcAddress");
                 return;
             }
         }
@@ -2032,7 +2087,7 @@ static void AttemptHookGlBlitFramebufferViaWgl() {
         reinterpret_cast<void*>(pBlitFramebufferGLEW) != reinterpret_cast<void*>(&hkglBlitFramebuffer) &&
         reinterpret_cast<void*>(pBlitFramebufferGLEW) != reinterpret_cast<void*>(&hkglBlitFramebuffer_Driver) &&
         reinterpret_cast<void*>(pBlitFramebufferGLEW) != pBlitFramebufferExport) {
-        LogCategory("init", "Attempting glBlitFramebuffer hook via GLEW pointer: " +
+        LOG_CATEGORY(Init, "Attempting glBlitFramebuffer hook via GLEW pointer: " +
                    std::to_string(reinterpret_cast<uintptr_t>(pBlitFramebufferGLEW)));
 
         MH_STATUS st = MH_CreateHook(reinterpret_cast<void*>(pBlitFramebufferGLEW), reinterpret_cast<void*>(&hkglBlitFramebuffer_Driver),
@@ -2042,7 +2097,7 @@ static void AttemptHookGlBlitFramebufferViaWgl() {
             if (st == MH_OK || st == MH_ERROR_ENABLED) {
                 s_hooked.store(true, std::memory_order_release);
                 g_glBlitFramebufferHooked.store(true, std::memory_order_release);
-                LogCategory("init", "SUCCESS: glBlitFramebuffer hooked via GLEW pointer");
+                LOG_CATEGORY(Init, "SUCCESS: glBlitFramebuffer hooked via GLEW pointer");
             }
         }
     }
@@ -2083,7 +2138,7 @@ static void AttemptHookGlBlitFramebufferThirdParty() {
                                           reinterpret_cast<void**>(&g_oglBlitFramebufferThirdParty),
                                           "glBlitFramebuffer (third-party chain)")) {
         g_glBlitFramebufferThirdPartyHookTarget.store(hookTarget, std::memory_order_release);
-        LogCategory("hookchain",
+        LOG_CATEGORY(HookChain,
                     std::string("[glBlitFramebuffer] installed third-party hook target ") +
                         HookChain::DescribeAddressWithOwner(hookTarget));
     }
@@ -2111,7 +2166,7 @@ static void AttemptHookGlNamedFramebufferTextureViaGlew() {
     }
 
     s_hooked.store(true, std::memory_order_release);
-    LogCategory("init", "Successfully hooked glNamedFramebufferTexture via GLEW");
+    LOG_CATEGORY(Init, "Successfully hooked glNamedFramebufferTexture via GLEW");
 }
 
 static BOOL SetCursorPosHook_Impl(SETCURSORPOSPROC next, int X, int Y) {
@@ -2353,100 +2408,25 @@ static UINT GetRawInputDataHook_Impl(GETRAWINPUTDATAPROC next, HRAWINPUT hRawInp
 
     if (result == static_cast<UINT>(-1) || pData == nullptr || uiCommand != RID_INPUT) { return result; }
 
+    if (IsInputTraceRecording()) {
+        const RAWINPUT* traced = reinterpret_cast<const RAWINPUT*>(pData);
+        if (traced->header.dwType == RIM_TYPEMOUSE) { RecordRawMouseInputForTrace(traced->data.mouse); }
+    }
+
     if (g_showGui.load() || g_isShuttingDown.load()) { return result; }
 
     RAWINPUT* raw = reinterpret_cast<RAWINPUT*>(pData);
 
-    if (raw->header.dwType == RIM_TYPEMOUSE) {
-        float sensitivityX = 1.0f;
-        float sensitivityY = 1.0f;
-        bool sensitivityDetermined = false;
-
-        {
-            std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-            if (g_tempSensitivityOverride.active) {
-                sensitivityX = g_tempSensitivityOverride.sensitivityX;
-                sensitivityY = g_tempSensitivityOverride.sensitivityY;
-                sensitivityDetermined = true;
-            }
-        }
-
-        if (!sensitivityDetermined) {
-            const ViewportTransitionSnapshot& transitionSnap =
-                g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_acquire)];
-
-            std::string modeId;
-            if (transitionSnap.active) {
-                modeId = transitionSnap.toModeId;
-            } else {
-                modeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-            }
-
-            auto inputCfgSnap = GetConfigSnapshot();
-            const ModeConfig* mode = inputCfgSnap ? GetModeFromSnapshotOrFallback(*inputCfgSnap, modeId) : nullptr;
-            if (mode && mode->sensitivityOverrideEnabled) {
-                if (mode->separateXYSensitivity) {
-                    sensitivityX = mode->modeSensitivityX;
-                    sensitivityY = mode->modeSensitivityY;
-                } else {
-                    sensitivityX = mode->modeSensitivity;
-                    sensitivityY = mode->modeSensitivity;
-                }
-            } else if (inputCfgSnap) {
-                sensitivityX = inputCfgSnap->mouseSensitivity;
-                sensitivityY = inputCfgSnap->mouseSensitivity;
-            }
-        }
-
-        if (!(raw->data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE)) {
-            static float xAccum = 0.0f;
-            static float yAccum = 0.0f;
-            static float lastSensitivityX = 1.0f;
-            static float lastSensitivityY = 1.0f;
-            static bool hasLastSensitivity = false;
-
-            const bool sensitivityChanged = !hasLastSensitivity || (std::fabs(sensitivityX - lastSensitivityX) > 0.000001f) ||
-                                          (std::fabs(sensitivityY - lastSensitivityY) > 0.000001f);
-            if (sensitivityChanged) {
-                xAccum = 0.0f;
-                yAccum = 0.0f;
-                lastSensitivityX = sensitivityX;
-                lastSensitivityY = sensitivityY;
-                hasLastSensitivity = true;
-            }
-
-            const LONG rawX = raw->data.mouse.lLastX;
-            const LONG rawY = raw->data.mouse.lLastY;
-
-            // Prevent stale remainder from one direction delaying opposite-direction output.
-            if (rawX != 0 && xAccum != 0.0f && ((rawX > 0) != (xAccum > 0.0f))) { xAccum = 0.0f; }
-            if (rawY != 0 && yAccum != 0.0f && ((rawY > 0) != (yAccum > 0.0f))) { yAccum = 0.0f; }
-
-            if (sensitivityX != 1.0f || sensitivityY != 1.0f) {
-                xAccum += rawX * sensitivityX;
-                yAccum += rawY * sensitivityY;
-
-                float roundedX = std::round(xAccum);
-                float roundedY = std::round(yAccum);
-
-                if (roundedX > static_cast<float>(LONG_MAX)) roundedX = static_cast<float>(LONG_MAX);
-                if (roundedX < static_cast<float>(LONG_MIN)) roundedX = static_cast<float>(LONG_MIN);
-                if (roundedY > static_cast<float>(LONG_MAX)) roundedY = static_cast<float>(LONG_MAX);
-                if (roundedY < static_cast<float>(LONG_MIN)) roundedY = static_cast<float>(LONG_MIN);
-
-                LONG outputX = static_cast<LONG>(roundedX);
-                LONG outputY = static_cast<LONG>(roundedY);
-
-                xAccum -= static_cast<float>(outputX);
-                yAccum -= static_cast<float>(outputY);
-
-                raw->data.mouse.lLastX = outputX;
-                raw->data.mouse.lLastY = outputY;
-            } else {
-                // No scaling: avoid carrying stale fractional remainder across future overrides.
-                xAccum = 0.0f;
-                yAccum = 0.0f;
-            }
+    if (raw->header.dwType == RIM_TYPEMOUSE && !(raw->data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE)) {
+        // Raw input is delivered on the game's input thread; the remainder is that thread's alone.
+        static SensitivityAccumulator s_accumulator;
+        const SensitivityState state = LoadSensitivityState();
+        int32_t dx = static_cast<int32_t>(raw->data.mouse.lLastX);
+        int32_t dy = static_cast<int32_t>(raw->data.mouse.lLastY);
+        s_accumulator.Apply(state, dx, dy);
+        if (!state.IsIdentity()) {
+            raw->data.mouse.lLastX = static_cast<LONG>(dx);
+            raw->data.mouse.lLastY = static_cast<LONG>(dy);
         }
     }
 
@@ -2779,14 +2759,14 @@ static void AttemptHookGlBindTextureViaWgl() {
         reinterpret_cast<void*>(pBindTexWGL) != reinterpret_cast<void*>(&hkglBindTexture) &&
         reinterpret_cast<void*>(pBindTexWGL) != reinterpret_cast<void*>(&hkglBindTexture_Driver) &&
         reinterpret_cast<void*>(pBindTexWGL) != reinterpret_cast<void*>(oglBindTexture)) {
-        LogCategory("init", "Attempting glBindTexture hook via wglGetProcAddress: " +
+        LOG_CATEGORY(Init, "Attempting glBindTexture hook via wglGetProcAddress: " +
                    std::to_string(reinterpret_cast<uintptr_t>(pBindTexWGL)));
         if (HookChain::TryCreateAndEnableHook(reinterpret_cast<void*>(pBindTexWGL),
                                               reinterpret_cast<void*>(&hkglBindTexture_Driver),
                                               reinterpret_cast<void**>(&g_oglBindTextureDriver),
                                               "glBindTexture (wglGetProcAddress)")) {
             s_hooked.store(true, std::memory_order_release);
-            LogCategory("init", "SUCCESS: glBindTexture hooked via wglGetProcAddress (driver target)");
+            LOG_CATEGORY(Init, "SUCCESS: glBindTexture hooked via wglGetProcAddress (driver target)");
         }
     }
 }
@@ -2808,14 +2788,14 @@ static void AttemptHookGlBindFramebufferViaWgl() {
         reinterpret_cast<void*>(pBindFramebufferWGL) != reinterpret_cast<void*>(&hkglBindFramebuffer) &&
         reinterpret_cast<void*>(pBindFramebufferWGL) != reinterpret_cast<void*>(&hkglBindFramebuffer_Driver) &&
         reinterpret_cast<void*>(pBindFramebufferWGL) != reinterpret_cast<void*>(oglBindFramebuffer)) {
-        LogCategory("init", "Attempting glBindFramebuffer hook via wglGetProcAddress: " +
+        LOG_CATEGORY(Init, "Attempting glBindFramebuffer hook via wglGetProcAddress: " +
                    std::to_string(reinterpret_cast<uintptr_t>(pBindFramebufferWGL)));
         if (HookChain::TryCreateAndEnableHook(reinterpret_cast<void*>(pBindFramebufferWGL),
                                               reinterpret_cast<void*>(&hkglBindFramebuffer_Driver),
                                               reinterpret_cast<void**>(&g_oglBindFramebufferDriver),
                                               "glBindFramebuffer (wglGetProcAddress)")) {
             s_hooked.store(true, std::memory_order_release);
-            LogCategory("init", "SUCCESS: glBindFramebuffer hooked via wglGetProcAddress (driver target)");
+            LOG_CATEGORY(Init, "SUCCESS: glBindFramebuffer hooked via wglGetProcAddress (driver target)");
             return;
         }
     }
@@ -2825,18 +2805,55 @@ static void AttemptHookGlBindFramebufferViaWgl() {
         reinterpret_cast<void*>(pBindFramebufferGLEW) != reinterpret_cast<void*>(&hkglBindFramebuffer) &&
         reinterpret_cast<void*>(pBindFramebufferGLEW) != reinterpret_cast<void*>(&hkglBindFramebuffer_Driver) &&
         reinterpret_cast<void*>(pBindFramebufferGLEW) != reinterpret_cast<void*>(oglBindFramebuffer)) {
-        LogCategory("init", "Attempting glBindFramebuffer hook via GLEW pointer: " +
+        LOG_CATEGORY(Init, "Attempting glBindFramebuffer hook via GLEW pointer: " +
                    std::to_string(reinterpret_cast<uintptr_t>(pBindFramebufferGLEW)));
         if (HookChain::TryCreateAndEnableHook(reinterpret_cast<void*>(pBindFramebufferGLEW),
                                               reinterpret_cast<void*>(&hkglBindFramebuffer_Driver),
                                               reinterpret_cast<void**>(&g_oglBindFramebufferDriver),
                                               "glBindFramebuffer (GLEW pointer)")) {
             s_hooked.store(true, std::memory_order_release);
-            LogCategory("init", "SUCCESS: glBindFramebuffer hooked via GLEW pointer (driver target)");
+            LOG_CATEGORY(Init, "SUCCESS: glBindFramebuffer hooked via GLEW pointer (driver target)");
         }
     }
 }
 
+// Steady clock plus the high-resolution waitable timer; only the SwapBuffers thread paces, so no locking is needed.
+class WaitableTimerFramePacerClock final : public FramePacerClock {
+  public:
+    int64_t NowNs() override {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void SleepUntilNs(int64_t deadlineNs) override {
+        const int64_t waitNs = deadlineNs - NowNs();
+        if (waitNs <= 0) { return; }
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(waitNs / 100);
+        if (SetWaitableTimer(g_highResTimer, &dueTime, 0, NULL, NULL, FALSE)) { WaitForSingleObject(g_highResTimer, 1000); }
+    }
+
+    void Relax() override { YieldProcessor(); }
+};
+
+static void PaceFrameToFpsLimit(const Config& cfg) {
+    static WaitableTimerFramePacerClock s_clock;
+    static FramePacer s_pacer(s_clock);
+
+    FramePacerSettings settings;
+    settings.targetFps = cfg.fpsLimit;
+    settings.sleepThresholdNs = static_cast<int64_t>((std::max)(cfg.fpsLimitSleepThreshold, 0)) * 1000;
+
+    FramePacerCaptureCadence capture;
+    uint64_t lastCaptureUs = 0;
+    uint64_t captureIntervalUs = 0;
+    if (cfg.fpsLimitAlignToObsCapture && GetObsCaptureCadenceUs(lastCaptureUs, captureIntervalUs)) {
+        capture.lastCaptureNs = static_cast<int64_t>(lastCaptureUs) * 1000;
+        capture.intervalNs = static_cast<int64_t>(captureIntervalUs) * 1000;
+    }
+
+    s_pacer.Pace(settings, capture);
+}
+
 // Runs from a destructor during exception unwind, so a fault here must not escape (-> terminate).
 static void RestoreGLStateNoThrow(const GLState& s) {
     __try {
@@ -2884,7 +2901,7 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
             PROFILE_SCOPE_CAT("GLEW Initialization", "SwapBuffers");
             glewExperimental = GL_TRUE;
             if (glewInit() == GLEW_OK) {
-                LogCategory("init", "[RENDER] GLEW Initialized successfully.");
+                LOG_CATEGORY(Init, "[RENDER] GLEW Initialized successfully.");
                 g_glewLoaded = true;
 
                 g_welcomeToastVisible.store(true);
@@ -3287,45 +3304,9 @@ static BOOL SwapBuffersHook_Impl(WGLSWAPBUFFERS next, HDC hDc) {
 
         g_isTransitioningMode = false;
 
-        int targetFPS = 0;
-        { targetFPS = frameCfg.fpsLimit; }
-
-        if (targetFPS > 0 && g_highResTimer) {
+        if (frameCfg.fpsLimit > 0 && g_highResTimer) {
             PROFILE_SCOPE_CAT("FPS Limit Sleep", "Timing");
-
-            const double targetFrameTimeUs = 1000000.0 / targetFPS;
-            const bool isHighFPS = targetFPS > 500;
-
-            std::lock_guard<std::mutex> lock(g_fpsLimitMutex);
-
-            auto targetTime = g_lastFrameEndTime + std::chrono::microseconds(static_cast<long long>(targetFrameTimeUs));
-            auto now = std::chrono::high_resolution_clock::now();
-
-            if (now < targetTime) {
-                auto timeToWaitUs = std::chrono::duration_cast<std::chrono::microseconds>(targetTime - now).count();
-
-                if (isHighFPS) {
-                    if (timeToWaitUs > 1000) {
-                        LARGE_INTEGER dueTime;
-                        dueTime.QuadPart = -static_cast<LONGLONG>(timeToWaitUs);
-
-                        if (SetWaitableTimer(g_highResTimer, &dueTime, 0, NULL, NULL, FALSE)) {
-                            WaitForSingleObject(g_highResTimer, 1000);
-                        }
-                    }
-                } else {
-                    if (timeToWaitUs > 10) {
-                        LARGE_INTEGER dueTime;
-                        dueTime.QuadPart = -static_cast<LONGLONG>(timeToWaitUs * 10LL);
-
-                        if (SetWaitableTimer(g_highResTimer, &dueTime, 0, NULL, NULL, FALSE)) { WaitForSingleObject(g_highResTimer, 1000); }
-                    }
-                }
-
-                g_lastFrameEndTime = targetTime;
-            } else {
-                g_lastFrameEndTime = now;
-            }
+            PaceFrameToFpsLimit(frameCfg);
         }
 
         if (IsModeTransitionActive()) {
@@ -3391,6 +3372,25 @@ BOOL WINAPI hkwglSwapBuffers_ThirdParty(HDC hDc) {
     return SwapBuffersHook_Impl(next, hDc);
 }
 
+// TOOLSCREEN_INPUT_TRACE=1 in the launcher's environment records the session's input to logs\input-trace.bin, for
+// reproducing input bugs through the replay harness.
+static bool IsInputTraceRequested() {
+    size_t valueLength = 0;
+    return getenv_s(&valueLength, nullptr, 0, "TOOLSCREEN_INPUT_TRACE") == 0 && valueLength > 1;
+}
+
+static void SaveInputTraceRecording() {
+    if (!IsInputTraceRecording()) { return; }
+    const std::vector<InputTraceEvent> events = StopInputTraceRecording();
+    if (g_toolscreenPath.empty()) { return; }
+    const std::wstring tracePath = g_toolscreenPath + L"\\logs\\input-trace.bin";
+    if (SaveInputTraceFile(tracePath, events)) {
+        Log("Saved input trace (" + std::to_string(events.size()) + " events) to " + WideToUtf8(tracePath));
+    } else {
+        Log("ERROR: Failed to save input trace to " + WideToUtf8(tracePath));
+    }
+}
+
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved) {
     if (ul_reason_for_call == DLL_PROCESS_ATTACH) {
         DisableThreadLibraryCalls(hModule);
@@ -3399,9 +3399,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         InstallGlobalExceptionHandlers();
 
-        LogCategory("init", "========================================");
-        LogCategory("init", "=== Toolscreen INITIALIZATION START ===");
-        LogCategory("init", "========================================");
+        LOG_CATEGORY(Init, "========================================");
+        LOG_CATEGORY(Init, "=== Toolscreen INITIALIZATION START ===");
+        LOG_CATEGORY(Init, "========================================");
         PrintVersionToStdout();
 
         // Create high-resolution waitable timer for FPS limiting (Windows 10 1803+)
@@ -3411,7 +3411,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                                                 TIMER_ALL_ACCESS
         );
         if (g_highResTimer) {
-            LogCategory("init", "High-resolution waitable timer created successfully for FPS limiting.");
+            LOG_CATEGORY(Init, "High-resolution waitable timer created successfully for FPS limiting.");
         } else {
             Log("Warning: Failed to create high-resolution waitable timer. FPS limiting may be less precise.");
         }
@@ -3488,7 +3488,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
             g_modeFilePath = g_toolscreenPath + L"\\mode.txt";
         }
-        LogCategory("init", "--- DLL instance attached ---");
+        LOG_CATEGORY(Init, "--- DLL instance attached ---");
         LogVersionInfo();
         if (g_toolscreenPath.empty()) { Log("FATAL: Could not get toolscreen directory."); }
         
@@ -3508,28 +3508,28 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             } else {
                 oss << " is outside supported range [1.16.1 - 1.18.2].";
             }
-            LogCategory("init", oss.str());
+            LOG_CATEGORY(Init, oss.str());
         } else {
-            LogCategory("init", "No game version detected from command line.");
+            LOG_CATEGORY(Init, "No game version detected from command line.");
         }
 
         LoadConfig();
 
         LoadLangs();
-        LogCategory("init", "Languages list loaded.");
+        LOG_CATEGORY(Init, "Languages list loaded.");
 
         if (!LoadTranslation(g_config.lang)) {
             Log("FATAL: Could not load translations of " + g_config.lang);
             return TRUE;
         }
-        LogCategory("init", "Loaded translations for language: " + g_config.lang);
+        LOG_CATEGORY(Init, "Loaded translations for language: " + g_config.lang);
 
         WCHAR dir[MAX_PATH];
         if (GetCurrentDirectoryW(MAX_PATH, dir) > 0) {
             g_stateFilePath = std::wstring(dir) + L"\\hermes\\state.json";
             g_hermesAliveFilePath = std::wstring(dir) + L"\\hermes\\alive";
             g_stateOutputFilePath = std::wstring(dir) + L"\\wpstateout.txt";
-            LogCategory("init", "Hermes state path: " + WideToUtf8(g_stateFilePath) +
+            LOG_CATEGORY(Init, "Hermes state path: " + WideToUtf8(g_stateFilePath) +
                                     "; State Output path: " + WideToUtf8(g_stateOutputFilePath));
 
             auto fileExists = [](const std::wstring& path) {
@@ -3540,7 +3540,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             const bool stateOutputPresent = fileExists(g_stateOutputFilePath);
             g_isStateOutputAvailable.store(hermesPresent || stateOutputPresent, std::memory_order_release);
             if (!hermesPresent && !stateOutputPresent) {
-                LogCategory("init",
+                LOG_CATEGORY(Init,
                             "WARNING: neither hermes/state.json nor wpstateout.txt found. Game-state hotkey restrictions "
                             "will not apply until Hermes (recommended) or State Output is installed.");
             }
@@ -3564,7 +3564,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Setting up hooks...");
+        LOG_CATEGORY(Init, "Setting up hooks...");
 
         HMODULE hOpenGL32 = GetModuleHandle(L"opengl32.dll");
         HMODULE hUser32 = GetModuleHandle(L"user32.dll");
@@ -3585,7 +3585,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (IsVersionInRange(g_gameVersion, GameVersion(1, 0, 0), GameVersion(1, 21, 0))) {
             if (HOOK(hOpenGL32, glViewport)) {
                 g_glViewportHookCount.fetch_add(1);
-                LogCategory("init", "Initial glViewport hook created via opengl32.dll");
+                LOG_CATEGORY(Init, "Initial glViewport hook created via opengl32.dll");
             }
         }
         HOOK(hUser32, SetCursorPos);
@@ -3597,7 +3597,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             HOOK(hGlfw, glfwSetInputMode);
             HOOK(hGlfw, glfwSetCursor);
         } else {
-            LogCategory("init", "WARNING: glfw.dll not loaded; skipping glfwSetInputMode hook");
+            LOG_CATEGORY(Init, "WARNING: glfw.dll not loaded; skipping glfwSetInputMode hook");
         }
 #undef HOOK
 
@@ -3605,7 +3605,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (pGlBindFramebuffer != NULL) {
             CreateHookOrDie(pGlBindFramebuffer, &hkglBindFramebuffer, &oglBindFramebuffer, "glBindFramebuffer");
         } else {
-            LogCategory("init",
+            LOG_CATEGORY(Init,
                         "WARNING: glBindFramebuffer not found in opengl32.dll - will attempt to hook via WGL/GLEW after context init");
         }
 
@@ -3613,7 +3613,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         if (pGlBlitNamedFramebuffer != NULL) {
             CreateHookOrDie(pGlBlitNamedFramebuffer, &hkglBlitNamedFramebuffer, &oglBlitNamedFramebuffer, "glBlitNamedFramebuffer");
         } else {
-            LogCategory("init",
+            LOG_CATEGORY(Init,
                         "WARNING: glBlitNamedFramebuffer not found in opengl32.dll - will attempt to hook via GLEW after context init");
         }
 
@@ -3623,7 +3623,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                 g_glBlitFramebufferHooked.store(true, std::memory_order_release);
             }
         } else {
-            LogCategory("init",
+            LOG_CATEGORY(Init,
                         "WARNING: glBlitFramebuffer not found in opengl32.dll - will attempt to hook via WGL/GLEW after context init");
         }
 
@@ -3632,7 +3632,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             return TRUE;
         }
 
-        LogCategory("init", "Hooks enabled.");
+        LOG_CATEGORY(Init, "Hooks enabled.");
 
         // This thread periodically detects those detours (prolog or IAT) and chains behind them.
         g_stopHookCompat.store(false, std::memory_order_release);
@@ -3653,6 +3653,11 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         SaveOriginalKeyRepeatSettings();
 
+        if (IsInputTraceRequested()) {
+            StartInputTraceRecording();
+            Log("Input trace recording enabled (TOOLSCREEN_INPUT_TRACE).");
+        }
+
     } else if (ul_reason_for_call == DLL_PROCESS_DETACH) {
         // We should do MINIMAL cleanup here. Windows will automatically clean up:
         // - GPU resources (driver handles cleanup)
@@ -3675,15 +3680,20 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 
         RestoreKeyRepeatSettings();
 
+        SaveInputTraceRecording();
+
         SaveConfigImmediate();
+        StopConfigPersistenceWorker();
         Log("Config saved.");
 
         // Stop monitoring threads
         g_stopMonitoring = true;
+        WakeFileMonitorThread();
         if (g_monitorThread.joinable()) { g_monitorThread.join(); }
 
         g_stopImageMonitoring = true;
         if (g_imageMonitorThread.joinable()) { g_imageMonitorThread.join(); }
+        StopImageDecodePool();
 
         // Stop hook compatibility monitor thread
         g_stopHookCompat.store(true, std::memory_order_release);
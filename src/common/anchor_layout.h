@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Typed form of the relativeTo strings stored in the config ("topLeftScreen", "centerViewport", "pieLeft", ...).
+// Strings stay the serialized and GUI representation; layout code parses them into an Anchor and solves positions
+// from small lookup tables instead of re-splitting and comparing strings for every placement.
+//
+// Two historical conventions exist and are both preserved:
+//  - mirror style (mirror outputs, mirror groups, capture zones): offsets point inward from the anchored edge, so
+//    x grows leftward on right anchors and y grows upward on bottom anchors. Pie anchors sit on the F3 pie chart.
+//    Unknown strings fall back to bottom-left.
+//  - image style (images, window/browser overlays, ninjabrain overlay): offsets are always added to the anchor
+//    point. Unknown strings fall back to the container origin.
+
+enum class AnchorCorner : std::uint8_t {
+    TopLeft,
+    TopRight,
+    Center,
+    BottomLeft,
+    BottomRight,
+    PieLeft,
+    PieRight,
+    Origin,
+};
+
+enum class AnchorSpace : std::uint8_t {
+    Screen,
+    Viewport,
+};
+
+struct Anchor {
+    AnchorCorner corner = AnchorCorner::TopLeft;
+    AnchorSpace space = AnchorSpace::Screen;
+
+    friend constexpr bool operator==(const Anchor& a, const Anchor& b) { return a.corner == b.corner && a.space == b.space; }
+};
+
+struct AnchorPoint {
+    int x = 0;
+    int y = 0;
+};
+
+// Container a space resolves to: the full screen, or the game viewport at its on-screen offset.
+struct AnchorFrame {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+namespace anchor_layout_detail {
+
+// Base positions a corner can pick from, indexed by AnchorLayoutRow::xBase / yBase.
+enum : std::uint8_t { kBaseZero = 0, kBaseSpan = 1, kBaseHalfSpan = 2, kBasePieLeft = 3, kBasePieRight = 4 };
+enum : std::uint8_t { kBaseYZero = 0, kBaseYSpan = 1, kBaseYHalfSpan = 2, kBaseYPie = 3 };
+
+constexpr int kPieTopFromBottom = 220;
+constexpr int kPieLeftFromRight = 92;
+constexpr int kPieRightFromRight = 36;
+
+struct AnchorLayoutRow {
+    std::uint8_t xBase;
+    std::uint8_t yBase;
+    std::int8_t xSign;
+    std::int8_t ySign;
+};
+
+// Indexed by AnchorCorner.
+constexpr AnchorLayoutRow kMirrorRows[] = {
+    { kBaseZero, kBaseYZero, 1, 1 },         // TopLeft
+    { kBaseSpan, kBaseYZero, -1, 1 },        // TopRight
+    { kBaseHalfSpan, kBaseYHalfSpan, 1, 1 }, // Center
+    { kBaseZero, kBaseYSpan, 1, -1 },        // BottomLeft
+    { kBaseSpan, kBaseYSpan, -1, -1 },       // BottomRight
+    { kBasePieLeft, kBaseYPie, 1, 1 },       // PieLeft
+    { kBasePieRight, kBaseYPie, 1, 1 },      // PieRight
+    { kBaseZero, kBaseYSpan, 1, -1 },        // Origin (mirror parsing never yields it; same as the bottom-left fallback)
+};
+
+constexpr AnchorLayoutRow kImageRows[] = {
+    { kBaseZero, kBaseYZero, 1, 1 },         // TopLeft
+    { kBaseSpan, kBaseYZero, 1, 1 },         // TopRight
+    { kBaseHalfSpan, kBaseYHalfSpan, 1, 1 }, // Center
+    { kBaseZero, kBaseYSpan, 1, 1 },         // BottomLeft
+    { kBaseSpan, kBaseYSpan, 1, 1 },         // BottomRight
+    { kBaseZero, kBaseYZero, 1, 1 },         // PieLeft (image parsing never yields it)
+    { kBaseZero, kBaseYZero, 1, 1 },         // PieRight (image parsing never yields it)
+    { kBaseZero, kBaseYZero, 1, 1 },         // Origin
+};
+
+inline AnchorPoint Solve(const AnchorLayoutRow& row, int relX, int relY, int w, int h, int containerW, int containerH) {
+    const int spanX = containerW - w;
+    const int spanY = containerH - h;
+    const int xBases[] = { 0, spanX, spanX / 2, containerW - kPieLeftFromRight, containerW - kPieRightFromRight };
+    const int yBases[] = { 0, spanY, spanY / 2, containerH - kPieTopFromBottom };
+    return { xBases[row.xBase] + relX * row.xSign, yBases[row.yBase] + relY * row.ySign };
+}
+
+constexpr bool EndsWithSuffix(std::string_view text, std::string_view suffix) {
+    return text.length() > suffix.length() && text.substr(text.length() - suffix.length()) == suffix;
+}
+
+constexpr std::string_view kScreenSuffix = "Screen";
+constexpr std::string_view kViewportSuffix = "Viewport";
+
+} // namespace anchor_layout_detail
+
+// Returns text without the suffix when text ends with it and has something in front of it.
+constexpr std::string_view StripAnchorSuffix(std::string_view text, std::string_view suffix) {
+    return anchor_layout_detail::EndsWithSuffix(text, suffix) ? text.substr(0, text.length() - suffix.length()) : text;
+}
+
+constexpr bool IsScreenAnchorText(std::string_view text) {
+    return anchor_layout_detail::EndsWithSuffix(text, anchor_layout_detail::kScreenSuffix);
+}
+
+constexpr bool IsViewportAnchorText(std::string_view text) {
+    return anchor_layout_detail::EndsWithSuffix(text, anchor_layout_detail::kViewportSuffix);
+}
+
+// Corner of an unsuffixed mirror-style anchor. Classification is by first letter, with the exact name deciding
+// between the two sides, which is how the string comparisons have always treated unexpected spellings.
+constexpr AnchorCorner ClassifyMirrorCorner(std::string_view base) {
+    const char first = base.empty() ? '\0' : base[0];
+    if (first == 't') { return base == "topLeft" ? AnchorCorner::TopLeft : AnchorCorner::TopRight; }
+    if (first == 'c') { return AnchorCorner::Center; }
+    if (first == 'p') { return base == "pieLeft" ? AnchorCorner::PieLeft : AnchorCorner::PieRight; }
+    return base == "bottomRight" ? AnchorCorner::BottomRight : AnchorCorner::BottomLeft;
+}
+
+// Corner of an unsuffixed image-style anchor.
+constexpr AnchorCorner ClassifyImageCorner(std::string_view base) {
+    const char first = base.empty() ? '\0' : base[0];
+    if (first == 't') { return base == "topLeft" ? AnchorCorner::TopLeft : AnchorCorner::TopRight; }
+    if (first == 'c') { return AnchorCorner::Center; }
+    if (first == 'b') { return base == "bottomLeft" ? AnchorCorner::BottomLeft : AnchorCorner::BottomRight; }
+    return AnchorCorner::Origin;
+}
+
+// Mirror-style corner of a possibly suffixed anchor; the space suffix is ignored (capture zones are always
+// resolved against the game).
+constexpr AnchorCorner ParseMirrorCorner(std::string_view text) {
+    if (IsViewportAnchorText(text)) { return ClassifyMirrorCorner(StripAnchorSuffix(text, anchor_layout_detail::kViewportSuffix)); }
+    return ClassifyMirrorCorner(StripAnchorSuffix(text, anchor_layout_detail::kScreenSuffix));
+}
+
+// Mirror output / mirror group anchor: "...Screen" is screen-relative, anything else is viewport-relative.
+constexpr Anchor ParseMirrorAnchor(std::string_view text) {
+    if (IsScreenAnchorText(text)) {
+        return { ParseMirrorCorner(StripAnchorSuffix(text, anchor_layout_detail::kScreenSuffix)), AnchorSpace::Screen };
+    }
+    return { ParseMirrorCorner(StripAnchorSuffix(text, anchor_layout_detail::kViewportSuffix)), AnchorSpace::Viewport };
+}
+
+// Image / overlay anchor: "...Viewport" is viewport-relative, anything else is screen-relative.
+constexpr Anchor ParseImageAnchor(std::string_view text) {
+    if (IsViewportAnchorText(text)) {
+        return { ClassifyImageCorner(StripAnchorSuffix(text, anchor_layout_detail::kViewportSuffix)), AnchorSpace::Viewport };
+    }
+    return { ClassifyImageCorner(StripAnchorSuffix(text, anchor_layout_detail::kScreenSuffix)), AnchorSpace::Screen };
+}
+
+// Top-left of a w x h box anchored inside a containerW x containerH container, relative to the container.
+inline AnchorPoint SolveMirrorAnchor(AnchorCorner corner, int relX, int relY, int w, int h, int containerW, int containerH) {
+    return anchor_layout_detail::Solve(anchor_layout_detail::kMirrorRows[static_cast<std::uint8_t>(corner)], relX, relY, w, h,
+                                       containerW, containerH);
+}
+
+inline AnchorPoint SolveImageAnchor(AnchorCorner corner, int relX, int relY, int w, int h, int containerW, int containerH) {
+    return anchor_layout_detail::Solve(anchor_layout_detail::kImageRows[static_cast<std::uint8_t>(corner)], relX, relY, w, h,
+                                       containerW, containerH);
+}
+
+inline const AnchorFrame& SelectAnchorFrame(AnchorSpace space, const AnchorFrame& screen, const AnchorFrame& viewport) {
+    const AnchorFrame* frames[] = { &screen, &viewport };
+    return *frames[static_cast<std::uint8_t>(space)];
+}
+
+// Absolute screen position of a w x h box for a parsed anchor.
+inline AnchorPoint SolveMirrorAnchorOnScreen(const Anchor& anchor, int relX, int relY, int w, int h, const AnchorFrame& screen,
+                                             const AnchorFrame& viewport) {
+    const AnchorFrame& frame = SelectAnchorFrame(anchor.space, screen, viewport);
+    const AnchorPoint local = SolveMirrorAnchor(anchor.corner, relX, relY, w, h, frame.w, frame.h);
+    return { frame.x + local.x, frame.y + local.y };
+}
+
+inline AnchorPoint SolveImageAnchorOnScreen(const Anchor& anchor, int relX, int relY, int w, int h, const AnchorFrame& screen,
+                                            const AnchorFrame& viewport) {
+    const AnchorFrame& frame = SelectAnchorFrame(anchor.space, screen, viewport);
+    const AnchorPoint local = SolveImageAnchor(anchor.corner, relX, relY, w, h, frame.w, frame.h);
+    return { frame.x + local.x, frame.y + local.y };
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Long-lived background thread that processes only the most recent submitted value.
+//
+// Submit() fills a single pending slot; a value submitted while another is still pending replaces (or is merged
+// into) it, so a burst of requests costs one run of the handler. The worker waits out a short batch window after
+// the first request of a burst before it takes the value (write-behind), which bounds the delay of any request to
+// the window plus one handler run while collapsing the rest of the burst.
+//
+// The handler runs on the worker thread without the lock held and must not throw.
+template <typename T>
+class CoalescingWorker {
+  public:
+    using Handler = std::function<void(T&)>;
+
+    struct Stats {
+        uint64_t submitted = 0;
+        // Submissions folded into a value that was still pending.
+        uint64_t coalesced = 0;
+        uint64_t processed = 0;
+    };
+
+    explicit CoalescingWorker(Handler handler, std::chrono::milliseconds batchWindow = std::chrono::milliseconds(0))
+        : m_handler(std::move(handler)), m_batchWindow(batchWindow) {}
+
+    ~CoalescingWorker() { Stop(); }
+
+    CoalescingWorker(const CoalescingWorker&) = delete;
+    CoalescingWorker& operator=(const CoalescingWorker&) = delete;
+
+    void Submit(T value) {
+        Submit(std::move(value), [](T& pending, T&& incoming) { pending = std::move(incoming); });
+    }
+
+    // merge(pending, std::move(value)) runs under the lock when a value is already pending.
+    template <typename Merge>
+    void Submit(T value, Merge&& merge) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.submitted;
+        if (m_pending) {
+            merge(*m_pending, std::move(value));
+            ++m_stats.coalesced;
+        } else {
+            m_pending.emplace(std::move(value));
+            m_pendingSince = std::chrono::steady_clock::now();
+            m_flushRequested = false;
+        }
+        if (!m_thread.joinable()) {
+            m_stopping = false;
+            m_thread = std::thread([this]() { Run(); });
+        }
+        m_cv.notify_all();
+    }
+
+    // Removes the pending value so the caller can handle it itself, e.g. to write it synchronously.
+    std::optional<T> TakePending() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::optional<T> taken = std::move(m_pending);
+        m_pending.reset();
+        m_cv.notify_all();
+        return taken;
+    }
+
+    // Skips the batch window for the pending value and waits until nothing is pending or running.
+    // A negative timeout waits indefinitely.
+    bool WaitIdle(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_flushRequested = true;
+        m_cv.notify_all();
+        auto idle = [this]() { return !m_pending && !m_running; };
+        if (timeout.count() < 0) {
+            m_cv.wait(lock, idle);
+            return true;
+        }
+        return m_cv.wait_for(lock, timeout, idle);
+    }
+
+    bool IsIdle() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_pending && !m_running;
+    }
+
+    // Processes the pending value, if any, then joins the worker. A later Submit() starts a new thread.
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) { return; }
+            m_stopping = true;
+            m_cv.notify_all();
+        }
+        m_thread.join();
+    }
+
+    Stats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+  private:
+    void Run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cv.wait(lock, [this]() { return m_pending.has_value() || m_stopping; });
+            if (!m_pending) { return; }
+
+            m_cv.wait_until(lock, m_pendingSince + m_batchWindow, [this]() { return m_stopping || m_flushRequested || !m_pending; });
+            if (!m_pending) { continue; }
+
+            T value = std::move(*m_pending);
+            m_pending.reset();
+            m_flushRequested = false;
+            m_running = true;
+            lock.unlock();
+
+            m_handler(value);
+
+            lock.lock();
+            m_running = false;
+            ++m_stats.processed;
+            m_cv.notify_all();
+        }
+    }
+
+    Handler m_handler;
+    const std::chrono::milliseconds m_batchWindow;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::optional<T> m_pending;
+    std::chrono::steady_clock::time_point m_pendingSince{};
+    bool m_running = false;
+    bool m_flushRequested = false;
+    bool m_stopping = false;
+    Stats m_stats;
+    std::thread m_thread;
+};
@@ -0,0 +1,99 @@
+#include "cpu_features.h"
+
+#if TOOLSCREEN_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+#if TOOLSCREEN_SIMD_X86
+    unsigned int leaf1Ecx = 0;
+    unsigned int leaf7Ebx = 0;
+    unsigned int maxLeaf = 0;
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    maxLeaf = static_cast<unsigned int>(regs[0]);
+    if (maxLeaf >= 1) {
+        __cpuid(regs, 1);
+        leaf1Ecx = static_cast<unsigned int>(regs[2]);
+    }
+    if (maxLeaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        leaf7Ebx = static_cast<unsigned int>(regs[1]);
+    }
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    maxLeaf = __get_cpuid_max(0, nullptr);
+    if (maxLeaf >= 1 && __get_cpuid(1, &eax, &ebx, &ecx, &edx)) { leaf1Ecx = ecx; }
+    if (maxLeaf >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) { leaf7Ebx = ebx; }
+#endif
+
+    features.sse41 = (leaf1Ecx & (1u << 19)) != 0;
+
+    // AVX2 also needs the OS to save YMM state (OSXSAVE plus XCR0 bits 1 and 2).
+    const bool osxsave = (leaf1Ecx & (1u << 27)) != 0;
+    const bool avx = (leaf1Ecx & (1u << 28)) != 0;
+    if (osxsave && avx) {
+#if defined(_MSC_VER)
+        const unsigned long long xcr0 = _xgetbv(0);
+#else
+        unsigned int xcr0Lo = 0, xcr0Hi = 0;
+        __asm__ volatile("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+        const unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0Hi) << 32) | xcr0Lo;
+#endif
+        features.avx2 = (xcr0 & 0x6u) == 0x6u && (leaf7Ebx & (1u << 5)) != 0;
+    }
+#endif
+    return features;
+}
+
+const CpuFeatures& GetCpuFeatures() {
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
+
+} // namespace
+
+bool IsSimdLevelSupported(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::Sse41:
+        return GetCpuFeatures().sse41;
+    case SimdLevel::Avx2:
+        return GetCpuFeatures().avx2;
+    default:
+        return false;
+    }
+}
+
+SimdLevel GetBestSimdLevel() {
+    static const SimdLevel level = IsSimdLevelSupported(SimdLevel::Avx2)    ? SimdLevel::Avx2
+                                   : IsSimdLevelSupported(SimdLevel::Sse41) ? SimdLevel::Sse41
+                                                                            : SimdLevel::Scalar;
+    return level;
+}
+
+const char* GetSimdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Sse41:
+        return "SSE4.1";
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Scalar:
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TOOLSCREEN_SIMD_X86 1
+#else
+#define TOOLSCREEN_SIMD_X86 0
+#endif
+
+// MSVC emits any intrinsic regardless of /arch; GCC and Clang need the target enabled per function.
+#if TOOLSCREEN_SIMD_X86 && !defined(_MSC_VER)
+#define TOOLSCREEN_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TOOLSCREEN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TOOLSCREEN_TARGET_SSE41
+#define TOOLSCREEN_TARGET_AVX2
+#endif
+
+// Instruction set tiers the pixel kernels are written for. Every tier produces identical output.
+enum class SimdLevel : std::uint8_t {
+    Scalar,
+    Sse41,
+    Avx2,
+};
+
+bool IsSimdLevelSupported(SimdLevel level);
+// Highest tier the CPU and OS support; detected once on first use.
+SimdLevel GetBestSimdLevel();
+const char* GetSimdLevelName(SimdLevel level);
@@ -0,0 +1,171 @@
+#include "decode_worker_pool.h"
+
+#include <algorithm>
+
+DecodeWorkerPool::DecodeWorkerPool(DecodeWorkerPoolOptions options) : m_options(options) {}
+
+DecodeWorkerPool::~DecodeWorkerPool() { Stop(); }
+
+size_t DecodeWorkerPool::DefaultWorkerCount() {
+    const size_t hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+    return (std::clamp)(hardwareThreads / 2, static_cast<size_t>(1), static_cast<size_t>(4));
+}
+
+void DecodeWorkerPool::Submit(DecodeRequest request) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) { return; }
+    ++m_stats.submitted;
+
+    auto queued = std::find_if(m_queue.begin(), m_queue.end(), [&](const QueuedRequest& entry) { return entry.request.key == request.key; });
+    if (queued != m_queue.end()) {
+        m_queue.erase(queued);
+        ++m_stats.superseded;
+    }
+    auto running = m_runningTokens.find(request.key);
+    if (running != m_runningTokens.end()) {
+        running->second.Cancel();
+        m_runningTokens.erase(running);
+        ++m_stats.cancelledWhileRunning;
+    }
+
+    m_queue.push_back(QueuedRequest{ std::move(request), m_nextSequence++, Clock::now() });
+    m_stats.queued = m_queue.size();
+
+    if (m_threads.empty()) {
+        const size_t workerCount = (std::max)(m_options.workerCount, static_cast<size_t>(1));
+        m_threads.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) { m_threads.emplace_back([this]() { Run(); }); }
+    }
+    m_cv.notify_one();
+}
+
+bool DecodeWorkerPool::WaitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto idle = [this]() { return m_queue.empty() && m_stats.running == 0; };
+    if (timeout.count() < 0) {
+        m_cv.wait(lock, idle);
+        return true;
+    }
+    return m_cv.wait_for(lock, timeout, idle);
+}
+
+void DecodeWorkerPool::Stop() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queue.clear();
+        m_stats.queued = 0;
+        for (auto& [key, token] : m_runningTokens) { token.Cancel(); }
+        m_runningTokens.clear();
+        threads.swap(m_threads);
+        m_cv.notify_all();
+    }
+    for (auto& thread : threads) {
+        if (thread.joinable()) { thread.join(); }
+    }
+}
+
+DecodeWorkerPoolStats DecodeWorkerPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+ptrdiff_t DecodeWorkerPool::PickNextLocked() const {
+    ptrdiff_t best = -1;
+    for (size_t i = 0; i < m_queue.size(); ++i) {
+        const QueuedRequest& candidate = m_queue[i];
+        if (candidate.estimating) { continue; }
+        if (best < 0) {
+            best = static_cast<ptrdiff_t>(i);
+            continue;
+        }
+        const QueuedRequest& current = m_queue[static_cast<size_t>(best)];
+        if (candidate.request.priority > current.request.priority ||
+            (candidate.request.priority == current.request.priority && candidate.sequence < current.sequence)) {
+            best = static_cast<ptrdiff_t>(i);
+        }
+    }
+    return best;
+}
+
+bool DecodeWorkerPool::FitsBudgetLocked(const QueuedRequest& entry) const {
+    return m_stats.inFlightBytes == 0 || m_stats.inFlightBytes + entry.request.estimatedBytes <= m_options.memoryBudgetBytes;
+}
+
+void DecodeWorkerPool::Run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        ptrdiff_t next = -1;
+        m_cv.wait(lock, [&]() {
+            if (m_stopping) { return true; }
+            next = PickNextLocked();
+            if (next < 0) { return false; }
+            QueuedRequest& head = m_queue[static_cast<size_t>(next)];
+            if (head.request.estimateBytes || FitsBudgetLocked(head)) { return true; }
+            // Strictly in priority order: a large head-of-queue request is not starved by smaller ones slipping past it.
+            if (!head.countedBudgetWait) {
+                head.countedBudgetWait = true;
+                ++m_stats.budgetWaits;
+            }
+            return false;
+        });
+        if (m_stopping) { return; }
+
+        QueuedRequest& head = m_queue[static_cast<size_t>(next)];
+        if (head.request.estimateBytes) {
+            // The estimate may read file headers, so it runs unlocked; the request stays queued (and can still be
+            // superseded or dropped by Stop()) and is picked again once its size is known.
+            std::function<size_t()> estimate = std::move(head.request.estimateBytes);
+            head.request.estimateBytes = nullptr;
+            head.estimating = true;
+            const uint64_t sequence = head.sequence;
+            lock.unlock();
+
+            const size_t estimatedBytes = estimate();
+
+            lock.lock();
+            auto estimated = std::find_if(m_queue.begin(), m_queue.end(), [&](const QueuedRequest& entry) { return entry.sequence == sequence; });
+            if (estimated != m_queue.end()) {
+                estimated->request.estimatedBytes = estimatedBytes;
+                estimated->estimating = false;
+            }
+            m_cv.notify_all();
+            continue;
+        }
+
+        QueuedRequest entry = std::move(m_queue[static_cast<size_t>(next)]);
+        m_queue.erase(m_queue.begin() + next);
+        DecodeCancelToken token;
+        m_runningTokens[entry.request.key] = token;
+        const size_t reserved = entry.request.estimatedBytes;
+        m_stats.inFlightBytes += reserved;
+        m_stats.peakInFlightBytes = (std::max)(m_stats.peakInFlightBytes, m_stats.inFlightBytes);
+        m_stats.queued = m_queue.size();
+        ++m_stats.running;
+
+        const Clock::time_point startedAt = Clock::now();
+        lock.unlock();
+
+        entry.request.work(token);
+
+        const Clock::time_point finishedAt = Clock::now();
+        lock.lock();
+        auto running = m_runningTokens.find(entry.request.key);
+        if (running != m_runningTokens.end() && running->second == token) { m_runningTokens.erase(running); }
+        m_stats.inFlightBytes -= reserved;
+        --m_stats.running;
+
+        const double queueMs = std::chrono::duration<double, std::milli>(startedAt - entry.submittedAt).count();
+        const double decodeMs = std::chrono::duration<double, std::milli>(finishedAt - startedAt).count();
+        DecodeFormatStats& format = m_stats.formats[entry.request.format];
+        ++format.decoded;
+        format.totalQueueMs += queueMs;
+        format.maxQueueMs = (std::max)(format.maxQueueMs, queueMs);
+        format.totalDecodeMs += decodeMs;
+        format.maxDecodeMs = (std::max)(format.maxDecodeMs, decodeMs);
+
+        // Freed budget may let a waiting request start, and WaitIdle() callers need to re-check.
+        m_cv.notify_all();
+    }
+}
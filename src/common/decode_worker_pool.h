@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of threads for decoding visual media off the render thread.
+//
+// Requests run highest priority first (FIFO among equal priorities). A request submitted for a key that already has
+// one queued replaces it, and one that is already decoding is flagged as cancelled so it drops its result instead of
+// publishing a stale image over the newer one. Each request reserves its estimated decoded size against a shared
+// memory budget while it runs; the next request waits when it would exceed the budget, unless nothing else is in
+// flight (so a single oversized image still loads). Estimates that need file I/O are computed on a pool thread before
+// the request is scheduled, never on the submitting thread.
+
+class DecodeCancelToken {
+  public:
+    DecodeCancelToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    bool IsCancelled() const { return m_flag->load(std::memory_order_acquire); }
+    void Cancel() const { m_flag->store(true, std::memory_order_release); }
+
+    bool operator==(const DecodeCancelToken& other) const { return m_flag == other.m_flag; }
+
+  private:
+    std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+struct DecodeRequest {
+    // Requests with the same key supersede each other.
+    std::string key;
+    int priority = 0;
+    size_t estimatedBytes = 0;
+    // Optional. Runs on a pool thread before the request is scheduled and replaces estimatedBytes. Must not throw.
+    std::function<size_t()> estimateBytes;
+    // Metrics bucket, e.g. "png", "gif", "mpeg1".
+    std::string format;
+    // Runs on a pool thread. Must not throw; should check the token before publishing its result.
+    std::function<void(const DecodeCancelToken&)> work;
+};
+
+struct DecodeFormatStats {
+    uint64_t decoded = 0;
+    double totalQueueMs = 0.0;
+    double maxQueueMs = 0.0;
+    double totalDecodeMs = 0.0;
+    double maxDecodeMs = 0.0;
+};
+
+struct DecodeWorkerPoolStats {
+    uint64_t submitted = 0;
+    // Queued requests dropped because a newer one arrived for the same key.
+    uint64_t superseded = 0;
+    // Running requests flagged as cancelled for the same reason.
+    uint64_t cancelledWhileRunning = 0;
+    // Requests that had to wait for in-flight decodes to release budget, each counted once.
+    uint64_t budgetWaits = 0;
+    size_t queued = 0;
+    size_t running = 0;
+    size_t inFlightBytes = 0;
+    size_t peakInFlightBytes = 0;
+    std::map<std::string, DecodeFormatStats> formats;
+};
+
+struct DecodeWorkerPoolOptions {
+    size_t workerCount = 2;
+    size_t memoryBudgetBytes = 768ull * 1024ull * 1024ull;
+};
+
+class DecodeWorkerPool {
+  public:
+    explicit DecodeWorkerPool(DecodeWorkerPoolOptions options = {});
+    ~DecodeWorkerPool();
+
+    DecodeWorkerPool(const DecodeWorkerPool&) = delete;
+    DecodeWorkerPool& operator=(const DecodeWorkerPool&) = delete;
+
+    // Threads are started on the first submission. Ignored after Stop().
+    void Submit(DecodeRequest request);
+
+    // Waits until nothing is queued or running. A negative timeout waits indefinitely.
+    bool WaitIdle(std::chrono::milliseconds timeout);
+
+    // Drops queued requests, cancels running ones and joins the threads.
+    void Stop();
+
+    DecodeWorkerPoolStats GetStats() const;
+
+    // Half the hardware threads, between 1 and 4: decoding is mostly disk and allocator bound past that.
+    static size_t DefaultWorkerCount();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct QueuedRequest {
+        DecodeRequest request;
+        uint64_t sequence = 0;
+        Clock::time_point submittedAt{};
+        // estimateBytes is running on a pool thread; the request is not scheduled until it returns.
+        bool estimating = false;
+        bool countedBudgetWait = false;
+    };
+
+    void Run();
+    // Index of the highest-priority request not being estimated, or -1 when there is none.
+    ptrdiff_t PickNextLocked() const;
+    bool FitsBudgetLocked(const QueuedRequest& entry) const;
+
+    const DecodeWorkerPoolOptions m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<QueuedRequest> m_queue;
+    std::map<std::string, DecodeCancelToken> m_runningTokens;
+    std::vector<std::thread> m_threads;
+    uint64_t m_nextSequence = 0;
+    bool m_stopping = false;
+    DecodeWorkerPoolStats m_stats;
+};
@@ -0,0 +1,258 @@
+#include "directory_watcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace file_watch {
+namespace {
+
+std::vector<std::filesystem::path> ParentDirectories(const std::vector<std::filesystem::path>& files) {
+    std::vector<std::filesystem::path> directories;
+    for (const auto& file : files) {
+        std::filesystem::path directory = file.parent_path();
+        if (directory.empty()) { continue; }
+        if (std::find(directories.begin(), directories.end(), directory) == directories.end()) {
+            directories.push_back(std::move(directory));
+        }
+    }
+    return directories;
+}
+
+std::vector<std::filesystem::path> ExistingDirectories(const std::vector<std::filesystem::path>& directories) {
+    std::vector<std::filesystem::path> existing;
+    for (const auto& directory : directories) {
+        std::error_code error;
+        if (std::filesystem::is_directory(directory, error)) { existing.push_back(directory); }
+    }
+    return existing;
+}
+
+#ifdef _WIN32
+
+class DirectoryChangeWatcher final : public DirectoryWatcher {
+  public:
+    ~DirectoryChangeWatcher() override {
+        for (HANDLE handle : m_handles) {
+            if (handle == m_wakeEvent) {
+                CloseHandle(handle);
+            } else {
+                FindCloseChangeNotification(handle);
+            }
+        }
+    }
+
+    bool Init(const std::vector<std::filesystem::path>& directories) {
+        // One wait slot is taken by the wake event; beyond that the owner falls back to polling.
+        if (directories.size() + 1 > MAXIMUM_WAIT_OBJECTS) { return false; }
+        m_wakeEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+        if (!m_wakeEvent) { return false; }
+        m_handles.push_back(m_wakeEvent);
+        for (const auto& directory : directories) {
+            HANDLE handle = FindFirstChangeNotificationW(directory.c_str(), FALSE,
+                                                         FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                                             FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+            if (handle != INVALID_HANDLE_VALUE) { m_handles.push_back(handle); }
+        }
+        return m_handles.size() > 1;
+    }
+
+    bool WaitForChange(std::chrono::milliseconds timeout) override {
+        const DWORD timeoutMs = static_cast<DWORD>((std::max)(timeout, std::chrono::milliseconds(0)).count());
+        const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(m_handles.size()), m_handles.data(), FALSE, timeoutMs);
+        if (result <= WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + m_handles.size()) { return false; }
+        FindNextChangeNotification(m_handles[result - WAIT_OBJECT_0]);
+        return true;
+    }
+
+    void Wake() override { SetEvent(m_wakeEvent); }
+
+    bool IsEventDriven() const override { return true; }
+
+  private:
+    HANDLE m_wakeEvent = NULL;
+    // m_handles[0] is the wake event, the rest are change notification handles.
+    std::vector<HANDLE> m_handles;
+};
+
+#else
+
+class InotifyWatcher final : public DirectoryWatcher {
+  public:
+    ~InotifyWatcher() override {
+        if (m_inotifyFd >= 0) { close(m_inotifyFd); }
+        if (m_wakeFd >= 0) { close(m_wakeFd); }
+    }
+
+    bool Init(const std::vector<std::filesystem::path>& directories, const std::vector<std::filesystem::path>& files) {
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_inotifyFd < 0 || m_wakeFd < 0) { return false; }
+
+        // Only events for the watched files, or for their directories appearing, count as changes.
+        for (const auto& file : files) {
+            m_relevantNames.push_back(file.filename().string());
+            m_relevantNames.push_back(file.parent_path().filename().string());
+        }
+
+        bool watchedAny = false;
+        for (const auto& directory : directories) {
+            const uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+            watchedAny |= inotify_add_watch(m_inotifyFd, directory.c_str(), mask) >= 0;
+        }
+        return watchedAny;
+    }
+
+    bool WaitForChange(std::chrono::milliseconds timeout) override {
+        pollfd fds[2] = { { m_inotifyFd, POLLIN, 0 }, { m_wakeFd, POLLIN, 0 } };
+        const int timeoutMs = static_cast<int>((std::max)(timeout, std::chrono::milliseconds(0)).count());
+        if (poll(fds, 2, timeoutMs) <= 0) { return false; }
+
+        if (fds[1].revents & POLLIN) {
+            uint64_t count = 0;
+            (void)!read(m_wakeFd, &count, sizeof(count));
+        }
+        return (fds[0].revents & POLLIN) && DrainEvents();
+    }
+
+    void Wake() override {
+        const uint64_t one = 1;
+        (void)!write(m_wakeFd, &one, sizeof(one));
+    }
+
+    bool IsEventDriven() const override { return true; }
+
+  private:
+    bool DrainEvents() {
+        alignas(inotify_event) char buffer[4096];
+        bool relevant = false;
+        for (;;) {
+            const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) { break; }
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if ((event->mask & IN_Q_OVERFLOW) || event->len == 0) {
+                    relevant = true;
+                } else {
+                    const std::string name(event->name);
+                    relevant |= std::find(m_relevantNames.begin(), m_relevantNames.end(), name) != m_relevantNames.end();
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return relevant;
+    }
+
+    int m_inotifyFd = -1;
+    int m_wakeFd = -1;
+    std::vector<std::string> m_relevantNames;
+};
+
+#endif
+
+class PollingWatcher final : public DirectoryWatcher {
+  public:
+    PollingWatcher(std::vector<std::filesystem::path> files, std::chrono::milliseconds interval)
+        : m_files(std::move(files)), m_interval(interval), m_stamps(m_files.size()) {
+        Sample();
+    }
+
+    bool WaitForChange(std::chrono::milliseconds timeout) override {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            const auto now = std::chrono::steady_clock::now();
+            const auto step = (std::min)(std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_interval),
+                                         (std::max)(deadline - now, std::chrono::steady_clock::duration::zero()));
+            if (m_cv.wait_for(lock, step, [this]() { return m_woken; })) {
+                m_woken = false;
+                return false;
+            }
+            if (Sample()) { return true; }
+            if (std::chrono::steady_clock::now() >= deadline) { return false; }
+        }
+    }
+
+    void Wake() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_woken = true;
+        m_cv.notify_all();
+    }
+
+    bool IsEventDriven() const override { return false; }
+
+  private:
+    struct Stamp {
+        bool exists = false;
+        std::filesystem::file_time_type writeTime{};
+        uintmax_t size = 0;
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    // Refreshes every stamp; true when any of them changed.
+    bool Sample() {
+        bool changed = false;
+        for (size_t i = 0; i < m_files.size(); ++i) {
+            Stamp stamp;
+            std::error_code error;
+            stamp.writeTime = std::filesystem::last_write_time(m_files[i], error);
+            if (!error) { stamp.size = std::filesystem::file_size(m_files[i], error); }
+            stamp.exists = !error;
+            if (!stamp.exists) { stamp = Stamp{}; }
+            changed |= !(stamp == m_stamps[i]);
+            m_stamps[i] = stamp;
+        }
+        return changed;
+    }
+
+    std::vector<std::filesystem::path> m_files;
+    std::chrono::milliseconds m_interval;
+    std::vector<Stamp> m_stamps;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_woken = false;
+};
+
+}  // namespace
+
+std::vector<std::filesystem::path> ExistingParentDirectories(const std::vector<std::filesystem::path>& files) {
+    return ExistingDirectories(ParentDirectories(files));
+}
+
+std::unique_ptr<DirectoryWatcher> CreateNotifyingDirectoryWatcher(const std::vector<std::filesystem::path>& files) {
+    const std::vector<std::filesystem::path> directories = ExistingParentDirectories(files);
+    if (directories.empty()) { return nullptr; }
+#ifdef _WIN32
+    auto watcher = std::make_unique<DirectoryChangeWatcher>();
+    if (!watcher->Init(directories)) { return nullptr; }
+#else
+    auto watcher = std::make_unique<InotifyWatcher>();
+    if (!watcher->Init(directories, files)) { return nullptr; }
+#endif
+    return watcher;
+}
+
+std::unique_ptr<DirectoryWatcher> CreatePollingDirectoryWatcher(const std::vector<std::filesystem::path>& files,
+                                                                std::chrono::milliseconds interval) {
+    return std::make_unique<PollingWatcher>(files, interval);
+}
+
+std::unique_ptr<DirectoryWatcher> CreateDirectoryWatcher(const std::vector<std::filesystem::path>& files,
+                                                         std::chrono::milliseconds pollingInterval) {
+    if (auto watcher = CreateNotifyingDirectoryWatcher(files)) { return watcher; }
+    return CreatePollingDirectoryWatcher(files, pollingInterval);
+}
+
+}  // namespace file_watch
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace file_watch {
+
+// Wakes its owner when one of a set of files may have changed.
+class DirectoryWatcher {
+  public:
+    virtual ~DirectoryWatcher() = default;
+
+    // Blocks until a watched file may have changed (true), or the timeout elapses or Wake() is called (false).
+    // Notifications are coalesced and can be spurious, so callers still compare what they read.
+    virtual bool WaitForChange(std::chrono::milliseconds timeout) = 0;
+
+    // Makes a blocked WaitForChange() return. Safe to call from any thread.
+    virtual void Wake() = 0;
+
+    virtual bool IsEventDriven() const = 0;
+};
+
+// Parent directories of files that currently exist, without duplicates.
+std::vector<std::filesystem::path> ExistingParentDirectories(const std::vector<std::filesystem::path>& files);
+
+// Change notifications with one handle per directory holding files: FindFirstChangeNotification on Windows, inotify
+// on Linux. Directories that do not exist yet are skipped. Returns nullptr when no directory could be watched.
+std::unique_ptr<DirectoryWatcher> CreateNotifyingDirectoryWatcher(const std::vector<std::filesystem::path>& files);
+
+// Compares the size and write time of files every interval.
+std::unique_ptr<DirectoryWatcher> CreatePollingDirectoryWatcher(const std::vector<std::filesystem::path>& files,
+                                                                std::chrono::milliseconds interval);
+
+// The notifying watcher, or the polling one when notifications are unavailable.
+std::unique_ptr<DirectoryWatcher> CreateDirectoryWatcher(const std::vector<std::filesystem::path>& files,
+                                                         std::chrono::milliseconds pollingInterval);
+
+}  // namespace file_watch
@@ -2,9 +2,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cmath>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -367,4 +372,316 @@ bool ValidateExpression(const std::string& expr, std::string& errorOut) {
 
     errorOut.clear();
     return true;
-}
\ No newline at end of file
+}
+// Mirrors ExpressionParser's grammar, but emits postfix code instead of evaluating and
+// reports errors through the return value instead of exceptions.
+class ExpressionCompiler {
+public:
+    using Op = CompiledExpression::Op;
+
+    ExpressionCompiler(std::string_view input, CompiledExpression& target) : m_input(input), m_target(target) {}
+
+    bool compile(std::string& error) {
+        m_target.m_code.clear();
+        m_target.m_maxStackDepth = 0;
+        m_depth = 0;
+        advance();
+        if (m_current.kind == ExprTokenKind::End) return fail("Expression cannot be empty", error);
+        if (!parseExpression()) return fail(m_error, error);
+        if (m_current.kind != ExprTokenKind::End) return fail("Unexpected token at end: " + std::string(m_current.text), error);
+        return true;
+    }
+
+private:
+    struct Token {
+        ExprTokenKind kind = ExprTokenKind::End;
+        std::string_view text;
+        double numValue = 0.0;
+    };
+
+    bool fail(const std::string& message, std::string& error) {
+        error = message;
+        m_target.m_code.clear();
+        return false;
+    }
+
+    bool setError(std::string message) {
+        if (m_error.empty()) m_error = std::move(message);
+        return false;
+    }
+
+    void advance() {
+        while (m_pos < m_input.size() && std::isspace(static_cast<unsigned char>(m_input[m_pos]))) ++m_pos;
+        m_current = Token{};
+        if (m_pos >= m_input.size()) return;
+
+        const size_t start = m_pos;
+        const char c = m_input[m_pos];
+        const auto single = [&](ExprTokenKind kind) {
+            ++m_pos;
+            m_current.kind = kind;
+            m_current.text = m_input.substr(start, 1);
+        };
+        switch (c) {
+        case '+': return single(ExprTokenKind::Plus);
+        case '-': return single(ExprTokenKind::Minus);
+        case '*': return single(ExprTokenKind::Star);
+        case '/': return single(ExprTokenKind::Slash);
+        case '(': return single(ExprTokenKind::LParen);
+        case ')': return single(ExprTokenKind::RParen);
+        case ',': return single(ExprTokenKind::Comma);
+        default: break;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            bool hasDecimal = false;
+            while (m_pos < m_input.size()) {
+                const char current = m_input[m_pos];
+                if (!std::isdigit(static_cast<unsigned char>(current)) && current != '.') break;
+                if (current == '.') {
+                    if (hasDecimal) break;
+                    hasDecimal = true;
+                }
+                ++m_pos;
+            }
+            m_current.text = m_input.substr(start, m_pos - start);
+            const char* first = m_current.text.data();
+            const char* last = first + m_current.text.size();
+            const auto parsed = std::from_chars(first, last, m_current.numValue, std::chars_format::fixed);
+            m_current.kind = (parsed.ec == std::errc() && parsed.ptr == last) ? ExprTokenKind::Number : ExprTokenKind::Invalid;
+            return;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            while (m_pos < m_input.size()) {
+                const char current = m_input[m_pos];
+                if (!std::isalnum(static_cast<unsigned char>(current)) && current != '_') break;
+                ++m_pos;
+            }
+            m_current.kind = ExprTokenKind::Identifier;
+            m_current.text = m_input.substr(start, m_pos - start);
+            return;
+        }
+
+        ++m_pos;
+        m_current.kind = ExprTokenKind::Invalid;
+        m_current.text = m_input.substr(start, 1);
+    }
+
+    void emit(Op op, int stackDelta, double value = 0.0) {
+        m_target.m_code.push_back({ op, value });
+        m_depth += stackDelta;
+        m_target.m_maxStackDepth = (std::max)(m_target.m_maxStackDepth, static_cast<size_t>(m_depth));
+    }
+
+    bool parseExpression() {
+        if (!parseTerm()) return false;
+        while (m_current.kind == ExprTokenKind::Plus || m_current.kind == ExprTokenKind::Minus) {
+            const ExprTokenKind op = m_current.kind;
+            advance();
+            if (!parseTerm()) return false;
+            emit(op == ExprTokenKind::Plus ? Op::Add : Op::Subtract, -1);
+        }
+        return true;
+    }
+
+    bool parseTerm() {
+        if (!parseUnary()) return false;
+        while (m_current.kind == ExprTokenKind::Star || m_current.kind == ExprTokenKind::Slash) {
+            const ExprTokenKind op = m_current.kind;
+            advance();
+            if (!parseUnary()) return false;
+            emit(op == ExprTokenKind::Star ? Op::Multiply : Op::Divide, -1);
+        }
+        return true;
+    }
+
+    bool parseUnary() {
+        if (m_current.kind == ExprTokenKind::Minus) {
+            advance();
+            if (!parseUnary()) return false;
+            emit(Op::Negate, 0);
+            return true;
+        }
+        if (m_current.kind == ExprTokenKind::Plus) {
+            advance();
+            return parseUnary();
+        }
+        return parsePrimary();
+    }
+
+    bool parsePrimary() {
+        if (m_current.kind == ExprTokenKind::Number) {
+            emit(Op::PushConstant, 1, m_current.numValue);
+            advance();
+            return true;
+        }
+
+        if (m_current.kind == ExprTokenKind::Identifier) {
+            const std::string_view identifier = m_current.text;
+            advance();
+            if (m_current.kind == ExprTokenKind::LParen) return parseFunctionCall(identifier);
+            if (identifier == "screenWidth") {
+                emit(Op::PushScreenWidth, 1);
+                return true;
+            }
+            if (identifier == "screenHeight") {
+                emit(Op::PushScreenHeight, 1);
+                return true;
+            }
+            return setError("Unknown variable: " + std::string(identifier));
+        }
+
+        if (m_current.kind == ExprTokenKind::LParen) {
+            advance();
+            if (!parseExpression()) return false;
+            if (m_current.kind != ExprTokenKind::RParen) return setError("Expected ')'");
+            advance();
+            return true;
+        }
+
+        return setError("Unexpected token: " + std::string(m_current.text));
+    }
+
+    bool parseFunctionCall(std::string_view functionName) {
+        advance();
+
+        size_t argCount = 0;
+        if (m_current.kind != ExprTokenKind::RParen) {
+            if (!parseExpression()) return false;
+            ++argCount;
+            while (m_current.kind == ExprTokenKind::Comma) {
+                advance();
+                if (!parseExpression()) return false;
+                ++argCount;
+            }
+        }
+        if (m_current.kind != ExprTokenKind::RParen) return setError("Expected ')' after function arguments");
+        advance();
+
+        struct FunctionInfo {
+            std::string_view name;
+            Op op;
+            size_t argCount;
+        };
+        static constexpr FunctionInfo kFunctions[] = {
+            { "min", Op::Min, 2 },     { "max", Op::Max, 2 },     { "floor", Op::Floor, 1 },         { "ceil", Op::Ceil, 1 },
+            { "round", Op::Round, 1 }, { "abs", Op::Abs, 1 },     { "roundEven", Op::RoundEven, 1 },
+        };
+        for (const FunctionInfo& function : kFunctions) {
+            if (function.name != functionName) continue;
+            if (argCount != function.argCount) {
+                return setError(std::string(functionName) + "() requires " + std::to_string(function.argCount) +
+                                (function.argCount == 1 ? " argument" : " arguments"));
+            }
+            emit(function.op, 1 - static_cast<int>(argCount));
+            return true;
+        }
+        return setError("Unknown function: " + std::string(functionName));
+    }
+
+    std::string_view m_input;
+    size_t m_pos = 0;
+    Token m_current;
+    CompiledExpression& m_target;
+    int m_depth = 0;
+    std::string m_error;
+};
+
+bool CompiledExpression::Compile(const std::string& expr, std::string* errorOut) {
+    std::string error;
+    ExpressionCompiler compiler(expr, *this);
+    m_valid = compiler.compile(error);
+    m_memo.store(0, std::memory_order_relaxed);
+    if (errorOut) *errorOut = error;
+    return m_valid;
+}
+
+bool CompiledExpression::TryEvaluate(int screenWidth, int screenHeight, double& out) const {
+    if (!m_valid) return false;
+
+    constexpr size_t kInlineStackDepth = 32;
+    double inlineStack[kInlineStackDepth];
+    std::vector<double> overflowStack;
+    double* stack = inlineStack;
+    if (m_maxStackDepth > kInlineStackDepth) {
+        overflowStack.resize(m_maxStackDepth);
+        stack = overflowStack.data();
+    }
+
+    size_t top = 0;
+    for (const Instruction& instruction : m_code) {
+        switch (instruction.op) {
+        case Op::PushConstant: stack[top++] = instruction.value; break;
+        case Op::PushScreenWidth: stack[top++] = static_cast<double>(screenWidth); break;
+        case Op::PushScreenHeight: stack[top++] = static_cast<double>(screenHeight); break;
+        case Op::Add: --top; stack[top - 1] = stack[top - 1] + stack[top]; break;
+        case Op::Subtract: --top; stack[top - 1] = stack[top - 1] - stack[top]; break;
+        case Op::Multiply: --top; stack[top - 1] = stack[top - 1] * stack[top]; break;
+        case Op::Divide:
+            --top;
+            if (stack[top] == 0.0) return false;
+            stack[top - 1] = stack[top - 1] / stack[top];
+            break;
+        case Op::Negate: stack[top - 1] = -stack[top - 1]; break;
+        case Op::Min: --top; stack[top - 1] = (std::min)(stack[top - 1], stack[top]); break;
+        case Op::Max: --top; stack[top - 1] = (std::max)(stack[top - 1], stack[top]); break;
+        case Op::Floor: stack[top - 1] = std::floor(stack[top - 1]); break;
+        case Op::Ceil: stack[top - 1] = std::ceil(stack[top - 1]); break;
+        case Op::Round: stack[top - 1] = std::round(stack[top - 1]); break;
+        case Op::Abs: stack[top - 1] = std::abs(stack[top - 1]); break;
+        case Op::RoundEven: stack[top - 1] = std::ceil(stack[top - 1] / 2.0) * 2.0; break;
+        }
+    }
+
+    out = stack[0];
+    return true;
+}
+
+int CompiledExpression::Evaluate(int screenWidth, int screenHeight, int defaultValue) const {
+    if (!m_valid) return defaultValue;
+
+    // Failed evaluations are remembered as INT32_MIN so the caller's default still applies.
+    constexpr uint32_t kFailedResult = 0x80000000u;
+    const bool memoizable = screenWidth > 0 && screenWidth <= 0xFFFF && screenHeight > 0 && screenHeight <= 0xFFFF;
+    const uint64_t key = (static_cast<uint64_t>(screenWidth) << 16) | static_cast<uint64_t>(screenHeight);
+    if (memoizable) {
+        const uint64_t memo = m_memo.load(std::memory_order_relaxed);
+        if ((memo >> 32) == key) {
+            const uint32_t stored = static_cast<uint32_t>(memo);
+            return stored == kFailedResult ? defaultValue : static_cast<int>(static_cast<int32_t>(stored));
+        }
+    }
+
+    double value = 0.0;
+    const bool ok = TryEvaluate(screenWidth, screenHeight, value);
+    const int result = ok ? static_cast<int>(std::floor(value)) : defaultValue;
+    const uint32_t stored = ok ? static_cast<uint32_t>(result) : kFailedResult;
+    if (memoizable && (!ok || stored != kFailedResult)) m_memo.store((key << 32) | stored, std::memory_order_relaxed);
+    return result;
+}
+
+std::shared_ptr<const CompiledExpression> GetCompiledExpression(const std::string& expr) {
+    struct Cache {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const CompiledExpression>> entries;
+    };
+    // Bounded so that expressions typed live in the GUI cannot grow the cache without limit.
+    constexpr size_t kMaxCachedExpressions = 256;
+    static Cache cache;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(cache.mutex);
+        auto it = cache.entries.find(expr);
+        if (it != cache.entries.end()) return it->second;
+    }
+
+    auto compiled = std::make_shared<const CompiledExpression>(expr);
+    std::unique_lock<std::shared_mutex> lock(cache.mutex);
+    if (cache.entries.size() >= kMaxCachedExpressions) cache.entries.clear();
+    return cache.entries.try_emplace(expr, std::move(compiled)).first->second;
+}
+
+int EvaluateExpressionCached(const std::string& expr, int screenWidth, int screenHeight, int defaultValue) {
+    return GetCompiledExpression(expr)->Evaluate(screenWidth, screenHeight, defaultValue);
+}
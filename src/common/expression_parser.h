@@ -1,7 +1,68 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 int EvaluateExpression(const std::string& expr, int screenWidth, int screenHeight, int defaultValue = 0);
 bool IsExpression(const std::string& str);
-bool ValidateExpression(const std::string& expr, std::string& errorOut);
\ No newline at end of file
+bool ValidateExpression(const std::string& expr, std::string& errorOut);
+
+// An expression parsed once into postfix bytecode with screenWidth/screenHeight and the
+// function names already resolved. Evaluate does not allocate and remembers the result for
+// the last screen size it was called with.
+class CompiledExpression {
+public:
+    CompiledExpression() = default;
+    explicit CompiledExpression(const std::string& expr) { Compile(expr); }
+
+    CompiledExpression(const CompiledExpression&) = delete;
+    CompiledExpression& operator=(const CompiledExpression&) = delete;
+
+    bool Compile(const std::string& expr, std::string* errorOut = nullptr);
+    bool IsValid() const { return m_valid; }
+
+    // Same result as EvaluateExpression(expr, screenWidth, screenHeight, defaultValue).
+    int Evaluate(int screenWidth, int screenHeight, int defaultValue = 0) const;
+    // Unrounded value; false when the expression is invalid or divides by zero.
+    bool TryEvaluate(int screenWidth, int screenHeight, double& out) const;
+
+private:
+    enum class Op : uint8_t {
+        PushConstant,
+        PushScreenWidth,
+        PushScreenHeight,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negate,
+        Min,
+        Max,
+        Floor,
+        Ceil,
+        Round,
+        Abs,
+        RoundEven
+    };
+
+    struct Instruction {
+        Op op = Op::PushConstant;
+        double value = 0.0;
+    };
+
+    friend class ExpressionCompiler;
+
+    std::vector<Instruction> m_code;
+    size_t m_maxStackDepth = 0;
+    bool m_valid = false;
+    // (width << 16 | height) << 32 | result, for screen sizes that fit in 16 bits.
+    mutable std::atomic<uint64_t> m_memo{ 0 };
+};
+
+// EvaluateExpression backed by a process-wide cache of compiled expressions keyed by the
+// expression text. Use this on paths that re-evaluate the same config strings repeatedly.
+int EvaluateExpressionCached(const std::string& expr, int screenWidth, int screenHeight, int defaultValue = 0);
+std::shared_ptr<const CompiledExpression> GetCompiledExpression(const std::string& expr);
@@ -0,0 +1,170 @@
+#include "file_watch_registry.h"
+
+#include <fstream>
+#include <set>
+#include <system_error>
+
+namespace file_watch {
+
+bool HashFileContents(const std::filesystem::path& path, uint64_t& outSize, uint64_t& outHash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) { return false; }
+
+    uint64_t hash = 14695981039346656037ull;
+    uint64_t size = 0;
+    char buffer[64 * 1024];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        const std::streamsize count = in.gcount();
+        for (std::streamsize i = 0; i < count; ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+        size += static_cast<uint64_t>(count);
+    }
+    if (in.bad()) { return false; }
+
+    outSize = size;
+    outHash = hash;
+    return true;
+}
+
+FileWatchRegistry::FileWatchRegistry(std::chrono::milliseconds debounce) : m_debounce(debounce) {}
+
+FileWatchRegistry::Stamp FileWatchRegistry::StatFile(const std::filesystem::path& path) {
+    Stamp stamp;
+    std::error_code error;
+    stamp.writeTime = std::filesystem::last_write_time(path, error);
+    if (error) { return Stamp{}; }
+    stamp.size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+    if (error) { return Stamp{}; }
+    stamp.exists = true;
+    return stamp;
+}
+
+FileWatchRegistry::Content FileWatchRegistry::ReadContent(const std::filesystem::path& path) {
+    Content content;
+    content.exists = HashFileContents(path, content.size, content.hash);
+    return content;
+}
+
+FileWatchRegistry::SubscriptionId FileWatchRegistry::Subscribe(const std::filesystem::path& path, Callback callback) {
+    const std::filesystem::path key = path.lexically_normal();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_files.try_emplace(key);
+    WatchedFile& file = it->second;
+    if (inserted) {
+        file.observed = StatFile(key);
+        if (file.observed.exists) {
+            file.delivered = ReadContent(key);
+            ++m_stats.filesHashed;
+        }
+    }
+
+    const SubscriptionId id = m_nextId++;
+    file.subscribers.emplace(id, std::move(callback));
+    m_subscriptionPaths.emplace(id, key);
+    return id;
+}
+
+void FileWatchRegistry::Unsubscribe(SubscriptionId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto pathIt = m_subscriptionPaths.find(id);
+    if (pathIt == m_subscriptionPaths.end()) { return; }
+    auto fileIt = m_files.find(pathIt->second);
+    m_subscriptionPaths.erase(pathIt);
+    if (fileIt == m_files.end()) { return; }
+    fileIt->second.subscribers.erase(id);
+    if (fileIt->second.subscribers.empty()) { m_files.erase(fileIt); }
+}
+
+std::vector<std::filesystem::path> FileWatchRegistry::WatchedFiles() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::filesystem::path> files;
+    files.reserve(m_files.size());
+    for (const auto& [key, file] : m_files) { files.push_back(key); }
+    return files;
+}
+
+std::vector<std::filesystem::path> FileWatchRegistry::WatchedDirectories() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::set<std::filesystem::path> directories;
+    for (const auto& [key, file] : m_files) {
+        if (key.has_parent_path()) { directories.insert(key.parent_path()); }
+    }
+    return { directories.begin(), directories.end() };
+}
+
+size_t FileWatchRegistry::Scan(Clock::time_point now) {
+    std::vector<std::pair<FileChange, std::vector<Callback>>> deliveries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.scans;
+        for (auto& [key, file] : m_files) {
+            const Stamp stamp = StatFile(key);
+            if (!(stamp == file.observed)) {
+                // Still being written: restart the debounce window.
+                file.observed = stamp;
+                file.pending = true;
+                file.pendingSince = now;
+            }
+            if (!file.pending || now - file.pendingSince < m_debounce) { continue; }
+
+            // A removed file keeps its last delivered version; subscribers keep what they loaded.
+            if (!stamp.exists) {
+                file.pending = false;
+                continue;
+            }
+
+            const Content content = ReadContent(key);
+            ++m_stats.filesHashed;
+            if (!content.exists) {
+                // Locked by the writer; try again after another debounce window.
+                file.pendingSince = now;
+                continue;
+            }
+            file.pending = false;
+            if (content == file.delivered) {
+                ++m_stats.unchangedContentSkipped;
+                continue;
+            }
+            file.delivered = content;
+
+            std::vector<Callback> callbacks;
+            callbacks.reserve(file.subscribers.size());
+            for (const auto& [id, callback] : file.subscribers) { callbacks.push_back(callback); }
+            deliveries.push_back({ FileChange{ key, content.size, content.hash }, std::move(callbacks) });
+        }
+    }
+
+    size_t invoked = 0;
+    for (const auto& [change, callbacks] : deliveries) {
+        for (const auto& callback : callbacks) {
+            callback(change);
+            ++invoked;
+        }
+    }
+    if (!deliveries.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.changesDelivered += deliveries.size();
+    }
+    return invoked;
+}
+
+std::optional<FileWatchRegistry::Clock::time_point> FileWatchRegistry::NextDebounceDeadline() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::optional<Clock::time_point> deadline;
+    for (const auto& [key, file] : m_files) {
+        if (!file.pending) { continue; }
+        const Clock::time_point due = file.pendingSince + m_debounce;
+        if (!deadline || due < *deadline) { deadline = due; }
+    }
+    return deadline;
+}
+
+FileWatchStats FileWatchRegistry::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+}  // namespace file_watch
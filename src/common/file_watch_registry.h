@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace file_watch {
+
+// Shared registry of files whose contents are watched for hot reload.
+//
+// Any number of subscribers (user images, mode backgrounds, EyeZoom overlays, ...) can subscribe to the same path;
+// each path is stat'ed and hashed once per scan and the change is fanned out to every subscriber. The registry
+// itself does no waiting: the owner blocks on change notifications for WatchedDirectories() (one handle per
+// directory, however many files live in it) and calls Scan() when something may have changed.
+//
+// A change is only delivered once the file's size and write time have stayed the same for the debounce window, so
+// an editor that truncates, writes and renames in several steps causes one reload. A file whose size and content
+// hash match the last delivered version (a touch, or an editor rewriting identical bytes) is not delivered at all.
+
+struct FileChange {
+    std::filesystem::path path;
+    uint64_t size = 0;
+    uint64_t contentHash = 0;
+};
+
+struct FileWatchStats {
+    uint64_t scans = 0;
+    uint64_t filesHashed = 0;
+    uint64_t changesDelivered = 0;
+    // Debounced changes whose size and hash matched the last delivered version.
+    uint64_t unchangedContentSkipped = 0;
+};
+
+// FNV-1a over the file's bytes. Returns false when the file cannot be read.
+bool HashFileContents(const std::filesystem::path& path, uint64_t& outSize, uint64_t& outHash);
+
+class FileWatchRegistry {
+  public:
+    using SubscriptionId = uint64_t;
+    using Callback = std::function<void(const FileChange&)>;
+    using Clock = std::chrono::steady_clock;
+
+    explicit FileWatchRegistry(std::chrono::milliseconds debounce = std::chrono::milliseconds(200));
+
+    // Records the file's current contents as the baseline, so subscribing never triggers a callback by itself.
+    SubscriptionId Subscribe(const std::filesystem::path& path, Callback callback);
+    void Unsubscribe(SubscriptionId id);
+
+    std::vector<std::filesystem::path> WatchedFiles() const;
+    std::vector<std::filesystem::path> WatchedDirectories() const;
+
+    // Stats every watched file and delivers the changes whose debounce window has passed. Callbacks run on the
+    // calling thread without the registry lock held. Returns the number of callbacks invoked.
+    size_t Scan(Clock::time_point now);
+
+    // When the earliest pending change finishes its debounce window; the owner should Scan() again by then.
+    std::optional<Clock::time_point> NextDebounceDeadline() const;
+
+    FileWatchStats GetStats() const;
+
+  private:
+    struct Stamp {
+        bool exists = false;
+        uint64_t size = 0;
+        std::filesystem::file_time_type writeTime{};
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    struct Content {
+        bool exists = false;
+        uint64_t size = 0;
+        uint64_t hash = 0;
+
+        bool operator==(const Content&) const = default;
+    };
+
+    struct WatchedFile {
+        Stamp observed;
+        Content delivered;
+        bool pending = false;
+        Clock::time_point pendingSince{};
+        std::map<SubscriptionId, Callback> subscribers;
+    };
+
+    static Stamp StatFile(const std::filesystem::path& path);
+    static Content ReadContent(const std::filesystem::path& path);
+
+    const std::chrono::milliseconds m_debounce;
+
+    mutable std::mutex m_mutex;
+    // Keyed by the lexically normalized path.
+    std::map<std::filesystem::path, WatchedFile> m_files;
+    std::map<SubscriptionId, std::filesystem::path> m_subscriptionPaths;
+    SubscriptionId m_nextId = 1;
+    FileWatchStats m_stats;
+};
+
+}  // namespace file_watch
@@ -0,0 +1,746 @@
+#include "gzip_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gzip_writer {
+namespace {
+
+constexpr int kWindowSize = 32768;
+constexpr int kWindowMask = kWindowSize - 1;
+constexpr int kMaxDistance = kWindowSize - 1;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+constexpr int kHashBits = 15;
+constexpr int kHashSize = 1 << kHashBits;
+constexpr int kTooFarForMinMatch = 4096;
+constexpr size_t kMaxBlockTokens = 16384;
+constexpr size_t kMaxStoredBlockBytes = 65535;
+constexpr size_t kMaxSegmentBytes = 1ull << 30;
+
+constexpr int kMaxCodeBits = 15;
+constexpr int kMaxCodeLengthBits = 7;
+constexpr int kLitLenSymbols = 286;
+constexpr int kFixedLitLenSymbols = 288;
+constexpr int kDistSymbols = 30;
+constexpr int kCodeLengthSymbols = 19;
+constexpr int kEndOfBlock = 256;
+
+constexpr uint8_t kCodeLengthOrder[kCodeLengthSymbols] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+constexpr uint16_t kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+constexpr uint8_t kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+constexpr uint16_t kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                     193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+constexpr uint8_t kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+constexpr uint8_t kCodeLengthExtra[3] = { 2, 3, 7 };
+
+struct HuffCode {
+    uint16_t code = 0;
+    uint8_t bits = 0;
+};
+
+struct Tables {
+    uint32_t crc[8][256] = {};
+    uint8_t lengthSymbol[kMaxMatch + 1] = {};
+    uint8_t distSymbol[512] = {};
+    HuffCode fixedLitLen[kFixedLitLenSymbols];
+    HuffCode fixedDist[kDistSymbols];
+    uint8_t fixedLitLenLengths[kFixedLitLenSymbols] = {};
+    uint8_t fixedDistLengths[kDistSymbols] = {};
+};
+
+uint16_t ReverseBits(uint16_t v, int bitCount) {
+    uint16_t r = 0;
+    for (int i = 0; i < bitCount; i++) {
+        r = static_cast<uint16_t>((r << 1) | (v & 1u));
+        v >>= 1;
+    }
+    return r;
+}
+
+void BuildCanonicalCodes(const uint8_t* lengths, int count, HuffCode* out) {
+    int blCount[kMaxCodeBits + 1] = { 0 };
+    for (int i = 0; i < count; i++) {
+        if (lengths[i] > 0) blCount[lengths[i]]++;
+    }
+
+    int nextCode[kMaxCodeBits + 1] = { 0 };
+    int code = 0;
+    for (int bits = 1; bits <= kMaxCodeBits; bits++) {
+        code = (code + blCount[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+
+    for (int symbol = 0; symbol < count; symbol++) {
+        const uint8_t len = lengths[symbol];
+        out[symbol] = {};
+        if (len == 0) continue;
+        out[symbol].bits = len;
+        out[symbol].code = ReverseBits(static_cast<uint16_t>(nextCode[len]++), len);
+    }
+}
+
+Tables BuildTables() {
+    Tables t;
+
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int j = 0; j < 8; j++) { c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1); }
+        t.crc[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int slice = 1; slice < 8; slice++) { t.crc[slice][i] = (t.crc[slice - 1][i] >> 8) ^ t.crc[0][t.crc[slice - 1][i] & 0xFFu]; }
+    }
+
+    for (int code = 0; code < 29; code++) {
+        for (int len = kLenBase[code]; len < kLenBase[code] + (1 << kLenExtra[code]) && len <= kMaxMatch; len++) {
+            t.lengthSymbol[len] = static_cast<uint8_t>(code);
+        }
+    }
+
+    for (int code = 0; code < kDistSymbols; code++) {
+        const int first = kDistBase[code] - 1;
+        const int last = first + (1 << kDistExtra[code]);
+        if (first < 256) {
+            for (int d = first; d < last; d++) t.distSymbol[d] = static_cast<uint8_t>(code);
+        } else {
+            for (int d = first; d < last; d += 128) t.distSymbol[256 + (d >> 7)] = static_cast<uint8_t>(code);
+        }
+    }
+
+    for (int i = 0; i <= 143; i++) t.fixedLitLenLengths[i] = 8;
+    for (int i = 144; i <= 255; i++) t.fixedLitLenLengths[i] = 9;
+    for (int i = 256; i <= 279; i++) t.fixedLitLenLengths[i] = 7;
+    for (int i = 280; i <= 287; i++) t.fixedLitLenLengths[i] = 8;
+    std::fill(std::begin(t.fixedDistLengths), std::end(t.fixedDistLengths), static_cast<uint8_t>(5));
+    BuildCanonicalCodes(t.fixedLitLenLengths, kFixedLitLenSymbols, t.fixedLitLen);
+    BuildCanonicalCodes(t.fixedDistLengths, kDistSymbols, t.fixedDist);
+    return t;
+}
+
+const Tables& GetTables() {
+    static const Tables tables = BuildTables();
+    return tables;
+}
+
+inline int DistanceSymbol(const Tables& t, int distance) {
+    const int d = distance - 1;
+    return d < 256 ? t.distSymbol[d] : t.distSymbol[256 + (d >> 7)];
+}
+
+// Huffman code lengths limited to maxBits. Lengths are derived from the tree depths, the
+// overflow is folded back with the Kraft-sum adjustment, then reassigned by frequency.
+void BuildCodeLengths(const uint32_t* freqs, int count, int maxBits, uint8_t* outLengths) {
+    std::fill(outLengths, outLengths + count, static_cast<uint8_t>(0));
+
+    std::array<uint16_t, kFixedLitLenSymbols> symbols{};
+    int used = 0;
+    for (int i = 0; i < count; i++) {
+        if (freqs[i] != 0) symbols[used++] = static_cast<uint16_t>(i);
+    }
+
+    // A complete code needs at least two symbols.
+    if (used < 2) {
+        const int only = used == 1 ? symbols[0] : 0;
+        outLengths[only] = 1;
+        outLengths[only == 0 ? 1 : 0] = 1;
+        return;
+    }
+
+    std::sort(symbols.begin(), symbols.begin() + used, [freqs](uint16_t a, uint16_t b) {
+        return freqs[a] != freqs[b] ? freqs[a] < freqs[b] : a < b;
+    });
+
+    // Two-queue Huffman construction over the sorted leaves; internal nodes are created
+    // in non-decreasing weight order, so each node's parent always has a larger index.
+    const int nodeCount = 2 * used - 1;
+    std::array<uint64_t, 2 * kFixedLitLenSymbols> weight{};
+    std::array<int, 2 * kFixedLitLenSymbols> parent{};
+    for (int i = 0; i < used; i++) weight[i] = freqs[symbols[i]];
+
+    int nextLeaf = 0;
+    int nextInternal = used;
+    for (int node = used; node < nodeCount; node++) {
+        int children[2];
+        for (int& child : children) {
+            if (nextLeaf < used && (nextInternal >= node || weight[nextLeaf] <= weight[nextInternal])) {
+                child = nextLeaf++;
+            } else {
+                child = nextInternal++;
+            }
+        }
+        weight[node] = weight[children[0]] + weight[children[1]];
+        parent[children[0]] = node;
+        parent[children[1]] = node;
+    }
+
+    std::array<int, 2 * kFixedLitLenSymbols> depth{};
+    depth[nodeCount - 1] = 0;
+    for (int node = nodeCount - 2; node >= 0; node--) depth[node] = depth[parent[node]] + 1;
+
+    int blCount[kMaxCodeBits + 2] = { 0 };
+    for (int i = 0; i < used; i++) blCount[(std::min)(depth[i], maxBits)]++;
+
+    uint32_t kraft = 0;
+    for (int len = 1; len <= maxBits; len++) kraft += static_cast<uint32_t>(blCount[len]) << (maxBits - len);
+    while (kraft > (1u << maxBits)) {
+        blCount[maxBits]--;
+        for (int len = maxBits - 1; len > 0; len--) {
+            if (blCount[len] != 0) {
+                blCount[len]--;
+                blCount[len + 1] += 2;
+                break;
+            }
+        }
+        kraft--;
+    }
+
+    int index = 0;
+    for (int len = maxBits; len >= 1; len--) {
+        for (int k = 0; k < blCount[len]; k++) outLengths[symbols[index++]] = static_cast<uint8_t>(len);
+    }
+}
+
+class BitWriter {
+  public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void Put(uint32_t value, int count) {
+        m_buffer |= static_cast<uint64_t>(value) << m_bitCount;
+        m_bitCount += count;
+        if (m_bitCount >= 32) {
+            const uint32_t word = static_cast<uint32_t>(m_buffer);
+            const uint8_t bytes[4] = { static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8), static_cast<uint8_t>(word >> 16),
+                                       static_cast<uint8_t>(word >> 24) };
+            m_out.insert(m_out.end(), bytes, bytes + 4);
+            m_buffer >>= 32;
+            m_bitCount -= 32;
+        }
+    }
+
+    void AlignToByte() {
+        while (m_bitCount > 0) {
+            m_out.push_back(static_cast<uint8_t>(m_buffer & 0xFFu));
+            m_buffer >>= 8;
+            m_bitCount -= 8;
+        }
+        m_buffer = 0;
+        m_bitCount = 0;
+    }
+
+    void PutBytes(const uint8_t* data, size_t size) { m_out.insert(m_out.end(), data, data + size); }
+
+  private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_buffer = 0;
+    int m_bitCount = 0;
+};
+
+struct Token {
+    uint16_t litLen = 0;
+    uint16_t dist = 0; // 0 for literals
+};
+
+class DeflateEncoder {
+  public:
+    DeflateEncoder(const GzipOptions& options, std::vector<uint8_t>& out)
+        : m_tables(GetTables()), m_writer(out), m_maxChain((std::max)(1, options.maxChainLength)),
+          m_lazyLength((std::clamp)(options.lazyMatchLength, kMinMatch, kMaxMatch)),
+          m_niceLength((std::clamp)(options.niceMatchLength, kMinMatch, kMaxMatch)), m_head(kHashSize), m_prev(kWindowSize) {
+        m_tokens.reserve(kMaxBlockTokens);
+        ResetFrequencies();
+    }
+
+    void Encode(const uint8_t* data, size_t size) {
+        m_data = data;
+        m_blockStart = 0;
+        m_blockBytes = 0;
+
+        for (size_t offset = 0; offset < size; offset += kMaxSegmentBytes) {
+            EncodeSegment(offset, (std::min)(kMaxSegmentBytes, size - offset));
+        }
+        FlushBlock(true);
+    }
+
+  private:
+    static uint32_t Hash(const uint8_t* p) {
+        const uint32_t v = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16);
+        return (v * 2654435761u) >> (32 - kHashBits);
+    }
+
+    int Insert(const uint8_t* seg, int pos) {
+        const uint32_t h = Hash(seg + pos);
+        const int previous = m_head[h];
+        m_prev[pos & kWindowMask] = previous;
+        m_head[h] = pos;
+        return previous;
+    }
+
+    static int MatchLength(const uint8_t* a, const uint8_t* b, int maxLen) {
+        int len = 0;
+        while (len + 8 <= maxLen) {
+            uint64_t x = 0;
+            uint64_t y = 0;
+            std::memcpy(&x, a + len, sizeof(x));
+            std::memcpy(&y, b + len, sizeof(y));
+            const uint64_t diff = x ^ y;
+            if (diff != 0) {
+                if constexpr (std::endian::native == std::endian::little) {
+                    return len + (std::countr_zero(diff) >> 3);
+                } else {
+                    return len + (std::countl_zero(diff) >> 3);
+                }
+            }
+            len += 8;
+        }
+        while (len < maxLen && a[len] == b[len]) len++;
+        return len;
+    }
+
+    // Walks the hash chain from candidate and returns the best match strictly longer than
+    // prevLen, or 0 when there is none worth emitting.
+    int FindLongestMatch(const uint8_t* seg, int pos, int available, int candidate, int prevLen, int& outDist) const {
+        const int maxLen = (std::min)(kMaxMatch, available);
+        if (maxLen < kMinMatch || prevLen >= maxLen) return 0;
+
+        int chain = m_maxChain;
+        if (prevLen >= m_lazyLength) chain >>= 2;
+        const int minPos = pos > kMaxDistance ? pos - kMaxDistance : 0;
+        const uint8_t* scan = seg + pos;
+        int bestLen = (std::max)(prevLen, kMinMatch - 1);
+        int bestDist = 0;
+
+        while (candidate >= minPos && chain-- > 0) {
+            const uint8_t* match = seg + candidate;
+            if (match[bestLen] == scan[bestLen] && match[0] == scan[0] && match[1] == scan[1]) {
+                const int len = MatchLength(match, scan, maxLen);
+                if (len > bestLen) {
+                    bestLen = len;
+                    bestDist = pos - candidate;
+                    if (len >= m_niceLength || len >= maxLen) break;
+                }
+            }
+            candidate = m_prev[candidate & kWindowMask];
+        }
+
+        if (bestDist == 0) return 0;
+        if (bestLen == kMinMatch && bestDist > kTooFarForMinMatch) return 0;
+        outDist = bestDist;
+        return bestLen;
+    }
+
+    void EncodeSegment(size_t offset, size_t size) {
+        std::fill(m_head.begin(), m_head.end(), -1);
+        const uint8_t* seg = m_data + offset;
+        const int n = static_cast<int>(size);
+
+        // Lazy evaluation: a match found at pos-1 is only emitted when pos does not
+        // produce a longer one; otherwise pos-1 degrades to a literal.
+        bool havePrev = false;
+        int prevLen = 0;
+        int prevDist = 0;
+        int pos = 0;
+        while (pos < n) {
+            int curLen = 0;
+            int curDist = 0;
+            if (pos + kMinMatch <= n) {
+                const int candidate = Insert(seg, pos);
+                if (candidate >= 0 && (!havePrev || prevLen < m_lazyLength)) {
+                    curLen = FindLongestMatch(seg, pos, n - pos, candidate, havePrev ? prevLen : 0, curDist);
+                }
+            }
+
+            if (havePrev && prevLen >= kMinMatch && curLen <= prevLen) {
+                EmitMatch(prevLen, prevDist);
+                const int end = pos - 1 + prevLen;
+                for (int p = pos + 1; p < end; p++) {
+                    if (p + kMinMatch <= n) Insert(seg, p);
+                }
+                pos = end;
+                havePrev = false;
+                prevLen = 0;
+                continue;
+            }
+
+            if (havePrev) EmitLiteral(seg[pos - 1]);
+            havePrev = true;
+            prevLen = curLen;
+            prevDist = curDist;
+            pos++;
+        }
+        if (havePrev) EmitLiteral(seg[n - 1]);
+    }
+
+    void EmitLiteral(uint8_t value) {
+        m_tokens.push_back({ value, 0 });
+        m_litLenFreq[value]++;
+        m_blockBytes += 1;
+        if (m_tokens.size() >= kMaxBlockTokens) FlushBlock(false);
+    }
+
+    void EmitMatch(int length, int distance) {
+        m_tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(distance) });
+        m_litLenFreq[257 + m_tables.lengthSymbol[length]]++;
+        m_distFreq[DistanceSymbol(m_tables, distance)]++;
+        m_blockBytes += static_cast<size_t>(length);
+        if (m_tokens.size() >= kMaxBlockTokens) FlushBlock(false);
+    }
+
+    void ResetFrequencies() {
+        std::fill(std::begin(m_litLenFreq), std::end(m_litLenFreq), 0u);
+        std::fill(std::begin(m_distFreq), std::end(m_distFreq), 0u);
+    }
+
+    uint64_t TokenBits(const uint8_t* litLenLengths, const uint8_t* distLengths) const {
+        uint64_t bits = 0;
+        for (int s = 0; s < kLitLenSymbols; s++) bits += static_cast<uint64_t>(m_litLenFreq[s]) * litLenLengths[s];
+        for (int s = 0; s < kDistSymbols; s++) bits += static_cast<uint64_t>(m_distFreq[s]) * distLengths[s];
+        return bits;
+    }
+
+    uint64_t ExtraBits() const {
+        uint64_t bits = 0;
+        for (int code = 0; code < 29; code++) bits += static_cast<uint64_t>(m_litLenFreq[257 + code]) * kLenExtra[code];
+        for (int code = 0; code < kDistSymbols; code++) bits += static_cast<uint64_t>(m_distFreq[code]) * kDistExtra[code];
+        return bits;
+    }
+
+    void WriteTokens(const HuffCode* litLen, const HuffCode* dist) {
+        for (const Token& t : m_tokens) {
+            if (t.dist == 0) {
+                m_writer.Put(litLen[t.litLen].code, litLen[t.litLen].bits);
+                continue;
+            }
+            const int lenCode = m_tables.lengthSymbol[t.litLen];
+            const HuffCode& lenH = litLen[257 + lenCode];
+            m_writer.Put(lenH.code, lenH.bits);
+            if (kLenExtra[lenCode] > 0) m_writer.Put(t.litLen - kLenBase[lenCode], kLenExtra[lenCode]);
+
+            const int distCode = DistanceSymbol(m_tables, t.dist);
+            const HuffCode& distH = dist[distCode];
+            m_writer.Put(distH.code, distH.bits);
+            if (kDistExtra[distCode] > 0) m_writer.Put(t.dist - kDistBase[distCode], kDistExtra[distCode]);
+        }
+        m_writer.Put(litLen[kEndOfBlock].code, litLen[kEndOfBlock].bits);
+    }
+
+    void WriteStored(bool final) {
+        const uint8_t* src = m_data + m_blockStart;
+        size_t remaining = m_blockBytes;
+        do {
+            const size_t len = (std::min)(remaining, kMaxStoredBlockBytes);
+            remaining -= len;
+            m_writer.Put((final && remaining == 0) ? 1u : 0u, 1);
+            m_writer.Put(0, 2);
+            m_writer.AlignToByte();
+            const uint8_t header[4] = { static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8), static_cast<uint8_t>(~len),
+                                        static_cast<uint8_t>(~len >> 8) };
+            m_writer.PutBytes(header, sizeof(header));
+            m_writer.PutBytes(src, len);
+            src += len;
+        } while (remaining > 0);
+    }
+
+    void FlushBlock(bool final) {
+        if (!final && m_tokens.empty()) return;
+
+        m_litLenFreq[kEndOfBlock]++;
+
+        uint8_t litLenLengths[kLitLenSymbols];
+        uint8_t distLengths[kDistSymbols];
+        BuildCodeLengths(m_litLenFreq, kLitLenSymbols, kMaxCodeBits, litLenLengths);
+        BuildCodeLengths(m_distFreq, kDistSymbols, kMaxCodeBits, distLengths);
+
+        int hlit = kLitLenSymbols;
+        while (hlit > 257 && litLenLengths[hlit - 1] == 0) hlit--;
+        int hdist = kDistSymbols;
+        while (hdist > 1 && distLengths[hdist - 1] == 0) hdist--;
+
+        // Run-length encode the concatenated code lengths with symbols 16/17/18.
+        uint8_t lengths[kLitLenSymbols + kDistSymbols];
+        std::memcpy(lengths, litLenLengths, hlit);
+        std::memcpy(lengths + hlit, distLengths, hdist);
+        const int totalLengths = hlit + hdist;
+
+        struct RleSymbol {
+            uint8_t symbol;
+            uint8_t extra;
+        };
+        RleSymbol rle[kLitLenSymbols + kDistSymbols];
+        int rleCount = 0;
+        uint32_t clFreq[kCodeLengthSymbols] = { 0 };
+        for (int i = 0; i < totalLengths;) {
+            const uint8_t len = lengths[i];
+            int run = 1;
+            while (i + run < totalLengths && lengths[i + run] == len) run++;
+            i += run;
+
+            if (len == 0) {
+                while (run >= 11) {
+                    const int n = (std::min)(run, 138);
+                    rle[rleCount++] = { 18, static_cast<uint8_t>(n - 11) };
+                    run -= n;
+                }
+                if (run >= 3) {
+                    rle[rleCount++] = { 17, static_cast<uint8_t>(run - 3) };
+                    run = 0;
+                }
+            } else {
+                rle[rleCount++] = { len, 0 };
+                run--;
+                while (run >= 3) {
+                    const int n = (std::min)(run, 6);
+                    rle[rleCount++] = { 16, static_cast<uint8_t>(n - 3) };
+                    run -= n;
+                }
+            }
+            while (run-- > 0) rle[rleCount++] = { len, 0 };
+        }
+        for (int i = 0; i < rleCount; i++) clFreq[rle[i].symbol]++;
+
+        uint8_t clLengths[kCodeLengthSymbols];
+        BuildCodeLengths(clFreq, kCodeLengthSymbols, kMaxCodeLengthBits, clLengths);
+        int hclen = kCodeLengthSymbols;
+        while (hclen > 4 && clLengths[kCodeLengthOrder[hclen - 1]] == 0) hclen--;
+
+        const uint64_t extraBits = ExtraBits();
+        uint64_t dynamicBits = 3 + 5 + 5 + 4 + static_cast<uint64_t>(hclen) * 3 + TokenBits(litLenLengths, distLengths) + extraBits;
+        for (int s = 0; s < kCodeLengthSymbols; s++) dynamicBits += static_cast<uint64_t>(clFreq[s]) * clLengths[s];
+        for (int s = 16; s <= 18; s++) dynamicBits += static_cast<uint64_t>(clFreq[s]) * kCodeLengthExtra[s - 16];
+
+        const uint64_t fixedBits = 3 + TokenBits(m_tables.fixedLitLenLengths, m_tables.fixedDistLengths) + extraBits;
+        const uint64_t storedBlocks = (std::max<uint64_t>)(1, (m_blockBytes + kMaxStoredBlockBytes - 1) / kMaxStoredBlockBytes);
+        const uint64_t storedBits = storedBlocks * (3 + 7 + 32) + static_cast<uint64_t>(m_blockBytes) * 8;
+
+        if (storedBits < dynamicBits && storedBits < fixedBits) {
+            WriteStored(final);
+        } else if (fixedBits <= dynamicBits) {
+            m_writer.Put(final ? 1u : 0u, 1);
+            m_writer.Put(1, 2);
+            WriteTokens(m_tables.fixedLitLen, m_tables.fixedDist);
+        } else {
+            m_writer.Put(final ? 1u : 0u, 1);
+            m_writer.Put(2, 2);
+            m_writer.Put(static_cast<uint32_t>(hlit - 257), 5);
+            m_writer.Put(static_cast<uint32_t>(hdist - 1), 5);
+            m_writer.Put(static_cast<uint32_t>(hclen - 4), 4);
+            for (int i = 0; i < hclen; i++) m_writer.Put(clLengths[kCodeLengthOrder[i]], 3);
+
+            HuffCode clCodes[kCodeLengthSymbols];
+            BuildCanonicalCodes(clLengths, kCodeLengthSymbols, clCodes);
+            for (int i = 0; i < rleCount; i++) {
+                const HuffCode& c = clCodes[rle[i].symbol];
+                m_writer.Put(c.code, c.bits);
+                if (rle[i].symbol >= 16) m_writer.Put(rle[i].extra, kCodeLengthExtra[rle[i].symbol - 16]);
+            }
+
+            HuffCode litLenCodes[kLitLenSymbols];
+            HuffCode distCodes[kDistSymbols];
+            BuildCanonicalCodes(litLenLengths, kLitLenSymbols, litLenCodes);
+            BuildCanonicalCodes(distLengths, kDistSymbols, distCodes);
+            WriteTokens(litLenCodes, distCodes);
+        }
+
+        if (final) m_writer.AlignToByte();
+
+        m_blockStart += m_blockBytes;
+        m_blockBytes = 0;
+        m_tokens.clear();
+        ResetFrequencies();
+    }
+
+    const Tables& m_tables;
+    BitWriter m_writer;
+    const int m_maxChain;
+    const int m_lazyLength;
+    const int m_niceLength;
+
+    std::vector<int> m_head;
+    std::vector<int> m_prev;
+    std::vector<Token> m_tokens;
+    uint32_t m_litLenFreq[kLitLenSymbols];
+    uint32_t m_distFreq[kDistSymbols];
+
+    const uint8_t* m_data = nullptr;
+    size_t m_blockStart = 0;
+    size_t m_blockBytes = 0;
+};
+
+void AppendLE32(std::vector<uint8_t>& out, uint32_t v) {
+    const uint8_t b[4] = { static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v >> 16),
+                           static_cast<uint8_t>(v >> 24) };
+    out.insert(out.end(), b, b + 4);
+}
+
+int ResolveWorkerCount(const GzipOptions& options) {
+    if (options.workerThreads > 0) return (std::min)(options.workerThreads, kMaxWorkerThreads);
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return (std::clamp)(hardware / 2, 1, kMaxWorkerThreads);
+}
+
+bool ReadFull(const ReadFn& read, uint8_t* dst, size_t capacity, size_t& outRead) {
+    outRead = 0;
+    while (outRead < capacity) {
+        size_t got = 0;
+        if (!read(dst + outRead, capacity - outRead, got)) return false;
+        if (got == 0) break;
+        outRead += got;
+    }
+    return true;
+}
+
+struct ChunkJob {
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+    bool done = false;
+};
+
+} // namespace
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+    const Tables& t = GetTables();
+    crc = ~crc;
+    while (size >= 8) {
+        const uint32_t lo = crc ^ (static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+                                   (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24));
+        crc = t.crc[7][lo & 0xFFu] ^ t.crc[6][(lo >> 8) & 0xFFu] ^ t.crc[5][(lo >> 16) & 0xFFu] ^ t.crc[4][lo >> 24] ^
+              t.crc[3][data[4]] ^ t.crc[2][data[5]] ^ t.crc[1][data[6]] ^ t.crc[0][data[7]];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) crc = t.crc[0][(crc ^ *data++) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+void DeflateRaw(const uint8_t* data, size_t size, const GzipOptions& options, std::vector<uint8_t>& out) {
+    DeflateEncoder encoder(options, out);
+    encoder.Encode(data, size);
+}
+
+void CompressGzipMember(const uint8_t* data, size_t size, const GzipOptions& options, std::vector<uint8_t>& out) {
+    const uint8_t header[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, options.osCode };
+    out.insert(out.end(), header, header + sizeof(header));
+    DeflateRaw(data, size, options, out);
+    AppendLE32(out, Crc32(data, size));
+    AppendLE32(out, static_cast<uint32_t>(size & 0xFFFFFFFFu));
+}
+
+bool CompressStream(const ReadFn& read, const WriteFn& write, const GzipOptions& options) {
+    const size_t chunkBytes = (std::max<size_t>)(options.chunkBytes, 1);
+    const int workerCount = ResolveWorkerCount(options);
+
+    if (workerCount <= 1) {
+        std::vector<uint8_t> input(chunkBytes);
+        std::vector<uint8_t> output;
+        bool wroteAny = false;
+        for (;;) {
+            size_t got = 0;
+            if (!ReadFull(read, input.data(), chunkBytes, got)) return false;
+            if (got == 0 && wroteAny) return true;
+
+            output.clear();
+            CompressGzipMember(input.data(), got, options, output);
+            if (!write(output.data(), output.size())) return false;
+            wroteAny = true;
+            if (got < chunkBytes) return true;
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable workCv;
+    std::condition_variable doneCv;
+    std::deque<ChunkJob*> pending;
+    std::deque<std::unique_ptr<ChunkJob>> inOrder;
+    std::vector<std::unique_ptr<ChunkJob>> spare;
+    bool stopping = false;
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(workerCount));
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                workCv.wait(lock, [&]() { return stopping || !pending.empty(); });
+                if (pending.empty()) return;
+                ChunkJob* job = pending.front();
+                pending.pop_front();
+                lock.unlock();
+
+                job->output.clear();
+                CompressGzipMember(job->input.data(), job->input.size(), options, job->output);
+
+                lock.lock();
+                job->done = true;
+                doneCv.notify_all();
+            }
+        });
+    }
+
+    const size_t maxInFlight = static_cast<size_t>(workerCount) * 2;
+    bool ok = true;
+    bool eof = false;
+    bool queuedAny = false;
+    while (ok) {
+        while (!eof && inOrder.size() < maxInFlight) {
+            std::unique_ptr<ChunkJob> job;
+            if (!spare.empty()) {
+                job = std::move(spare.back());
+                spare.pop_back();
+            } else {
+                job = std::make_unique<ChunkJob>();
+            }
+
+            job->input.resize(chunkBytes);
+            size_t got = 0;
+            if (!ReadFull(read, job->input.data(), chunkBytes, got)) {
+                ok = false;
+                break;
+            }
+            if (got < chunkBytes) eof = true;
+            // An empty input still produces one (empty) member so the output is valid gzip.
+            if (got == 0 && queuedAny) break;
+
+            job->input.resize(got);
+            job->done = false;
+            queuedAny = true;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(job.get());
+            inOrder.push_back(std::move(job));
+            workCv.notify_one();
+        }
+
+        if (!ok || inOrder.empty()) break;
+
+        std::unique_ptr<ChunkJob> finished;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCv.wait(lock, [&]() { return inOrder.front()->done; });
+            finished = std::move(inOrder.front());
+            inOrder.pop_front();
+        }
+
+        if (!write(finished->output.data(), finished->output.size())) ok = false;
+        spare.push_back(std::move(finished));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.clear();
+        stopping = true;
+    }
+    workCv.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    return ok;
+}
+
+} // namespace gzip_writer
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gzip_writer {
+
+constexpr size_t kDefaultChunkBytes = 1024ull * 1024ull;
+constexpr int kMaxWorkerThreads = 4;
+
+struct GzipOptions {
+    // Each chunk becomes an independent gzip member, so peak memory is bounded by
+    // chunkBytes * (in-flight chunks) regardless of the input size.
+    size_t chunkBytes = kDefaultChunkBytes;
+    // 0 picks from hardware_concurrency (capped at kMaxWorkerThreads); 1 compresses inline.
+    int workerThreads = 0;
+    int maxChainLength = 128;
+    int lazyMatchLength = 32;
+    int niceMatchLength = 128;
+    uint8_t osCode = 0x0B; // OS=NTFS/Windows
+};
+
+// Fills dst with up to capacity bytes; outRead == 0 signals end of input.
+using ReadFn = std::function<bool(uint8_t* dst, size_t capacity, size_t& outRead)>;
+using WriteFn = std::function<bool(const uint8_t* data, size_t size)>;
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+// Appends a raw (headerless) deflate stream for data to out.
+void DeflateRaw(const uint8_t* data, size_t size, const GzipOptions& options, std::vector<uint8_t>& out);
+
+// Appends one complete gzip member (header, deflate stream, CRC32/ISIZE trailer) to out.
+void CompressGzipMember(const uint8_t* data, size_t size, const GzipOptions& options, std::vector<uint8_t>& out);
+
+// Reads the input in chunkBytes pieces, compresses them across a small worker pool and
+// writes the resulting gzip members in input order.
+bool CompressStream(const ReadFn& read, const WriteFn& write, const GzipOptions& options = {});
+
+} // namespace gzip_writer
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Debug log categories, one bit each in g_logCategoryMask. The order matches the
+// log* toggles in DebugGlobalConfig.
+enum class LogCategoryId : uint8_t {
+    ModeSwitch,
+    Animation,
+    Hotkey,
+    Obs,
+    WindowOverlay,
+    BrowserOverlay,
+    Ninjabrain,
+    FileMonitor,
+    ImageMonitor,
+    Performance,
+    TextureOps,
+    Gui,
+    Init,
+    CursorTextures,
+    HookChain,
+    Count
+};
+
+static_assert(static_cast<uint32_t>(LogCategoryId::Count) <= 32, "log categories must fit the 32-bit mask");
+
+constexpr uint32_t LogCategoryBit(LogCategoryId id) { return 1u << static_cast<uint32_t>(id); }
+
+// Categories that are logged regardless of the debug toggles.
+constexpr uint32_t kAlwaysEnabledLogCategories = LogCategoryBit(LogCategoryId::HookChain);
+
+// Rebuilt from the debug section every time a config snapshot is published.
+extern std::atomic<uint32_t> g_logCategoryMask;
+
+inline bool IsLogCategoryEnabled(LogCategoryId id) {
+    return (g_logCategoryMask.load(std::memory_order_relaxed) & LogCategoryBit(id)) != 0;
+}
+
+// Logs only when the category is enabled. The message arguments are not evaluated when
+// it is disabled, so the string building at the call site costs nothing while off.
+#define LOG_CATEGORY(category, ...)                                                                                                        \
+    do {                                                                                                                                   \
+        if (IsLogCategoryEnabled(LogCategoryId::category)) Log(__VA_ARGS__);                                                               \
+    } while (0)
@@ -0,0 +1,245 @@
+#include "log_pipeline.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace log_pipeline {
+namespace {
+
+constexpr size_t kMinCapacitySlots = 16;
+constexpr std::chrono::milliseconds kMinSinkRetryDelay{ 10 };
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = kMinCapacitySlots;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+int64_t NowEpochMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+LogPipeline::LogPipeline(Sink sink, const LogPipelineOptions& options) : m_sink(std::move(sink)), m_options(options) {
+    const size_t capacity = RoundUpToPowerOfTwo(options.capacitySlots);
+    m_mask = capacity - 1;
+    m_slots = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < capacity; i++) m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    m_batch.reserve(m_options.batchBytes + kMaxRecordSlots * kPayloadBytes + 64);
+}
+
+LogPipeline::~LogPipeline() { Stop(); }
+
+bool LogPipeline::Submit(std::string_view message) { return Submit(NowEpochMs(), message); }
+
+bool LogPipeline::Submit(int64_t epochMs, std::string_view message) {
+    const size_t maxSpan = (std::min)(kMaxRecordSlots, m_mask + 1);
+    size_t length = (std::min)(message.size(), maxSpan * kPayloadBytes);
+    const bool truncated = length < message.size();
+    const size_t span = length == 0 ? 1 : (length + kPayloadBytes - 1) / kPayloadBytes;
+
+    // Claim span consecutive positions. Slots are released in order, so the last slot
+    // being free for this lap implies the whole range is free.
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        const size_t last = pos + span - 1;
+        const size_t sequence = m_slots[last & m_mask].sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(last);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + span, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (truncated) m_truncated.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < span; i++) {
+        const size_t offset = i * kPayloadBytes;
+        const size_t chunk = (std::min)(kPayloadBytes, length - offset);
+        if (chunk > 0) std::memcpy(m_slots[(pos + i) & m_mask].payload, message.data() + offset, chunk);
+    }
+
+    Slot& head = m_slots[pos & m_mask];
+    head.epochMs = epochMs;
+    head.length = static_cast<uint32_t>(length);
+    head.span = static_cast<uint32_t>(span);
+
+    // Continuation slots first so a visible head implies a complete record.
+    for (size_t i = span; i-- > 1;) m_slots[(pos + i) & m_mask].sequence.store(pos + i + 1, std::memory_order_release);
+    head.sequence.store(pos + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerParked.load(std::memory_order_relaxed) && m_writerParked.exchange(false)) Wake();
+    return true;
+}
+
+bool LogPipeline::HasPending() const {
+    const size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    return m_slots[pos & m_mask].sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+void LogPipeline::AppendTimestamp(int64_t epochMs) {
+    const int64_t second = epochMs >= 0 ? epochMs / 1000 : (epochMs - 999) / 1000;
+    const int millis = static_cast<int>(epochMs - second * 1000);
+    if (second != m_cachedSecond) {
+        const std::time_t t = static_cast<std::time_t>(second);
+        std::tm timeinfo{};
+#ifdef _WIN32
+        localtime_s(&timeinfo, &t);
+#else
+        localtime_r(&t, &timeinfo);
+#endif
+        std::snprintf(m_cachedClock, sizeof(m_cachedClock), "%02d:%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+        m_cachedSecond = second;
+    }
+
+    char stamp[16] = { '[' };
+    std::memcpy(stamp + 1, m_cachedClock, 8);
+    stamp[9] = '.';
+    stamp[10] = static_cast<char>('0' + millis / 100);
+    stamp[11] = static_cast<char>('0' + (millis / 10) % 10);
+    stamp[12] = static_cast<char>('0' + millis % 10);
+    stamp[13] = ']';
+    stamp[14] = ' ';
+    m_batch.append(stamp, 15);
+}
+
+size_t LogPipeline::DrainLocked(bool& sinkRejected) {
+    sinkRejected = false;
+    const size_t capacity = m_mask + 1;
+    size_t total = 0;
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+    for (;;) {
+        m_batch.clear();
+        const size_t batchStart = pos;
+        size_t records = 0;
+
+        const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reportedDropped) {
+            AppendTimestamp(NowEpochMs());
+            m_batch += "(Dropped ";
+            m_batch += std::to_string(dropped - m_reportedDropped);
+            m_batch += " log message(s): queue full)\n";
+        }
+        const uint64_t truncated = m_truncated.load(std::memory_order_relaxed);
+        if (truncated != m_reportedTruncated) {
+            AppendTimestamp(NowEpochMs());
+            m_batch += "(Truncated ";
+            m_batch += std::to_string(truncated - m_reportedTruncated);
+            m_batch += " log message(s) to ";
+            m_batch += std::to_string((std::min)(kMaxRecordSlots, m_mask + 1) * kPayloadBytes);
+            m_batch += " bytes)\n";
+        }
+
+        while (m_batch.size() < m_options.batchBytes) {
+            const Slot& head = m_slots[pos & m_mask];
+            if (head.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+            AppendTimestamp(head.epochMs);
+            size_t remaining = head.length;
+            for (size_t i = 0; i < head.span; i++) {
+                const size_t chunk = (std::min)(kPayloadBytes, remaining);
+                m_batch.append(m_slots[(pos + i) & m_mask].payload, chunk);
+                remaining -= chunk;
+            }
+            m_batch.push_back('\n');
+            pos += head.span;
+            records++;
+        }
+
+        if (m_batch.empty()) break;
+        if (!m_sink || !m_sink(m_batch.data(), m_batch.size())) {
+            sinkRejected = true;
+            break;
+        }
+
+        for (size_t p = batchStart; p != pos; p++) m_slots[p & m_mask].sequence.store(p + capacity, std::memory_order_release);
+        m_dequeuePos.store(pos, std::memory_order_relaxed);
+        m_reportedDropped = dropped;
+        m_reportedTruncated = truncated;
+        total += records;
+        if (records == 0) break;
+    }
+
+    return total;
+}
+
+size_t LogPipeline::Flush() {
+    std::lock_guard<std::mutex> lock(m_drainMutex);
+    bool sinkRejected = false;
+    return DrainLocked(sinkRejected);
+}
+
+void LogPipeline::Wake() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakePending = true;
+    }
+    m_wakeCv.notify_one();
+}
+
+void LogPipeline::Start(IdleTask idleTask) {
+    if (m_running.exchange(true)) return;
+    m_idleTask = std::move(idleTask);
+    m_thread = std::thread(&LogPipeline::ThreadMain, this);
+}
+
+void LogPipeline::Stop() {
+    if (m_running.exchange(false)) {
+        Wake();
+        if (m_thread.joinable()) m_thread.join();
+    }
+    Flush();
+}
+
+void LogPipeline::ThreadMain() {
+    const std::chrono::milliseconds maxRetryDelay = (std::max)(m_options.idleInterval, kMinSinkRetryDelay);
+    std::chrono::milliseconds retryDelay{ 0 };
+    while (m_running.load(std::memory_order_acquire)) {
+        bool sinkRejected = false;
+        {
+            std::lock_guard<std::mutex> drainLock(m_drainMutex);
+            DrainLocked(sinkRejected);
+        }
+        if (m_idleTask) m_idleTask();
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (sinkRejected) {
+            // Records stay queued, so HasPending() would never let the writer park; back off instead of
+            // spinning on the sink. Producer wakes are ignored until the delay passes.
+            retryDelay = retryDelay.count() == 0 ? kMinSinkRetryDelay : (std::min)(retryDelay * 2, maxRetryDelay);
+            m_wakeCv.wait_for(lock, retryDelay, [this]() { return !m_running.load(std::memory_order_acquire); });
+            m_wakePending = false;
+            continue;
+        }
+        retryDelay = std::chrono::milliseconds{ 0 };
+
+        if (m_wakePending) {
+            m_wakePending = false;
+            continue;
+        }
+
+        m_writerParked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!HasPending()) {
+            m_wakeCv.wait_for(lock, m_options.idleInterval,
+                              [this]() { return m_wakePending || !m_running.load(std::memory_order_acquire); });
+            if (m_wakePending) m_wakes.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_wakePending = false;
+        m_writerParked.store(false, std::memory_order_relaxed);
+    }
+
+    Flush();
+    if (m_idleTask) m_idleTask();
+}
+
+} // namespace log_pipeline
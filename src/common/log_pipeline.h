@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace log_pipeline {
+
+constexpr size_t kSlotBytes = 256;
+constexpr size_t kDefaultCapacitySlots = 8192;
+constexpr size_t kMaxRecordSlots = 128;
+constexpr size_t kSlotPayloadBytes = kSlotBytes - sizeof(size_t) - sizeof(int64_t) - 2 * sizeof(uint32_t);
+// Longest message kept whole (about 29 KB). Longer ones are cut to this size, counted, and reported in the log.
+constexpr size_t kMaxRecordBytes = kMaxRecordSlots * kSlotPayloadBytes;
+
+struct LogPipelineOptions {
+    size_t capacitySlots = kDefaultCapacitySlots; // rounded up to a power of two
+    size_t batchBytes = 256 * 1024;
+    std::chrono::milliseconds idleInterval{ 1000 };
+};
+
+// Multi-producer log queue. Producers copy the message into fixed-size slots of a
+// preallocated ring (long messages span consecutive slots), so Submit never allocates.
+// A single consumer formats the timestamps in bulk and hands whole batches to the sink.
+// While the sink rejects batches the writer thread retries with a growing delay, capped at
+// idleInterval; producers keep queueing until the ring is full and then drop.
+class LogPipeline {
+  public:
+    // Returns false when the destination is not ready; the batch is kept and retried later.
+    using Sink = std::function<bool(const char* data, size_t size)>;
+    using IdleTask = std::function<void()>;
+
+    explicit LogPipeline(Sink sink, const LogPipelineOptions& options = {});
+    ~LogPipeline();
+
+    LogPipeline(const LogPipeline&) = delete;
+    LogPipeline& operator=(const LogPipeline&) = delete;
+
+    bool Submit(std::string_view message);
+    bool Submit(int64_t epochMs, std::string_view message);
+
+    // Runs the writer thread. It sleeps until a producer wakes it (or idleInterval passes)
+    // and calls idleTask after every drain.
+    void Start(IdleTask idleTask = {});
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Drains everything currently queued on the calling thread; returns the record count.
+    size_t Flush();
+    void Wake();
+
+    uint64_t DroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t TruncatedCount() const { return m_truncated.load(std::memory_order_relaxed); }
+    uint64_t WakeCount() const { return m_wakes.load(std::memory_order_relaxed); }
+
+  private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence{ 0 };
+        int64_t epochMs = 0;
+        uint32_t length = 0;
+        uint32_t span = 0;
+        char payload[kSlotPayloadBytes];
+    };
+    static_assert(sizeof(Slot) == kSlotBytes, "log slots must stay fixed-size");
+    static constexpr size_t kPayloadBytes = sizeof(Slot::payload);
+
+    bool HasPending() const;
+    // sinkRejected is set when the sink refused a batch and records are still queued.
+    size_t DrainLocked(bool& sinkRejected);
+    void AppendTimestamp(int64_t epochMs);
+    void ThreadMain();
+
+    Sink m_sink;
+    LogPipelineOptions m_options;
+    size_t m_mask = 0;
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(64) std::atomic<size_t> m_dequeuePos{ 0 };
+    std::atomic<uint64_t> m_dropped{ 0 };
+    uint64_t m_reportedDropped = 0;
+    std::atomic<uint64_t> m_truncated{ 0 };
+    uint64_t m_reportedTruncated = 0;
+
+    std::mutex m_drainMutex;
+    std::string m_batch;
+    int64_t m_cachedSecond = INT64_MIN;
+    char m_cachedClock[9] = {};
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+    std::atomic<bool> m_writerParked{ false };
+    std::atomic<uint64_t> m_wakes{ 0 };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    bool m_wakePending = false;
+    IdleTask m_idleTask;
+};
+
+} // namespace log_pipeline
@@ -144,13 +144,13 @@ void RecalculateModeDimensions(Config& config, int screenW, int screenH) {
         }
 
         if (widthUsesExpression) {
-            int newWidth = EvaluateExpression(mode.widthExpr, screenW, screenH, mode.width);
+            int newWidth = EvaluateExpressionCached(mode.widthExpr, screenW, screenH, mode.width);
             if (newWidth > 0) {
                 mode.width = newWidth;
             }
         }
         if (heightUsesExpression) {
-            int newHeight = EvaluateExpression(mode.heightExpr, screenW, screenH, mode.height);
+            int newHeight = EvaluateExpressionCached(mode.heightExpr, screenW, screenH, mode.height);
             if (newHeight > 0) {
                 mode.height = newHeight;
             }
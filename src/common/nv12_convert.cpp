@@ -0,0 +1,233 @@
+#include "nv12_convert.h"
+
+#if TOOLSCREEN_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct Coefficients {
+    std::int16_t yR, yG, yB;
+    std::int16_t uR, uG, uB;
+    std::int16_t vR, vG, vB;
+};
+
+constexpr Coefficients kBt601Coefficients{ 66, 129, 25, -38, -74, 112, 112, -94, -18 };
+constexpr Coefficients kBt709Coefficients{ 47, 157, 16, -26, -87, 112, 112, -102, -10 };
+
+const Coefficients& GetCoefficients(Nv12ColorMatrix matrix) {
+    return matrix == Nv12ColorMatrix::Bt709 ? kBt709Coefficients : kBt601Coefficients;
+}
+
+inline std::uint8_t ClampToByte(std::int32_t value) {
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return static_cast<std::uint8_t>(value);
+}
+
+// Source rows are bottom-up, so output row y reads source row height - 1 - y. yRow1 is null for
+// the last pair of an odd-height frame, whose bottom source row is replicated from the top one.
+struct RowPair {
+    const std::uint8_t* src0;
+    const std::uint8_t* src1;
+    std::uint8_t* yRow0;
+    std::uint8_t* yRow1;
+    std::uint8_t* uvRow;
+};
+
+RowPair GetRowPair(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height, std::uint32_t rowPair) {
+    const size_t stride = static_cast<size_t>(width) * 4u;
+    const size_t uvStride = (static_cast<size_t>(width) + 1u) & ~static_cast<size_t>(1);
+    const std::uint32_t y = rowPair * 2u;
+    const bool hasSecondRow = y + 1u < height;
+
+    RowPair rows;
+    rows.src0 = rgba + static_cast<size_t>(height - 1u - y) * stride;
+    rows.src1 = hasSecondRow ? rgba + static_cast<size_t>(height - 2u - y) * stride : rows.src0;
+    rows.yRow0 = nv12 + static_cast<size_t>(y) * width;
+    rows.yRow1 = hasSecondRow ? rows.yRow0 + width : nullptr;
+    rows.uvRow = nv12 + static_cast<size_t>(width) * height + static_cast<size_t>(rowPair) * uvStride;
+    return rows;
+}
+
+// Converts the 2x2 blocks starting at xBegin (even) through the end of the row. The SIMD kernels
+// use this for the columns left over after their last full vector.
+void ConvertBlocksScalar(const RowPair& rows, std::uint32_t width, std::uint32_t xBegin, const Coefficients& c) {
+    for (std::uint32_t x = xBegin; x < width; x += 2) {
+        const std::uint32_t x1 = x + 1u < width ? x + 1u : x;
+        const std::uint8_t* p00 = rows.src0 + static_cast<size_t>(x) * 4u;
+        const std::uint8_t* p10 = rows.src0 + static_cast<size_t>(x1) * 4u;
+        const std::uint8_t* p01 = rows.src1 + static_cast<size_t>(x) * 4u;
+        const std::uint8_t* p11 = rows.src1 + static_cast<size_t>(x1) * 4u;
+
+        const auto luma = [&c](const std::uint8_t* p) {
+            return ClampToByte(((c.yR * p[0] + c.yG * p[1] + c.yB * p[2] + 128) >> 8) + 16);
+        };
+        rows.yRow0[x] = luma(p00);
+        if (x1 != x) rows.yRow0[x1] = luma(p10);
+        if (rows.yRow1) {
+            rows.yRow1[x] = luma(p01);
+            if (x1 != x) rows.yRow1[x1] = luma(p11);
+        }
+
+        const std::int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
+        const std::int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
+        const std::int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
+        rows.uvRow[x] = ClampToByte(((c.uR * avgR + c.uG * avgG + c.uB * avgB + 128) >> 8) + 128);
+        rows.uvRow[x + 1] = ClampToByte(((c.vR * avgR + c.vG * avgG + c.vB * avgB + 128) >> 8) + 128);
+    }
+}
+
+void ConvertRowsScalar(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height, const Coefficients& c,
+                       std::uint32_t firstRowPair, std::uint32_t endRowPair) {
+    for (std::uint32_t pair = firstRowPair; pair < endRowPair; ++pair) {
+        ConvertBlocksScalar(GetRowPair(rgba, nv12, width, height, pair), width, 0, c);
+    }
+}
+
+#if TOOLSCREEN_SIMD_X86
+
+// The vector kernels widen each RGBA pixel to four 16-bit lanes and use madd against
+// {r, g, b, 0} coefficients, so every intermediate matches the scalar int32 arithmetic exactly.
+// Luma sums reach 220 * 255, chroma sums stay within +-112 * 255, and the 2x2 channel sums fit in
+// 16 bits, so nothing saturates before the final pack.
+
+TOOLSCREEN_TARGET_SSE41 inline __m128i LumaSse41(__m128i pixels4, __m128i coefficients) {
+    const __m128i lo = _mm_cvtepu8_epi16(pixels4);
+    const __m128i hi = _mm_cvtepu8_epi16(_mm_srli_si128(pixels4, 8));
+    const __m128i sums = _mm_hadd_epi32(_mm_madd_epi16(lo, coefficients), _mm_madd_epi16(hi, coefficients));
+    return _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(sums, _mm_set1_epi32(128)), 8), _mm_set1_epi32(16));
+}
+
+// Two 2x2 blocks from four columns of the row pair, returned as U0 V0 U1 V1.
+TOOLSCREEN_TARGET_SSE41 inline __m128i ChromaSse41(__m128i top4, __m128i bottom4, __m128i uCoefficients, __m128i vCoefficients) {
+    const __m128i pair01 = _mm_add_epi16(_mm_cvtepu8_epi16(top4), _mm_cvtepu8_epi16(bottom4));
+    const __m128i pair23 = _mm_add_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(top4, 8)), _mm_cvtepu8_epi16(_mm_srli_si128(bottom4, 8)));
+    const __m128i blockSums = _mm_add_epi16(_mm_unpacklo_epi64(pair01, pair23), _mm_unpackhi_epi64(pair01, pair23));
+    const __m128i average = _mm_srli_epi16(_mm_add_epi16(blockSums, _mm_set1_epi16(2)), 2);
+    const __m128i uuvv = _mm_hadd_epi32(_mm_madd_epi16(average, uCoefficients), _mm_madd_epi16(average, vCoefficients));
+    const __m128i scaled = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(uuvv, _mm_set1_epi32(128)), 8), _mm_set1_epi32(128));
+    return _mm_shuffle_epi32(scaled, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+TOOLSCREEN_TARGET_SSE41 void ConvertRowsSse41(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height,
+                                        const Coefficients& c, std::uint32_t firstRowPair, std::uint32_t endRowPair) {
+    const __m128i yCoefficients = _mm_setr_epi16(c.yR, c.yG, c.yB, 0, c.yR, c.yG, c.yB, 0);
+    const __m128i uCoefficients = _mm_setr_epi16(c.uR, c.uG, c.uB, 0, c.uR, c.uG, c.uB, 0);
+    const __m128i vCoefficients = _mm_setr_epi16(c.vR, c.vG, c.vB, 0, c.vR, c.vG, c.vB, 0);
+
+    for (std::uint32_t pair = firstRowPair; pair < endRowPair; ++pair) {
+        const RowPair rows = GetRowPair(rgba, nv12, width, height, pair);
+        std::uint32_t x = 0;
+        for (; x + 8u <= width; x += 8u) {
+            const __m128i top0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.src0 + x * 4u));
+            const __m128i top1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.src0 + x * 4u + 16u));
+            const __m128i bottom0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.src1 + x * 4u));
+            const __m128i bottom1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows.src1 + x * 4u + 16u));
+
+            const __m128i luma0 = _mm_packs_epi32(LumaSse41(top0, yCoefficients), LumaSse41(top1, yCoefficients));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(rows.yRow0 + x), _mm_packus_epi16(luma0, luma0));
+            if (rows.yRow1) {
+                const __m128i luma1 = _mm_packs_epi32(LumaSse41(bottom0, yCoefficients), LumaSse41(bottom1, yCoefficients));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(rows.yRow1 + x), _mm_packus_epi16(luma1, luma1));
+            }
+
+            const __m128i chroma = _mm_packs_epi32(ChromaSse41(top0, bottom0, uCoefficients, vCoefficients),
+                                                   ChromaSse41(top1, bottom1, uCoefficients, vCoefficients));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(rows.uvRow + x), _mm_packus_epi16(chroma, chroma));
+        }
+        ConvertBlocksScalar(rows, width, x, c);
+    }
+}
+
+// AVX2 unpack/hadd work per 128-bit lane; with pixels 0-7 loaded, the lane split happens to
+// leave luma in pixel order, and the (3, 1, 2, 0) shuffle leaves chroma as U0 V0 .. U3 V3.
+TOOLSCREEN_TARGET_AVX2 inline __m256i LumaAvx2(__m256i pixels8, __m256i coefficients) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lo = _mm256_unpacklo_epi8(pixels8, zero);
+    const __m256i hi = _mm256_unpackhi_epi8(pixels8, zero);
+    const __m256i sums = _mm256_hadd_epi32(_mm256_madd_epi16(lo, coefficients), _mm256_madd_epi16(hi, coefficients));
+    return _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(sums, _mm256_set1_epi32(128)), 8), _mm256_set1_epi32(16));
+}
+
+TOOLSCREEN_TARGET_AVX2 inline __m256i ChromaAvx2(__m256i top8, __m256i bottom8, __m256i uCoefficients, __m256i vCoefficients) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i pairsLo = _mm256_add_epi16(_mm256_unpacklo_epi8(top8, zero), _mm256_unpacklo_epi8(bottom8, zero));
+    const __m256i pairsHi = _mm256_add_epi16(_mm256_unpackhi_epi8(top8, zero), _mm256_unpackhi_epi8(bottom8, zero));
+    const __m256i blockSums = _mm256_add_epi16(_mm256_unpacklo_epi64(pairsLo, pairsHi), _mm256_unpackhi_epi64(pairsLo, pairsHi));
+    const __m256i average = _mm256_srli_epi16(_mm256_add_epi16(blockSums, _mm256_set1_epi16(2)), 2);
+    const __m256i uuvv = _mm256_hadd_epi32(_mm256_madd_epi16(average, uCoefficients), _mm256_madd_epi16(average, vCoefficients));
+    const __m256i scaled = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(uuvv, _mm256_set1_epi32(128)), 8), _mm256_set1_epi32(128));
+    return _mm256_shuffle_epi32(scaled, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// Packs two vectors of eight in-order int32 values into sixteen in-order bytes.
+TOOLSCREEN_TARGET_AVX2 inline __m128i PackOrderedAvx2(__m256i first, __m256i second) {
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+TOOLSCREEN_TARGET_AVX2 void ConvertRowsAvx2(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height,
+                                      const Coefficients& c, std::uint32_t firstRowPair, std::uint32_t endRowPair) {
+    const __m256i yCoefficients = _mm256_setr_epi16(c.yR, c.yG, c.yB, 0, c.yR, c.yG, c.yB, 0, c.yR, c.yG, c.yB, 0, c.yR, c.yG, c.yB, 0);
+    const __m256i uCoefficients = _mm256_setr_epi16(c.uR, c.uG, c.uB, 0, c.uR, c.uG, c.uB, 0, c.uR, c.uG, c.uB, 0, c.uR, c.uG, c.uB, 0);
+    const __m256i vCoefficients = _mm256_setr_epi16(c.vR, c.vG, c.vB, 0, c.vR, c.vG, c.vB, 0, c.vR, c.vG, c.vB, 0, c.vR, c.vG, c.vB, 0);
+
+    for (std::uint32_t pair = firstRowPair; pair < endRowPair; ++pair) {
+        const RowPair rows = GetRowPair(rgba, nv12, width, height, pair);
+        std::uint32_t x = 0;
+        for (; x + 16u <= width; x += 16u) {
+            const __m256i top0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows.src0 + x * 4u));
+            const __m256i top1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows.src0 + x * 4u + 32u));
+            const __m256i bottom0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows.src1 + x * 4u));
+            const __m256i bottom1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows.src1 + x * 4u + 32u));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.yRow0 + x),
+                             PackOrderedAvx2(LumaAvx2(top0, yCoefficients), LumaAvx2(top1, yCoefficients)));
+            if (rows.yRow1) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.yRow1 + x),
+                                 PackOrderedAvx2(LumaAvx2(bottom0, yCoefficients), LumaAvx2(bottom1, yCoefficients)));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rows.uvRow + x),
+                             PackOrderedAvx2(ChromaAvx2(top0, bottom0, uCoefficients, vCoefficients),
+                                             ChromaAvx2(top1, bottom1, uCoefficients, vCoefficients)));
+        }
+        ConvertBlocksScalar(rows, width, x, c);
+    }
+}
+
+#endif // TOOLSCREEN_SIMD_X86
+
+} // namespace
+
+size_t GetNv12FrameBytes(std::uint32_t width, std::uint32_t height) {
+    const size_t uvStride = (static_cast<size_t>(width) + 1u) & ~static_cast<size_t>(1);
+    return static_cast<size_t>(width) * height + uvStride * ((static_cast<size_t>(height) + 1u) / 2u);
+}
+
+void ConvertRgbaToNv12(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height, Nv12ColorMatrix matrix) {
+    ConvertRgbaToNv12Rows(GetBestSimdLevel(), rgba, nv12, width, height, matrix, 0, (height + 1u) / 2u);
+}
+
+void ConvertRgbaToNv12Rows(SimdLevel level, const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height,
+                           Nv12ColorMatrix matrix, std::uint32_t firstRowPair, std::uint32_t endRowPair) {
+    if (!rgba || !nv12 || width == 0 || height == 0) { return; }
+    const std::uint32_t rowPairs = (height + 1u) / 2u;
+    if (endRowPair > rowPairs) { endRowPair = rowPairs; }
+    if (firstRowPair >= endRowPair) { return; }
+
+    const Coefficients& coefficients = GetCoefficients(matrix);
+#if TOOLSCREEN_SIMD_X86
+    if (level == SimdLevel::Avx2 && IsSimdLevelSupported(SimdLevel::Avx2)) {
+        ConvertRowsAvx2(rgba, nv12, width, height, coefficients, firstRowPair, endRowPair);
+        return;
+    }
+    if (level == SimdLevel::Sse41 && IsSimdLevelSupported(SimdLevel::Sse41)) {
+        ConvertRowsSse41(rgba, nv12, width, height, coefficients, firstRowPair, endRowPair);
+        return;
+    }
+#else
+    (void)level;
+#endif
+    ConvertRowsScalar(rgba, nv12, width, height, coefficients, firstRowPair, endRowPair);
+}
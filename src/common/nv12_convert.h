@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/cpu_features.h"
+
+enum class Nv12ColorMatrix : std::uint8_t {
+    Bt601,
+    Bt709,
+};
+
+// NV12 layout produced by the converters: a width*height Y plane followed by an interleaved UV
+// plane of (height+1)/2 rows whose stride is width rounded up to even. For even dimensions this
+// is the usual width*height*3/2 frame.
+size_t GetNv12FrameBytes(std::uint32_t width, std::uint32_t height);
+
+// Converts bottom-up RGBA rows (as read back from GL) into a top-down NV12 frame using 8-bit
+// fixed-point limited-range coefficients and the best kernel for this CPU. Odd widths and heights
+// replicate the last column/row into the final chroma sample.
+void ConvertRgbaToNv12(const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height, Nv12ColorMatrix matrix);
+
+// Converts only output rows [2 * firstRowPair, 2 * endRowPair) so callers can split a frame into
+// bands across threads. Unsupported levels fall back to the scalar kernel.
+void ConvertRgbaToNv12Rows(SimdLevel level, const std::uint8_t* rgba, std::uint8_t* nv12, std::uint32_t width, std::uint32_t height,
+                           Nv12ColorMatrix matrix, std::uint32_t firstRowPair, std::uint32_t endRowPair);
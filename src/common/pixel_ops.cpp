@@ -0,0 +1,299 @@
+#include "pixel_ops.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if TOOLSCREEN_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr float kChannelScale = 255.0f * static_cast<float>(1 << ColorKeyMatcher::kFractionBits);
+
+// Keys beyond this many fall back to the scalar kernel; the UI allows far fewer.
+constexpr size_t kMaxVectorKeys = 16;
+
+inline std::int16_t QuantizeChannel(float value) {
+    const float clamped = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<std::int16_t>(std::lround(clamped * kChannelScale));
+}
+
+constexpr std::uint64_t kHashPrime1 = 11400714785074694791ull;
+constexpr std::uint64_t kHashPrime2 = 14029467366897019727ull;
+constexpr std::uint64_t kHashPrime3 = 1609587929392839161ull;
+constexpr std::uint64_t kHashPrime4 = 9650029242287828579ull;
+constexpr std::uint64_t kHashPrime5 = 2870177450012600261ull;
+
+inline std::uint64_t RotateLeft64(std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+inline std::uint64_t ReadU64(const std::uint8_t* bytes) {
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t ReadU32(const std::uint8_t* bytes) {
+    std::uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t HashRound(std::uint64_t acc, std::uint64_t lane) {
+    acc += lane * kHashPrime2;
+    acc = RotateLeft64(acc, 31);
+    return acc * kHashPrime1;
+}
+
+inline std::uint64_t HashMergeRound(std::uint64_t acc, std::uint64_t value) {
+    acc ^= HashRound(0, value);
+    return acc * kHashPrime1 + kHashPrime4;
+}
+
+void ConvertOpaqueScalar(std::uint8_t* pixels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        std::uint8_t* pixel = pixels + i * 4u;
+        const std::uint8_t blue = pixel[0];
+        pixel[0] = pixel[2];
+        pixel[2] = blue;
+        pixel[3] = 255;
+    }
+}
+
+void ConvertColorKeyedScalar(std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        std::uint8_t* pixel = pixels + i * 4u;
+        const std::uint8_t blue = pixel[0];
+        pixel[0] = pixel[2];
+        pixel[2] = blue;
+        pixel[3] = keys.Matches(pixel[0], pixel[1], pixel[2]) ? 0 : 255;
+    }
+}
+
+#if TOOLSCREEN_SIMD_X86
+
+// Each pixel is widened to {r, g, b, 0} 16-bit lanes scaled by 64; subtracting a key and using
+// madd plus hadd gives one squared distance per pixel in pixel order. Differences stay within
+// +-16320 and the three-channel sum below 800M, so neither the lanes nor the sums overflow.
+
+TOOLSCREEN_TARGET_SSE41 void ConvertOpaqueSse41(std::uint8_t* pixels, size_t pixelCount) {
+    const __m128i swizzle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    for (; i + 4u <= pixelCount; i += 4u) {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4u);
+        _mm_storeu_si128(block, _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(block), swizzle), alpha));
+    }
+    ConvertOpaqueScalar(pixels + i * 4u, pixelCount - i);
+}
+
+TOOLSCREEN_TARGET_SSE41 void ConvertColorKeyedSse41(std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys) {
+    const std::vector<ColorKeyMatcher::Key>& keyList = keys.GetKeys();
+    __m128i keyColors[kMaxVectorKeys];
+    __m128i keyThresholds[kMaxVectorKeys];
+    for (size_t k = 0; k < keyList.size(); ++k) {
+        const ColorKeyMatcher::Key& key = keyList[k];
+        keyColors[k] = _mm_setr_epi16(key.r, key.g, key.b, 0, key.r, key.g, key.b, 0);
+        keyThresholds[k] = _mm_set1_epi32(key.maxDistanceSq);
+    }
+
+    const __m128i swizzle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+    size_t i = 0;
+    for (; i + 4u <= pixelCount; i += 4u) {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4u);
+        const __m128i rgb = _mm_and_si128(_mm_shuffle_epi8(_mm_loadu_si128(block), swizzle), rgbMask);
+        const __m128i lo = _mm_slli_epi16(_mm_cvtepu8_epi16(rgb), ColorKeyMatcher::kFractionBits);
+        const __m128i hi = _mm_slli_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(rgb, 8)), ColorKeyMatcher::kFractionBits);
+
+        __m128i unmatched = _mm_set1_epi32(-1);
+        for (size_t k = 0; k < keyList.size(); ++k) {
+            const __m128i dLo = _mm_sub_epi16(lo, keyColors[k]);
+            const __m128i dHi = _mm_sub_epi16(hi, keyColors[k]);
+            const __m128i distance = _mm_hadd_epi32(_mm_madd_epi16(dLo, dLo), _mm_madd_epi16(dHi, dHi));
+            unmatched = _mm_and_si128(unmatched, _mm_cmpgt_epi32(distance, keyThresholds[k]));
+        }
+        _mm_storeu_si128(block, _mm_or_si128(rgb, _mm_and_si128(unmatched, alpha)));
+    }
+    ConvertColorKeyedScalar(pixels + i * 4u, pixelCount - i, keys);
+}
+
+TOOLSCREEN_TARGET_AVX2 void ConvertOpaqueAvx2(std::uint8_t* pixels, size_t pixelCount) {
+    const __m256i swizzle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14,
+                                             13, 12, 15);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    for (; i + 8u <= pixelCount; i += 8u) {
+        __m256i* block = reinterpret_cast<__m256i*>(pixels + i * 4u);
+        _mm256_storeu_si256(block, _mm256_or_si256(_mm256_shuffle_epi8(_mm256_loadu_si256(block), swizzle), alpha));
+    }
+    ConvertOpaqueScalar(pixels + i * 4u, pixelCount - i);
+}
+
+// unpacklo/unpackhi split each 128-bit lane, so the hadd result holds pixels 0-3 in the low
+// lane and 4-7 in the high lane, matching the dword order of the source pixels.
+TOOLSCREEN_TARGET_AVX2 void ConvertColorKeyedAvx2(std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys) {
+    const std::vector<ColorKeyMatcher::Key>& keyList = keys.GetKeys();
+    __m256i keyColors[kMaxVectorKeys];
+    __m256i keyThresholds[kMaxVectorKeys];
+    for (size_t k = 0; k < keyList.size(); ++k) {
+        const ColorKeyMatcher::Key& key = keyList[k];
+        keyColors[k] = _mm256_setr_epi16(key.r, key.g, key.b, 0, key.r, key.g, key.b, 0, key.r, key.g, key.b, 0, key.r, key.g, key.b, 0);
+        keyThresholds[k] = _mm256_set1_epi32(key.maxDistanceSq);
+    }
+
+    const __m256i swizzle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14,
+                                             13, 12, 15);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i rgbMask = _mm256_set1_epi32(0x00FFFFFF);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8u <= pixelCount; i += 8u) {
+        __m256i* block = reinterpret_cast<__m256i*>(pixels + i * 4u);
+        const __m256i rgb = _mm256_and_si256(_mm256_shuffle_epi8(_mm256_loadu_si256(block), swizzle), rgbMask);
+        const __m256i lo = _mm256_slli_epi16(_mm256_unpacklo_epi8(rgb, zero), ColorKeyMatcher::kFractionBits);
+        const __m256i hi = _mm256_slli_epi16(_mm256_unpackhi_epi8(rgb, zero), ColorKeyMatcher::kFractionBits);
+
+        __m256i unmatched = _mm256_set1_epi32(-1);
+        for (size_t k = 0; k < keyList.size(); ++k) {
+            const __m256i dLo = _mm256_sub_epi16(lo, keyColors[k]);
+            const __m256i dHi = _mm256_sub_epi16(hi, keyColors[k]);
+            const __m256i distance = _mm256_hadd_epi32(_mm256_madd_epi16(dLo, dLo), _mm256_madd_epi16(dHi, dHi));
+            unmatched = _mm256_and_si256(unmatched, _mm256_cmpgt_epi32(distance, keyThresholds[k]));
+        }
+        _mm256_storeu_si256(block, _mm256_or_si256(rgb, _mm256_and_si256(unmatched, alpha)));
+    }
+    ConvertColorKeyedScalar(pixels + i * 4u, pixelCount - i, keys);
+}
+
+#endif // TOOLSCREEN_SIMD_X86
+
+} // namespace
+
+void ColorKeyMatcher::AddKey(float r, float g, float b, float sensitivity) {
+    Key key;
+    key.r = QuantizeChannel(r);
+    key.g = QuantizeChannel(g);
+    key.b = QuantizeChannel(b);
+
+    const double radius = static_cast<double>(sensitivity) * kChannelScale;
+    const double radiusSq = radius * radius;
+    const double maxThreshold = static_cast<double>((std::numeric_limits<std::int32_t>::max)());
+    key.maxDistanceSq = radiusSq >= maxThreshold ? (std::numeric_limits<std::int32_t>::max)() : static_cast<std::int32_t>(radiusSq);
+    m_keys.push_back(key);
+}
+
+bool ColorKeyMatcher::Matches(std::uint8_t r, std::uint8_t g, std::uint8_t b) const {
+    const std::int32_t pr = static_cast<std::int32_t>(r) << kFractionBits;
+    const std::int32_t pg = static_cast<std::int32_t>(g) << kFractionBits;
+    const std::int32_t pb = static_cast<std::int32_t>(b) << kFractionBits;
+    for (const Key& key : m_keys) {
+        const std::int32_t dr = pr - key.r;
+        const std::int32_t dg = pg - key.g;
+        const std::int32_t db = pb - key.b;
+        if (dr * dr + dg * dg + db * db <= key.maxDistanceSq) { return true; }
+    }
+    return false;
+}
+
+void ConvertBgraToRgbaOpaque(std::uint8_t* pixels, size_t pixelCount) { ConvertBgraToRgbaOpaque(GetBestSimdLevel(), pixels, pixelCount); }
+
+void ConvertBgraToRgbaOpaque(SimdLevel level, std::uint8_t* pixels, size_t pixelCount) {
+    if (!pixels || pixelCount == 0) { return; }
+#if TOOLSCREEN_SIMD_X86
+    if (level == SimdLevel::Avx2 && IsSimdLevelSupported(SimdLevel::Avx2)) {
+        ConvertOpaqueAvx2(pixels, pixelCount);
+        return;
+    }
+    if (level == SimdLevel::Sse41 && IsSimdLevelSupported(SimdLevel::Sse41)) {
+        ConvertOpaqueSse41(pixels, pixelCount);
+        return;
+    }
+#else
+    (void)level;
+#endif
+    ConvertOpaqueScalar(pixels, pixelCount);
+}
+
+void ConvertBgraToRgbaColorKeyed(std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys) {
+    ConvertBgraToRgbaColorKeyed(GetBestSimdLevel(), pixels, pixelCount, keys);
+}
+
+void ConvertBgraToRgbaColorKeyed(SimdLevel level, std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys) {
+    if (!pixels || pixelCount == 0) { return; }
+    if (keys.Empty()) {
+        ConvertBgraToRgbaOpaque(level, pixels, pixelCount);
+        return;
+    }
+#if TOOLSCREEN_SIMD_X86
+    if (keys.GetKeys().size() <= kMaxVectorKeys) {
+        if (level == SimdLevel::Avx2 && IsSimdLevelSupported(SimdLevel::Avx2)) {
+            ConvertColorKeyedAvx2(pixels, pixelCount, keys);
+            return;
+        }
+        if (level == SimdLevel::Sse41 && IsSimdLevelSupported(SimdLevel::Sse41)) {
+            ConvertColorKeyedSse41(pixels, pixelCount, keys);
+            return;
+        }
+    }
+#else
+    (void)level;
+#endif
+    ConvertColorKeyedScalar(pixels, pixelCount, keys);
+}
+
+std::uint64_t HashFrameBytes(const void* data, size_t size) {
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    const std::uint8_t* const end = bytes + size;
+    std::uint64_t hash;
+
+    if (size >= 32u) {
+        std::uint64_t v1 = kHashPrime1 + kHashPrime2;
+        std::uint64_t v2 = kHashPrime2;
+        std::uint64_t v3 = 0;
+        std::uint64_t v4 = 0 - kHashPrime1;
+        const std::uint8_t* const limit = end - 32u;
+        do {
+            v1 = HashRound(v1, ReadU64(bytes));
+            v2 = HashRound(v2, ReadU64(bytes + 8));
+            v3 = HashRound(v3, ReadU64(bytes + 16));
+            v4 = HashRound(v4, ReadU64(bytes + 24));
+            bytes += 32;
+        } while (bytes <= limit);
+
+        hash = RotateLeft64(v1, 1) + RotateLeft64(v2, 7) + RotateLeft64(v3, 12) + RotateLeft64(v4, 18);
+        hash = HashMergeRound(hash, v1);
+        hash = HashMergeRound(hash, v2);
+        hash = HashMergeRound(hash, v3);
+        hash = HashMergeRound(hash, v4);
+    } else {
+        hash = kHashPrime5;
+    }
+
+    hash += static_cast<std::uint64_t>(size);
+
+    while (bytes + 8 <= end) {
+        hash ^= HashRound(0, ReadU64(bytes));
+        hash = RotateLeft64(hash, 27) * kHashPrime1 + kHashPrime4;
+        bytes += 8;
+    }
+    if (bytes + 4 <= end) {
+        hash ^= static_cast<std::uint64_t>(ReadU32(bytes)) * kHashPrime1;
+        hash = RotateLeft64(hash, 23) * kHashPrime2 + kHashPrime3;
+        bytes += 4;
+    }
+    while (bytes < end) {
+        hash ^= static_cast<std::uint64_t>(*bytes) * kHashPrime5;
+        hash = RotateLeft64(hash, 11) * kHashPrime1;
+        ++bytes;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kHashPrime2;
+    hash ^= hash >> 29;
+    hash *= kHashPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
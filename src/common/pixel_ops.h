@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/cpu_features.h"
+
+// Color keys in the integer form the pixel kernels test against. Channels are stored in 1/64ths
+// of an 8-bit step, so keys picked as floats stay within a rounding step of the float distance
+// test while every pixel is evaluated with 16-bit lanes and 32-bit sums.
+class ColorKeyMatcher {
+public:
+    static constexpr int kFractionBits = 6;
+
+    struct Key {
+        std::int16_t r = 0;
+        std::int16_t g = 0;
+        std::int16_t b = 0;
+        std::int32_t maxDistanceSq = 0;
+    };
+
+    void Clear() { m_keys.clear(); }
+    // Color components and sensitivity are normalized [0, 1] values, as stored in ColorKeyConfig.
+    void AddKey(float r, float g, float b, float sensitivity);
+
+    bool Empty() const { return m_keys.empty(); }
+    const std::vector<Key>& GetKeys() const { return m_keys; }
+    bool Matches(std::uint8_t r, std::uint8_t g, std::uint8_t b) const;
+
+private:
+    std::vector<Key> m_keys;
+};
+
+// In-place BGRA -> RGBA swizzle with alpha forced to 255, for GDI captures read with GetDIBits.
+void ConvertBgraToRgbaOpaque(std::uint8_t* pixels, size_t pixelCount);
+void ConvertBgraToRgbaOpaque(SimdLevel level, std::uint8_t* pixels, size_t pixelCount);
+
+// Same swizzle, but pixels within any key's distance get alpha 0 instead of 255.
+void ConvertBgraToRgbaColorKeyed(std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys);
+void ConvertBgraToRgbaColorKeyed(SimdLevel level, std::uint8_t* pixels, size_t pixelCount, const ColorKeyMatcher& keys);
+
+// 64-bit content hash for frame dirty checks (XXH64 construction, seed 0). Consumers compare it
+// against the previous frame's hash to skip swizzles, decodes and texture uploads.
+std::uint64_t HashFrameBytes(const void* data, size_t size);
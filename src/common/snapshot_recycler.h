@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Storage for RCU-published immutable snapshots (config snapshots) that reuses retired snapshots instead of
+// allocating a fresh object for every publish.
+//
+// Snapshots are handed out as shared_ptr with a deleter that returns the object to a small free list when the last
+// reader drops it. The next publish copy-assigns into a returned object, which lets std::vector and std::string keep
+// their existing buffers, so republishing after a small edit copies bytes for unchanged sections instead of
+// reallocating every string, vector and nested element.
+//
+// Readers are unaffected: they still load a shared_ptr and the object it points to never changes while any of them
+// holds it, because it only becomes reusable once the reference count reaches zero.
+template <typename T, size_t MaxRetained = 4>
+class SnapshotRecycler {
+  public:
+    SnapshotRecycler() : m_pool(std::make_shared<Pool>()) {}
+
+    SnapshotRecycler(const SnapshotRecycler&) = delete;
+    SnapshotRecycler& operator=(const SnapshotRecycler&) = delete;
+
+    // Returns writable storage holding a copy of value, for the caller to finish (sanitize) and then publish.
+    // Allocates only when no retired snapshot is available.
+    std::shared_ptr<T> AcquireCopyOf(const T& value) {
+        std::unique_ptr<T> object;
+        {
+            std::lock_guard<std::mutex> lock(m_pool->mutex);
+            if (!m_pool->retired.empty()) {
+                object = std::move(m_pool->retired.back());
+                m_pool->retired.pop_back();
+                ++m_pool->reusedCount;
+            } else {
+                ++m_pool->allocatedCount;
+            }
+        }
+
+        if (object) {
+            *object = value;
+        } else {
+            object = std::make_unique<T>(value);
+        }
+        return std::shared_ptr<T>(object.release(), Retire{ m_pool });
+    }
+
+    size_t ReusedCount() const {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        return m_pool->reusedCount;
+    }
+
+    size_t AllocatedCount() const {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        return m_pool->allocatedCount;
+    }
+
+  private:
+    // Shared with every outstanding snapshot's deleter so snapshots may outlive the recycler.
+    struct Pool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<T>> retired;
+        size_t reusedCount = 0;
+        size_t allocatedCount = 0;
+    };
+
+    // Runs on whichever thread drops the last reference to a snapshot.
+    struct Retire {
+        std::shared_ptr<Pool> pool;
+
+        void operator()(T* object) const {
+            std::unique_ptr<T> owned(object);
+            std::lock_guard<std::mutex> lock(pool->mutex);
+            if (pool->retired.size() < MaxRetained) { pool->retired.push_back(std::move(owned)); }
+        }
+    };
+
+    std::shared_ptr<Pool> m_pool;
+};
@@ -1,7 +1,14 @@
 #include "utils.h"
+#include "common/gzip_writer.h"
+#include "common/log_pipeline.h"
+#include "common/decode_worker_pool.h"
+#include "common/file_watch_registry.h"
 #include "common/video_media.h"
+#include "config/config_diff.h"
 #include "features/game_state_source.h"
+#include "features/game_state_watcher.h"
 #include "gui/gui.h"
+#include "hooks/compiled_input_map.h"
 #include "hooks/input_hook.h"
 #include "runtime/logic_thread.h"
 #include "render/mirror_thread.h"
@@ -30,9 +37,12 @@ extern std::atomic<GLuint> g_cachedGameTextureId;
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <set>
 #include <shared_mutex>
 #include <sstream>
 #include <thread>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -236,310 +246,38 @@ bool IsWindowInForegroundTree(HWND hwnd) {
 }
 
 
-static uint32_t g_crc32Table[256];
-static std::once_flag g_crc32InitFlag;
-
-static void InitCrc32Table() {
-    std::call_once(g_crc32InitFlag, []() {
-        for (uint32_t i = 0; i < 256; i++) {
-            uint32_t c = i;
-            for (int j = 0; j < 8; j++) { c = (c & 1u) ? ((c >> 1) ^ 0xEDB88320u) : (c >> 1); }
-            g_crc32Table[i] = c;
-        }
-    });
-}
-
-static uint32_t Crc32(const uint8_t* data, size_t size) {
-    InitCrc32Table();
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < size; i++) { crc = g_crc32Table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8); }
-    return crc ^ 0xFFFFFFFFu;
-}
-
 static bool FileExistsW(const std::wstring& path) {
     DWORD attrs = GetFileAttributesW(path.c_str());
     return (attrs != INVALID_FILE_ATTRIBUTES) && ((attrs & FILE_ATTRIBUTE_DIRECTORY) == 0);
 }
 
-static bool ReadFileBytes(const std::wstring& path, std::vector<uint8_t>& out) {
-    // Open via std::filesystem::path so wide Win32 APIs are used.
-    std::ifstream in(std::filesystem::path(path), std::ios::binary | std::ios::ate);
-    if (!in.is_open()) return false;
-
-    std::streamoff size = in.tellg();
-    if (size < 0) return false;
-    in.seekg(0, std::ios::beg);
-
-    out.resize(static_cast<size_t>(size));
-    if (!out.empty()) {
-        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
-        if (in.bad() || static_cast<size_t>(in.gcount()) != out.size()) return false;
-    }
-    return true;
-}
-
-static void WriteLE32(std::ofstream& out, uint32_t v) {
-    uint8_t b[4] = { (uint8_t)(v & 0xFFu), (uint8_t)((v >> 8) & 0xFFu), (uint8_t)((v >> 16) & 0xFFu), (uint8_t)((v >> 24) & 0xFFu) };
-    out.write(reinterpret_cast<const char*>(b), 4);
-}
-
-static uint16_t ReverseBits(uint16_t v, uint8_t bitCount) {
-    uint16_t r = 0;
-    for (uint8_t i = 0; i < bitCount; i++) {
-        r = static_cast<uint16_t>((r << 1) | (v & 1u));
-        v >>= 1;
-    }
-    return r;
-}
-
-struct HuffCode {
-    uint16_t code = 0;
-    uint8_t bits = 0;
-};
-
-struct BitWriter {
-    std::vector<uint8_t> bytes;
-    uint32_t bitBuffer = 0;
-    int bitCount = 0;
-
-    void WriteBits(uint32_t value, int count) {
-        bitBuffer |= ((value & ((1u << count) - 1u)) << bitCount);
-        bitCount += count;
-        while (bitCount >= 8) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer >>= 8;
-            bitCount -= 8;
-        }
-    }
-
-    void FlushToByteBoundary() {
-        if (bitCount > 0) {
-            bytes.push_back(static_cast<uint8_t>(bitBuffer & 0xFFu));
-            bitBuffer = 0;
-            bitCount = 0;
-        }
-    }
-};
-
-static void BuildCanonicalCodes(const uint8_t* lengths, size_t count, std::vector<HuffCode>& out) {
-    out.assign(count, {});
-
-    int blCount[16] = { 0 };
-    for (size_t i = 0; i < count; i++) {
-        if (lengths[i] > 0 && lengths[i] <= 15) blCount[lengths[i]]++;
-    }
-
-    int nextCode[16] = { 0 };
-    int code = 0;
-    for (int bits = 1; bits <= 15; bits++) {
-        code = (code + blCount[bits - 1]) << 1;
-        nextCode[bits] = code;
-    }
-
-    for (size_t symbol = 0; symbol < count; symbol++) {
-        uint8_t len = lengths[symbol];
-        if (len == 0) continue;
-        uint16_t c = static_cast<uint16_t>(nextCode[len]++);
-        out[symbol].bits = len;
-        out[symbol].code = ReverseBits(c, len);
-    }
-}
-
-static std::once_flag g_fixedCodesInitFlag;
-static std::vector<HuffCode> g_fixedLitLenCodes;
-static std::vector<HuffCode> g_fixedDistCodes;
-
-static void InitFixedCodes() {
-    std::call_once(g_fixedCodesInitFlag, []() {
-        std::array<uint8_t, 288> ll{};
-        for (int i = 0; i <= 143; i++) ll[i] = 8;
-        for (int i = 144; i <= 255; i++) ll[i] = 9;
-        for (int i = 256; i <= 279; i++) ll[i] = 7;
-        for (int i = 280; i <= 287; i++) ll[i] = 8;
-        BuildCanonicalCodes(ll.data(), ll.size(), g_fixedLitLenCodes);
-
-        std::array<uint8_t, 32> dd{};
-        dd.fill(5);
-        BuildCanonicalCodes(dd.data(), dd.size(), g_fixedDistCodes);
-    });
-}
-
-struct DeflateToken {
-    bool isMatch = false;
-    uint16_t literal = 0;
-    uint16_t length = 0;
-    uint16_t distance = 0;
-};
-
-static std::vector<DeflateToken> BuildLz77Tokens(const std::vector<uint8_t>& data) {
-    std::vector<DeflateToken> tokens;
-    tokens.reserve(data.size());
-
-    const size_t n = data.size();
-    size_t i = 0;
-    while (i < n) {
-        size_t bestLen = 0;
-        size_t bestDist = 0;
-
-        if (i + 3 <= n) {
-            const size_t windowStart = (i > 32768) ? (i - 32768) : 0;
-            size_t attempts = 0;
-
-            for (size_t j = i; j > windowStart && attempts < 2048;) {
-                --j;
-                if (data[j] != data[i]) continue;
-
-                const size_t maxLen = std::min<size_t>(258, n - i);
-                size_t len = 1;
-                while (len < maxLen && data[j + len] == data[i + len]) len++;
-
-                if (len >= 3 && len > bestLen) {
-                    bestLen = len;
-                    bestDist = i - j;
-                    if (len == 258) break;
-                }
-                attempts++;
-            }
-        }
-
-        if (bestLen >= 3) {
-            DeflateToken t;
-            t.isMatch = true;
-            t.length = static_cast<uint16_t>(bestLen);
-            t.distance = static_cast<uint16_t>(bestDist);
-            tokens.push_back(t);
-            i += bestLen;
-        } else {
-            DeflateToken t;
-            t.isMatch = false;
-            t.literal = data[i];
-            tokens.push_back(t);
-            i++;
-        }
-    }
-
-    return tokens;
-}
-
-static bool EncodeLength(uint16_t length, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
-                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
-    static const int kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
-
-    if (length < 3 || length > 258) return false;
-
-    for (int i = 0; i < 29; i++) {
-        int base = kLenBase[i];
-        int extra = kLenExtra[i];
-        int maxLen = base + ((1 << extra) - 1);
-        if (length >= base && length <= maxLen) {
-            outCode = 257 + i;
-            outExtraBits = extra;
-            outExtraValue = length - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool EncodeDistance(uint16_t distance, int& outCode, int& outExtraBits, int& outExtraValue) {
-    static const int kDistBase[30] = { 1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
-                                       193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
-    static const int kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
-
-    if (distance < 1 || distance > 32768) return false;
-
-    for (int i = 0; i < 30; i++) {
-        int base = kDistBase[i];
-        int extra = kDistExtra[i];
-        int maxDist = base + ((1 << extra) - 1);
-        if (distance >= base && distance <= maxDist) {
-            outCode = i;
-            outExtraBits = extra;
-            outExtraValue = distance - base;
-            return true;
-        }
-    }
-
-    return false;
-}
-
-static bool WriteFixedDeflateStream(const std::vector<uint8_t>& input, std::vector<uint8_t>& outDeflate) {
-    InitFixedCodes();
-    if (g_fixedLitLenCodes.size() < 288 || g_fixedDistCodes.size() < 30) return false;
-
-    std::vector<DeflateToken> tokens = BuildLz77Tokens(input);
-
-    BitWriter w;
-    // Final block + fixed Huffman block type
-    w.WriteBits(1, 1);
-    w.WriteBits(0b01, 2);
-
-    for (const DeflateToken& t : tokens) {
-        if (!t.isMatch) {
-            const HuffCode& hc = g_fixedLitLenCodes[t.literal];
-            w.WriteBits(hc.code, hc.bits);
-            continue;
-        }
-
-        int lenCode = 0, lenExtraBits = 0, lenExtraValue = 0;
-        int distCode = 0, distExtraBits = 0, distExtraValue = 0;
-
-        if (!EncodeLength(t.length, lenCode, lenExtraBits, lenExtraValue)) return false;
-        if (!EncodeDistance(t.distance, distCode, distExtraBits, distExtraValue)) return false;
-
-        const HuffCode& lenH = g_fixedLitLenCodes[lenCode];
-        w.WriteBits(lenH.code, lenH.bits);
-        if (lenExtraBits > 0) w.WriteBits(static_cast<uint32_t>(lenExtraValue), lenExtraBits);
-
-        const HuffCode& distH = g_fixedDistCodes[distCode];
-        w.WriteBits(distH.code, distH.bits);
-        if (distExtraBits > 0) w.WriteBits(static_cast<uint32_t>(distExtraValue), distExtraBits);
-    }
-
-    // End of block symbol
-    const HuffCode& eob = g_fixedLitLenCodes[256];
-    w.WriteBits(eob.code, eob.bits);
-    w.FlushToByteBoundary();
-
-    outDeflate = std::move(w.bytes);
-    return true;
-}
-
 bool CompressFileToGzip(const std::wstring& srcPath, const std::wstring& dstPath) {
     if (!FileExistsW(srcPath)) return false;
 
-    std::vector<uint8_t> input;
-    if (!ReadFileBytes(srcPath, input)) return false;
-
-    std::vector<uint8_t> deflate;
-    if (!WriteFixedDeflateStream(input, deflate)) return false;
+    // Open via std::filesystem::path so wide Win32 APIs are used.
+    std::ifstream in(std::filesystem::path(srcPath), std::ios::binary);
+    if (!in.is_open()) return false;
 
     std::wstring tempPath = dstPath + L".tmp";
     DeleteFileW(tempPath.c_str());
 
-    // Open via std::filesystem::path so wide Win32 APIs are used.
     std::ofstream out(std::filesystem::path(tempPath), std::ios::binary | std::ios::trunc);
     if (!out.is_open()) return false;
 
-    const uint8_t hdr[10] = {
-        0x1F, 0x8B,
-        0x08,
-        0x00,
-        0x00, 0x00, 0x00, 0x00,
-        0x00,
-        0x0B                    // OS=NTFS/Windows
-    };
-    out.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
-    if (!deflate.empty()) out.write(reinterpret_cast<const char*>(deflate.data()), static_cast<std::streamsize>(deflate.size()));
-
-    const uint32_t crc = Crc32(input.data(), input.size());
-    WriteLE32(out, crc);
-    WriteLE32(out, static_cast<uint32_t>(input.size() & 0xFFFFFFFFu));
+    const bool compressed = gzip_writer::CompressStream(
+        [&in](uint8_t* dst, size_t capacity, size_t& outRead) {
+            in.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(capacity));
+            outRead = static_cast<size_t>(in.gcount());
+            return !in.bad();
+        },
+        [&out](const uint8_t* data, size_t size) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            return out.good();
+        });
+    in.close();
 
     out.flush();
-    bool good = out.good();
+    bool good = compressed && out.good();
     out.close();
     if (!good) {
         DeleteFileW(tempPath.c_str());
@@ -1051,28 +789,23 @@ std::string BuildLogSessionHeader(const LogSession& session) {
     return stream.str();
 }
 
-// Uses a lock-free ring buffer for zero-contention log submission.
-// A background thread writes to disk every 500ms.
-
-struct LogEntry {
-    std::atomic<bool> ready{ false };
-    std::string formattedMessage;
-};
-
-// Lock-free ring buffer for log entries
-static constexpr size_t LOG_BUFFER_SIZE = 8192;
-static LogEntry g_logBuffer[LOG_BUFFER_SIZE];
-static std::atomic<size_t> g_logClaimIndex{ 0 };
-static std::atomic<size_t> g_logReadIndex{ 0 };
 static std::mutex g_logArchiveQueueMutex;
 static std::vector<std::wstring> g_pendingLogArchives;
 
-// Background writer thread
-static std::thread g_logThread;
-static std::atomic<bool> g_logThreadRunning{ false };
+static bool WriteLogBatchToFile(const char* data, size_t size) {
+    std::lock_guard<std::mutex> lock(g_logFileMutex);
+    if (!logFile.is_open()) return false;
 
-static void LogThreadMain();
-static void WriteLogsToFile();
+    logFile.write(data, static_cast<std::streamsize>(size));
+    logFile.flush();
+    return true;
+}
+
+// Intentionally leaked: producers may still log while static destructors run.
+static log_pipeline::LogPipeline& GetLogPipeline() {
+    static log_pipeline::LogPipeline* pipeline = new log_pipeline::LogPipeline(&WriteLogBatchToFile);
+    return *pipeline;
+}
 
 static void ProcessPendingLogArchives() {
     std::vector<std::wstring> pendingArchives;
@@ -1093,132 +826,51 @@ static void ProcessPendingLogArchives() {
 void QueueArchivedLogCompression(const std::wstring& archivedLogPath) {
     if (archivedLogPath.empty()) return;
 
-    std::lock_guard<std::mutex> lock(g_logArchiveQueueMutex);
-    g_pendingLogArchives.push_back(archivedLogPath);
+    {
+        std::lock_guard<std::mutex> lock(g_logArchiveQueueMutex);
+        g_pendingLogArchives.push_back(archivedLogPath);
+    }
+    GetLogPipeline().Wake();
 }
 
 void ProcessQueuedArchivedLogCompressions() { ProcessPendingLogArchives(); }
 
-void StartLogThread() {
-    if (g_logThreadRunning.load()) return;
-    g_logThreadRunning.store(true);
-    g_logThread = std::thread(LogThreadMain);
-}
+void StartLogThread() { GetLogPipeline().Start(&ProcessPendingLogArchives); }
 
 void StopLogThread() {
-    if (g_logThreadRunning.load()) {
-        g_logThreadRunning.store(false);
-        if (g_logThread.joinable()) { g_logThread.join(); }
-    }
+    GetLogPipeline().Stop();
 
     FlushLogs();
     ProcessQueuedArchivedLogCompressions();
 }
 
-static void LogThreadMain() {
-    while (g_logThreadRunning.load()) {
-        WriteLogsToFile();
-        ProcessPendingLogArchives();
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    }
-
-    ProcessPendingLogArchives();
-}
+void FlushLogs() { GetLogPipeline().Flush(); }
 
-// Internal: Write all pending log entries to file (called by background thread or FlushLogs)
-static void WriteLogsToFile() {
-    size_t readPos = g_logReadIndex.load(std::memory_order_relaxed);
-    size_t claimPos = g_logClaimIndex.load(std::memory_order_acquire);
-
-    if (readPos == claimPos) return;
-
-    // Lock only during actual file I/O (not during Log() calls)
-    std::lock_guard<std::mutex> lock(g_logFileMutex);
-    if (!logFile.is_open()) return;
-
-    while (readPos != claimPos) {
-        LogEntry& entry = g_logBuffer[readPos % LOG_BUFFER_SIZE];
-
-        // Use relaxed load in tight loop, acquire synchronizes with writer's release
-        if (!entry.ready.load(std::memory_order_acquire)) {
-            break;
-        }
+std::atomic<uint32_t> g_logCategoryMask{ kAlwaysEnabledLogCategories };
 
-        logFile << entry.formattedMessage << std::endl;
-
-        entry.ready.store(false, std::memory_order_relaxed);
-
-        readPos = (readPos + 1) % LOG_BUFFER_SIZE;
-    }
-
-    logFile.flush();
-    g_logReadIndex.store(readPos, std::memory_order_release);
-}
-
-void FlushLogs() { WriteLogsToFile(); }
-
-void LogCategory(const char* category, const std::string& message) {
-    bool enabled = false;
-    if (strcmp(category, "mode_switch") == 0)
-        enabled = g_config.debug.logModeSwitch;
-    else if (strcmp(category, "animation") == 0)
-        enabled = g_config.debug.logAnimation;
-    else if (strcmp(category, "hotkey") == 0)
-        enabled = g_config.debug.logHotkey;
-    else if (strcmp(category, "obs") == 0)
-        enabled = g_config.debug.logObs;
-    else if (strcmp(category, "window_overlay") == 0)
-        enabled = g_config.debug.logWindowOverlay;
-    else if (strcmp(category, "browser_overlay") == 0)
-        enabled = g_config.debug.logBrowserOverlay;
-    else if (strcmp(category, "ninjabrain") == 0)
-        enabled = g_config.debug.logNinjabrain;
-    else if (strcmp(category, "file_monitor") == 0)
-        enabled = g_config.debug.logFileMonitor;
-    else if (strcmp(category, "image_monitor") == 0)
-        enabled = g_config.debug.logImageMonitor;
-    else if (strcmp(category, "performance") == 0)
-        enabled = g_config.debug.logPerformance;
-    else if (strcmp(category, "texture_ops") == 0)
-        enabled = g_config.debug.logTextureOps;
-    else if (strcmp(category, "gui") == 0)
-        enabled = g_config.debug.logGui;
-    else if (strcmp(category, "init") == 0)
-        enabled = g_config.debug.logInit;
-    else if (strcmp(category, "cursor_textures") == 0)
-        enabled = g_config.debug.logCursorTextures;
-    else if (strcmp(category, "hookchain") == 0)
-        enabled = true;
-
-    if (!enabled) return;
-    Log(message);
-}
-
-// True lock-free log submission using two-phase commit:
-// 1. Atomically claim a slot with CAS on g_logClaimIndex
-void Log(const std::string& message) {
-    std::string formatted = "[" + GetTimestamp() + "] " + message;
-
-    // Atomically claim a slot using CAS loop
-    size_t claimPos, nextClaimPos;
-    do {
-        claimPos = g_logClaimIndex.load(std::memory_order_relaxed);
-        nextClaimPos = (claimPos + 1) % LOG_BUFFER_SIZE;
-
-        if (nextClaimPos == g_logReadIndex.load(std::memory_order_acquire)) {
-            // Buffer full - drop this message (better than blocking)
-            return;
-        }
-        // Try to atomically claim this slot by advancing claimIndex
-    } while (!g_logClaimIndex.compare_exchange_weak(claimPos, nextClaimPos, std::memory_order_acq_rel, std::memory_order_relaxed));
-
-    LogEntry& entry = g_logBuffer[claimPos % LOG_BUFFER_SIZE];
-    entry.formattedMessage = std::move(formatted);
-
-    // Mark slot as ready (release ensures data write is visible before ready flag)
-    entry.ready.store(true, std::memory_order_release);
+void PublishLogCategoryMask(const DebugGlobalConfig& debug) {
+    uint32_t mask = kAlwaysEnabledLogCategories;
+    if (debug.logModeSwitch) mask |= LogCategoryBit(LogCategoryId::ModeSwitch);
+    if (debug.logAnimation) mask |= LogCategoryBit(LogCategoryId::Animation);
+    if (debug.logHotkey) mask |= LogCategoryBit(LogCategoryId::Hotkey);
+    if (debug.logObs) mask |= LogCategoryBit(LogCategoryId::Obs);
+    if (debug.logWindowOverlay) mask |= LogCategoryBit(LogCategoryId::WindowOverlay);
+    if (debug.logBrowserOverlay) mask |= LogCategoryBit(LogCategoryId::BrowserOverlay);
+    if (debug.logNinjabrain) mask |= LogCategoryBit(LogCategoryId::Ninjabrain);
+    if (debug.logFileMonitor) mask |= LogCategoryBit(LogCategoryId::FileMonitor);
+    if (debug.logImageMonitor) mask |= LogCategoryBit(LogCategoryId::ImageMonitor);
+    if (debug.logPerformance) mask |= LogCategoryBit(LogCategoryId::Performance);
+    if (debug.logTextureOps) mask |= LogCategoryBit(LogCategoryId::TextureOps);
+    if (debug.logGui) mask |= LogCategoryBit(LogCategoryId::Gui);
+    if (debug.logInit) mask |= LogCategoryBit(LogCategoryId::Init);
+    if (debug.logCursorTextures) mask |= LogCategoryBit(LogCategoryId::CursorTextures);
+    g_logCategoryMask.store(mask, std::memory_order_relaxed);
 }
 
+// Lock-free and allocation-free for messages that fit the pipeline's slot budget; the
+// timestamp is formatted later by the log writer thread.
+void Log(const std::string& message) { GetLogPipeline().Submit(message); }
+
 void Log(const std::wstring& message) { Log(WideToUtf8(message)); }
 
 std::wstring Utf8ToWide(const std::string& utf8_string) {
@@ -1516,7 +1168,7 @@ void WriteCurrentModeToFile(const std::string& modeId) {
 bool SwitchToMode(const std::string& newModeId, const std::string& source, bool forceCut) {
     PROFILE_SCOPE_CAT("Mode Switch", "Mode Management");
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] Entry: Attempting to switch to '" + newModeId + "' from source: " + source);
 
     if (newModeId.empty()) {
         Log("ERROR: Attempted to switch to empty mode ID");
@@ -1540,11 +1192,11 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
 
     std::string currentMode;
 
-    LogCategory("mode_switch", "[MODE_SWITCH] Acquiring g_modeIdMutex...");
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] Acquiring g_modeIdMutex...");
     // Keep the mode ID publication serialized with StartModeTransition so render readers
     // never observe the new mode before the transition snapshot is ready.
     std::unique_lock<std::mutex> modeLock(g_modeIdMutex);
-    LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex acquired");
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] g_modeIdMutex acquired");
     currentMode = g_currentModeId;
 
     if (EqualsIgnoreCase(currentMode, newModeId)) {
@@ -1554,7 +1206,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
 
     std::string logMessage = "[MODE] Switching from '" + currentMode + "' to '" + newModeId + "'";
     if (!source.empty()) { logMessage += " (source: " + source + ")"; }
-    LogCategory("mode_switch", logMessage);
+    LOG_CATEGORY(ModeSwitch, logMessage);
 
     int fromWidth = 0, fromHeight = 0, fromX = 0, fromY = 0;
     int toWidth = 0, toHeight = 0, toX = 0, toY = 0;
@@ -1585,7 +1237,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
             if (origDistance > 0) {
             }
 
-            LogCategory("mode_switch",
+            LOG_CATEGORY(ModeSwitch,
                         "[MODE_SWITCH] Active transition detected - using current animated position: " + std::to_string(fromWidth) + "x" +
                             std::to_string(fromHeight) + " at " + std::to_string(fromX) + "," + std::to_string(fromY));
         }
@@ -1680,7 +1332,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
             toModeCopy.overlayTransition = OverlayTransitionType::Cut;
             toModeCopy.backgroundTransition = BackgroundTransitionType::Cut;
         }
-        LogCategory("mode_switch", "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
+        LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] Mode dimensions calculated - from: " + std::to_string(fromWidth) + "x" +
                                        std::to_string(fromHeight) + ", to: " + std::to_string(toWidth) + "x" + std::to_string(toHeight));
     }
 
@@ -1713,7 +1365,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
                 int originalDuration = toModeCopy.transitionDurationMs;
                 toModeCopy.transitionDurationMs = static_cast<int>(originalDuration * distanceRatio);
 
-                LogCategory("mode_switch",
+                LOG_CATEGORY(ModeSwitch,
                             "[MODE_SWITCH] Mid-animation reversal: scaling duration from " + std::to_string(originalDuration) + "ms to " +
                                 std::to_string(toModeCopy.transitionDurationMs) + "ms (ratio: " + std::to_string(distanceRatio) + ")");
             }
@@ -1726,7 +1378,7 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
         toModeCopy.backgroundTransition = BackgroundTransitionType::Cut;
     }
 
-    LogCategory("mode_switch",
+    LOG_CATEGORY(ModeSwitch,
                 "[MODE_SWITCH] Calling StartModeTransition with Game:" + GameTransitionTypeToString(toModeCopy.gameTransition) +
                     ", Overlay:" + OverlayTransitionTypeToString(toModeCopy.overlayTransition) +
                     ", Bg:" + BackgroundTransitionTypeToString(toModeCopy.backgroundTransition));
@@ -1734,16 +1386,17 @@ bool SwitchToMode(const std::string& newModeId, const std::string& source, bool
     // Until then, input translation should resolve from the new mode snapshot instead of the prior mode's viewport.
     InvalidateLatestGameViewportSize();
     StartModeTransition(currentMode, newModeId, fromWidth, fromHeight, fromX, fromY, toWidth, toHeight, toX, toY, toModeCopy);
-    LogCategory("mode_switch", "[MODE_SWITCH] StartModeTransition completed");
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] StartModeTransition completed");
 
     g_currentModeId = newModeId;
     int nextIndex = 1 - g_currentModeIdIndex.load(std::memory_order_relaxed);
     g_modeIdBuffers[nextIndex] = newModeId;
     g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
-    LogCategory("mode_switch", "[MODE_SWITCH] Published new active mode after transition setup: " + newModeId);
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] Published new active mode after transition setup: " + newModeId);
+    RefreshSensitivityState();
 
     modeLock.unlock();
-    LogCategory("mode_switch", "[MODE_SWITCH] g_modeIdMutex released");
+    LOG_CATEGORY(ModeSwitch, "[MODE_SWITCH] g_modeIdMutex released");
 
     // Async file write OUTSIDE the mutex - never blocks
     WriteCurrentModeToFile(newModeId);
@@ -2133,6 +1786,62 @@ GLuint CreateShaderProgram(const char* vert, const char* frag) {
     return p;
 }
 
+namespace {
+std::string ResolveVisualMediaPathUtf8(const std::string& path, const std::wstring& toolscreenPath) {
+    std::wstring image_wpath = Utf8ToWide(path);
+    if (PathIsRelativeW(image_wpath.c_str()) && !toolscreenPath.empty()) { return WideToUtf8(toolscreenPath + L"\\" + image_wpath); }
+    return WideToUtf8(image_wpath);
+}
+
+std::string VisualMediaFormatName(VisualMediaKind kind, const std::string& path) {
+    if (kind == VisualMediaKind::AnimatedGif) { return "gif"; }
+    if (kind == VisualMediaKind::VideoMpeg1) { return "mpeg1"; }
+    std::string extension = std::filesystem::path(Utf8ToWide(path)).extension().string();
+    if (!extension.empty() && extension[0] == '.') { extension.erase(0, 1); }
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    return extension.empty() ? std::string("image") : extension;
+}
+
+// Decoded size reserved against the decode pool's memory budget, from the file header only.
+size_t EstimateDecodedVisualMediaBytes(VisualMediaKind kind, const std::string& path_utf8, size_t videoCacheBudgetBytes) {
+    if (kind == VisualMediaKind::VideoMpeg1) { return videoCacheBudgetBytes; }
+    int w = 0, h = 0, c = 0;
+    size_t frameBytes = 0;
+    if (!stbi_info(path_utf8.c_str(), &w, &h, &c) || !TryComputeImageByteCount(w, h, 4, frameBytes)) { return 0; }
+    if (kind != VisualMediaKind::AnimatedGif) { return frameBytes; }
+
+    // The frame count is unknown until the whole GIF is decoded; assume about one compressed bit per pixel per frame.
+    std::error_code error;
+    const uintmax_t fileBytes = std::filesystem::file_size(std::filesystem::path(Utf8ToWide(path_utf8)), error);
+    const uintmax_t pixels = static_cast<uintmax_t>(w) * static_cast<uintmax_t>(h);
+    const uintmax_t frames = error ? 1 : (std::max)(static_cast<uintmax_t>(1), fileBytes * 8 / (std::max)(pixels, static_cast<uintmax_t>(1)));
+    return static_cast<size_t>((std::min)(static_cast<uintmax_t>(frameBytes) * frames, static_cast<uintmax_t>(kMaxDecodedImageBytes)));
+}
+
+// Images and backgrounds on screen in the current mode decode before everything else.
+int VisualMediaDecodePriority(DecodedImageData::Type type, const std::string& id) {
+    auto cfgSnap = GetConfigSnapshot();
+    if (!cfgSnap) { return 0; }
+    const std::string currentModeId = GetPublishedCurrentModeId();
+    if (type == DecodedImageData::Type::Background) { return id == currentModeId ? 1 : 0; }
+    const ModeConfig* mode = GetModeFromSnapshot(*cfgSnap, currentModeId);
+    if (!mode) { return 0; }
+    for (const auto& source : mode->sources) {
+        if (source.type == ModeSourceType::Image && source.id == id) { return 1; }
+    }
+    return 0;
+}
+
+DecodeWorkerPool& GetImageDecodePool() {
+    static DecodeWorkerPool s_pool(DecodeWorkerPoolOptions{ DecodeWorkerPool::DefaultWorkerCount() });
+    return s_pool;
+}
+}  // namespace
+
+void StopImageDecodePool() { GetImageDecodePool().Stop(); }
+
+DecodeWorkerPoolStats GetImageDecodePoolStats() { return GetImageDecodePool().GetStats(); }
+
 void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string path, const std::wstring& toolscreenPath) {
     PROFILE_SCOPE_CAT("Async Image Load", "IO Operations");
     if (path.empty()) {
@@ -2142,29 +1851,34 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
 
     const int videoCacheBudgetMiB = g_config.debug.videoCacheBudgetMiB;
     const size_t videoCacheBudgetBytes = GetConfiguredVideoCacheBudgetBytes(videoCacheBudgetMiB);
+    const VisualMediaKind requestKind = DetectVisualMediaKindFromPath(path);
+
+    DecodeRequest request;
+    request.key = std::to_string(static_cast<int>(type)) + ":" + id;
+    request.priority = VisualMediaDecodePriority(type, id);
+    request.format = VisualMediaFormatName(requestKind, path);
+    if (requestKind != VisualMediaKind::Unsupported) {
+        // stbi_info and file_size touch the disk; the pool runs the estimate on a decode thread.
+        request.estimateBytes = [requestKind, path, toolscreenPath, videoCacheBudgetBytes]() {
+            return EstimateDecodedVisualMediaBytes(requestKind, ResolveVisualMediaPathUtf8(path, toolscreenPath), videoCacheBudgetBytes);
+        };
+    }
 
-    std::thread([type, id, path, toolscreenPath, videoCacheBudgetMiB, videoCacheBudgetBytes]() {
+    request.work = [type, id, path, toolscreenPath, videoCacheBudgetMiB, videoCacheBudgetBytes](const DecodeCancelToken& token) {
         _set_se_translator(SEHTranslator);
 
         try {
-            LogCategory("image_monitor", "Started thread for loading image '" + id + "' from path '" + path + "'");
+            LOG_CATEGORY(ImageMonitor, "Started decode for image '" + id + "' from path '" + path + "'");
             try {
-                if (g_isShuttingDown.load()) { return; }
+                if (g_isShuttingDown.load() || token.IsCancelled()) { return; }
 
-                std::wstring final_path;
-                std::wstring image_wpath = Utf8ToWide(path);
-                if (PathIsRelativeW(image_wpath.c_str()) && !toolscreenPath.empty()) {
-                    final_path = toolscreenPath + L"\\" + image_wpath;
-                } else {
-                    final_path = image_wpath;
-                }
-                std::string path_utf8 = WideToUtf8(final_path);
+                std::string path_utf8 = ResolveVisualMediaPathUtf8(path, toolscreenPath);
 
                 const VisualMediaKind mediaKind = DetectVisualMediaKindFromPath(path);
                 const bool isGif = mediaKind == VisualMediaKind::AnimatedGif;
                 const bool isVideo = mediaKind == VisualMediaKind::VideoMpeg1;
                 if (mediaKind == VisualMediaKind::Unsupported) {
-                    LogCategory("image_monitor",
+                    LOG_CATEGORY(ImageMonitor,
                                 "Skipping unsupported visual media for '" + id + "' from '" + path + "'. " +
                                     DescribeSupportedVisualMediaFormats());
                     return;
@@ -2177,14 +1891,42 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                 std::vector<int> decodedFrameDelays;
 
                 if (isVideo) {
-                    CachedMpegVideoResult cachedVideo;
-                    if (videoCacheBudgetBytes == 0) {
-                        LogCategory("image_monitor",
-                                    "Skipping MPEG-1 video '" + id + "' from '" + path +
-                                        "' because debug.videoCacheBudgetMiB is set to 0 and live streaming playback is disabled.");
+                    // Clips that would not fit the cache budget (or whose length is unknown) are streamed from
+                    // disk through a small frame ring instead of being decoded up front.
+                    VideoProbeResult probe;
+                    const size_t estimatedBytes = ProbeMpegVideoFile(path_utf8, probe) ? EstimateDecodedMpegVideoBytes(probe) : 0;
+                    if (videoCacheBudgetBytes == 0 || estimatedBytes == 0 || estimatedBytes > videoCacheBudgetBytes) {
+                        auto stream = std::make_shared<MpegVideoStream>();
+                        std::string streamError;
+                        if (!stream->Open(path_utf8, MpegVideoStreamOptions{}, &streamError)) {
+                            LOG_CATEGORY(ImageMonitor, "Skipping MPEG-1 video '" + id + "' from '" + path + "': " + streamError);
+                            return;
+                        }
+                        if (g_isShuttingDown.load() || token.IsCancelled()) { return; }
+
+                        DecodedImageData decoded;
+                        decoded.type = type;
+                        decoded.id = id;
+                        decoded.width = stream->GetWidth();
+                        decoded.height = stream->GetHeight();
+                        decoded.frameHeight = stream->GetHeight();
+                        decoded.channels = 4;
+                        decoded.frameCount = 1;
+                        decoded.isVideo = true;
+                        decoded.videoStream = stream;
+
+                        std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
+                        // Checked under the queue lock so a superseded decode can never publish after the newer one.
+                        if (token.IsCancelled()) { return; }
+                        g_decodedImagesQueue.push_back(std::move(decoded));
+                        Log("Streaming MPEG-1 video '" + id + "' from disk, frame size: " + std::to_string(stream->GetWidth()) + "x" +
+                            std::to_string(stream->GetHeight()) + ", ring=" + FormatByteCount(stream->GetRingBytes()) +
+                            ", estimated full decode=" + (estimatedBytes > 0 ? FormatByteCount(estimatedBytes) : std::string("unknown")) +
+                            ".");
                         return;
                     }
 
+                    CachedMpegVideoResult cachedVideo;
                     if (DecodeCachedMpegVideoFile(path_utf8, videoCacheBudgetBytes, cachedVideo)) {
                         w = cachedVideo.width;
                         h = cachedVideo.height;
@@ -2200,7 +1942,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                             }
                         }
                     } else {
-                        LogCategory("image_monitor",
+                        LOG_CATEGORY(ImageMonitor,
                                     "Skipping MPEG-1 video '" + id + "' from '" + path + "' because it could not be cached within the configured budget of " +
                                         std::to_string(videoCacheBudgetMiB) + " MiB: " + cachedVideo.error);
                         return;
@@ -2216,15 +1958,15 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                         fseek(f, 0, SEEK_SET);
 
                         if (fileSize <= 0) {
-                            LogCategory("image_monitor", "Skipping GIF load for '" + id + "' from '" + path + "' due to invalid file size " +
+                            LOG_CATEGORY(ImageMonitor, "Skipping GIF load for '" + id + "' from '" + path + "' due to invalid file size " +
                                                            std::to_string(fileSize) + ".");
                         } else if (static_cast<unsigned long long>(fileSize) > kMaxGifLoadBytes) {
-                            LogCategory("image_monitor",
+                            LOG_CATEGORY(ImageMonitor,
                                         "Skipping GIF load for '" + id + "' from '" + path + "' because file size " +
                                             FormatByteCount(static_cast<size_t>(fileSize)) + " exceeds guard limit of " +
                                             FormatByteCount(kMaxGifLoadBytes) + ".");
                         } else if (fileSize > (std::numeric_limits<int>::max)()) {
-                            LogCategory("image_monitor",
+                            LOG_CATEGORY(ImageMonitor,
                                         "Skipping GIF load for '" + id + "' from '" + path + "' because file size " +
                                             FormatByteCount(static_cast<size_t>(fileSize)) + " exceeds stb_image int input range.");
                         } else {
@@ -2242,7 +1984,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                                     delays = nullptr;
                                 }
                             } else {
-                                LogCategory("image_monitor",
+                                LOG_CATEGORY(ImageMonitor,
                                             "Failed to read full GIF file for '" + id + "' from '" + path + "'. Expected " +
                                                 std::to_string(fileSize) + " bytes, read " + std::to_string(bytesRead) + ".");
                             }
@@ -2259,7 +2001,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                     data = stbi_load(path_utf8.c_str(), &w, &h, &c, 4);
                 }
 
-                if (g_isShuttingDown.load()) {
+                if (g_isShuttingDown.load() || token.IsCancelled()) {
                     if (data) stbi_image_free(data);
                     if (delays) stbi_image_free(delays);
                     return;
@@ -2270,7 +2012,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                     if (frameCount > 1) {
                         long long totalHeight = static_cast<long long>(h) * static_cast<long long>(frameCount);
                         if (frameCount <= 0 || totalHeight <= 0 || totalHeight > (std::numeric_limits<int>::max)()) {
-                            LogCategory("image_monitor",
+                            LOG_CATEGORY(ImageMonitor,
                                         "Skipping decoded animated image '" + id + "' from '" + path +
                                             "' because frame dimensions are invalid: frameCount=" + std::to_string(frameCount) +
                                             ", frameHeight=" + std::to_string(h) + ".");
@@ -2283,7 +2025,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
 
                     size_t decodedBytes = 0;
                     if (!TryComputeImageByteCount(w, decodedHeight, 4, decodedBytes)) {
-                        LogCategory("image_monitor",
+                        LOG_CATEGORY(ImageMonitor,
                                     "Skipping decoded image '" + id + "' from '" + path +
                                         "' because dimensions overflow byte-count calculation: " + std::to_string(w) + "x" +
                                         std::to_string(decodedHeight) + "x4.");
@@ -2292,7 +2034,7 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                         return;
                     }
                     if (!isVideo && decodedBytes > kMaxDecodedImageBytes) {
-                        LogCategory("image_monitor",
+                        LOG_CATEGORY(ImageMonitor,
                                     "Skipping decoded image '" + id + "' from '" + path + "' because estimated pixel storage " +
                                         FormatByteCount(decodedBytes) + " exceeds guard limit of " +
                                         FormatByteCount(kMaxDecodedImageBytes) + ".");
@@ -2339,8 +2081,13 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
                     if (delays) stbi_image_free(delays);
 
                     std::lock_guard<std::mutex> lock(g_decodedImagesMutex);
+                    if (token.IsCancelled()) {
+                        LOG_CATEGORY(ImageMonitor, "Dropping decoded image '" + id + "' because a newer load superseded it.");
+                        stbi_image_free(data);
+                        return;
+                    }
                     g_decodedImagesQueue.push_back(decoded);
-                    LogCategory("image_monitor", "Successfully decoded visual media for '" + id + "' from '" + path +
+                    LOG_CATEGORY(ImageMonitor, "Successfully decoded visual media for '" + id + "' from '" + path +
                                                    "' on background thread: " + std::to_string(decoded.width) + "x" +
                                                    std::to_string(decoded.height) + ", frameCount=" +
                                                    std::to_string(decoded.frameCount) + ", queueSize=" +
@@ -2365,8 +2112,10 @@ void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string pat
         } catch (const std::exception& e) { LogException("ImageLoadThread for '" + id + "'", e); } catch (...) {
             Log("EXCEPTION in ImageLoadThread for '" + id + "': Unknown exception");
         }
-        LogCategory("image_monitor", "Image load thread for '" + id + "' has completed.");
-    }).detach();
+        LOG_CATEGORY(ImageMonitor, "Image decode for '" + id + "' has completed.");
+    };
+
+    GetImageDecodePool().Submit(std::move(request));
 }
 
 void LoadAllImages() {
@@ -2405,33 +2154,15 @@ void LoadAllImages() {
 }
 
 namespace {
-long long NowEpochMillis() {
-    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-}
-
-bool ReadAliveFileBytes(const std::wstring& alivePath, unsigned char (&bytes)[16]) {
-    HANDLE file = CreateFileW(alivePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
-                              FILE_ATTRIBUTE_NORMAL, NULL);
-    if (file == INVALID_HANDLE_VALUE) { return false; }
-    DWORD bytesRead = 0;
-    const bool readWholeFile = ReadFile(file, bytes, sizeof(bytes), &bytesRead, NULL) && bytesRead == sizeof(bytes);
-    CloseHandle(file);
-    return readWholeFile;
-}
-
-bool IsHermesAlive(const std::wstring& alivePath) {
-    if (alivePath.empty()) { return false; }
-    unsigned char bytes[16] = {};
-    if (!ReadAliveFileBytes(alivePath, bytes)) { return false; }
-    return game_state_source::EvaluateHermesAlive(bytes, static_cast<uint64_t>(GetCurrentProcessId()), NowEpochMillis());
-}
+// Owned by FileMonitorThread; published so shutdown can wake it out of its wait.
+std::mutex s_fileMonitorMutex;
+game_state_source::GameStateMonitor* s_fileMonitor = nullptr;
+}  // namespace
 
-bool StateOutputFileAvailable(const std::wstring& path) {
-    if (path.empty()) { return false; }
-    const DWORD attrs = GetFileAttributesW(path.c_str());
-    return attrs != INVALID_FILE_ATTRIBUTES && !(attrs & FILE_ATTRIBUTE_DIRECTORY);
+void WakeFileMonitorThread() {
+    std::lock_guard<std::mutex> lock(s_fileMonitorMutex);
+    if (s_fileMonitor) { s_fileMonitor->Wake(); }
 }
-}  // namespace
 
 DWORD WINAPI FileMonitorThread(LPVOID lpParam) {
     _set_se_translator(SEHTranslator);
@@ -2441,92 +2172,44 @@ DWORD WINAPI FileMonitorThread(LPVOID lpParam) {
         g_isStateOutputAvailable.store(false, std::memory_order_release);
         g_activeGameStateSource.store(GameStateSourceKind::None, std::memory_order_release);
 
-        auto steadyNowMs = []() {
-            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
-        };
-
-        std::vector<char> buffer;
-        buffer.reserve(512);
-
-        HANDLE hFile = INVALID_HANDLE_VALUE;
-        GameStateSourceKind openSource = GameStateSourceKind::None;
-        FILETIME lastWriteTime{};
-        bool haveLastWriteTime = false;
-
-        constexpr DWORD kFileMonitorSleepMs = 8;
-        constexpr DWORD kMaxStateFileSize = 65536;
-        constexpr long long kSourceCheckIntervalMs = 1000;
-        long long lastSourceCheckMs = steadyNowMs() - kSourceCheckIntervalMs;
-        GameStateSourceKind activeSource = GameStateSourceKind::None;
-
-        auto closeActiveFile = [&]() {
-            if (hFile != INVALID_HANDLE_VALUE) {
-                CloseHandle(hFile);
-                hFile = INVALID_HANDLE_VALUE;
-            }
-            openSource = GameStateSourceKind::None;
-            haveLastWriteTime = false;
-        };
+        game_state_source::GameStateMonitorOptions options;
+        options.processId = static_cast<uint64_t>(GetCurrentProcessId());
+        game_state_source::GameStateMonitor monitor({ g_stateFilePath, g_hermesAliveFilePath, g_stateOutputFilePath }, options);
+        {
+            std::lock_guard<std::mutex> lock(s_fileMonitorMutex);
+            s_fileMonitor = &monitor;
+        }
 
+        // The monitor blocks on directory change notifications between updates; the timeout only bounds how long a
+        // missed stop request could keep the thread alive.
+        constexpr std::chrono::milliseconds kMaxWait(1000);
+        bool loggedWatchMode = false;
         while (!g_stopMonitoring) {
-            Sleep(kFileMonitorSleepMs);
-
-            const long long nowMs = steadyNowMs();
-            if (nowMs - lastSourceCheckMs >= kSourceCheckIntervalMs) {
-                lastSourceCheckMs = nowMs;
-                const bool hermesAlive = IsHermesAlive(g_hermesAliveFilePath);
-                const bool stateOutputAvailable = StateOutputFileAvailable(g_stateOutputFilePath);
-                activeSource = game_state_source::Select(hermesAlive, stateOutputAvailable);
-                g_activeGameStateSource.store(activeSource, std::memory_order_release);
-                g_isStateOutputAvailable.store(activeSource != GameStateSourceKind::None, std::memory_order_release);
-            }
+            std::optional<std::string> state = monitor.WaitAndUpdate(kMaxWait);
 
-            if (activeSource == GameStateSourceKind::None) {
-                closeActiveFile();
-                continue;
-            }
+            const GameStateSourceKind activeSource = monitor.ActiveSource();
+            g_activeGameStateSource.store(activeSource, std::memory_order_release);
+            g_isStateOutputAvailable.store(activeSource != GameStateSourceKind::None, std::memory_order_release);
 
-            if (activeSource != openSource) {
-                closeActiveFile();
-                const std::wstring& path = (activeSource == GameStateSourceKind::Hermes) ? g_stateFilePath : g_stateOutputFilePath;
-                hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
-                                    FILE_ATTRIBUTE_NORMAL, NULL);
-                if (hFile == INVALID_HANDLE_VALUE) { continue; }
-                openSource = activeSource;
+            if (!loggedWatchMode) {
+                loggedWatchMode = true;
+                Log(monitor.IsEventDriven() ? "[FMON] Watching game state files with change notifications."
+                                            : "[FMON] Change notifications unavailable, polling game state files.");
             }
 
-            FILETIME curWriteTime{};
-            if (GetFileTime(hFile, NULL, NULL, &curWriteTime)) {
-                if (haveLastWriteTime && CompareFileTime(&lastWriteTime, &curWriteTime) == 0) { continue; }
-            }
-
-            if (SetFilePointer(hFile, 0, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER) { continue; }
-
-            DWORD fileSize = GetFileSize(hFile, NULL);
-            if (fileSize == 0 || fileSize >= kMaxStateFileSize) { continue; }
-
-            buffer.resize(fileSize);
-            DWORD bytesRead = 0;
-            if (!ReadFile(hFile, buffer.data(), fileSize, &bytesRead, NULL) || bytesRead != fileSize) { continue; }
-
-            std::string content(buffer.data(), bytesRead);
-            std::optional<std::string> state = (openSource == GameStateSourceKind::Hermes)
-                                                   ? game_state_source::DeriveStateFromHermesJson(content)
-                                                   : game_state_source::DeriveStateFromStateOutputText(content);
             if (!state) { continue; }
-
-            lastWriteTime = curWriteTime;
-            haveLastWriteTime = true;
-
             int currentIdx = g_currentGameStateIndex.load(std::memory_order_acquire);
             if (g_gameStateBuffers[currentIdx] != *state) {
                 int nextIdx = 1 - currentIdx;
-                g_gameStateBuffers[nextIdx] = *state;
+                g_gameStateBuffers[nextIdx] = std::move(*state);
                 g_currentGameStateIndex.store(nextIdx, std::memory_order_release);
             }
         }
 
-        closeActiveFile();
+        {
+            std::lock_guard<std::mutex> lock(s_fileMonitorMutex);
+            s_fileMonitor = nullptr;
+        }
         Log("[FMON] FileMonitorThread stopped.");
         return 0;
     } catch (const SE_Exception& e) {
@@ -2541,45 +2224,113 @@ DWORD WINAPI FileMonitorThread(LPVOID lpParam) {
     }
 }
 
+namespace {
+// A visual media file watched for hot reload, keyed by what LoadImageAsync() needs to reload it.
+struct WatchedImageKey {
+    DecodedImageData::Type type;
+    std::string id;
+    std::string path;
+
+    bool operator<(const WatchedImageKey& other) const {
+        return std::tie(type, id, path) < std::tie(other.type, other.id, other.path);
+    }
+};
+
+// The same set of images LoadAllImages() loads.
+std::set<WatchedImageKey> CollectWatchedImages(const Config& config) {
+    std::set<WatchedImageKey> images;
+    for (const auto& mode : config.modes) {
+        if (mode.background.selectedMode == "image" && !mode.background.image.empty()) {
+            images.insert({ DecodedImageData::Type::Background, mode.id, mode.background.image });
+        }
+    }
+    for (const auto& img : config.images) {
+        if (!img.path.empty()) { images.insert({ DecodedImageData::Type::UserImage, img.name, img.path }); }
+    }
+    for (const auto& overlay : config.eyezoom.overlays) {
+        if (!overlay.path.empty()) { images.insert({ DecodedImageData::Type::UserImage, "ezoverlay_" + overlay.name, overlay.path }); }
+    }
+    return images;
+}
+
+std::filesystem::path ResolveWatchedImagePath(const std::string& path) {
+    std::wstring finalPath = Utf8ToWide(path);
+    if (PathIsRelativeW(finalPath.c_str())) { finalPath = g_toolscreenPath + L"\\" + finalPath; }
+    return std::filesystem::path(finalPath);
+}
+}  // namespace
+
 DWORD WINAPI ImageMonitorThread(LPVOID lpParam) {
     _set_se_translator(SEHTranslator);
 
     try {
         Log("[IMON] ImageMonitorThread started.");
-        static std::map<std::string, FILETIME> s_lastWriteTimes;
-
-        while (!g_stopImageMonitoring) {
-            Sleep(250);
-
-            // Use snapshot to avoid racing GUI edits and to allow future lock-free snapshot impls.
-            auto cfgSnap = GetConfigSnapshot();
-            if (!cfgSnap) { continue; }
 
-            const auto& imagesToCheck = cfgSnap->images;
-            if (imagesToCheck.empty()) { continue; }
+        // Editors commonly save in several steps (truncate, write, rename); wait for the file to settle.
+        constexpr std::chrono::milliseconds kReloadDebounce(200);
+        // Bounds how long a config edit or a stop request waits to be noticed; no files are touched on these wakeups.
+        constexpr std::chrono::milliseconds kMaxWait(250);
+        constexpr std::chrono::milliseconds kPollingFallbackInterval(250);
 
-            for (const auto& img : imagesToCheck) {
-                if (img.path.empty()) continue;
+        file_watch::FileWatchRegistry registry(kReloadDebounce);
+        std::map<WatchedImageKey, file_watch::FileWatchRegistry::SubscriptionId> subscriptions;
+        std::unique_ptr<file_watch::DirectoryWatcher> watcher;
+        std::vector<std::filesystem::path> watchedDirectories;
 
-                std::wstring final_path = Utf8ToWide(img.path);
-                if (PathIsRelativeW(final_path.c_str())) { final_path = g_toolscreenPath + L"\\" + final_path; }
+        constexpr ConfigSection kWatchedSections[] = { ConfigSection::Images, ConfigSection::Modes, ConfigSection::EyeZoom };
+        uint64_t seenVersions[std::size(kWatchedSections)] = {};
+        bool firstSync = true;
 
-                HANDLE hFile = CreateFileW(final_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
-                if (hFile == INVALID_HANDLE_VALUE) continue;
+        while (!g_stopImageMonitoring) {
+            bool configChanged = firstSync;
+            for (size_t i = 0; i < std::size(kWatchedSections); ++i) {
+                const uint64_t version = GetConfigSectionVersion(kWatchedSections[i]);
+                configChanged |= version != seenVersions[i];
+                seenVersions[i] = version;
+            }
 
-                FILETIME currentWriteTime;
-                if (GetFileTime(hFile, NULL, NULL, &currentWriteTime)) {
-                    auto it = s_lastWriteTimes.find(img.name);
-                    if (it == s_lastWriteTimes.end() || CompareFileTime(&it->second, &currentWriteTime) != 0) {
-                        if (it != s_lastWriteTimes.end()) {
-                            Log("[IMON] Detected change in image file, queueing for reload: " + img.path);
-                            LoadImageAsync(DecodedImageData::Type::UserImage, img.name, img.path, g_toolscreenPath);
+            if (configChanged) {
+                // Use snapshot to avoid racing GUI edits and to allow future lock-free snapshot impls.
+                auto cfgSnap = GetConfigSnapshot();
+                if (cfgSnap) {
+                    firstSync = false;
+                    const std::set<WatchedImageKey> wanted = CollectWatchedImages(*cfgSnap);
+                    for (auto it = subscriptions.begin(); it != subscriptions.end();) {
+                        if (wanted.count(it->first)) {
+                            ++it;
+                            continue;
                         }
-                        s_lastWriteTimes[img.name] = currentWriteTime;
+                        registry.Unsubscribe(it->second);
+                        it = subscriptions.erase(it);
+                    }
+                    for (const auto& key : wanted) {
+                        if (subscriptions.count(key)) { continue; }
+                        subscriptions.emplace(key, registry.Subscribe(ResolveWatchedImagePath(key.path), [key](const file_watch::FileChange&) {
+                            Log("[IMON] Detected change in image file, queueing for reload: " + key.path);
+                            LoadImageAsync(key.type, key.id, key.path, g_toolscreenPath);
+                        }));
                     }
                 }
-                CloseHandle(hFile);
             }
+
+            // Keyed on the directories that exist, as the watcher only opens those: an image directory created after
+            // startup is picked up by the next pass (at most kMaxWait later) instead of staying unwatched.
+            const std::vector<std::filesystem::path> watchedFiles = registry.WatchedFiles();
+            std::vector<std::filesystem::path> directories = file_watch::ExistingParentDirectories(watchedFiles);
+            if (!watcher || directories != watchedDirectories) {
+                watcher = file_watch::CreateDirectoryWatcher(watchedFiles, kPollingFallbackInterval);
+                watchedDirectories = std::move(directories);
+                LOG_CATEGORY(ImageMonitor, std::string("[IMON] Watching ") + std::to_string(watchedDirectories.size()) + " image directories" +
+                                               (watcher->IsEventDriven() ? " with change notifications." : " by polling."));
+            }
+
+            auto wait = kMaxWait;
+            if (auto deadline = registry.NextDebounceDeadline()) {
+                const auto untilDeadline = std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
+                wait = (std::max)(std::chrono::milliseconds(0), (std::min)(wait, untilDeadline));
+            }
+            const bool changed = watcher->WaitForChange(wait);
+            if (changed || registry.NextDebounceDeadline()) { registry.Scan(std::chrono::steady_clock::now()); }
         }
         Log("[IMON] ImageMonitorThread stopped.");
         return 0;
@@ -2596,30 +2347,7 @@ DWORD WINAPI ImageMonitorThread(LPVOID lpParam) {
 }
 
 bool MatchesConfiguredInputKeyEvent(DWORD incomingVk, DWORD incomingRawVk, DWORD configuredKey) {
-    if (configuredKey == 0) return false;
-    if (incomingVk == configuredKey) return true;
-
-    if (configuredKey == VK_CONTROL) {
-        return incomingVk == VK_LCONTROL || incomingVk == VK_RCONTROL || incomingRawVk == VK_CONTROL;
-    }
-    if (configuredKey == VK_SHIFT) {
-        return incomingVk == VK_LSHIFT || incomingVk == VK_RSHIFT || incomingRawVk == VK_SHIFT;
-    }
-    if (configuredKey == VK_MENU) {
-        return incomingVk == VK_LMENU || incomingVk == VK_RMENU || incomingRawVk == VK_MENU;
-    }
-
-    if (incomingRawVk == VK_CONTROL && incomingVk == VK_CONTROL && (configuredKey == VK_LCONTROL || configuredKey == VK_RCONTROL)) {
-        return true;
-    }
-    if (incomingRawVk == VK_SHIFT && incomingVk == VK_SHIFT && (configuredKey == VK_LSHIFT || configuredKey == VK_RSHIFT)) {
-        return true;
-    }
-    if (incomingRawVk == VK_MENU && incomingVk == VK_MENU && (configuredKey == VK_LMENU || configuredKey == VK_RMENU)) {
-        return true;
-    }
-
-    return false;
+    return MatchesInputKeyEvent(static_cast<uint32_t>(incomingVk), static_cast<uint32_t>(incomingRawVk), static_cast<uint32_t>(configuredKey));
 }
 
 bool IsConfiguredInputKeyDown(DWORD key) {
@@ -3039,78 +2767,24 @@ std::string FindHotkeyConflict(const std::vector<DWORD>& newKeys, const std::str
 }
 
 void GetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX, int& outY) {
-    std::string anchor = type;
-    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") {
-        anchor = anchor.substr(0, anchor.length() - 8);
-    } else if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
-        anchor = anchor.substr(0, anchor.length() - 6);
-    }
-
-    char firstChar = anchor.empty() ? '\0' : anchor[0];
-
-    if (firstChar == 't') {
-        outY = relY;
-        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
-    } else if (firstChar == 'c') {
-        outX = (containerW - w) / 2 + relX;
-        outY = (containerH - h) / 2 + relY;
-    } else if (firstChar == 'p') {
-        const int PIE_Y_TOP = 220, PIE_X_LEFT = 92, PIE_X_RIGHT = 36;
-        int base_x = (anchor == "pieLeft") ? containerW - PIE_X_LEFT : containerW - PIE_X_RIGHT;
-        outX = base_x + relX;
-        outY = containerH - PIE_Y_TOP + relY;
-    } else {
-        outY = containerH - h - relY;
-        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
-    }
+    const AnchorPoint pos = SolveMirrorAnchor(ParseMirrorCorner(type), relX, relY, w, h, containerW, containerH);
+    outX = pos.x;
+    outY = pos.y;
 }
 
 void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
                                int& outY) {
-    int anchor_x = 0, anchor_y = 0;
-    char firstChar = type.empty() ? '\0' : type[0];
-
-    if (firstChar == 't') {
-        anchor_x = (type == "topLeft") ? 0 : containerW - w;
-        anchor_y = 0;
-    } else if (firstChar == 'c') {
-        anchor_x = (containerW - w) / 2;
-        anchor_y = (containerH - h) / 2;
-    } else if (firstChar == 'b') {
-        anchor_x = (type == "bottomLeft") ? 0 : containerW - w;
-        anchor_y = containerH - h;
-    }
-
-    outX = anchor_x + relX;
-    outY = anchor_y + relY;
+    const AnchorPoint pos = SolveImageAnchor(ClassifyImageCorner(type), relX, relY, w, h, containerW, containerH);
+    outX = pos.x;
+    outY = pos.y;
 }
 
 void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
                                            int gameH, int fullW, int fullH, int& outX, int& outY) {
-    if (type.length() > 8 && type.substr(type.length() - 8) == "Viewport") {
-        std::string baseAnchor = type.substr(0, type.length() - 8);
-
-        int anchor_x = 0, anchor_y = 0;
-        char firstChar = baseAnchor.empty() ? '\0' : baseAnchor[0];
-
-        if (firstChar == 't') {
-            anchor_x = (baseAnchor == "topLeft") ? 0 : gameW - w;
-            anchor_y = 0;
-        } else if (firstChar == 'c') {
-            anchor_x = (gameW - w) / 2;
-            anchor_y = (gameH - h) / 2;
-        } else if (firstChar == 'b') {
-            anchor_x = (baseAnchor == "bottomLeft") ? 0 : gameW - w;
-            anchor_y = gameH - h;
-        }
-
-        outX = gameX + anchor_x + relX;
-        outY = gameY + anchor_y + relY;
-    } else {
-        std::string baseAnchor = type;
-        if (type.length() > 6 && type.substr(type.length() - 6) == "Screen") { baseAnchor = type.substr(0, type.length() - 6); }
-        GetRelativeCoordsForImage(baseAnchor, relX, relY, w, h, fullW, fullH, outX, outY);
-    }
+    const AnchorPoint pos = SolveImageAnchorOnScreen(ParseImageAnchor(type), relX, relY, w, h, AnchorFrame{ 0, 0, fullW, fullH },
+                                                     AnchorFrame{ gameX, gameY, gameW, gameH });
+    outX = pos.x;
+    outY = pos.y;
 }
 
 void CalculateFinalScreenPos(const MirrorConfig* conf, const MirrorInstance& inst, int gameW, int gameH, int finalX, int finalY, int finalW,
@@ -3123,26 +2797,10 @@ void CalculateFinalScreenPos(const MirrorConfig* conf, const MirrorInstance& ins
     int outW = static_cast<int>(inst.fbo_w * scaleX);
     int outH = static_cast<int>(inst.fbo_h * scaleY);
 
-    std::string anchor = conf->output.relativeTo;
-    int offsetX = conf->output.x;
-    int offsetY = conf->output.y;
-
-    if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
-        anchor = anchor.substr(0, anchor.length() - 6);
-        int relative_x, relative_y;
-        GetRelativeCoords(anchor, offsetX, offsetY, outW, outH, fullW, fullH, relative_x, relative_y);
-        outScreenX = relative_x;
-        outScreenY = relative_y;
-        return;
-    }
-
-    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") { anchor = anchor.substr(0, anchor.length() - 8); }
-
-    int relative_x = 0;
-    int relative_y = 0;
-    GetRelativeCoords(anchor, offsetX, offsetY, outW, outH, finalW, finalH, relative_x, relative_y);
-    outScreenX = finalX + relative_x;
-    outScreenY = finalY + relative_y;
+    const AnchorPoint pos = SolveMirrorAnchorOnScreen(ParseMirrorAnchor(conf->output.relativeTo), conf->output.x, conf->output.y, outW,
+                                                      outH, AnchorFrame{ 0, 0, fullW, fullH }, AnchorFrame{ finalX, finalY, finalW, finalH });
+    outScreenX = pos.x;
+    outScreenY = pos.y;
 }
 
 void ScreenDeltaToMirrorConfigDelta(const std::string& relativeTo,
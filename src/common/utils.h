@@ -17,6 +17,9 @@
 #include <vector>
 #include <windows.h>
 
+#include "common/anchor_layout.h"
+#include "common/decode_worker_pool.h"
+#include "common/log_category.h"
 #include "gui/gui.h"
 #include "features/game_state_source.h"
 
@@ -280,6 +283,8 @@ struct UserImageInstance {
     uint64_t totalAnimationDurationMs = 0;
     size_t currentFrame = 0;
     std::chrono::steady_clock::time_point lastFrameTime;
+    std::shared_ptr<MpegVideoStream> videoStream;
+    uint64_t uploadedVideoSequence = UINT64_MAX;
 
     struct CachedImageRenderState {
         int crop_left = -1;
@@ -341,7 +346,9 @@ void FlushLogs();
 void QueueArchivedLogCompression(const std::wstring& archivedLogPath);
 void ProcessQueuedArchivedLogCompressions();
 
-void LogCategory(const char* category, const std::string& message);
+// Recomputes g_logCategoryMask (see common/log_category.h); called whenever a config
+// snapshot is published.
+void PublishLogCategoryMask(const DebugGlobalConfig& debug);
 
 std::wstring Utf8ToWide(const std::string& utf8_string);
 std::string WideToUtf8(const std::wstring& wstr);
@@ -438,6 +445,9 @@ GLuint CreateShaderProgram(const char* vert, const char* frag);
 
 void LoadImageAsync(DecodedImageData::Type type, std::string id, std::string path, const std::wstring& toolscreenPath);
 void LoadAllImages();
+// LoadImageAsync() decodes on a shared, fixed-size worker pool. Stopped once during shutdown.
+void StopImageDecodePool();
+DecodeWorkerPoolStats GetImageDecodePoolStats();
 
 bool MatchesConfiguredInputKeyEvent(DWORD incomingVk, DWORD incomingRawVk, DWORD configuredKey);
 bool IsConfiguredInputKeyDown(DWORD key);
@@ -456,10 +466,7 @@ void GetRelativeCoordsForImage(const std::string& type, int relX, int relY, int
 void GetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY, int gameW,
                                            int gameH, int fullW, int fullH, int& outX, int& outY);
 
-inline bool IsViewportRelativeAnchor(const std::string& relativeTo) {
-    if (relativeTo.length() > 8 && relativeTo.substr(relativeTo.length() - 8) == "Viewport") { return true; }
-    return false;
-}
+inline bool IsViewportRelativeAnchor(const std::string& relativeTo) { return IsViewportAnchorText(relativeTo); }
 void CalculateFinalScreenPos(const MirrorConfig* conf, const MirrorInstance& inst, int gameW, int gameH, int finalX, int finalY, int finalW,
                              int finalH, int fullW, int fullH, int& outScreenX, int& outScreenY);
 
@@ -472,6 +479,8 @@ void ScreenDeltaToMirrorConfigDelta(const std::string& relativeTo,
 void ScreenshotToClipboard(int width, int height);
 
 DWORD WINAPI FileMonitorThread(LPVOID lpParam);
+// Interrupts FileMonitorThread's wait for a file change so it notices g_stopMonitoring promptly.
+void WakeFileMonitorThread();
 DWORD WINAPI ImageMonitorThread(LPVOID lpParam);
 
 class SE_Exception : public std::exception {
@@ -260,3 +260,170 @@ bool DecodeCachedMpegVideoFile(const std::string& pathUtf8, size_t maxDecodedByt
     }
     return true;
 }
+
+size_t EstimateDecodedMpegVideoBytes(const VideoProbeResult& probe) {
+    size_t frameBytes = 0;
+    if (!probe.success || probe.durationSeconds <= 0.0 || !TryComputeDecodedFrameBytes(probe.width, probe.height, frameBytes)) {
+        return 0;
+    }
+
+    const double frames = std::ceil(probe.durationSeconds * SanitizeFrameRate(probe.frameRate)) + 1.0;
+    const double bytes = frames * static_cast<double>(frameBytes);
+    if (!std::isfinite(bytes) || bytes >= static_cast<double>((std::numeric_limits<size_t>::max)())) {
+        return (std::numeric_limits<size_t>::max)();
+    }
+    return static_cast<size_t>(bytes);
+}
+
+MpegVideoStream::~MpegVideoStream() { Close(); }
+
+bool MpegVideoStream::Open(const std::string& pathUtf8, const MpegVideoStreamOptions& options, std::string* errorOut) {
+    Close();
+
+    plm_t* decoder = plm_create_with_filename(pathUtf8.c_str());
+    if (!decoder) {
+        return WriteError(errorOut, "Could not open MPEG-1 video file.");
+    }
+
+    plm_set_audio_enabled(decoder, 0);
+    plm_set_video_enabled(decoder, 1);
+    plm_set_loop(decoder, 0);
+
+    const int width = plm_get_width(decoder);
+    const int height = plm_get_height(decoder);
+    size_t frameBytes = 0;
+    if (width <= 0 || height <= 0 || !TryComputeDecodedFrameBytes(width, height, frameBytes)) {
+        plm_destroy(decoder);
+        return WriteError(errorOut, "Invalid MPEG-1 video dimensions.");
+    }
+
+    m_decoder = decoder;
+    m_width = width;
+    m_height = height;
+    m_frameRate = SanitizeFrameRate(plm_get_framerate(decoder));
+    m_frameBytes = frameBytes;
+    // One slot is always held by the consumer, so at least two are needed to decode ahead.
+    m_slots.resize(static_cast<size_t>((std::max)(2, options.ringFrames)));
+    for (Slot& slot : m_slots) {
+        slot.rgba.resize(frameBytes);
+    }
+
+    m_decodedFrames = 0;
+    m_currentFrame = 0;
+    m_clipFrameCount = 0;
+    m_stopRequested = false;
+    m_failed = false;
+    m_thread = std::thread(&MpegVideoStream::DecodeThreadMain, this);
+    return true;
+}
+
+void MpegVideoStream::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_spaceCv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    if (m_decoder) {
+        plm_destroy(m_decoder);
+        m_decoder = nullptr;
+    }
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+}
+
+int MpegVideoStream::GetClipFrameCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_clipFrameCount;
+}
+
+bool MpegVideoStream::HasFailed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+bool MpegVideoStream::AcquireFrame(double playheadMs, MpegVideoStreamFrame& outFrame) {
+    const double frameDurationMs = 1000.0 / m_frameRate;
+    const std::uint64_t targetFrame =
+        playheadMs > 0.0 && std::isfinite(playheadMs) ? static_cast<std::uint64_t>(playheadMs / frameDurationMs) : 0;
+
+    bool releasedFrames = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_slots.empty() || m_decodedFrames == 0) {
+            return false;
+        }
+
+        // Keep the current frame until a newer one that is due has been decoded.
+        while (m_currentFrame + 1 < m_decodedFrames && m_currentFrame < targetFrame) {
+            m_currentFrame++;
+            releasedFrames = true;
+        }
+
+        const Slot& slot = m_slots[m_currentFrame % m_slots.size()];
+        outFrame.rgba = slot.rgba.data();
+        outFrame.sequence = m_currentFrame;
+        outFrame.clipFrameIndex = slot.clipFrameIndex;
+        outFrame.loopIndex = slot.loopIndex;
+    }
+
+    if (releasedFrames) {
+        m_spaceCv.notify_one();
+    }
+    return true;
+}
+
+void MpegVideoStream::DecodeThreadMain() {
+    std::vector<std::uint8_t> scratchRow;
+    std::uint64_t nextFrame = 0;
+    int clipFrameIndex = 0;
+    int loopIndex = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_spaceCv.wait(lock, [&]() { return m_stopRequested || nextFrame < m_currentFrame + m_slots.size(); });
+            if (m_stopRequested) {
+                return;
+            }
+        }
+
+        // The slot for nextFrame is not visible to the consumer until m_decodedFrames moves
+        // past it, so it is written without holding the lock.
+        plm_frame_t* frame = plm_decode_video(m_decoder);
+        if (!frame) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (clipFrameIndex == 0) {
+                    m_failed = true;
+                    return;
+                }
+                if (m_clipFrameCount == 0) {
+                    m_clipFrameCount = clipFrameIndex;
+                }
+            }
+            plm_rewind(m_decoder);
+            clipFrameIndex = 0;
+            loopIndex++;
+            continue;
+        }
+
+        Slot& slot = m_slots[nextFrame % m_slots.size()];
+        if (!ConvertFrameToRgbaBuffer(frame, m_width, m_height, slot.rgba.data(), scratchRow)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failed = true;
+            return;
+        }
+        slot.clipFrameIndex = clipFrameIndex;
+        slot.loopIndex = loopIndex;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decodedFrames = ++nextFrame;
+        }
+        clipFrameIndex++;
+    }
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+struct plm_t;
+
 enum class VisualMediaKind {
     Unsupported,
     StaticImage,
@@ -38,4 +43,71 @@ bool IsSupportedVisualMediaPath(const std::string& path);
 const char* DescribeSupportedVisualMediaFormats();
 
 bool ProbeMpegVideoFile(const std::string& pathUtf8, VideoProbeResult& outResult);
-bool DecodeCachedMpegVideoFile(const std::string& pathUtf8, size_t maxDecodedBytes, CachedMpegVideoResult& outResult);
\ No newline at end of file
+bool DecodeCachedMpegVideoFile(const std::string& pathUtf8, size_t maxDecodedBytes, CachedMpegVideoResult& outResult);
+// Decoded size of the whole clip at its probed duration; 0 when the duration is unknown.
+size_t EstimateDecodedMpegVideoBytes(const VideoProbeResult& probe);
+
+struct MpegVideoStreamOptions {
+    int ringFrames = 8;
+};
+
+struct MpegVideoStreamFrame {
+    const std::uint8_t* rgba = nullptr; // bottom-up rows; valid until the next AcquireFrame or Close
+    std::uint64_t sequence = 0;         // frames since playback started, counting across loops
+    int clipFrameIndex = 0;
+    int loopIndex = 0;
+};
+
+// Plays an MPEG-1 file from disk without decoding it into memory up front. A decoder thread
+// keeps at most ringFrames RGBA frames ahead of the playhead and rewinds at the end of the
+// clip, so memory stays bounded by the ring size regardless of clip length.
+class MpegVideoStream {
+public:
+    MpegVideoStream() = default;
+    ~MpegVideoStream();
+
+    MpegVideoStream(const MpegVideoStream&) = delete;
+    MpegVideoStream& operator=(const MpegVideoStream&) = delete;
+
+    bool Open(const std::string& pathUtf8, const MpegVideoStreamOptions& options, std::string* errorOut = nullptr);
+    void Close();
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    double GetFrameRate() const { return m_frameRate; }
+    size_t GetFrameBytes() const { return m_frameBytes; }
+    size_t GetRingBytes() const { return m_frameBytes * m_slots.size(); }
+    // Number of frames in one pass of the clip; 0 until the decoder first reaches the end.
+    int GetClipFrameCount() const;
+    bool HasFailed() const;
+
+    // Returns the newest decoded frame at or before playheadMs (measured from the start of
+    // playback) and hands every older frame back to the decoder. Returns false until the first
+    // frame is ready. Must only be called from one thread.
+    bool AcquireFrame(double playheadMs, MpegVideoStreamFrame& outFrame);
+
+private:
+    struct Slot {
+        std::vector<std::uint8_t> rgba;
+        int clipFrameIndex = 0;
+        int loopIndex = 0;
+    };
+
+    void DecodeThreadMain();
+
+    plm_t* m_decoder = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    double m_frameRate = 0.0;
+    size_t m_frameBytes = 0;
+    std::vector<Slot> m_slots;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_spaceCv;
+    std::uint64_t m_decodedFrames = 0; // frames published by the decoder thread
+    std::uint64_t m_currentFrame = 0;  // oldest frame still owned by the consumer
+    int m_clipFrameCount = 0;
+    bool m_stopRequested = false;
+    bool m_failed = false;
+    std::thread m_thread;
+};
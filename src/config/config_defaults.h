@@ -234,6 +234,7 @@ constexpr float CONFIG_GUI_FONT_SCALE = 1.0f;
 inline const std::string CONFIG_LANG = "en";
 constexpr int CONFIG_FPS_LIMIT = 0;
 constexpr int CONFIG_FPS_LIMIT_SLEEP_THRESHOLD = 1000;
+constexpr bool CONFIG_FPS_LIMIT_ALIGN_TO_OBS_CAPTURE = false;
 constexpr bool CONFIG_ALLOW_CURSOR_ESCAPE = false;
 constexpr bool CONFIG_DISABLE_HOOK_CHAINING = false;
 constexpr float CONFIG_MOUSE_SENSITIVITY = 1.0f;
@@ -0,0 +1,106 @@
+#include "config_diff.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <tuple>
+
+namespace {
+
+std::array<std::atomic<std::uint64_t>, kConfigSectionCount> s_configSectionVersions{};
+
+// Config fields outside the named sections. Keep in sync with Config: a field missing here is invisible to
+// ConfigSection::General consumers (config-diff-general-fields covers every field listed in the struct today).
+auto GeneralFields(const Config& config) {
+    return std::tie(config.configVersion, config.defaultMode, config.guiHotkey, config.borderlessHotkey, config.autoBorderless,
+                    config.imageOverlaysHotkey, config.windowOverlaysHotkey, config.ninjabrainOverlayHotkey, config.fontPath, config.lang,
+                    config.fpsLimit, config.fpsLimitSleepThreshold, config.fpsLimitAlignToObsCapture, config.mirrorGammaMode,
+                    config.disableHookChaining, config.allowCursorEscape, config.confineCursor, config.mouseSensitivity,
+                    config.windowsMouseSpeed, config.hideAnimationsInGame, config.captureFakeCursor, config.limitCaptureFramerate,
+                    config.obsFramerate, config.useSystemKeyRepeat, config.keyRepeatStartDelay, config.keyRepeatDelay,
+                    config.basicModeEnabled, config.restoreWindowedModeOnFullscreenExit, config.disableFullscreenPrompt,
+                    config.disableConfigurePrompt, config.startupIndicatorMode, config.startupIndicatorImagePath);
+}
+
+} // namespace
+
+bool ConfigElementChanges::Touches(std::string_view key) const {
+    auto contains = [key](const std::vector<std::string>& keys) { return std::find(keys.begin(), keys.end(), key) != keys.end(); };
+    return contains(modified) || contains(added) || contains(removed);
+}
+
+ConfigSectionMask DiffConfigSections(const Config& before, const Config& after) {
+    ConfigSectionMask changed = 0;
+    auto mark = [&changed](ConfigSection section, bool differs) {
+        if (differs) { changed |= ConfigSectionBit(section); }
+    };
+
+    mark(ConfigSection::Mirrors, before.mirrors != after.mirrors);
+    mark(ConfigSection::MirrorGroups, before.mirrorGroups != after.mirrorGroups);
+    mark(ConfigSection::Images, before.images != after.images);
+    mark(ConfigSection::WindowOverlays, before.windowOverlays != after.windowOverlays);
+    mark(ConfigSection::BrowserOverlays, before.browserOverlays != after.browserOverlays);
+    mark(ConfigSection::Modes, before.modes != after.modes);
+    mark(ConfigSection::Hotkeys, before.hotkeys != after.hotkeys);
+    mark(ConfigSection::SensitivityHotkeys, before.sensitivityHotkeys != after.sensitivityHotkeys);
+    mark(ConfigSection::EyeZoom, !(before.eyezoom == after.eyezoom));
+    mark(ConfigSection::Cursors, !(before.cursors == after.cursors));
+    mark(ConfigSection::CursorTrail, !(before.cursorTrail == after.cursorTrail));
+    mark(ConfigSection::KeyRebinds, !(before.keyRebinds == after.keyRebinds));
+    mark(ConfigSection::Appearance, !(before.appearance == after.appearance));
+    mark(ConfigSection::NinjabrainOverlay, !(before.ninjabrainOverlay == after.ninjabrainOverlay));
+    mark(ConfigSection::Debug, !(before.debug == after.debug));
+    mark(ConfigSection::General, GeneralFields(before) != GeneralFields(after));
+    return changed;
+}
+
+ConfigDiff DiffConfigs(const Config& before, const Config& after) {
+    ConfigDiff diff;
+    diff.changed = DiffConfigSections(before, after);
+
+    auto byName = [](const auto& element) -> const std::string& { return element.name; };
+    auto elementsOf = [&diff](ConfigSection section) -> ConfigElementChanges& { return diff.elements[static_cast<size_t>(section)]; };
+
+    if (diff.Changed(ConfigSection::Mirrors)) {
+        DiffKeyedElements(before.mirrors, after.mirrors, byName, elementsOf(ConfigSection::Mirrors));
+    }
+    if (diff.Changed(ConfigSection::MirrorGroups)) {
+        DiffKeyedElements(before.mirrorGroups, after.mirrorGroups, byName, elementsOf(ConfigSection::MirrorGroups));
+    }
+    if (diff.Changed(ConfigSection::Images)) { DiffKeyedElements(before.images, after.images, byName, elementsOf(ConfigSection::Images)); }
+    if (diff.Changed(ConfigSection::WindowOverlays)) {
+        DiffKeyedElements(before.windowOverlays, after.windowOverlays, byName, elementsOf(ConfigSection::WindowOverlays));
+    }
+    if (diff.Changed(ConfigSection::BrowserOverlays)) {
+        DiffKeyedElements(before.browserOverlays, after.browserOverlays, byName, elementsOf(ConfigSection::BrowserOverlays));
+    }
+    if (diff.Changed(ConfigSection::Modes)) {
+        DiffKeyedElements(before.modes, after.modes, [](const ModeConfig& mode) -> const std::string& { return mode.id; },
+                          elementsOf(ConfigSection::Modes));
+    }
+    if (diff.Changed(ConfigSection::Hotkeys)) { DiffIndexedElements(before.hotkeys, after.hotkeys, elementsOf(ConfigSection::Hotkeys)); }
+    if (diff.Changed(ConfigSection::SensitivityHotkeys)) {
+        DiffIndexedElements(before.sensitivityHotkeys, after.sensitivityHotkeys, elementsOf(ConfigSection::SensitivityHotkeys));
+    }
+    return diff;
+}
+
+void BumpConfigSectionVersions(ConfigSectionMask sections) {
+    for (size_t i = 0; i < kConfigSectionCount; ++i) {
+        if (sections & ConfigSectionBit(static_cast<ConfigSection>(i))) { s_configSectionVersions[i].fetch_add(1, std::memory_order_release); }
+    }
+}
+
+std::uint64_t GetConfigSectionVersion(ConfigSection section) {
+    return s_configSectionVersions[static_cast<size_t>(section)].load(std::memory_order_acquire);
+}
+
+std::uint64_t GetConfigSectionsVersion(ConfigSectionMask sections) {
+    std::uint64_t version = 0;
+    for (size_t i = 0; i < kConfigSectionCount; ++i) {
+        if (sections & ConfigSectionBit(static_cast<ConfigSection>(i))) {
+            version += s_configSectionVersions[i].load(std::memory_order_acquire);
+        }
+    }
+    return version;
+}
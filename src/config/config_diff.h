@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "gui/gui.h"
+
+// Typed change set between two published config snapshots.
+//
+// The snapshot publisher diffs every new snapshot against the one it replaces and bumps a version counter per
+// changed section. Runtime consumers poll the versions of only the sections they depend on (the logic thread's
+// mirror capture plan watches mirrors, mirror groups and modes; the browser overlay thread watches browser overlays),
+// so an edit to one section no longer makes every consumer rebuild. List sections can additionally be diffed per
+// element, keyed by name, to invalidate just the touched entries.
+
+enum class ConfigSection : std::uint8_t {
+    Mirrors,
+    MirrorGroups,
+    Images,
+    WindowOverlays,
+    BrowserOverlays,
+    Modes,
+    Hotkeys,
+    SensitivityHotkeys,
+    EyeZoom,
+    Cursors,
+    CursorTrail,
+    KeyRebinds,
+    Appearance,
+    NinjabrainOverlay,
+    Debug,
+    // Every remaining top-level scalar and hotkey field of Config.
+    General,
+    Count,
+};
+
+constexpr size_t kConfigSectionCount = static_cast<size_t>(ConfigSection::Count);
+
+using ConfigSectionMask = std::uint32_t;
+
+constexpr ConfigSectionMask ConfigSectionBit(ConfigSection section) { return ConfigSectionMask{ 1 } << static_cast<std::uint32_t>(section); }
+
+constexpr ConfigSectionMask kAllConfigSections = (ConfigSectionMask{ 1 } << kConfigSectionCount) - 1;
+
+// Element-level changes of one list section. Named lists (mirrors, mirror groups, images, overlays) are keyed by
+// name and modes by id; hotkey lists have no stable identity and are keyed by position ("0", "1", ...).
+struct ConfigElementChanges {
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    std::vector<std::string> modified;
+    // The same keys in a different order, or a list with duplicate keys that changed. Index-based caches must rebuild.
+    bool reordered = false;
+
+    bool Empty() const { return added.empty() && removed.empty() && modified.empty() && !reordered; }
+    bool StructureChanged() const { return !added.empty() || !removed.empty() || reordered; }
+    bool Touches(std::string_view key) const;
+};
+
+struct ConfigDiff {
+    ConfigSectionMask changed = 0;
+    ConfigElementChanges elements[kConfigSectionCount];
+
+    bool Empty() const { return changed == 0; }
+    bool Changed(ConfigSection section) const { return (changed & ConfigSectionBit(section)) != 0; }
+    bool ChangedAny(ConfigSectionMask sections) const { return (changed & sections) != 0; }
+    const ConfigElementChanges& Elements(ConfigSection section) const { return elements[static_cast<size_t>(section)]; }
+};
+
+// Sections whose contents differ. Cheap enough to run on every publish: it only compares, never allocates.
+ConfigSectionMask DiffConfigSections(const Config& before, const Config& after);
+
+// Full change set including per-element keys for the changed list sections.
+ConfigDiff DiffConfigs(const Config& before, const Config& after);
+
+// Per-section versions, bumped by the snapshot publisher for the sections a publish changed. A consumer remembers
+// GetConfigSectionsVersion(mask) for the sections it reads and rebuilds only when the value moves; the value is the
+// sum of monotonic counters, so any change to any section in the mask changes it.
+void BumpConfigSectionVersions(ConfigSectionMask sections);
+std::uint64_t GetConfigSectionVersion(ConfigSection section);
+std::uint64_t GetConfigSectionsVersion(ConfigSectionMask sections);
+
+// Diffs two lists whose elements are identified by key(element), which must return a reference to a string inside
+// the element. Returns true when anything changed.
+template <typename T, typename KeyFn>
+bool DiffKeyedElements(const std::vector<T>& before, const std::vector<T>& after, KeyFn key, ConfigElementChanges& out) {
+    out = ConfigElementChanges{};
+    if (before == after) { return false; }
+
+    std::unordered_map<std::string_view, size_t> beforeIndex;
+    beforeIndex.reserve(before.size());
+    bool duplicateKeys = false;
+    for (size_t i = 0; i < before.size(); ++i) { duplicateKeys |= !beforeIndex.emplace(key(before[i]), i).second; }
+
+    std::vector<bool> matched(before.size(), false);
+    size_t previousMatch = 0;
+    bool firstMatch = true;
+    for (size_t i = 0; i < after.size(); ++i) {
+        const std::string& afterKey = key(after[i]);
+        auto it = beforeIndex.find(afterKey);
+        if (it == beforeIndex.end()) {
+            out.added.push_back(afterKey);
+            continue;
+        }
+        if (matched[it->second]) {
+            duplicateKeys = true;
+            continue;
+        }
+        matched[it->second] = true;
+        if (!firstMatch && it->second < previousMatch) { out.reordered = true; }
+        previousMatch = it->second;
+        firstMatch = false;
+        if (!(before[it->second] == after[i])) { out.modified.push_back(afterKey); }
+    }
+    for (size_t i = 0; i < before.size(); ++i) {
+        if (!matched[i]) { out.removed.push_back(key(before[i])); }
+    }
+
+    // With duplicate keys the pairing above is ambiguous; report a structural change so consumers rebuild.
+    if (duplicateKeys) { out.reordered = true; }
+    return true;
+}
+
+// Diffs two lists without a stable identity, pairing elements by position.
+template <typename T>
+bool DiffIndexedElements(const std::vector<T>& before, const std::vector<T>& after, ConfigElementChanges& out) {
+    out = ConfigElementChanges{};
+    if (before == after) { return false; }
+
+    const size_t common = (std::min)(before.size(), after.size());
+    for (size_t i = 0; i < common; ++i) {
+        if (!(before[i] == after[i])) { out.modified.push_back(std::to_string(i)); }
+    }
+    for (size_t i = common; i < after.size(); ++i) { out.added.push_back(std::to_string(i)); }
+    for (size_t i = common; i < before.size(); ++i) { out.removed.push_back(std::to_string(i)); }
+    return true;
+}
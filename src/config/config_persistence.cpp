@@ -0,0 +1,347 @@
+#include "config_persistence.h"
+
+#include "config_snapshot_cache.h"
+#include "config_toml.h"
+#include "common/coalescing_worker.h"
+#include "common/profiler.h"
+#include "common/utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// Long enough to fold a slider drag or a burst of checkbox clicks into one write, short enough that a crash loses
+// at most a fraction of a second of edits.
+constexpr std::chrono::milliseconds kConfigSaveBatchWindow(250);
+
+bool IsTransientFileError(const DWORD errorCode) {
+    return errorCode == ERROR_ACCESS_DENIED ||
+           errorCode == ERROR_LOCK_VIOLATION ||
+           errorCode == ERROR_SHARING_VIOLATION;
+}
+
+template <typename Operation>
+bool RetryFileOperation(Operation&& operation) {
+    constexpr int kMaxAttempts = 60;
+    constexpr DWORD kRetryDelayMs = 5;
+
+    DWORD lastError = ERROR_SUCCESS;
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        if (operation()) {
+            return true;
+        }
+
+        lastError = GetLastError();
+        if (!IsTransientFileError(lastError) || attempt == (kMaxAttempts - 1)) {
+            SetLastError(lastError);
+            return false;
+        }
+
+        Sleep(kRetryDelayMs);
+    }
+
+    SetLastError(lastError);
+    return false;
+}
+
+bool DeletePathIfPresentWithRetries(const std::wstring& path) {
+    return RetryFileOperation([&]() {
+        if (DeleteFileW(path.c_str())) {
+            return true;
+        }
+
+        const DWORD errorCode = GetLastError();
+        if (errorCode == ERROR_FILE_NOT_FOUND || errorCode == ERROR_PATH_NOT_FOUND) {
+            SetLastError(ERROR_SUCCESS);
+            return true;
+        }
+
+        SetLastError(errorCode);
+        return false;
+    });
+}
+
+struct WrittenFile {
+    std::string contents;
+    ULONGLONG size = 0;
+    FILETIME lastWriteTime{};
+};
+
+// Serializes file writes so a synchronous save never interleaves with the worker, and guards the state below.
+std::mutex s_persistMutex;
+std::string s_serializeBuffer;
+std::string s_snapshotCacheBuffer;
+std::unordered_map<std::wstring, WrittenFile> s_writtenFiles;
+
+std::atomic<uint64_t> s_savesWritten{ 0 };
+// Sidecar-only submissions share the worker but are not saves.
+std::atomic<uint64_t> s_snapshotCacheWritesQueued{ 0 };
+std::atomic<uint64_t> s_filesWritten{ 0 };
+std::atomic<uint64_t> s_filesUnchanged{ 0 };
+std::atomic<uint64_t> s_writeFailures{ 0 };
+std::atomic<uint64_t> s_bytesWritten{ 0 };
+std::atomic<uint64_t> s_lastSaveMicros{ 0 };
+std::atomic<uint64_t> s_totalSaveMicros{ 0 };
+
+bool QueryFileStamp(const std::wstring& path, ULONGLONG& size, FILETIME& lastWriteTime) {
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) { return false; }
+    size = (static_cast<ULONGLONG>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    lastWriteTime = data.ftLastWriteTime;
+    return true;
+}
+
+void RememberWrittenFile(const std::wstring& path, std::string_view contents) {
+    WrittenFile& entry = s_writtenFiles[path];
+    if (!QueryFileStamp(path, entry.size, entry.lastWriteTime)) {
+        s_writtenFiles.erase(path);
+        return;
+    }
+    entry.contents.assign(contents.data(), contents.size());
+}
+
+// True when path already holds exactly contents. The remembered contents are trusted only while the file's size and
+// write time still match what this process left behind; otherwise (first save of the session, an edit made outside
+// Toolscreen) the file is read back and compared.
+bool FileAlreadyHolds(const std::wstring& path, std::string_view contents) {
+    ULONGLONG size = 0;
+    FILETIME lastWriteTime{};
+    if (!QueryFileStamp(path, size, lastWriteTime) || size != contents.size()) { return false; }
+
+    auto it = s_writtenFiles.find(path);
+    if (it != s_writtenFiles.end() && it->second.size == size && CompareFileTime(&it->second.lastWriteTime, &lastWriteTime) == 0) {
+        return it->second.contents == contents;
+    }
+
+    std::ifstream in(std::filesystem::path(path), std::ios::binary);
+    if (!in.is_open()) { return false; }
+    std::string onDisk(static_cast<size_t>(size), '\0');
+    if (!in.read(onDisk.data(), static_cast<std::streamsize>(onDisk.size())) || onDisk != contents) { return false; }
+
+    RememberWrittenFile(path, contents);
+    return true;
+}
+
+// Rewrites tomlPath's snapshot cache from the source just written to it. A failure only costs the next load a parse:
+// the stale sidecar no longer matches the file and is skipped.
+void RefreshConfigSnapshotCache(const std::wstring& tomlPath, const std::string& source) {
+    PROFILE_SCOPE_CAT("Config Snapshot Cache Refresh", "IO Operations");
+    if (!EncodeConfigSnapshotCacheFromSource(source, s_snapshotCacheBuffer) ||
+        !WriteFileAtomically(GetConfigSnapshotCachePath(tomlPath), s_snapshotCacheBuffer)) {
+        Log("WARNING: Failed to refresh config snapshot cache for " + WideToUtf8(tomlPath));
+    }
+}
+
+void MergeConfigSaveJob(ConfigSaveJob& pending, ConfigSaveJob&& incoming) {
+    if (!incoming.configPath.empty()) {
+        pending.configPath = std::move(incoming.configPath);
+        pending.sharedSnapshot = std::move(incoming.sharedSnapshot);
+    }
+    for (auto& [cachePath, image] : incoming.snapshotCaches) {
+        auto existing = std::find_if(pending.snapshotCaches.begin(), pending.snapshotCaches.end(),
+                                     [&cachePath](const auto& entry) { return entry.first == cachePath; });
+        if (existing != pending.snapshotCaches.end()) {
+            existing->second = std::move(image);
+        } else {
+            pending.snapshotCaches.emplace_back(cachePath, std::move(image));
+        }
+    }
+    for (auto& [name, snapshot] : incoming.profileSnapshots) {
+        auto existing = std::find_if(pending.profileSnapshots.begin(), pending.profileSnapshots.end(),
+                                     [&name](const auto& entry) { return EqualsIgnoreCase(entry.first, name); });
+        if (existing != pending.profileSnapshots.end()) {
+            existing->second = std::move(snapshot);
+        } else {
+            pending.profileSnapshots.emplace_back(name, std::move(snapshot));
+        }
+    }
+}
+
+void WriteQueuedSnapshotCaches(const ConfigSaveJob& job) {
+    std::lock_guard<std::mutex> lock(s_persistMutex);
+    for (const auto& [cachePath, image] : job.snapshotCaches) {
+        if (!WriteFileAtomically(cachePath, image)) { Log("WARNING: Failed to write config snapshot cache: " + WideToUtf8(cachePath)); }
+    }
+}
+
+bool WriteConfigSaveJob(const ConfigSaveJob& job) {
+    PROFILE_SCOPE_CAT("Config Persistence Write", "IO Operations");
+    // Sidecars queued by a load go first: a save in the same job rewrites its own sidecar afterwards.
+    WriteQueuedSnapshotCaches(job);
+    if (job.configPath.empty() && job.profileSnapshots.empty()) { return true; }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    bool ok = true;
+    if (!job.configPath.empty() && !PersistConfigFile(job.sharedSnapshot, job.configPath)) {
+        Log("ERROR: Failed to write config file.");
+        ok = false;
+    }
+    for (const auto& [name, snapshot] : job.profileSnapshots) {
+        if (!SaveProfileSnapshotIfTracked(name, snapshot)) {
+            Log("INFO: Skipped profile save for removed or renamed profile '" + name + "'.");
+        }
+    }
+
+    const uint64_t elapsedMicros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    s_lastSaveMicros.store(elapsedMicros, std::memory_order_relaxed);
+    s_totalSaveMicros.fetch_add(elapsedMicros, std::memory_order_relaxed);
+    s_savesWritten.fetch_add(1, std::memory_order_relaxed);
+    return ok;
+}
+
+void RunConfigSaveJob(ConfigSaveJob& job) {
+    _set_se_translator(SEHTranslator);
+    try {
+        WriteConfigSaveJob(job);
+    } catch (const SE_Exception& e) {
+        LogException("ConfigSaveThread (SEH)", e.getCode(), e.getInfo());
+    } catch (const std::exception& e) {
+        LogException("ConfigSaveThread", e);
+    } catch (...) {
+        Log("EXCEPTION in ConfigSaveThread: Unknown exception");
+    }
+}
+
+CoalescingWorker<ConfigSaveJob>& ConfigSaveWorker() {
+    static CoalescingWorker<ConfigSaveJob> worker(&RunConfigSaveJob, kConfigSaveBatchWindow);
+    return worker;
+}
+
+} // namespace
+
+std::wstring MakeTempSiblingPath(const std::wstring& finalPath, const wchar_t* suffix) {
+    const std::filesystem::path final(finalPath);
+    const std::wstring filename = final.filename().wstring();
+    return (final.parent_path() /
+            (filename + suffix + std::to_wstring(GetCurrentProcessId()) + L"-" + std::to_wstring(GetTickCount64())))
+        .wstring();
+}
+
+bool MovePathWithRetries(const std::wstring& fromPath, const std::wstring& toPath, const DWORD flags) {
+    return RetryFileOperation([&]() {
+        return MoveFileExW(fromPath.c_str(), toPath.c_str(), flags | MOVEFILE_WRITE_THROUGH);
+    });
+}
+
+bool ReplacePathAtomically(const std::wstring& tempPath, const std::wstring& finalPath) {
+    if (MovePathWithRetries(tempPath, finalPath, MOVEFILE_REPLACE_EXISTING)) {
+        return true;
+    }
+
+    if (!DeletePathIfPresentWithRetries(finalPath)) {
+        return false;
+    }
+
+    if (MovePathWithRetries(tempPath, finalPath, 0)) {
+        return true;
+    }
+
+    std::error_code cleanupError;
+    std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
+    return false;
+}
+
+
+bool WriteFileAtomically(const std::wstring& path, std::string_view contents) {
+    std::error_code dirError;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), dirError);
+
+    const std::wstring tempPath = MakeTempSiblingPath(path, L".tmp-");
+    HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return false; }
+
+    bool ok = true;
+    const char* data = contents.data();
+    size_t remaining = contents.size();
+    while (ok && remaining > 0) {
+        const DWORD chunk = static_cast<DWORD>((std::min)(remaining, static_cast<size_t>(1) << 30));
+        DWORD written = 0;
+        ok = WriteFile(file, data, chunk, &written, nullptr) && written > 0;
+        data += written;
+        remaining -= written;
+    }
+    // Flush before the rename: otherwise a power loss can leave the renamed file empty.
+    if (ok) { ok = FlushFileBuffers(file) != FALSE; }
+    CloseHandle(file);
+
+    if (!ok || !ReplacePathAtomically(tempPath, path)) {
+        std::error_code cleanupError;
+        std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
+        return false;
+    }
+    return true;
+}
+
+bool PersistConfigFile(const Config& config, const std::wstring& path) {
+    std::lock_guard<std::mutex> lock(s_persistMutex);
+
+    if (!SerializeConfigToTomlString(config, s_serializeBuffer)) {
+        s_writeFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (FileAlreadyHolds(path, s_serializeBuffer)) {
+        s_filesUnchanged.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (!WriteFileAtomically(path, s_serializeBuffer)) {
+        s_writeFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    RememberWrittenFile(path, s_serializeBuffer);
+    s_filesWritten.fetch_add(1, std::memory_order_relaxed);
+    s_bytesWritten.fetch_add(s_serializeBuffer.size(), std::memory_order_relaxed);
+    RefreshConfigSnapshotCache(path, s_serializeBuffer);
+    return true;
+}
+
+void QueueConfigSave(ConfigSaveJob job) { ConfigSaveWorker().Submit(std::move(job), &MergeConfigSaveJob); }
+
+void QueueConfigSnapshotCacheWrite(const std::wstring& cachePath, std::string image) {
+    ConfigSaveJob job;
+    job.snapshotCaches.emplace_back(cachePath, std::move(image));
+    s_snapshotCacheWritesQueued.fetch_add(1, std::memory_order_relaxed);
+    ConfigSaveWorker().Submit(std::move(job), &MergeConfigSaveJob);
+}
+
+bool WriteConfigSaveNow(const ConfigSaveJob& job) {
+    CoalescingWorker<ConfigSaveJob>& worker = ConfigSaveWorker();
+
+    // A queued save may carry profile snapshots this job does not, so fold this job into it rather than dropping it.
+    std::optional<ConfigSaveJob> pending = worker.TakePending();
+    if (pending) { MergeConfigSaveJob(*pending, ConfigSaveJob(job)); }
+
+    // Let a write already in progress finish first so it cannot land after (and overwrite) this one.
+    if (!worker.WaitIdle(std::chrono::milliseconds(3000))) {
+        Log("WriteConfigSaveNow: Timed out waiting for background save. Proceeding anyway.");
+    }
+    return WriteConfigSaveJob(pending ? *pending : job);
+}
+
+bool WaitForConfigPersistenceIdle(int timeoutMs) { return ConfigSaveWorker().WaitIdle(std::chrono::milliseconds(timeoutMs)); }
+
+void StopConfigPersistenceWorker() { ConfigSaveWorker().Stop(); }
+
+ConfigPersistenceStats GetConfigPersistenceStats() {
+    const CoalescingWorker<ConfigSaveJob>::Stats workerStats = ConfigSaveWorker().GetStats();
+
+    ConfigPersistenceStats stats;
+    stats.savesRequested = workerStats.submitted - s_snapshotCacheWritesQueued.load(std::memory_order_relaxed);
+    stats.savesCoalesced = workerStats.coalesced;
+    stats.savesWritten = s_savesWritten.load(std::memory_order_relaxed);
+    stats.filesWritten = s_filesWritten.load(std::memory_order_relaxed);
+    stats.filesUnchanged = s_filesUnchanged.load(std::memory_order_relaxed);
+    stats.writeFailures = s_writeFailures.load(std::memory_order_relaxed);
+    stats.bytesWritten = s_bytesWritten.load(std::memory_order_relaxed);
+    stats.lastSaveMs = static_cast<double>(s_lastSaveMicros.load(std::memory_order_relaxed)) / 1000.0;
+    stats.totalSaveMs = static_cast<double>(s_totalSaveMicros.load(std::memory_order_relaxed)) / 1000.0;
+    return stats;
+}
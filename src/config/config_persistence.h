@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Windows.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gui/gui.h"
+
+// Config persistence: one long-lived worker writes config.toml and the active profile's snapshot.
+//
+// SaveConfig() queues a save instead of spawning a thread per save. A save queued while another is still waiting
+// replaces it (the latest config wins; profile snapshots are kept per profile), and the worker waits a short batch
+// window before writing so that a burst of GUI edits becomes a single write. Every file goes through
+// PersistConfigFile(): serialized into a reused buffer, skipped when the file already holds those exact bytes, and
+// otherwise written to a temp file, flushed and renamed over the target. Each file written also refreshes its snapshot
+// cache sidecar (config_snapshot_cache.h), so the next load skips the TOML parser.
+
+struct ConfigSaveJob {
+    // Empty when the job only carries sidecar writes.
+    std::wstring configPath;
+    Config sharedSnapshot;
+    // Profile name and the profile's section snapshot. Written only if the profile is still tracked at write time.
+    std::vector<std::pair<std::string, Config>> profileSnapshots;
+    // Sidecar path and encoded cache image, queued by loads that had to parse the TOML text.
+    std::vector<std::pair<std::wstring, std::string>> snapshotCaches;
+};
+
+struct ConfigPersistenceStats {
+    uint64_t savesRequested = 0;
+    uint64_t savesCoalesced = 0;
+    uint64_t savesWritten = 0;
+    uint64_t filesWritten = 0;
+    uint64_t filesUnchanged = 0;
+    uint64_t writeFailures = 0;
+    uint64_t bytesWritten = 0;
+    double lastSaveMs = 0.0;
+    double totalSaveMs = 0.0;
+};
+
+void QueueConfigSave(ConfigSaveJob job);
+
+// Queues an encoded snapshot cache image to be written to cachePath by the persistence worker.
+void QueueConfigSnapshotCacheWrite(const std::wstring& cachePath, std::string image);
+
+// Writes job on the calling thread, after any queued save has been written.
+bool WriteConfigSaveNow(const ConfigSaveJob& job);
+
+// Writes any queued save without waiting for its batch window and waits for the worker to go idle.
+bool WaitForConfigPersistenceIdle(int timeoutMs);
+
+// Writes any queued save and joins the worker. Called once during shutdown.
+void StopConfigPersistenceWorker();
+
+ConfigPersistenceStats GetConfigPersistenceStats();
+
+// Serializes config to TOML and writes it atomically, unless path already holds the same bytes.
+bool PersistConfigFile(const Config& config, const std::wstring& path);
+
+// Writes contents to a temp file next to path, flushes it to disk and renames it over path.
+bool WriteFileAtomically(const std::wstring& path, std::string_view contents);
+
+// Rename helpers shared with profile management. They retry transient sharing violations caused by
+// antivirus scanners and file indexers holding the file open.
+std::wstring MakeTempSiblingPath(const std::wstring& finalPath, const wchar_t* suffix);
+bool MovePathWithRetries(const std::wstring& fromPath, const std::wstring& toPath, DWORD flags);
+bool ReplacePathAtomically(const std::wstring& tempPath, const std::wstring& finalPath);
@@ -1,6 +1,9 @@
 #include "config_migration.h"
+#include "config_persistence.h"
+#include "config_snapshot_cache.h"
 #include "config_toml.h"
 #include "common/i18n.h"
+#include "common/profiler.h"
 #include "common/utils.h"
 #include "features/ninjabrain_client.h"
 #include "gui/gui.h"
@@ -16,6 +19,7 @@
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <sstream>
 #include <thread>
 
 void ApplyKeyRepeatSettings();
@@ -110,85 +114,6 @@ static ProfileSectionSelection ProfileSectionsFromToml(const toml::node* node) {
     return sections;
 }
 
-static std::wstring MakeTempSiblingPath(const std::wstring& finalPath, const wchar_t* suffix) {
-    const std::filesystem::path final(finalPath);
-    const std::wstring filename = final.filename().wstring();
-    return (final.parent_path() /
-            (filename + suffix + std::to_wstring(GetCurrentProcessId()) + L"-" + std::to_wstring(GetTickCount64())))
-        .wstring();
-}
-
-static bool IsTransientProfileFileError(const DWORD errorCode) {
-    return errorCode == ERROR_ACCESS_DENIED ||
-           errorCode == ERROR_LOCK_VIOLATION ||
-           errorCode == ERROR_SHARING_VIOLATION;
-}
-
-template <typename Operation>
-static bool RetryProfileFileOperation(Operation&& operation) {
-    constexpr int kMaxAttempts = 60;
-    constexpr DWORD kRetryDelayMs = 5;
-
-    DWORD lastError = ERROR_SUCCESS;
-    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
-        if (operation()) {
-            return true;
-        }
-
-        lastError = GetLastError();
-        if (!IsTransientProfileFileError(lastError) || attempt == (kMaxAttempts - 1)) {
-            SetLastError(lastError);
-            return false;
-        }
-
-        Sleep(kRetryDelayMs);
-    }
-
-    SetLastError(lastError);
-    return false;
-}
-
-static bool DeletePathIfPresentWithRetries(const std::wstring& path) {
-    return RetryProfileFileOperation([&]() {
-        if (DeleteFileW(path.c_str())) {
-            return true;
-        }
-
-        const DWORD errorCode = GetLastError();
-        if (errorCode == ERROR_FILE_NOT_FOUND || errorCode == ERROR_PATH_NOT_FOUND) {
-            SetLastError(ERROR_SUCCESS);
-            return true;
-        }
-
-        SetLastError(errorCode);
-        return false;
-    });
-}
-
-static bool MovePathWithRetries(const std::wstring& fromPath, const std::wstring& toPath, const DWORD flags) {
-    return RetryProfileFileOperation([&]() {
-        return MoveFileExW(fromPath.c_str(), toPath.c_str(), flags | MOVEFILE_WRITE_THROUGH);
-    });
-}
-
-static bool ReplacePathAtomically(const std::wstring& tempPath, const std::wstring& finalPath) {
-    if (MovePathWithRetries(tempPath, finalPath, MOVEFILE_REPLACE_EXISTING)) {
-        return true;
-    }
-
-    if (!DeletePathIfPresentWithRetries(finalPath)) {
-        return false;
-    }
-
-    if (MovePathWithRetries(tempPath, finalPath, 0)) {
-        return true;
-    }
-
-    std::error_code cleanupError;
-    std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
-    return false;
-}
-
 static bool RenamePathReplacingExisting(const std::wstring& fromPath, const std::wstring& toPath) {
     if (fromPath == toPath) {
         return true;
@@ -220,46 +145,13 @@ static void EnsureProfilesDirExists() {
 }
 
 static bool SaveConfigAtomically(const Config& config, const std::wstring& path) {
-    std::error_code dirError;
-    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), dirError);
-
-    const std::wstring tempPath = MakeTempSiblingPath(path, L".tmp-");
-    if (!SaveConfigToTomlFile(config, tempPath)) {
-        std::error_code cleanupError;
-        std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
-        return false;
-    }
-
-    if (!ReplacePathAtomically(tempPath, path)) {
-        std::error_code cleanupError;
-        std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
-        return false;
-    }
-
-    return true;
+    return PersistConfigFile(config, path);
 }
 
 static bool WriteTomlTableAtomically(const toml::table& tbl, const std::wstring& path) {
-    std::error_code dirError;
-    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), dirError);
-
-    const std::wstring tempPath = MakeTempSiblingPath(path, L".tmp-");
-    {
-        std::ofstream out(std::filesystem::path(tempPath), std::ios::binary | std::ios::trunc);
-        if (!out.is_open()) {
-            return false;
-        }
-        out << tbl;
-        out.close();
-    }
-
-    if (!ReplacePathAtomically(tempPath, path)) {
-        std::error_code cleanupError;
-        std::filesystem::remove(std::filesystem::path(tempPath), cleanupError);
-        return false;
-    }
-
-    return true;
+    std::ostringstream out;
+    out << tbl;
+    return WriteFileAtomically(path, out.view());
 }
 
 static ProfileMetadata* FindProfileMetadataLocked(const std::string& name) {
@@ -581,6 +473,7 @@ void ApplyProfileFields(const Config& src, Config& dst, const ProfileSectionSele
         dst.debug = src.debug;
         dst.fpsLimit = src.fpsLimit;
         dst.fpsLimitSleepThreshold = src.fpsLimitSleepThreshold;
+        dst.fpsLimitAlignToObsCapture = src.fpsLimitAlignToObsCapture;
         dst.disableHookChaining = src.disableHookChaining;
     }
     if (sections.appearance) {
@@ -725,6 +618,9 @@ bool EnsureProfilesConfigReady() {
 }
 
 void SwitchProfile(const std::string& newProfileName) {
+    PROFILE_SCOPE_CAT("Switch Profile", "IO Operations");
+    // Write any queued save first so it cannot land on the outgoing profile after the switch has saved it.
+    WaitForConfigPersistenceIdle(3000);
     const Config previousConfig = g_config;
     Config oldProfileConfig;
     Config newProfileConfig;
@@ -824,6 +720,7 @@ void SwitchProfile(const std::string& newProfileName) {
         g_modeIdBuffers[nextIndex] = g_config.defaultMode;
         g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
     }
+    RefreshSensitivityState();
 
     WriteCurrentModeToFile(g_config.defaultMode);
     ApplyProfileSwitchRuntimeConfig(previousConfig);
@@ -921,6 +818,8 @@ void DeleteProfile(const std::string& name) {
 
     try {
         std::filesystem::remove(std::filesystem::path(GetProfilePath(trackedName)));
+        std::error_code cacheCleanupError;
+        std::filesystem::remove(std::filesystem::path(GetConfigSnapshotCachePath(GetProfilePath(trackedName))), cacheCleanupError);
     } catch (const std::exception& e) {
         g_profilesConfig.profiles = previousProfiles;
         SaveProfilesConfigLocked();
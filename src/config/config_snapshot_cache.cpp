@@ -0,0 +1,386 @@
+#include "config_snapshot_cache.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+
+constexpr char kMagic[4] = { 'T', 'S', 'C', 'B' };
+constexpr size_t kHeaderSize = 40;
+constexpr int kMaxNestingDepth = 128;
+
+enum class SnapshotTag : std::uint8_t {
+    Table = 1,
+    Array,
+    String,
+    Integer,
+    Float,
+    Boolean,
+    Date,
+    Time,
+    DateTime,
+};
+
+std::uint64_t HashBytes(const void* data, size_t size) {
+    // FNV-1a; the cache only has to notice edits, not resist crafted collisions.
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::string& out) : m_out(out) {}
+
+    void PutU8(std::uint8_t v) { m_out.push_back(static_cast<char>(v)); }
+
+    void PutFixed(std::uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) PutU8(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void PutVarint(std::uint64_t v) {
+        while (v >= 0x80) {
+            PutU8(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        PutU8(static_cast<std::uint8_t>(v));
+    }
+
+    void PutString(std::string_view s) {
+        PutVarint(s.size());
+        m_out.append(s.data(), s.size());
+    }
+
+    void PutDate(const toml::date& d) {
+        PutFixed(d.year, 2);
+        PutU8(d.month);
+        PutU8(d.day);
+    }
+
+    void PutTime(const toml::time& t) {
+        PutU8(t.hour);
+        PutU8(t.minute);
+        PutU8(t.second);
+        PutFixed(t.nanosecond, 4);
+    }
+
+private:
+    std::string& m_out;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const std::uint8_t* data, size_t size) : m_cur(data), m_end(data + size) {}
+
+    size_t Remaining() const { return static_cast<size_t>(m_end - m_cur); }
+
+    bool GetU8(std::uint8_t& v) {
+        if (m_cur == m_end) return false;
+        v = *m_cur++;
+        return true;
+    }
+
+    bool GetFixed(std::uint64_t& v, int bytes) {
+        if (Remaining() < static_cast<size_t>(bytes)) return false;
+        v = 0;
+        for (int i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(m_cur[i]) << (8 * i);
+        m_cur += bytes;
+        return true;
+    }
+
+    bool GetVarint(std::uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            std::uint8_t byte = 0;
+            if (!GetU8(byte)) return false;
+            v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    // Element counts are bounded by the bytes left, since every element takes at least one byte.
+    bool GetCount(size_t& count) {
+        std::uint64_t v = 0;
+        if (!GetVarint(v) || v > Remaining()) return false;
+        count = static_cast<size_t>(v);
+        return true;
+    }
+
+    bool GetString(std::string& s) {
+        size_t length = 0;
+        if (!GetCount(length)) return false;
+        s.assign(reinterpret_cast<const char*>(m_cur), length);
+        m_cur += length;
+        return true;
+    }
+
+    bool GetDate(toml::date& d) {
+        std::uint64_t year = 0;
+        if (!GetFixed(year, 2) || !GetU8(d.month) || !GetU8(d.day)) return false;
+        d.year = static_cast<std::uint16_t>(year);
+        return true;
+    }
+
+    bool GetTime(toml::time& t) {
+        std::uint64_t nanosecond = 0;
+        if (!GetU8(t.hour) || !GetU8(t.minute) || !GetU8(t.second) || !GetFixed(nanosecond, 4)) return false;
+        t.nanosecond = static_cast<std::uint32_t>(nanosecond);
+        return true;
+    }
+
+private:
+    const std::uint8_t* m_cur;
+    const std::uint8_t* m_end;
+};
+
+bool EncodeNode(SnapshotWriter& w, const toml::node& node) {
+    switch (node.type()) {
+    case toml::node_type::table: {
+        const toml::table& tbl = *node.as_table();
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Table));
+        w.PutVarint(tbl.size());
+        for (const auto& [key, value] : tbl) {
+            w.PutString(key.str());
+            if (!EncodeNode(w, value)) return false;
+        }
+        return true;
+    }
+    case toml::node_type::array: {
+        const toml::array& arr = *node.as_array();
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Array));
+        w.PutVarint(arr.size());
+        for (const toml::node& elem : arr) {
+            if (!EncodeNode(w, elem)) return false;
+        }
+        return true;
+    }
+    case toml::node_type::string:
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::String));
+        w.PutString(node.as_string()->get());
+        return true;
+    case toml::node_type::integer: {
+        const std::int64_t v = node.as_integer()->get();
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Integer));
+        w.PutVarint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+        return true;
+    }
+    case toml::node_type::floating_point: {
+        const double v = node.as_floating_point()->get();
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Float));
+        w.PutFixed(bits, 8);
+        return true;
+    }
+    case toml::node_type::boolean:
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Boolean));
+        w.PutU8(node.as_boolean()->get() ? 1 : 0);
+        return true;
+    case toml::node_type::date:
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Date));
+        w.PutDate(node.as_date()->get());
+        return true;
+    case toml::node_type::time:
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::Time));
+        w.PutTime(node.as_time()->get());
+        return true;
+    case toml::node_type::date_time: {
+        const toml::date_time& dt = node.as_date_time()->get();
+        w.PutU8(static_cast<std::uint8_t>(SnapshotTag::DateTime));
+        w.PutDate(dt.date);
+        w.PutTime(dt.time);
+        w.PutU8(dt.offset.has_value() ? 1 : 0);
+        w.PutFixed(static_cast<std::uint16_t>(dt.offset.has_value() ? dt.offset->minutes : 0), 2);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// Destination of a decoded value: a key in a table or the end of an array.
+struct NodeSink {
+    toml::table* table = nullptr;
+    toml::array* array = nullptr;
+    std::string key;
+
+    template <typename T>
+    void Put(T&& value) {
+        if (table) {
+            table->insert_or_assign(key, std::forward<T>(value));
+        } else {
+            array->push_back(std::forward<T>(value));
+        }
+    }
+};
+
+bool DecodeNode(SnapshotReader& r, NodeSink& sink, int depth);
+
+bool DecodeTableEntries(SnapshotReader& r, toml::table& tbl, int depth) {
+    size_t count = 0;
+    if (!r.GetCount(count)) return false;
+    NodeSink sink;
+    sink.table = &tbl;
+    for (size_t i = 0; i < count; ++i) {
+        if (!r.GetString(sink.key) || !DecodeNode(r, sink, depth + 1)) return false;
+    }
+    return true;
+}
+
+bool DecodeNode(SnapshotReader& r, NodeSink& sink, int depth) {
+    if (depth > kMaxNestingDepth) return false;
+
+    std::uint8_t tag = 0;
+    if (!r.GetU8(tag)) return false;
+
+    switch (static_cast<SnapshotTag>(tag)) {
+    case SnapshotTag::Table: {
+        toml::table child;
+        if (!DecodeTableEntries(r, child, depth)) return false;
+        sink.Put(std::move(child));
+        return true;
+    }
+    case SnapshotTag::Array: {
+        size_t count = 0;
+        if (!r.GetCount(count)) return false;
+        toml::array child;
+        child.reserve(count);
+        NodeSink elemSink;
+        elemSink.array = &child;
+        for (size_t i = 0; i < count; ++i) {
+            if (!DecodeNode(r, elemSink, depth + 1)) return false;
+        }
+        sink.Put(std::move(child));
+        return true;
+    }
+    case SnapshotTag::String: {
+        std::string value;
+        if (!r.GetString(value)) return false;
+        sink.Put(std::move(value));
+        return true;
+    }
+    case SnapshotTag::Integer: {
+        std::uint64_t zigzag = 0;
+        if (!r.GetVarint(zigzag)) return false;
+        sink.Put(static_cast<std::int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+        return true;
+    }
+    case SnapshotTag::Float: {
+        std::uint64_t bits = 0;
+        if (!r.GetFixed(bits, 8)) return false;
+        double value = 0.0;
+        std::memcpy(&value, &bits, sizeof(value));
+        sink.Put(value);
+        return true;
+    }
+    case SnapshotTag::Boolean: {
+        std::uint8_t value = 0;
+        if (!r.GetU8(value) || value > 1) return false;
+        sink.Put(value != 0);
+        return true;
+    }
+    case SnapshotTag::Date: {
+        toml::date value;
+        if (!r.GetDate(value)) return false;
+        sink.Put(value);
+        return true;
+    }
+    case SnapshotTag::Time: {
+        toml::time value;
+        if (!r.GetTime(value)) return false;
+        sink.Put(value);
+        return true;
+    }
+    case SnapshotTag::DateTime: {
+        toml::date date;
+        toml::time time;
+        std::uint8_t hasOffset = 0;
+        std::uint64_t offsetMinutes = 0;
+        if (!r.GetDate(date) || !r.GetTime(time) || !r.GetU8(hasOffset) || hasOffset > 1 || !r.GetFixed(offsetMinutes, 2)) return false;
+        if (hasOffset) {
+            toml::time_offset offset;
+            offset.minutes = static_cast<std::int16_t>(static_cast<std::uint16_t>(offsetMinutes));
+            sink.Put(toml::date_time{ date, time, offset });
+        } else {
+            sink.Put(toml::date_time{ date, time });
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void SetError(std::string* error, const char* message) {
+    if (error) *error = message;
+}
+
+} // namespace
+
+std::uint64_t HashConfigSource(std::string_view source) { return HashBytes(source.data(), source.size()); }
+
+bool EncodeConfigSnapshotCache(const toml::table& tbl, std::string_view source, std::string& out) {
+    std::string payload;
+    SnapshotWriter payloadWriter(payload);
+    if (!EncodeNode(payloadWriter, tbl)) {
+        out.clear();
+        return false;
+    }
+
+    out.clear();
+    out.reserve(kHeaderSize + payload.size());
+    out.append(kMagic, sizeof(kMagic));
+    SnapshotWriter header(out);
+    header.PutFixed(kConfigSnapshotCacheVersion, 4);
+    header.PutFixed(source.size(), 8);
+    header.PutFixed(HashConfigSource(source), 8);
+    header.PutFixed(payload.size(), 8);
+    header.PutFixed(HashBytes(payload.data(), payload.size()), 8);
+    out += payload;
+    return true;
+}
+
+bool DecodeConfigSnapshotCache(const void* data, size_t size, std::string_view source, toml::table& out, std::string* error) {
+    out.clear();
+    if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        SetError(error, "not a config snapshot cache");
+        return false;
+    }
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    SnapshotReader header(bytes + sizeof(kMagic), kHeaderSize - sizeof(kMagic));
+    std::uint64_t version = 0, sourceSize = 0, sourceHash = 0, payloadSize = 0, payloadHash = 0;
+    header.GetFixed(version, 4);
+    header.GetFixed(sourceSize, 8);
+    header.GetFixed(sourceHash, 8);
+    header.GetFixed(payloadSize, 8);
+    header.GetFixed(payloadHash, 8);
+
+    if (version != kConfigSnapshotCacheVersion) {
+        SetError(error, "cache format version changed");
+        return false;
+    }
+    if (sourceSize != source.size() || sourceHash != HashConfigSource(source)) {
+        SetError(error, "config file changed since the cache was written");
+        return false;
+    }
+    if (payloadSize != size - kHeaderSize || payloadHash != HashBytes(bytes + kHeaderSize, static_cast<size_t>(payloadSize))) {
+        SetError(error, "cache payload is truncated or corrupt");
+        return false;
+    }
+
+    SnapshotReader payload(bytes + kHeaderSize, static_cast<size_t>(payloadSize));
+    std::uint8_t rootTag = 0;
+    if (!payload.GetU8(rootTag) || rootTag != static_cast<std::uint8_t>(SnapshotTag::Table) || !DecodeTableEntries(payload, out, 0) ||
+        payload.Remaining() != 0) {
+        out.clear();
+        SetError(error, "cache payload is malformed");
+        return false;
+    }
+    return true;
+}
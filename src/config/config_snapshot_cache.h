@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "third_party/toml.hpp"
+
+// Binary sidecar ("config.toml.cache", "<profile>.toml.cache") holding the parsed TOML document of a config file,
+// so startup and profile switches can skip the TOML text parser when the file has not changed.
+//
+// The cache stores the toml++ DOM rather than a Config: ConfigFromToml, migrations and sanitizing still run on every
+// load, so the cache never needs invalidating when config fields are added or their defaults change. It is keyed by
+// the size and hash of the exact TOML text it was built from and is rejected on any mismatch, version change,
+// truncation or payload corruption; callers then parse the TOML as usual and regenerate the sidecar.
+
+constexpr std::uint32_t kConfigSnapshotCacheVersion = 1;
+
+inline std::wstring GetConfigSnapshotCachePath(const std::wstring& tomlPath) { return tomlPath + L".cache"; }
+
+std::uint64_t HashConfigSource(std::string_view source);
+
+// Serializes tbl (parsed from source) into the cache format.
+bool EncodeConfigSnapshotCache(const toml::table& tbl, std::string_view source, std::string& out);
+
+// Rebuilds the table from a cache image if it was written for exactly this source text. On failure out is left
+// empty and, when error is non-null, it receives a short reason for logging.
+bool DecodeConfigSnapshotCache(const void* data, size_t size, std::string_view source, toml::table& out, std::string* error = nullptr);
@@ -1,6 +1,9 @@
 #include "config_toml.h"
 #include "config_defaults.h"
+#include "config_persistence.h"
+#include "config_snapshot_cache.h"
 #include "common/expression_parser.h"
+#include "common/profiler.h"
 #include "gui/gui.h"
 #include "runtime/logic_thread.h"
 #include "common/utils.h"
@@ -8,10 +11,12 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <optional>
 #include <sstream>
 #include <unordered_set>
@@ -284,10 +289,10 @@ void ModeConfigFromTomlInternal(const toml::table& tbl, ModeConfig& cfg, const s
     }
 
     if (!cfg.widthExpr.empty() && cachedScreenWidth > 0 && cachedScreenHeight > 0) {
-        cfg.width = (std::max)(1, EvaluateExpression(cfg.widthExpr, cachedScreenWidth, cachedScreenHeight, cfg.width));
+        cfg.width = (std::max)(1, EvaluateExpressionCached(cfg.widthExpr, cachedScreenWidth, cachedScreenHeight, cfg.width));
     }
     if (!cfg.heightExpr.empty() && cachedScreenWidth > 0 && cachedScreenHeight > 0) {
-        cfg.height = (std::max)(1, EvaluateExpression(cfg.heightExpr, cachedScreenWidth, cachedScreenHeight, cfg.height));
+        cfg.height = (std::max)(1, EvaluateExpressionCached(cfg.heightExpr, cachedScreenWidth, cachedScreenHeight, cfg.height));
     }
 
     cfg.manualWidth = (cfg.width > 0) ? cfg.width : ConfigDefaults::MODE_WIDTH;
@@ -2238,6 +2243,7 @@ void ConfigToToml(const Config& config, toml::table& out) {
     out.insert("lang", config.lang);
     out.insert("fpsLimit", config.fpsLimit);
     out.insert("fpsLimitSleepThreshold", config.fpsLimitSleepThreshold);
+    out.insert("fpsLimitAlignToObsCapture", config.fpsLimitAlignToObsCapture);
     out.insert("mirrorMatchColorspace", MirrorGammaModeToString(config.mirrorGammaMode));
     out.insert("allowCursorEscape", config.allowCursorEscape);
     out.insert("confineCursor", config.confineCursor);
@@ -2513,6 +2519,7 @@ void ConfigFromToml(const toml::table& tbl, Config& config) {
     config.lang = GetStringOr(tbl, "lang", ConfigDefaults::CONFIG_LANG);
     config.fpsLimit = GetOr(tbl, "fpsLimit", ConfigDefaults::CONFIG_FPS_LIMIT);
     config.fpsLimitSleepThreshold = GetOr(tbl, "fpsLimitSleepThreshold", ConfigDefaults::CONFIG_FPS_LIMIT_SLEEP_THRESHOLD);
+    config.fpsLimitAlignToObsCapture = GetOr(tbl, "fpsLimitAlignToObsCapture", ConfigDefaults::CONFIG_FPS_LIMIT_ALIGN_TO_OBS_CAPTURE);
     bool hasGlobalMirrorMatchColorspace = tbl.contains("mirrorMatchColorspace");
     config.mirrorGammaMode = StringToMirrorGammaMode(
         GetStringOr(tbl, "mirrorMatchColorspace", ConfigDefaults::CONFIG_MIRROR_MATCH_COLORSPACE));
@@ -2990,6 +2997,7 @@ const std::vector<std::string>& GetConfigTomlOrderedKeys() {
         "lang",
         "fpsLimit",
         "fpsLimitSleepThreshold",
+        "fpsLimitAlignToObsCapture",
         "mirrorMatchColorspace",
         "allowCursorEscape",
         "confineCursor",
@@ -3489,11 +3497,13 @@ bool WriteConfigTomlDocument(std::ostream& out, const Config& config) {
 
 bool SerializeConfigToTomlString(const Config& config, std::string& outToml) {
     try {
-        std::ostringstream out;
+        // Serialize into outToml's existing allocation so a caller that keeps the string across saves does not regrow it.
+        outToml.clear();
+        std::ostringstream out(std::move(outToml));
         if (!WriteConfigTomlDocument(out, config)) {
             return false;
         }
-        outToml = out.str();
+        outToml = std::move(out).str();
         return true;
     } catch (const std::exception& e) {
         Log("ERROR: Failed to serialize config to TOML: " + std::string(e.what()));
@@ -3519,6 +3529,48 @@ bool SaveConfigToTomlFile(const Config& config, const std::wstring& path) {
     }
 }
 
+static bool TryLoadConfigSnapshotCache(const std::wstring& cachePath, const std::string& source, toml::table& tbl) {
+    PROFILE_SCOPE_CAT("Config Snapshot Cache Load", "IO Operations");
+
+    HANDLE file = CreateFileW(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return false; }
+
+    bool loaded = false;
+    LARGE_INTEGER size{};
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            if (const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                std::string error;
+                loaded = DecodeConfigSnapshotCache(view, static_cast<size_t>(size.QuadPart), source, tbl, &error);
+                if (!loaded) { Log("Config snapshot cache skipped for " + WideToUtf8(cachePath) + ": " + error); }
+                UnmapViewOfFile(view);
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    return loaded;
+}
+
+bool EncodeConfigSnapshotCacheFromSource(const std::string& source, std::string& out) {
+    toml::table tbl;
+    std::string parseError;
+    return ParseTomlTableFromString(source, tbl, parseError) && EncodeConfigSnapshotCache(tbl, source, out);
+}
+
+// Encodes on the caller (a fraction of the parse it replaces) and leaves the write to the persistence worker, which
+// writes through a temp file and rename so a reader never maps a partially written cache.
+static void QueueSnapshotCacheWriteForLoad(const std::wstring& cachePath, const toml::table& tbl, const std::string& source) {
+    std::string image;
+    if (!EncodeConfigSnapshotCache(tbl, source, image)) {
+        Log("WARNING: Config snapshot cache could not encode " + WideToUtf8(cachePath));
+        return;
+    }
+    QueueConfigSnapshotCacheWrite(cachePath, std::move(image));
+}
+
 bool LoadConfigFromTomlFile(const std::wstring& path, Config& config) {
     try {
         std::ifstream in(std::filesystem::path(path), std::ios::binary);
@@ -3533,17 +3585,22 @@ bool LoadConfigFromTomlFile(const std::wstring& path, Config& config) {
         toml::table tbl;
         std::string parseError;
         const std::string source = buffer.str();
+        const std::wstring cachePath = GetConfigSnapshotCachePath(path);
         bool repairedLegacyArrayConflict = false;
-        if (!ParseTomlTableFromString(source, tbl, parseError)) {
-            std::string repairedSource;
-            if (parseError.find("cannot redefine existing array") != std::string::npos &&
-                RepairLegacyArrayOfTablesConflicts(source, repairedSource) &&
-                ParseTomlTableFromString(repairedSource, tbl, parseError)) {
-                repairedLegacyArrayConflict = true;
-                Log("WARNING: Repaired legacy TOML array-of-tables conflict while loading: " + WideToUtf8(path));
+        if (!TryLoadConfigSnapshotCache(cachePath, source, tbl)) {
+            if (ParseTomlTableFromString(source, tbl, parseError)) {
+                QueueSnapshotCacheWriteForLoad(cachePath, tbl, source);
             } else {
-                Log("ERROR: TOML parse error: " + parseError);
-                return false;
+                std::string repairedSource;
+                if (parseError.find("cannot redefine existing array") != std::string::npos &&
+                    RepairLegacyArrayOfTablesConflicts(source, repairedSource) &&
+                    ParseTomlTableFromString(repairedSource, tbl, parseError)) {
+                    repairedLegacyArrayConflict = true;
+                    Log("WARNING: Repaired legacy TOML array-of-tables conflict while loading: " + WideToUtf8(path));
+                } else {
+                    Log("ERROR: TOML parse error: " + parseError);
+                    return false;
+                }
             }
         }
 
@@ -3568,8 +3625,6 @@ bool LoadConfigFromTomlFile(const std::wstring& path, Config& config) {
 
 #include "platform/resource.h"
 
-static std::string s_embeddedConfigCache;
-static bool s_embeddedConfigLoaded = false;
 static std::vector<NinjabrainPresetDefinition> s_embeddedNinjabrainPresetsCache;
 static bool s_embeddedNinjabrainPresetsLoaded = false;
 
@@ -3603,19 +3658,76 @@ static std::string LoadEmbeddedRcDataString(int resourceId, const char* debugNam
     return std::string(data, size);
 }
 
-std::string GetEmbeddedDefaultConfigString() {
-    if (s_embeddedConfigLoaded) { return s_embeddedConfigCache; }
+// default.toml parsed once per process. Sections are stored as written in the file; adjustments that depend on
+// the running system (screen size, DPI, temp directory) are applied by the getters on every call.
+struct EmbeddedDefaults {
+    std::string source;
+    toml::table table;
+    bool parsed = false;
 
-    s_embeddedConfigCache = LoadEmbeddedRcDataString(IDR_DEFAULT_CONFIG, "embedded default.toml");
-    if (s_embeddedConfigCache.empty()) {
-        return "";
+    std::vector<ModeConfig> modes;
+    std::vector<MirrorConfig> mirrors;
+    std::vector<MirrorGroupConfig> mirrorGroups;
+    std::vector<HotkeyConfig> hotkeys;
+    std::vector<ImageConfig> images;
+    CursorsConfig cursors;
+    EyeZoomConfig eyezoom;
+};
+
+template <typename T, typename FromToml>
+static std::vector<T> ReadEmbeddedArray(const toml::table& tbl, const char* key, FromToml&& fromToml) {
+    std::vector<T> items;
+    if (auto arr = GetArray(tbl, key)) {
+        for (const auto& elem : *arr) {
+            if (auto t = elem.as_table()) {
+                T item;
+                fromToml(*t, item);
+                items.push_back(std::move(item));
+            }
+        }
     }
-    s_embeddedConfigLoaded = true;
+    return items;
+}
+
+static EmbeddedDefaults LoadEmbeddedDefaults() {
+    EmbeddedDefaults defaults;
+    defaults.source = LoadEmbeddedRcDataString(IDR_DEFAULT_CONFIG, "embedded default.toml");
+    if (defaults.source.empty()) { return defaults; }
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        defaults.table = toml::parse(defaults.source);
+        const toml::table& tbl = defaults.table;
+
+        defaults.modes = ReadEmbeddedArray<ModeConfig>(tbl, "mode", ModeConfigFromToml);
+        defaults.mirrors = ReadEmbeddedArray<MirrorConfig>(tbl, "mirror", MirrorConfigFromToml);
+        defaults.mirrorGroups = ReadEmbeddedArray<MirrorGroupConfig>(tbl, "mirrorGroup", MirrorGroupConfigFromToml);
+        defaults.hotkeys = ReadEmbeddedArray<HotkeyConfig>(tbl, "hotkey", HotkeyConfigFromToml);
+        defaults.images = ReadEmbeddedArray<ImageConfig>(tbl, "image", ImageConfigFromToml);
+        if (auto t = GetTable(tbl, "cursors")) { CursorsConfigFromToml(*t, defaults.cursors); }
+        if (auto t = GetTable(tbl, "eyezoom")) { EyeZoomConfigFromToml(*t, defaults.eyezoom); }
+        defaults.parsed = true;
+    } catch (const std::exception& e) {
+        Log("ERROR: Failed to parse embedded default.toml: " + std::string(e.what()));
+        return defaults;
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-    Log("Loaded embedded default.toml (" + std::to_string(s_embeddedConfigCache.size()) + " bytes)");
-    return s_embeddedConfigCache;
+    std::ostringstream msg;
+    msg << "Loaded embedded default.toml (" << defaults.source.size() << " bytes, parsed in " << std::fixed << std::setprecision(2)
+        << elapsedMs << " ms)";
+    Log(msg.str());
+    return defaults;
 }
 
+// Thread-safe lazy initialization; every later caller shares the same immutable instance.
+static const EmbeddedDefaults& GetEmbeddedDefaults() {
+    static const EmbeddedDefaults s_defaults = LoadEmbeddedDefaults();
+    return s_defaults;
+}
+
+std::string GetEmbeddedDefaultConfigString() { return GetEmbeddedDefaults().source; }
+
 std::vector<NinjabrainPresetDefinition> GetEmbeddedNinjabrainPresets() {
     if (s_embeddedNinjabrainPresetsLoaded) {
         return s_embeddedNinjabrainPresetsCache;
@@ -3672,16 +3784,12 @@ std::vector<NinjabrainPresetDefinition> GetEmbeddedNinjabrainPresets() {
 }
 
 bool LoadEmbeddedDefaultConfig(Config& config) {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    if (configStr.empty()) { return false; }
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) { return false; }
 
     try {
-        toml::table tbl = toml::parse(configStr);
-        ConfigFromToml(tbl, config);
+        ConfigFromToml(defaults.table, config);
         return true;
-    } catch (const toml::parse_error& e) {
-        Log("ERROR: Failed to parse embedded default.toml: " + std::string(e.what()));
-        return false;
     } catch (const std::exception& e) {
         Log("ERROR: Failed to load embedded default config: " + std::string(e.what()));
         return false;
@@ -3692,231 +3800,131 @@ int GetCachedWindowWidth();
 int GetCachedWindowHeight();
 
 std::vector<ModeConfig> GetDefaultModesFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    std::vector<ModeConfig> modes;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for modes, falling back to empty");
-        return modes;
+        return {};
     }
 
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto arr = GetArray(tbl, "mode")) {
-            for (const auto& elem : *arr) {
-                if (auto t = elem.as_table()) {
-                    ModeConfig mode;
-                    ModeConfigFromToml(*t, mode);
-                    modes.push_back(mode);
-                }
-            }
-        }
+    std::vector<ModeConfig> modes = defaults.modes;
 
-        int screenWidth = GetCachedWindowWidth();
-        int screenHeight = GetCachedWindowHeight();
+    int screenWidth = GetCachedWindowWidth();
+    int screenHeight = GetCachedWindowHeight();
 
-        for (auto& mode : modes) {
-            if (mode.id == "Fullscreen") {
-                mode.width = screenWidth;
-                mode.height = screenHeight;
-                if (mode.stretch.enabled) {
-                    mode.stretch.width = screenWidth;
-                    mode.stretch.height = screenHeight;
-                }
+    for (auto& mode : modes) {
+        if (mode.id == "Fullscreen") {
+            mode.width = screenWidth;
+            mode.height = screenHeight;
+            if (mode.stretch.enabled) {
+                mode.stretch.width = screenWidth;
+                mode.stretch.height = screenHeight;
             }
         }
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded modes: " + std::string(e.what())); }
+    }
 
     return modes;
 }
 
 std::vector<MirrorConfig> GetDefaultMirrorsFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    std::vector<MirrorConfig> mirrors;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for mirrors, falling back to empty");
-        return mirrors;
+        return {};
     }
-
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto arr = GetArray(tbl, "mirror")) {
-            for (const auto& elem : *arr) {
-                if (auto t = elem.as_table()) {
-                    MirrorConfig mirror;
-                    MirrorConfigFromToml(*t, mirror);
-                    mirrors.push_back(mirror);
-                }
-            }
-        }
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded mirrors: " + std::string(e.what())); }
-
-    return mirrors;
+    return defaults.mirrors;
 }
 
 std::vector<MirrorGroupConfig> GetDefaultMirrorGroupsFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    std::vector<MirrorGroupConfig> groups;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for mirror groups, falling back to empty");
-        return groups;
+        return {};
     }
-
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto arr = GetArray(tbl, "mirrorGroup")) {
-            for (const auto& elem : *arr) {
-                if (auto t = elem.as_table()) {
-                    MirrorGroupConfig group;
-                    MirrorGroupConfigFromToml(*t, group);
-                    groups.push_back(group);
-                }
-            }
-        }
-
-    } catch (const std::exception& e) {
-        Log("ERROR: Failed to parse embedded mirror groups: " + std::string(e.what()));
-    }
-
-    return groups;
+    return defaults.mirrorGroups;
 }
 
 std::vector<HotkeyConfig> GetDefaultHotkeysFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    std::vector<HotkeyConfig> hotkeys;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for hotkeys, falling back to empty");
-        return hotkeys;
+        return {};
     }
-
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto arr = GetArray(tbl, "hotkey")) {
-            for (const auto& elem : *arr) {
-                if (auto t = elem.as_table()) {
-                    HotkeyConfig hotkey;
-                    HotkeyConfigFromToml(*t, hotkey);
-                    hotkeys.push_back(hotkey);
-                }
-            }
-        }
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded hotkeys: " + std::string(e.what())); }
-
-    return hotkeys;
+    return defaults.hotkeys;
 }
 
 std::vector<ImageConfig> GetDefaultImagesFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    std::vector<ImageConfig> images;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for images, falling back to empty");
-        return images;
+        return {};
     }
 
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto arr = GetArray(tbl, "image")) {
-            for (const auto& elem : *arr) {
-                if (auto t = elem.as_table()) {
-                    ImageConfig image;
-                    ImageConfigFromToml(*t, image);
-                    images.push_back(image);
-                }
-            }
-        }
+    std::vector<ImageConfig> images = defaults.images;
 
-        for (auto& image : images) {
-            if (image.name == "Ninjabrain Bot" && image.path.empty()) {
-                WCHAR tempPath[MAX_PATH];
-                if (GetTempPathW(MAX_PATH, tempPath) > 0) {
-                    std::wstring nbImagePath = std::wstring(tempPath) + L"nb-overlay.png";
-                    image.path = WideToUtf8(nbImagePath);
-                }
+    for (auto& image : images) {
+        if (image.name == "Ninjabrain Bot" && image.path.empty()) {
+            WCHAR tempPath[MAX_PATH];
+            if (GetTempPathW(MAX_PATH, tempPath) > 0) {
+                std::wstring nbImagePath = std::wstring(tempPath) + L"nb-overlay.png";
+                image.path = WideToUtf8(nbImagePath);
             }
         }
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded images: " + std::string(e.what())); }
+    }
 
     return images;
 }
 
 CursorsConfig GetDefaultCursorsFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    CursorsConfig cursors;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for cursors, falling back to defaults");
-        return cursors;
+        return CursorsConfig{};
     }
 
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto t = GetTable(tbl, "cursors")) { CursorsConfigFromToml(*t, cursors); }
+    CursorsConfig cursors = defaults.cursors;
 
-        HDC hdc = GetDC(NULL);
-        int dpi = GetDeviceCaps(hdc, LOGPIXELSY);
-        ReleaseDC(NULL, hdc);
+    HDC hdc = GetDC(NULL);
+    int dpi = GetDeviceCaps(hdc, LOGPIXELSY);
+    ReleaseDC(NULL, hdc);
 
-        int systemCursorSize = GetSystemMetricsForDpi(SM_CYCURSOR, dpi);
-        systemCursorSize = std::clamp(systemCursorSize, ConfigDefaults::CURSOR_MIN_SIZE, ConfigDefaults::CURSOR_MAX_SIZE);
+    int systemCursorSize = GetSystemMetricsForDpi(SM_CYCURSOR, dpi);
+    systemCursorSize = std::clamp(systemCursorSize, ConfigDefaults::CURSOR_MIN_SIZE, ConfigDefaults::CURSOR_MAX_SIZE);
 
-        cursors.title.cursorSize = systemCursorSize;
-        cursors.wall.cursorSize = systemCursorSize;
-        cursors.ingame.cursorSize = systemCursorSize;
-
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded cursors: " + std::string(e.what())); }
+    cursors.title.cursorSize = systemCursorSize;
+    cursors.wall.cursorSize = systemCursorSize;
+    cursors.ingame.cursorSize = systemCursorSize;
 
     return cursors;
 }
 
 EyeZoomConfig GetDefaultEyeZoomConfigFromEmbedded() {
-    std::string configStr = GetEmbeddedDefaultConfigString();
-    EyeZoomConfig eyezoom;
-
-    if (configStr.empty()) {
+    const EmbeddedDefaults& defaults = GetEmbeddedDefaults();
+    if (!defaults.parsed) {
         Log("WARNING: Could not load embedded config for eyezoom, falling back to defaults");
-        return eyezoom;
+        return EyeZoomConfig{};
     }
 
-    try {
-        toml::table tbl = toml::parse(configStr);
-
-        if (auto t = GetTable(tbl, "eyezoom")) { EyeZoomConfigFromToml(*t, eyezoom); }
-
-        int screenWidth = GetCachedWindowWidth();
-        int screenHeight = GetCachedWindowHeight();
-
-        int eyezoomWindowWidth = eyezoom.windowWidth;
-        if (eyezoomWindowWidth < 1) eyezoomWindowWidth = ConfigDefaults::EYEZOOM_WINDOW_WIDTH;
-        int eyezoomTargetFinalX = (screenWidth - eyezoomWindowWidth) / 2;
-        if (eyezoomTargetFinalX < 1) eyezoomTargetFinalX = 1;
-        int horizontalMargin = ((screenWidth / 2) - (eyezoomWindowWidth / 2)) / 20;
-        int verticalMargin = (screenHeight / 2) / 4;
+    EyeZoomConfig eyezoom = defaults.eyezoom;
 
-        int defaultZoomAreaWidth = eyezoomTargetFinalX - (2 * horizontalMargin);
-        int defaultZoomAreaHeight = screenHeight - (2 * verticalMargin);
-        if (defaultZoomAreaWidth < 1) defaultZoomAreaWidth = 1;
-        if (defaultZoomAreaHeight < 1) defaultZoomAreaHeight = 1;
-
-        eyezoom.zoomAreaWidth = defaultZoomAreaWidth;
-        eyezoom.zoomAreaHeight = defaultZoomAreaHeight;
-        eyezoom.positionX = horizontalMargin;
-        eyezoom.positionY = verticalMargin;
+    int screenWidth = GetCachedWindowWidth();
+    int screenHeight = GetCachedWindowHeight();
 
-    } catch (const std::exception& e) { Log("ERROR: Failed to parse embedded eyezoom: " + std::string(e.what())); }
+    int eyezoomWindowWidth = eyezoom.windowWidth;
+    if (eyezoomWindowWidth < 1) eyezoomWindowWidth = ConfigDefaults::EYEZOOM_WINDOW_WIDTH;
+    int eyezoomTargetFinalX = (screenWidth - eyezoomWindowWidth) / 2;
+    if (eyezoomTargetFinalX < 1) eyezoomTargetFinalX = 1;
+    int horizontalMargin = ((screenWidth / 2) - (eyezoomWindowWidth / 2)) / 20;
+    int verticalMargin = (screenHeight / 2) / 4;
+
+    int defaultZoomAreaWidth = eyezoomTargetFinalX - (2 * horizontalMargin);
+    int defaultZoomAreaHeight = screenHeight - (2 * verticalMargin);
+    if (defaultZoomAreaWidth < 1) defaultZoomAreaWidth = 1;
+    if (defaultZoomAreaHeight < 1) defaultZoomAreaHeight = 1;
+
+    eyezoom.zoomAreaWidth = defaultZoomAreaWidth;
+    eyezoom.zoomAreaHeight = defaultZoomAreaHeight;
+    eyezoom.positionX = horizontalMargin;
+    eyezoom.positionY = verticalMargin;
 
     return eyezoom;
 }
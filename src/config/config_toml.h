@@ -76,6 +76,8 @@ void KeyRebindsConfigToToml(const KeyRebindsConfig& cfg, toml::table& out);
 void AppearanceConfigToToml(const AppearanceConfig& cfg, toml::table& out);
 void ConfigToToml(const Config& config, toml::table& out);
 bool SerializeConfigToTomlString(const Config& config, std::string& outToml);
+// Parses source and encodes its snapshot cache sidecar image (config_snapshot_cache.h) into out.
+bool EncodeConfigSnapshotCacheFromSource(const std::string& source, std::string& out);
 
 
 void BackgroundConfigFromToml(const toml::table& tbl, BackgroundConfig& cfg);
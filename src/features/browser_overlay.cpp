@@ -1,6 +1,9 @@
 #include "browser_overlay.h"
 
+#include "common/pixel_ops.h"
+#include "common/profiler.h"
 #include "common/utils.h"
+#include "config/config_diff.h"
 #include "render/render.h"
 #include "third_party/stb_image.h"
 
@@ -34,6 +37,8 @@ constexpr int kBrowserOverlayOffscreenPos = -32000;
 constexpr size_t kBrowserOverlayMaxFrameBytes = 100ull * 1024ull * 1024ull;
 constexpr size_t kBrowserOverlayUploadPboCount = 3;
 constexpr size_t kBrowserOverlayEnvironmentCount = 4;
+constexpr unsigned kBrowserOverlayMaxDecodeThreads = 4;
+constexpr size_t kBrowserOverlayMaxPooledEncodedBuffers = 8;
 
 struct BrowserOverlayEnvironmentState {
     ComPtr<ICoreWebView2Environment> environment;
@@ -86,6 +91,12 @@ struct BrowserOverlayCacheEntry {
     bool controllerCreationFailed = false;
     bool pendingReload = false;
     uint64_t latestQueuedDecodeSequence = 0;
+    // Content hashes of the last accepted PNG (UI thread) and the last raw window capture (overlay
+    // thread). An identical capture is dropped before decode/swizzle so static pages never re-upload.
+    uint64_t lastEncodedFrameHash = 0;
+    bool hasEncodedFrameHash = false;
+    uint64_t lastCapturedFrameHash = 0;
+    bool hasCapturedFrameHash = false;
     std::chrono::steady_clock::time_point lastCaptureTime{};
     std::chrono::steady_clock::time_point lastReloadTime{};
 
@@ -145,13 +156,25 @@ std::vector<BrowserOverlayPendingGlCleanup> g_browserOverlayPendingGlCleanup;
 std::mutex g_browserOverlayPendingGlCleanupMutex;
 
 std::atomic<bool> g_stopBrowserOverlayThread{ false };
+// Set when a cache entry is marked for removal outside a config change, e.g. "Reset to defaults" on a list that
+// already equals the defaults, so the thread re-syncs it even though the section version did not move.
+std::atomic<bool> g_browserOverlayReconcileRequested{ false };
 std::thread g_browserOverlayThread;
-std::thread g_browserOverlayDecodeThread;
+std::vector<std::thread> g_browserOverlayDecodeThreads;
 
+// Latest undecoded frame per overlay. A worker claims an overlay by moving it into the decoding set,
+// so frames of one overlay are decoded in order while different overlays decode in parallel.
 std::map<std::string, BrowserOverlayEncodedFrame> g_browserOverlayPendingDecodeFrames;
+std::set<std::string> g_browserOverlayDecodingOverlays;
+std::vector<std::vector<stbi_uc>> g_browserOverlayEncodedBufferPool;
 std::mutex g_browserOverlayDecodeMutex;
 std::condition_variable g_browserOverlayDecodeCv;
 
+// Profiler events keep raw section-name pointers, so per-overlay scope names are interned for the
+// lifetime of the process.
+std::set<std::string> g_browserOverlayProfileScopeNames;
+std::mutex g_browserOverlayProfileScopeNamesMutex;
+
 std::array<BrowserOverlayEnvironmentState, kBrowserOverlayEnvironmentCount> g_browserOverlayEnvironments;
 std::atomic<bool> g_browserOverlayHostClassRegistered{ false };
 
@@ -225,7 +248,7 @@ std::string GetBrowserOverlayEnvironmentModeLabel(bool allowSystemMediaKeys, boo
 }
 
 void LogBrowserOverlayMessage(const std::string& message) {
-    LogCategory("browser_overlay", message);
+    LOG_CATEGORY(BrowserOverlay, message);
 }
 
 std::wstring GetBrowserOverlayUserDataFolder(bool allowSystemMediaKeys, bool hardwareAcceleration) {
@@ -500,10 +523,48 @@ void UpdateBrowserOverlayBuffer(BrowserOverlayCacheEntry& entry, const unsigned
     entry.hasNewFrame.store(true, std::memory_order_release);
 }
 
+std::vector<stbi_uc> AcquireBrowserOverlayEncodedBuffer() {
+    std::lock_guard<std::mutex> lock(g_browserOverlayDecodeMutex);
+    if (g_browserOverlayEncodedBufferPool.empty()) {
+        return {};
+    }
+
+    std::vector<stbi_uc> buffer = std::move(g_browserOverlayEncodedBufferPool.back());
+    g_browserOverlayEncodedBufferPool.pop_back();
+    return buffer;
+}
+
+void ReleaseBrowserOverlayEncodedBufferLocked(std::vector<stbi_uc>&& buffer) {
+    if (buffer.capacity() == 0 || g_browserOverlayEncodedBufferPool.size() >= kBrowserOverlayMaxPooledEncodedBuffers) {
+        return;
+    }
+
+    buffer.clear();
+    g_browserOverlayEncodedBufferPool.push_back(std::move(buffer));
+}
+
+const char* GetBrowserOverlayDecodeProfileScopeName(const std::string& overlayId) {
+    // Called for every decoded frame; the name is only read when the profiler records the scope.
+    if (!Profiler::GetInstance().IsEnabled()) { return "Decode"; }
+
+    // Interned names never move, so each decode worker remembers the last one it looked up.
+    thread_local std::string s_lastOverlayId;
+    thread_local const char* s_lastScopeName = nullptr;
+    if (s_lastScopeName != nullptr && s_lastOverlayId == overlayId) { return s_lastScopeName; }
+
+    {
+        std::lock_guard<std::mutex> lock(g_browserOverlayProfileScopeNamesMutex);
+        s_lastScopeName = g_browserOverlayProfileScopeNames.insert("Decode '" + overlayId + "'").first->c_str();
+    }
+    s_lastOverlayId = overlayId;
+    return s_lastScopeName;
+}
+
 void EnqueueBrowserOverlayDecode(BrowserOverlayEncodedFrame&& frame) {
     {
         std::lock_guard<std::mutex> lock(g_browserOverlayDecodeMutex);
         auto& slot = g_browserOverlayPendingDecodeFrames[frame.overlayId];
+        ReleaseBrowserOverlayEncodedBufferLocked(std::move(slot.encodedBytes));
         slot = std::move(frame);
     }
     g_browserOverlayDecodeCv.notify_one();
@@ -591,18 +652,20 @@ bool CaptureBrowserOverlayHostWindow(BrowserOverlayCacheEntry& entry) {
         const int scanlines = GetDIBits(hdcScreen, hBitmap, 0, captureHeight, entry.writeBuffer->pixelData, &bmi, DIB_RGB_COLORS);
         if (scanlines == captureHeight) {
             const size_t totalPixels = static_cast<size_t>(captureWidth) * static_cast<size_t>(captureHeight);
-            for (size_t pixelIndex = 0; pixelIndex < totalPixels; ++pixelIndex) {
-                unsigned char* pixel = &entry.writeBuffer->pixelData[pixelIndex * 4];
-                std::swap(pixel[0], pixel[2]);
-                pixel[3] = 255;
-            }
+            const uint64_t frameHash = HashFrameBytes(entry.writeBuffer->pixelData, totalPixels * 4);
+            if (!entry.hasCapturedFrameHash || frameHash != entry.lastCapturedFrameHash) {
+                entry.lastCapturedFrameHash = frameHash;
+                entry.hasCapturedFrameHash = true;
+                ConvertBgraToRgbaOpaque(entry.writeBuffer->pixelData, totalPixels);
 
-            {
-                std::lock_guard<std::mutex> lock(entry.swapMutex);
-                entry.writeBuffer.swap(entry.readyBuffer);
-            }
+                {
+                    std::lock_guard<std::mutex> lock(entry.swapMutex);
+                    entry.writeBuffer.swap(entry.readyBuffer);
+                }
 
-            entry.hasNewFrame.store(true, std::memory_order_release);
+                entry.hasNewFrame.store(true, std::memory_order_release);
+            }
+            // An unchanged page keeps showing the frame that is already uploaded.
             success = true;
         }
     }
@@ -1048,6 +1111,11 @@ void SyncBrowserOverlayEntry(const BrowserOverlayConfig& config) {
             slot->reloadOnUpdate = config.reloadOnUpdate;
             slot->reloadInterval = (std::max)(0, config.reloadInterval);
             slot->markedForRemoval = false;
+            if (transparencyChanged) {
+                // The other capture path starts from scratch; its first frame must not be deduplicated.
+                slot->hasEncodedFrameHash = false;
+                slot->hasCapturedFrameHash = false;
+            }
         }
         entryPtr = slot;
     }
@@ -1304,18 +1372,38 @@ void TryCaptureBrowserOverlay(const std::string& overlayId) {
                     return S_OK;
                 }
 
+                const uint64_t encodedHash = HashFrameBytes(rawBytes, encodedSize);
+                bool unchanged = false;
+                {
+                    std::lock_guard<std::mutex> lock(g_browserOverlayCacheMutex);
+                    auto it = g_browserOverlayCache.find(overlayId);
+                    if (it != g_browserOverlayCache.end() && it->second) {
+                        BrowserOverlayCacheEntry& entry = *it->second;
+                        entry.captureInFlight = false;
+                        unchanged = entry.hasEncodedFrameHash && entry.lastEncodedFrameHash == encodedHash;
+                    }
+                }
+
+                if (unchanged) {
+                    // WebView2 encodes identical pages to identical PNGs, so skip decode and upload.
+                    GlobalUnlock(hGlobal);
+                    return S_OK;
+                }
+
                 BrowserOverlayEncodedFrame frame{};
                 frame.overlayId = overlayId;
-                frame.encodedBytes.resize(encodedSize);
-                memcpy(frame.encodedBytes.data(), rawBytes, encodedSize);
+                frame.encodedBytes = AcquireBrowserOverlayEncodedBuffer();
+                frame.encodedBytes.assign(static_cast<const stbi_uc*>(rawBytes), static_cast<const stbi_uc*>(rawBytes) + encodedSize);
                 GlobalUnlock(hGlobal);
 
                 {
                     std::lock_guard<std::mutex> lock(g_browserOverlayCacheMutex);
                     auto it = g_browserOverlayCache.find(overlayId);
                     if (it != g_browserOverlayCache.end() && it->second) {
-                        it->second->captureInFlight = false;
-                        frame.sequence = ++it->second->latestQueuedDecodeSequence;
+                        BrowserOverlayCacheEntry& entry = *it->second;
+                        entry.lastEncodedFrameHash = encodedHash;
+                        entry.hasEncodedFrameHash = true;
+                        frame.sequence = ++entry.latestQueuedDecodeSequence;
                     }
                 }
 
@@ -1338,63 +1426,78 @@ void TryCaptureBrowserOverlay(const std::string& overlayId) {
     }
 }
 
+bool HasClaimableBrowserOverlayDecodeLocked() {
+    for (const auto& [overlayId, _] : g_browserOverlayPendingDecodeFrames) {
+        if (g_browserOverlayDecodingOverlays.find(overlayId) == g_browserOverlayDecodingOverlays.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void BrowserOverlayDecodeThreadFunc() {
     // Image overlays use a global stb vertical flip; browser captures need the raw orientation.
     stbi_set_flip_vertically_on_load_thread(0);
 
-    LogBrowserOverlayMessage("[BrowserOverlay] Decode thread started");
-
     while (true) {
         BrowserOverlayEncodedFrame frame{};
         {
             std::unique_lock<std::mutex> lock(g_browserOverlayDecodeMutex);
             g_browserOverlayDecodeCv.wait(lock, [] {
-                return g_stopBrowserOverlayThread.load(std::memory_order_acquire) || !g_browserOverlayPendingDecodeFrames.empty();
+                return g_stopBrowserOverlayThread.load(std::memory_order_acquire) || HasClaimableBrowserOverlayDecodeLocked();
             });
 
-            if (g_stopBrowserOverlayThread.load(std::memory_order_acquire) && g_browserOverlayPendingDecodeFrames.empty()) {
+            if (g_stopBrowserOverlayThread.load(std::memory_order_acquire) && !HasClaimableBrowserOverlayDecodeLocked()) {
                 break;
             }
 
             auto it = g_browserOverlayPendingDecodeFrames.begin();
+            while (g_browserOverlayDecodingOverlays.find(it->first) != g_browserOverlayDecodingOverlays.end()) {
+                ++it;
+            }
             frame = std::move(it->second);
             g_browserOverlayPendingDecodeFrames.erase(it);
+            g_browserOverlayDecodingOverlays.insert(frame.overlayId);
         }
 
-        if (frame.encodedBytes.empty() || frame.sequence == 0) {
-            continue;
-        }
+        if (!frame.encodedBytes.empty() && frame.sequence != 0) {
+            PROFILE_SCOPE_CAT("Browser Overlay Decode", "Browser Overlay");
+            Profiler::ScopedTimer overlayDecodeTimer(Profiler::GetInstance(), GetBrowserOverlayDecodeProfileScopeName(frame.overlayId));
+
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            unsigned char* pixels = stbi_load_from_memory(frame.encodedBytes.data(), static_cast<int>(frame.encodedBytes.size()), &width,
+                                                          &height, &channels, 4);
+
+            if (pixels && width > 0 && height > 0) {
+                std::shared_ptr<BrowserOverlayCacheEntry> entry;
+                {
+                    std::lock_guard<std::mutex> lock(g_browserOverlayCacheMutex);
+                    auto it = g_browserOverlayCache.find(frame.overlayId);
+                    if (it != g_browserOverlayCache.end() && it->second && it->second->latestQueuedDecodeSequence == frame.sequence) {
+                        entry = it->second;
+                    }
+                }
 
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        unsigned char* pixels = stbi_load_from_memory(frame.encodedBytes.data(), static_cast<int>(frame.encodedBytes.size()), &width,
-                                                      &height, &channels, 4);
+                if (entry) {
+                    UpdateBrowserOverlayBuffer(*entry, pixels, width, height);
+                }
+            }
 
-        if (!pixels || width <= 0 || height <= 0) {
             if (pixels) {
                 stbi_image_free(pixels);
             }
-            continue;
         }
 
-        std::shared_ptr<BrowserOverlayCacheEntry> entry;
         {
-            std::lock_guard<std::mutex> lock(g_browserOverlayCacheMutex);
-            auto it = g_browserOverlayCache.find(frame.overlayId);
-            if (it != g_browserOverlayCache.end() && it->second && it->second->latestQueuedDecodeSequence == frame.sequence) {
-                entry = it->second;
-            }
+            std::lock_guard<std::mutex> lock(g_browserOverlayDecodeMutex);
+            g_browserOverlayDecodingOverlays.erase(frame.overlayId);
+            ReleaseBrowserOverlayEncodedBufferLocked(std::move(frame.encodedBytes));
         }
-
-        if (entry) {
-            UpdateBrowserOverlayBuffer(*entry, pixels, width, height);
-        }
-
-        stbi_image_free(pixels);
+        // A newer frame for this overlay may have been queued while it was claimed.
+        g_browserOverlayDecodeCv.notify_all();
     }
-
-    LogBrowserOverlayMessage("[BrowserOverlay] Decode thread stopped");
 }
 
 void BrowserOverlayThreadFunc() {
@@ -1409,12 +1512,15 @@ void BrowserOverlayThreadFunc() {
 
     LogBrowserOverlayMessage("[BrowserOverlay] Thread started");
 
+    // Reconcile only when the browser overlay list itself changed or an entry was dropped from the cache, not on
+    // every unrelated config edit.
     uint64_t lastConfigVersion = UINT64_MAX;
     while (!g_stopBrowserOverlayThread.load(std::memory_order_acquire)) {
         PumpBrowserOverlayMessages();
 
-        const uint64_t currentVersion = g_configSnapshotVersion.load(std::memory_order_acquire);
-        if (currentVersion != lastConfigVersion) {
+        const uint64_t currentVersion = GetConfigSectionVersion(ConfigSection::BrowserOverlays);
+        const bool reconcileRequested = g_browserOverlayReconcileRequested.exchange(false, std::memory_order_acq_rel);
+        if (currentVersion != lastConfigVersion || reconcileRequested) {
             lastConfigVersion = currentVersion;
             ReconcileBrowserOverlays();
         }
@@ -1496,6 +1602,7 @@ void RemoveBrowserOverlayFromCache(const std::string& overlayId) {
     auto it = g_browserOverlayCache.find(overlayId);
     if (it != g_browserOverlayCache.end() && it->second) {
         it->second->markedForRemoval = true;
+        g_browserOverlayReconcileRequested.store(true, std::memory_order_release);
     }
 }
 
@@ -1533,6 +1640,7 @@ void CleanupBrowserOverlayCache() {
     {
         std::lock_guard<std::mutex> lock(g_browserOverlayDecodeMutex);
         g_browserOverlayPendingDecodeFrames.clear();
+        g_browserOverlayEncodedBufferPool.clear();
     }
 }
 
@@ -1541,8 +1649,14 @@ void StartBrowserOverlayThread() {
         g_stopBrowserOverlayThread.store(false, std::memory_order_release);
         g_browserOverlayThread = std::thread(BrowserOverlayThreadFunc);
     }
-    if (!g_browserOverlayDecodeThread.joinable()) {
-        g_browserOverlayDecodeThread = std::thread(BrowserOverlayDecodeThreadFunc);
+    if (g_browserOverlayDecodeThreads.empty()) {
+        const unsigned hardwareThreads = (std::max)(1u, std::thread::hardware_concurrency());
+        const unsigned decodeThreadCount = (std::min)(kBrowserOverlayMaxDecodeThreads, (std::max)(1u, hardwareThreads / 2));
+        g_browserOverlayDecodeThreads.reserve(decodeThreadCount);
+        for (unsigned i = 0; i < decodeThreadCount; ++i) {
+            g_browserOverlayDecodeThreads.emplace_back(BrowserOverlayDecodeThreadFunc);
+        }
+        LogBrowserOverlayMessage("[BrowserOverlay] Decode pool started with " + std::to_string(decodeThreadCount) + " thread(s)");
     }
 }
 
@@ -1552,14 +1666,22 @@ void StopBrowserOverlayThread() {
         g_browserOverlayDecodeCv.notify_all();
         g_browserOverlayThread.join();
     }
-    if (g_browserOverlayDecodeThread.joinable()) {
+    if (!g_browserOverlayDecodeThreads.empty()) {
         g_browserOverlayDecodeCv.notify_all();
-        g_browserOverlayDecodeThread.join();
+        for (std::thread& decodeThread : g_browserOverlayDecodeThreads) {
+            if (decodeThread.joinable()) {
+                decodeThread.join();
+            }
+        }
+        g_browserOverlayDecodeThreads.clear();
+        LogBrowserOverlayMessage("[BrowserOverlay] Decode pool stopped");
     }
 
     {
         std::lock_guard<std::mutex> lock(g_browserOverlayDecodeMutex);
         g_browserOverlayPendingDecodeFrames.clear();
+        g_browserOverlayDecodingOverlays.clear();
+        g_browserOverlayEncodedBufferPool.clear();
     }
 }
 
@@ -47,37 +47,37 @@ static bool g_cursorDefsInitialized = false;
 static std::mutex g_cursorDefsMutex;
 
 static void ScanCursorDefinitionsLocked() {
-    LogCategory("cursor_textures", "[CursorTextures] ScanCursorDefinitionsLocked starting...");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] ScanCursorDefinitionsLocked starting...");
 
     AVAILABLE_CURSORS = SYSTEM_CURSORS;
-    LogCategory("cursor_textures", "[CursorTextures] Loaded " + std::to_string(SYSTEM_CURSORS.size()) + " system cursor definitions");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Loaded " + std::to_string(SYSTEM_CURSORS.size()) + " system cursor definitions");
 
     int validSystemCursors = 0;
     for (const auto& cursor : SYSTEM_CURSORS) {
         if (std::filesystem::exists(cursor.path)) {
             validSystemCursors++;
         } else {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: System cursor not found: " + WideToUtf8(cursor.path));
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] WARNING: System cursor not found: " + WideToUtf8(cursor.path));
         }
     }
-    LogCategory("cursor_textures", "[CursorTextures] Verified " + std::to_string(validSystemCursors) + "/" +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Verified " + std::to_string(validSystemCursors) + "/" +
                                        std::to_string(SYSTEM_CURSORS.size()) + " system cursors exist on disk");
 
     try {
         std::wstring toolscreenPath = GetToolscreenPath();
         if (toolscreenPath.empty()) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to get toolscreen path - custom cursors will not be available");
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Failed to get toolscreen path - custom cursors will not be available");
             return;
         }
 
         std::filesystem::path cursorsPath = std::filesystem::path(toolscreenPath) / "cursors";
-        LogCategory("cursor_textures", "[CursorTextures] Scanning for custom cursors at: " + cursorsPath.string());
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] Scanning for custom cursors at: " + cursorsPath.string());
 
         if (!std::filesystem::exists(cursorsPath)) {
-            LogCategory("cursor_textures", "[CursorTextures] Custom cursors folder does not exist: " + cursorsPath.string());
-            LogCategory("cursor_textures", "[CursorTextures] To add custom cursors, create this folder and add .cur or .ico files");
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] Custom cursors folder does not exist: " + cursorsPath.string());
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] To add custom cursors, create this folder and add .cur or .ico files");
         } else if (!std::filesystem::is_directory(cursorsPath)) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Cursors path exists but is not a directory: " + cursorsPath.string());
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Cursors path exists but is not a directory: " + cursorsPath.string());
         } else {
             int customCursorsFound = 0;
             int filesSkipped = 0;
@@ -93,24 +93,24 @@ static void ScanCursorDefinitionsLocked() {
                         UINT loadType = (ext == ".ico") ? IMAGE_ICON : IMAGE_CURSOR;
 
                         AVAILABLE_CURSORS.push_back({ filename, filepath, loadType });
-                        LogCategory("cursor_textures", "[CursorTextures] Found custom cursor: " + filename + " (" + ext + ")");
+                        LOG_CATEGORY(CursorTextures, "[CursorTextures] Found custom cursor: " + filename + " (" + ext + ")");
                         customCursorsFound++;
                     } else {
                         filesSkipped++;
                     }
                 }
             }
-            LogCategory("cursor_textures", "[CursorTextures] Found " + std::to_string(customCursorsFound) + " custom cursor(s), skipped " +
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] Found " + std::to_string(customCursorsFound) + " custom cursor(s), skipped " +
                                                std::to_string(filesSkipped) + " non-cursor file(s)");
         }
     } catch (const std::filesystem::filesystem_error& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Filesystem error scanning cursors folder: " + std::string(e.what()));
-        LogCategory("cursor_textures", "[CursorTextures] Error code: " + std::to_string(e.code().value()) + " - " + e.code().message());
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Filesystem error scanning cursors folder: " + std::string(e.what()));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] Error code: " + std::to_string(e.code().value()) + " - " + e.code().message());
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Exception scanning cursors folder: " + std::string(e.what()));
-    } catch (...) { LogCategory("cursor_textures", "[CursorTextures] ERROR: Unknown exception scanning cursors folder"); }
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Exception scanning cursors folder: " + std::string(e.what()));
+    } catch (...) { LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Unknown exception scanning cursors folder"); }
 
-    LogCategory("cursor_textures", "[CursorTextures] ScanCursorDefinitionsLocked complete. Total cursors available: " +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] ScanCursorDefinitionsLocked complete. Total cursors available: " +
                                        std::to_string(AVAILABLE_CURSORS.size()));
 }
 
@@ -118,14 +118,14 @@ void InitializeCursorDefinitions() {
     std::lock_guard<std::mutex> lock(g_cursorDefsMutex);
     if (g_cursorDefsInitialized) return;
 
-    LogCategory("cursor_textures", "[CursorTextures] InitializeCursorDefinitions starting...");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] InitializeCursorDefinitions starting...");
     ScanCursorDefinitionsLocked();
     g_cursorDefsInitialized = true;
 }
 
 void RefreshCursorDefinitions() {
     std::lock_guard<std::mutex> lock(g_cursorDefsMutex);
-    LogCategory("cursor_textures", "[CursorTextures] RefreshCursorDefinitions starting...");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] RefreshCursorDefinitions starting...");
     ScanCursorDefinitionsLocked();
     g_cursorDefsInitialized = true;
 }
@@ -195,11 +195,11 @@ static const std::vector<int> STANDARD_SIZES = {
 
 static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size, CursorData& outData) {
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadSingleCursor called with empty path");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: LoadSingleCursor called with empty path");
         return false;
     }
     if (size <= 0 || size > 512) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadSingleCursor called with invalid size: " + std::to_string(size));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: LoadSingleCursor called with invalid size: " + std::to_string(size));
         return false;
     }
 
@@ -207,16 +207,16 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     try {
         if (!std::filesystem::path(path).is_absolute()) { resolvedPath = ResolveCwdPath(path); }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to resolve path: " + std::string(e.what()));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Failed to resolve path: " + std::string(e.what()));
         return false;
     }
 
     std::string pathStr = WideToUtf8(resolvedPath);
-    LogCategory("cursor_textures", "[CursorTextures] Loading cursor: " + pathStr + " at size " + std::to_string(size) +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Loading cursor: " + pathStr + " at size " + std::to_string(size) +
                                        " (type: " + (loadType == IMAGE_ICON ? "ICON" : "CURSOR") + ")");
 
     if (!std::filesystem::exists(resolvedPath)) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Cursor file does not exist: " + pathStr);
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Cursor file does not exist: " + pathStr);
         return false;
     }
 
@@ -252,7 +252,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
             errMsg = "Unknown error";
             break;
         }
-        LogCategory("cursor_textures",
+        LOG_CATEGORY(CursorTextures,
                     "[CursorTextures] ERROR: LoadImageW failed for '" + pathStr + "' - Error " + std::to_string(err) + ": " + errMsg);
         return false;
     }
@@ -267,7 +267,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
                 hCursor = hScaled;
             }
         } else {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: CopyImage failed to force size to " + std::to_string(size) +
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] WARNING: CopyImage failed to force size to " + std::to_string(size) +
                                                "px for " + pathStr + " (err=" + std::to_string(GetLastError()) + ")");
         }
     }
@@ -280,7 +280,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     if (!hasIconInfoEx) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: GetIconInfoExW failed with error " + std::to_string(err));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: GetIconInfoExW failed with error " + std::to_string(err));
         DestroyCursorOrIcon(hCursor, loadType);
         outData.hCursor = nullptr;
         return false;
@@ -288,18 +288,18 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     BITMAP bmp;
     bool isMonochrome = (iconInfoEx.hbmColor == NULL);
-    LogCategory("cursor_textures", "[CursorTextures] Cursor type: " + std::string(isMonochrome ? "monochrome" : "color"));
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Cursor type: " + std::string(isMonochrome ? "monochrome" : "color"));
 
     if (isMonochrome) {
         if (!iconInfoEx.hbmMask) {
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: Monochrome cursor has no mask bitmap");
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Monochrome cursor has no mask bitmap");
             DestroyCursorOrIcon(hCursor, loadType);
             outData.hCursor = nullptr;
             return false;
         }
         if (!GetObject(iconInfoEx.hbmMask, sizeof(BITMAP), &bmp)) {
             DWORD err = GetLastError();
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: GetObject for mask bitmap failed with error " + std::to_string(err));
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: GetObject for mask bitmap failed with error " + std::to_string(err));
             DeleteObject(iconInfoEx.hbmMask);
             DestroyCursorOrIcon(hCursor, loadType);
             outData.hCursor = nullptr;
@@ -308,7 +308,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     } else {
         if (!GetObject(iconInfoEx.hbmColor, sizeof(BITMAP), &bmp)) {
             DWORD err = GetLastError();
-            LogCategory("cursor_textures", "[CursorTextures] ERROR: GetObject for color bitmap failed with error " + std::to_string(err));
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: GetObject for color bitmap failed with error " + std::to_string(err));
             if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
             if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
             DestroyCursorOrIcon(hCursor, loadType);
@@ -321,7 +321,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     int height = isMonochrome ? bmp.bmHeight / 2 : bmp.bmHeight;
 
     if (width <= 0 || height <= 0 || width > 1024 || height > 1024) {
-        LogCategory("cursor_textures",
+        LOG_CATEGORY(CursorTextures,
                     "[CursorTextures] ERROR: Invalid bitmap dimensions: " + std::to_string(width) + "x" + std::to_string(height));
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
@@ -330,7 +330,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
         return false;
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] Bitmap size: " + std::to_string(width) + "x" + std::to_string(height) +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Bitmap size: " + std::to_string(width) + "x" + std::to_string(height) +
                                        ", hotspot: (" + std::to_string(iconInfoEx.xHotspot) + ", " + std::to_string(iconInfoEx.yHotspot) +
                                        ")");
 
@@ -342,7 +342,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     HDC hdcScreen = GetDC(NULL);
     if (!hdcScreen) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: GetDC(NULL) failed with error " + std::to_string(err));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: GetDC(NULL) failed with error " + std::to_string(err));
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
         DestroyCursorOrIcon(hCursor, loadType);
@@ -353,7 +353,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
     HDC hdcMem = CreateCompatibleDC(hdcScreen);
     if (!hdcMem) {
         DWORD err = GetLastError();
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: CreateCompatibleDC failed with error " + std::to_string(err));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: CreateCompatibleDC failed with error " + std::to_string(err));
         ReleaseDC(NULL, hdcScreen);
         if (iconInfoEx.hbmMask) DeleteObject(iconInfoEx.hbmMask);
         if (iconInfoEx.hbmColor) DeleteObject(iconInfoEx.hbmColor);
@@ -441,7 +441,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
             glGenTextures(1, &outData.invertMaskTexture);
             if (outData.invertMaskTexture == 0) {
-                LogCategory("cursor_textures", "[CursorTextures] WARNING: Failed to create invert mask texture - glGenTextures returned 0");
+                LOG_CATEGORY(CursorTextures, "[CursorTextures] WARNING: Failed to create invert mask texture - glGenTextures returned 0");
                 outData.hasInvertedPixels = false;
             } else {
                 BindTextureDirect(GL_TEXTURE_2D, outData.invertMaskTexture);
@@ -453,13 +453,13 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
                 GLenum glErr = glGetError();
                 if (glErr != GL_NO_ERROR) {
-                    LogCategory("cursor_textures",
+                    LOG_CATEGORY(CursorTextures,
                                 "[CursorTextures] WARNING: OpenGL error creating invert mask texture: " + std::to_string(glErr));
                     glDeleteTextures(1, &outData.invertMaskTexture);
                     outData.invertMaskTexture = 0;
                     outData.hasInvertedPixels = false;
                 } else {
-                    LogCategory("cursor_textures",
+                    LOG_CATEGORY(CursorTextures,
                                 "[CursorTextures] Created invert mask texture ID " + std::to_string(outData.invertMaskTexture));
                 }
                 BindTextureDirect(GL_TEXTURE_2D, 0);
@@ -514,7 +514,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     glGenTextures(1, &outData.texture);
     if (outData.texture == 0) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: glGenTextures returned 0 - OpenGL context may not be valid");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: glGenTextures returned 0 - OpenGL context may not be valid");
         DestroyCursorOrIcon(outData.hCursor, outData.loadType);
         outData.hCursor = nullptr;
         return false;
@@ -547,7 +547,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
             errStr = "Unknown (" + std::to_string(err) + ")";
             break;
         }
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: OpenGL error during texture creation: " + errStr);
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: OpenGL error during texture creation: " + errStr);
         glDeleteTextures(1, &outData.texture);
         outData.texture = 0;
         if (outData.invertMaskTexture) {
@@ -561,7 +561,7 @@ static bool LoadSingleCursor(const std::wstring& path, UINT loadType, int size,
 
     BindTextureDirect(GL_TEXTURE_2D, 0);
 
-    LogCategory("cursor_textures", "[CursorTextures] Successfully created texture ID " + std::to_string(outData.texture) + " (" +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Successfully created texture ID " + std::to_string(outData.texture) + " (" +
                                        std::to_string(width) + "x" + std::to_string(height) + ") for " + WideToUtf8(path));
     return true;
 }
@@ -577,7 +577,7 @@ void LoadCursorTextures() {
         cursorDefs = AVAILABLE_CURSORS;
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] LoadCursorTextures called - loading initial cursors at default size (64px)");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] LoadCursorTextures called - loading initial cursors at default size (64px)");
 
     int totalLoaded = 0;
     const int defaultSize = 64;
@@ -586,16 +586,16 @@ void LoadCursorTextures() {
         CursorData cursorData;
         if (LoadSingleCursor(cursorDef.path, cursorDef.loadType, defaultSize, cursorData)) {
             g_cursorList.push_back(cursorData);
-            LogCategory("cursor_textures",
+            LOG_CATEGORY(CursorTextures,
                         "[CursorTextures] Loaded " + WideToUtf8(cursorDef.path) + " at size " + std::to_string(defaultSize));
             totalLoaded++;
         } else {
-            LogCategory("cursor_textures",
+            LOG_CATEGORY(CursorTextures,
                         "[CursorTextures] Failed to load " + WideToUtf8(cursorDef.path) + " at size " + std::to_string(defaultSize));
         }
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] Finished loading " + std::to_string(totalLoaded) + " default cursor variants");
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Finished loading " + std::to_string(totalLoaded) + " default cursor variants");
 }
 
 // NOTE: Caller must NOT hold g_cursorListMutex when calling this function
@@ -603,7 +603,7 @@ const CursorData* LoadOrFindCursor(const std::wstring& path, UINT loadType, int
     std::string pathStr = WideToUtf8(path);
 
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: LoadOrFindCursor called with empty path");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: LoadOrFindCursor called with empty path");
         return nullptr;
     }
 
@@ -616,23 +616,23 @@ const CursorData* LoadOrFindCursor(const std::wstring& path, UINT loadType, int
         }
     }
 
-    LogCategory("cursor_textures", "[CursorTextures] Loading cursor on-demand: " + pathStr + " at size " + std::to_string(size));
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Loading cursor on-demand: " + pathStr + " at size " + std::to_string(size));
     CursorData newCursorData;
     if (LoadSingleCursor(path, loadType, size, newCursorData)) {
         std::lock_guard<std::mutex> lock(g_cursorListMutex);
         g_cursorList.push_back(newCursorData);
-        LogCategory("cursor_textures",
+        LOG_CATEGORY(CursorTextures,
                     "[CursorTextures] Successfully loaded on-demand cursor. Total loaded: " + std::to_string(g_cursorList.size()));
         return &g_cursorList.back();
     } else {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: Failed to load cursor on-demand: " + pathStr);
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: Failed to load cursor on-demand: " + pathStr);
         return nullptr;
     }
 }
 
 const CursorData* FindCursor(const std::wstring& path, int size) {
     if (path.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: FindCursor called with empty path");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: FindCursor called with empty path");
         return nullptr;
     }
 
@@ -651,10 +651,10 @@ const CursorData* FindCursor(const std::wstring& path, int size) {
         if (ext == ".ico") {
             loadType = IMAGE_ICON;
         } else if (ext != ".cur" && ext != ".ani") {
-            LogCategory("cursor_textures", "[CursorTextures] WARNING: Unexpected cursor file extension: " + ext + ", treating as cursor");
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] WARNING: Unexpected cursor file extension: " + ext + ", treating as cursor");
         }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures",
+        LOG_CATEGORY(CursorTextures,
                     "[CursorTextures] WARNING: Failed to parse path extension: " + std::string(e.what()) + ", defaulting to IMAGE_CURSOR");
     }
 
@@ -989,20 +989,20 @@ bool GetCursorPathByName(const std::string& cursorName, std::wstring& outPath, U
         outLoadType = selectedDef->loadType;
         return true;
     } else {
-        LogCategory("cursor_textures", "[CursorTextures] WARNING: Unknown cursor name '" + cursorName + "'");
-        LogCategory("cursor_textures", "[CursorTextures] Available cursors: " + std::to_string(AVAILABLE_CURSORS.size()));
-        for (const auto& def : AVAILABLE_CURSORS) { LogCategory("cursor_textures", "[CursorTextures]   - " + def.name); }
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] WARNING: Unknown cursor name '" + cursorName + "'");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] Available cursors: " + std::to_string(AVAILABLE_CURSORS.size()));
+        for (const auto& def : AVAILABLE_CURSORS) { LOG_CATEGORY(CursorTextures, "[CursorTextures]   - " + def.name); }
 
         if (!AVAILABLE_CURSORS.empty()) {
             outPath = AVAILABLE_CURSORS[0].path;
             outLoadType = AVAILABLE_CURSORS[0].loadType;
-            LogCategory("cursor_textures", "[CursorTextures] Using first available cursor as fallback: " + AVAILABLE_CURSORS[0].name);
+            LOG_CATEGORY(CursorTextures, "[CursorTextures] Using first available cursor as fallback: " + AVAILABLE_CURSORS[0].name);
             return false;
         }
 
         outPath = L"";
         outLoadType = IMAGE_CURSOR;
-        LogCategory("cursor_textures", "[CursorTextures] ERROR: No cursors available for fallback");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] ERROR: No cursors available for fallback");
         return false;
     }
 }
@@ -1013,7 +1013,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     std::lock_guard<std::mutex> lock(g_cursorDefsMutex);
 
     if (cursorName.empty()) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Empty cursor name provided");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] IsCursorFileValid: Empty cursor name provided");
         return false;
     }
 
@@ -1026,7 +1026,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
     }
 
     if (!selectedDef) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Cursor '" + cursorName + "' not found in definitions");
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] IsCursorFileValid: Cursor '" + cursorName + "' not found in definitions");
         return false;
     }
 
@@ -1034,14 +1034,14 @@ bool IsCursorFileValid(const std::string& cursorName) {
     try {
         if (!std::filesystem::path(selectedDef->path).is_absolute()) { resolvedPath = ResolveCwdPath(selectedDef->path); }
     } catch (const std::exception& e) {
-        LogCategory("cursor_textures",
+        LOG_CATEGORY(CursorTextures,
                     "[CursorTextures] IsCursorFileValid: Failed to resolve path for '" + cursorName + "': " + std::string(e.what()));
         return false;
     }
 
     bool exists = std::filesystem::exists(resolvedPath);
     if (!exists) {
-        LogCategory("cursor_textures", "[CursorTextures] IsCursorFileValid: Cursor file does not exist: " + WideToUtf8(resolvedPath));
+        LOG_CATEGORY(CursorTextures, "[CursorTextures] IsCursorFileValid: Cursor file does not exist: " + WideToUtf8(resolvedPath));
     }
     return exists;
 }
@@ -1049,7 +1049,7 @@ bool IsCursorFileValid(const std::string& cursorName) {
 void Cleanup() {
     std::lock_guard<std::mutex> lock(g_cursorListMutex);
 
-    LogCategory("cursor_textures",
+    LOG_CATEGORY(CursorTextures,
                 "[CursorTextures] Cleanup: Starting cleanup of " + std::to_string(g_cursorList.size()) + " cursor entries");
 
     int texturesDeleted = 0;
@@ -1077,7 +1077,7 @@ void Cleanup() {
     }
 
     g_cursorList.clear();
-    LogCategory("cursor_textures", "[CursorTextures] Cleanup complete: " + std::to_string(texturesDeleted) + " textures, " +
+    LOG_CATEGORY(CursorTextures, "[CursorTextures] Cleanup complete: " + std::to_string(texturesDeleted) + " textures, " +
                                        std::to_string(invertMasksDeleted) + " invert masks, " + std::to_string(cursorsDestroyed) +
                                        " cursor handles");
 }
@@ -0,0 +1,174 @@
+#include "features/game_state_watcher.h"
+
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace game_state_source {
+namespace {
+
+constexpr size_t kMaxStateFileSize = 65536;
+// Polling fallback period, the old monitor loop's.
+constexpr std::chrono::milliseconds kPollingFallbackInterval(8);
+// After a read that could not be parsed (typically caught mid-write) retry at the old polling cadence rather than
+// waiting for a notification that may already have been consumed.
+constexpr std::chrono::milliseconds kRetryAfterPartialReadMs(8);
+
+// Reads a small file into out, reusing its allocation. Opened with full sharing so the game can keep writing it.
+bool ReadSmallFile(const std::filesystem::path& path, std::string& out, size_t maxSize) {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) { return false; }
+    LARGE_INTEGER size{};
+    bool ok = GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<unsigned long long>(size.QuadPart) < maxSize;
+    if (ok) {
+        out.resize(static_cast<size_t>(size.QuadPart));
+        DWORD bytesRead = 0;
+        ok = ReadFile(file, out.data(), static_cast<DWORD>(out.size()), &bytesRead, NULL) && bytesRead == out.size();
+    }
+    CloseHandle(file);
+    return ok;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) { return false; }
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    if (size <= 0 || static_cast<size_t>(size) >= maxSize) { return false; }
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<size_t>(size));
+    return static_cast<bool>(in.read(out.data(), size));
+#endif
+}
+
+long long NowEpochMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool IsHermesAlive(const std::filesystem::path& alivePath, uint64_t processId) {
+    if (alivePath.empty()) { return false; }
+    std::string bytes;
+    if (!ReadSmallFile(alivePath, bytes, kMaxStateFileSize) || bytes.size() < 16) { return false; }
+    return EvaluateHermesAlive(reinterpret_cast<const unsigned char*>(bytes.data()), processId, NowEpochMillis());
+}
+
+bool RegularFileExists(const std::filesystem::path& path) {
+    if (path.empty()) { return false; }
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+}  // namespace
+
+std::unique_ptr<file_watch::DirectoryWatcher> CreateGameStateWatcher(const std::vector<std::filesystem::path>& files) {
+    return file_watch::CreateDirectoryWatcher(files, kPollingFallbackInterval);
+}
+
+GameStateMonitor::GameStateMonitor(GameStateMonitorPaths paths, GameStateMonitorOptions options)
+    : m_paths(std::move(paths)), m_options(std::move(options)) {
+    m_readBuffer.reserve(512);
+    m_lastContent.reserve(512);
+}
+
+std::optional<std::string> GameStateMonitor::WaitAndUpdate(std::chrono::milliseconds timeout) {
+    if (!m_watcher) {
+        RefreshSource();
+        RebuildWatcherIfDirectoriesChanged();
+        m_nextSourceCheck = std::chrono::steady_clock::now() + m_options.sourceCheckInterval;
+        return m_activeSource != GameStateSourceKind::None ? ReadActiveState() : std::nullopt;
+    }
+
+    bool changed = false;
+    if (!m_wakePending.exchange(false, std::memory_order_acq_rel)) {
+        const auto now = std::chrono::steady_clock::now();
+        // Rounded up so the last fraction of a millisecond before a source check is not spent in zero-length waits.
+        auto wait = (std::min)(timeout, std::chrono::ceil<std::chrono::milliseconds>(
+                                            (std::max)(m_nextSourceCheck - now, std::chrono::steady_clock::duration::zero())));
+        if (m_needsRead) { wait = (std::min)(wait, kRetryAfterPartialReadMs); }
+        changed = m_watcher->WaitForChange(wait);
+        m_wakePending.store(false, std::memory_order_release);
+        ++m_wakeups;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool sourceCheckDue = now >= m_nextSourceCheck || (changed && m_activeSource == GameStateSourceKind::None);
+    if (sourceCheckDue) {
+        m_nextSourceCheck = now + m_options.sourceCheckInterval;
+        RefreshSource();
+        RebuildWatcherIfDirectoriesChanged();
+        // Periodic re-read as a safety net for notifications that were coalesced away; unchanged bytes are not parsed.
+        m_needsRead = true;
+    }
+
+    if (m_activeSource == GameStateSourceKind::None || !(changed || m_needsRead)) { return std::nullopt; }
+    return ReadActiveState();
+}
+
+void GameStateMonitor::Wake() {
+    m_wakePending.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_watcherMutex);
+    if (m_watcher) { m_watcher->Wake(); }
+}
+
+bool GameStateMonitor::IsEventDriven() const {
+    std::lock_guard<std::mutex> lock(m_watcherMutex);
+    return m_watcher && m_watcher->IsEventDriven();
+}
+
+void GameStateMonitor::RefreshSource() {
+    const bool hermesAlive = IsHermesAlive(m_paths.hermesAlive, m_options.processId);
+    const bool stateOutputAvailable = RegularFileExists(m_paths.stateOutput);
+    const GameStateSourceKind source = Select(hermesAlive, stateOutputAvailable);
+    if (source != m_activeSource) {
+        m_activeSource = source;
+        m_haveLastContent = false;
+        m_needsRead = true;
+    }
+}
+
+void GameStateMonitor::RebuildWatcherIfDirectoriesChanged() {
+    const std::vector<std::filesystem::path> files = { m_paths.hermesState, m_paths.hermesAlive, m_paths.stateOutput };
+    std::vector<std::filesystem::path> directories = file_watch::ExistingParentDirectories(files);
+    if (m_watcher && directories == m_watchedDirectories) { return; }
+
+    // Also covers the Hermes directory appearing after startup: its creation is seen in the instance directory,
+    // and from then on it is watched directly.
+    std::unique_ptr<file_watch::DirectoryWatcher> watcher = m_options.createWatcher(files);
+    if (!watcher) { watcher = file_watch::CreatePollingDirectoryWatcher(files, kPollingFallbackInterval); }
+
+    std::lock_guard<std::mutex> lock(m_watcherMutex);
+    m_watcher = std::move(watcher);
+    m_watchedDirectories = std::move(directories);
+}
+
+std::optional<std::string> GameStateMonitor::ReadActiveState() {
+    const std::filesystem::path& path = (m_activeSource == GameStateSourceKind::Hermes) ? m_paths.hermesState : m_paths.stateOutput;
+    if (!ReadSmallFile(path, m_readBuffer, kMaxStateFileSize)) {
+        m_needsRead = true;
+        return std::nullopt;
+    }
+    if (m_haveLastContent && m_readBuffer == m_lastContent) {
+        m_needsRead = false;
+        return std::nullopt;
+    }
+
+    std::optional<std::string> state = (m_activeSource == GameStateSourceKind::Hermes) ? DeriveStateFromHermesJson(m_readBuffer)
+                                                                                       : DeriveStateFromStateOutputText(m_readBuffer);
+    if (!state) {
+        m_needsRead = true;
+        return std::nullopt;
+    }
+
+    m_lastContent.swap(m_readBuffer);
+    m_haveLastContent = true;
+    m_needsRead = false;
+    if (m_lastState == state) { return std::nullopt; }
+    m_lastState = state;
+    return state;
+}
+
+}  // namespace game_state_source
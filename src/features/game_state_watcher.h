@@ -0,0 +1,80 @@
+#pragma once
+
+#include "common/directory_watcher.h"
+#include "features/game_state_source.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace game_state_source {
+
+// Directory watcher over the game state files, or one polling them every 8 ms when notifications are unavailable.
+std::unique_ptr<file_watch::DirectoryWatcher> CreateGameStateWatcher(const std::vector<std::filesystem::path>& files);
+
+struct GameStateMonitorPaths {
+    std::filesystem::path hermesState;
+    std::filesystem::path hermesAlive;
+    std::filesystem::path stateOutput;
+};
+
+struct GameStateMonitorOptions {
+    // Compared against the pid in Hermes' alive file.
+    uint64_t processId = 0;
+    // Hermes liveness and state output availability are re-evaluated this often even without notifications, which
+    // also bounds how long a missed notification can delay a state change.
+    std::chrono::milliseconds sourceCheckInterval{ 1000 };
+    std::function<std::unique_ptr<file_watch::DirectoryWatcher>(const std::vector<std::filesystem::path>&)> createWatcher = CreateGameStateWatcher;
+};
+
+// Tracks the active game state source (Hermes or State Output) and the state it reports. Sleeps in the watcher between
+// changes instead of polling, so an idle instance wakes about once per source check interval.
+class GameStateMonitor {
+  public:
+    explicit GameStateMonitor(GameStateMonitorPaths paths, GameStateMonitorOptions options = {});
+
+    // Waits for a change, the next source check or timeout, then re-reads the active source if needed.
+    // Returns the derived state when it differs from the last one returned.
+    std::optional<std::string> WaitAndUpdate(std::chrono::milliseconds timeout);
+
+    // Makes a blocked WaitAndUpdate() return early. Safe to call from any thread.
+    void Wake();
+
+    GameStateSourceKind ActiveSource() const { return m_activeSource; }
+    bool IsEventDriven() const;
+    // Times WaitAndUpdate() returned from its wait, for measuring idle wakeups.
+    uint64_t WakeupCount() const { return m_wakeups; }
+
+  private:
+    void RefreshSource();
+    void RebuildWatcherIfDirectoriesChanged();
+    std::optional<std::string> ReadActiveState();
+
+    GameStateMonitorPaths m_paths;
+    GameStateMonitorOptions m_options;
+
+    mutable std::mutex m_watcherMutex;
+    std::unique_ptr<file_watch::DirectoryWatcher> m_watcher;
+    std::vector<std::filesystem::path> m_watchedDirectories;
+    std::atomic<bool> m_wakePending{ false };
+
+    GameStateSourceKind m_activeSource = GameStateSourceKind::None;
+    std::chrono::steady_clock::time_point m_nextSourceCheck{};
+    bool m_needsRead = false;
+
+    // Reused across reads; the state file is only parsed when its bytes differ from the last parsed content.
+    std::string m_readBuffer;
+    std::string m_lastContent;
+    bool m_haveLastContent = false;
+    std::optional<std::string> m_lastState;
+    uint64_t m_wakeups = 0;
+};
+
+}  // namespace game_state_source
@@ -35,7 +35,7 @@ bool IsNinjabrainOverlayEnabled() {
 }
 
 void LogNinjabrainMessage(const std::string& message) {
-    LogCategory("ninjabrain", message);
+    LOG_CATEGORY(Ninjabrain, message);
 }
 
 std::string ResolveApiBaseUrl() {
@@ -1,4 +1,5 @@
 #include "virtual_camera.h"
+#include "common/nv12_convert.h"
 #include "common/utils.h"
 #include "render/render.h"
 
@@ -78,20 +79,8 @@ static VirtualCameraState g_vcState;
 static void ForceVirtualCameraCaptureFrames(int frameCount);
 
 
-// Helper to clamp int to byte range (avoids Windows min/max macro conflict)
-static inline uint8_t clampToByte(int32_t val) {
-    if (val < 0) return 0;
-    if (val > 255) return 255;
-    return static_cast<uint8_t>(val);
-}
-
-enum class VirtualCameraColorSpaceMode {
-    Bt601,
-    Bt709,
-};
-
-static VirtualCameraColorSpaceMode GetVirtualCameraColorSpaceMode(uint32_t width, uint32_t height) {
-    return (width >= 1280 || height > 576) ? VirtualCameraColorSpaceMode::Bt709 : VirtualCameraColorSpaceMode::Bt601;
+static Nv12ColorMatrix GetVirtualCameraColorMatrix(uint32_t width, uint32_t height) {
+    return (width >= 1280 || height > 576) ? Nv12ColorMatrix::Bt709 : Nv12ColorMatrix::Bt601;
 }
 
 static int GetVirtualCameraTargetFps() {
@@ -236,10 +225,10 @@ static void ForceVirtualCameraCaptureFrames(int frameCount) {
 static void FillVirtualCameraFrameBlack(uint8_t* frameData, uint32_t width, uint32_t height, uint32_t frameCapacityBytes) {
     if (!frameData || width < 2 || height < 2) { return; }
 
-    const uint32_t yPlaneSize = width * height;
-    const uint32_t uvPlaneSize = yPlaneSize / 2;
-    const uint32_t requiredFrameBytes = yPlaneSize + uvPlaneSize;
+    const size_t yPlaneSize = static_cast<size_t>(width) * height;
+    const size_t requiredFrameBytes = GetNv12FrameBytes(width, height);
     if (requiredFrameBytes > frameCapacityBytes) { return; }
+    const size_t uvPlaneSize = requiredFrameBytes - yPlaneSize;
 
     memset(frameData, 0, frameCapacityBytes);
     memset(frameData, 16, yPlaneSize);
@@ -249,7 +238,7 @@ static void FillVirtualCameraFrameBlack(uint8_t* frameData, uint32_t width, uint
 static void PublishBlankVirtualCameraFrameLocked(uint32_t width, uint32_t height) {
     if (!g_vcState.active || !g_vcState.header || width < 2 || height < 2) { return; }
 
-    const uint32_t requiredFrameBytes = width * height * 3 / 2;
+    const size_t requiredFrameBytes = GetNv12FrameBytes(width, height);
     if (requiredFrameBytes > g_vcState.frameCapacityBytes) { return; }
 
     if (g_vcState.frame[0]) {
@@ -270,7 +259,7 @@ static void PublishBlankVirtualCameraFrameLocked(uint32_t width, uint32_t height
 static bool ResetVirtualCameraStateLocked(uint32_t width, uint32_t height, const char* reason) {
     if (!g_vcState.active || !g_vcState.header || width < 2 || height < 2) { return false; }
 
-    const uint32_t requiredFrameBytes = width * height * 3 / 2;
+    const size_t requiredFrameBytes = GetNv12FrameBytes(width, height);
     if (requiredFrameBytes > g_vcState.frameCapacityBytes) { return false; }
 
     g_vcState.width = width;
@@ -298,62 +287,6 @@ static bool ResetVirtualCameraStateLocked(uint32_t width, uint32_t height, const
     return true;
 }
 
-// Single pass: computes Y for every pixel and UV for every 2x2 block simultaneously
-static void ConvertRGBAtoNV12(const uint8_t* __restrict rgba, uint8_t* __restrict nv12, uint32_t width, uint32_t height) {
-    const uint32_t yPlaneSize = width * height;
-    uint8_t* __restrict yPlane = nv12;
-    uint8_t* __restrict uvPlane = nv12 + yPlaneSize;
-    const uint32_t stride = width * 4;
-    const VirtualCameraColorSpaceMode colorSpaceMode = GetVirtualCameraColorSpaceMode(width, height);
-
-    const int32_t yR = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? 47 : 66;
-    const int32_t yG = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? 157 : 129;
-    const int32_t yB = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? 16 : 25;
-    const int32_t uR = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? -26 : -38;
-    const int32_t uG = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? -87 : -74;
-    const int32_t uB = 112;
-    const int32_t vR = 112;
-    const int32_t vG = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? -102 : -94;
-    const int32_t vB = colorSpaceMode == VirtualCameraColorSpaceMode::Bt709 ? -10 : -18;
-
-    for (uint32_t y = 0; y < height; y += 2) {
-        const uint8_t* __restrict srcRow0 = rgba + (height - 1 - y) * stride;
-        const uint8_t* __restrict srcRow1 = rgba + (height - 2 - y) * stride;
-        uint8_t* __restrict yRow0 = yPlane + y * width;
-        uint8_t* __restrict yRow1 = yPlane + (y + 1) * width;
-        uint8_t* __restrict uvRow = uvPlane + (y / 2) * width;
-
-        for (uint32_t x = 0; x < width; x += 2) {
-            // Load 2x2 block of RGBA pixels
-            const uint8_t* p00 = srcRow0 + x * 4;
-            const uint8_t* p10 = srcRow0 + (x + 1) * 4;
-            const uint8_t* p01 = srcRow1 + x * 4;
-            const uint8_t* p11 = srcRow1 + (x + 1) * 4;
-
-            int32_t y00 = ((yR * p00[0] + yG * p00[1] + yB * p00[2] + 128) >> 8) + 16;
-            int32_t y10 = ((yR * p10[0] + yG * p10[1] + yB * p10[2] + 128) >> 8) + 16;
-            int32_t y01 = ((yR * p01[0] + yG * p01[1] + yB * p01[2] + 128) >> 8) + 16;
-            int32_t y11 = ((yR * p11[0] + yG * p11[1] + yB * p11[2] + 128) >> 8) + 16;
-
-            yRow0[x] = clampToByte(y00);
-            yRow0[x + 1] = clampToByte(y10);
-            yRow1[x] = clampToByte(y01);
-            yRow1[x + 1] = clampToByte(y11);
-
-            // Average RGB of 2x2 block for chroma (shift right by 2 = divide by 4)
-            int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
-            int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
-            int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
-
-            int32_t u = ((uR * avgR + uG * avgG + uB * avgB + 128) >> 8) + 128;
-            int32_t v = ((vR * avgR + vG * avgG + vB * avgB + 128) >> 8) + 128;
-
-            uvRow[x] = clampToByte(u);
-            uvRow[x + 1] = clampToByte(v);
-        }
-    }
-}
-
 bool IsVirtualCameraDriverInstalled() {
     HKEY hKey;
     LONG result = RegOpenKeyExA(HKEY_CLASSES_ROOT, "CLSID\\{A3FCE0F5-3493-419F-958A-ABA1250EC20B}", 0, KEY_READ, &hKey);
@@ -458,7 +391,8 @@ bool StartVirtualCamera(uint32_t width, uint32_t height) {
     uint32_t allocHeight = 0;
     ResolveVirtualCameraAllocationSize(width, height, allocWidth, allocHeight);
 
-    uint32_t frameSize = allocWidth * allocHeight * 3 / 2;
+    // Odd sizes round the chroma plane up, so the frame is slightly larger than width * height * 3 / 2.
+    uint32_t frameSize = static_cast<uint32_t>(GetNv12FrameBytes(allocWidth, allocHeight));
     uint32_t offset_frame[3];
     uint32_t totalSize;
 
@@ -525,7 +459,7 @@ bool StartVirtualCamera(uint32_t width, uint32_t height) {
     ForceVirtualCameraCaptureFrames(kVirtualCameraForcedFramesAfterReinit);
 
     Log("Virtual Camera: Started at " + std::to_string(width) + "x" + std::to_string(height) + " @ " + std::to_string(targetFps) +
-        "fps");
+        "fps (" + GetSimdLevelName(GetBestSimdLevel()) + " NV12 conversion)");
     return true;
 }
 
@@ -658,7 +592,7 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
     uint32_t idx = writeIdx % 3;
     uint8_t* dst = g_vcState.frame[idx];
 
-    ConvertRGBAtoNV12(rgba_data, dst, width, height);
+    ConvertRgbaToNv12(rgba_data, dst, width, height, GetVirtualCameraColorMatrix(width, height));
 
     *g_vcState.ts[idx] = timestamp;
 
@@ -673,7 +607,7 @@ bool WriteVirtualCameraFrame(const uint8_t* rgba_data, uint32_t width, uint32_t
 
     static int frameCount = 0;
     if (frameCount < 3) {
-        uint32_t frameSize = width * height * 3 / 2;
+        const size_t frameSize = GetNv12FrameBytes(width, height);
         Log("Virtual Camera: Wrote frame " + std::to_string(frameCount) + " at idx " + std::to_string(idx) +
             " ts=" + std::to_string(timestamp) + " size=" + std::to_string(frameSize));
         frameCount++;
@@ -504,39 +504,16 @@ bool CaptureWindowContent(WindowOverlayCacheEntry& entry, const WindowOverlayCon
     int scanlines = GetDIBits(hdcScreen, hBitmap, 0, captureHeight, entry.pixelData, &bmi, DIB_RGB_COLORS);
 
     if (scanlines == captureHeight) {
-        const int totalPixels = captureWidth * captureHeight;
+        const size_t totalPixels = static_cast<size_t>(captureWidth) * static_cast<size_t>(captureHeight);
 
         if (result && config.enableColorKey && !config.colorKeys.empty()) {
-            for (int i = 0; i < totalPixels; i++) {
-                unsigned char* pixel = &entry.pixelData[i * 4];
-                std::swap(pixel[0], pixel[2]);
-
-                float r = pixel[0] / 255.0f;
-                float g = pixel[1] / 255.0f;
-                float b = pixel[2] / 255.0f;
-
-                bool matchesAnyKey = false;
-                for (const auto& key : config.colorKeys) {
-                    float dr = r - key.color.r;
-                    float dg = g - key.color.g;
-                    float db = b - key.color.b;
-                    float distanceSq = dr * dr + dg * dg + db * db;
-                    float sensitivitySq = key.sensitivity * key.sensitivity;
-
-                    if (distanceSq <= sensitivitySq) {
-                        matchesAnyKey = true;
-                        break;
-                    }
-                }
-
-                pixel[3] = matchesAnyKey ? 0 : 255;
+            entry.colorKeyMatcher.Clear();
+            for (const auto& key : config.colorKeys) {
+                entry.colorKeyMatcher.AddKey(key.color.r, key.color.g, key.color.b, key.sensitivity);
             }
+            ConvertBgraToRgbaColorKeyed(entry.pixelData, totalPixels, entry.colorKeyMatcher);
         } else {
-            for (int i = 0; i < totalPixels; i++) {
-                unsigned char* pixel = &entry.pixelData[i * 4];
-                std::swap(pixel[0], pixel[2]);
-                pixel[3] = 255;
-            }
+            ConvertBgraToRgbaOpaque(entry.pixelData, totalPixels);
         }
 
         success = true;
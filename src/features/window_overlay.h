@@ -4,6 +4,7 @@
 #define NOMINMAX
 #endif
 #include "gui/gui.h"
+#include "common/pixel_ops.h"
 #include "common/utils.h"
 #include <atomic>
 #include <chrono>
@@ -69,6 +70,7 @@ struct WindowOverlayCacheEntry {
     unsigned char* pixelData = nullptr;
     int width = 0;
     int height = 0;
+    ColorKeyMatcher colorKeyMatcher;
 
     // Triple-buffered render data for lock-free rendering
     // Capture thread writes to writeBuffer, then swaps with readyBuffer
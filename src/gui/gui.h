@@ -26,6 +26,8 @@ typedef unsigned int GLuint;
 
 struct Color {
     float r = 0.0f, g = 0.0f, b = 0.0f, a = 1.0f;
+
+    bool operator==(const Color&) const = default;
 };
 
 struct DecodedImageData {
@@ -40,6 +42,8 @@ struct DecodedImageData {
     int frameCount = 0;
     int frameHeight = 0;
     std::vector<int> frameDelays;
+    // Set instead of data for videos too large for the cache budget; frames are decoded on demand.
+    std::shared_ptr<MpegVideoStream> videoStream;
 };
 
 void ParseColorString(const std::string& input, Color& outColor);
@@ -161,6 +165,8 @@ enum class GradientAnimationType {
 struct GradientColorStop {
     Color color = { 0.0f, 0.0f, 0.0f };
     float position = 0.0f;
+
+    bool operator==(const GradientColorStop&) const = default;
 };
 
 struct GradientConfig {
@@ -173,6 +179,8 @@ struct GradientConfig {
     GradientAnimationType gradientAnimation = GradientAnimationType::None;
     float gradientAnimationSpeed = 1.0f;
     bool gradientColorFade = false;
+
+    bool operator==(const GradientConfig&) const = default;
 };
 
 struct BackgroundConfig {
@@ -190,11 +198,15 @@ struct BackgroundConfig {
     GradientAnimationType gradientAnimation = GradientAnimationType::None;
     float gradientAnimationSpeed = 1.0f;
     bool gradientColorFade = false;
+
+    bool operator==(const BackgroundConfig&) const = default;
 };
 
 struct MirrorCaptureConfig {
     int x = 0, y = 0;
     std::string relativeTo = "topLeftScreen";
+
+    bool operator==(const MirrorCaptureConfig&) const = default;
 };
 struct MirrorRenderConfig {
     int x = 0, y = 0;
@@ -206,10 +218,14 @@ struct MirrorRenderConfig {
     float scaleX = 1.0f;
     float scaleY = 1.0f;
     std::string relativeTo = "topLeftScreen";
+
+    bool operator==(const MirrorRenderConfig&) const = default;
 };
 struct MirrorColors {
     std::vector<Color> targetColors;
     Color output, border;
+
+    bool operator==(const MirrorColors&) const = default;
 };
 
 enum class MirrorGammaMode {
@@ -241,6 +257,8 @@ struct MirrorBorderConfig {
     int staticOffsetY = 0;
     int staticWidth = 0;
     int staticHeight = 0;
+
+    bool operator==(const MirrorBorderConfig&) const = default;
 };
 
 struct MirrorConfig {
@@ -261,6 +279,8 @@ struct MirrorConfig {
     bool onlyOnMyScreen = false;
     bool runtimeGrouped = false;
     std::string runtimeGroupName;
+
+    bool operator==(const MirrorConfig&) const = default;
 };
 struct MirrorGroupItem {
     std::string mirrorId;
@@ -269,30 +289,42 @@ struct MirrorGroupItem {
     float heightPercent = 1.0f;
     int offsetX = 0;
     int offsetY = 0;
+
+    bool operator==(const MirrorGroupItem&) const = default;
 };
 struct MirrorGroupConfig {
     std::string name;
     MirrorRenderConfig output;
     std::vector<MirrorGroupItem> mirrors;
+
+    bool operator==(const MirrorGroupConfig&) const = default;
 };
 struct ImageBackgroundConfig {
     bool enabled = false;
     Color color = { 0.0f, 0.0f, 0.0f };
     float opacity = 1.0f;
+
+    bool operator==(const ImageBackgroundConfig&) const = default;
 };
 struct StretchConfig {
     bool enabled = false;
     int width = 0, height = 0, x = 0, y = 0;
+
+    bool operator==(const StretchConfig&) const = default;
 };
 struct BorderConfig {
     bool enabled = false;
     Color color = { 1.0f, 1.0f, 1.0f };
     int width = 4;
     int radius = 0;
+
+    bool operator==(const BorderConfig&) const = default;
 };
 struct ColorKeyConfig {
     Color color;
     float sensitivity = 0.05f;
+
+    bool operator==(const ColorKeyConfig&) const = default;
 };
 struct ImageConfig {
     std::string name;
@@ -315,6 +347,8 @@ struct ImageConfig {
     bool pixelatedScaling = false;
     bool onlyOnMyScreen = false;
     BorderConfig border;
+
+    bool operator==(const ImageConfig&) const = default;
 };
 struct WindowOverlayConfig {
     std::string name;
@@ -345,6 +379,8 @@ struct WindowOverlayConfig {
     bool forceUpdate = false;
     bool enableInteraction = false;
     BorderConfig border;
+
+    bool operator==(const WindowOverlayConfig&) const = default;
 };
 struct BrowserOverlayConfig {
     std::string name;
@@ -372,6 +408,8 @@ struct BrowserOverlayConfig {
     bool reloadOnUpdate = false;
     int reloadInterval = 0;
     BorderConfig border;
+
+    bool operator==(const BrowserOverlayConfig&) const = default;
 };
 
 struct ResolvedCrop {
@@ -417,6 +455,8 @@ enum class ModeSourceType {
 struct ModeSourceRef {
     ModeSourceType type = ModeSourceType::Mirror;
     std::string id;
+
+    bool operator==(const ModeSourceRef&) const = default;
 };
 
 struct ModeConfig {
@@ -456,14 +496,20 @@ struct ModeConfig {
     float modeSensitivityY = 1.0f;
 
     bool slideMirrorsIn = false;
+
+    bool operator==(const ModeConfig&) const = default;
 };
 struct HotkeyConditions {
     std::vector<std::string> gameState;
     std::vector<DWORD> exclusions;
+
+    bool operator==(const HotkeyConditions&) const = default;
 };
 struct AltSecondaryMode {
     std::vector<DWORD> keys;
     std::string mode;
+
+    bool operator==(const AltSecondaryMode&) const = default;
 };
 struct HotkeyConfig {
     std::vector<DWORD> keys;
@@ -480,6 +526,8 @@ struct HotkeyConfig {
     bool blockKeyFromGame = false;
 
     bool allowExitToFullscreenRegardlessOfGameState = false;
+
+    bool operator==(const HotkeyConfig&) const = default;
 };
 
 struct SensitivityHotkeyConfig {
@@ -491,6 +539,8 @@ struct SensitivityHotkeyConfig {
     bool toggle = false;
     HotkeyConditions conditions;
     int debounce = 100;
+
+    bool operator==(const SensitivityHotkeyConfig&) const = default;
 };
 struct DebugGlobalConfig {
     bool showPerformanceOverlay = false;
@@ -517,16 +567,22 @@ struct DebugGlobalConfig {
     bool logGui = false;
     bool logInit = false;
     bool logCursorTextures = false;
+
+    bool operator==(const DebugGlobalConfig&) const = default;
 };
 struct CursorConfig {
     std::string cursorName = "";
     int cursorSize = 64;
+
+    bool operator==(const CursorConfig&) const = default;
 };
 struct CursorsConfig {
     bool enabled = false;
     CursorConfig title;
     CursorConfig wall;
     CursorConfig ingame;
+
+    bool operator==(const CursorsConfig&) const = default;
 };
 struct CursorTrailConfig {
     bool enabled = ConfigDefaults::CURSOR_TRAIL_ENABLED;
@@ -544,6 +600,8 @@ struct CursorTrailConfig {
     float opacity = ConfigDefaults::CURSOR_TRAIL_OPACITY;
     std::string blendMode = ConfigDefaults::CURSOR_TRAIL_BLEND_MODE;
     std::string spritePath = ConfigDefaults::CURSOR_TRAIL_SPRITE_PATH;
+
+    bool operator==(const CursorTrailConfig&) const = default;
 };
 enum class EyeZoomOverlayDisplayMode { Manual, Fit, Stretch };
 
@@ -561,6 +619,8 @@ struct EyeZoomOverlayConfig {
     int manualHeight = 100;
     bool clipToZoomArea = false;
     float opacity = 1.0f;
+
+    bool operator==(const EyeZoomOverlayConfig&) const = default;
 };
 
 struct EyeZoomConfig {
@@ -592,11 +652,15 @@ struct EyeZoomConfig {
     bool slideMirrorsIn = false;
     int activeOverlayIndex = -1; // -1 = Default (numbered boxes), 0+ = custom overlay index
     std::vector<EyeZoomOverlayConfig> overlays;
+
+    bool operator==(const EyeZoomConfig&) const = default;
 };
 struct AppearanceConfig {
     std::string theme = "Dark";
     float guiFontScale = ConfigDefaults::CONFIG_GUI_FONT_SCALE;
     std::map<std::string, Color> customColors;
+
+    bool operator==(const AppearanceConfig&) const = default;
 };
 
 inline constexpr DWORD VK_TOOLSCREEN_SCROLL_UP = 0x1000;
@@ -638,6 +702,8 @@ struct KeyRebind {
     DWORD shiftLayerOutputVK = 0;
     DWORD shiftLayerOutputUnicode = 0;
     bool shiftLayerOutputShifted = false;
+
+    bool operator==(const KeyRebind&) const = default;
 };
 struct KeyRebindsConfig {
     bool enabled = false;
@@ -652,6 +718,8 @@ struct KeyRebindsConfig {
     std::vector<DWORD> toggleHotkey = {};
     std::vector<DWORD> layoutExtraKeys;
     std::vector<KeyRebind> rebinds;
+
+    bool operator==(const KeyRebindsConfig&) const = default;
 };
 
 inline bool IsKeyRebindMouseButtonVk(DWORD vk) {
@@ -853,6 +921,8 @@ struct NinjabrainColumn {
     std::string header;
     bool show = true;
     int staticWidth = 0;
+
+    bool operator==(const NinjabrainColumn&) const = default;
 };
 
 constexpr float kNinjabrainOverlayBaseFontSize = 64.0f;
@@ -985,7 +1055,22 @@ struct NinjabrainOverlayConfig {
         {"nether", "Nether", true},
         {"angle", "Angle", true},
     };
+
+    bool operator==(const NinjabrainOverlayConfig&) const = default;
+};
+// Identity of one published config snapshot, stamped by PublishConfigSnapshot(). Copies start out unpublished (0), so
+// a Config copied from a snapshot and then edited never shares that snapshot's generation.
+struct ConfigSnapshotGeneration {
+    uint64_t value = 0;
+
+    ConfigSnapshotGeneration() = default;
+    ConfigSnapshotGeneration(const ConfigSnapshotGeneration&) {}
+    ConfigSnapshotGeneration& operator=(const ConfigSnapshotGeneration&) {
+        value = 0;
+        return *this;
+    }
 };
+
 struct Config {
     int configVersion = GetConfigVersion();
     std::vector<MirrorConfig> mirrors;
@@ -1011,6 +1096,8 @@ struct Config {
     std::string lang = "en";
     int fpsLimit = 0;
     int fpsLimitSleepThreshold = 1000;
+    // Shift the FPS limiter's frame deadlines so frames land just before each OBS game capture.
+    bool fpsLimitAlignToObsCapture = ConfigDefaults::CONFIG_FPS_LIMIT_ALIGN_TO_OBS_CAPTURE;
     MirrorGammaMode mirrorGammaMode = MirrorGammaMode::Auto;
     // Useful if a specific overlay/driver hook layer is unstable when chained.
     bool disableHookChaining = false;
@@ -1034,6 +1121,8 @@ struct Config {
     int startupIndicatorMode = ConfigDefaults::STARTUP_INDICATOR_MODE;
     std::string startupIndicatorImagePath = ConfigDefaults::STARTUP_INDICATOR_IMAGE_PATH;
     NinjabrainOverlayConfig ninjabrainOverlay;
+    // Not persisted. Render caches key on this rather than on the snapshot's address, which is reused once retired.
+    ConfigSnapshotGeneration snapshotGeneration;
 };
 
 inline bool SanitizeConfigKeyRebindsForCannotTypeTriggers(Config& config) {
@@ -1249,6 +1338,9 @@ extern TempSensitivityOverride g_tempSensitivityOverride;
 extern std::mutex g_tempSensitivityMutex;
 
 void ClearTempSensitivityOverride();
+// Re-resolves the raw input hook's sensitivity. Call after changing the temp override, the current mode, the mode
+// transition target or the config; must not be called while holding g_tempSensitivityMutex.
+void RefreshSensitivityState();
 
 extern ModeTransitionAnimation g_modeTransition;
 extern std::mutex g_modeTransitionMutex;
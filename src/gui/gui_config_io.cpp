@@ -5,6 +5,7 @@
 #include "common/profiler.h"
 #include "common/utils.h"
 #include "config/config_migration.h"
+#include "config/config_persistence.h"
 #include "config/config_toml.h"
 #include "render/render.h"
 #include "render/mirror_thread.h"
@@ -15,9 +16,6 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
-#include <thread>
-
-static std::atomic<bool> s_isConfigSaving{ false };
 
 struct ActiveProfileSaveState {
     bool tracked = false;
@@ -93,17 +91,7 @@ void PublishGuiConfigSnapshot() {
     PublishConfigSnapshot(runtimeResolvedConfig);
 }
 
-bool WaitForConfigSaveIdle(int timeoutMs) {
-    const auto startWait = std::chrono::steady_clock::now();
-    while (s_isConfigSaving.load(std::memory_order_acquire)) {
-        if (timeoutMs >= 0 &&
-            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startWait).count() > timeoutMs) {
-            return false;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-    return true;
-}
+bool WaitForConfigSaveIdle(int timeoutMs) { return WaitForConfigPersistenceIdle(timeoutMs); }
 
 std::string GameTransitionTypeToString(GameTransitionType type) {
     switch (type) {
@@ -280,6 +268,15 @@ error_case:
     outColor = { 0.0f, 0.0f, 0.0f };
 }
 
+static ConfigSaveJob BuildConfigSaveJob(const std::wstring& configPath) {
+    ConfigSaveJob job;
+    job.configPath = configPath;
+    Config profileSnapshot;
+    const ActiveProfileSaveState activeProfileState = PrepareConfigPersistence(job.sharedSnapshot, profileSnapshot);
+    if (activeProfileState.tracked) { job.profileSnapshots.emplace_back(activeProfileState.name, std::move(profileSnapshot)); }
+    return job;
+}
+
 void SaveConfig() {
     PROFILE_SCOPE_CAT("Config Save", "IO Operations");
 
@@ -290,7 +287,6 @@ void SaveConfig() {
 
     if (!g_configIsDirty.load()) return;
     if (timeSinceLastSave < 1000) return;
-    if (s_isConfigSaving.load()) return;
 
     if (g_toolscreenPath.empty()) {
         Log("ERROR: Cannot save config, toolscreen path is not available.");
@@ -299,42 +295,15 @@ void SaveConfig() {
 
     std::wstring configPath = g_toolscreenPath + L"\\config.toml";
     try {
-        Config sharedSnapshot;
-        Config profileSnapshot;
-        const ActiveProfileSaveState activeProfileState = PrepareConfigPersistence(sharedSnapshot, profileSnapshot);
-
-        const std::string activeProfileName = activeProfileState.name;
-        const bool activeProfileTracked = activeProfileState.tracked;
+        ConfigSaveJob job = BuildConfigSaveJob(configPath);
 
         PublishGuiConfigSnapshot();
 
         g_configIsDirty = false;
         s_lastSaveTime = currentTime;
-        s_isConfigSaving = true;
-
-        std::thread([configPath, sharedSnapshot = std::move(sharedSnapshot), activeProfileName, activeProfileTracked,
-                     profileSnapshot = std::move(profileSnapshot)]() {
-            _set_se_translator(SEHTranslator);
-            try {
-                try {
-                    if (!SaveConfigToTomlFile(sharedSnapshot, configPath)) {
-                        Log("ERROR: Failed to write config file.");
-                    }
-                } catch (const std::exception& e) {
-                    Log("ERROR: Failed to write config file: " + std::string(e.what()));
-                }
-                if (activeProfileTracked && !SaveProfileSnapshotIfTracked(activeProfileName, profileSnapshot)) {
-                    Log("INFO: Skipped async profile save for removed or renamed profile '" + activeProfileName + "'.");
-                }
-            } catch (const SE_Exception& e) {
-                LogException("ConfigSaveThread (SEH)", e.getCode(), e.getInfo());
-            } catch (const std::exception& e) {
-                LogException("ConfigSaveThread", e);
-            } catch (...) {
-                Log("EXCEPTION in ConfigSaveThread: Unknown exception");
-            }
-            s_isConfigSaving = false;
-        }).detach();
+
+        // The persistence worker writes it; a save still waiting there is replaced by this newer one.
+        QueueConfigSave(std::move(job));
     } catch (const std::exception& e) {
         Log("ERROR: Failed to prepare config for save: " + std::string(e.what()));
     } catch (...) {
@@ -345,13 +314,6 @@ void SaveConfig() {
 void SaveConfigImmediate() {
     PROFILE_SCOPE_CAT("Config Save (Immediate)", "IO Operations");
 
-    if (s_isConfigSaving.load()) {
-        Log("SaveConfigImmediate: Waiting for background save to complete...");
-        if (!WaitForConfigSaveIdle(3000)) {
-            Log("SaveConfigImmediate: Timed out waiting for background save. Proceeding anyway.");
-        }
-    }
-
     if (!g_configIsDirty) return;
 
     if (g_toolscreenPath.empty()) {
@@ -362,21 +324,14 @@ void SaveConfigImmediate() {
     std::wstring configPath = g_toolscreenPath + L"\\config.toml";
     try {
         Log("SaveConfigImmediate: Starting config copy...");
-        Config sharedSnapshot;
-        Config profileSnapshot;
-        const ActiveProfileSaveState activeProfileState = PrepareConfigPersistence(sharedSnapshot, profileSnapshot);
+        const ConfigSaveJob job = BuildConfigSaveJob(configPath);
 
         PublishGuiConfigSnapshot();
 
-        if (!SaveConfigToTomlFile(sharedSnapshot, configPath)) {
-            Log("ERROR: Failed to write config file.");
+        if (!WriteConfigSaveNow(job)) {
             return;
         }
 
-        if (activeProfileState.tracked && !SaveProfileSnapshotIfTracked(activeProfileState.name, profileSnapshot)) {
-            Log("INFO: Skipped immediate profile save for removed or renamed profile '" + activeProfileState.name + "'.");
-        }
-
         Log("Configuration saved to file (immediate).");
         g_configIsDirty = false;
     } catch (const std::exception& e) {
@@ -784,6 +739,7 @@ void LoadConfig() {
                 g_currentModeIdIndex.store(nextIndex, std::memory_order_release);
             }
         }
+        RefreshSensitivityState();
 
         Log("Config loaded: " + std::to_string(g_config.modes.size()) + " modes, " + std::to_string(g_config.mirrors.size()) +
             " mirrors, " + std::to_string(g_config.images.size()) + " images, " + std::to_string(g_config.windowOverlays.size()) +
@@ -4,6 +4,7 @@
 #include "common/i18n.h"
 #include "common/profiler.h"
 #include "common/utils.h"
+#include "config/config_persistence.h"
 #include "imgui_cache.h"
 #include "imgui_impl_opengl3.h"
 #include "imgui_impl_win32.h"
@@ -1619,6 +1620,40 @@ void RenderProfilerOverlay(bool showProfiler, bool showPerformanceOverlay) {
         renderTreeSection("Other Threads", displayData.otherThreads, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
     }
 
+    const ConfigPersistenceStats persistence = GetConfigPersistenceStats();
+    if (persistence.savesRequested > 0 || persistence.savesWritten > 0) {
+        ImGui::Separator();
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
+        ImGui::Text("Config Persistence");
+        ImGui::PopStyleColor();
+        ImGui::Text("Saves: %llu requested, %llu coalesced, %llu written", static_cast<unsigned long long>(persistence.savesRequested),
+                    static_cast<unsigned long long>(persistence.savesCoalesced), static_cast<unsigned long long>(persistence.savesWritten));
+        ImGui::Text("Files: %llu written, %llu unchanged, %llu failed, %.1f KB", static_cast<unsigned long long>(persistence.filesWritten),
+                    static_cast<unsigned long long>(persistence.filesUnchanged), static_cast<unsigned long long>(persistence.writeFailures),
+                    static_cast<double>(persistence.bytesWritten) / 1024.0);
+        ImGui::Text("Last save: %.2f ms, total: %.1f ms", persistence.lastSaveMs, persistence.totalSaveMs);
+    }
+
+    const DecodeWorkerPoolStats decode = GetImageDecodePoolStats();
+    if (decode.submitted > 0) {
+        ImGui::Separator();
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.7f, 1.0f, 1.0f));
+        ImGui::Text("Image Decode");
+        ImGui::PopStyleColor();
+        ImGui::Text("Requests: %llu submitted, %llu superseded, %llu cancelled, %llu budget waits",
+                    static_cast<unsigned long long>(decode.submitted), static_cast<unsigned long long>(decode.superseded),
+                    static_cast<unsigned long long>(decode.cancelledWhileRunning), static_cast<unsigned long long>(decode.budgetWaits));
+        ImGui::Text("Now: %zu queued, %zu running, %.1f MB in flight (peak %.1f MB)", decode.queued, decode.running,
+                    static_cast<double>(decode.inFlightBytes) / (1024.0 * 1024.0), static_cast<double>(decode.peakInFlightBytes) / (1024.0 * 1024.0));
+        for (const auto& [format, formatStats] : decode.formats) {
+            if (formatStats.decoded == 0) { continue; }
+            const double count = static_cast<double>(formatStats.decoded);
+            ImGui::Text("%s: %llu, queue avg %.1f / max %.1f ms, decode avg %.1f / max %.1f ms", format.c_str(),
+                        static_cast<unsigned long long>(formatStats.decoded), formatStats.totalQueueMs / count, formatStats.maxQueueMs,
+                        formatStats.totalDecodeMs / count, formatStats.maxDecodeMs);
+        }
+    }
+
     ImGui::End();
 }
 
@@ -190,8 +190,7 @@ if (BeginSelectableSettingsTopTabItem(trc("tabs.other"))) {
         ImGui::Text(trc("settings.video_cache_budget_mib"));
         ImGui::SetNextItemWidth(300);
         int videoCacheBudgetMiB = g_config.debug.videoCacheBudgetMiB;
-        if (ImGui::SliderInt("##videoCacheBudgetMiB", &videoCacheBudgetMiB, 0, 2048,
-                             videoCacheBudgetMiB == 0 ? trc("label.disabled") : "%d MiB")) {
+        if (ImGui::SliderInt("##videoCacheBudgetMiB", &videoCacheBudgetMiB, 0, 2048, "%d MiB")) {
             g_config.debug.videoCacheBudgetMiB = videoCacheBudgetMiB;
             g_configIsDirty = true;
         }
@@ -0,0 +1,160 @@
+#include "compiled_input_map.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr const char* kAnyCursorFreeState = "any,cursor_free";
+constexpr const char* kAnyCursorGrabbedState = "any,cursor_grabbed";
+
+}  // namespace
+
+uint32_t GetInputKeyFamily(uint32_t vk) {
+    switch (vk) {
+    case input_vk::kLShift:
+    case input_vk::kRShift:
+        return input_vk::kShift;
+    case input_vk::kLControl:
+    case input_vk::kRControl:
+        return input_vk::kControl;
+    case input_vk::kLMenu:
+    case input_vk::kRMenu:
+        return input_vk::kMenu;
+    default:
+        return vk;
+    }
+}
+
+bool MatchesInputKeyEvent(uint32_t incomingVk, uint32_t incomingRawVk, uint32_t configuredKey) {
+    if (configuredKey == 0) return false;
+    if (incomingVk == configuredKey) return true;
+
+    if (configuredKey == input_vk::kControl) {
+        return incomingVk == input_vk::kLControl || incomingVk == input_vk::kRControl || incomingRawVk == input_vk::kControl;
+    }
+    if (configuredKey == input_vk::kShift) {
+        return incomingVk == input_vk::kLShift || incomingVk == input_vk::kRShift || incomingRawVk == input_vk::kShift;
+    }
+    if (configuredKey == input_vk::kMenu) {
+        return incomingVk == input_vk::kLMenu || incomingVk == input_vk::kRMenu || incomingRawVk == input_vk::kMenu;
+    }
+
+    // A generic modifier message (no side information) triggers sided bindings of its family.
+    const uint32_t family = GetInputKeyFamily(configuredKey);
+    if (family != configuredKey && incomingRawVk == family && incomingVk == family) { return true; }
+
+    return false;
+}
+
+bool CompiledGameStateCondition::Matches(int stateId, bool cursorVisible) const {
+    if (m_matchAny) { return true; }
+    if (stateId >= 0) {
+        const size_t word = static_cast<size_t>(stateId) / 64;
+        if (word < m_stateBits.size() && ((m_stateBits[word] >> (stateId % 64)) & 1u) != 0) { return true; }
+    }
+    return (m_matchCursorFree && cursorVisible) || (m_matchCursorGrabbed && !cursorVisible);
+}
+
+bool InputKeyCandidates::Next(uint32_t& index) {
+    for (;;) {
+        size_t best = m_listCount;
+        for (size_t i = 0; i < m_listCount; ++i) {
+            if (m_positions[i] >= m_lists[i]->size()) { continue; }
+            if (best == m_listCount || (*m_lists[i])[m_positions[i]] < (*m_lists[best])[m_positions[best]]) { best = i; }
+        }
+        if (best == m_listCount) { return false; }
+        const uint32_t candidate = (*m_lists[best])[m_positions[best]++];
+        // A binding reachable through two of the message's keys is yielded once.
+        if (m_last.has_value() && *m_last == candidate) { continue; }
+        m_last = candidate;
+        index = candidate;
+        return true;
+    }
+}
+
+void CompiledInputMap::AddRebind(size_t configIndex, uint32_t fromKey, RebindCursorFilter cursorFilter) {
+    const uint32_t entryIndex = static_cast<uint32_t>(m_rebinds.size());
+    m_rebinds.push_back(RebindEntry{ configIndex, fromKey, cursorFilter });
+    AddToBucket(m_rebindBuckets, fromKey, entryIndex);
+}
+
+size_t CompiledInputMap::AddHotkey(const std::vector<std::string>& gameStates) {
+    m_hotkeys.conditions.push_back(CompileCondition(gameStates));
+    return m_hotkeys.conditions.size() - 1;
+}
+
+void CompiledInputMap::AddHotkeyTrigger(size_t hotkeyIndex, uint32_t mainKey) {
+    AddToBucket(m_hotkeys.buckets, mainKey, static_cast<uint32_t>(hotkeyIndex));
+}
+
+size_t CompiledInputMap::AddSensitivityHotkey(const std::vector<std::string>& gameStates) {
+    m_sensitivityHotkeys.conditions.push_back(CompileCondition(gameStates));
+    return m_sensitivityHotkeys.conditions.size() - 1;
+}
+
+void CompiledInputMap::AddSensitivityHotkeyTrigger(size_t hotkeyIndex, uint32_t mainKey) {
+    AddToBucket(m_sensitivityHotkeys.buckets, mainKey, static_cast<uint32_t>(hotkeyIndex));
+}
+
+int CompiledInputMap::FindGameStateId(const std::string& gameState) const {
+    auto it = m_gameStateIds.find(gameState);
+    return it != m_gameStateIds.end() ? it->second : -1;
+}
+
+InputKeyCandidates CompiledInputMap::HotkeyCandidates(uint32_t vk, uint32_t rawVk, uint32_t rebindTargetVk) const {
+    return Candidates(m_hotkeys.buckets, vk, rawVk, rebindTargetVk);
+}
+
+InputKeyCandidates CompiledInputMap::SensitivityHotkeyCandidates(uint32_t vk, uint32_t rawVk, uint32_t rebindTargetVk) const {
+    return Candidates(m_sensitivityHotkeys.buckets, vk, rawVk, rebindTargetVk);
+}
+
+size_t CompiledInputMap::BucketOf(uint32_t key) {
+    const uint32_t family = GetInputKeyFamily(key);
+    return family < kKeyCount ? family : kOverflowBucket;
+}
+
+InputKeyCandidates CompiledInputMap::Candidates(const KeyBuckets& buckets, uint32_t a, uint32_t b, uint32_t c) {
+    InputKeyCandidates candidates;
+    std::array<size_t, 3> bucketIndices{};
+    size_t bucketCount = 0;
+    for (uint32_t key : { a, b, c }) {
+        const size_t bucketIndex = BucketOf(key);
+        if (buckets[bucketIndex].empty()) { continue; }
+        if (std::find(bucketIndices.begin(), bucketIndices.begin() + bucketCount, bucketIndex) != bucketIndices.begin() + bucketCount) {
+            continue;
+        }
+        bucketIndices[bucketCount] = bucketIndex;
+        candidates.m_lists[bucketCount] = &buckets[bucketIndex];
+        ++bucketCount;
+    }
+    candidates.m_listCount = bucketCount;
+    return candidates;
+}
+
+void CompiledInputMap::AddToBucket(KeyBuckets& buckets, uint32_t key, uint32_t index) {
+    // Pseudo-VKs above the virtual key range land in the overflow bucket; the final match tells them apart.
+    std::vector<uint32_t>& bucket = buckets[BucketOf(key)];
+    // Indices arrive in ascending order; a hotkey with several combinations on one key is listed once.
+    if (!bucket.empty() && bucket.back() == index) { return; }
+    bucket.push_back(index);
+}
+
+CompiledGameStateCondition CompiledInputMap::CompileCondition(const std::vector<std::string>& gameStates) {
+    CompiledGameStateCondition condition;
+    condition.m_matchAny = gameStates.empty();
+    for (const std::string& gameState : gameStates) {
+        if (gameState == kAnyCursorFreeState) { condition.m_matchCursorFree = true; }
+        if (gameState == kAnyCursorGrabbedState) { condition.m_matchCursorGrabbed = true; }
+        // The pseudo-states are interned too: a reported state equal to one of them still matches by name.
+        const int stateId = InternGameState(gameState);
+        const size_t word = static_cast<size_t>(stateId) / 64;
+        if (condition.m_stateBits.size() <= word) { condition.m_stateBits.resize(word + 1, 0); }
+        condition.m_stateBits[word] |= uint64_t{ 1 } << (stateId % 64);
+    }
+    return condition;
+}
+
+int CompiledInputMap::InternGameState(const std::string& gameState) {
+    return m_gameStateIds.emplace(gameState, static_cast<int>(m_gameStateIds.size())).first->second;
+}
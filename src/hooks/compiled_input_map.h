@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-config lookup tables for keyboard and mouse message dispatch.
+//
+// Built once per published config snapshot. Key rebinds, hotkeys and sensitivity hotkeys are bucketed by the virtual
+// key that can trigger them, keeping config order within a bucket. Modifiers share their family's bucket, since a
+// generic VK_SHIFT binding matches either side and a sided one matches a generic VK_SHIFT message. Keys outside the
+// virtual key range (the scroll wheel pseudo-VKs) share one overflow bucket. Game state names are interned so a
+// condition is a bit test. A message looks up its keys' buckets instead of walking the config; the final match against
+// live key state (modifiers, exclusions) stays with the existing matchers.
+
+namespace input_vk {
+inline constexpr uint32_t kShift = 0x10;
+inline constexpr uint32_t kControl = 0x11;
+inline constexpr uint32_t kMenu = 0x12;
+inline constexpr uint32_t kLShift = 0xA0;
+inline constexpr uint32_t kRShift = 0xA1;
+inline constexpr uint32_t kLControl = 0xA2;
+inline constexpr uint32_t kRControl = 0xA3;
+inline constexpr uint32_t kLMenu = 0xA4;
+inline constexpr uint32_t kRMenu = 0xA5;
+}  // namespace input_vk
+
+// The generic modifier for a sided one (VK_LSHIFT -> VK_SHIFT); any other key is its own family.
+uint32_t GetInputKeyFamily(uint32_t vk);
+
+// Whether a message for incomingVk (resolved) / incomingRawVk (as delivered) triggers a binding on configuredKey.
+bool MatchesInputKeyEvent(uint32_t incomingVk, uint32_t incomingRawVk, uint32_t configuredKey);
+
+enum class RebindCursorFilter : uint8_t {
+    Any,
+    CursorFree,
+    CursorGrabbed,
+};
+
+class CompiledGameStateCondition {
+  public:
+    // stateId comes from CompiledInputMap::FindGameStateId() and is -1 for a state no condition names.
+    bool Matches(int stateId, bool cursorVisible) const;
+
+    // Whether Matches() reads cursorVisible, so callers can skip querying it.
+    bool UsesCursorState() const { return m_matchCursorFree || m_matchCursorGrabbed; }
+
+  private:
+    friend class CompiledInputMap;
+
+    bool m_matchAny = true;
+    bool m_matchCursorFree = false;
+    bool m_matchCursorGrabbed = false;
+    std::vector<uint64_t> m_stateBits;
+};
+
+// Yields binding indices from up to three key buckets in ascending order, each index once.
+class InputKeyCandidates {
+  public:
+    bool Next(uint32_t& index);
+
+  private:
+    friend class CompiledInputMap;
+
+    std::array<const std::vector<uint32_t>*, 3> m_lists{};
+    std::array<size_t, 3> m_positions{};
+    size_t m_listCount = 0;
+    std::optional<uint32_t> m_last;
+};
+
+class CompiledInputMap {
+  public:
+    static constexpr size_t kKeyCount = 256;
+    // Bucket for every key at or above kKeyCount, such as VK_TOOLSCREEN_SCROLL_UP/DOWN.
+    static constexpr size_t kOverflowBucket = kKeyCount;
+
+    // Only rebinds that can ever match (enabled, with a source key) should be added, in config order.
+    void AddRebind(size_t configIndex, uint32_t fromKey, RebindCursorFilter cursorFilter);
+
+    // Hotkeys are numbered in the order they are added, which must be config order.
+    size_t AddHotkey(const std::vector<std::string>& gameStates);
+    // Registers a key combination of the hotkey by its main (last) key.
+    void AddHotkeyTrigger(size_t hotkeyIndex, uint32_t mainKey);
+    size_t AddSensitivityHotkey(const std::vector<std::string>& gameStates);
+    void AddSensitivityHotkeyTrigger(size_t hotkeyIndex, uint32_t mainKey);
+
+    int FindGameStateId(const std::string& gameState) const;
+
+    const CompiledGameStateCondition& HotkeyCondition(size_t hotkeyIndex) const { return m_hotkeys.conditions[hotkeyIndex]; }
+    const CompiledGameStateCondition& SensitivityHotkeyCondition(size_t hotkeyIndex) const {
+        return m_sensitivityHotkeys.conditions[hotkeyIndex];
+    }
+
+    // Hotkeys with a combination whose main key can match a message for any of these keys (0 for unused slots).
+    InputKeyCandidates HotkeyCandidates(uint32_t vk, uint32_t rawVk, uint32_t rebindTargetVk) const;
+    InputKeyCandidates SensitivityHotkeyCandidates(uint32_t vk, uint32_t rawVk, uint32_t rebindTargetVk) const;
+
+    // Config index of the rebind for this message: the first in config order whose cursor state filter names the
+    // current state exactly, else the first that applies to any cursor state. The predicate can veto candidates.
+    template <typename Predicate>
+    std::optional<size_t> FindPreferredRebind(uint32_t incomingVk, uint32_t incomingRawVk, bool cursorVisible, Predicate predicate) const {
+        InputKeyCandidates candidates = Candidates(m_rebindBuckets, incomingVk, incomingRawVk, 0);
+        std::optional<size_t> anyMatch;
+        uint32_t entryIndex = 0;
+        while (candidates.Next(entryIndex)) {
+            const RebindEntry& entry = m_rebinds[entryIndex];
+            if (!MatchesInputKeyEvent(incomingVk, incomingRawVk, entry.fromKey)) { continue; }
+            if (entry.cursorFilter != RebindCursorFilter::Any) {
+                const bool exact = (entry.cursorFilter == RebindCursorFilter::CursorFree) == cursorVisible;
+                if (exact && predicate(entry.configIndex)) { return entry.configIndex; }
+                continue;
+            }
+            if (!anyMatch.has_value() && predicate(entry.configIndex)) { anyMatch = entry.configIndex; }
+        }
+        return anyMatch;
+    }
+
+  private:
+    using KeyBuckets = std::array<std::vector<uint32_t>, kKeyCount + 1>;
+
+    struct RebindEntry {
+        size_t configIndex = 0;
+        uint32_t fromKey = 0;
+        RebindCursorFilter cursorFilter = RebindCursorFilter::Any;
+    };
+
+    struct HotkeyTable {
+        std::vector<CompiledGameStateCondition> conditions;
+        KeyBuckets buckets;
+    };
+
+    static size_t BucketOf(uint32_t key);
+    static InputKeyCandidates Candidates(const KeyBuckets& buckets, uint32_t a, uint32_t b, uint32_t c);
+    static void AddToBucket(KeyBuckets& buckets, uint32_t key, uint32_t index);
+
+    CompiledGameStateCondition CompileCondition(const std::vector<std::string>& gameStates);
+    int InternGameState(const std::string& gameState);
+
+    std::vector<RebindEntry> m_rebinds;
+    KeyBuckets m_rebindBuckets;
+    HotkeyTable m_hotkeys;
+    HotkeyTable m_sensitivityHotkeys;
+    std::unordered_map<std::string, int> m_gameStateIds;
+};
@@ -272,7 +272,7 @@ static void LogSkippedDisallowedHookTarget(const char* apiName, void* startAddre
         action = "Skipping chaining our own hook";
     }
 
-    LogCategory("hookchain",
+    LOG_CATEGORY(HookChain,
                 std::string("[") + apiName + "] " + action + " start=" +
                     HookChain::DescribeAddressWithOwner(startAddress) + " target=" + HookChain::DescribeAddressWithOwner(skippedTarget));
 }
@@ -280,7 +280,7 @@ static void LogSkippedDisallowedHookTarget(const char* apiName, void* startAddre
 static void LogSkippedStaleHookTarget(const char* apiName, void* target, const char* reason) {
     if (!apiName || !target) return;
 
-    LogCategory("hookchain",
+    LOG_CATEGORY(HookChain,
                 std::string("[") + apiName + "] skipping stale third-party hook target " + HookChain::DescribeAddressWithOwner(target) +
                     " reason=" + (reason ? reason : "unknown"));
 }
@@ -389,21 +389,21 @@ static void LogHookChainDetails(const char* apiName, void* startAddress, void* r
 
     const char* mode = "LatestHook";
 
-    LogCategory("hookchain",
+    LOG_CATEGORY(HookChain,
                 std::string("[") + apiName + "] chain-detect reason=" + reason + " nextTarget=" + mode + " start=" +
                     HookChain::DescribeAddressWithOwner(startAddress) + " hookTarget=" + HookChain::DescribeAddressWithOwner(resolvedHookTarget));
 
     std::vector<std::string> trace;
     (void)TraceAbsoluteJumpTarget(startAddress, trace);
     for (const auto& line : trace) {
-        LogCategory("hookchain", std::string("[") + apiName + "] " + line);
+        LOG_CATEGORY(HookChain, std::string("[") + apiName + "] " + line);
     }
 }
 
 static void LogIatHookChainDetails(const char* apiName, HMODULE importingModule, void* thunkTarget, void* expectedExport) {
     if (!apiName) apiName = "(unknown api)";
     std::string importerDesc = importingModule ? HookChain::DescribeAddressWithOwner(importingModule) : std::string("(null)");
-    LogCategory("hookchain",
+    LOG_CATEGORY(HookChain,
                 std::string("[") + apiName + "] IAT chain-detect importingModule=" + importerDesc + " iatTarget=" +
                     HookChain::DescribeAddressWithOwner(thunkTarget) + " expectedExport=" + HookChain::DescribeAddressWithOwner(expectedExport));
 }
@@ -415,7 +415,7 @@ static bool TryInstallThirdPartyWglSwapBuffersHook(void* jumpTarget, const char*
     }
 
     if (currentTarget) {
-        LogCategory("hookchain",
+        LOG_CATEGORY(HookChain,
                     std::string("[wglSwapBuffers] keeping existing third-party hook target ") +
                         HookChain::DescribeAddressWithOwner(currentTarget) + " instead of switching to " +
                         HookChain::DescribeAddressWithOwner(jumpTarget));
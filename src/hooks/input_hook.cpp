@@ -1,8 +1,12 @@
 #include "input_hook.h"
+#include "compiled_input_map.h"
+#include "input_trace.h"
+#include "key_repeat_scheduler.h"
 
 #include "features/fake_cursor.h"
 #include "features/virtual_camera.h"
 #include "common/mode_dimensions.h"
+#include "config/config_diff.h"
 #include "gui/gui.h"
 #include "gui/imgui_cache.h"
 #include "runtime/logic_thread.h"
@@ -125,10 +129,11 @@ static std::vector<SuppressedLocalRepeatChar> s_localKeyRepeatSuppressedChars;
 static HANDLE s_localKeyRepeatHighResTimer = NULL;
 static HANDLE s_localKeyRepeatWakeEvent = NULL;
 static HANDLE s_localKeyRepeatThread = NULL;
-static ULONGLONG s_localKeyRepeatDelayGateDeadlineMs = 0;
 static std::mutex s_localKeyRepeatSchedulerInitMutex;
 static std::atomic<HWND> s_localKeyRepeatScheduledHwnd{ NULL };
-static std::atomic<int64_t> s_localKeyRepeatRequestedDelay100ns{ 0 };
+// Mutated on the window thread; the scheduler thread only reads the next deadline to arm its timer.
+static KeyRepeatScheduler s_localKeyRepeatScheduler;
+static std::mutex s_localKeyRepeatSchedulerMutex;
 static std::unordered_map<DWORD, LowLevelSuppressedKeyState> s_lowLevelSuppressedKeys;
 static std::mutex s_lowLevelSuppressedKeysMutex;
 static std::unordered_set<DWORD> s_lowLevelExactModifierKeysDown;
@@ -208,27 +213,6 @@ static InputHandlerResult HandleLocalKeyRepeat(HWND hWnd, UINT uMsg, WPARAM wPar
 bool GetEffectiveKeyRepeatTimings(int& outStartDelayMs, int& outRepeatDelayMs);
 static void ReleaseSuppressedLowLevelRebindKeys(HWND hWnd);
 
-static bool MatchesConfiguredGameStateCondition(const std::vector<std::string>& configuredStates, const std::string& gameState) {
-    if (configuredStates.empty()) {
-        return true;
-    }
-
-    const bool cursorVisible = IsCursorVisible();
-    for (const std::string& configuredState : configuredStates) {
-        if (configuredState == gameState) {
-            return true;
-        }
-        if (configuredState == "any,cursor_free" && cursorVisible) {
-            return true;
-        }
-        if (configuredState == "any,cursor_grabbed" && !cursorVisible) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 enum class KeyRebindCursorStateMatchPriority {
     None = 0,
     Any = 1,
@@ -265,33 +249,62 @@ static KeyRebindCursorStateMatchPriority GetKeyRebindCursorStateMatchPriority(co
     return KeyRebindCursorStateMatchPriority::Any;
 }
 
-template <typename Predicate>
-static const KeyRebind* FindPreferredEnabledKeyRebind(const std::vector<KeyRebind>& rebinds,
-                                                      bool cursorVisible,
-                                                      Predicate predicate) {
-    const KeyRebind* anyMatch = nullptr;
+static RebindCursorFilter GetKeyRebindCursorFilter(const KeyRebind& rebind) {
+    if (rebind.cursorState == kKeyRebindCursorStateCursorFree) { return RebindCursorFilter::CursorFree; }
+    if (rebind.cursorState == kKeyRebindCursorStateCursorGrabbed) { return RebindCursorFilter::CursorGrabbed; }
+    return RebindCursorFilter::Any;
+}
 
-    for (const auto& rebind : rebinds) {
-        if (!rebind.enabled || rebind.fromKey == 0) {
-            continue;
-        }
-        if (rebind.toKey == 0 && !IsConsumeOnlyKeyRebind(rebind)) {
-            continue;
-        }
-        if (!predicate(rebind)) {
-            continue;
+static std::shared_ptr<const CompiledInputMap> BuildCompiledInputMap(const Config& cfg) {
+    auto compiled = std::make_shared<CompiledInputMap>();
+    for (size_t i = 0; i < cfg.keyRebinds.rebinds.size(); ++i) {
+        const KeyRebind& rebind = cfg.keyRebinds.rebinds[i];
+        // A rebind without a target is consume-only, so enabled with a source key is all it takes to match.
+        if (!rebind.enabled || rebind.fromKey == 0) { continue; }
+        compiled->AddRebind(i, static_cast<uint32_t>(rebind.fromKey), GetKeyRebindCursorFilter(rebind));
+    }
+    for (const HotkeyConfig& hotkey : cfg.hotkeys) {
+        const size_t index = compiled->AddHotkey(hotkey.conditions.gameState);
+        for (const AltSecondaryMode& alt : hotkey.altSecondaryModes) {
+            if (!alt.keys.empty()) { compiled->AddHotkeyTrigger(index, static_cast<uint32_t>(alt.keys.back())); }
         }
+        if (!hotkey.keys.empty()) { compiled->AddHotkeyTrigger(index, static_cast<uint32_t>(hotkey.keys.back())); }
+    }
+    for (const SensitivityHotkeyConfig& sensHotkey : cfg.sensitivityHotkeys) {
+        const size_t index = compiled->AddSensitivityHotkey(sensHotkey.conditions.gameState);
+        if (!sensHotkey.keys.empty()) { compiled->AddSensitivityHotkeyTrigger(index, static_cast<uint32_t>(sensHotkey.keys.back())); }
+    }
+    return compiled;
+}
 
-        const KeyRebindCursorStateMatchPriority matchPriority = GetKeyRebindCursorStateMatchPriority(rebind, cursorVisible);
-        if (matchPriority == KeyRebindCursorStateMatchPriority::Exact) {
-            return &rebind;
-        }
-        if (matchPriority == KeyRebindCursorStateMatchPriority::Any && anyMatch == nullptr) {
-            anyMatch = &rebind;
-        }
+// Compiled lazily per thread for the config snapshot it is used with, so its indices always refer to that snapshot.
+static std::shared_ptr<const CompiledInputMap> GetCompiledInputMap(const std::shared_ptr<const Config>& cfg) {
+    struct CachedInputMap {
+        std::shared_ptr<const Config> source;
+        std::shared_ptr<const CompiledInputMap> compiled;
+    };
+    thread_local CachedInputMap s_cache;
+    if (s_cache.source != cfg) {
+        s_cache.compiled = BuildCompiledInputMap(*cfg);
+        s_cache.source = cfg;
     }
+    return s_cache.compiled;
+}
 
-    return anyMatch;
+static bool MatchesCompiledGameStateCondition(const CompiledGameStateCondition& condition, int gameStateId) {
+    return condition.Matches(gameStateId, condition.UsesCursorState() && IsCursorVisible());
+}
+
+// The preferred enabled rebind for a key event; see CompiledInputMap::FindPreferredRebind().
+template <typename Predicate>
+static const KeyRebind* FindPreferredEnabledKeyRebind(const std::shared_ptr<const Config>& cfg, DWORD incomingVk, DWORD incomingRawVk,
+                                                      bool cursorVisible, Predicate predicate) {
+    const auto compiled = GetCompiledInputMap(cfg);
+    const std::vector<KeyRebind>& rebinds = cfg->keyRebinds.rebinds;
+    const std::optional<size_t> index =
+        compiled->FindPreferredRebind(static_cast<uint32_t>(incomingVk), static_cast<uint32_t>(incomingRawVk), cursorVisible,
+                                      [&](size_t rebindIndex) { return predicate(rebinds[rebindIndex]); });
+    return index.has_value() ? &rebinds[*index] : nullptr;
 }
 
 static UINT GetScanCodeWithExtendedFlagFromLParam(LPARAM lParam) {
@@ -665,10 +678,6 @@ static bool IsTrackedExactAutoRepeatKeyDown(UINT uMsg, WPARAM wParam, LPARAM lPa
     return trackedVk != 0 && s_exactKeyboardKeysDown.contains(trackedVk);
 }
 
-static bool MatchesRebindSourceKey(DWORD incomingVk, DWORD incomingRawVk, DWORD fromKey) {
-    return MatchesConfiguredInputKeyEvent(incomingVk, incomingRawVk, fromKey);
-}
-
 static bool AreConfiguredKeysCurrentlyDown(const std::vector<DWORD>& keys) {
     if (keys.empty()) return false;
 
@@ -1196,12 +1205,12 @@ InputHandlerResult HandleConfigLoadFailure(HWND hWnd, UINT uMsg, WPARAM wParam,
 }
 
 static HCURSOR s_forcedCursorCached = nullptr;
-static uint64_t s_forcedCursorCachedConfigVersion = UINT64_MAX;
+static uint64_t s_forcedCursorCachedCursorsVersion = UINT64_MAX;
 static std::string s_forcedCursorCachedGameState;
 
 static HCURSOR ResolveForcedVisibleGuiCursor(const std::string& gameState) {
-    const uint64_t version = g_configSnapshotVersion.load(std::memory_order_acquire);
-    if (s_forcedCursorCached && version == s_forcedCursorCachedConfigVersion &&
+    const uint64_t version = GetConfigSectionVersion(ConfigSection::Cursors);
+    if (s_forcedCursorCached && version == s_forcedCursorCachedCursorsVersion &&
         gameState == s_forcedCursorCachedGameState) {
         return s_forcedCursorCached;
     }
@@ -1209,7 +1218,7 @@ static HCURSOR ResolveForcedVisibleGuiCursor(const std::string& gameState) {
     const CursorTextures::CursorData* cursorData = CursorTextures::GetSelectedCursor(gameState, 64);
     HCURSOR resolved = (cursorData && cursorData->hCursor) ? cursorData->hCursor : s_arrowCursor;
     s_forcedCursorCached = resolved;
-    s_forcedCursorCachedConfigVersion = version;
+    s_forcedCursorCachedCursorsVersion = version;
     s_forcedCursorCachedGameState = gameState;
     return resolved;
 }
@@ -2107,10 +2116,8 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
     DWORD rebindTargetVk = 0;
     const bool cursorVisible = (cfg.keyRebinds.enabled && cfg.keyRebinds.resolveRebindTargetsForHotkeys) ? IsCursorVisible() : false;
     if (cfg.keyRebinds.enabled && cfg.keyRebinds.resolveRebindTargetsForHotkeys) {
-        const KeyRebind* matchedRebind = FindPreferredEnabledKeyRebind(
-            cfg.keyRebinds.rebinds,
-            cursorVisible,
-            [&](const KeyRebind& rebind) { return MatchesRebindSourceKey(vkCode, rawVkCode, rebind.fromKey); });
+        const KeyRebind* matchedRebind =
+            FindPreferredEnabledKeyRebind(cfgSnap, vkCode, rawVkCode, cursorVisible, [](const KeyRebind&) { return true; });
         if (matchedRebind != nullptr) {
             const bool shiftLayerActive = IsShiftLayerActiveForRebind(*matchedRebind, vkCode, rawVkCode, isKeyDown);
             const DWORD effectiveCustomOutputVk = ResolveEffectiveCustomOutputVk(*matchedRebind, shiftLayerActive);
@@ -2148,14 +2155,20 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
         Log("[Hotkey] Evaluating " + std::to_string(cfg.hotkeys.size()) + " configured hotkeys");
     }
 
-    for (size_t hotkeyIdx = 0; hotkeyIdx < cfg.hotkeys.size(); ++hotkeyIdx) {
+    // Only hotkeys with a combination on one of this message's keys can match; the rest are never asked.
+    const auto compiledInput = GetCompiledInputMap(cfgSnap);
+    const int gameStateId = compiledInput->FindGameStateId(gameState);
+    InputKeyCandidates hotkeyCandidates = compiledInput->HotkeyCandidates(vkCode, rawVkCode, rebindTargetVk);
+    uint32_t hotkeyCandidate = 0;
+    while (hotkeyCandidates.Next(hotkeyCandidate)) {
+        const size_t hotkeyIdx = hotkeyCandidate;
         const auto& hotkey = cfg.hotkeys[hotkeyIdx];
         if (s_enableHotkeyDebug) {
             Log("[Hotkey] Checking: " + GetKeyComboString(hotkey.keys) + " (main: " + hotkey.mainMode + ", sec: " + hotkey.secondaryMode +
                 ")");
         }
 
-        bool conditionsMet = MatchesConfiguredGameStateCondition(hotkey.conditions.gameState, gameState);
+        bool conditionsMet = MatchesCompiledGameStateCondition(compiledInput->HotkeyCondition(hotkeyIdx), gameStateId);
 
         std::string currentSecMode;
         bool wouldExitToFullscreen = false;
@@ -2394,14 +2407,17 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
         }
     }
 
-    for (size_t sensIdx = 0; sensIdx < cfg.sensitivityHotkeys.size(); ++sensIdx) {
+    InputKeyCandidates sensitivityCandidates = compiledInput->SensitivityHotkeyCandidates(vkCode, rawVkCode, rebindTargetVk);
+    uint32_t sensitivityCandidate = 0;
+    while (sensitivityCandidates.Next(sensitivityCandidate)) {
+        const size_t sensIdx = sensitivityCandidate;
         const auto& sensHotkey = cfg.sensitivityHotkeys[sensIdx];
         if (s_enableHotkeyDebug) {
             Log("[Hotkey] Checking sensitivity hotkey: " + GetKeyComboString(sensHotkey.keys) +
                 " -> sens=" + std::to_string(sensHotkey.sensitivity));
         }
 
-        bool conditionsMet = MatchesConfiguredGameStateCondition(sensHotkey.conditions.gameState, gameState);
+        bool conditionsMet = MatchesCompiledGameStateCondition(compiledInput->SensitivityHotkeyCondition(sensIdx), gameStateId);
         if (!conditionsMet) {
             if (s_enableHotkeyDebug) { Log("[Hotkey] SKIP sensitivity: Game state conditions not met"); }
             continue;
@@ -2442,30 +2458,36 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
                 if (sensHotkey.toggle) {
                     extern TempSensitivityOverride g_tempSensitivityOverride;
                     extern std::mutex g_tempSensitivityMutex;
-                    std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
-
-                    if (g_tempSensitivityOverride.active && g_tempSensitivityOverride.activeSensHotkeyIndex == static_cast<int>(sensIdx)) {
-                        g_tempSensitivityOverride.active = false;
-                        g_tempSensitivityOverride.sensitivityX = 1.0f;
-                        g_tempSensitivityOverride.sensitivityY = 1.0f;
-                        g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+                    bool toggledOff = false;
+                    {
+                        std::lock_guard<std::mutex> lock(g_tempSensitivityMutex);
+                        if (g_tempSensitivityOverride.active && g_tempSensitivityOverride.activeSensHotkeyIndex == static_cast<int>(sensIdx)) {
+                            g_tempSensitivityOverride.active = false;
+                            g_tempSensitivityOverride.sensitivityX = 1.0f;
+                            g_tempSensitivityOverride.sensitivityY = 1.0f;
+                            g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
+                            toggledOff = true;
+                        } else {
+                            g_tempSensitivityOverride.active = true;
+                            if (sensHotkey.separateXY) {
+                                g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
+                                g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
+                            } else {
+                                g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
+                                g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
+                            }
+                            g_tempSensitivityOverride.activeSensHotkeyIndex = static_cast<int>(sensIdx);
+                        }
+                    }
+                    RefreshSensitivityState();
 
+                    if (toggledOff) {
                         if (s_enableHotkeyDebug) { Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED OFF: " + hotkeyId); }
 
                         if (blockKey) return { true, 0 };
                         return { true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
                     }
 
-                    g_tempSensitivityOverride.active = true;
-                    if (sensHotkey.separateXY) {
-                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivityX;
-                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivityY;
-                    } else {
-                        g_tempSensitivityOverride.sensitivityX = sensHotkey.sensitivity;
-                        g_tempSensitivityOverride.sensitivityY = sensHotkey.sensitivity;
-                    }
-                    g_tempSensitivityOverride.activeSensHotkeyIndex = static_cast<int>(sensIdx);
-
                     if (s_enableHotkeyDebug) {
                         Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TOGGLED ON: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
                     }
@@ -2484,6 +2506,7 @@ InputHandlerResult HandleHotkeys(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
                         }
                         g_tempSensitivityOverride.activeSensHotkeyIndex = -1;
                     }
+                    RefreshSensitivityState();
 
                     if (s_enableHotkeyDebug) {
                         Log("[Hotkey] ✓✓✓ SENSITIVITY HOTKEY TRIGGERED: " + hotkeyId + " -> sens=" + std::to_string(sensHotkey.sensitivity));
@@ -2759,33 +2782,49 @@ static void LogLocalRepeatDebug(const char* phase, UINT uMsg, WPARAM wParam, LPA
     Log(stream.str());
 }
 
+static int64_t GetLocalKeyRepeatNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Sleeps until the scheduler's next deadline and posts an untargeted tick; the window thread collects whatever is due
+// and signals the wake event, which re-arms the timer for the following deadline.
 static DWORD WINAPI LocalKeyRepeatSchedulerThreadProc(LPVOID) {
     HANDLE handles[2] = { s_localKeyRepeatWakeEvent, s_localKeyRepeatHighResTimer };
+    bool tickPending = false;
     for (;;) {
-        const DWORD waitResult = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
-        if (waitResult == WAIT_OBJECT_0) {
-            if (s_localKeyRepeatHighResTimer) {
-                (void)CancelWaitableTimer(s_localKeyRepeatHighResTimer);
+        DWORD handleCount = 1;
+        const HWND targetHwnd = s_localKeyRepeatScheduledHwnd.load(std::memory_order_acquire);
+        if (!tickPending && targetHwnd && IsWindow(targetHwnd)) {
+            std::optional<int64_t> deadlineNs;
+            {
+                std::lock_guard<std::mutex> lock(s_localKeyRepeatSchedulerMutex);
+                deadlineNs = s_localKeyRepeatScheduler.NextDeadlineNs();
             }
-
-            const HWND targetHwnd = s_localKeyRepeatScheduledHwnd.load(std::memory_order_acquire);
-            const int64_t delay100ns = s_localKeyRepeatRequestedDelay100ns.load(std::memory_order_acquire);
-            if (!targetHwnd || !IsWindow(targetHwnd) || delay100ns <= 0 || !s_localKeyRepeatHighResTimer) {
-                continue;
+            if (deadlineNs) {
+                const int64_t wait100ns = (std::max)((*deadlineNs - GetLocalKeyRepeatNowNs()) / 100, int64_t{ 1 });
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -static_cast<LONGLONG>(wait100ns);
+                if (SetWaitableTimer(s_localKeyRepeatHighResTimer, &dueTime, 0, NULL, NULL, FALSE)) {
+                    handleCount = 2;
+                } else {
+                    Log("WARNING: Failed to arm high-resolution local key repeat timer");
+                }
             }
+        }
 
-            LARGE_INTEGER dueTime;
-            dueTime.QuadPart = -static_cast<LONGLONG>(delay100ns);
-            if (!SetWaitableTimer(s_localKeyRepeatHighResTimer, &dueTime, 0, NULL, NULL, FALSE)) {
-                Log("WARNING: Failed to arm high-resolution local key repeat timer");
-            }
+        const DWORD waitResult = WaitForMultipleObjects(handleCount, handles, FALSE, INFINITE);
+        if (waitResult == WAIT_OBJECT_0) {
+            (void)CancelWaitableTimer(s_localKeyRepeatHighResTimer);
+            tickPending = false;
             continue;
         }
 
         if (waitResult == (WAIT_OBJECT_0 + 1)) {
-            const HWND targetHwnd = s_localKeyRepeatScheduledHwnd.load(std::memory_order_acquire);
-            if (targetHwnd && IsWindow(targetHwnd)) {
-                if (::PostMessageW(targetHwnd, WM_TOOLSCREEN_LOCAL_KEY_REPEAT, 0, 0) == FALSE) {
+            // Wait for the window thread to collect before re-arming; the deadline stays in the past until it does.
+            tickPending = true;
+            const HWND tickHwnd = s_localKeyRepeatScheduledHwnd.load(std::memory_order_acquire);
+            if (tickHwnd && IsWindow(tickHwnd)) {
+                if (::PostMessageW(tickHwnd, WM_TOOLSCREEN_LOCAL_KEY_REPEAT, 0, 0) == FALSE) {
                     Log("WARNING: Failed to post high-resolution local key repeat tick");
                 }
             }
@@ -2838,44 +2877,79 @@ static bool EnsureLocalKeyRepeatSchedulerInitialized() {
     return true;
 }
 
+// Hands the updated schedule to the scheduler thread, or polls it from WM_TIMER when the thread is unavailable.
+static void WakeLocalKeyRepeatScheduler(HWND hWnd) {
+    if (!hWnd || !IsWindow(hWnd)) {
+        return;
+    }
+
+    s_localKeyRepeatScheduledHwnd.store(hWnd, std::memory_order_release);
+    if (EnsureLocalKeyRepeatSchedulerInitialized()) {
+        if (SetEvent(s_localKeyRepeatWakeEvent) != FALSE) {
+            (void)KillTimer(hWnd, kToolscreenLocalKeyRepeatTimerId);
+            return;
+        }
+
+        Log("WARNING: Failed to signal high-resolution local key repeat timer; falling back to WM_TIMER");
+    }
+
+    if (SetTimer(hWnd, kToolscreenLocalKeyRepeatTimerId, USER_TIMER_MINIMUM, NULL) == 0) {
+        Log("WARNING: Failed to arm local key repeat timer");
+    }
+}
+
 static void StopLocalKeyRepeatTimer(HWND hWnd) {
     const HWND targetHwnd = hWnd ? hWnd : g_subclassedHwnd.load(std::memory_order_acquire);
     if (targetHwnd && IsWindow(targetHwnd)) {
         (void)KillTimer(targetHwnd, kToolscreenLocalKeyRepeatTimerId);
     }
 
-    s_localKeyRepeatDelayGateDeadlineMs = 0;
+    KeyRepeatScheduleStats stats;
+    {
+        std::lock_guard<std::mutex> lock(s_localKeyRepeatSchedulerMutex);
+        s_localKeyRepeatScheduler.Clear();
+        stats = s_localKeyRepeatScheduler.Stats();
+        s_localKeyRepeatScheduler.ResetStats();
+    }
+    if (stats.fires != 0 && IsLocalRepeatDebugEnabled()) {
+        Log("[LocalRepeat] schedule repeats=" + std::to_string(stats.fires) +
+            " meanErrorUs=" + std::to_string(stats.MeanAbsErrorNs() / 1000) + " maxLateUs=" + std::to_string(stats.maxLateNs / 1000) +
+            " skipped=" + std::to_string(stats.skipped));
+    }
 
     if (s_localKeyRepeatWakeEvent && s_localKeyRepeatHighResTimer) {
         s_localKeyRepeatScheduledHwnd.store(NULL, std::memory_order_release);
-        s_localKeyRepeatRequestedDelay100ns.store(0, std::memory_order_release);
         (void)SetEvent(s_localKeyRepeatWakeEvent);
     }
 }
 
-static void ArmLocalKeyRepeatTimer(HWND hWnd, int delayMs) {
+// Only the most recently pressed key repeats, so the scheduler holds at most the owner.
+static void ScheduleLocalKeyRepeat(HWND hWnd, DWORD previousOwnerVk, DWORD ownerVk) {
     if (!hWnd || !IsWindow(hWnd)) {
         return;
     }
 
-    const int intervalMs = (std::max)(delayMs, 1);
-    (void)KillTimer(hWnd, kToolscreenLocalKeyRepeatTimerId);
-
-    if (EnsureLocalKeyRepeatSchedulerInitialized()) {
-        s_localKeyRepeatScheduledHwnd.store(hWnd, std::memory_order_release);
-        s_localKeyRepeatRequestedDelay100ns.store(static_cast<int64_t>(intervalMs) * 10000,
-                                                  std::memory_order_release);
-        if (SetEvent(s_localKeyRepeatWakeEvent) != FALSE) {
-            return;
-        }
-
-        Log("WARNING: Failed to signal high-resolution local key repeat timer; falling back to WM_TIMER");
+    int startDelayMs = 250;
+    int repeatDelayMs = 33;
+    (void)GetEffectiveKeyRepeatTimings(startDelayMs, repeatDelayMs);
+    {
+        std::lock_guard<std::mutex> lock(s_localKeyRepeatSchedulerMutex);
+        if (previousOwnerVk != ownerVk) { (void)s_localKeyRepeatScheduler.Release(previousOwnerVk); }
+        s_localKeyRepeatScheduler.Press(ownerVk, GetLocalKeyRepeatNowNs(), static_cast<int64_t>((std::max)(startDelayMs, 1)) * 1000000,
+                                        static_cast<int64_t>((std::max)(repeatDelayMs, 1)) * 1000000);
     }
+    WakeLocalKeyRepeatScheduler(hWnd);
+}
 
-    const UINT fallbackIntervalMs = static_cast<UINT>((std::max)(intervalMs, 1));
-    if (SetTimer(hWnd, kToolscreenLocalKeyRepeatTimerId, fallbackIntervalMs, NULL) == 0) {
-        Log("WARNING: Failed to arm local key repeat timer");
+// Collects the repeats that are due now; true when the owner's repeat is among them.
+static bool CollectDueLocalKeyRepeat(HWND hWnd, DWORD ownerVk) {
+    std::vector<KeyRepeatFire> fires;
+    {
+        std::lock_guard<std::mutex> lock(s_localKeyRepeatSchedulerMutex);
+        (void)s_localKeyRepeatScheduler.Collect(GetLocalKeyRepeatNowNs(), fires);
     }
+    WakeLocalKeyRepeatScheduler(hWnd);
+    return std::any_of(fires.begin(), fires.end(), [ownerVk](const KeyRepeatFire& fire) { return fire.key == ownerVk; });
 }
 
 void ResetLocalKeyRepeatState(HWND hWnd) {
@@ -2899,11 +2973,7 @@ static void RestartLocalKeyRepeatStartDelay(HWND hWnd) {
         return;
     }
 
-    int startDelayMs = 250;
-    int repeatDelayMs = 33;
-    (void)GetEffectiveKeyRepeatTimings(startDelayMs, repeatDelayMs);
-    s_localKeyRepeatDelayGateDeadlineMs = GetTickCount64() + static_cast<ULONGLONG>((std::max)(startDelayMs, 1));
-    ArmLocalKeyRepeatTimer(hWnd, startDelayMs);
+    ScheduleLocalKeyRepeat(hWnd, s_localKeyRepeatOwner.rawVk, s_localKeyRepeatOwner.rawVk);
 }
 
 static void BeginLocalKeyRepeatTracking(HWND hWnd, DWORD rawVk, UINT scanCodeWithFlags, bool isSystemKey, LPARAM sourceKeyDownLParam) {
@@ -2920,14 +2990,12 @@ static void BeginLocalKeyRepeatTracking(HWND hWnd, DWORD rawVk, UINT scanCodeWit
     state.sourceKeyDownLParam = sourceKeyDownLParam;
     state.sourceMessageTimeMs = static_cast<DWORD>(GetMessageTime());
 
+    const DWORD previousOwnerVk = s_localKeyRepeatOwnerActive ? s_localKeyRepeatOwner.rawVk : 0;
     s_localKeyRepeatHeldKeys[rawVk] = state;
     s_localKeyRepeatOwner = state;
     s_localKeyRepeatOwnerActive = true;
 
-    int startDelayMs = 250;
-    int repeatDelayMs = 33;
-    (void)GetEffectiveKeyRepeatTimings(startDelayMs, repeatDelayMs);
-    ArmLocalKeyRepeatTimer(hWnd, startDelayMs);
+    ScheduleLocalKeyRepeat(hWnd, previousOwnerVk, rawVk);
 }
 
 static bool RetargetLocalKeyRepeatAliasSource(DWORD rawVk, UINT scanCodeWithFlags, bool isSystemKey, LPARAM sourceKeyDownLParam) {
@@ -2963,6 +3031,10 @@ static bool RetargetLocalKeyRepeatAliasSource(DWORD rawVk, UINT scanCodeWithFlag
     retargetedState.sourceKeyDownLParam = sourceKeyDownLParam;
     retargetedState.sourceMessageTimeMs = messageTimeMs;
 
+    {
+        std::lock_guard<std::mutex> lock(s_localKeyRepeatSchedulerMutex);
+        (void)s_localKeyRepeatScheduler.Rekey(s_localKeyRepeatOwner.rawVk, rawVk);
+    }
     s_localKeyRepeatHeldKeys.clear();
     s_localKeyRepeatHeldKeys[rawVk] = retargetedState;
     s_localKeyRepeatOwner = retargetedState;
@@ -3029,22 +3101,13 @@ static InputHandlerResult HandleLocalKeyRepeat(HWND hWnd, UINT uMsg, WPARAM wPar
             return { true, 0 };
         }
 
-        const ULONGLONG nowMs = GetTickCount64();
-        if (s_localKeyRepeatDelayGateDeadlineMs != 0 && nowMs < s_localKeyRepeatDelayGateDeadlineMs) {
-            const ULONGLONG remainingDelayMs64 = s_localKeyRepeatDelayGateDeadlineMs - nowMs;
-            const int remainingDelayMs =
-                remainingDelayMs64 > static_cast<ULONGLONG>(0x7fffffff) ? 0x7fffffff : static_cast<int>(remainingDelayMs64);
+        if (!CollectDueLocalKeyRepeat(hWnd, s_localKeyRepeatOwner.rawVk)) {
             if (IsLocalRepeatDebugEnabled()) {
-                Log("[LocalRepeat] ignore repeat tick before due time remainingMs=" + std::to_string(remainingDelayMs));
+                Log("[LocalRepeat] ignore repeat tick before due time");
             }
-            ArmLocalKeyRepeatTimer(hWnd, remainingDelayMs);
             return { true, 0 };
         }
-        s_localKeyRepeatDelayGateDeadlineMs = 0;
 
-        int startDelayMs = 250;
-        int repeatDelayMs = 33;
-        (void)GetEffectiveKeyRepeatTimings(startDelayMs, repeatDelayMs);
         if (!PostLocalKeyRepeatKeyDown(hWnd)) {
             if (IsLocalRepeatDebugEnabled()) {
                 Log("[LocalRepeat] reset on repeat tick because posting repeat keydown failed");
@@ -3052,8 +3115,6 @@ static InputHandlerResult HandleLocalKeyRepeat(HWND hWnd, UINT uMsg, WPARAM wPar
             ResetLocalKeyRepeatState(hWnd);
             return { true, 0 };
         }
-
-        ArmLocalKeyRepeatTimer(hWnd, repeatDelayMs);
         return { true, 0 };
     }
 
@@ -3637,11 +3698,12 @@ static bool ShouldDeepSuppressLowLevelModifierKey(DWORD rawVk) {
 
     const bool cursorVisible = IsCursorVisible();
     const KeyRebind* matchedRebind = FindPreferredEnabledKeyRebind(
-        cfg->keyRebinds.rebinds,
+        cfg,
+        rawVk,
+        rawVk,
         cursorVisible,
         [&](const KeyRebind& rebind) {
             if (!IsDeepSuppressionEligibleSourceVk(rebind.fromKey)) return false;
-            if (!MatchesRebindSourceKey(rawVk, rawVk, rebind.fromKey)) return false;
             if ((cfg->keyRebinds.allowSystemAltTab || cfg->keyRebinds.allowSystemAltF4) && IsAltVk(rawVk) && IsAltVk(rebind.fromKey)) {
                 return false;
             }
@@ -3756,7 +3818,7 @@ static void EnsureLowLevelKeyboardHookInstalled() {
         return;
     }
 
-    LogCategory("init", "Installed low-level keyboard hook for exact modifier tracking and deep key rebind suppression.");
+    LOG_CATEGORY(Init, "Installed low-level keyboard hook for exact modifier tracking and deep key rebind suppression.");
 }
 
 static bool HasDeepSuppressionEligibleEnabledRebind() {
@@ -3846,7 +3908,7 @@ static void UninstallLowLevelKeyboardHook() {
         return;
     }
 
-    LogCategory("init", "Uninstalled low-level keyboard hook for exact modifier tracking and deep key rebind suppression.");
+    LOG_CATEGORY(Init, "Uninstalled low-level keyboard hook for exact modifier tracking and deep key rebind suppression.");
 }
 
 static void UpdateLowLevelKeyboardHookInstalledState() {
@@ -4653,10 +4715,8 @@ InputHandlerResult HandleKeyRebinding(HWND hWnd, UINT uMsg, WPARAM wParam, LPARA
     }
 
     const DWORD matchVk = isMouseButton ? vkCode : NormalizeModifierVkFromKeyMessage(rawVkCode, lParam);
-    const KeyRebind* matchedRebind = FindPreferredEnabledKeyRebind(
-        rebindCfg->keyRebinds.rebinds,
-        cursorVisible,
-        [&](const KeyRebind& rebind) { return MatchesRebindSourceKey(matchVk, rawVkCode, rebind.fromKey); });
+    const KeyRebind* matchedRebind =
+        FindPreferredEnabledKeyRebind(rebindCfg, matchVk, rawVkCode, cursorVisible, [](const KeyRebind&) { return true; });
     if (matchedRebind != nullptr) {
         if (isKeyDown && !isAutoRepeatKeyDown) {
             s_unreboundKeyDownVks.erase(passthroughVk);
@@ -5100,6 +5160,61 @@ static InputHandlerResult HandleShiftHotkeyPolling(HWND hWnd, UINT uMsg, WPARAM
     return { true, anyConsumed ? lastResult.result : 0 };
 }
 
+static InputTraceRecorder s_inputTraceRecorder;
+static InputStageTimings s_inputStageTimings;
+static std::atomic<bool> s_inputStageTimingEnabled{ false };
+
+// Messages worth replaying: input, plus the focus and size changes that input handling depends on. What the chain
+// sends itself (WM_TOOLSCREEN_* messages, tagged local repeats) is left out; replaying the originals regenerates it.
+static bool IsTraceableInputMessage(UINT uMsg) {
+    if (uMsg >= WM_KEYFIRST && uMsg <= WM_KEYLAST) return true;
+    if (uMsg >= WM_MOUSEFIRST && uMsg <= WM_MOUSELAST) return true;
+    switch (uMsg) {
+    case WM_INPUT:
+    case WM_ACTIVATE:
+    case WM_ACTIVATEAPP:
+    case WM_SETFOCUS:
+    case WM_KILLFOCUS:
+    case WM_SIZE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void StartInputTraceRecording() { s_inputTraceRecorder.Start(); }
+
+std::vector<InputTraceEvent> StopInputTraceRecording() { return s_inputTraceRecorder.Stop(); }
+
+bool IsInputTraceRecording() { return s_inputTraceRecorder.IsRecording(); }
+
+void RecordRawMouseInputForTrace(const RAWMOUSE& mouse) {
+    if (!s_inputTraceRecorder.IsRecording()) return;
+    InputTraceEvent event;
+    event.kind = InputTraceEventKind::RawMouse;
+    event.rawDx = static_cast<int32_t>(mouse.lLastX);
+    event.rawDy = static_cast<int32_t>(mouse.lLastY);
+    event.rawButtonFlags = mouse.usButtonFlags;
+    event.rawFlags = mouse.usFlags;
+    s_inputTraceRecorder.Record(event);
+}
+
+void SetInputStageTimingEnabled(bool enabled) { s_inputStageTimingEnabled.store(enabled, std::memory_order_relaxed); }
+
+std::vector<InputStageStats> GetInputStageTimings() { return s_inputStageTimings.Snapshot(); }
+
+void ResetInputStageTimings() { s_inputStageTimings.Reset(); }
+
+// Runs one stage of the chain, timing it only while stage timing is enabled.
+template <typename Handler> static InputHandlerResult RunInputStage(const char* stage, Handler&& handler) {
+    if (!s_inputStageTimingEnabled.load(std::memory_order_relaxed)) { return handler(); }
+    const auto start = std::chrono::steady_clock::now();
+    const InputHandlerResult result = handler();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    s_inputStageTimings.Record(stage, static_cast<uint64_t>(elapsed.count()), result.consumed);
+    return result;
+}
+
 LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     PROFILE_SCOPE("SubclassedWndProc");
 
@@ -5113,6 +5228,14 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
         return DefWindowProc(hWnd, uMsg, wParam, lParam);
     }
 
+    if (!isLocalRepeatTagged && s_inputTraceRecorder.IsRecording() && IsTraceableInputMessage(uMsg)) {
+        InputTraceEvent event;
+        event.message = uMsg;
+        event.wParam = static_cast<uint64_t>(wParam);
+        event.lParam = static_cast<int64_t>(lParam);
+        s_inputTraceRecorder.Record(event);
+    }
+
     ScopedExactKeyboardMessageState scopedKeyboardMessageState(uMsg, wParam, lParam);
 
     const bool guiOpen = g_showGui.load(std::memory_order_acquire);
@@ -5131,10 +5254,10 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
 
     InputHandlerResult result;
 
-    result = HandleShiftHotkeyPolling(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ShiftHotkeyPolling", [&] { return HandleShiftHotkeyPolling(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleLocalKeyRepeat(hWnd, uMsg, wParam, lParam, isLocalRepeatTagged);
+    result = RunInputStage("LocalKeyRepeat", [&] { return HandleLocalKeyRepeat(hWnd, uMsg, wParam, lParam, isLocalRepeatTagged); });
     if (result.consumed) return result.result;
 
     if (!isLocalRepeatTagged) {
@@ -5144,13 +5267,13 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     // Keep all window metrics/cache updates in one place to avoid split-brain resize state.
     SyncWindowMetricsFromMessage(hWnd, uMsg, wParam, lParam);
 
-    result = HandleShutdownCheck(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ShutdownCheck", [&] { return HandleShutdownCheck(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleWindowValidation(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("WindowValidation", [&] { return HandleWindowValidation(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleToolscreenQueryMessages(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ToolscreenQueryMessages", [&] { return HandleToolscreenQueryMessages(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     if (uMsg == WM_TOOLSCREEN_APPLY_FOCUS_REGAIN_SIZE) {
@@ -5159,7 +5282,7 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
         return 0;
     }
 
-    result = HandleInjectedMenuMaskKey(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("InjectedMenuMaskKey", [&] { return HandleInjectedMenuMaskKey(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     switch (uMsg) {
@@ -5182,58 +5305,58 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
         break;
     }
 
-    result = HandleBorderlessToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("BorderlessToggle", [&] { return HandleBorderlessToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleImageOverlaysToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ImageOverlaysToggle", [&] { return HandleImageOverlaysToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
-    result = HandleWindowOverlaysToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("WindowOverlaysToggle", [&] { return HandleWindowOverlaysToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
-    result = HandleNinjabrainOverlayToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("NinjabrainOverlayToggle", [&] { return HandleNinjabrainOverlayToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
-    result = HandleKeyRebindsToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("KeyRebindsToggle", [&] { return HandleKeyRebindsToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     //HandleCharLogging(uMsg, wParam, lParam);
 
-    result = HandleAltF4(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("AltF4", [&] { return HandleAltF4(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleConfigLoadFailure(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ConfigLoadFailure", [&] { return HandleConfigLoadFailure(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     if (uMsg == WM_SETCURSOR) {
         const std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
-        result = HandleSetCursor(hWnd, uMsg, wParam, lParam, localGameState);
+        result = RunInputStage("SetCursor", [&] { return HandleSetCursor(hWnd, uMsg, wParam, lParam, localGameState); });
         if (result.consumed) return result.result;
     }
 
-    result = HandleDestroy(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("Destroy", [&] { return HandleDestroy(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     if (g_isShuttingDown.load()) { return CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam); }
 
-    result = HandleImGuiInput(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("ImGuiInput", [&] { return HandleImGuiInput(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleGuiToggle(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("GuiToggle", [&] { return HandleGuiToggle(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleWindowOverlayKeyboard(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("WindowOverlayKeyboard", [&] { return HandleWindowOverlayKeyboard(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleWindowOverlayMouse(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("WindowOverlayMouse", [&] { return HandleWindowOverlayMouse(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleGuiInputBlocking(uMsg);
+    result = RunInputStage("GuiInputBlocking", [&] { return HandleGuiInputBlocking(uMsg); });
     if (result.consumed) return result.result;
 
-    result = HandleActivate(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("Activate", [&] { return HandleActivate(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
     if (uMsg == WM_SIZE) {
         const std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-        result = HandleWmSizeModeDimensions(hWnd, uMsg, wParam, lParam, currentModeId);
+        result = RunInputStage("WmSizeModeDimensions", [&] { return HandleWmSizeModeDimensions(hWnd, uMsg, wParam, lParam, currentModeId); });
         if (result.consumed) return result.result;
     }
 
@@ -5252,7 +5375,7 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
     case WM_MBUTTONUP: {
         const std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
         const std::string localGameState = g_gameStateBuffers[g_currentGameStateIndex.load(std::memory_order_acquire)];
-        result = HandleHotkeys(hWnd, uMsg, wParam, lParam, currentModeId, localGameState);
+        result = RunInputStage("Hotkeys", [&] { return HandleHotkeys(hWnd, uMsg, wParam, lParam, currentModeId, localGameState); });
         if (result.consumed) return result.result;
         break;
     }
@@ -5260,22 +5383,25 @@ LRESULT CALLBACK SubclassedWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
         break;
     }
 
-    result = HandleMouseCoordinateTranslationPhase(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("MouseCoordinateTranslationPhase",
+                           [&] { return HandleMouseCoordinateTranslationPhase(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleCustomKeyNoRebind(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("CustomKeyNoRebind", [&] { return HandleCustomKeyNoRebind(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleKeyRebinding(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("KeyRebinding", [&] { return HandleKeyRebinding(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleCustomCharNoRebind(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("CustomCharNoRebind", [&] { return HandleCustomCharNoRebind(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    result = HandleCharRebinding(hWnd, uMsg, wParam, lParam);
+    result = RunInputStage("CharRebinding", [&] { return HandleCharRebinding(hWnd, uMsg, wParam, lParam); });
     if (result.consumed) return result.result;
 
-    const LRESULT forwarded = CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam);
+    const LRESULT forwarded = RunInputStage("ForwardToGame", [&] {
+                                  return InputHandlerResult{ true, CallWindowProc(g_originalWndProc, hWnd, uMsg, wParam, lParam) };
+                              }).result;
     if (IsFocusGainMessage(uMsg) && s_deferredFocusRegainWmSizePending.exchange(false, std::memory_order_relaxed)) {
         QueueDeferredFocusRegainWmSize(hWnd);
     }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "input_trace.h"
+
 #include <atomic>
 #include <Windows.h>
 #include <string>
+#include <vector>
 
 extern WNDPROC g_originalWndProc;
 extern std::atomic<HWND> g_subclassedHwnd;
@@ -81,6 +84,18 @@ void ReleaseHeldPassthroughRebindSources(HWND hWnd);
 
 bool IsKeyCurrentlyLowLevelSuppressed(DWORD vk);
 
+// Input tracing. While recording, the input messages SubclassedWndProc receives (and raw mouse packets reported by
+// the raw input hook) are captured for replay; see input_trace.h.
+void StartInputTraceRecording();
+std::vector<InputTraceEvent> StopInputTraceRecording();
+bool IsInputTraceRecording();
+void RecordRawMouseInputForTrace(const RAWMOUSE& mouse);
+
+// Per-handler timing of SubclassedWndProc's chain. Off by default; costs two clock reads per stage when on.
+void SetInputStageTimingEnabled(bool enabled);
+std::vector<InputStageStats> GetInputStageTimings();
+void ResetInputStageTimings();
+
 #ifdef TOOLSCREEN_GUI_INTEGRATION_TESTS
 void ClearLowLevelSuppressedKeysForTest();
 void ResetSyntheticRebindKeyEventsForTest();
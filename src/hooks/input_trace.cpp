@@ -0,0 +1,282 @@
+#include "input_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+constexpr uint8_t kMagic[4] = { 'T', 'S', 'I', 'T' };
+constexpr uint8_t kVersion = 1;
+// Smallest encoded record: timestamp delta, kind and three one-byte message fields.
+constexpr size_t kMinRecordBytes = 5;
+
+void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t ZigZag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+
+int64_t UnZigZag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+class TraceReader {
+  public:
+    TraceReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    size_t Remaining() const { return m_size - m_pos; }
+
+    bool Byte(uint8_t& out) {
+        if (m_pos >= m_size) { return false; }
+        out = m_data[m_pos++];
+        return true;
+    }
+
+    bool Varint(uint64_t& out) {
+        out = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!Byte(byte)) { return false; }
+            // The tenth byte may only carry the top bit of a 64-bit value.
+            if (shift == 63 && byte > 1) { return false; }
+            out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) { return true; }
+        }
+        return false;
+    }
+
+    template <typename T> bool Unsigned(T& out) {
+        uint64_t value = 0;
+        if (!Varint(value) || value > static_cast<uint64_t>((std::numeric_limits<T>::max)())) { return false; }
+        out = static_cast<T>(value);
+        return true;
+    }
+
+    template <typename T> bool Signed(T& out) {
+        uint64_t encoded = 0;
+        if (!Varint(encoded)) { return false; }
+        const int64_t value = UnZigZag(encoded);
+        if (value < static_cast<int64_t>((std::numeric_limits<T>::min)()) || value > static_cast<int64_t>((std::numeric_limits<T>::max)())) {
+            return false;
+        }
+        out = static_cast<T>(value);
+        return true;
+    }
+
+  private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+bool DecodeEvents(TraceReader& reader, std::vector<InputTraceEvent>& outEvents) {
+    for (size_t i = 0; i < 4; ++i) {
+        uint8_t byte = 0;
+        if (!reader.Byte(byte) || byte != kMagic[i]) { return false; }
+    }
+    uint8_t version = 0;
+    if (!reader.Byte(version) || version != kVersion) { return false; }
+
+    uint64_t count = 0;
+    if (!reader.Varint(count) || count > reader.Remaining() / kMinRecordBytes) { return false; }
+    outEvents.reserve(static_cast<size_t>(count));
+
+    uint64_t timestampUs = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        InputTraceEvent event;
+        uint64_t delta = 0;
+        uint8_t kind = 0;
+        if (!reader.Varint(delta) || timestampUs + delta < timestampUs || !reader.Byte(kind)) { return false; }
+        timestampUs += delta;
+        event.timestampUs = timestampUs;
+
+        switch (static_cast<InputTraceEventKind>(kind)) {
+        case InputTraceEventKind::WindowMessage:
+            event.kind = InputTraceEventKind::WindowMessage;
+            if (!reader.Unsigned(event.message) || !reader.Varint(event.wParam) || !reader.Signed(event.lParam)) { return false; }
+            break;
+        case InputTraceEventKind::RawMouse:
+            event.kind = InputTraceEventKind::RawMouse;
+            if (!reader.Signed(event.rawDx) || !reader.Signed(event.rawDy) || !reader.Unsigned(event.rawButtonFlags) ||
+                !reader.Unsigned(event.rawFlags)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+        outEvents.push_back(event);
+    }
+    return reader.Remaining() == 0;
+}
+
+size_t BucketFor(uint64_t elapsedNs) {
+    size_t bucket = 0;
+    while (elapsedNs != 0 && bucket + 1 < InputStageTimings::kBucketCount) {
+        elapsedNs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint64_t BucketUpperBound(size_t bucket) { return bucket == 0 ? 0 : (uint64_t{ 1 } << bucket) - 1; }
+
+}  // namespace
+
+std::vector<uint8_t> EncodeInputTrace(const std::vector<InputTraceEvent>& events) {
+    std::vector<uint8_t> out;
+    out.reserve(16 + events.size() * 8);
+    out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+    out.push_back(kVersion);
+    PutVarint(out, events.size());
+
+    uint64_t previousUs = 0;
+    for (const InputTraceEvent& event : events) {
+        // Out-of-order stamps (a late raw packet racing a message) are clamped rather than corrupting the deltas.
+        const uint64_t timestampUs = (std::max)(event.timestampUs, previousUs);
+        PutVarint(out, timestampUs - previousUs);
+        previousUs = timestampUs;
+        out.push_back(static_cast<uint8_t>(event.kind));
+        if (event.kind == InputTraceEventKind::RawMouse) {
+            PutVarint(out, ZigZag(event.rawDx));
+            PutVarint(out, ZigZag(event.rawDy));
+            PutVarint(out, event.rawButtonFlags);
+            PutVarint(out, event.rawFlags);
+        } else {
+            PutVarint(out, event.message);
+            PutVarint(out, event.wParam);
+            PutVarint(out, ZigZag(event.lParam));
+        }
+    }
+    return out;
+}
+
+bool DecodeInputTrace(const uint8_t* data, size_t size, std::vector<InputTraceEvent>& outEvents) {
+    outEvents.clear();
+    if (data == nullptr && size != 0) { return false; }
+    TraceReader reader(data, size);
+    if (!DecodeEvents(reader, outEvents)) {
+        outEvents.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SaveInputTraceFile(const std::filesystem::path& path, const std::vector<InputTraceEvent>& events) {
+    const std::vector<uint8_t> encoded = EncodeInputTrace(events);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) { return false; }
+    file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    return static_cast<bool>(file);
+}
+
+bool LoadInputTraceFile(const std::filesystem::path& path, std::vector<InputTraceEvent>& outEvents) {
+    outEvents.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) { return false; }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return DecodeInputTrace(data.data(), data.size(), outEvents);
+}
+
+void InputTraceRecorder::Start(size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+    m_maxEvents = maxEvents;
+    m_dropped = 0;
+    m_start = std::chrono::steady_clock::now();
+    m_recording.store(true, std::memory_order_relaxed);
+}
+
+std::vector<InputTraceEvent> InputTraceRecorder::Stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_recording.store(false, std::memory_order_relaxed);
+    return std::move(m_events);
+}
+
+void InputTraceRecorder::Record(InputTraceEvent event) {
+    if (!IsRecording()) { return; }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Re-checked under the lock so nothing lands after Stop() handed the events over.
+    if (!m_recording.load(std::memory_order_relaxed)) { return; }
+    if (m_events.size() >= m_maxEvents) {
+        ++m_dropped;
+        return;
+    }
+    event.timestampUs =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+    m_events.push_back(event);
+}
+
+size_t InputTraceRecorder::DroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void InputStageTimings::Record(const char* stage, uint64_t elapsedNs, bool consumed) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_stages.begin(), m_stages.end(), [stage](const Stage& s) { return s.name == stage; });
+    if (it == m_stages.end()) {
+        it = std::find_if(m_stages.begin(), m_stages.end(), [stage](const Stage& s) { return std::string_view(s.name) == stage; });
+    }
+    if (it == m_stages.end()) {
+        m_stages.emplace_back();
+        it = std::prev(m_stages.end());
+        it->name = stage;
+    }
+    ++it->calls;
+    if (consumed) { ++it->consumed; }
+    it->totalNs += elapsedNs;
+    it->maxNs = (std::max)(it->maxNs, elapsedNs);
+    ++it->buckets[BucketFor(elapsedNs)];
+}
+
+std::vector<InputStageStats> InputStageTimings::Snapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<InputStageStats> stats;
+    stats.reserve(m_stages.size());
+    for (const Stage& stage : m_stages) {
+        InputStageStats s;
+        s.name = stage.name;
+        s.calls = stage.calls;
+        s.consumed = stage.consumed;
+        s.totalNs = stage.totalNs;
+        s.maxNs = stage.maxNs;
+
+        const auto percentile = [&stage](uint64_t permille) {
+            const uint64_t rank = (stage.calls * permille + 999) / 1000;
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+                seen += stage.buckets[bucket];
+                if (seen >= rank && seen != 0) { return (std::min)(BucketUpperBound(bucket), stage.maxNs); }
+            }
+            return stage.maxNs;
+        };
+        s.p50Ns = percentile(500);
+        s.p99Ns = percentile(990);
+        stats.push_back(std::move(s));
+    }
+    return stats;
+}
+
+void InputStageTimings::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stages.clear();
+}
+
+std::string FormatInputStageReport(const std::vector<InputStageStats>& stats) {
+    std::ostringstream out;
+    uint64_t totalNs = 0;
+    for (const InputStageStats& s : stats) {
+        totalNs += s.totalNs;
+        const uint64_t meanNs = s.calls != 0 ? s.totalNs / s.calls : 0;
+        out << s.name << ": calls=" << s.calls << " consumed=" << s.consumed << " mean=" << meanNs << "ns p50<=" << s.p50Ns
+            << "ns p99<=" << s.p99Ns << "ns max=" << s.maxNs << "ns\n";
+    }
+    out << "total: " << totalNs << "ns\n";
+    return out.str();
+}
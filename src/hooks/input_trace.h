@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Recording and replay support for the window procedure's input path.
+//
+// A trace is the stream of messages SubclassedWndProc saw (plus relative raw mouse packets), timestamped in
+// microseconds since recording started. Traces are stored in a compact binary form: a small header, then one record
+// per event with a delta-encoded timestamp and varint fields, so a minute of play is a few hundred KiB at most.
+// InputStageTimings accumulates how long each handler stage of the chain takes, for the replay benchmark.
+
+enum class InputTraceEventKind : uint8_t {
+    WindowMessage = 0,
+    RawMouse = 1,
+};
+
+struct InputTraceEvent {
+    uint64_t timestampUs = 0;
+    InputTraceEventKind kind = InputTraceEventKind::WindowMessage;
+
+    // WindowMessage
+    uint32_t message = 0;
+    uint64_t wParam = 0;
+    int64_t lParam = 0;
+
+    // RawMouse (RAWMOUSE fields)
+    int32_t rawDx = 0;
+    int32_t rawDy = 0;
+    uint16_t rawButtonFlags = 0;
+    uint16_t rawFlags = 0;
+
+    bool operator==(const InputTraceEvent&) const = default;
+};
+
+// Serializes events in order; timestamps must not decrease.
+std::vector<uint8_t> EncodeInputTrace(const std::vector<InputTraceEvent>& events);
+
+// Returns false (leaving outEvents empty) for anything that is not a complete, well-formed trace.
+bool DecodeInputTrace(const uint8_t* data, size_t size, std::vector<InputTraceEvent>& outEvents);
+
+bool SaveInputTraceFile(const std::filesystem::path& path, const std::vector<InputTraceEvent>& events);
+bool LoadInputTraceFile(const std::filesystem::path& path, std::vector<InputTraceEvent>& outEvents);
+
+// Collects events from the input threads while active. Record() is a relaxed load when not recording.
+class InputTraceRecorder {
+  public:
+    static constexpr size_t kDefaultMaxEvents = 1u << 20;
+
+    void Start(size_t maxEvents = kDefaultMaxEvents);
+    // Stops recording and hands over what was captured.
+    std::vector<InputTraceEvent> Stop();
+
+    bool IsRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+    // Stamps the event with the time since Start(). Events past maxEvents are counted and dropped.
+    void Record(InputTraceEvent event);
+
+    size_t DroppedCount() const;
+
+  private:
+    std::atomic<bool> m_recording{ false };
+    mutable std::mutex m_mutex;
+    std::vector<InputTraceEvent> m_events;
+    size_t m_maxEvents = kDefaultMaxEvents;
+    size_t m_dropped = 0;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+struct InputStageStats {
+    std::string name;
+    uint64_t calls = 0;
+    // Calls where the stage consumed the message, ending the chain.
+    uint64_t consumed = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    // Upper bounds of the power-of-two bucket holding the percentile.
+    uint64_t p50Ns = 0;
+    uint64_t p99Ns = 0;
+};
+
+// Per-stage latency accumulator. Stages are reported in the order they were first seen, which for the window
+// procedure is chain order.
+class InputStageTimings {
+  public:
+    // Power-of-two latency buckets; the last one is open-ended.
+    static constexpr size_t kBucketCount = 40;
+
+    // stage must be a string literal (or otherwise outlive this object); it is compared by address first.
+    void Record(const char* stage, uint64_t elapsedNs, bool consumed);
+
+    std::vector<InputStageStats> Snapshot() const;
+    void Reset();
+
+  private:
+    struct Stage {
+        const char* name = nullptr;
+        uint64_t calls = 0;
+        uint64_t consumed = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t buckets[kBucketCount] = {};
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Stage> m_stages;
+};
+
+// One line per stage: calls, consumed, mean, p50, p99 and max, plus a total line.
+std::string FormatInputStageReport(const std::vector<InputStageStats>& stats);
@@ -0,0 +1,206 @@
+#include "key_repeat_scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+int64_t FloorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+size_t SlotOf(int64_t tick) {
+    const int64_t slotCount = static_cast<int64_t>(KeyRepeatScheduler::kSlotCount);
+    return static_cast<size_t>(((tick % slotCount) + slotCount) % slotCount);
+}
+
+}  // namespace
+
+KeyRepeatScheduler::KeyRepeatScheduler(const KeyRepeatSchedulerOptions& options) : m_options(options) {
+    m_options.tickNs = (std::max)(m_options.tickNs, int64_t{ 1 });
+    m_options.coalesceToleranceNs = (std::max)(m_options.coalesceToleranceNs, int64_t{ 0 });
+}
+
+void KeyRepeatScheduler::Press(uint32_t key, int64_t nowNs, int64_t startDelayNs, int64_t intervalNs) {
+    size_t entryIndex = 0;
+    auto it = m_keyToEntry.find(key);
+    if (it != m_keyToEntry.end()) {
+        entryIndex = it->second;
+        Unlink(entryIndex);
+    } else if (!m_freeEntries.empty()) {
+        entryIndex = m_freeEntries.back();
+        m_freeEntries.pop_back();
+        m_keyToEntry.emplace(key, entryIndex);
+    } else {
+        entryIndex = m_entries.size();
+        m_entries.emplace_back();
+        m_keyToEntry.emplace(key, entryIndex);
+    }
+
+    Entry& entry = m_entries[entryIndex];
+    entry.key = key;
+    entry.startDelayNs = (std::max)(startDelayNs, int64_t{ 0 });
+    entry.intervalNs = (std::max)(intervalNs, int64_t{ 1 });
+    entry.firstDueNs = nowNs + entry.startDelayNs;
+    entry.repeatIndex = 0;
+    entry.dueNs = entry.firstDueNs;
+    if (!m_hasCursor) {
+        m_hasCursor = true;
+        m_cursorTick = TickOf(nowNs);
+    }
+    Link(entryIndex);
+}
+
+bool KeyRepeatScheduler::Release(uint32_t key) {
+    auto it = m_keyToEntry.find(key);
+    if (it == m_keyToEntry.end()) { return false; }
+    const size_t entryIndex = it->second;
+    m_keyToEntry.erase(it);
+    Unlink(entryIndex);
+    FreeEntry(entryIndex);
+    return true;
+}
+
+bool KeyRepeatScheduler::Rekey(uint32_t key, uint32_t newKey) {
+    auto it = m_keyToEntry.find(key);
+    if (it == m_keyToEntry.end()) { return false; }
+    if (key == newKey) { return true; }
+
+    const size_t entryIndex = it->second;
+    m_keyToEntry.erase(it);
+    (void)Release(newKey);
+    m_entries[entryIndex].key = newKey;
+    m_keyToEntry.emplace(newKey, entryIndex);
+    return true;
+}
+
+bool KeyRepeatScheduler::RestartDelay(uint32_t key, int64_t nowNs) {
+    auto it = m_keyToEntry.find(key);
+    if (it == m_keyToEntry.end()) { return false; }
+    const Entry& entry = m_entries[it->second];
+    Press(key, nowNs, entry.startDelayNs, entry.intervalNs);
+    return true;
+}
+
+void KeyRepeatScheduler::Clear() {
+    m_entries.clear();
+    m_freeEntries.clear();
+    for (auto& slot : m_slots) { slot.clear(); }
+    m_keyToEntry.clear();
+    m_hasCursor = false;
+}
+
+std::optional<int64_t> KeyRepeatScheduler::NextDeadlineNs() const {
+    if (m_keyToEntry.empty()) { return std::nullopt; }
+
+    // Walk one revolution from the cursor; the first slot holding a deadline for its own tick has the earliest one.
+    for (int64_t tick = m_cursorTick; tick < m_cursorTick + static_cast<int64_t>(kSlotCount); ++tick) {
+        std::optional<int64_t> earliest;
+        for (size_t entryIndex : m_slots[SlotOf(tick)]) {
+            const Entry& entry = m_entries[entryIndex];
+            if (TickOf(entry.dueNs) > tick) { continue; }
+            if (!earliest || entry.dueNs < *earliest) { earliest = entry.dueNs; }
+        }
+        if (earliest) { return earliest; }
+    }
+
+    // Everything is more than a revolution away.
+    std::optional<int64_t> earliest;
+    for (const auto& [key, entryIndex] : m_keyToEntry) {
+        const int64_t dueNs = m_entries[entryIndex].dueNs;
+        if (!earliest || dueNs < *earliest) { earliest = dueNs; }
+    }
+    return earliest;
+}
+
+size_t KeyRepeatScheduler::Collect(int64_t nowNs, std::vector<KeyRepeatFire>& out) {
+    if (!m_hasCursor) {
+        m_hasCursor = true;
+        m_cursorTick = TickOf(nowNs);
+    }
+
+    std::vector<size_t> dueEntries;
+    const int64_t limitTick = TickOf(nowNs + m_options.coalesceToleranceNs);
+    const auto gatherSlot = [&](size_t slot) {
+        for (size_t entryIndex : m_slots[slot]) {
+            const Entry& entry = m_entries[entryIndex];
+            if (entry.dueNs <= nowNs + ToleranceFor(entry)) { dueEntries.push_back(entryIndex); }
+        }
+    };
+    if (limitTick - m_cursorTick + 1 >= static_cast<int64_t>(kSlotCount)) {
+        for (size_t slot = 0; slot < kSlotCount; ++slot) { gatherSlot(slot); }
+    } else {
+        for (int64_t tick = m_cursorTick; tick <= limitTick; ++tick) { gatherSlot(SlotOf(tick)); }
+    }
+    m_cursorTick = (std::max)(m_cursorTick, TickOf(nowNs));
+    if (dueEntries.empty()) { return 0; }
+
+    std::sort(dueEntries.begin(), dueEntries.end(), [this](size_t a, size_t b) {
+        const Entry& lhs = m_entries[a];
+        const Entry& rhs = m_entries[b];
+        return lhs.dueNs != rhs.dueNs ? lhs.dueNs < rhs.dueNs : lhs.key < rhs.key;
+    });
+
+    for (size_t entryIndex : dueEntries) {
+        Entry& entry = m_entries[entryIndex];
+        KeyRepeatFire fire;
+        fire.key = entry.key;
+        fire.repeatIndex = entry.repeatIndex;
+        fire.dueNs = entry.dueNs;
+        fire.firedNs = nowNs;
+        out.push_back(fire);
+
+        const int64_t errorNs = nowNs - entry.dueNs;
+        ++m_stats.fires;
+        m_stats.totalAbsErrorNs += std::llabs(errorNs);
+        if (errorNs < 0) {
+            ++m_stats.coalesced;
+            m_stats.maxEarlyNs = (std::max)(m_stats.maxEarlyNs, -errorNs);
+        } else {
+            m_stats.maxLateNs = (std::max)(m_stats.maxLateNs, errorNs);
+        }
+
+        Unlink(entryIndex);
+        ++entry.repeatIndex;
+        entry.dueNs = entry.firstDueNs + static_cast<int64_t>(entry.repeatIndex) * entry.intervalNs;
+        const int64_t toleranceNs = ToleranceFor(entry);
+        if (entry.dueNs <= nowNs + toleranceNs) {
+            const uint64_t missed = static_cast<uint64_t>((nowNs + toleranceNs - entry.dueNs) / entry.intervalNs) + 1;
+            entry.repeatIndex += missed;
+            entry.dueNs = entry.firstDueNs + static_cast<int64_t>(entry.repeatIndex) * entry.intervalNs;
+            m_stats.skipped += missed;
+        }
+        Link(entryIndex);
+    }
+
+    ++m_stats.wakes;
+    return dueEntries.size();
+}
+
+int64_t KeyRepeatScheduler::TickOf(int64_t ns) const {
+    return FloorDiv(ns, m_options.tickNs);
+}
+
+int64_t KeyRepeatScheduler::ToleranceFor(const Entry& entry) const {
+    return (std::min)(m_options.coalesceToleranceNs, entry.intervalNs / 2);
+}
+
+void KeyRepeatScheduler::Link(size_t entryIndex) {
+    Entry& entry = m_entries[entryIndex];
+    entry.slot = SlotOf(TickOf(entry.dueNs));
+    m_slots[entry.slot].push_back(entryIndex);
+}
+
+void KeyRepeatScheduler::Unlink(size_t entryIndex) {
+    std::vector<size_t>& slot = m_slots[m_entries[entryIndex].slot];
+    auto it = std::find(slot.begin(), slot.end(), entryIndex);
+    if (it == slot.end()) { return; }
+    *it = slot.back();
+    slot.pop_back();
+}
+
+void KeyRepeatScheduler::FreeEntry(size_t entryIndex) {
+    m_entries[entryIndex] = {};
+    m_freeEntries.push_back(entryIndex);
+}
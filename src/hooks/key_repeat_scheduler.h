@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Deadline bookkeeping for Toolscreen's local key repeat.
+//
+// Each held key repeats on its own exact grid: the first repeat is due startDelay after the press and repeat k is due
+// interval later than repeat k - 1, computed from the press time rather than from when the previous repeat fired, so
+// a long hold cannot drift. Deadlines live in a hashed timer wheel keyed by tick, so collecting due repeats only
+// visits the slots between the last collection and now. Repeats due within the coalescing tolerance of a wake fire
+// together, so keys held at nearly the same time share one timer wake. A repeat that is overdue by whole intervals
+// fires once and skips the rest instead of bursting.
+//
+// The scheduler never reads a clock: callers pass the current time, so it runs unchanged against a simulated clock.
+
+struct KeyRepeatSchedulerOptions {
+    // Width of one wheel slot.
+    int64_t tickNs = 1'000'000;
+    // Repeats due this soon after a wake fire on that wake (capped per key at half its interval).
+    int64_t coalesceToleranceNs = 1'000'000;
+};
+
+struct KeyRepeatFire {
+    uint32_t key = 0;
+    // 0 for the first repeat after the start delay.
+    uint64_t repeatIndex = 0;
+    int64_t dueNs = 0;
+    int64_t firedNs = 0;
+};
+
+struct KeyRepeatScheduleStats {
+    uint64_t fires = 0;
+    // Fired before their deadline because they fell inside the coalescing window.
+    uint64_t coalesced = 0;
+    // Dropped because the scheduler was collected more than one interval late.
+    uint64_t skipped = 0;
+    // Collect() calls that fired at least one repeat.
+    uint64_t wakes = 0;
+    // Schedule error is fired - due.
+    int64_t totalAbsErrorNs = 0;
+    int64_t maxLateNs = 0;
+    int64_t maxEarlyNs = 0;
+
+    int64_t MeanAbsErrorNs() const { return fires != 0 ? totalAbsErrorNs / static_cast<int64_t>(fires) : 0; }
+};
+
+class KeyRepeatScheduler {
+  public:
+    static constexpr size_t kSlotCount = 256;
+
+    explicit KeyRepeatScheduler(const KeyRepeatSchedulerOptions& options = {});
+
+    // Starts (or restarts) repeating key: first repeat at nowNs + startDelayNs, then every intervalNs.
+    void Press(uint32_t key, int64_t nowNs, int64_t startDelayNs, int64_t intervalNs);
+    // Stops repeating key; false if it was not scheduled.
+    bool Release(uint32_t key);
+    // Moves key's schedule to newKey, keeping its deadlines (newKey's own schedule, if any, is dropped).
+    bool Rekey(uint32_t key, uint32_t newKey);
+    // Restarts key's start delay from nowNs with its current timings.
+    bool RestartDelay(uint32_t key, int64_t nowNs);
+    void Clear();
+
+    bool IsScheduled(uint32_t key) const { return m_keyToEntry.find(key) != m_keyToEntry.end(); }
+    size_t ScheduledCount() const { return m_keyToEntry.size(); }
+
+    // Earliest pending deadline, or nullopt when nothing repeats. Valid after Collect() for the current time.
+    std::optional<int64_t> NextDeadlineNs() const;
+
+    // Appends every repeat due by nowNs (plus the coalescing tolerance) to out, oldest deadline first, and schedules
+    // the following repeat of each. Returns how many fired.
+    size_t Collect(int64_t nowNs, std::vector<KeyRepeatFire>& out);
+
+    const KeyRepeatScheduleStats& Stats() const { return m_stats; }
+    void ResetStats() { m_stats = {}; }
+
+  private:
+    struct Entry {
+        uint32_t key = 0;
+        int64_t firstDueNs = 0;
+        int64_t intervalNs = 0;
+        int64_t startDelayNs = 0;
+        uint64_t repeatIndex = 0;
+        int64_t dueNs = 0;
+        size_t slot = 0;
+    };
+
+    int64_t TickOf(int64_t ns) const;
+    int64_t ToleranceFor(const Entry& entry) const;
+    void Link(size_t entryIndex);
+    void Unlink(size_t entryIndex);
+    void FreeEntry(size_t entryIndex);
+
+    KeyRepeatSchedulerOptions m_options;
+    std::vector<Entry> m_entries;
+    std::vector<size_t> m_freeEntries;
+    std::array<std::vector<size_t>, kSlotCount> m_slots;
+    std::unordered_map<uint32_t, size_t> m_keyToEntry;
+    int64_t m_cursorTick = 0;
+    bool m_hasCursor = false;
+    KeyRepeatScheduleStats m_stats;
+};
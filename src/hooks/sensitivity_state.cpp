@@ -0,0 +1,87 @@
+#include "sensitivity_state.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+std::atomic<SensitivityState> g_sensitivityState{ SensitivityState{} };
+
+// Rounds a 16.16 value to the nearest integer, halves away from zero (like std::round).
+int64_t RoundFixedToInt(int64_t value) {
+    constexpr int64_t kHalf = SensitivityState::kOne / 2;
+    return value >= 0 ? (value + kHalf) >> 16 : -((-value + kHalf) >> 16);
+}
+
+int32_t ClampToInt32(int64_t value) {
+    return static_cast<int32_t>((std::clamp)(value, static_cast<int64_t>((std::numeric_limits<int32_t>::min)()),
+                                             static_cast<int64_t>((std::numeric_limits<int32_t>::max)())));
+}
+
+// Scales one axis. Rounding to nearest leaves a remainder of either sign, so a reversal is detected from the previous
+// movement's direction rather than the remainder's; the remainder is then dropped so it cannot delay the reversal.
+int32_t ApplyAxis(int32_t delta, int32_t scale, int64_t& remainder, int8_t& lastDirection) {
+    if (delta != 0) {
+        const int8_t direction = delta > 0 ? 1 : -1;
+        if (direction != lastDirection) { remainder = 0; }
+        lastDirection = direction;
+    }
+    const int64_t scaled = remainder + static_cast<int64_t>(delta) * scale;
+    const int64_t output = RoundFixedToInt(scaled);
+    remainder = scaled - output * SensitivityState::kOne;
+    return ClampToInt32(output);
+}
+
+}  // namespace
+
+int32_t SensitivityToFixed(float sensitivity) {
+    if (!std::isfinite(sensitivity)) { return SensitivityState::kOne; }
+    // Far beyond any configurable sensitivity; keeps delta * scale well inside 64 bits.
+    constexpr float kMaxSensitivity = 1024.0f;
+    const float clamped = (std::clamp)(sensitivity, -kMaxSensitivity, kMaxSensitivity);
+    return static_cast<int32_t>(std::lround(static_cast<double>(clamped) * SensitivityState::kOne));
+}
+
+SensitivityState ComputeSensitivityState(const SensitivityInputs& inputs) {
+    float x = inputs.globalSensitivity;
+    float y = inputs.globalSensitivity;
+    if (inputs.overrideActive) {
+        x = inputs.overrideX;
+        y = inputs.overrideY;
+    } else if (inputs.modeOverrideEnabled) {
+        x = inputs.modeX;
+        y = inputs.modeY;
+    }
+    SensitivityState state;
+    state.scaleX = SensitivityToFixed(x);
+    state.scaleY = SensitivityToFixed(y);
+    return state;
+}
+
+void SensitivityAccumulator::Apply(const SensitivityState& state, int32_t& dx, int32_t& dy) {
+    // A new multiplier starts from a clean remainder, as does unscaled movement, so a stale fraction is never
+    // carried into a later override.
+    if (!m_hasLastState || !(state == m_lastState)) {
+        Reset();
+        m_lastState = state;
+        m_hasLastState = true;
+    }
+    if (state.IsIdentity()) {
+        Reset();
+        return;
+    }
+    dx = ApplyAxis(dx, state.scaleX, m_remainderX, m_directionX);
+    dy = ApplyAxis(dy, state.scaleY, m_remainderY, m_directionY);
+}
+
+void SensitivityAccumulator::Reset() {
+    m_remainderX = 0;
+    m_remainderY = 0;
+    m_directionX = 0;
+    m_directionY = 0;
+}
+
+void PublishSensitivityState(const SensitivityState& state) { g_sensitivityState.store(state, std::memory_order_release); }
+
+SensitivityState LoadSensitivityState() { return g_sensitivityState.load(std::memory_order_acquire); }
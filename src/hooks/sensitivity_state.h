@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Mouse sensitivity for the raw input hook, precomputed off the input path.
+//
+// The effective multipliers depend on the temporary sensitivity hotkey override, the current (or transition target)
+// mode and the config. Whoever changes one of those calls RefreshSensitivityState(), which resolves them once and
+// publishes a SensitivityState; the per-packet path is then one acquire load plus fixed-point math, with no lock,
+// config snapshot or mode lookup by name.
+
+// Multipliers in 16.16 fixed point. Eight bytes, so it is published and loaded as one lock-free atomic.
+struct SensitivityState {
+    static constexpr int32_t kOne = 1 << 16;
+
+    int32_t scaleX = kOne;
+    int32_t scaleY = kOne;
+
+    bool IsIdentity() const { return scaleX == kOne && scaleY == kOne; }
+    bool operator==(const SensitivityState&) const = default;
+};
+
+static_assert(std::atomic<SensitivityState>::is_always_lock_free, "SensitivityState must publish without a lock");
+
+struct SensitivityInputs {
+    bool overrideActive = false;
+    float overrideX = 1.0f;
+    float overrideY = 1.0f;
+    // The resolved mode's own sensitivity, when it has sensitivityOverrideEnabled.
+    bool modeOverrideEnabled = false;
+    float modeX = 1.0f;
+    float modeY = 1.0f;
+    float globalSensitivity = 1.0f;
+};
+
+// The temporary override wins over the mode's sensitivity, which wins over the global one.
+SensitivityState ComputeSensitivityState(const SensitivityInputs& inputs);
+
+int32_t SensitivityToFixed(float sensitivity);
+
+// Carries the fractional remainder of scaled movement between packets, in 16.16 fixed point. Owned by the one
+// thread that processes raw input.
+class SensitivityAccumulator {
+  public:
+    // Scales a relative movement in place.
+    void Apply(const SensitivityState& state, int32_t& dx, int32_t& dy);
+
+    void Reset();
+
+    int64_t RemainderX() const { return m_remainderX; }
+    int64_t RemainderY() const { return m_remainderY; }
+
+  private:
+    int64_t m_remainderX = 0;
+    int64_t m_remainderY = 0;
+    // Sign of the last non-zero delta per axis, 0 before any movement.
+    int8_t m_directionX = 0;
+    int8_t m_directionY = 0;
+    SensitivityState m_lastState;
+    bool m_hasLastState = false;
+};
+
+void PublishSensitivityState(const SensitivityState& state);
+SensitivityState LoadSensitivityState();
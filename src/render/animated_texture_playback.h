@@ -11,6 +11,13 @@
 #include <iterator>
 #include <vector>
 
+class MpegVideoStream;
+
+// Uploads the frame due at (now - playbackStart) into texture when it differs from
+// uploadedSequence. Defined in render.cpp so this header stays free of GL upload details.
+void AdvanceVideoStreamTexture(MpegVideoStream& stream, GLuint texture, std::chrono::steady_clock::time_point playbackStart,
+                               uint64_t& uploadedSequence);
+
 inline int GetAnimatedTextureDelayMs(const std::vector<int>& frameDelays, size_t frameIndex) {
     int delay = 100;
     if (frameIndex < frameDelays.size() && frameDelays[frameIndex] > 0) {
@@ -49,6 +56,13 @@ AnimatedTextureResolveResult<TextureInstance> ResolveAnimatedTexture(TextureInst
     AnimatedTextureResolveResult<TextureInstance> result;
     result.textureId = inst.textureId;
 
+    if constexpr (requires { inst.videoStream; }) {
+        if (inst.videoStream) {
+            AdvanceVideoStreamTexture(*inst.videoStream, inst.textureId, inst.lastFrameTime, inst.uploadedVideoSequence);
+            return result;
+        }
+    }
+
     if (!inst.isAnimated) {
         return result;
     }
@@ -0,0 +1,143 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+constexpr int64_t kNsPerSecond = 1'000'000'000;
+// Margin kept above the learned oversleep, in mean deviations.
+constexpr int64_t kOversleepDeviations = 3;
+// Smoothing of the oversleep estimate: late wakes are learned quickly, improvements slowly.
+constexpr int64_t kOversleepRiseDivisor = 4;
+constexpr int64_t kOversleepFallDivisor = 32;
+constexpr int64_t kOversleepDeviationDivisor = 8;
+// Capture alignment corrects this fraction of the phase error per frame, capped at 1/kMaxPhaseStepDivisor of a frame.
+constexpr int64_t kPhaseCorrectionDivisor = 8;
+constexpr int64_t kMaxPhaseStepDivisor = 16;
+// OBS and the limiter must run at the same rate or an integer multiple of it (within 2%) for alignment to hold.
+constexpr double kCadenceRatioTolerance = 0.02;
+
+}  // namespace
+
+FramePacerFrameResult FramePacer::Pace(const FramePacerSettings& settings, const FramePacerCaptureCadence& capture) {
+    const int64_t startNs = m_clock.NowNs();
+    FramePacerFrameResult result;
+    result.deadlineNs = startNs;
+    result.presentNs = startNs;
+    if (settings.targetFps <= 0) {
+        m_hasGrid = false;
+        return result;
+    }
+
+    const int64_t intervalNs = kNsPerSecond / settings.targetFps;
+    if (!m_hasGrid || m_gridFps != settings.targetFps) {
+        m_hasGrid = true;
+        m_gridFps = settings.targetFps;
+        m_anchorNs = startNs;
+        m_frameIndex = 0;
+    }
+    // Fold whole minutes into the anchor; the grid stays exact and frameIndex * 1e9 stays far from overflow.
+    if (m_frameIndex >= static_cast<uint64_t>(m_gridFps) * 60) {
+        m_anchorNs = GridDeadline(m_frameIndex);
+        m_frameIndex = 0;
+    }
+
+    AlignToCapture(capture, intervalNs);
+
+    ++m_frameIndex;
+    int64_t deadlineNs = GridDeadline(m_frameIndex);
+    ++m_stats.frames;
+
+    if (startNs >= deadlineNs) {
+        // A frame late by more than a whole interval starts a new grid; catching up would release a burst of frames.
+        if (startNs - deadlineNs > intervalNs) {
+            m_anchorNs = startNs;
+            m_frameIndex = 0;
+            deadlineNs = startNs;
+        }
+        ++m_stats.missedDeadlines;
+        result.deadlineNs = deadlineNs;
+        result.missedDeadline = true;
+        return result;
+    }
+    result.deadlineNs = deadlineNs;
+
+    int64_t nowNs = startNs;
+    const int64_t remainingNs = deadlineNs - startNs;
+    if (remainingNs >= settings.sleepThresholdNs && remainingNs > m_spinMarginNs) {
+        const int64_t wakeTargetNs = deadlineNs - m_spinMarginNs;
+        m_clock.SleepUntilNs(wakeTargetNs);
+        nowNs = m_clock.NowNs();
+        result.sleptNs = nowNs - startNs;
+        ++m_stats.sleeps;
+        m_stats.totalSleptNs += result.sleptNs;
+        LearnOversleep(nowNs - wakeTargetNs, settings);
+    } else if (remainingNs >= settings.sleepThresholdNs) {
+        // The margin alone swallowed a wait long enough to sleep; narrow it so a single bad wake cannot lock the
+        // pacer into spinning every frame with nothing left to learn from.
+        m_oversleepMeanNs -= m_oversleepMeanNs / kOversleepFallDivisor;
+        m_oversleepDeviationNs -= m_oversleepDeviationNs / kOversleepDeviationDivisor;
+        UpdateSpinMargin(settings);
+    }
+
+    const int64_t spinStartNs = nowNs;
+    while (nowNs < deadlineNs) {
+        m_clock.Relax();
+        nowNs = m_clock.NowNs();
+    }
+    result.spunNs = nowNs - spinStartNs;
+    result.presentNs = nowNs;
+    m_stats.totalSpunNs += result.spunNs;
+
+    const int64_t jitterNs = nowNs - deadlineNs;
+    m_stats.totalJitterNs += jitterNs;
+    m_stats.maxJitterNs = (std::max)(m_stats.maxJitterNs, jitterNs);
+    return result;
+}
+
+void FramePacer::Reset() {
+    m_hasGrid = false;
+    m_frameIndex = 0;
+}
+
+int64_t FramePacer::GridDeadline(uint64_t frameIndex) const {
+    return m_anchorNs + static_cast<int64_t>((frameIndex * static_cast<uint64_t>(kNsPerSecond)) / static_cast<uint64_t>(m_gridFps));
+}
+
+void FramePacer::AlignToCapture(const FramePacerCaptureCadence& capture, int64_t intervalNs) {
+    if (capture.intervalNs <= 0 || intervalNs <= 0) { return; }
+    const double ratio = static_cast<double>(capture.intervalNs) / static_cast<double>(intervalNs);
+    const double multiple = std::round(ratio);
+    if (multiple < 1.0 || std::fabs(ratio - multiple) > kCadenceRatioTolerance * multiple) { return; }
+
+    // Phase of the next deadline relative to "just before a capture", wrapped to (-interval/2, interval/2].
+    const int64_t nextDeadlineNs = GridDeadline(m_frameIndex + 1);
+    int64_t errorNs = (capture.lastCaptureNs - kCaptureLeadNs - nextDeadlineNs) % intervalNs;
+    if (errorNs <= -intervalNs / 2) { errorNs += intervalNs; }
+    if (errorNs > intervalNs / 2) { errorNs -= intervalNs; }
+
+    const int64_t maxStepNs = intervalNs / kMaxPhaseStepDivisor;
+    m_anchorNs += (std::clamp)(errorNs / kPhaseCorrectionDivisor, -maxStepNs, maxStepNs);
+}
+
+void FramePacer::LearnOversleep(int64_t oversleepNs, const FramePacerSettings& settings) {
+    if (!m_hasOversleepSample) {
+        m_hasOversleepSample = true;
+        // One sample says little about the spread; start wide and let the deviation settle.
+        m_oversleepMeanNs = oversleepNs;
+        m_oversleepDeviationNs = std::llabs(oversleepNs) / 2;
+    } else {
+        const int64_t delta = oversleepNs - m_oversleepMeanNs;
+        m_oversleepMeanNs += delta / (delta > 0 ? kOversleepRiseDivisor : kOversleepFallDivisor);
+        m_oversleepDeviationNs += (std::llabs(delta) - m_oversleepDeviationNs) / kOversleepDeviationDivisor;
+    }
+    UpdateSpinMargin(settings);
+}
+
+void FramePacer::UpdateSpinMargin(const FramePacerSettings& settings) {
+    const int64_t marginNs = (std::max)(m_oversleepMeanNs, int64_t{ 0 }) + kOversleepDeviations * m_oversleepDeviationNs +
+                             settings.minSpinMarginNs;
+    m_spinMarginNs = (std::clamp)(marginNs, settings.minSpinMarginNs, (std::max)(settings.minSpinMarginNs, settings.maxSpinMarginNs));
+}
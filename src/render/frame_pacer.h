@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+
+// Frame rate limiter for the SwapBuffers hook.
+//
+// Frames are presented on a deadline grid (anchor + k * interval, computed exactly so the cadence cannot drift). The
+// wait before a deadline is split into a timer sleep and a short spin: the sleep is aimed at the deadline minus a
+// spin margin, and the margin is learned from how late the timer actually wakes, so a coarse or noisy timer costs a
+// little more spinning instead of a missed deadline. Optionally the grid's phase is pulled toward the OBS capture
+// cadence so each captured frame is a freshly presented one.
+//
+// All time comes from a FramePacerClock, so the pacing logic runs unchanged against a simulated clock in tests.
+
+class FramePacerClock {
+  public:
+    virtual ~FramePacerClock() = default;
+
+    // Monotonic time in nanoseconds.
+    virtual int64_t NowNs() = 0;
+    // Blocks until roughly deadlineNs; may wake late (or early), which the pacer measures.
+    virtual void SleepUntilNs(int64_t deadlineNs) = 0;
+    // One iteration of a busy wait.
+    virtual void Relax() {}
+};
+
+struct FramePacerSettings {
+    // 0 disables pacing.
+    int targetFps = 0;
+    // Waits shorter than this are spun instead of slept (config fpsLimitSleepThreshold).
+    int64_t sleepThresholdNs = 1'000'000;
+    // Bounds of the learned spin margin.
+    int64_t minSpinMarginNs = 50'000;
+    int64_t maxSpinMarginNs = 4'000'000;
+};
+
+// Where OBS last captured a frame and how often it captures; intervalNs == 0 when unknown.
+struct FramePacerCaptureCadence {
+    int64_t lastCaptureNs = 0;
+    int64_t intervalNs = 0;
+};
+
+struct FramePacerFrameResult {
+    int64_t deadlineNs = 0;
+    int64_t presentNs = 0;
+    int64_t sleptNs = 0;
+    int64_t spunNs = 0;
+    // The frame arrived after its deadline and was released immediately.
+    bool missedDeadline = false;
+};
+
+struct FramePacerStats {
+    uint64_t frames = 0;
+    uint64_t missedDeadlines = 0;
+    uint64_t sleeps = 0;
+    // |present - deadline| over paced (not missed) frames.
+    int64_t totalJitterNs = 0;
+    int64_t maxJitterNs = 0;
+    int64_t totalSleptNs = 0;
+    int64_t totalSpunNs = 0;
+
+    int64_t MeanJitterNs() const {
+        const uint64_t paced = frames - missedDeadlines;
+        return paced != 0 ? totalJitterNs / static_cast<int64_t>(paced) : 0;
+    }
+};
+
+class FramePacer {
+  public:
+    // Presenting this close before an OBS capture tick counts as aligned.
+    static constexpr int64_t kCaptureLeadNs = 500'000;
+
+    explicit FramePacer(FramePacerClock& clock) : m_clock(clock) {}
+
+    // Waits until the next frame deadline. Call once per frame, right before presenting.
+    FramePacerFrameResult Pace(const FramePacerSettings& settings, const FramePacerCaptureCadence& capture = {});
+
+    // Forgets the grid (the next frame starts a new one) but keeps the learned timer behaviour.
+    void Reset();
+
+    const FramePacerStats& Stats() const { return m_stats; }
+    void ResetStats() { m_stats = {}; }
+
+    int64_t SpinMarginNs() const { return m_spinMarginNs; }
+    // Smoothed timer oversleep and its mean deviation, as measured so far.
+    int64_t OversleepEstimateNs() const { return m_oversleepMeanNs; }
+    int64_t OversleepDeviationNs() const { return m_oversleepDeviationNs; }
+
+  private:
+    int64_t GridDeadline(uint64_t frameIndex) const;
+    void AlignToCapture(const FramePacerCaptureCadence& capture, int64_t intervalNs);
+    void LearnOversleep(int64_t oversleepNs, const FramePacerSettings& settings);
+    void UpdateSpinMargin(const FramePacerSettings& settings);
+
+    FramePacerClock& m_clock;
+    int m_gridFps = 0;
+    bool m_hasGrid = false;
+    int64_t m_anchorNs = 0;
+    uint64_t m_frameIndex = 0;
+
+    bool m_hasOversleepSample = false;
+    int64_t m_oversleepMeanNs = 0;
+    int64_t m_oversleepDeviationNs = 0;
+    int64_t m_spinMarginNs = 1'000'000;
+
+    FramePacerStats m_stats;
+};
@@ -805,7 +805,7 @@ static GLuint MT_CreateShaderProgram(const char* vertSrc, const char* fragSrc) {
 }
 
 static bool MT_InitializeShaders() {
-    LogCategory("init", "Mirror Thread: Initializing local shaders...");
+    LOG_CATEGORY(Init, "Mirror Thread: Initializing local shaders...");
 
     mt_filterProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_frag_shader);
     mt_filterPassthroughProgram = MT_CreateShaderProgram(mt_passthrough_vert_shader, mt_filter_passthrough_frag_shader);
@@ -930,7 +930,7 @@ static bool MT_InitializeShaders() {
 
     glUseProgram(0);
 
-    LogCategory("init", "Mirror Thread: Local shaders initialized successfully");
+    LOG_CATEGORY(Init, "Mirror Thread: Local shaders initialized successfully");
     return true;
 }
 
@@ -1043,7 +1043,7 @@ void InitCaptureTexture(int width, int height) {
     g_copyTextureWriteIndex.store(0);
     g_safeReadTextureValid.store(false, std::memory_order_release);
 
-    LogCategory("init", "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
+    LOG_CATEGORY(Init, "InitCaptureTexture: Created FBO and " + std::to_string(2) + " textures of " + std::to_string(width) + "x" +
                             std::to_string(height));
 }
 
@@ -1166,7 +1166,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
 
         g_copyTextureW = width;
         g_copyTextureH = height;
-        LogCategory("texture_ops", "SubmitFrameCapture: Resized copy textures to " + std::to_string(width) + "x" + std::to_string(height));
+        LOG_CATEGORY(TextureOps, "SubmitFrameCapture: Resized copy textures to " + std::to_string(width) + "x" + std::to_string(height));
     }
 
     static GLuint srcFBO = 0;
@@ -1178,7 +1178,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (srcStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_srcIncompleteLog = 0;
         if ((++s_srcIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
+            LOG_CATEGORY(TextureOps,
                         "SubmitFrameCapture: Source FBO incomplete (status " + std::to_string(srcStatus) + ") gameTex=" +
                             std::to_string(gameTexture) + " size=" + std::to_string(width) + "x" + std::to_string(height));
         }
@@ -1195,7 +1195,7 @@ void SubmitFrameCapture(GLuint gameTexture, int width, int height) {
     if (dstStatus != GL_FRAMEBUFFER_COMPLETE) {
         static int s_dstIncompleteLog = 0;
         if ((++s_dstIncompleteLog % 240) == 1) {
-            LogCategory("texture_ops",
+            LOG_CATEGORY(TextureOps,
                         "SubmitFrameCapture: Destination FBO incomplete (status " + std::to_string(dstStatus) + ") writeIdx=" +
                             std::to_string(writeIndex) + " dstTex=" + std::to_string(g_copyTextures[writeIndex]) + " size=" +
                             std::to_string(width) + "x" + std::to_string(height));
@@ -1488,8 +1488,8 @@ static uint64_t MT_ComputeSourceRectLayoutHash(const ThreadedMirrorConfig& conf)
     for (const auto& input : conf.input) {
         hash = MT_HashBytes(hash, &input.x, sizeof(input.x));
         hash = MT_HashBytes(hash, &input.y, sizeof(input.y));
-        hash = MT_HashBytes(hash, input.relativeTo.data(), input.relativeTo.size());
     }
+    hash = MT_HashBytes(hash, conf.inputCorners.data(), conf.inputCorners.size() * sizeof(AnchorCorner));
 
     return hash;
 }
@@ -1531,10 +1531,6 @@ static void MT_BindSourceRectInstanceBufferCached(GLuint instanceVbo, MT_RenderT
     }
 }
 
-// Forward declaration needed for use in MT_GetCachedSourceRects before the full definition below
-static void MT_GetRelativeCoordsNormalized(const std::string& anchor, int relX, int relY, int w, int h, int containerW,
-                                           int containerH, int& outX, int& outY);
-
 static const std::vector<float>& MT_GetCachedSourceRects(const ThreadedMirrorConfig& conf, int gameW, int gameH) {
     thread_local std::unordered_map<std::string, MT_SourceRectCacheEntry> s_sourceRectCache;
 
@@ -1554,12 +1550,10 @@ static const std::vector<float>& MT_GetCachedSourceRects(const ThreadedMirrorCon
     const float sh = static_cast<float>(conf.captureHeight) / gameH;
     for (size_t i = 0; i < conf.input.size(); ++i) {
         const auto& r = conf.input[i];
-        int capX = 0;
-        int capY = 0;
-        MT_GetRelativeCoordsNormalized(r.relativeTo, r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH, capX, capY);
-        const int capYGl = gameH - capY - conf.captureHeight;
+        const AnchorPoint cap = SolveMirrorAnchor(conf.inputCorners[i], r.x, r.y, conf.captureWidth, conf.captureHeight, gameW, gameH);
+        const int capYGl = gameH - cap.y - conf.captureHeight;
 
-        cacheEntry.sourceRects[i * 4 + 0] = static_cast<float>(capX) / gameW;
+        cacheEntry.sourceRects[i * 4 + 0] = static_cast<float>(cap.x) / gameW;
         cacheEntry.sourceRects[i * 4 + 1] = static_cast<float>(capYGl) / gameH;
         cacheEntry.sourceRects[i * 4 + 2] = sw;
         cacheEntry.sourceRects[i * 4 + 3] = sh;
@@ -2377,53 +2371,13 @@ static void EnsureSameThreadMirrorCaptureResources() {
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
 }
 
-static std::string MT_NormalizeCaptureAnchor(const std::string& relativeTo) {
-    if (relativeTo.length() > 8 && relativeTo.substr(relativeTo.length() - 8) == "Viewport") {
-        return relativeTo.substr(0, relativeTo.length() - 8);
-    }
-    if (relativeTo.length() > 6 && relativeTo.substr(relativeTo.length() - 6) == "Screen") {
-        return relativeTo.substr(0, relativeTo.length() - 6);
-    }
-    return relativeTo;
-}
-
-static std::vector<MirrorCaptureConfig> MT_NormalizeCaptureInputs(const std::vector<MirrorCaptureConfig>& inputRegions) {
-    std::vector<MirrorCaptureConfig> normalized = inputRegions;
-    for (auto& region : normalized) {
-        region.relativeTo = MT_NormalizeCaptureAnchor(region.relativeTo);
-    }
-    return normalized;
-}
-
-static void MT_CopyNormalizedCaptureInputs(const std::vector<MirrorCaptureConfig>& inputRegions,
-                                           std::vector<MirrorCaptureConfig>& outRegions) {
-    outRegions.resize(inputRegions.size());
+// Capture zones are always resolved against the game, so only the corner of each anchor matters. Parse them
+// once here instead of for every source-rect rebuild.
+static void MT_AssignCaptureInputs(const std::vector<MirrorCaptureConfig>& inputRegions, ThreadedMirrorConfig& conf) {
+    conf.input = inputRegions;
+    conf.inputCorners.resize(inputRegions.size());
     for (size_t i = 0; i < inputRegions.size(); ++i) {
-        outRegions[i] = inputRegions[i];
-        outRegions[i].relativeTo = MT_NormalizeCaptureAnchor(inputRegions[i].relativeTo);
-    }
-}
-
-static void MT_GetRelativeCoordsNormalized(const std::string& anchor, int relX, int relY, int w, int h, int containerW,
-                                           int containerH, int& outX, int& outY) {
-    char firstChar = anchor.empty() ? '\0' : anchor[0];
-
-    if (firstChar == 't') {
-        outY = relY;
-        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
-    } else if (firstChar == 'c') {
-        outX = (containerW - w) / 2 + relX;
-        outY = (containerH - h) / 2 + relY;
-    } else if (firstChar == 'p') {
-        const int pieYTop = 220;
-        const int pieXLeft = 92;
-        const int pieXRight = 36;
-        int baseX = (anchor == "pieLeft") ? containerW - pieXLeft : containerW - pieXRight;
-        outX = baseX + relX;
-        outY = containerH - pieYTop + relY;
-    } else {
-        outY = containerH - h - relY;
-        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
+        conf.inputCorners[i] = ParseMirrorCorner(inputRegions[i].relativeTo);
     }
 }
 
@@ -2450,7 +2404,7 @@ static void PopulateThreadedMirrorConfig(ThreadedMirrorConfig& conf, const Mirro
     conf.outputColor = mirror.colors.output;
     conf.borderColor = mirror.colors.border;
     conf.colorSensitivity = mirror.colorSensitivity;
-    MT_CopyNormalizedCaptureInputs(mirror.input, conf.input);
+    MT_AssignCaptureInputs(mirror.input, conf);
     conf.outputScale = mirror.output.scale;
     conf.outputSeparateScale = mirror.output.separateScale;
     conf.outputScaleX = mirror.output.scaleX;
@@ -2643,7 +2597,7 @@ bool RenderMirrorCapturesOnCurrentThread(const std::vector<ThreadedMirrorConfig>
 }
 
 // Update capture configs from main thread (call when active mirrors change)
-void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors) {
+void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors, const std::vector<std::string>& invalidatedMirrors) {
     std::vector<ThreadedMirrorConfig> configs;
     BuildThreadedMirrorConfigs(activeMirrors, configs);
 
@@ -2659,14 +2613,16 @@ void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors)
         maxFps = (std::max)(maxFps, c.fps);
     }
 
-    // Clear captureReady for all mirrors to allow capture thread to start fresh
+    // Clear captureReady for the changed mirrors to allow capture thread to start fresh
     // (captureReady would stay true if main thread never consumed the capture)
     {
         std::unique_lock<std::shared_mutex> clearLock(g_mirrorInstancesMutex);
-        for (auto& [name, inst] : g_mirrorInstances) {
-            inst.captureReady.store(false, std::memory_order_release);
-            inst.cachedRenderState.isValid = false;
-            inst.cachedRenderStateBack.isValid = false;
+        for (const std::string& name : invalidatedMirrors) {
+            auto it = g_mirrorInstances.find(name);
+            if (it == g_mirrorInstances.end()) { continue; }
+            it->second.captureReady.store(false, std::memory_order_release);
+            it->second.cachedRenderState.isValid = false;
+            it->second.cachedRenderStateBack.isValid = false;
         }
     }
 
@@ -2768,7 +2724,7 @@ void UpdateMirrorInputRegions(const std::string& mirrorName, const std::vector<M
     std::lock_guard<std::mutex> lock(g_threadedMirrorConfigMutex);
     for (auto& conf : g_threadedMirrorConfigs) {
         if (conf.name == mirrorName) {
-            conf.input = MT_NormalizeCaptureInputs(inputRegions);
+            MT_AssignCaptureInputs(inputRegions, conf);
             conf.sourceRectLayoutHash = MT_ComputeSourceRectLayoutHash(conf);
             break;
         }
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "common/anchor_layout.h"
 // Need gui.h for Color and MirrorCaptureConfig used as value types in ThreadedMirrorConfig
 #include "gui/gui.h"
 
@@ -65,6 +66,7 @@ struct ThreadedMirrorConfig {
     Color borderColor;
     float colorSensitivity = 0.0f;
     std::vector<MirrorCaptureConfig> input;
+    std::vector<AnchorCorner> inputCorners; // parsed input[i].relativeTo
     uint64_t sourceRectLayoutHash = 0;
     std::chrono::steady_clock::time_point lastCaptureTime;
 
@@ -90,8 +92,9 @@ bool RenderMirrorCapturesOnCurrentThread(const std::vector<ThreadedMirrorConfig>
 
 void BuildThreadedMirrorConfigs(const std::vector<MirrorConfig>& activeMirrors, std::vector<ThreadedMirrorConfig>& outConfigs);
 
-// Update capture configs from main thread (call when active mirrors change)
-void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors);
+// Update capture configs from main thread (call when active mirrors change). Only the named mirrors drop their
+// pending capture and cached render state; the others keep capturing across the update.
+void UpdateMirrorCaptureConfigs(const std::vector<MirrorConfig>& activeMirrors, const std::vector<std::string>& invalidatedMirrors);
 
 void UpdateMirrorFPS(const std::string& mirrorName, int fps);
 
@@ -168,6 +168,19 @@ int GetObsTargetFramerate() {
     return ApplyObsCaptureFramerateLimit(CalculateObsTargetFramerate(smoothedIntervalUs));
 }
 
+bool GetObsCaptureCadenceUs(uint64_t& outLastCaptureUs, uint64_t& outIntervalUs) {
+    const uint64_t lastSampleUs = g_obsLastGameCaptureSampleTickUs.load(std::memory_order_acquire);
+    const uint64_t smoothedIntervalUs = g_obsSmoothedGameCaptureIntervalUs.load(std::memory_order_acquire);
+    if (lastSampleUs == 0 || smoothedIntervalUs == 0) { return false; }
+
+    const uint64_t nowUs = GetObsSteadyNowUs();
+    if (nowUs > lastSampleUs && (nowUs - lastSampleUs) >= OBS_TARGET_STALE_TIMEOUT_US) { return false; }
+
+    outLastCaptureUs = lastSampleUs;
+    outIntervalUs = smoothedIntervalUs;
+    return true;
+}
+
 void ResetObsTextureUpdateSchedule() {
     g_obsNextTextureUpdateTickUs.store(0, std::memory_order_release);
 }
@@ -2,6 +2,7 @@
 
 #include <GL/glew.h>
 #include <atomic>
+#include <cstdint>
 #include <windows.h>
 
 // OBS capture redirect state used by the main glBlitFramebuffer hook.
@@ -45,6 +46,9 @@ bool ShouldUpdateObsTextureNow();
 
 int GetObsTargetFramerate();
 
+// Last OBS game capture (steady_clock microseconds) and the smoothed capture interval; false while unknown or stale.
+bool GetObsCaptureCadenceUs(uint64_t& outLastCaptureUs, uint64_t& outIntervalUs);
+
 void ResetObsTextureUpdateSchedule();
 
 void EnableObsOverride();
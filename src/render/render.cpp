@@ -25,6 +25,7 @@
 #include <Shlwapi.h>
 #include <cctype>
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstring>
@@ -33,6 +34,7 @@
 #include <limits>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -235,15 +237,6 @@ static std::atomic<uint64_t> s_configCacheVersion{ 0 };
 static uint64_t s_lastCacheRebuildVersion = 0;
 static std::mutex s_lookupCacheMutex;
 
-static std::string MakeLowercaseKey(const std::string& value) {
-    std::string lowered;
-    lowered.reserve(value.size());
-    for (unsigned char ch : value) {
-        lowered.push_back(static_cast<char>(std::tolower(ch)));
-    }
-    return lowered;
-}
-
 static void RebuildConfigLookupCaches() {
     s_mirrorLookupCache.clear();
     s_imageLookupCache.clear();
@@ -289,12 +282,35 @@ enum class ActiveModeSourceType {
     BrowserOverlay
 };
 
-struct ActiveModeSourceEntry {
+// One resolved mode source. `index` points into the plan array for `type`; mirror entries are appended
+// in source order, so a run of consecutive mirror entries is also a contiguous slice of `mirrors`.
+struct ModeRenderPlanEntry {
     ActiveModeSourceType type = ActiveModeSourceType::Mirror;
-    MirrorConfig mirror;
-    const ImageConfig* image = nullptr;
-    const WindowOverlayConfig* windowOverlay = nullptr;
-    const BrowserOverlayConfig* browserOverlay = nullptr;
+    uint32_t index = 0;
+};
+
+// Flat, index-based draw list for one mode, compiled once per (config snapshot generation, mode, screen
+// size, pass, overlay visibility) and reused by every frame until one of those changes.
+struct ModeRenderPlan {
+    uint64_t configGeneration = 0;
+    uint64_t lookupVersion = 0;
+    std::string modeId;
+    int screenW = 0;
+    int screenH = 0;
+    bool onlyOnMyScreenPass = false;
+    bool imagesVisible = false;
+    bool windowOverlaysVisible = false;
+    bool browserOverlaysVisible = false;
+    bool compiled = false;
+    uint64_t lastUsed = 0;
+
+    std::vector<MirrorConfig> mirrors;
+    std::vector<const ImageConfig*> images;
+    std::vector<const WindowOverlayConfig*> windowOverlays;
+    std::vector<const BrowserOverlayConfig*> browserOverlays;
+    std::vector<ModeRenderPlanEntry> entries;
+    // Indices into `mirrors` sorted by name; transitions look source mirrors up by name.
+    std::vector<uint32_t> mirrorsByName;
 };
 
 static MirrorConfig BuildGroupedMirrorConfig(const MirrorConfig& mirror, const MirrorGroupConfig& group, const MirrorGroupItem& item,
@@ -337,178 +353,191 @@ static bool ModeHasAnyMirrorSources(const ModeConfig& mode) {
     return ModeHasSourceType(mode, ModeSourceType::Mirror) || ModeHasSourceType(mode, ModeSourceType::MirrorGroup);
 }
 
-static void ResolveActiveElementsForMode(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
-                                         uint64_t configVersion, std::vector<MirrorConfig>& outMirrors,
-                                         std::vector<ImageConfig>& outImages,
-                                         std::vector<const WindowOverlayConfig*>& outWindowOverlays,
-                                         std::vector<const BrowserOverlayConfig*>& outBrowserOverlays,
-                                         std::vector<ActiveModeSourceEntry>* outOrderedSources,
-                                         int screenWOverride = 0, int screenHOverride = 0) {
-    outMirrors.clear();
-    outImages.clear();
-    outWindowOverlays.clear();
-    outBrowserOverlays.clear();
-    if (outOrderedSources) { outOrderedSources->clear(); }
-
-    std::unordered_map<std::string, const ModeConfig*> modeById;
-    std::unordered_map<std::string, const ModeConfig*> modeByIdLowered;
-    std::unordered_map<std::string, const MirrorConfig*> mirrorByName;
-    std::unordered_map<std::string, const MirrorGroupConfig*> groupByName;
-    std::unordered_map<std::string, const ImageConfig*> imageByName;
-    std::unordered_map<std::string, const WindowOverlayConfig*> windowOverlayByName;
-    std::unordered_map<std::string, const BrowserOverlayConfig*> browserOverlayByName;
-
-    modeById.reserve(config.modes.size());
-    modeByIdLowered.reserve(config.modes.size());
-    for (const auto& m : config.modes) {
-        modeById[m.id] = &m;
-        modeByIdLowered[MakeLowercaseKey(m.id)] = &m;
+// Later entries win when names are duplicated, as they did with the per-call name maps.
+template <typename T>
+static const T* FindLastConfigByName(const std::vector<T>& items, const std::string& name) {
+    for (auto it = items.rbegin(); it != items.rend(); ++it) {
+        if (it->name == name) { return &*it; }
     }
+    return nullptr;
+}
 
-    mirrorByName.reserve(config.mirrors.size());
-    for (const auto& m : config.mirrors) { mirrorByName[m.name] = &m; }
-
-    groupByName.reserve(config.mirrorGroups.size());
-    for (const auto& g : config.mirrorGroups) { groupByName[g.name] = &g; }
-
-    imageByName.reserve(config.images.size());
-    for (const auto& img : config.images) { imageByName[img.name] = &img; }
+static const ModeConfig* FindModeForRenderPlan(const Config& config, const std::string& modeId) {
+    for (auto it = config.modes.rbegin(); it != config.modes.rend(); ++it) {
+        if (it->id == modeId) { return &*it; }
+    }
+    for (auto it = config.modes.rbegin(); it != config.modes.rend(); ++it) {
+        if (EqualsIgnoreCase(it->id, modeId)) { return &*it; }
+    }
+    return nullptr;
+}
 
-    windowOverlayByName.reserve(config.windowOverlays.size());
-    for (const auto& overlay : config.windowOverlays) { windowOverlayByName[overlay.name] = &overlay; }
+static std::atomic<uint64_t> s_modeRenderPlanCompileCount{ 0 };
 
-    browserOverlayByName.reserve(config.browserOverlays.size());
-    for (const auto& overlay : config.browserOverlays) { browserOverlayByName[overlay.name] = &overlay; }
+static void CompileModeRenderPlan(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass, int screenW, int screenH,
+                                  bool imagesVisible, bool windowOverlaysVisible, bool browserOverlaysVisible, ModeRenderPlan& plan) {
+    // clear() keeps capacity, so recompiling a slot for a mode of similar size does not reallocate.
+    plan.mirrors.clear();
+    plan.images.clear();
+    plan.windowOverlays.clear();
+    plan.browserOverlays.clear();
+    plan.entries.clear();
+    plan.mirrorsByName.clear();
+    s_modeRenderPlanCompileCount.fetch_add(1, std::memory_order_relaxed);
 
-    const ModeConfig* mode = nullptr;
-    if (auto it = modeById.find(modeId); it != modeById.end()) {
-        mode = it->second;
-    } else {
-        auto loweredIt = modeByIdLowered.find(MakeLowercaseKey(modeId));
-        if (loweredIt != modeByIdLowered.end()) {
-            mode = loweredIt->second;
-        }
-    }
+    const ModeConfig* mode = FindModeForRenderPlan(config, modeId);
     if (!mode) return;
 
-    const int resolvedScreenW = screenWOverride > 0 ? screenWOverride : GetCachedWindowWidth();
-    const int resolvedScreenH = screenHOverride > 0 ? screenHOverride : GetCachedWindowHeight();
-    const bool imagesVisible = g_imageOverlaysVisible.load(std::memory_order_acquire);
-    const bool windowOverlaysVisible = g_windowOverlaysVisible.load(std::memory_order_acquire);
-    const bool browserOverlaysVisible = g_browserOverlaysVisible.load(std::memory_order_acquire);
-
     const size_t sourceEstimate = mode->sources.size();
-    outMirrors.reserve(sourceEstimate);
-    outImages.reserve(sourceEstimate);
-    outWindowOverlays.reserve(sourceEstimate);
-    outBrowserOverlays.reserve(sourceEstimate);
-    if (outOrderedSources) { outOrderedSources->reserve(sourceEstimate * 2); }
-
-    auto appendMirror = [&](const MirrorConfig& mirror) {
-        if (onlyOnMyScreenPass && !mirror.onlyOnMyScreen) { return; }
-        outMirrors.push_back(mirror);
-        if (outOrderedSources) {
-            ActiveModeSourceEntry source;
-            source.type = ActiveModeSourceType::Mirror;
-            source.mirror = mirror;
-            outOrderedSources->push_back(std::move(source));
-        }
+    plan.mirrors.reserve(sourceEstimate);
+    plan.entries.reserve(sourceEstimate);
+
+    auto appendEntry = [&](ActiveModeSourceType type, size_t index) {
+        ModeRenderPlanEntry entry;
+        entry.type = type;
+        entry.index = static_cast<uint32_t>(index);
+        plan.entries.push_back(entry);
     };
 
-    auto appendMirrorByName = [&](const std::string& mirrorName) {
-        auto it = mirrorByName.find(mirrorName);
-        if (it == mirrorByName.end() || !it->second) return;
-        appendMirror(*it->second);
-    };
-
-    auto appendMirrorGroup = [&](const std::string& groupName) {
-        auto git = groupByName.find(groupName);
-        if (git == groupByName.end() || !git->second) return;
-        const auto& group = *git->second;
-
-        for (const auto& item : group.mirrors) {
-            if (!item.enabled) continue;
-            auto mit = mirrorByName.find(item.mirrorId);
-            if (mit == mirrorByName.end() || !mit->second) continue;
-            appendMirror(BuildGroupedMirrorConfig(*mit->second, group, item, resolvedScreenW, resolvedScreenH));
-        }
-    };
-
-    auto appendImage = [&](const std::string& imageName) {
-        if (!imagesVisible) return;
-        auto it = imageByName.find(imageName);
-        if (it == imageByName.end() || !it->second) return;
-        const ImageConfig* image = it->second;
-        if (onlyOnMyScreenPass && !image->onlyOnMyScreen) { return; }
-        outImages.push_back(*image);
-        if (outOrderedSources) {
-            ActiveModeSourceEntry source;
-            source.type = ActiveModeSourceType::Image;
-            source.image = image;
-            outOrderedSources->push_back(std::move(source));
-        }
-    };
-
-    auto appendWindowOverlay = [&](const std::string& overlayId) {
-        if (!windowOverlaysVisible) return;
-        auto it = windowOverlayByName.find(overlayId);
-        if (it == windowOverlayByName.end() || !it->second) return;
-        const WindowOverlayConfig* overlay = it->second;
-        if (onlyOnMyScreenPass && !overlay->onlyOnMyScreen) { return; }
-        outWindowOverlays.push_back(overlay);
-        if (outOrderedSources) {
-            ActiveModeSourceEntry source;
-            source.type = ActiveModeSourceType::WindowOverlay;
-            source.windowOverlay = overlay;
-            outOrderedSources->push_back(std::move(source));
-        }
-    };
-
-    auto appendBrowserOverlay = [&](const std::string& overlayId) {
-        if (!browserOverlaysVisible) return;
-        auto it = browserOverlayByName.find(overlayId);
-        if (it == browserOverlayByName.end() || !it->second) return;
-        const BrowserOverlayConfig* overlay = it->second;
-        if (onlyOnMyScreenPass && !overlay->onlyOnMyScreen) { return; }
-        outBrowserOverlays.push_back(overlay);
-        if (outOrderedSources) {
-            ActiveModeSourceEntry source;
-            source.type = ActiveModeSourceType::BrowserOverlay;
-            source.browserOverlay = overlay;
-            outOrderedSources->push_back(std::move(source));
-        }
+    auto appendMirror = [&](MirrorConfig&& mirror) {
+        if (onlyOnMyScreenPass && !mirror.onlyOnMyScreen) { return; }
+        appendEntry(ActiveModeSourceType::Mirror, plan.mirrors.size());
+        plan.mirrors.push_back(std::move(mirror));
     };
 
     for (const auto& source : mode->sources) {
         switch (source.type) {
-        case ModeSourceType::Mirror:
-            appendMirrorByName(source.id);
+        case ModeSourceType::Mirror: {
+            const MirrorConfig* mirror = FindLastConfigByName(config.mirrors, source.id);
+            if (mirror) { appendMirror(MirrorConfig(*mirror)); }
             break;
-        case ModeSourceType::MirrorGroup:
-            appendMirrorGroup(source.id);
+        }
+        case ModeSourceType::MirrorGroup: {
+            const MirrorGroupConfig* group = FindLastConfigByName(config.mirrorGroups, source.id);
+            if (!group) break;
+            for (const auto& item : group->mirrors) {
+                if (!item.enabled) continue;
+                const MirrorConfig* mirror = FindLastConfigByName(config.mirrors, item.mirrorId);
+                if (!mirror) continue;
+                appendMirror(BuildGroupedMirrorConfig(*mirror, *group, item, screenW, screenH));
+            }
             break;
-        case ModeSourceType::Image:
-            appendImage(source.id);
+        }
+        case ModeSourceType::Image: {
+            if (!imagesVisible) break;
+            const ImageConfig* image = FindLastConfigByName(config.images, source.id);
+            if (!image || (onlyOnMyScreenPass && !image->onlyOnMyScreen)) break;
+            appendEntry(ActiveModeSourceType::Image, plan.images.size());
+            plan.images.push_back(image);
             break;
-        case ModeSourceType::WindowOverlay:
-            appendWindowOverlay(source.id);
+        }
+        case ModeSourceType::WindowOverlay: {
+            if (!windowOverlaysVisible) break;
+            const WindowOverlayConfig* overlay = FindLastConfigByName(config.windowOverlays, source.id);
+            if (!overlay || (onlyOnMyScreenPass && !overlay->onlyOnMyScreen)) break;
+            appendEntry(ActiveModeSourceType::WindowOverlay, plan.windowOverlays.size());
+            plan.windowOverlays.push_back(overlay);
             break;
-        case ModeSourceType::BrowserOverlay:
-            appendBrowserOverlay(source.id);
+        }
+        case ModeSourceType::BrowserOverlay: {
+            if (!browserOverlaysVisible) break;
+            const BrowserOverlayConfig* overlay = FindLastConfigByName(config.browserOverlays, source.id);
+            if (!overlay || (onlyOnMyScreenPass && !overlay->onlyOnMyScreen)) break;
+            appendEntry(ActiveModeSourceType::BrowserOverlay, plan.browserOverlays.size());
+            plan.browserOverlays.push_back(overlay);
             break;
         }
+        }
     }
+
+    plan.mirrorsByName.resize(plan.mirrors.size());
+    for (size_t i = 0; i < plan.mirrorsByName.size(); ++i) { plan.mirrorsByName[i] = static_cast<uint32_t>(i); }
+    std::stable_sort(plan.mirrorsByName.begin(), plan.mirrorsByName.end(),
+                     [&](uint32_t a, uint32_t b) { return plan.mirrors[a].name < plan.mirrors[b].name; });
 }
 
-void CollectActiveElementsForMode(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass, uint64_t configVersion,
+// Returns the last mirror in the plan with this name, like the name -> config map it replaces.
+static const MirrorConfig* FindModeRenderPlanMirror(const ModeRenderPlan& plan, const std::string& name) {
+    auto it = std::upper_bound(plan.mirrorsByName.begin(), plan.mirrorsByName.end(), name,
+                               [&](const std::string& key, uint32_t index) { return key < plan.mirrors[index].name; });
+    if (it == plan.mirrorsByName.begin()) { return nullptr; }
+    --it;
+    const MirrorConfig& mirror = plan.mirrors[*it];
+    return mirror.name == name ? &mirror : nullptr;
+}
+
+// Per-thread plan cache with least-recently-used replacement. One frame touches at most four plans (the
+// target mode at its own and at window size, the mode being left, and EyeZoom), so with eight slots a
+// plan referenced earlier in the frame is never evicted by a later lookup in the same frame.
+// A config that was never published (generation 0) has no identity to key on and recompiles on every call.
+static const ModeRenderPlan& GetModeRenderPlan(const Config& config, const std::string& modeId,
+                                               int screenWOverride = 0, int screenHOverride = 0, bool onlyOnMyScreenPass = false) {
+    constexpr size_t kModeRenderPlanSlots = 8;
+    static thread_local std::array<ModeRenderPlan, kModeRenderPlanSlots> t_plans;
+    static thread_local uint64_t t_planUseCounter = 0;
+
+    const int screenW = screenWOverride > 0 ? screenWOverride : GetCachedWindowWidth();
+    const int screenH = screenHOverride > 0 ? screenHOverride : GetCachedWindowHeight();
+    const uint64_t lookupVersion = s_configCacheVersion.load(std::memory_order_acquire);
+    const bool imagesVisible = g_imageOverlaysVisible.load(std::memory_order_acquire);
+    const bool windowOverlaysVisible = g_windowOverlaysVisible.load(std::memory_order_acquire);
+    const bool browserOverlaysVisible = g_browserOverlaysVisible.load(std::memory_order_acquire);
+
+    const uint64_t configGeneration = config.snapshotGeneration.value;
+    ModeRenderPlan* victim = &t_plans[0];
+    for (ModeRenderPlan& plan : t_plans) {
+        if (plan.compiled && configGeneration != 0 && plan.configGeneration == configGeneration && plan.lookupVersion == lookupVersion &&
+            plan.screenW == screenW && plan.screenH == screenH && plan.onlyOnMyScreenPass == onlyOnMyScreenPass &&
+            plan.imagesVisible == imagesVisible && plan.windowOverlaysVisible == windowOverlaysVisible &&
+            plan.browserOverlaysVisible == browserOverlaysVisible && plan.modeId == modeId) {
+            plan.lastUsed = ++t_planUseCounter;
+            return plan;
+        }
+        if (!plan.compiled || (victim->compiled && plan.lastUsed < victim->lastUsed)) { victim = &plan; }
+    }
+
+    PROFILE_SCOPE_CAT("Compile Mode Render Plan", "Rendering");
+    CompileModeRenderPlan(config, modeId, onlyOnMyScreenPass, screenW, screenH, imagesVisible, windowOverlaysVisible,
+                          browserOverlaysVisible, *victim);
+    victim->configGeneration = configGeneration;
+    victim->lookupVersion = lookupVersion;
+    victim->modeId = modeId;
+    victim->screenW = screenW;
+    victim->screenH = screenH;
+    victim->onlyOnMyScreenPass = onlyOnMyScreenPass;
+    victim->imagesVisible = imagesVisible;
+    victim->windowOverlaysVisible = windowOverlaysVisible;
+    victim->browserOverlaysVisible = browserOverlaysVisible;
+    victim->compiled = true;
+    victim->lastUsed = ++t_planUseCounter;
+    return *victim;
+}
+
+void CollectActiveElementsForMode(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
                                   std::vector<MirrorConfig>& outMirrors, std::vector<ImageConfig>& outImages,
                                   std::vector<const WindowOverlayConfig*>& outWindowOverlays,
                                   std::vector<const BrowserOverlayConfig*>& outBrowserOverlays,
                                   int screenWOverride, int screenHOverride) {
-    ResolveActiveElementsForMode(config, modeId, onlyOnMyScreenPass, configVersion, outMirrors, outImages, outWindowOverlays,
-                                 outBrowserOverlays, nullptr, screenWOverride, screenHOverride);
+    // Callers keep the results, so compile a private plan rather than borrowing a cached slot.
+    ModeRenderPlan plan;
+    CompileModeRenderPlan(config, modeId, onlyOnMyScreenPass, screenWOverride > 0 ? screenWOverride : GetCachedWindowWidth(),
+                          screenHOverride > 0 ? screenHOverride : GetCachedWindowHeight(),
+                          g_imageOverlaysVisible.load(std::memory_order_acquire),
+                          g_windowOverlaysVisible.load(std::memory_order_acquire),
+                          g_browserOverlaysVisible.load(std::memory_order_acquire), plan);
+
+    outMirrors = std::move(plan.mirrors);
+    outImages.clear();
+    outImages.reserve(plan.images.size());
+    for (const ImageConfig* image : plan.images) { outImages.push_back(*image); }
+    outWindowOverlays = std::move(plan.windowOverlays);
+    outBrowserOverlays = std::move(plan.browserOverlays);
 }
 
+#ifdef TOOLSCREEN_GUI_INTEGRATION_TESTS
+uint64_t GetModeRenderPlanCompileCountForIntegrationTest() { return s_modeRenderPlanCompileCount.load(std::memory_order_relaxed); }
+#endif
+
 extern std::atomic<bool> g_graphicsHookDetected;
 
 GLuint g_filterProgram = 0;
@@ -848,14 +877,12 @@ static void ComputeMirrorGroupAnchorScreen(const MirrorGroupConfig& group, const
         if (fullW > 0) groupX = static_cast<int>(group.output.relativeX * static_cast<float>(fullW));
         if (fullH > 0) groupY = static_cast<int>(group.output.relativeY * static_cast<float>(fullH));
     }
-    const std::string& anchor = group.output.relativeTo;
-    const bool isScreen = anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen";
-    if (isScreen) {
-        GetRelativeCoords(anchor, groupX, groupY, 0, 0, fullW, fullH, outX, outY);
-    } else {
-        GetRelativeCoords(anchor, groupX, groupY, 0, 0, geo.finalW, geo.finalH, outX, outY);
-        outX += geo.finalX; outY += geo.finalY;
-    }
+    const Anchor anchor{ ParseMirrorCorner(group.output.relativeTo),
+                         IsScreenAnchorText(group.output.relativeTo) ? AnchorSpace::Screen : AnchorSpace::Viewport };
+    const AnchorPoint pos = SolveMirrorAnchorOnScreen(anchor, groupX, groupY, 0, 0, AnchorFrame{ 0, 0, fullW, fullH },
+                                                      AnchorFrame{ geo.finalX, geo.finalY, geo.finalW, geo.finalH });
+    outX = pos.x;
+    outY = pos.y;
 }
 
 enum class OverlayEditKind { Mirror, Image, WindowOverlay, Ninjabrain, MirrorGroup };
@@ -1487,6 +1514,14 @@ bool GetCroppedImageDimensions(const ImageConfig& img, int& outCroppedW, int& ou
     return true;
 }
 
+static void ResolveImageScreenPos(const Anchor& anchor, int relX, int relY, int w, int h, int gameX, int gameY, int gameW, int gameH,
+                                  int fullW, int fullH, int& outX, int& outY) {
+    const AnchorPoint pos =
+        SolveImageAnchorOnScreen(anchor, relX, relY, w, h, AnchorFrame{ 0, 0, fullW, fullH }, AnchorFrame{ gameX, gameY, gameW, gameH });
+    outX = pos.x;
+    outY = pos.y;
+}
+
 static void ResolveConfiguredImageDimensions(const ImageConfig& img, int sourceWidth, int sourceHeight, int& outW, int& outH) {
     auto c = ResolveCrop(img.crop_top, img.crop_bottom, img.crop_left, img.crop_right,
                          img.cropToWidth, img.cropToHeight, sourceWidth, sourceHeight);
@@ -2329,7 +2364,7 @@ void DiscardUnusedUserImageCaches() {
     }
 
     if (removedGpuEntries > 0 || removedPendingDecodes > 0) {
-        LogCategory("image_monitor", "Pruned deleted user image caches: gpuEntries=" + std::to_string(removedGpuEntries) +
+        LOG_CATEGORY(ImageMonitor, "Pruned deleted user image caches: gpuEntries=" + std::to_string(removedGpuEntries) +
                                          ", pendingDecodes=" + std::to_string(removedPendingDecodes) + ".");
     }
 }
@@ -2358,6 +2393,38 @@ struct PixelStoreStateGuard {
     }
 };
 
+void AdvanceVideoStreamTexture(MpegVideoStream& stream, GLuint texture, std::chrono::steady_clock::time_point playbackStart,
+                               uint64_t& uploadedSequence) {
+    if (texture == 0) { return; }
+
+    const double playheadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - playbackStart).count();
+    MpegVideoStreamFrame frame;
+    if (!stream.AcquireFrame(playheadMs, frame) || frame.sequence == uploadedSequence) { return; }
+
+    PROFILE_SCOPE_CAT("Video Stream Frame Upload", "GPU Operations");
+    PixelStoreStateGuard pixelStoreGuard;
+    BindTextureDirect(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, stream.GetWidth(), stream.GetHeight(), GL_RGBA, GL_UNSIGNED_BYTE, frame.rgba);
+    uploadedSequence = frame.sequence;
+}
+
+// Allocates the single texture a streamed video is played through; frames arrive via AdvanceVideoStreamTexture.
+static GLuint CreateVideoStreamTexture(const MpegVideoStream& stream) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    BindTextureDirect(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, stream.GetWidth(), stream.GetHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    return texture;
+}
+
 static bool SupportsSamplerObjects() {
     return GLEW_VERSION_3_3 || GLEW_ARB_sampler_objects;
 }
@@ -2866,17 +2933,17 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
     size_t decodedBytes = 0;
     std::string decodedReason;
     if (!TryDescribeDecodedImageStorage(imgData, decodedBytes, decodedReason)) {
-        LogCategory("image_monitor", "Skipping GPU upload for image '" + imgData.id + "' due to invalid decoded image data: " + decodedReason + ".");
+        LOG_CATEGORY(ImageMonitor, "Skipping GPU upload for image '" + imgData.id + "' due to invalid decoded image data: " + decodedReason + ".");
         return;
     }
     if (!imgData.isVideo && decodedBytes > kMaxDecodedImageUploadBytes) {
-        LogCategory("image_monitor",
+        LOG_CATEGORY(ImageMonitor,
                     "Skipping GPU upload for image '" + imgData.id + "' because decoded storage " + FormatByteCount(decodedBytes) +
                         " exceeds guard limit of " + FormatByteCount(kMaxDecodedImageUploadBytes) + ".");
         return;
     }
 
-    LogCategory("image_monitor", "Uploading decoded image '" + imgData.id + "' to GPU: " + std::to_string(imgData.width) + "x" +
+    LOG_CATEGORY(ImageMonitor, "Uploading decoded image '" + imgData.id + "' to GPU: " + std::to_string(imgData.width) + "x" +
                                    std::to_string(imgData.height) + ", frameCount=" + std::to_string(imgData.frameCount) +
                                    ", bytes=" + FormatByteCount(decodedBytes) + ".");
 
@@ -2899,7 +2966,18 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
             g_backgroundTextures.erase(it);
         }
 
-        if (imgData.data) {
+        if (imgData.videoStream) {
+            BackgroundTextureInstance inst;
+            inst.width = imgData.videoStream->GetWidth();
+            inst.height = imgData.videoStream->GetHeight();
+            inst.textureStorageHeight = inst.height;
+            inst.isVideo = true;
+            inst.videoStream = imgData.videoStream;
+            inst.textureId = CreateVideoStreamTexture(*inst.videoStream);
+            inst.lastFrameTime = std::chrono::steady_clock::now();
+            g_backgroundTextures[imgData.id] = std::move(inst);
+            Log("Uploaded streamed video background for '" + imgData.id + "' to GPU.");
+        } else if (imgData.data) {
             BackgroundTextureInstance inst;
             inst.width = imgData.width;
             inst.height = imgData.frameHeight;
@@ -2916,7 +2994,7 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
                 glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
                 const int frameHeight = imgData.frameHeight;
                 if (maxTextureSize > 0 && (imgData.width > maxTextureSize || frameHeight > maxTextureSize)) {
-                    LogCategory("image_monitor", "Skipping animated background atlas upload for '" + imgData.id +
+                    LOG_CATEGORY(ImageMonitor, "Skipping animated background atlas upload for '" + imgData.id +
                                                      "' because frame dimensions exceed GL_MAX_TEXTURE_SIZE=" +
                                                      std::to_string(maxTextureSize) + ": " + std::to_string(imgData.width) + "x" +
                                                      std::to_string(frameHeight) + ".");
@@ -3004,7 +3082,22 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
         }
         if (hadOldInst) { g_hasTexturesToDelete.store(true, std::memory_order_release); }
 
-        if (imgData.data) {
+        if (imgData.videoStream) {
+            UserImageInstance inst;
+            inst.width = imgData.videoStream->GetWidth();
+            inst.height = imgData.videoStream->GetHeight();
+            inst.textureStorageHeight = inst.height;
+            inst.isVideo = true;
+            inst.isFullyTransparent = false;
+            inst.videoStream = imgData.videoStream;
+            inst.textureId = CreateVideoStreamTexture(*inst.videoStream);
+            inst.lastFrameTime = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
+                g_userImages[imgData.id] = std::move(inst);
+            }
+            LOG_CATEGORY(ImageMonitor, "Uploaded streamed video user image '" + imgData.id + "' to GPU.");
+        } else if (imgData.data) {
             UserImageInstance inst;
             inst.width = imgData.width;
             inst.height = imgData.frameHeight;
@@ -3030,7 +3123,7 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
                 glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
                 const int frameHeight = imgData.frameHeight;
                 if (maxTextureSize > 0 && (imgData.width > maxTextureSize || frameHeight > maxTextureSize)) {
-                    LogCategory("image_monitor", "Skipping animated user image atlas upload for '" + imgData.id +
+                    LOG_CATEGORY(ImageMonitor, "Skipping animated user image atlas upload for '" + imgData.id +
                                                      "' because frame dimensions exceed GL_MAX_TEXTURE_SIZE=" +
                                                      std::to_string(maxTextureSize) + ": " + std::to_string(imgData.width) + "x" +
                                                      std::to_string(frameHeight) + ".");
@@ -3071,7 +3164,7 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
                     std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
                     g_userImages[imgData.id] = std::move(inst);
                 }
-                LogCategory("image_monitor", "Uploaded animated user image atlas '" + imgData.id + "' to GPU (" +
+                LOG_CATEGORY(ImageMonitor, "Uploaded animated user image atlas '" + imgData.id + "' to GPU (" +
                                                  std::to_string(imgData.frameCount) + " frames across " +
                                                  std::to_string(pageCount) + " texture page(s)).");
             } else {
@@ -3094,7 +3187,7 @@ void UploadDecodedImageToGPU_Internal(const DecodedImageData& imgData) {
                     std::lock_guard<std::mutex> imageLock(g_userImagesMutex);
                     g_userImages[imgData.id] = std::move(inst);
                 }
-                LogCategory("image_monitor", "Uploaded user image '" + imgData.id + "' to GPU.");
+                LOG_CATEGORY(ImageMonitor, "Uploaded user image '" + imgData.id + "' to GPU.");
             }
         } else {
             Log("Skipping GPU upload for user image '" + imgData.id + "' due to null image data.");
@@ -3113,9 +3206,9 @@ void ProcessPendingDecodedImages() {
     }
 
     PROFILE_SCOPE_CAT("Process Decoded Images", "GPU Operations");
-    LogCategory("image_monitor", "Processing " + std::to_string(pendingImages.size()) + " decoded images on render thread.");
+    LOG_CATEGORY(ImageMonitor, "Processing " + std::to_string(pendingImages.size()) + " decoded images on render thread.");
     for (auto& decodedImg : pendingImages) {
-        if (!decodedImg.data) {
+        if (!decodedImg.data && !decodedImg.videoStream) {
             continue;
         }
 
@@ -3167,7 +3260,7 @@ void InitializeGPUResources() {
     {
         auto initSnap = GetConfigSnapshot();
         if (initSnap) { mirrorsToCreate = initSnap->mirrors; }
-        LogCategory("init", "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
+        LOG_CATEGORY(Init, "Found " + std::to_string(mirrorsToCreate.size()) + " mirrors in config to create.");
     }
     // Release the framebuffer binding before calling CreateMirrorGPUResources
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
@@ -3215,7 +3308,7 @@ void InitializeGPUResources() {
 
     glBindVertexArray(0);
 
-    LogCategory("init", "Restoring original OpenGL state...");
+    LOG_CATEGORY(Init, "Restoring original OpenGL state...");
     glUseProgram(last_program);
     glActiveTexture(last_active_texture);
     BindTextureDirect(GL_TEXTURE_2D, last_texture);
@@ -3224,7 +3317,7 @@ void InitializeGPUResources() {
     glBindFramebuffer(GL_FRAMEBUFFER, last_framebuffer);
 
     g_glInitialized.store(true, std::memory_order_release);
-    LogCategory("init", "--- GPU resources initialized successfully. ---");
+    LOG_CATEGORY(Init, "--- GPU resources initialized successfully. ---");
 }
 
 static bool CreateMirrorFramebuffer(GLuint& fbo, GLuint& texture, int w, int h, GLenum filter) {
@@ -3305,7 +3398,7 @@ void CreateMirrorGPUResources(const MirrorConfig& conf) {
         inst.capturedAsRawOutput = conf.rawOutput;
         inst.capturedAsRawOutputBack = conf.rawOutput;
         g_mirrorInstances[conf.name] = inst;
-        LogCategory("init", "Created single-buffered GPU resources for mirror '" + conf.name + "' (FBO: " +
+        LOG_CATEGORY(Init, "Created single-buffered GPU resources for mirror '" + conf.name + "' (FBO: " +
                                 std::to_string(inst.fbo) + ", FinalFBO: " + std::to_string(inst.finalFbo) + " [" +
                                 std::to_string(inst.final_w) + "x" + std::to_string(inst.final_h) + "])");
     } else {
@@ -3374,7 +3467,7 @@ static void LogInvalidTextureSampleThrottled(const std::string& stage, GLuint te
         expected = " expected=" + std::to_string(expectedW) + "x" + std::to_string(expectedH);
     }
 
-    LogCategory("texture_ops", "Main Render: Invalid texture sample stage=" + stage + " tex=" + std::to_string(texture) +
+    LOG_CATEGORY(TextureOps, "Main Render: Invalid texture sample stage=" + stage + " tex=" + std::to_string(texture) +
                                    " valid=" + std::to_string(valid ? 1 : 0) + " actual=" + std::to_string(actualW) + "x" +
                                    std::to_string(actualH) + expected);
 }
@@ -3560,7 +3653,7 @@ static void LogEyeZoomDebugThrottled(const char* stage, const std::string& messa
 
     state.lastLogMs = now;
     state.lastMessage = message;
-    LogCategory("texture_ops", std::string("EyeZoom: ") + stage + " " + message);
+    LOG_CATEGORY(TextureOps, std::string("EyeZoom: ") + stage + " " + message);
 }
 
 static void LogEyeZoomFramebufferStatusThrottled(const char* stage, GLuint texture, GLenum status, int width, int height) {
@@ -3572,7 +3665,7 @@ static void LogEyeZoomFramebufferStatusThrottled(const char* stage, GLuint textu
     if (it != s_lastLogByStage.end() && (now - it->second) < kLogIntervalMs) { return; }
     s_lastLogByStage[stage] = now;
 
-    LogCategory("texture_ops",
+    LOG_CATEGORY(TextureOps,
                 std::string("EyeZoom: framebuffer incomplete at ") + stage + " status=" + std::to_string(status) +
                     " tex=" + std::to_string(texture) + " size=" + std::to_string(width) + "x" + std::to_string(height));
 }
@@ -3632,7 +3725,7 @@ static void AppendUniqueMirrorsByName(std::vector<MirrorConfig>& dest, const std
     }
 }
 
-static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors, const GameViewportGeometry& geo, int fullW, int fullH,
+static void RenderMirrorsDirect(std::span<const MirrorConfig> activeMirrors, const GameViewportGeometry& geo, int fullW, int fullH,
                                 float modeOpacity, bool excludeOnlyOnMyScreen, bool relativeStretching, float transitionProgress,
                                 float mirrorSlideProgress, int fromX, int fromY, int fromW, int fromH, int toX, int toY, int toW,
                                 int toH, int fromFullW, int fromFullH, bool isEyeZoomMode, bool isTransitioningFromEyeZoom,
@@ -3655,31 +3748,12 @@ static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors,
     const bool wantsEyeZoomSlide =
         cfg.eyezoom.slideMirrorsIn && hasEyeZoomAnimatedPosition && isEyeZoomMode && isEyeZoomTransitioning;
     const float eyeZoomSlideProgress = wantsEyeZoomSlide ? static_cast<float>(eyeZoomAnimatedViewportX) / targetViewportX : 1.0f;
-    std::vector<MirrorConfig> sourceMirrors;
-    std::unordered_map<std::string, const MirrorConfig*> sourceMirrorConfigs;
+    const ModeRenderPlan* sourcePlan = nullptr;
     if (!fromModeId.empty() && (isAnimating || fromSlideMirrorsIn || toSlideMirrorsIn || cfg.eyezoom.slideMirrorsIn)) {
-        std::vector<ImageConfig> unusedImages;
-        std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
-        std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-        CollectActiveElementsForMode(cfg, fromModeId, false, 0, sourceMirrors, unusedImages, unusedWindowOverlays,
-                         unusedBrowserOverlays);
-        sourceMirrorConfigs.reserve(sourceMirrors.size());
-        for (const auto& sourceMirror : sourceMirrors) {
-            sourceMirrorConfigs[sourceMirror.name] = &sourceMirror;
-        }
-    }
-    const bool allowCachedMirrorVertices = !isAnimating && !wantsTransitionSlide && !wantsEyeZoomSlide && sourceMirrorConfigs.empty();
-
-    auto splitRelativeAnchor = [](const std::string& relativeTo, std::string& anchorOut, bool& isScreenRelativeOut) {
-        anchorOut = relativeTo;
-        isScreenRelativeOut = false;
-        if (anchorOut.length() > 6 && anchorOut.substr(anchorOut.length() - 6) == "Screen") {
-            anchorOut = anchorOut.substr(0, anchorOut.length() - 6);
-            isScreenRelativeOut = true;
-        } else if (anchorOut.length() > 8 && anchorOut.substr(anchorOut.length() - 8) == "Viewport") {
-            anchorOut = anchorOut.substr(0, anchorOut.length() - 8);
-        }
-    };
+        sourcePlan = &GetModeRenderPlan(cfg, fromModeId);
+    }
+    const bool hasSourceMirrors = sourcePlan && !sourcePlan->mirrors.empty();
+    const bool allowCachedMirrorVertices = !isAnimating && !wantsTransitionSlide && !wantsEyeZoomSlide && !hasSourceMirrors;
 
     struct MirrorLayoutState {
         int finalXScreen = 0;
@@ -3699,31 +3773,21 @@ static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors,
     };
 
     auto resolveSourceConfig = [&](const MirrorConfig& conf) -> const MirrorConfig* {
-        if (isSlideOutPass) {
-            return nullptr;
-        }
-
-        auto sourceIt = sourceMirrorConfigs.find(conf.name);
-        if (sourceIt == sourceMirrorConfigs.end()) {
+        if (isSlideOutPass || !hasSourceMirrors) {
             return nullptr;
         }
 
-        return sourceIt->second;
+        return FindModeRenderPlanMirror(*sourcePlan, conf.name);
     };
 
     auto resolveMirrorLayout = [&](const MirrorConfig& conf, const MirrorConfig* sourceConf, int renderedOutW,
                                    int renderedOutH) {
         MirrorLayoutState layout{};
 
-        std::string targetAnchor;
-        bool targetIsScreenRelative = false;
-        splitRelativeAnchor(conf.output.relativeTo, targetAnchor, targetIsScreenRelative);
-
-        std::string sourceAnchor = targetAnchor;
-        bool sourceIsScreenRelative = targetIsScreenRelative;
-        if (sourceConf) {
-            splitRelativeAnchor(sourceConf->output.relativeTo, sourceAnchor, sourceIsScreenRelative);
-        }
+        const Anchor targetAnchor = ParseMirrorAnchor(conf.output.relativeTo);
+        const bool targetIsScreenRelative = targetAnchor.space == AnchorSpace::Screen;
+        const Anchor sourceAnchor = sourceConf ? ParseMirrorAnchor(sourceConf->output.relativeTo) : targetAnchor;
+        const bool sourceIsScreenRelative = sourceAnchor.space == AnchorSpace::Screen;
 
         const float targetScaleBaseX = conf.output.separateScale ? conf.output.scaleX : conf.output.scale;
         const float targetScaleBaseY = conf.output.separateScale ? conf.output.scaleY : conf.output.scale;
@@ -3752,41 +3816,27 @@ static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors,
         const int sourceSizeW = relativeStretching ? static_cast<int>(sourceBaseW * fromScaleX) : sourceBaseW;
         const int sourceSizeH = relativeStretching ? static_cast<int>(sourceBaseH * fromScaleY) : sourceBaseH;
 
-        int toPosX = 0;
-        int toPosY = 0;
-        if (targetIsScreenRelative) {
-            GetRelativeCoords(targetAnchor, conf.output.x, conf.output.y, targetSizeW, targetSizeH, fullW, fullH, toPosX, toPosY);
-        } else {
-            int toOutX = 0;
-            int toOutY = 0;
-            GetRelativeCoords(targetAnchor, conf.output.x, conf.output.y, targetSizeW, targetSizeH, toW, toH, toOutX, toOutY);
-            toPosX = toX + toOutX;
-            toPosY = toY + toOutY;
-        }
+        const AnchorFrame screenFrame{ 0, 0, fullW, fullH };
+        const AnchorPoint toPos = SolveMirrorAnchorOnScreen(targetAnchor, conf.output.x, conf.output.y, targetSizeW, targetSizeH,
+                                                            screenFrame, AnchorFrame{ toX, toY, toW, toH });
+        const int toPosX = toPos.x;
+        const int toPosY = toPos.y;
 
         int fromPosX = toPosX;
         int fromPosY = toPosY;
         if (sourceConf) {
-            if (sourceIsScreenRelative) {
-                GetRelativeCoords(sourceAnchor, sourceConf->output.x, sourceConf->output.y, sourceSizeW, sourceSizeH, fullW, fullH,
-                                  fromPosX, fromPosY);
-            } else {
-                int fromOutX = 0;
-                int fromOutY = 0;
-                const int effectiveFromSizeH = isTransitioningFromEyeZoom ? targetSizeH : sourceSizeH;
-                GetRelativeCoords(sourceAnchor, sourceConf->output.x, sourceConf->output.y, sourceSizeW, effectiveFromSizeH, fromW,
-                                  effectiveFromH, fromOutX, fromOutY);
-                fromPosX = fromX + fromOutX;
-                fromPosY = effectiveFromY + fromOutY;
-            }
+            const int effectiveFromSizeH = (isTransitioningFromEyeZoom && !sourceIsScreenRelative) ? targetSizeH : sourceSizeH;
+            const AnchorPoint fromPos =
+                SolveMirrorAnchorOnScreen(sourceAnchor, sourceConf->output.x, sourceConf->output.y, sourceSizeW, effectiveFromSizeH,
+                                          screenFrame, AnchorFrame{ fromX, effectiveFromY, fromW, effectiveFromH });
+            fromPosX = fromPos.x;
+            fromPosY = fromPos.y;
         } else if (!targetIsScreenRelative) {
-            int fromOutX = 0;
-            int fromOutY = 0;
             const int effectiveFromSizeH = isTransitioningFromEyeZoom ? targetSizeH : sourceSizeH;
-            GetRelativeCoords(targetAnchor, conf.output.x, conf.output.y, sourceSizeW, effectiveFromSizeH, fromW, effectiveFromH,
-                              fromOutX, fromOutY);
-            fromPosX = fromX + fromOutX;
-            fromPosY = effectiveFromY + fromOutY;
+            const AnchorPoint fromPos = SolveMirrorAnchor(targetAnchor.corner, conf.output.x, conf.output.y, sourceSizeW, effectiveFromSizeH,
+                                                          fromW, effectiveFromH);
+            fromPosX = fromX + fromPos.x;
+            fromPosY = effectiveFromY + fromPos.y;
         }
 
         layout.finalWScreen = targetSizeW;
@@ -3842,7 +3892,10 @@ static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors,
         return layout;
     };
 
-    std::vector<MirrorRenderData> mirrorsToRender;
+    // Reused across calls so steady-state frames do not allocate; mirror passes never nest.
+    static thread_local std::vector<MirrorRenderData> t_mirrorsToRender;
+    std::vector<MirrorRenderData>& mirrorsToRender = t_mirrorsToRender;
+    mirrorsToRender.clear();
     mirrorsToRender.reserve(activeMirrors.size());
 
     {
@@ -4200,7 +4253,7 @@ static void RenderMirrorsDirect(const std::vector<MirrorConfig>& activeMirrors,
     glDisable(GL_BLEND);
 }
 
-static void RenderImagesDirect(const std::vector<ImageConfig>& activeImages, int fullW, int fullH, int gameX, int gameY, int gameW,
+static void RenderImagesDirect(std::span<const ImageConfig> activeImages, int fullW, int fullH, int gameX, int gameY, int gameW,
                                int gameH, int gameResW, int gameResH, bool relativeStretching, float transitionProgress, int fromX,
                                int fromY, int fromW, int fromH, float modeOpacity, bool excludeOnlyOnMyScreen) {
     if (activeImages.empty()) return;
@@ -4259,7 +4312,8 @@ static void RenderImagesDirect(const std::vector<ImageConfig>& activeImages, int
         int displayH = 0;
         ResolveConfiguredImageDimensions(conf, texWidth, texHeight, displayW, displayH);
 
-        bool isViewportRelative = conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+        const Anchor anchor = ParseImageAnchor(conf.relativeTo);
+        const bool isViewportRelative = anchor.space == AnchorSpace::Viewport;
         int finalScreenX = 0;
         int finalScreenY = 0;
         int finalDisplayW = displayW;
@@ -4280,13 +4334,13 @@ static void RenderImagesDirect(const std::vector<ImageConfig>& activeImages, int
 
             int toPosX = 0;
             int toPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
-                                                  fullW, fullH, toPosX, toPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW, gameH,
+                                  fullW, fullH, toPosX, toPosY);
 
             int fromPosX = 0;
             int fromPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
-                                                  fromH, fullW, fullH, fromPosX, fromPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
+                                  fromH, fullW, fullH, fromPosX, fromPosY);
 
             float t = transitionProgress;
             finalScreenX = static_cast<int>(fromPosX + (toPosX - fromPosX) * t);
@@ -4296,8 +4350,8 @@ static void RenderImagesDirect(const std::vector<ImageConfig>& activeImages, int
                 finalDisplayH = static_cast<int>(fromDisplayH + (toDisplayH - fromDisplayH) * t);
             }
         } else {
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, finalDisplayW, finalDisplayH, gameX, gameY, gameW,
-                                                  gameH, fullW, fullH, finalScreenX, finalScreenY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, finalDisplayW, finalDisplayH, gameX, gameY, gameW,
+                                  gameH, fullW, fullH, finalScreenX, finalScreenY);
         }
 
         int finalScreenYGl = fullH - finalScreenY - finalDisplayH;
@@ -4357,7 +4411,7 @@ static void RenderImagesDirect(const std::vector<ImageConfig>& activeImages, int
     glDisable(GL_BLEND);
 }
 
-static void RenderWindowOverlaysDirect(const std::vector<WindowOverlayConfig>& overlays, int fullW, int fullH, int gameX,
+static void RenderWindowOverlaysDirect(std::span<const WindowOverlayConfig> overlays, int fullW, int fullH, int gameX,
                                        int gameY, int gameW, int gameH, int gameResW, int gameResH, bool relativeStretching,
                                        float transitionProgress, int fromX, int fromY, int fromW, int fromH, float modeOpacity,
                                        bool excludeOnlyOnMyScreen) {
@@ -4432,7 +4486,8 @@ static void RenderWindowOverlaysDirect(const std::vector<WindowOverlayConfig>& o
         int displayW = (std::max)(1, static_cast<int>(croppedW * (conf.separateScale ? conf.scaleX : conf.scale)));
         int displayH = (std::max)(1, static_cast<int>(croppedH * (conf.separateScale ? conf.scaleY : conf.scale)));
 
-        bool isViewportRelative = conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+        const Anchor anchor = ParseImageAnchor(conf.relativeTo);
+        const bool isViewportRelative = anchor.space == AnchorSpace::Viewport;
         int screenX = 0;
         int screenY = 0;
         if (isViewportRelative) {
@@ -4446,12 +4501,12 @@ static void RenderWindowOverlaysDirect(const std::vector<WindowOverlayConfig>& o
             int fromDisplayH = relativeStretching ? static_cast<int>(displayH * fromScaleY) : displayH;
             int toPosX = 0;
             int toPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW,
-                                                  gameH, fullW, fullH, toPosX, toPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW,
+                                  gameH, fullW, fullH, toPosX, toPosY);
             int fromPosX = 0;
             int fromPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
-                                                  fromH, fullW, fullH, fromPosX, fromPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
+                                  fromH, fullW, fullH, fromPosX, fromPosY);
             float t = transitionProgress;
             screenX = static_cast<int>(fromPosX + (toPosX - fromPosX) * t);
             screenY = static_cast<int>(fromPosY + (toPosY - fromPosY) * t);
@@ -4460,8 +4515,8 @@ static void RenderWindowOverlaysDirect(const std::vector<WindowOverlayConfig>& o
                 displayH = static_cast<int>(fromDisplayH + (toDisplayH - fromDisplayH) * t);
             }
         } else {
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, displayW, displayH, gameX, gameY, gameW, gameH,
-                                                  fullW, fullH, screenX, screenY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, displayW, displayH, gameX, gameY, gameW, gameH,
+                                  fullW, fullH, screenX, screenY);
         }
 
         int screenYGl = fullH - screenY - displayH;
@@ -4512,7 +4567,7 @@ static void RenderWindowOverlaysDirect(const std::vector<WindowOverlayConfig>& o
     glDisable(GL_BLEND);
 }
 
-static void RenderBrowserOverlaysDirect(const std::vector<BrowserOverlayConfig>& overlays, int fullW, int fullH, int gameX,
+static void RenderBrowserOverlaysDirect(std::span<const BrowserOverlayConfig> overlays, int fullW, int fullH, int gameX,
                                         int gameY, int gameW, int gameH, int gameResW, int gameResH, bool relativeStretching,
                                         float transitionProgress, int fromX, int fromY, int fromW, int fromH, float modeOpacity,
                                         bool excludeOnlyOnMyScreen) {
@@ -4547,7 +4602,8 @@ static void RenderBrowserOverlaysDirect(const std::vector<BrowserOverlayConfig>&
         int displayW = (std::max)(1, static_cast<int>(croppedW * conf.scale));
         int displayH = (std::max)(1, static_cast<int>(croppedH * conf.scale));
 
-        bool isViewportRelative = conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+        const Anchor anchor = ParseImageAnchor(conf.relativeTo);
+        const bool isViewportRelative = anchor.space == AnchorSpace::Viewport;
         int screenX = 0;
         int screenY = 0;
         if (isViewportRelative) {
@@ -4561,12 +4617,12 @@ static void RenderBrowserOverlaysDirect(const std::vector<BrowserOverlayConfig>&
             int fromDisplayH = relativeStretching ? static_cast<int>(displayH * fromScaleY) : displayH;
             int toPosX = 0;
             int toPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW,
-                                                  gameH, fullW, fullH, toPosX, toPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, toDisplayW, toDisplayH, gameX, gameY, gameW,
+                                  gameH, fullW, fullH, toPosX, toPosY);
             int fromPosX = 0;
             int fromPosY = 0;
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
-                                                  fromH, fullW, fullH, fromPosX, fromPosY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, fromDisplayW, fromDisplayH, fromX, fromY, fromW,
+                                  fromH, fullW, fullH, fromPosX, fromPosY);
             float t = transitionProgress;
             screenX = static_cast<int>(fromPosX + (toPosX - fromPosX) * t);
             screenY = static_cast<int>(fromPosY + (toPosY - fromPosY) * t);
@@ -4575,8 +4631,8 @@ static void RenderBrowserOverlaysDirect(const std::vector<BrowserOverlayConfig>&
                 displayH = static_cast<int>(fromDisplayH + (toDisplayH - fromDisplayH) * t);
             }
         } else {
-            GetRelativeCoordsForImageWithViewport(conf.relativeTo, conf.x, conf.y, displayW, displayH, gameX, gameY, gameW, gameH,
-                                                  fullW, fullH, screenX, screenY);
+            ResolveImageScreenPos(anchor, conf.x, conf.y, displayW, displayH, gameX, gameY, gameW, gameH,
+                                  fullW, fullH, screenX, screenY);
         }
 
         int screenYGl = fullH - screenY - displayH;
@@ -4706,7 +4762,7 @@ struct SameThreadOverlayState {
 struct SameThreadMirrorCaptureReuseState {
     bool available = false;
     uint64_t frameTag = 0;
-    const Config* configIdentity = nullptr;
+    uint64_t configGeneration = 0;
     std::string modeId;
     std::string fromModeId;
     bool hasEyeZoomSlideOut = false;
@@ -4820,7 +4876,7 @@ static bool CanReuseSameThreadMirrorCapture(const Config& cfg, const SameThreadO
                                             GLuint sourceTexture, int sourceW, int sourceH) {
     return request.allowMirrorCaptureReuse && request.mirrorCaptureFrameTag != 0 && s_sameThreadMirrorCaptureReuseState.available &&
            s_sameThreadMirrorCaptureReuseState.frameTag == request.mirrorCaptureFrameTag &&
-           s_sameThreadMirrorCaptureReuseState.configIdentity == &cfg &&
+           cfg.snapshotGeneration.value != 0 && s_sameThreadMirrorCaptureReuseState.configGeneration == cfg.snapshotGeneration.value &&
            s_sameThreadMirrorCaptureReuseState.modeId == request.modeId &&
            s_sameThreadMirrorCaptureReuseState.fromModeId == request.fromModeId &&
            s_sameThreadMirrorCaptureReuseState.hasEyeZoomSlideOut == hasEyeZoomSlideOutMirrors &&
@@ -4834,7 +4890,7 @@ static void CacheSameThreadMirrorCapture(const Config& cfg, const SameThreadOver
                                          int sourceW, int sourceH) {
     s_sameThreadMirrorCaptureReuseState.available = true;
     s_sameThreadMirrorCaptureReuseState.frameTag = request.mirrorCaptureFrameTag;
-    s_sameThreadMirrorCaptureReuseState.configIdentity = &cfg;
+    s_sameThreadMirrorCaptureReuseState.configGeneration = cfg.snapshotGeneration.value;
     s_sameThreadMirrorCaptureReuseState.modeId = request.modeId;
     s_sameThreadMirrorCaptureReuseState.fromModeId = request.fromModeId;
     s_sameThreadMirrorCaptureReuseState.hasEyeZoomSlideOut = hasEyeZoomSlideOutMirrors;
@@ -4986,42 +5042,26 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
         PrepareSameThreadOverlayState(s, request.fullW, request.fullH);
     }
 
-    static const Config* s_cachedActiveConfig = nullptr;
-    static uint64_t s_cachedActiveConfigVersion = UINT64_MAX;
-    static std::string s_cachedActiveModeId;
-    static int s_cachedActiveScreenW = 0;
-    static int s_cachedActiveScreenH = 0;
-    static bool s_cachedActiveImagesVisible = false;
-    static bool s_cachedActiveWindowOverlaysVisible = false;
-    static bool s_cachedActiveBrowserOverlaysVisible = false;
-    static std::vector<MirrorConfig> s_cachedActiveMirrors;
-    static std::vector<ImageConfig> s_cachedActiveImages;
-    static std::vector<const WindowOverlayConfig*> s_cachedActiveWindowOverlays;
-    static std::vector<const BrowserOverlayConfig*> s_cachedActiveBrowserOverlays;
-    static std::vector<ActiveModeSourceEntry> s_cachedActiveOrderedSources;
-    static uint64_t s_cachedEyeZoomSlideOutConfigVersion = 0;
+    static uint64_t s_cachedEyeZoomSlideOutConfigGeneration = 0;
     static std::string s_cachedEyeZoomSlideOutTargetModeId;
     static int s_cachedEyeZoomSlideOutScreenW = 0;
     static int s_cachedEyeZoomSlideOutScreenH = 0;
     static std::vector<MirrorConfig> s_cachedEyeZoomSlideOutMirrors;
-    static const Config* s_cachedTransitionSlideOutConfig = nullptr;
+    static uint64_t s_cachedTransitionSlideOutConfigGeneration = 0;
     static std::string s_cachedTransitionSlideOutFromModeId;
     static std::string s_cachedTransitionSlideOutTargetModeId;
     static int s_cachedTransitionSlideOutScreenW = 0;
     static int s_cachedTransitionSlideOutScreenH = 0;
     static std::vector<MirrorConfig> s_cachedTransitionSlideOutMirrors;
-    static const Config* s_cachedSameThreadCaptureConfig = nullptr;
+    static uint64_t s_cachedSameThreadCaptureConfigGeneration = 0;
     static std::string s_cachedSameThreadCaptureModeId;
     static int s_cachedSameThreadCaptureScreenW = 0;
     static int s_cachedSameThreadCaptureScreenH = 0;
     static std::vector<ThreadedMirrorConfig> s_cachedSameThreadCaptureConfigs;
     static const std::vector<MirrorConfig> s_emptyMirrors;
-    static const std::vector<ImageConfig> s_emptyImages;
-    static const std::vector<const WindowOverlayConfig*> s_emptyWindowOverlays;
-    static const std::vector<const BrowserOverlayConfig*> s_emptyBrowserOverlays;
-    static const std::vector<ActiveModeSourceEntry> s_emptyActiveSources;
+    static const ModeRenderPlan s_emptyModeRenderPlan;
 
-    const uint64_t cfgVersion = g_configSnapshotVersion.load(std::memory_order_acquire);
+    const uint64_t cfgGeneration = cfg.snapshotGeneration.value;
 
     GameViewportGeometry geo{};
     geo.gameW = request.gameW;
@@ -5039,56 +5079,29 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
                                          request.mirrorSlideProgress < 1.0f && !request.skipAnimation));
     const bool needModeElements = request.modeHasMirrors || request.modeHasImages || request.modeHasWindowOverlays ||
                                   request.modeHasBrowserOverlays || hasMirrorSlideOutWork;
-    const bool imagesVisible = request.modeHasImages;
-    const bool windowOverlaysVisible = request.modeHasWindowOverlays;
-    const bool browserOverlaysVisible = request.modeHasBrowserOverlays;
     const int resolvedTargetScreenW = request.toFullW > 0 ? request.toFullW : request.fullW;
     const int resolvedTargetScreenH = request.toFullH > 0 ? request.toFullH : request.fullH;
     const int resolvedSourceScreenW = request.fromFullW > 0 ? request.fromFullW : request.fullW;
     const int resolvedSourceScreenH = request.fromFullH > 0 ? request.fromFullH : request.fullH;
-    if (needModeElements) {
-        if (s_cachedActiveConfig != &cfg || s_cachedActiveConfigVersion != cfgVersion || s_cachedActiveModeId != request.modeId ||
-            s_cachedActiveScreenW != resolvedTargetScreenW || s_cachedActiveScreenH != resolvedTargetScreenH ||
-            s_cachedActiveImagesVisible != imagesVisible || s_cachedActiveWindowOverlaysVisible != windowOverlaysVisible ||
-            s_cachedActiveBrowserOverlaysVisible != browserOverlaysVisible) {
-            PROFILE_SCOPE_CAT("Collect Active Mode Elements", "Rendering");
-            s_cachedActiveConfig = &cfg;
-            s_cachedActiveConfigVersion = cfgVersion;
-            s_cachedActiveModeId = request.modeId;
-            s_cachedActiveScreenW = resolvedTargetScreenW;
-            s_cachedActiveScreenH = resolvedTargetScreenH;
-            s_cachedActiveImagesVisible = imagesVisible;
-            s_cachedActiveWindowOverlaysVisible = windowOverlaysVisible;
-            s_cachedActiveBrowserOverlaysVisible = browserOverlaysVisible;
-            ResolveActiveElementsForMode(cfg, request.modeId, false, cfgVersion, s_cachedActiveMirrors, s_cachedActiveImages,
-                                         s_cachedActiveWindowOverlays, s_cachedActiveBrowserOverlays,
-                                         &s_cachedActiveOrderedSources, resolvedTargetScreenW, resolvedTargetScreenH);
-        }
-    }
-    const std::vector<MirrorConfig>& activeMirrors = needModeElements ? s_cachedActiveMirrors : s_emptyMirrors;
-    const std::vector<ImageConfig>& activeImages = needModeElements ? s_cachedActiveImages : s_emptyImages;
-    const std::vector<const WindowOverlayConfig*>& activeWindowOverlays =
-        needModeElements ? s_cachedActiveWindowOverlays : s_emptyWindowOverlays;
-    const std::vector<const BrowserOverlayConfig*>& activeBrowserOverlays =
-        needModeElements ? s_cachedActiveBrowserOverlays : s_emptyBrowserOverlays;
-    const std::vector<ActiveModeSourceEntry>& activeOrderedSources = needModeElements ? s_cachedActiveOrderedSources : s_emptyActiveSources;
+    const ModeRenderPlan& activePlan = needModeElements
+                                           ? GetModeRenderPlan(cfg, request.modeId, resolvedTargetScreenW, resolvedTargetScreenH)
+                                           : s_emptyModeRenderPlan;
+    const std::vector<MirrorConfig>& activeMirrors = activePlan.mirrors;
+    const std::vector<ModeRenderPlanEntry>& activeEntries = activePlan.entries;
 
     if (!request.isRawWindowedMode && request.isTransitioningFromEyeZoom && cfg.eyezoom.slideMirrorsIn && !request.skipAnimation) {
-        if (s_cachedEyeZoomSlideOutConfigVersion != cfgVersion || s_cachedEyeZoomSlideOutTargetModeId != request.modeId ||
+        if (cfgGeneration == 0 || s_cachedEyeZoomSlideOutConfigGeneration != cfgGeneration ||
+            s_cachedEyeZoomSlideOutTargetModeId != request.modeId ||
             s_cachedEyeZoomSlideOutScreenW != resolvedSourceScreenW || s_cachedEyeZoomSlideOutScreenH != resolvedSourceScreenH) {
             PROFILE_SCOPE_CAT("Resolve EyeZoom Slide-Out Mirrors", "Rendering");
-            std::vector<MirrorConfig> eyeZoomMirrors;
-            std::vector<ImageConfig> unusedImages;
-            std::vector<const WindowOverlayConfig*> unusedOverlays;
-            std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
             std::unordered_set<std::string> activeMirrorNames;
             activeMirrorNames.reserve(activeMirrors.size());
             for (const auto& targetMirror : activeMirrors) {
                 activeMirrorNames.insert(targetMirror.name);
             }
 
-            CollectActiveElementsForMode(cfg, "EyeZoom", false, cfgVersion, eyeZoomMirrors, unusedImages, unusedOverlays,
-                                         unusedBrowserOverlays);
+            static const std::string kEyeZoomModeId = "EyeZoom";
+            const std::vector<MirrorConfig>& eyeZoomMirrors = GetModeRenderPlan(cfg, kEyeZoomModeId).mirrors;
 
             s_cachedEyeZoomSlideOutMirrors.clear();
             s_cachedEyeZoomSlideOutMirrors.reserve(eyeZoomMirrors.size());
@@ -5098,7 +5111,7 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
                 }
             }
 
-            s_cachedEyeZoomSlideOutConfigVersion = cfgVersion;
+            s_cachedEyeZoomSlideOutConfigGeneration = cfgGeneration;
             s_cachedEyeZoomSlideOutTargetModeId = request.modeId;
             s_cachedEyeZoomSlideOutScreenW = resolvedSourceScreenW;
             s_cachedEyeZoomSlideOutScreenH = resolvedSourceScreenH;
@@ -5109,23 +5122,19 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
 
     if (!request.isRawWindowedMode && !request.isTransitioningFromEyeZoom && request.fromSlideMirrorsIn && !request.fromModeId.empty() &&
         request.mirrorSlideProgress < 1.0f && !request.skipAnimation) {
-        if (s_cachedTransitionSlideOutConfig != &cfg || s_cachedTransitionSlideOutFromModeId != request.fromModeId ||
+        if (cfgGeneration == 0 || s_cachedTransitionSlideOutConfigGeneration != cfgGeneration ||
+            s_cachedTransitionSlideOutFromModeId != request.fromModeId ||
             s_cachedTransitionSlideOutTargetModeId != request.modeId ||
             s_cachedTransitionSlideOutScreenW != resolvedSourceScreenW ||
             s_cachedTransitionSlideOutScreenH != resolvedSourceScreenH) {
             PROFILE_SCOPE_CAT("Resolve Transition Slide-Out Mirrors", "Rendering");
-            std::vector<MirrorConfig> fromModeMirrors;
-            std::vector<ImageConfig> unusedImages;
-            std::vector<const WindowOverlayConfig*> unusedOverlays;
-            std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
             std::unordered_set<std::string> activeMirrorNames;
             activeMirrorNames.reserve(activeMirrors.size());
             for (const auto& targetMirror : activeMirrors) {
                 activeMirrorNames.insert(targetMirror.name);
             }
 
-            CollectActiveElementsForMode(cfg, request.fromModeId, false, cfgVersion, fromModeMirrors, unusedImages, unusedOverlays,
-                                         unusedBrowserOverlays);
+            const std::vector<MirrorConfig>& fromModeMirrors = GetModeRenderPlan(cfg, request.fromModeId).mirrors;
 
             s_cachedTransitionSlideOutMirrors.clear();
             s_cachedTransitionSlideOutMirrors.reserve(fromModeMirrors.size());
@@ -5135,7 +5144,7 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
                 }
             }
 
-            s_cachedTransitionSlideOutConfig = &cfg;
+            s_cachedTransitionSlideOutConfigGeneration = cfgGeneration;
             s_cachedTransitionSlideOutFromModeId = request.fromModeId;
             s_cachedTransitionSlideOutTargetModeId = request.modeId;
             s_cachedTransitionSlideOutScreenW = resolvedSourceScreenW;
@@ -5168,79 +5177,61 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
 
     const bool isEyeZoomMode = (request.modeId == "EyeZoom");
     const auto renderActiveSourceRange = [&](size_t beginIndex, size_t endIndex) {
-        if (beginIndex >= endIndex || endIndex > activeOrderedSources.size()) { return; }
-
-        std::vector<MirrorConfig> mirrorBatch;
-        std::vector<ImageConfig> singleImage;
-        std::vector<WindowOverlayConfig> singleWindowOverlay;
-        std::vector<BrowserOverlayConfig> singleBrowserOverlay;
-        singleImage.reserve(1);
-        singleWindowOverlay.reserve(1);
-        singleBrowserOverlay.reserve(1);
-
-        auto flushMirrorBatch = [&]() {
-            if (mirrorBatch.empty()) { return; }
-            RenderMirrorsDirect(mirrorBatch, geo, request.fullW, request.fullH, request.overlayOpacity,
-                                request.excludeOnlyOnMyScreen, request.relativeStretching, request.transitionProgress,
-                                request.mirrorSlideProgress, request.fromX, request.fromY, request.fromW, request.fromH,
-                                request.toX, request.toY, request.toW, request.toH, request.fromFullW, request.fromFullH,
-                                isEyeZoomMode,
-                                request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
-                                request.fromModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false, cfg);
-            mirrorBatch.clear();
-        };
+        if (beginIndex >= endIndex || endIndex > activeEntries.size()) { return; }
 
-        for (size_t sourceIndex = beginIndex; sourceIndex < endIndex; ++sourceIndex) {
-            const ActiveModeSourceEntry& source = activeOrderedSources[sourceIndex];
-
-            if (source.type != ActiveModeSourceType::Mirror) { flushMirrorBatch(); }
+        size_t sourceIndex = beginIndex;
+        while (sourceIndex < endIndex) {
+            const ModeRenderPlanEntry& source = activeEntries[sourceIndex];
 
             switch (source.type) {
-            case ActiveModeSourceType::Mirror:
-                if (request.isRawWindowedMode) { break; }
-                mirrorBatch.push_back(source.mirror);
-                break;
+            case ActiveModeSourceType::Mirror: {
+                // Consecutive mirror entries index a contiguous slice of the plan's mirrors; draw them as one batch.
+                size_t runEnd = sourceIndex + 1;
+                while (runEnd < endIndex && activeEntries[runEnd].type == ActiveModeSourceType::Mirror) { ++runEnd; }
+                if (!request.isRawWindowedMode) {
+                    RenderMirrorsDirect(std::span<const MirrorConfig>(activePlan.mirrors.data() + source.index, runEnd - sourceIndex),
+                                        geo, request.fullW, request.fullH, request.overlayOpacity, request.excludeOnlyOnMyScreen,
+                                        request.relativeStretching, request.transitionProgress, request.mirrorSlideProgress,
+                                        request.fromX, request.fromY, request.fromW, request.fromH, request.toX, request.toY,
+                                        request.toW, request.toH, request.fromFullW, request.fromFullH, isEyeZoomMode,
+                                        request.isTransitioningFromEyeZoom, request.eyeZoomAnimatedViewportX, request.skipAnimation,
+                                        request.fromModeId, request.fromSlideMirrorsIn, request.toSlideMirrorsIn, false, cfg);
+                }
+                sourceIndex = runEnd;
+                continue;
+            }
 
             case ActiveModeSourceType::Image:
-                if (request.isRawWindowedMode || !source.image) { break; }
-                singleImage.clear();
-                singleImage.push_back(*source.image);
-                RenderImagesDirect(singleImage, request.fullW, request.fullH, request.toX, request.toY, request.toW,
-                                   request.toH, request.gameW, request.gameH, request.relativeStretching,
-                                   request.transitionProgress, request.fromX, request.fromY, request.fromW, request.fromH,
-                                   request.overlayOpacity, request.excludeOnlyOnMyScreen);
+                if (request.isRawWindowedMode) { break; }
+                RenderImagesDirect(std::span<const ImageConfig>(activePlan.images[source.index], 1), request.fullW, request.fullH,
+                                   request.toX, request.toY, request.toW, request.toH, request.gameW, request.gameH,
+                                   request.relativeStretching, request.transitionProgress, request.fromX, request.fromY,
+                                   request.fromW, request.fromH, request.overlayOpacity, request.excludeOnlyOnMyScreen);
                 break;
 
             case ActiveModeSourceType::WindowOverlay:
-                if (!source.windowOverlay) { break; }
-                singleWindowOverlay.clear();
-                singleWindowOverlay.push_back(*source.windowOverlay);
-                RenderWindowOverlaysDirect(singleWindowOverlay, request.fullW, request.fullH, request.toX, request.toY,
-                                           request.toW, request.toH, request.gameW, request.gameH,
-                                           request.relativeStretching, request.transitionProgress, request.fromX,
-                                           request.fromY, request.fromW, request.fromH, request.overlayOpacity,
+                RenderWindowOverlaysDirect(std::span<const WindowOverlayConfig>(activePlan.windowOverlays[source.index], 1),
+                                           request.fullW, request.fullH, request.toX, request.toY, request.toW, request.toH,
+                                           request.gameW, request.gameH, request.relativeStretching, request.transitionProgress,
+                                           request.fromX, request.fromY, request.fromW, request.fromH, request.overlayOpacity,
                                            request.excludeOnlyOnMyScreen);
                 break;
 
             case ActiveModeSourceType::BrowserOverlay:
-                if (!source.browserOverlay) { break; }
-                singleBrowserOverlay.clear();
-                singleBrowserOverlay.push_back(*source.browserOverlay);
-                RenderBrowserOverlaysDirect(singleBrowserOverlay, request.fullW, request.fullH, request.toX, request.toY,
-                                            request.toW, request.toH, request.gameW, request.gameH,
-                                            request.relativeStretching, request.transitionProgress, request.fromX,
-                                            request.fromY, request.fromW, request.fromH, request.overlayOpacity,
+                RenderBrowserOverlaysDirect(std::span<const BrowserOverlayConfig>(activePlan.browserOverlays[source.index], 1),
+                                            request.fullW, request.fullH, request.toX, request.toY, request.toW, request.toH,
+                                            request.gameW, request.gameH, request.relativeStretching, request.transitionProgress,
+                                            request.fromX, request.fromY, request.fromW, request.fromH, request.overlayOpacity,
                                             request.excludeOnlyOnMyScreen);
                 break;
             }
+            ++sourceIndex;
         }
-
-        flushMirrorBatch();
     };
 
-    size_t firstNonMirrorSource = activeOrderedSources.size();
-    for (size_t i = 0; i < activeOrderedSources.size(); ++i) {
-        if (activeOrderedSources[i].type != ActiveModeSourceType::Mirror) {
+    size_t firstNonMirrorSource = activeEntries.size();
+    for (size_t i = 0; i < activeEntries.size(); ++i) {
+        if (activeEntries[i].type != ActiveModeSourceType::Mirror) {
             firstNonMirrorSource = i;
             break;
         }
@@ -5252,14 +5243,15 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
         int sourceH = 0;
         const bool hasEyeZoomSlideOutMirrors = !eyeZoomSlideOutMirrors->empty();
         const bool hasTransitionSlideOutMirrors = !transitionSlideOutMirrors->empty();
-        if (s_cachedSameThreadCaptureConfig != &cfg || s_cachedSameThreadCaptureModeId != request.modeId ||
+        if (cfgGeneration == 0 || s_cachedSameThreadCaptureConfigGeneration != cfgGeneration ||
+            s_cachedSameThreadCaptureModeId != request.modeId ||
             s_cachedSameThreadCaptureScreenW != resolvedTargetScreenW ||
             s_cachedSameThreadCaptureScreenH != resolvedTargetScreenH) {
             PROFILE_SCOPE_CAT("Build Same-Thread Capture Configs", "Rendering");
             std::vector<MirrorConfig> mirrorsForCapture = activeMirrors;
             BuildThreadedMirrorConfigs(mirrorsForCapture, s_cachedSameThreadCaptureConfigs);
 
-            s_cachedSameThreadCaptureConfig = &cfg;
+            s_cachedSameThreadCaptureConfigGeneration = cfgGeneration;
             s_cachedSameThreadCaptureModeId = request.modeId;
             s_cachedSameThreadCaptureScreenW = resolvedTargetScreenW;
             s_cachedSameThreadCaptureScreenH = resolvedTargetScreenH;
@@ -5316,9 +5308,9 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
         }
     }
 
-    if (firstNonMirrorSource < activeOrderedSources.size()) {
+    if (firstNonMirrorSource < activeEntries.size()) {
         PROFILE_SCOPE_CAT("Render Ordered Non-Mirror Sources", "Rendering");
-        renderActiveSourceRange(firstNonMirrorSource, activeOrderedSources.size());
+        renderActiveSourceRange(firstNonMirrorSource, activeEntries.size());
     }
 
     if (request.showRebindIndicator) {
@@ -5348,8 +5340,8 @@ static bool RenderSameThreadOverlayPass(const SameThreadOverlayState& request, c
                            request.startupIndicatorMode,
                            request.startupIndicatorImagePath);
     }
-    return !activeMirrors.empty() || !eyeZoomSlideOutMirrors->empty() || !transitionSlideOutMirrors->empty() || !activeImages.empty() ||
-            !activeWindowOverlays.empty() || !activeBrowserOverlays.empty() || request.shouldRenderGui || request.showPerformanceOverlay || request.showProfiler ||
+    return !activeMirrors.empty() || !eyeZoomSlideOutMirrors->empty() || !transitionSlideOutMirrors->empty() || !activePlan.images.empty() ||
+            !activePlan.windowOverlays.empty() || !activePlan.browserOverlays.empty() || request.shouldRenderGui || request.showPerformanceOverlay || request.showProfiler ||
            request.showTextureGrid || request.showEyeZoom || request.showWelcomeToast || request.showRebindIndicator || renderCursorTrail || renderNinjabrainOverlay;
 }
 
@@ -7251,15 +7243,19 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
         if (useFramebufferFallback) {
             auto now = std::chrono::steady_clock::now();
 
-            static std::vector<MirrorConfig> fallbackMirrors;
-            static std::vector<ImageConfig> unusedImages;
-            static std::vector<const WindowOverlayConfig*> unusedOverlays;
-            static std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
             static std::vector<size_t> mirrorsNeedingUpdate;
-            const Config& fallbackConfig = configSnap ? *configSnap : g_config;
-            const uint64_t fallbackConfigVersion = configSnap ? g_configSnapshotVersion.load(std::memory_order_acquire) : 0;
-            CollectActiveElementsForMode(fallbackConfig, modeToRender->id, false, fallbackConfigVersion, fallbackMirrors,
-                                         unusedImages, unusedOverlays, unusedBrowserOverlays);
+            // Published snapshots are immutable per version, so their plan can be reused; the live config has no
+            // version to key on and is resolved every frame as before.
+            static std::vector<MirrorConfig> liveConfigMirrors;
+            if (!configSnap) {
+                std::vector<ImageConfig> unusedImages;
+                std::vector<const WindowOverlayConfig*> unusedOverlays;
+                std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
+                CollectActiveElementsForMode(g_config, modeToRender->id, false, liveConfigMirrors, unusedImages, unusedOverlays,
+                                             unusedBrowserOverlays);
+            }
+            const std::vector<MirrorConfig>& fallbackMirrors =
+                configSnap ? GetModeRenderPlan(*configSnap, modeToRender->id).mirrors : liveConfigMirrors;
 
             mirrorsNeedingUpdate.clear();
             mirrorsNeedingUpdate.reserve(fallbackMirrors.size());
@@ -7577,8 +7573,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         int displayH = 0;
                         ResolveConfiguredImageDimensions(conf, texWidth, texHeight, displayW, displayH);
 
-                        const bool isViewportRelative =
-                            conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+                        const bool isViewportRelative = IsViewportAnchorText(conf.relativeTo);
                         if (isViewportRelative) {
                             const float viewportScaleX =
                                 (currentGeo.finalW > 0 && currentGeo.gameW > 0) ? static_cast<float>(currentGeo.finalW) / currentGeo.gameW : 1.0f;
@@ -8463,8 +8458,7 @@ void RenderModeInternal(const ModeConfig* modeToRender, const GLState& s, int cu
                         int displayW = (std::max)(1, static_cast<int>(croppedW * conf.scale));
                         int displayH = (std::max)(1, static_cast<int>(croppedH * conf.scale));
 
-                        const bool isViewportRelative =
-                            conf.relativeTo.length() > 8 && conf.relativeTo.substr(conf.relativeTo.length() - 8) == "Viewport";
+                        const bool isViewportRelative = IsViewportAnchorText(conf.relativeTo);
                         if (isViewportRelative) {
                             const float viewportScaleX =
                                 (currentGeo.finalW > 0 && currentGeo.gameW > 0) ? static_cast<float>(currentGeo.finalW) / currentGeo.gameW : 1.0f;
@@ -9679,6 +9673,10 @@ static void ResolveModeTransitionTargetBounds(const ModeConfig& mode, int fullW,
 }
 
 static void PublishViewportTransitionSnapshotLocked() {
+    const ViewportTransitionSnapshot& previous = g_viewportTransitionSnapshots[g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed)];
+    // Sensitivity follows the transition target, so only a start, end or retarget needs a refresh.
+    const bool sensitivityInputsChanged = previous.active != g_modeTransition.active || previous.toModeId != g_modeTransition.toModeId;
+
     int nextSnapshotIndex = 1 - g_viewportTransitionSnapshotIndex.load(std::memory_order_relaxed);
     ViewportTransitionSnapshot& snapshot = g_viewportTransitionSnapshots[nextSnapshotIndex];
     snapshot.active = g_modeTransition.active;
@@ -9708,13 +9706,14 @@ static void PublishViewportTransitionSnapshotLocked() {
     snapshot.moveProgress = g_modeTransition.moveProgress;
     snapshot.startTime = g_modeTransition.startTime;
     g_viewportTransitionSnapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
+    if (sensitivityInputsChanged) { RefreshSensitivityState(); }
 }
 
 void StartModeTransition(const std::string& fromModeId, const std::string& toModeId, int fromWidth, int fromHeight, int fromX, int fromY,
                          int toWidth, int toHeight, int toX, int toY, const ModeConfig& toMode) {
-    LogCategory("animation", "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
+    LOG_CATEGORY(Animation, "[ANIMATION] StartModeTransition entry - acquiring g_modeTransitionMutex...");
     std::lock_guard<std::mutex> lock(g_modeTransitionMutex);
-    LogCategory("animation", "[ANIMATION] g_modeTransitionMutex acquired");
+    LOG_CATEGORY(Animation, "[ANIMATION] g_modeTransitionMutex acquired");
 
     bool transitioningToFullscreen = EqualsIgnoreCase(toModeId, "Fullscreen");
     bool transitioningFromFullscreen = EqualsIgnoreCase(fromModeId, "Fullscreen");
@@ -9723,7 +9722,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
                               toMode.backgroundTransition == BackgroundTransitionType::Cut;
 
     if (isAllCutTransition && !transitioningToFullscreen) {
-        LogCategory("animation", "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
+        LOG_CATEGORY(Animation, "[ANIMATION] Cut/Cut/Cut transition - using 1-frame protection to prevent black flash");
     }
 
     g_modeTransition.active = true;
@@ -9809,7 +9808,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
 
     if (transitioningFromEyeZoom && !transitioningToEyeZoom) {
         g_isTransitioningFromEyeZoom.store(true, std::memory_order_release);
-        LogCategory("animation", "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
+        LOG_CATEGORY(Animation, "[ANIMATION] Set g_isTransitioningFromEyeZoom=true BEFORE WM_SIZE to freeze snapshot");
     } else {
         g_isTransitioningFromEyeZoom.store(false, std::memory_order_release);
     }
@@ -9824,11 +9823,11 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
         if (posted) {
             g_modeTransition.lastSentWidth = wmWidth;
             g_modeTransition.lastSentHeight = wmHeight;
-            LogCategory("animation", "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
+            LOG_CATEGORY(Animation, "[ANIMATION] WM_SIZE sent immediately: " + std::to_string(wmWidth) + "x" + std::to_string(wmHeight));
         }
     }
 
-    LogCategory("animation", "[ANIMATION] Starting mode transition (Game:" + GameTransitionTypeToString(toMode.gameTransition) +
+    LOG_CATEGORY(Animation, "[ANIMATION] Starting mode transition (Game:" + GameTransitionTypeToString(toMode.gameTransition) +
                                  ", Overlay:" + OverlayTransitionTypeToString(toMode.overlayTransition) +
                                  ", Bg:" + BackgroundTransitionTypeToString(toMode.backgroundTransition) + ", " +
                                  std::to_string(toMode.transitionDurationMs) + "ms): " + fromModeId + " (" + std::to_string(fromWidth) +
@@ -9838,7 +9837,7 @@ void StartModeTransition(const std::string& fromModeId, const std::string& toMod
 
     PublishViewportTransitionSnapshotLocked();
 
-    LogCategory("animation", "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
+    LOG_CATEGORY(Animation, "[ANIMATION] StartModeTransition complete - releasing g_modeTransitionMutex");
 }
 
 void RetargetActiveModeTransition(const ModeConfig& mode) {
@@ -10001,7 +10000,7 @@ void UpdateModeTransition() {
     bool allComplete = (elapsed >= totalDuration);
 
     if (allComplete) {
-        LogCategory("animation", "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
+        LOG_CATEGORY(Animation, "[ANIMATION] Mode transition complete: " + g_modeTransition.toModeId + " (final stretch: " +
                                      std::to_string(g_modeTransition.toWidth) + "x" + std::to_string(g_modeTransition.toHeight) + " at " +
                                      std::to_string(g_modeTransition.toX) + "," + std::to_string(g_modeTransition.toY) + ")");
 
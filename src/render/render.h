@@ -195,6 +195,8 @@ struct BackgroundTextureInstance {
     uint64_t totalAnimationDurationMs = 0;
     size_t currentFrame = 0;
     std::chrono::steady_clock::time_point lastFrameTime;
+    std::shared_ptr<MpegVideoStream> videoStream;
+    uint64_t uploadedVideoSequence = UINT64_MAX;
 };
 
 extern std::unordered_map<std::string, BackgroundTextureInstance> g_backgroundTextures;
@@ -264,7 +266,7 @@ void RenderMirrors(const std::vector<MirrorConfig>& activeMirrors, const GameVie
                    float modeOpacity = 1.0f, bool excludeOnlyOnMyScreen = false);
 void RenderImages(const std::vector<ImageConfig>& activeImages, int fullW, int fullH, float modeOpacity = 1.0f,
                   bool excludeOnlyOnMyScreen = false);
-void CollectActiveElementsForMode(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass, uint64_t configVersion,
+void CollectActiveElementsForMode(const Config& config, const std::string& modeId, bool onlyOnMyScreenPass,
                                   std::vector<MirrorConfig>& outMirrors, std::vector<ImageConfig>& outImages,
                                   std::vector<const WindowOverlayConfig*>& outWindowOverlays,
                                   std::vector<const BrowserOverlayConfig*>& outBrowserOverlays,
@@ -276,6 +278,7 @@ bool RenderModeOverlaysForIntegrationTest(const Config& config, const ModeConfig
 #ifdef TOOLSCREEN_GUI_INTEGRATION_TESTS
 const char* GetNinjabrainOverlayRenderEligibilityFailureForIntegrationTest(const std::string& modeId,
                                                                            bool excludeOnlyOnMyScreen = false);
+uint64_t GetModeRenderPlanCompileCountForIntegrationTest();
 #endif
 void RenderMode(const ModeConfig* modeToRender, const GLState& s, int current_gameW, int current_gameH, bool skipAnimation = false,
                 bool excludeOnlyOnMyScreen = false);
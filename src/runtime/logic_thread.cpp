@@ -1,5 +1,6 @@
 #include "logic_thread.h"
 #include "common/mode_dimensions.h"
+#include "config/config_diff.h"
 #include "gui/gui.h"
 #include "render/mirror_thread.h"
 #include "common/profiler.h"
@@ -46,7 +47,7 @@ void ApplyWindowsMouseSpeed();
 CachedModeViewport g_viewportModeCache[2];
 std::atomic<int> g_viewportModeCacheIndex{ 0 };
 static std::string s_lastCachedModeId;
-static uint64_t s_lastCachedViewportSnapshotVersion = 0;
+static uint64_t s_lastCachedViewportModesVersion = 0;
 
 static bool s_wasInWorld = false;
 static int s_lastAppliedWindowsMouseSpeed = -1;
@@ -156,9 +157,12 @@ void RequestScreenMetricsRecalculation() {
     s_screenMetricsRecalcRequested.store(true, std::memory_order_relaxed);
 }
 
-static std::vector<std::string> s_lastActiveMirrorIds;
+static std::vector<MirrorConfig> s_lastActiveMirrorsForCapture;
 static std::string s_lastMirrorConfigModeId;
-static uint64_t s_lastMirrorConfigSnapshotVersion = 0;
+static uint64_t s_lastMirrorConfigSectionsVersion = 0;
+// The capture plan only depends on these sections; edits elsewhere (images, hotkeys, ...) leave it alone.
+constexpr ConfigSectionMask kMirrorCaptureConfigSections =
+    ConfigSectionBit(ConfigSection::Mirrors) | ConfigSectionBit(ConfigSection::MirrorGroups) | ConfigSectionBit(ConfigSection::Modes);
 static int s_lastViewportScreenW = 0;
 static int s_lastViewportScreenH = 0;
 
@@ -170,18 +174,26 @@ void UpdateActiveMirrorConfigs() {
         const MirrorGroupItem* item = nullptr;
     };
 
+    // Get current mode ID from double-buffer (lock-free)
+    std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
+
+    const uint64_t sectionsVer = GetConfigSectionsVersion(kMirrorCaptureConfigSections);
+    if (currentModeId == s_lastMirrorConfigModeId && sectionsVer == s_lastMirrorConfigSectionsVersion) {
+        return;
+    }
+
     // Use config snapshot for thread-safe access to modes/mirrors/mirrorGroups
     auto cfgSnap = GetConfigSnapshot();
     if (!cfgSnap) return;
     const Config& cfg = *cfgSnap;
 
-    const uint64_t snapVer = g_configSnapshotVersion.load(std::memory_order_acquire);
-    static uint64_t s_lookupSnapshotVersion = 0;
+    // The lookups point into the snapshot they were built from, so keep that snapshot alive alongside them.
+    static std::shared_ptr<const Config> s_lookupSnapshot;
     static std::unordered_map<std::string, const MirrorGroupConfig*> s_groupByName;
     static std::unordered_map<std::string, const MirrorConfig*> s_mirrorByName;
 
-    if (s_lookupSnapshotVersion != snapVer) {
-        s_lookupSnapshotVersion = snapVer;
+    if (s_lookupSnapshot != cfgSnap) {
+        s_lookupSnapshot = cfgSnap;
         s_groupByName.clear();
         s_mirrorByName.clear();
         s_groupByName.reserve(cfg.mirrorGroups.size());
@@ -190,12 +202,6 @@ void UpdateActiveMirrorConfigs() {
         for (const auto& mirror : cfg.mirrors) { s_mirrorByName[mirror.name] = &mirror; }
     }
 
-    // Get current mode ID from double-buffer (lock-free)
-    std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-
-    if (currentModeId == s_lastMirrorConfigModeId && snapVer == s_lastMirrorConfigSnapshotVersion) {
-        return;
-    }
     const ModeConfig* mode = GetModeFromSnapshotOrFallback(cfg, currentModeId);
     if (!mode) { return; }
 
@@ -260,11 +266,22 @@ void UpdateActiveMirrorConfigs() {
 
         activeMirrorsForCapture.push_back(activeMirror);
     }
-    UpdateMirrorCaptureConfigs(activeMirrorsForCapture);
-    s_lastActiveMirrorIds = currentMirrorIds;
+    // Only mirrors whose resolved capture config changed (or that entered or left the mode) lose their capture
+    // state; the rest keep capturing undisturbed.
+    ConfigElementChanges mirrorChanges;
+    if (DiffKeyedElements(s_lastActiveMirrorsForCapture, activeMirrorsForCapture,
+                          [](const MirrorConfig& mirror) -> const std::string& { return mirror.name; }, mirrorChanges)) {
+        std::vector<std::string> invalidatedMirrors;
+        invalidatedMirrors.reserve(mirrorChanges.added.size() + mirrorChanges.removed.size() + mirrorChanges.modified.size());
+        for (const auto* names : { &mirrorChanges.added, &mirrorChanges.removed, &mirrorChanges.modified }) {
+            invalidatedMirrors.insert(invalidatedMirrors.end(), names->begin(), names->end());
+        }
+        UpdateMirrorCaptureConfigs(activeMirrorsForCapture, invalidatedMirrors);
+        s_lastActiveMirrorsForCapture = std::move(activeMirrorsForCapture);
+    }
 
     s_lastMirrorConfigModeId = currentModeId;
-    s_lastMirrorConfigSnapshotVersion = snapVer;
+    s_lastMirrorConfigSectionsVersion = sectionsVer;
 }
 
 void UpdateCachedScreenMetrics() {
@@ -439,7 +456,8 @@ void UpdateCachedViewportMode() {
 
     // Read current mode ID from double-buffer (lock-free)
     std::string currentModeId = g_modeIdBuffers[g_currentModeIdIndex.load(std::memory_order_acquire)];
-    const uint64_t snapVer = g_configSnapshotVersion.load(std::memory_order_acquire);
+    // The viewport cache only reads the mode list.
+    const uint64_t modesVer = GetConfigSectionVersion(ConfigSection::Modes);
 
     // Also force periodic refresh every 60 ticks (~1 second) as a safety net
     static int s_ticksSinceRefresh = 0;
@@ -449,7 +467,7 @@ void UpdateCachedViewportMode() {
     const int screenH = s_cachedScreenHeight.load(std::memory_order_relaxed);
     const bool screenMetricsChanged = (screenW != s_lastViewportScreenW) || (screenH != s_lastViewportScreenH);
 
-    if (currentModeId == s_lastCachedModeId && snapVer == s_lastCachedViewportSnapshotVersion && !guiOpen && !periodicRefresh &&
+    if (currentModeId == s_lastCachedModeId && modesVer == s_lastCachedViewportModesVersion && !guiOpen && !periodicRefresh &&
         !screenMetricsChanged) {
         return;
     }
@@ -487,7 +505,7 @@ void UpdateCachedViewportMode() {
     // Atomic swap to make new cache visible
     g_viewportModeCacheIndex.store(nextIndex, std::memory_order_release);
     s_lastCachedModeId = currentModeId;
-    s_lastCachedViewportSnapshotVersion = snapVer;
+    s_lastCachedViewportModesVersion = modesVer;
     s_lastViewportScreenW = screenW;
     s_lastViewportScreenH = screenH;
 }
@@ -563,7 +581,7 @@ void ProcessPendingModeSwitch() {
 
         SwitchToMode(toModeId, "Preview (animated)");
     } else {
-        LogCategory("gui", "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
+        LOG_CATEGORY(Gui, "[GUI] Processing deferred mode switch to: " + g_pendingModeSwitch.modeId +
                                " (source: " + g_pendingModeSwitch.source + ")");
 
         // This avoids cross-thread mutation of g_config from the logic thread
@@ -633,7 +651,7 @@ static void CheckAutoBorderless() {
 }
 
 static void LogicThreadFunc() {
-    LogCategory("init", "[LogicThread] Started");
+    LOG_CATEGORY(Init, "[LogicThread] Started");
 
     const auto tickInterval = std::chrono::milliseconds(16);
 
@@ -684,7 +702,7 @@ void StartLogicThread() {
     g_logicThread = std::thread(LogicThreadFunc);
     g_logicThreadRunning.store(true);
 
-    LogCategory("init", "[LogicThread] Logic thread started");
+    LOG_CATEGORY(Init, "[LogicThread] Logic thread started");
 }
 
 void StopLogicThread() {
@@ -0,0 +1,419 @@
+#include "common/anchor_layout.h"
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+// String-based implementations the solver replaced, kept as the reference.
+void LegacyGetRelativeCoords(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
+                             int& outY) {
+    std::string anchor = type;
+    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") {
+        anchor = anchor.substr(0, anchor.length() - 8);
+    } else if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
+        anchor = anchor.substr(0, anchor.length() - 6);
+    }
+
+    char firstChar = anchor.empty() ? '\0' : anchor[0];
+
+    if (firstChar == 't') {
+        outY = relY;
+        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
+    } else if (firstChar == 'c') {
+        outX = (containerW - w) / 2 + relX;
+        outY = (containerH - h) / 2 + relY;
+    } else if (firstChar == 'p') {
+        const int PIE_Y_TOP = 220, PIE_X_LEFT = 92, PIE_X_RIGHT = 36;
+        int base_x = (anchor == "pieLeft") ? containerW - PIE_X_LEFT : containerW - PIE_X_RIGHT;
+        outX = base_x + relX;
+        outY = containerH - PIE_Y_TOP + relY;
+    } else {
+        outY = containerH - h - relY;
+        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
+    }
+}
+
+void LegacyGetRelativeCoordsForImage(const std::string& type, int relX, int relY, int w, int h, int containerW, int containerH, int& outX,
+                                     int& outY) {
+    int anchor_x = 0, anchor_y = 0;
+    char firstChar = type.empty() ? '\0' : type[0];
+
+    if (firstChar == 't') {
+        anchor_x = (type == "topLeft") ? 0 : containerW - w;
+        anchor_y = 0;
+    } else if (firstChar == 'c') {
+        anchor_x = (containerW - w) / 2;
+        anchor_y = (containerH - h) / 2;
+    } else if (firstChar == 'b') {
+        anchor_x = (type == "bottomLeft") ? 0 : containerW - w;
+        anchor_y = containerH - h;
+    }
+
+    outX = anchor_x + relX;
+    outY = anchor_y + relY;
+}
+
+void LegacyGetRelativeCoordsForImageWithViewport(const std::string& type, int relX, int relY, int w, int h, int gameX, int gameY,
+                                                 int gameW, int gameH, int fullW, int fullH, int& outX, int& outY) {
+    if (type.length() > 8 && type.substr(type.length() - 8) == "Viewport") {
+        std::string baseAnchor = type.substr(0, type.length() - 8);
+        int localX = 0, localY = 0;
+        LegacyGetRelativeCoordsForImage(baseAnchor, relX, relY, w, h, gameW, gameH, localX, localY);
+        outX = gameX + localX;
+        outY = gameY + localY;
+    } else {
+        std::string baseAnchor = type;
+        if (type.length() > 6 && type.substr(type.length() - 6) == "Screen") { baseAnchor = type.substr(0, type.length() - 6); }
+        LegacyGetRelativeCoordsForImage(baseAnchor, relX, relY, w, h, fullW, fullH, outX, outY);
+    }
+}
+
+// CalculateFinalScreenPos after the scale has been applied to the mirror size.
+void LegacyCalculateFinalScreenPos(const std::string& relativeTo, int offsetX, int offsetY, int outW, int outH, int finalX, int finalY,
+                                   int finalW, int finalH, int fullW, int fullH, int& outScreenX, int& outScreenY) {
+    std::string anchor = relativeTo;
+    if (anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen") {
+        anchor = anchor.substr(0, anchor.length() - 6);
+        LegacyGetRelativeCoords(anchor, offsetX, offsetY, outW, outH, fullW, fullH, outScreenX, outScreenY);
+        return;
+    }
+
+    if (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport") { anchor = anchor.substr(0, anchor.length() - 8); }
+
+    int relative_x = 0;
+    int relative_y = 0;
+    LegacyGetRelativeCoords(anchor, offsetX, offsetY, outW, outH, finalW, finalH, relative_x, relative_y);
+    outScreenX = finalX + relative_x;
+    outScreenY = finalY + relative_y;
+}
+
+// The render thread's splitRelativeAnchor lambda.
+void LegacySplitRelativeAnchor(const std::string& relativeTo, std::string& anchorOut, bool& isScreenRelativeOut) {
+    anchorOut = relativeTo;
+    isScreenRelativeOut = false;
+    if (anchorOut.length() > 6 && anchorOut.substr(anchorOut.length() - 6) == "Screen") {
+        anchorOut = anchorOut.substr(0, anchorOut.length() - 6);
+        isScreenRelativeOut = true;
+    } else if (anchorOut.length() > 8 && anchorOut.substr(anchorOut.length() - 8) == "Viewport") {
+        anchorOut = anchorOut.substr(0, anchorOut.length() - 8);
+    }
+}
+
+void LegacyMirrorGroupAnchor(const std::string& anchor, int groupX, int groupY, int finalX, int finalY, int finalW, int finalH, int fullW,
+                             int fullH, int& outX, int& outY) {
+    const bool isScreen = anchor.length() > 6 && anchor.substr(anchor.length() - 6) == "Screen";
+    if (isScreen) {
+        LegacyGetRelativeCoords(anchor, groupX, groupY, 0, 0, fullW, fullH, outX, outY);
+    } else {
+        LegacyGetRelativeCoords(anchor, groupX, groupY, 0, 0, finalW, finalH, outX, outY);
+        outX += finalX;
+        outY += finalY;
+    }
+}
+
+std::string LegacyNormalizeCaptureAnchor(const std::string& relativeTo) {
+    if (relativeTo.length() > 8 && relativeTo.substr(relativeTo.length() - 8) == "Viewport") {
+        return relativeTo.substr(0, relativeTo.length() - 8);
+    }
+    if (relativeTo.length() > 6 && relativeTo.substr(relativeTo.length() - 6) == "Screen") {
+        return relativeTo.substr(0, relativeTo.length() - 6);
+    }
+    return relativeTo;
+}
+
+void LegacyMtGetRelativeCoordsNormalized(const std::string& anchor, int relX, int relY, int w, int h, int containerW, int containerH,
+                                         int& outX, int& outY) {
+    char firstChar = anchor.empty() ? '\0' : anchor[0];
+
+    if (firstChar == 't') {
+        outY = relY;
+        outX = (anchor == "topLeft") ? relX : containerW - w - relX;
+    } else if (firstChar == 'c') {
+        outX = (containerW - w) / 2 + relX;
+        outY = (containerH - h) / 2 + relY;
+    } else if (firstChar == 'p') {
+        const int pieYTop = 220;
+        const int pieXLeft = 92;
+        const int pieXRight = 36;
+        int baseX = (anchor == "pieLeft") ? containerW - pieXLeft : containerW - pieXRight;
+        outX = baseX + relX;
+        outY = containerH - pieYTop + relY;
+    } else {
+        outY = containerH - h - relY;
+        outX = (anchor == "bottomRight") ? containerW - w - relX : relX;
+    }
+}
+
+// Every anchor the GUI can write, plus spellings that only hand-edited configs produce.
+std::vector<std::string> AnchorStrings() {
+    std::vector<std::string> anchors;
+    const char* bases[] = { "topLeft", "topRight", "center", "bottomLeft", "bottomRight", "pieLeft", "pieRight" };
+    const char* suffixes[] = { "", "Screen", "Viewport" };
+    for (const char* base : bases) {
+        for (const char* suffix : suffixes) anchors.push_back(std::string(base) + suffix);
+    }
+    const char* odd[] = { "",
+                          "t",
+                          "c",
+                          "b",
+                          "p",
+                          "x",
+                          "top",
+                          "bottom",
+                          "pie",
+                          "centre",
+                          "TopLeft",
+                          "bogus",
+                          "Screen",
+                          "Viewport",
+                          "xScreen",
+                          "xViewport",
+                          "topLeftScreenViewport",
+                          "topLeftViewportScreen",
+                          "bottomRightScreenScreen",
+                          "bottomRightViewportViewport",
+                          "pieLeftViewportScreen",
+                          "bottomLeftscreen",
+                          "topRight " };
+    for (const char* s : odd) anchors.emplace_back(s);
+    return anchors;
+}
+
+const int kSizes[] = { 0, 1, 37, 200, 1921 };
+const int kContainers[] = { 0, 1, 300, 1920, 2560 };
+const int kOffsets[] = { -250, -1, 0, 1, 7, 513 };
+
+// Calls fn(w, h, containerW, containerH, relX, relY) for every combination of the value tables.
+template <typename Fn>
+void ForEachLayout(Fn&& fn) {
+    for (int w : kSizes) {
+        for (int h : kSizes) {
+            for (int cw : kContainers) {
+                for (int ch : kContainers) {
+                    for (int rx : kOffsets) {
+                        for (int ry : kOffsets) fn(w, h, cw, ch, rx, ry);
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::string Describe(const std::string& anchor, int w, int h, int cw, int ch, int rx, int ry) {
+    return "'" + anchor + "' box " + std::to_string(w) + "x" + std::to_string(h) + " in " + std::to_string(cw) + "x" + std::to_string(ch) +
+           " offset " + std::to_string(rx) + "," + std::to_string(ry);
+}
+
+void MirrorCornerMatchesGetRelativeCoords() {
+    for (const std::string& anchor : AnchorStrings()) {
+        const AnchorCorner corner = ParseMirrorCorner(anchor);
+        int mismatches = 0;
+        ForEachLayout([&](int w, int h, int cw, int ch, int rx, int ry) {
+            int legacyX = 0, legacyY = 0;
+            LegacyGetRelativeCoords(anchor, rx, ry, w, h, cw, ch, legacyX, legacyY);
+            const AnchorPoint pos = SolveMirrorAnchor(corner, rx, ry, w, h, cw, ch);
+            if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                Check(false, "mirror layout differs for " + Describe(anchor, w, h, cw, ch, rx, ry));
+            }
+        });
+    }
+}
+
+void CaptureZoneMatchesMirrorThread() {
+    for (const std::string& anchor : AnchorStrings()) {
+        const std::string normalized = LegacyNormalizeCaptureAnchor(anchor);
+        const AnchorCorner corner = ParseMirrorCorner(anchor);
+        int mismatches = 0;
+        ForEachLayout([&](int w, int h, int cw, int ch, int rx, int ry) {
+            int legacyX = 0, legacyY = 0;
+            LegacyMtGetRelativeCoordsNormalized(normalized, rx, ry, w, h, cw, ch, legacyX, legacyY);
+            const AnchorPoint pos = SolveMirrorAnchor(corner, rx, ry, w, h, cw, ch);
+            if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                Check(false, "capture zone differs for " + Describe(anchor, w, h, cw, ch, rx, ry));
+            }
+        });
+    }
+}
+
+void ImageCornerMatchesGetRelativeCoordsForImage() {
+    for (const std::string& anchor : AnchorStrings()) {
+        const AnchorCorner corner = ClassifyImageCorner(anchor);
+        int mismatches = 0;
+        ForEachLayout([&](int w, int h, int cw, int ch, int rx, int ry) {
+            int legacyX = 0, legacyY = 0;
+            LegacyGetRelativeCoordsForImage(anchor, rx, ry, w, h, cw, ch, legacyX, legacyY);
+            const AnchorPoint pos = SolveImageAnchor(corner, rx, ry, w, h, cw, ch);
+            if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                Check(false, "image layout differs for " + Describe(anchor, w, h, cw, ch, rx, ry));
+            }
+        });
+    }
+}
+
+void ImageViewportMatchesLegacy() {
+    const AnchorFrame viewports[] = { { 0, 0, 1920, 1080 }, { 640, 0, 640, 1080 }, { -20, 300, 2000, 16 }, { 5, 5, 0, 0 } };
+    for (const std::string& anchor : AnchorStrings()) {
+        const Anchor parsed = ParseImageAnchor(anchor);
+        for (const AnchorFrame& viewport : viewports) {
+            int mismatches = 0;
+            ForEachLayout([&](int w, int h, int fullW, int fullH, int rx, int ry) {
+                int legacyX = 0, legacyY = 0;
+                LegacyGetRelativeCoordsForImageWithViewport(anchor, rx, ry, w, h, viewport.x, viewport.y, viewport.w, viewport.h, fullW,
+                                                            fullH, legacyX, legacyY);
+                const AnchorPoint pos = SolveImageAnchorOnScreen(parsed, rx, ry, w, h, AnchorFrame{ 0, 0, fullW, fullH }, viewport);
+                if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                    Check(false, "image viewport layout differs for " + Describe(anchor, w, h, fullW, fullH, rx, ry));
+                }
+            });
+        }
+        Check((parsed.space == AnchorSpace::Viewport) == (anchor.length() > 8 && anchor.substr(anchor.length() - 8) == "Viewport"),
+              "image anchor space for '" + anchor + "'");
+    }
+}
+
+void MirrorOutputMatchesFinalScreenPos() {
+    const AnchorFrame viewports[] = { { 0, 0, 1920, 1080 }, { 640, 0, 640, 1080 }, { -20, 300, 2000, 16 }, { 5, 5, 0, 0 } };
+    for (const std::string& anchor : AnchorStrings()) {
+        const Anchor parsed = ParseMirrorAnchor(anchor);
+
+        std::string splitAnchor;
+        bool splitIsScreen = false;
+        LegacySplitRelativeAnchor(anchor, splitAnchor, splitIsScreen);
+        Check((parsed.space == AnchorSpace::Screen) == splitIsScreen, "mirror anchor space for '" + anchor + "'");
+        Check(parsed.corner == ParseMirrorCorner(splitAnchor), "mirror anchor corner for '" + anchor + "'");
+
+        for (const AnchorFrame& viewport : viewports) {
+            int mismatches = 0;
+            ForEachLayout([&](int w, int h, int fullW, int fullH, int rx, int ry) {
+                int legacyX = 0, legacyY = 0;
+                LegacyCalculateFinalScreenPos(anchor, rx, ry, w, h, viewport.x, viewport.y, viewport.w, viewport.h, fullW, fullH, legacyX,
+                                              legacyY);
+                const AnchorPoint pos = SolveMirrorAnchorOnScreen(parsed, rx, ry, w, h, AnchorFrame{ 0, 0, fullW, fullH }, viewport);
+                if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                    Check(false, "mirror output differs for " + Describe(anchor, w, h, fullW, fullH, rx, ry));
+                }
+            });
+        }
+    }
+}
+
+void MirrorGroupAnchorMatchesLegacy() {
+    const AnchorFrame viewport{ 640, 12, 640, 1056 };
+    for (const std::string& anchor : AnchorStrings()) {
+        const Anchor parsed{ ParseMirrorCorner(anchor), IsScreenAnchorText(anchor) ? AnchorSpace::Screen : AnchorSpace::Viewport };
+        int mismatches = 0;
+        ForEachLayout([&](int, int, int fullW, int fullH, int rx, int ry) {
+            int legacyX = 0, legacyY = 0;
+            LegacyMirrorGroupAnchor(anchor, rx, ry, viewport.x, viewport.y, viewport.w, viewport.h, fullW, fullH, legacyX, legacyY);
+            const AnchorPoint pos = SolveMirrorAnchorOnScreen(parsed, rx, ry, 0, 0, AnchorFrame{ 0, 0, fullW, fullH }, viewport);
+            if ((pos.x != legacyX || pos.y != legacyY) && mismatches++ == 0) {
+                Check(false, "mirror group anchor differs for " + Describe(anchor, 0, 0, fullW, fullH, rx, ry));
+            }
+        });
+    }
+}
+
+void GuiAnchorNamesParseExactly() {
+    static_assert(ParseMirrorAnchor("topRightViewport") == Anchor{ AnchorCorner::TopRight, AnchorSpace::Viewport });
+    static_assert(ParseMirrorAnchor("pieLeftScreen") == Anchor{ AnchorCorner::PieLeft, AnchorSpace::Screen });
+    static_assert(ParseImageAnchor("bottomRightViewport") == Anchor{ AnchorCorner::BottomRight, AnchorSpace::Viewport });
+    static_assert(ParseImageAnchor("centerScreen") == Anchor{ AnchorCorner::Center, AnchorSpace::Screen });
+
+    struct Expected {
+        const char* base;
+        AnchorCorner mirror;
+        AnchorCorner image;
+    };
+    const Expected expected[] = {
+        { "topLeft", AnchorCorner::TopLeft, AnchorCorner::TopLeft },
+        { "topRight", AnchorCorner::TopRight, AnchorCorner::TopRight },
+        { "center", AnchorCorner::Center, AnchorCorner::Center },
+        { "bottomLeft", AnchorCorner::BottomLeft, AnchorCorner::BottomLeft },
+        { "bottomRight", AnchorCorner::BottomRight, AnchorCorner::BottomRight },
+        { "pieLeft", AnchorCorner::PieLeft, AnchorCorner::Origin },
+        { "pieRight", AnchorCorner::PieRight, AnchorCorner::Origin },
+    };
+    for (const Expected& e : expected) {
+        const std::string base = e.base;
+        Check(ParseMirrorAnchor(base + "Screen") == Anchor{ e.mirror, AnchorSpace::Screen }, base + "Screen as mirror anchor");
+        Check(ParseMirrorAnchor(base + "Viewport") == Anchor{ e.mirror, AnchorSpace::Viewport }, base + "Viewport as mirror anchor");
+        Check(ParseMirrorAnchor(base) == Anchor{ e.mirror, AnchorSpace::Viewport }, base + " as mirror anchor");
+        Check(ParseImageAnchor(base + "Screen") == Anchor{ e.image, AnchorSpace::Screen }, base + "Screen as image anchor");
+        Check(ParseImageAnchor(base + "Viewport") == Anchor{ e.image, AnchorSpace::Viewport }, base + "Viewport as image anchor");
+        Check(ParseImageAnchor(base) == Anchor{ e.image, AnchorSpace::Screen }, base + " as image anchor");
+    }
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"mirror_corner_matches_get_relative_coords", &MirrorCornerMatchesGetRelativeCoords},
+        {"capture_zone_matches_mirror_thread", &CaptureZoneMatchesMirrorThread},
+        {"image_corner_matches_get_relative_coords_for_image", &ImageCornerMatchesGetRelativeCoordsForImage},
+        {"image_viewport_matches_legacy", &ImageViewportMatchesLegacy},
+        {"mirror_output_matches_final_screen_pos", &MirrorOutputMatchesFinalScreenPos},
+        {"mirror_group_anchor_matches_legacy", &MirrorGroupAnchorMatchesLegacy},
+        {"gui_anchor_names_parse_exactly", &GuiAnchorNamesParseExactly},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
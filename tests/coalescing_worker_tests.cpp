@@ -0,0 +1,196 @@
+#include "common/coalescing_worker.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+using namespace std::chrono_literals;
+
+// Records every value the worker handed to its handler.
+struct Recorder {
+    std::mutex mutex;
+    std::vector<int> values;
+
+    void Record(int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(value);
+    }
+
+    std::vector<int> Snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return values;
+    }
+};
+
+void BurstIsCoalescedIntoOneRun() {
+    Recorder recorder;
+    CoalescingWorker<int> worker([&recorder](int& value) { recorder.Record(value); }, 200ms);
+    for (int i = 1; i <= 50; ++i) worker.Submit(i);
+    Check(worker.WaitIdle(5000ms), "worker goes idle");
+
+    const std::vector<int> values = recorder.Snapshot();
+    Check(values.size() == 1 && values[0] == 50, "one run with the latest value");
+    const auto stats = worker.GetStats();
+    Check(stats.submitted == 50 && stats.coalesced == 49 && stats.processed == 1, "stats count the coalesced submissions");
+}
+
+void LatestValueWinsWhileRunning() {
+    Recorder recorder;
+    std::mutex gateMutex;
+    std::condition_variable gateCv;
+    bool started = false;
+    bool released = false;
+
+    CoalescingWorker<int> worker([&](int& value) {
+        {
+            std::unique_lock<std::mutex> lock(gateMutex);
+            started = true;
+            gateCv.notify_all();
+            gateCv.wait(lock, [&]() { return released; });
+        }
+        recorder.Record(value);
+    });
+
+    worker.Submit(1);
+    {
+        std::unique_lock<std::mutex> lock(gateMutex);
+        gateCv.wait(lock, [&]() { return started; });
+    }
+    // The first value is being handled; these queue behind it and collapse into one.
+    worker.Submit(2);
+    worker.Submit(3);
+    worker.Submit(4);
+    {
+        std::lock_guard<std::mutex> lock(gateMutex);
+        released = true;
+        gateCv.notify_all();
+    }
+    Check(worker.WaitIdle(5000ms), "worker goes idle");
+    Check(recorder.Snapshot() == std::vector<int>({ 1, 4 }), "running value finishes, then only the latest queued value runs");
+}
+
+void MergeCombinesPendingValues() {
+    Recorder recorder;
+    CoalescingWorker<int> worker([&recorder](int& value) { recorder.Record(value); }, 10s);
+    for (int i = 1; i <= 4; ++i) worker.Submit(i, [](int& pending, int&& incoming) { pending += incoming; });
+    Check(worker.WaitIdle(5000ms), "worker goes idle");
+    Check(recorder.Snapshot() == std::vector<int>({ 10 }), "merge folds every submission into the pending value");
+}
+
+void WaitIdleSkipsBatchWindow() {
+    Recorder recorder;
+    CoalescingWorker<int> worker([&recorder](int& value) { recorder.Record(value); }, 10s);
+    worker.Submit(7);
+    const auto start = std::chrono::steady_clock::now();
+    Check(worker.WaitIdle(5000ms), "flush completes");
+    Check(std::chrono::steady_clock::now() - start < 5s, "flush does not wait out the batch window");
+    Check(recorder.Snapshot() == std::vector<int>({ 7 }), "flushed value was handled");
+
+    // A later burst gets its batch window again.
+    worker.Submit(8);
+    std::this_thread::sleep_for(50ms);
+    Check(recorder.Snapshot().size() == 1, "next submission waits for its batch window");
+    worker.Stop();
+    Check(recorder.Snapshot() == std::vector<int>({ 7, 8 }), "stop handles the pending value");
+}
+
+void TakePendingRemovesQueuedValue() {
+    Recorder recorder;
+    CoalescingWorker<int> worker([&recorder](int& value) { recorder.Record(value); }, 10s);
+    worker.Submit(5);
+    std::optional<int> taken = worker.TakePending();
+    Check(taken.has_value() && *taken == 5, "pending value is returned");
+    Check(!worker.TakePending().has_value(), "nothing is left to take");
+    Check(worker.WaitIdle(1000ms), "worker is idle");
+    Check(recorder.Snapshot().empty(), "taken value is not handled by the worker");
+}
+
+void SubmitAfterStopRestarts() {
+    Recorder recorder;
+    CoalescingWorker<int> worker([&recorder](int& value) { recorder.Record(value); });
+    worker.Submit(1);
+    worker.Stop();
+    worker.Submit(2);
+    Check(worker.WaitIdle(5000ms), "restarted worker goes idle");
+    Check(recorder.Snapshot() == std::vector<int>({ 1, 2 }), "both values are handled across the restart");
+    worker.Stop();
+    worker.Stop();
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"burst_is_coalesced_into_one_run", &BurstIsCoalescedIntoOneRun},
+        {"latest_value_wins_while_running", &LatestValueWinsWhileRunning},
+        {"merge_combines_pending_values", &MergeCombinesPendingValues},
+        {"wait_idle_skips_batch_window", &WaitIdleSkipsBatchWindow},
+        {"take_pending_removes_queued_value", &TakePendingRemovesQueuedValue},
+        {"submit_after_stop_restarts", &SubmitAfterStopRestarts},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
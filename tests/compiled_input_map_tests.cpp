@@ -0,0 +1,399 @@
+#include "hooks/compiled_input_map.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+using namespace input_vk;
+
+constexpr uint32_t kLButton = 0x01;
+constexpr uint32_t kXButton1 = 0x05;
+constexpr uint32_t kTab = 0x09;
+constexpr uint32_t kKeyA = 0x41;
+constexpr uint32_t kKeyF = 0x46;
+constexpr uint32_t kF3 = 0x72;
+// VK_TOOLSCREEN_SCROLL_UP / VK_TOOLSCREEN_SCROLL_DOWN (gui.h), delivered as the raw key of WM_MOUSEWHEEL rebinds.
+constexpr uint32_t kScrollUp = 0x1000;
+constexpr uint32_t kScrollDown = 0x1001;
+
+const std::vector<uint32_t>& KeyPool() {
+    static const std::vector<uint32_t> pool = { 0,      kLButton, kXButton1, kTab,      kKeyA,     kKeyF,  kF3,    kShift,    kControl,
+                                                kMenu,  kLShift,  kRShift,   kLControl, kRControl, kLMenu, kRMenu, kScrollUp, kScrollDown };
+    return pool;
+}
+
+const std::vector<std::string>& StatePool() {
+    static const std::vector<std::string> pool = { "wall", "inworld,cursor_free", "inworld,cursor_grabbed", "title", "generating",
+                                                   "any,cursor_free", "any,cursor_grabbed", "unknown" };
+    return pool;
+}
+
+// The matchers the input hook used before dispatch was compiled, kept as the reference implementation.
+bool LegacyMatchesConfiguredInputKeyEvent(uint32_t incomingVk, uint32_t incomingRawVk, uint32_t configuredKey) {
+    if (configuredKey == 0) return false;
+    if (incomingVk == configuredKey) return true;
+    if (configuredKey == kControl) return incomingVk == kLControl || incomingVk == kRControl || incomingRawVk == kControl;
+    if (configuredKey == kShift) return incomingVk == kLShift || incomingVk == kRShift || incomingRawVk == kShift;
+    if (configuredKey == kMenu) return incomingVk == kLMenu || incomingVk == kRMenu || incomingRawVk == kMenu;
+    if (incomingRawVk == kControl && incomingVk == kControl && (configuredKey == kLControl || configuredKey == kRControl)) return true;
+    if (incomingRawVk == kShift && incomingVk == kShift && (configuredKey == kLShift || configuredKey == kRShift)) return true;
+    if (incomingRawVk == kMenu && incomingVk == kMenu && (configuredKey == kLMenu || configuredKey == kRMenu)) return true;
+    return false;
+}
+
+bool LegacyMatchesConfiguredGameStateCondition(const std::vector<std::string>& configuredStates, const std::string& gameState,
+                                               bool cursorVisible) {
+    if (configuredStates.empty()) return true;
+    for (const std::string& configuredState : configuredStates) {
+        if (configuredState == gameState) return true;
+        if (configuredState == "any,cursor_free" && cursorVisible) return true;
+        if (configuredState == "any,cursor_grabbed" && !cursorVisible) return true;
+    }
+    return false;
+}
+
+struct TestRebind {
+    bool enabled = true;
+    uint32_t fromKey = 0;
+    uint32_t toKey = 0;
+    RebindCursorFilter cursorFilter = RebindCursorFilter::Any;
+};
+
+template <typename Predicate>
+std::optional<size_t> LegacyFindPreferredEnabledKeyRebind(const std::vector<TestRebind>& rebinds, uint32_t vk, uint32_t rawVk,
+                                                          bool cursorVisible, Predicate predicate) {
+    std::optional<size_t> anyMatch;
+    for (size_t i = 0; i < rebinds.size(); ++i) {
+        const TestRebind& rebind = rebinds[i];
+        if (!rebind.enabled || rebind.fromKey == 0) continue;
+        const bool consumeOnly = rebind.enabled && rebind.fromKey != 0 && rebind.toKey == 0;
+        if (rebind.toKey == 0 && !consumeOnly) continue;
+        if (!LegacyMatchesConfiguredInputKeyEvent(vk, rawVk, rebind.fromKey) || !predicate(i)) continue;
+        if (rebind.cursorFilter == RebindCursorFilter::CursorFree) {
+            if (cursorVisible) return i;
+            continue;
+        }
+        if (rebind.cursorFilter == RebindCursorFilter::CursorGrabbed) {
+            if (!cursorVisible) return i;
+            continue;
+        }
+        if (!anyMatch.has_value()) anyMatch = i;
+    }
+    return anyMatch;
+}
+
+bool IsModifierKey(uint32_t key) { return GetInputKeyFamily(key) == kShift || GetInputKeyFamily(key) == kControl || GetInputKeyFamily(key) == kMenu; }
+
+// CheckHotkeyMatch's main key test for one combination of its flags and live modifier state.
+bool LegacyMainKeyPressed(uint32_t mainKey, uint32_t wParam, uint32_t rawWParam, bool skipLiveKeyStateChecks, bool hasIncomingKeyState,
+                          bool incomingIsKeyDown, unsigned modifiersDown) {
+    const bool lctrl = (modifiersDown & 1) != 0, rctrl = (modifiersDown & 2) != 0;
+    const bool lshift = (modifiersDown & 4) != 0, rshift = (modifiersDown & 8) != 0;
+    const bool lalt = (modifiersDown & 16) != 0, ralt = (modifiersDown & 32) != 0;
+    auto familyEvent = [&](uint32_t key) {
+        const uint32_t family = GetInputKeyFamily(key);
+        if (!IsModifierKey(key)) return false;
+        return GetInputKeyFamily(wParam) == family || rawWParam == family;
+    };
+    auto downNow = [&](uint32_t key) {
+        switch (key) {
+        case kControl: return lctrl || rctrl;
+        case kLControl: return lctrl;
+        case kRControl: return rctrl;
+        case kShift: return lshift || rshift;
+        case kLShift: return lshift;
+        case kRShift: return rshift;
+        case kMenu: return lalt || ralt;
+        case kLMenu: return lalt;
+        case kRMenu: return ralt;
+        default: return false;
+        }
+    };
+
+    const bool isModifierRelease = skipLiveKeyStateChecks && hasIncomingKeyState && !incomingIsKeyDown && IsModifierKey(mainKey) && familyEvent(mainKey);
+    if (isModifierRelease) {
+        const uint32_t generic = GetInputKeyFamily(mainKey);
+        const bool specific = mainKey != generic;
+        if (specific && wParam == mainKey) return true;
+        if (specific && wParam != generic) return false;
+        return !downNow(mainKey);
+    }
+    if (mainKey == wParam) return true;
+    switch (mainKey) {
+    case kControl: return wParam == kControl || wParam == kLControl || wParam == kRControl;
+    case kLControl: return wParam == kLControl || (wParam == kControl && (skipLiveKeyStateChecks || lctrl));
+    case kRControl: return wParam == kRControl || (wParam == kControl && (skipLiveKeyStateChecks || rctrl));
+    case kShift: return wParam == kShift || wParam == kLShift || wParam == kRShift;
+    case kLShift: return wParam == kLShift || (wParam == kShift && (skipLiveKeyStateChecks || lshift));
+    case kRShift: return wParam == kRShift || (wParam == kShift && (skipLiveKeyStateChecks || rshift));
+    case kMenu: return wParam == kMenu || wParam == kLMenu || wParam == kRMenu;
+    case kLMenu: return wParam == kLMenu || (wParam == kMenu && (skipLiveKeyStateChecks || lalt));
+    case kRMenu: return wParam == kRMenu || (wParam == kMenu && (skipLiveKeyStateChecks || ralt));
+    default: return false;
+    }
+}
+
+bool LegacyMainKeyCanMatch(uint32_t mainKey, uint32_t wParam, uint32_t rawWParam) {
+    for (unsigned flags = 0; flags < 8; ++flags) {
+        for (unsigned modifiers = 0; modifiers < 64; ++modifiers) {
+            if (LegacyMainKeyPressed(mainKey, wParam, rawWParam, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0, modifiers)) return true;
+        }
+    }
+    return false;
+}
+
+uint32_t RandomKey(std::mt19937& rng) {
+    const auto& pool = KeyPool();
+    return pool[std::uniform_int_distribution<size_t>(0, pool.size() - 1)(rng)];
+}
+
+std::vector<std::string> RandomStates(std::mt19937& rng) {
+    std::vector<std::string> states;
+    const size_t count = std::uniform_int_distribution<size_t>(0, 3)(rng);
+    for (size_t i = 0; i < count; ++i) {
+        states.push_back(StatePool()[std::uniform_int_distribution<size_t>(0, StatePool().size() - 2)(rng)]);
+    }
+    return states;
+}
+
+std::vector<uint32_t> Drain(InputKeyCandidates candidates) {
+    std::vector<uint32_t> indices;
+    uint32_t index = 0;
+    while (candidates.Next(index)) indices.push_back(index);
+    return indices;
+}
+
+void InputKeyEventMatchesLegacy() {
+    int mismatches = 0;
+    for (uint32_t vk : KeyPool()) {
+        for (uint32_t rawVk : KeyPool()) {
+            for (uint32_t configured : KeyPool()) {
+                if (MatchesInputKeyEvent(vk, rawVk, configured) != LegacyMatchesConfiguredInputKeyEvent(vk, rawVk, configured)) ++mismatches;
+            }
+        }
+    }
+    Check(mismatches == 0, std::to_string(mismatches) + " key event combinations differ from the legacy matcher");
+}
+
+void RebindLookupMatchesLinearScan() {
+    std::mt19937 rng(22);
+    int mismatches = 0;
+    for (int config = 0; config < 300; ++config) {
+        std::vector<TestRebind> rebinds(std::uniform_int_distribution<size_t>(0, 12)(rng));
+        CompiledInputMap compiled;
+        for (size_t i = 0; i < rebinds.size(); ++i) {
+            TestRebind& rebind = rebinds[i];
+            rebind.enabled = std::uniform_int_distribution<int>(0, 5)(rng) != 0;
+            rebind.fromKey = RandomKey(rng);
+            rebind.toKey = std::uniform_int_distribution<int>(0, 3)(rng) == 0 ? 0 : kKeyA;
+            rebind.cursorFilter = static_cast<RebindCursorFilter>(std::uniform_int_distribution<int>(0, 2)(rng));
+            if (rebind.enabled && rebind.fromKey != 0) compiled.AddRebind(i, rebind.fromKey, rebind.cursorFilter);
+        }
+        const uint32_t vetoMask = std::uniform_int_distribution<uint32_t>(0, 0xFFFF)(rng);
+        auto predicate = [&](size_t index) { return ((vetoMask >> (index % 16)) & 1u) == 0 || (config % 2) == 0; };
+        for (int event = 0; event < 40; ++event) {
+            const uint32_t vk = RandomKey(rng);
+            const uint32_t rawVk = std::uniform_int_distribution<int>(0, 1)(rng) == 0 ? vk : RandomKey(rng);
+            for (bool cursorVisible : { false, true }) {
+                if (compiled.FindPreferredRebind(vk, rawVk, cursorVisible, predicate) !=
+                    LegacyFindPreferredEnabledKeyRebind(rebinds, vk, rawVk, cursorVisible, predicate)) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    Check(mismatches == 0, std::to_string(mismatches) + " rebind lookups differ from the linear scan");
+}
+
+void HotkeyCandidatesCoverEveryMainKeyMatch() {
+    std::mt19937 rng(2022);
+    int missing = 0;
+    int unordered = 0;
+    for (int config = 0; config < 200; ++config) {
+        std::vector<std::vector<uint32_t>> mainKeys(std::uniform_int_distribution<size_t>(0, 10)(rng));
+        CompiledInputMap compiled;
+        for (auto& keys : mainKeys) {
+            const size_t index = compiled.AddHotkey({});
+            const size_t combinations = std::uniform_int_distribution<size_t>(0, 3)(rng);
+            for (size_t c = 0; c < combinations; ++c) {
+                keys.push_back(RandomKey(rng));
+                compiled.AddHotkeyTrigger(index, keys.back());
+            }
+        }
+        for (int event = 0; event < 30; ++event) {
+            const uint32_t vk = RandomKey(rng);
+            const uint32_t rawVk = std::uniform_int_distribution<int>(0, 1)(rng) == 0 ? vk : RandomKey(rng);
+            const uint32_t rebindTarget = std::uniform_int_distribution<int>(0, 1)(rng) == 0 ? 0 : RandomKey(rng);
+            const std::vector<uint32_t> candidates = Drain(compiled.HotkeyCandidates(vk, rawVk, rebindTarget));
+            if (!std::is_sorted(candidates.begin(), candidates.end()) ||
+                std::adjacent_find(candidates.begin(), candidates.end()) != candidates.end()) {
+                ++unordered;
+            }
+            for (size_t hotkey = 0; hotkey < mainKeys.size(); ++hotkey) {
+                bool canMatch = false;
+                for (uint32_t mainKey : mainKeys[hotkey]) {
+                    canMatch = canMatch || LegacyMainKeyCanMatch(mainKey, vk, rawVk) ||
+                               (rebindTarget != 0 && LegacyMainKeyCanMatch(mainKey, rebindTarget, 0));
+                }
+                if (canMatch && !std::binary_search(candidates.begin(), candidates.end(), static_cast<uint32_t>(hotkey))) ++missing;
+            }
+        }
+    }
+    Check(missing == 0, std::to_string(missing) + " hotkeys that could match were not offered as candidates");
+    Check(unordered == 0, std::to_string(unordered) + " candidate lists were not ascending and unique");
+}
+
+void CandidatesSkipUnrelatedKeys() {
+    CompiledInputMap compiled;
+    const size_t onA = compiled.AddHotkey({});
+    compiled.AddHotkeyTrigger(onA, kKeyA);
+    const size_t onShift = compiled.AddHotkey({});
+    compiled.AddHotkeyTrigger(onShift, kLShift);
+    const size_t onBoth = compiled.AddHotkey({});
+    compiled.AddHotkeyTrigger(onBoth, kKeyA);
+    compiled.AddHotkeyTrigger(onBoth, kKeyA);
+    compiled.AddHotkeyTrigger(onBoth, kShift);
+
+    Check(Drain(compiled.HotkeyCandidates(kKeyF, kKeyF, 0)).empty(), "unbound key should have no candidates");
+    Check(Drain(compiled.HotkeyCandidates(kKeyA, kKeyA, 0)) == std::vector<uint32_t>{ 0, 2 }, "A should offer hotkeys 0 and 2 once each");
+    Check(Drain(compiled.HotkeyCandidates(kRShift, kShift, 0)) == std::vector<uint32_t>{ 1, 2 }, "shift family should share a bucket");
+    Check(Drain(compiled.HotkeyCandidates(kKeyF, kKeyF, kKeyA)) == std::vector<uint32_t>{ 0, 2 }, "rebind target should be looked up");
+    Check(Drain(compiled.HotkeyCandidates(kKeyA, kKeyA, kLShift)) == std::vector<uint32_t>{ 0, 1, 2 }, "buckets should merge in order");
+}
+
+void ScrollWheelPseudoKeysMatch() {
+    CompiledInputMap compiled;
+    compiled.AddRebind(0, kScrollUp, RebindCursorFilter::Any);
+    compiled.AddRebind(1, kScrollDown, RebindCursorFilter::Any);
+    const size_t onScrollDown = compiled.AddHotkey({});
+    compiled.AddHotkeyTrigger(onScrollDown, kScrollDown);
+    const size_t onScrollUp = compiled.AddHotkey({});
+    compiled.AddHotkeyTrigger(onScrollUp, kScrollUp);
+
+    auto any = [](size_t) { return true; };
+    Check(compiled.FindPreferredRebind(kScrollUp, kScrollUp, false, any) == std::optional<size_t>(0), "scroll up should find its rebind");
+    Check(compiled.FindPreferredRebind(kScrollDown, kScrollDown, true, any) == std::optional<size_t>(1),
+          "scroll down should find its rebind, not scroll up's");
+    Check(Drain(compiled.HotkeyCandidates(kScrollUp, kScrollUp, 0)) == std::vector<uint32_t>{ 0, 1 },
+          "both wheel hotkeys share the overflow bucket");
+    Check(Drain(compiled.HotkeyCandidates(kKeyF, kKeyF, kScrollDown)) == std::vector<uint32_t>{ 0, 1 },
+          "a wheel rebind target should be looked up");
+    Check(Drain(compiled.HotkeyCandidates(kKeyA, kKeyA, 0)).empty(), "ordinary keys should not reach the overflow bucket");
+}
+
+void GameStateConditionMatchesStringCompare() {
+    std::mt19937 rng(7);
+    int mismatches = 0;
+    for (int config = 0; config < 200; ++config) {
+        CompiledInputMap compiled;
+        std::vector<std::vector<std::string>> conditions(std::uniform_int_distribution<size_t>(1, 8)(rng));
+        for (auto& states : conditions) {
+            states = RandomStates(rng);
+            compiled.AddHotkey(states);
+        }
+        for (const std::string& gameState : StatePool()) {
+            const int stateId = compiled.FindGameStateId(gameState);
+            for (bool cursorVisible : { false, true }) {
+                for (size_t i = 0; i < conditions.size(); ++i) {
+                    const CompiledGameStateCondition& condition = compiled.HotkeyCondition(i);
+                    const bool cursor = condition.UsesCursorState() && cursorVisible;
+                    if (condition.Matches(stateId, cursor) != LegacyMatchesConfiguredGameStateCondition(conditions[i], gameState, cursorVisible)) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+    }
+    Check(mismatches == 0, std::to_string(mismatches) + " game state checks differ from the string compare");
+}
+
+void InternsMoreThanSixtyFourStates() {
+    CompiledInputMap compiled;
+    std::vector<std::string> states;
+    for (int i = 0; i < 100; ++i) states.push_back("state" + std::to_string(i));
+    compiled.AddHotkey({ "state0" });
+    compiled.AddHotkey(states);
+    compiled.AddSensitivityHotkey({ "state99" });
+    Check(compiled.HotkeyCondition(1).Matches(compiled.FindGameStateId("state99"), false), "state past 64 should match");
+    Check(!compiled.HotkeyCondition(0).Matches(compiled.FindGameStateId("state99"), false), "other condition should not match it");
+    Check(compiled.SensitivityHotkeyCondition(0).Matches(compiled.FindGameStateId("state99"), false), "sensitivity hotkeys share the ids");
+    Check(!compiled.HotkeyCondition(1).Matches(compiled.FindGameStateId("wall"), true), "uninterned state should not match");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"input_key_event_matches_legacy", &InputKeyEventMatchesLegacy},
+        {"rebind_lookup_matches_linear_scan", &RebindLookupMatchesLinearScan},
+        {"hotkey_candidates_cover_every_main_key_match", &HotkeyCandidatesCoverEveryMainKeyMatch},
+        {"candidates_skip_unrelated_keys", &CandidatesSkipUnrelatedKeys},
+        {"scroll_wheel_pseudo_keys_match", &ScrollWheelPseudoKeysMatch},
+        {"game_state_condition_matches_string_compare", &GameStateConditionMatchesStringCompare},
+        {"interns_more_than_sixty_four_states", &InternsMoreThanSixtyFourStates},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
@@ -0,0 +1,281 @@
+#include "config/config_snapshot_cache.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+// Exercises every value type the TOML parser can produce, including shapes the config writer never emits.
+const char* kEdgeCaseToml = R"(
+configVersion = 4
+lang = "en"
+negative = -9223372036854775808
+large = 9223372036854775807
+hex = 0xDEADBEEF
+ratio = -0.0
+tiny = 5e-324
+infinity = inf
+unicode = "Gr\u00FC\u00DFe \u2013 \u65E5\u672C\u8A9E \u0000 end"
+empty = ""
+enabled = true
+disabled = false
+day = 2026-10-17
+clock = 07:32:00.999999999
+local = 1979-05-27T07:32:00
+offset = 1979-05-27T00:32:00.5-07:00
+utc = 1979-05-27T07:32:00Z
+mixed = [1, "two", 3.0, [4, [5]], { six = 6 }]
+emptyArray = []
+inlineTable = { a = 1, b = { c = "deep" } }
+
+[emptyTable]
+
+[appearance.customColors]
+accent = [0.1, 0.2, 0.3, 1.0]
+
+[[mode]]
+id = "Fullscreen"
+width = 0
+height = 0
+
+[[mode]]
+id = "EyeZoom"
+width = 384
+height = 16384
+mirrorIds = ["Pie", "F3"]
+
+[[mode.stretch]]
+enabled = true
+)";
+
+std::string ReadFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+bool RoundTrip(const std::string& source, toml::table& parsed, toml::table& decoded, std::string& image) {
+    parsed = toml::parse(source);
+    if (!EncodeConfigSnapshotCache(parsed, source, image)) return false;
+    std::string error;
+    const bool ok = DecodeConfigSnapshotCache(image.data(), image.size(), source, decoded, &error);
+    if (!ok) std::cerr << "  decode error: " << error << '\n';
+    return ok;
+}
+
+void EdgeCaseDocumentRoundTrips() {
+    toml::table parsed, decoded;
+    std::string image;
+    Check(RoundTrip(kEdgeCaseToml, parsed, decoded, image), "edge case document encodes and decodes");
+    Check(decoded == parsed, "decoded table equals the parsed table");
+
+    Check(decoded["negative"].value<std::int64_t>() == std::numeric_limits<std::int64_t>::min(), "int64 min survives");
+    Check(decoded["large"].value<std::int64_t>() == std::numeric_limits<std::int64_t>::max(), "int64 max survives");
+    Check(std::signbit(decoded["ratio"].value_or(1.0)), "negative zero keeps its sign");
+    Check(decoded["unicode"].value_or(std::string()) == parsed["unicode"].value_or(std::string("x")), "embedded NUL and UTF-8 survive");
+    Check(decoded["offset"].as_date_time() && decoded["offset"].as_date_time()->get().offset.has_value() &&
+              decoded["offset"].as_date_time()->get().offset->minutes == -420,
+          "date-time offset survives");
+    Check(decoded["local"].as_date_time() && !decoded["local"].as_date_time()->get().offset.has_value(), "local date-time stays local");
+    Check(decoded["mixed"][3][1][0].value<std::int64_t>() == 5, "nested arrays survive");
+}
+
+void NanRoundTrips() {
+    const std::string source = "value = nan\nnegative = -nan\n";
+    toml::table parsed, decoded;
+    std::string image;
+    Check(RoundTrip(source, parsed, decoded, image), "nan document encodes and decodes");
+    Check(std::isnan(decoded["value"].value_or(0.0)), "nan decodes as nan");
+    Check(std::isnan(decoded["negative"].value_or(0.0)), "negative nan decodes as nan");
+}
+
+void DefaultConfigRoundTrips() {
+    const std::string source = ReadFile(TOOLSCREEN_DEFAULT_TOML_PATH);
+    Check(!source.empty(), "default.toml is readable");
+    toml::table parsed, decoded;
+    std::string image;
+    Check(RoundTrip(source, parsed, decoded, image), "default.toml encodes and decodes");
+    Check(decoded == parsed, "default.toml decodes to the parsed table");
+
+    // Re-encoding the decoded table must be byte-identical, so the format has a single canonical form.
+    std::string again;
+    Check(EncodeConfigSnapshotCache(decoded, source, again) && again == image, "re-encoding is stable");
+}
+
+void ChangedSourceIsRejected() {
+    const std::string source = kEdgeCaseToml;
+    toml::table parsed, decoded;
+    std::string image;
+    Check(RoundTrip(source, parsed, decoded, image), "baseline round trip");
+
+    std::string edited = source;
+    edited[edited.find("384")] = '5';
+    std::string error;
+    Check(!DecodeConfigSnapshotCache(image.data(), image.size(), edited, decoded, &error), "same-size edit is rejected");
+    Check(decoded.empty(), "rejected decode leaves the table empty");
+    Check(!error.empty(), "rejection reports a reason");
+    Check(!DecodeConfigSnapshotCache(image.data(), image.size(), source + "\n", decoded), "appended text is rejected");
+    Check(!DecodeConfigSnapshotCache(image.data(), image.size(), std::string_view(), decoded), "empty source is rejected");
+}
+
+void DamagedImagesAreRejected() {
+    const std::string source = kEdgeCaseToml;
+    toml::table parsed, decoded;
+    std::string image;
+    Check(RoundTrip(source, parsed, decoded, image), "baseline round trip");
+
+    for (size_t length = 0; length < image.size(); ++length) {
+        if (DecodeConfigSnapshotCache(image.data(), length, source, decoded)) {
+            Check(false, "truncated image of " + std::to_string(length) + " bytes was accepted");
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < image.size(); ++i) {
+        std::string damaged = image;
+        damaged[i] = static_cast<char>(damaged[i] ^ 0x5A);
+        if (DecodeConfigSnapshotCache(damaged.data(), damaged.size(), source, decoded)) {
+            Check(false, "image with byte " + std::to_string(i) + " flipped was accepted");
+            break;
+        }
+    }
+
+    std::string wrongVersion = image;
+    wrongVersion[4] = static_cast<char>(kConfigSnapshotCacheVersion + 1);
+    Check(!DecodeConfigSnapshotCache(wrongVersion.data(), wrongVersion.size(), source, decoded), "other format version is rejected");
+
+    std::string trailing = image + "x";
+    Check(!DecodeConfigSnapshotCache(trailing.data(), trailing.size(), source, decoded), "trailing bytes are rejected");
+}
+
+void DeepNestingIsBounded() {
+    // Valid TOML nested past the decoder's depth limit: encoding works, decoding refuses instead of recursing without bound.
+    std::string source = "deep = ";
+    for (int i = 0; i < 200; ++i) source += "[";
+    for (int i = 0; i < 200; ++i) source += "]";
+    source += "\n";
+    toml::table parsed = toml::parse(source);
+    std::string image;
+    Check(EncodeConfigSnapshotCache(parsed, source, image), "deep document encodes");
+    toml::table decoded;
+    Check(!DecodeConfigSnapshotCache(image.data(), image.size(), source, decoded), "over-deep document is rejected");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"edge_case_document_round_trips", &EdgeCaseDocumentRoundTrips},
+        {"nan_round_trips", &NanRoundTrips},
+        {"default_config_round_trips", &DefaultConfigRoundTrips},
+        {"changed_source_is_rejected", &ChangedSourceIsRejected},
+        {"damaged_images_are_rejected", &DamagedImagesAreRejected},
+        {"deep_nesting_is_bounded", &DeepNestingIsBounded},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+template <typename Fn>
+double MeasureMicroseconds(int iterations, Fn&& fn) {
+    fn();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int RunBenchmark() {
+    std::string source = ReadFile(TOOLSCREEN_DEFAULT_TOML_PATH);
+    // A heavier config resembling a user's with many modes, mirrors and rebinds.
+    std::string large = source;
+    for (int i = 0; i < 40; ++i) {
+        large += "\n[[mode]]\nid = \"Bench " + std::to_string(i) +
+                 "\"\nwidth = 320\nheight = 900\nmirrorIds = [\"a\", \"b\", \"c\"]\nimageIds = []\n[mode.border]\nenabled = true\n"
+                 "color = [0.1, 0.2, 0.3]\nwidth = 4\n";
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const std::string* doc : { &source, &large }) {
+        const toml::table parsed = toml::parse(*doc);
+        std::string image;
+        EncodeConfigSnapshotCache(parsed, *doc, image);
+        const double parseUs = MeasureMicroseconds(200, [&]() {
+            toml::table tbl = toml::parse(*doc);
+            (void)tbl;
+        });
+        const double decodeUs = MeasureMicroseconds(200, [&]() {
+            toml::table tbl;
+            DecodeConfigSnapshotCache(image.data(), image.size(), *doc, tbl);
+        });
+        std::cout << doc->size() << " byte TOML, " << image.size() << " byte cache: parse " << parseUs << " us, cache decode " << decodeUs
+                  << " us (" << parseUs / decodeUs << "x)\n";
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
@@ -0,0 +1,316 @@
+#include "common/decode_worker_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+using namespace std::chrono_literals;
+
+// Holds a pool thread inside a request until released.
+struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool entered = false;
+    bool released = false;
+
+    void Enter() {
+        std::unique_lock<std::mutex> lock(mutex);
+        entered = true;
+        cv.notify_all();
+        cv.wait(lock, [this]() { return released; });
+    }
+
+    void WaitEntered() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return entered; });
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        cv.notify_all();
+    }
+};
+
+// Records the order requests ran in.
+struct Recorder {
+    std::mutex mutex;
+    std::vector<std::string> order;
+
+    void Record(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(name);
+    }
+
+    std::vector<std::string> Snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order;
+    }
+};
+
+DecodeRequest MakeRequest(const std::string& key, int priority, std::function<void(const DecodeCancelToken&)> work,
+                          size_t estimatedBytes = 0, const std::string& format = "png") {
+    DecodeRequest request;
+    request.key = key;
+    request.priority = priority;
+    request.estimatedBytes = estimatedBytes;
+    request.format = format;
+    request.work = std::move(work);
+    return request;
+}
+
+// Occupies the only worker of a single-thread pool so later submissions queue up behind it.
+void BlockSingleWorker(DecodeWorkerPool& pool, Gate& gate) {
+    pool.Submit(MakeRequest("blocker", 0, [&gate](const DecodeCancelToken&) { gate.Enter(); }));
+    gate.WaitEntered();
+}
+
+void RunsHighestPriorityFirst() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 1 });
+    Gate gate;
+    Recorder recorder;
+    BlockSingleWorker(pool, gate);
+
+    pool.Submit(MakeRequest("low", 0, [&](const DecodeCancelToken&) { recorder.Record("low"); }));
+    pool.Submit(MakeRequest("high", 10, [&](const DecodeCancelToken&) { recorder.Record("high"); }));
+    pool.Submit(MakeRequest("mid", 5, [&](const DecodeCancelToken&) { recorder.Record("mid"); }));
+    pool.Submit(MakeRequest("high2", 10, [&](const DecodeCancelToken&) { recorder.Record("high2"); }));
+    gate.Release();
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(recorder.Snapshot() == std::vector<std::string>({ "high", "high2", "mid", "low" }),
+          "priority order, submission order within a priority");
+}
+
+void SupersedesQueuedRequestForSameKey() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 1 });
+    Gate gate;
+    Recorder recorder;
+    BlockSingleWorker(pool, gate);
+
+    pool.Submit(MakeRequest("image", 0, [&](const DecodeCancelToken&) { recorder.Record("v1"); }));
+    pool.Submit(MakeRequest("image", 0, [&](const DecodeCancelToken&) { recorder.Record("v2"); }));
+    gate.Release();
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(recorder.Snapshot() == std::vector<std::string>({ "v2" }), "only the newest request for a key runs");
+    Check(pool.GetStats().superseded == 1, "superseded request is counted");
+}
+
+void CancelsRunningRequestForSameKey() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 2 });
+    Gate gate;
+    std::atomic<bool> oldSawCancel{ false };
+    std::atomic<bool> newRan{ false };
+
+    pool.Submit(MakeRequest("image", 0, [&](const DecodeCancelToken& token) {
+        gate.Enter();
+        oldSawCancel = token.IsCancelled();
+    }));
+    gate.WaitEntered();
+    pool.Submit(MakeRequest("image", 0, [&](const DecodeCancelToken& token) { newRan = !token.IsCancelled(); }));
+    gate.Release();
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(oldSawCancel, "the running request sees it was superseded");
+    Check(newRan, "the newer request runs uncancelled");
+    Check(pool.GetStats().cancelledWhileRunning == 1, "cancellation is counted");
+}
+
+void MemoryBudgetLimitsInFlightDecodes() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 4, 100 });
+    std::atomic<int> concurrent{ 0 };
+    std::atomic<int> maxConcurrent{ 0 };
+    auto work = [&](const DecodeCancelToken&) {
+        const int now = ++concurrent;
+        int seen = maxConcurrent.load();
+        while (now > seen && !maxConcurrent.compare_exchange_weak(seen, now)) {}
+        std::this_thread::sleep_for(20ms);
+        --concurrent;
+    };
+
+    for (int i = 0; i < 4; ++i) pool.Submit(MakeRequest("big" + std::to_string(i), 0, work, 60));
+    // Larger than the whole budget: still runs, alone.
+    pool.Submit(MakeRequest("huge", 0, work, 500));
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(maxConcurrent.load() == 1, "requests that do not fit together run one at a time");
+    const DecodeWorkerPoolStats stats = pool.GetStats();
+    Check(stats.peakInFlightBytes == 500, "peak in-flight bytes is the oversized request alone");
+    Check(stats.inFlightBytes == 0, "budget is released after each request");
+}
+
+void SmallRequestsShareTheBudget() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 2, 100 });
+    Gate first;
+    Gate second;
+    pool.Submit(MakeRequest("a", 0, [&first](const DecodeCancelToken&) { first.Enter(); }, 40));
+    pool.Submit(MakeRequest("b", 0, [&second](const DecodeCancelToken&) { second.Enter(); }, 40));
+    first.WaitEntered();
+    second.WaitEntered();
+    Check(pool.GetStats().inFlightBytes == 80, "both requests run within the budget");
+    first.Release();
+    second.Release();
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+}
+
+void CountsEachBudgetWaitOnce() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 2, 100 });
+    Gate gate;
+    pool.Submit(MakeRequest("a", 0, [&gate](const DecodeCancelToken&) { gate.Enter(); }, 60));
+    gate.WaitEntered();
+    pool.Submit(MakeRequest("b", 0, [](const DecodeCancelToken&) {}, 60));
+    for (int i = 0; i < 500 && pool.GetStats().budgetWaits == 0; ++i) std::this_thread::sleep_for(1ms);
+
+    // Each submission wakes the idle worker, which finds "b" still blocked on the budget.
+    pool.Submit(MakeRequest("c", -1, [](const DecodeCancelToken&) {}, 10));
+    pool.Submit(MakeRequest("d", -1, [](const DecodeCancelToken&) {}, 10));
+    std::this_thread::sleep_for(20ms);
+    gate.Release();
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(pool.GetStats().budgetWaits == 1, "a request blocked on the budget is counted once");
+}
+
+void EstimatesOnPoolThread() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 1 });
+    const std::thread::id submitter = std::this_thread::get_id();
+    std::atomic<bool> estimatedOnSubmitter{ true };
+    std::atomic<bool> estimatedBeforeWork{ false };
+    std::atomic<bool> estimated{ false };
+
+    DecodeRequest request = MakeRequest("image", 0, [&](const DecodeCancelToken&) { estimatedBeforeWork = estimated.load(); }, 1);
+    request.estimateBytes = [&]() {
+        estimatedOnSubmitter = std::this_thread::get_id() == submitter;
+        estimated = true;
+        return static_cast<size_t>(42);
+    };
+    pool.Submit(std::move(request));
+
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+    Check(!estimatedOnSubmitter, "the estimate runs on a pool thread");
+    Check(estimatedBeforeWork, "the estimate runs before the work");
+    Check(pool.GetStats().peakInFlightBytes == 42, "the computed estimate is reserved");
+}
+
+void RecordsPerFormatMetrics() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 2 });
+    auto work = [](const DecodeCancelToken&) { std::this_thread::sleep_for(5ms); };
+    pool.Submit(MakeRequest("a", 0, work, 0, "png"));
+    pool.Submit(MakeRequest("b", 0, work, 0, "png"));
+    pool.Submit(MakeRequest("c", 0, work, 0, "gif"));
+    Check(pool.WaitIdle(5000ms), "pool goes idle");
+
+    const DecodeWorkerPoolStats stats = pool.GetStats();
+    Check(stats.submitted == 3, "submissions are counted");
+    Check(stats.formats.count("png") && stats.formats.at("png").decoded == 2, "png decodes are counted");
+    Check(stats.formats.count("gif") && stats.formats.at("gif").decoded == 1, "gif decodes are counted");
+    Check(stats.formats.at("png").maxDecodeMs >= 4.0, "decode time is measured");
+    Check(stats.formats.at("png").totalDecodeMs >= stats.formats.at("png").maxDecodeMs, "total covers the max");
+}
+
+void StopDropsQueuedRequests() {
+    DecodeWorkerPool pool(DecodeWorkerPoolOptions{ 1 });
+    Gate gate;
+    std::atomic<bool> queuedRan{ false };
+    std::atomic<bool> blockerCancelled{ false };
+    pool.Submit(MakeRequest("blocker", 0, [&](const DecodeCancelToken& token) {
+        gate.Enter();
+        blockerCancelled = token.IsCancelled();
+    }));
+    gate.WaitEntered();
+    pool.Submit(MakeRequest("queued", 0, [&](const DecodeCancelToken&) { queuedRan = true; }));
+
+    std::thread releaser([&gate]() {
+        std::this_thread::sleep_for(50ms);
+        gate.Release();
+    });
+    pool.Stop();
+    releaser.join();
+
+    Check(!queuedRan, "queued request is dropped");
+    Check(blockerCancelled, "running request is cancelled");
+    pool.Submit(MakeRequest("late", 0, [&](const DecodeCancelToken&) { queuedRan = true; }));
+    Check(pool.WaitIdle(1000ms) && !queuedRan, "submissions after stop are ignored");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"runs_highest_priority_first", &RunsHighestPriorityFirst},
+        {"supersedes_queued_request_for_same_key", &SupersedesQueuedRequestForSameKey},
+        {"cancels_running_request_for_same_key", &CancelsRunningRequestForSameKey},
+        {"memory_budget_limits_in_flight_decodes", &MemoryBudgetLimitsInFlightDecodes},
+        {"small_requests_share_the_budget", &SmallRequestsShareTheBudget},
+        {"counts_each_budget_wait_once", &CountsEachBudgetWaitOnce},
+        {"estimates_on_pool_thread", &EstimatesOnPoolThread},
+        {"records_per_format_metrics", &RecordsPerFormatMetrics},
+        {"stop_drops_queued_requests", &StopDropsQueuedRequests},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
@@ -0,0 +1,294 @@
+#include "common/expression_parser.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+void CheckEqual(int actual, int expected, const std::string& message) {
+    Check(actual == expected, message + " (expected " + std::to_string(expected) + ", got " + std::to_string(actual) + ")");
+}
+
+void CompiledMatchesKnownValues() {
+    struct Case {
+        const char* expr;
+        int expected;
+    };
+    const Case cases[] = {
+        { "screenWidth", 1920 },
+        { "screenHeight / 2", 540 },
+        { "  screenWidth - 2 * 10 ", 1900 },
+        { "-(screenWidth + screenHeight) / -3", 1000 },
+        { "min(screenWidth, 1000) + max(1, 2)", 1002 },
+        { "floor(7.9) + ceil(0.1) + round(2.5) + abs(-4)", 15 },
+        { "roundEven(screenHeight / 7)", 156 },
+        { "1.5 * 3", 4 },
+        { "+-+5", -5 },
+        { ".5 + .5", 1 },
+    };
+    for (const Case& testCase : cases) {
+        CompiledExpression compiled(testCase.expr);
+        Check(compiled.IsValid(), std::string("compiles: ") + testCase.expr);
+        CheckEqual(compiled.Evaluate(1920, 1080, -1), testCase.expected, testCase.expr);
+        CheckEqual(EvaluateExpression(testCase.expr, 1920, 1080, -1), testCase.expected, std::string("legacy ") + testCase.expr);
+    }
+}
+
+void InvalidExpressionsReturnDefault() {
+    const char* invalid[] = { "", "   ", "screenDepth", "foo(1)", "min(1)", "abs(1, 2)", "(1 + 2", "1 +", "1 2", "1.2.3", ".", "3 $ 4",
+                              "screenWidth(1)", "min(1,)", "()" };
+    for (const char* expr : invalid) {
+        std::string error;
+        CompiledExpression compiled;
+        Check(!compiled.Compile(expr, &error), std::string("rejects: ") + expr);
+        Check(!error.empty(), std::string("reports an error for: ") + expr);
+        CheckEqual(compiled.Evaluate(1920, 1080, 77), 77, std::string("default for ") + expr);
+        CheckEqual(EvaluateExpression(expr, 1920, 1080, 77), 77, std::string("legacy default for ") + expr);
+    }
+
+    std::string error;
+    CompiledExpression compiled;
+    compiled.Compile("min(1)", &error);
+    Check(error == "min() requires 2 arguments", "argument count error matches the legacy message: " + error);
+}
+
+void DivisionByZeroDependsOnScreenSize() {
+    CompiledExpression compiled("100 / (screenWidth - 1920)");
+    Check(compiled.IsValid(), "compiles");
+    CheckEqual(compiled.Evaluate(1920, 1080, 5), 5, "division by zero returns the default");
+    CheckEqual(compiled.Evaluate(1920, 1080, 6), 6, "memoized failure still uses the caller's default");
+    CheckEqual(compiled.Evaluate(1970, 1080, 5), 2, "other sizes evaluate normally");
+    CheckEqual(compiled.Evaluate(1920, 1080, 7), 7, "failure after a size change");
+}
+
+void MemoizedResultsTrackScreenSize() {
+    CompiledExpression compiled("screenWidth / 3 + screenHeight");
+    for (int round = 0; round < 3; round++) {
+        CheckEqual(compiled.Evaluate(1920, 1080, 0), 1720, "1920x1080");
+        CheckEqual(compiled.Evaluate(2560, 1440, 0), 2293, "2560x1440");
+        CheckEqual(compiled.Evaluate(100000, 5, 0), 33338, "sizes that skip the memo");
+    }
+
+    compiled.Compile("screenHeight");
+    CheckEqual(compiled.Evaluate(2560, 1440, 0), 1440, "recompiling clears the memo");
+}
+
+void CachedEvaluationSharesCompiledCode() {
+    const std::string expr = "screenWidth - 10";
+    Check(GetCompiledExpression(expr) == GetCompiledExpression(expr), "cache returns the same compiled expression");
+    CheckEqual(EvaluateExpressionCached(expr, 800, 600, 0), 790, "cached evaluation");
+    CheckEqual(EvaluateExpressionCached("bogus", 800, 600, 42), 42, "cached invalid expression returns the default");
+
+    for (int i = 0; i < 1000; i++) EvaluateExpressionCached(std::to_string(i) + " + screenWidth", 800, 600, 0);
+    CheckEqual(EvaluateExpressionCached("999 + screenWidth", 800, 600, 0), 1799, "cache stays correct after eviction");
+}
+
+void DeepNestingUsesOverflowStack() {
+    std::string expr;
+    for (int i = 0; i < 100; i++) expr += "(1 + ";
+    expr += "screenWidth";
+    for (int i = 0; i < 100; i++) expr += ")";
+    CompiledExpression compiled(expr);
+    CheckEqual(compiled.Evaluate(1000, 1000, 0), 1100, "deeply nested expression");
+
+    std::string wide = "0";
+    for (int i = 0; i < 60; i++) wide = "min(" + std::to_string(i) + ", " + wide + ")";
+    CompiledExpression wideCompiled(wide);
+    CheckEqual(wideCompiled.Evaluate(1000, 1000, -1), EvaluateExpression(wide, 1000, 1000, -1), "wide stack matches legacy");
+}
+
+// Random expressions over the full grammar, including malformed ones. Both evaluators must
+// agree on every screen size whenever the legacy result fits an int.
+class ExpressionFuzzer {
+public:
+    explicit ExpressionFuzzer(uint32_t seed) : m_rng(seed) {}
+
+    std::string Generate() {
+        std::string expr = Expression(0);
+        if (Roll(20)) Corrupt(expr);
+        return expr;
+    }
+
+private:
+    bool Roll(int percent) { return static_cast<int>(m_rng() % 100) < percent; }
+
+    std::string Number() {
+        std::string text = std::to_string(m_rng() % 200);
+        if (Roll(30)) text += "." + std::to_string(m_rng() % 100);
+        if (Roll(3)) text = "." + std::to_string(m_rng() % 10);
+        return text;
+    }
+
+    std::string Expression(int depth) {
+        if (depth > 4 || Roll(25)) {
+            switch (m_rng() % 4) {
+            case 0: return "screenWidth";
+            case 1: return "screenHeight";
+            default: return Number();
+            }
+        }
+        static const char* kBinary[] = { " + ", " - ", " * ", " / ", "-", "*" };
+        static const char* kUnaryFunctions[] = { "floor", "ceil", "round", "abs", "roundEven" };
+        switch (m_rng() % 6) {
+        case 0:
+        case 1: return Expression(depth + 1) + kBinary[m_rng() % 6] + Expression(depth + 1);
+        case 2: return "(" + Expression(depth + 1) + ")";
+        case 3: return (Roll(50) ? "-" : "+") + Expression(depth + 1);
+        case 4: return std::string(kUnaryFunctions[m_rng() % 5]) + "(" + Expression(depth + 1) + ")";
+        default: return std::string(Roll(50) ? "min" : "max") + "(" + Expression(depth + 1) + ", " + Expression(depth + 1) + ")";
+        }
+    }
+
+    void Corrupt(std::string& expr) {
+        static const char kNoise[] = "()+-*/,.x 9_$";
+        const size_t pos = expr.empty() ? 0 : m_rng() % expr.size();
+        switch (m_rng() % 3) {
+        case 0: expr.insert(pos, 1, kNoise[m_rng() % (sizeof(kNoise) - 1)]); break;
+        case 1:
+            if (!expr.empty()) expr.erase(pos, 1);
+            break;
+        default: expr = expr.substr(0, pos); break;
+        }
+    }
+
+    std::mt19937 m_rng;
+};
+
+void FuzzMatchesLegacyEvaluator() {
+    const int sizes[][2] = { { 1920, 1080 }, { 2560, 1440 }, { 1, 1 }, { 0, 0 }, { 3840, 2160 }, { 1366, 768 } };
+    ExpressionFuzzer fuzzer(0x5EED1234u);
+    int compared = 0;
+    int mismatches = 0;
+    for (int i = 0; i < 20000 && mismatches < 10; i++) {
+        const std::string expr = fuzzer.Generate();
+        CompiledExpression compiled(expr);
+        for (const auto& size : sizes) {
+            double raw = 0.0;
+            if (compiled.TryEvaluate(size[0], size[1], raw)) {
+                const double floored = std::floor(raw);
+                if (!(floored >= std::numeric_limits<int>::min() && floored <= std::numeric_limits<int>::max())) continue;
+            }
+            const int legacy = EvaluateExpression(expr, size[0], size[1], -12345);
+            const int fast = compiled.Evaluate(size[0], size[1], -12345);
+            const int memoized = compiled.Evaluate(size[0], size[1], -12345);
+            compared++;
+            if (legacy != fast || fast != memoized) {
+                mismatches++;
+                Check(false, "mismatch for '" + expr + "' at " + std::to_string(size[0]) + "x" + std::to_string(size[1]) + ": legacy " +
+                                 std::to_string(legacy) + ", compiled " + std::to_string(fast) + ", memoized " + std::to_string(memoized));
+            }
+        }
+    }
+    Check(compared > 50000, "fuzzer compared enough cases: " + std::to_string(compared));
+}
+
+int RunBenchmark() {
+    const std::vector<std::string> expressions = { "screenWidth", "roundEven(screenHeight * 0.3)", "min(screenWidth, screenHeight * 16 / 9) - 2 * 40",
+                                                   "max(330, floor((screenWidth - 60) / 3))" };
+    constexpr int kIterations = 200000;
+    volatile int sink = 0;
+
+    for (const std::string& expr : expressions) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; i++) sink = sink + EvaluateExpression(expr, 1920 + (i & 1), 1080, 0);
+        const double legacyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        CompiledExpression compiled(expr);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; i++) sink = sink + compiled.Evaluate(1920 + (i & 1), 1080, 0);
+        const double compiledNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; i++) sink = sink + compiled.Evaluate(1920, 1080, 0);
+        const double memoNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; i++) sink = sink + EvaluateExpressionCached(expr, 1920, 1080, 0);
+        const double cachedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        std::cout << expr << "\n  legacy " << legacyNs << " ns, compiled " << compiledNs << " ns, memoized " << memoNs << " ns, cached lookup "
+                  << cachedNs << " ns\n";
+    }
+    return sink == 42 ? 1 : 0;
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"compiled_matches_known_values", &CompiledMatchesKnownValues},
+        {"invalid_expressions_return_default", &InvalidExpressionsReturnDefault},
+        {"division_by_zero_depends_on_screen_size", &DivisionByZeroDependsOnScreenSize},
+        {"memoized_results_track_screen_size", &MemoizedResultsTrackScreenSize},
+        {"cached_evaluation_shares_compiled_code", &CachedEvaluationSharesCompiledCode},
+        {"deep_nesting_uses_overflow_stack", &DeepNestingUsesOverflowStack},
+        {"fuzz_matches_legacy_evaluator", &FuzzMatchesLegacyEvaluator},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
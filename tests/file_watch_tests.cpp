@@ -0,0 +1,287 @@
+#include "common/directory_watcher.h"
+#include "common/file_watch_registry.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+using namespace std::chrono_literals;
+using file_watch::FileChange;
+using file_watch::FileWatchRegistry;
+
+// Fresh directory under the system temp dir, removed on destruction.
+struct ScopedTempDir {
+    std::filesystem::path path;
+
+    explicit ScopedTempDir(const std::string& name) {
+        path = std::filesystem::temp_directory_path() /
+               ("toolscreen_" + name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(path);
+    }
+
+    ~ScopedTempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+};
+
+// Writes contents and stamps the file with a distinct write time, so changes are visible regardless of the file
+// system's timestamp granularity.
+void WriteFileStamped(const std::filesystem::path& path, const std::string& contents, int stamp) {
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1) + std::chrono::seconds(stamp));
+}
+
+void WatcherReportsFileWrite() {
+    ScopedTempDir dir("watcher_write");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "a", 0);
+    auto watcher = file_watch::CreateNotifyingDirectoryWatcher({ file });
+    Check(watcher != nullptr, "notifying watcher created for an existing directory");
+    if (!watcher) { return; }
+    Check(watcher->IsEventDriven(), "notifying watcher is event driven");
+
+    std::thread writer([&file]() {
+        std::this_thread::sleep_for(50ms);
+        WriteFileStamped(file, "bb", 1);
+    });
+    Check(watcher->WaitForChange(5000ms), "write is reported");
+    writer.join();
+}
+
+void WatcherTimesOutWhenIdle() {
+    ScopedTempDir dir("watcher_idle");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "a", 0);
+    auto watcher = file_watch::CreateNotifyingDirectoryWatcher({ file });
+    if (!watcher) {
+        Check(false, "notifying watcher created");
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    Check(!watcher->WaitForChange(100ms), "no change reported without writes");
+    Check(std::chrono::steady_clock::now() - start >= 90ms, "wait lasts for the timeout");
+}
+
+void WatcherWakeInterruptsWait() {
+    ScopedTempDir dir("watcher_wake");
+    auto watcher = file_watch::CreateNotifyingDirectoryWatcher({ dir.path / "image.png" });
+    if (!watcher) {
+        Check(false, "notifying watcher created");
+        return;
+    }
+    std::thread waker([&watcher]() {
+        std::this_thread::sleep_for(50ms);
+        watcher->Wake();
+    });
+    const auto start = std::chrono::steady_clock::now();
+    Check(!watcher->WaitForChange(10000ms), "wake is not reported as a change");
+    Check(std::chrono::steady_clock::now() - start < 5000ms, "wake returns before the timeout");
+    waker.join();
+}
+
+void RegistrySubscribeDoesNotFire() {
+    ScopedTempDir dir("registry_subscribe");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "pixels", 0);
+
+    FileWatchRegistry registry(200ms);
+    int calls = 0;
+    registry.Subscribe(file, [&calls](const FileChange&) { ++calls; });
+    const auto t0 = FileWatchRegistry::Clock::now();
+    Check(registry.Scan(t0) == 0 && registry.Scan(t0 + 1s) == 0, "an unchanged file is never delivered");
+    Check(calls == 0, "no callback for the baseline");
+    Check(!registry.NextDebounceDeadline().has_value(), "nothing is pending");
+}
+
+void RegistryDebouncesWriteBurst() {
+    ScopedTempDir dir("registry_debounce");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "v1", 0);
+
+    FileWatchRegistry registry(200ms);
+    std::vector<FileChange> changes;
+    registry.Subscribe(file, [&changes](const FileChange& change) { changes.push_back(change); });
+
+    // An editor saving in steps: truncate, partial write, final write.
+    const auto t0 = FileWatchRegistry::Clock::now();
+    WriteFileStamped(file, "", 1);
+    Check(registry.Scan(t0) == 0, "first step starts the debounce window");
+    Check(registry.NextDebounceDeadline() == t0 + 200ms, "deadline is one window after the first step");
+    WriteFileStamped(file, "v2-par", 2);
+    Check(registry.Scan(t0 + 150ms) == 0, "second step restarts the window");
+    WriteFileStamped(file, "v2-partial-final", 3);
+    Check(registry.Scan(t0 + 300ms) == 0, "third step restarts the window");
+    Check(registry.Scan(t0 + 450ms) == 0, "window has not passed since the last step");
+    Check(registry.Scan(t0 + 500ms) == 1, "one delivery once the file is stable");
+    Check(changes.size() == 1 && changes[0].size == std::string("v2-partial-final").size(), "delivered change has the final size");
+    Check(registry.Scan(t0 + 2s) == 0, "nothing further is delivered");
+    Check(registry.GetStats().changesDelivered == 1, "stats count one delivered change");
+}
+
+void RegistrySkipsUnchangedContent() {
+    ScopedTempDir dir("registry_unchanged");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "same bytes", 0);
+
+    FileWatchRegistry registry(100ms);
+    int calls = 0;
+    registry.Subscribe(file, [&calls](const FileChange&) { ++calls; });
+
+    const auto t0 = FileWatchRegistry::Clock::now();
+    WriteFileStamped(file, "same bytes", 5);
+    registry.Scan(t0);
+    Check(registry.Scan(t0 + 200ms) == 0, "rewriting identical bytes is not a change");
+    Check(calls == 0, "no callback for identical content");
+    Check(registry.GetStats().unchangedContentSkipped == 1, "skip is counted");
+
+    WriteFileStamped(file, "diff bytes", 6);
+    registry.Scan(t0 + 300ms);
+    Check(registry.Scan(t0 + 400ms) == 1 && calls == 1, "same size with different content is delivered");
+}
+
+void RegistryFansOutToAllSubscribers() {
+    ScopedTempDir dir("registry_fanout");
+    const auto image = dir.path / "image.png";
+    const auto other = dir.path / "background.png";
+    WriteFileStamped(image, "a", 0);
+    WriteFileStamped(other, "b", 0);
+
+    FileWatchRegistry registry(0ms);
+    int imageCalls = 0;
+    int backgroundCalls = 0;
+    registry.Subscribe(image, [&imageCalls](const FileChange&) { ++imageCalls; });
+    registry.Subscribe(dir.path / "." / "image.png", [&backgroundCalls](const FileChange&) { ++backgroundCalls; });
+    registry.Subscribe(other, [](const FileChange&) {});
+
+    Check(registry.WatchedFiles().size() == 2, "both spellings of the same path share one entry");
+    Check(registry.WatchedDirectories().size() == 1, "files in one directory share one directory watch");
+
+    WriteFileStamped(image, "changed", 1);
+    Check(registry.Scan(FileWatchRegistry::Clock::now()) == 2, "both subscribers are called");
+    Check(imageCalls == 1 && backgroundCalls == 1, "each subscriber sees the change once");
+    Check(registry.GetStats().changesDelivered == 1, "one change for the shared path");
+}
+
+void RegistryUnsubscribeStopsDelivery() {
+    ScopedTempDir dir("registry_unsubscribe");
+    const auto file = dir.path / "image.png";
+    WriteFileStamped(file, "a", 0);
+
+    FileWatchRegistry registry(0ms);
+    int kept = 0;
+    int removed = 0;
+    const auto keptId = registry.Subscribe(file, [&kept](const FileChange&) { ++kept; });
+    const auto id = registry.Subscribe(file, [&removed](const FileChange&) { ++removed; });
+    registry.Unsubscribe(id);
+
+    WriteFileStamped(file, "bb", 1);
+    registry.Scan(FileWatchRegistry::Clock::now());
+    Check(kept == 1 && removed == 0, "only the remaining subscriber is called");
+
+    registry.Unsubscribe(keptId);
+    Check(registry.WatchedFiles().empty(), "the path is dropped with its last subscriber");
+    Check(registry.WatchedDirectories().empty(), "and so is its directory");
+}
+
+void RegistryDeliversFileCreatedLater() {
+    ScopedTempDir dir("registry_created");
+    const auto file = dir.path / "image.png";
+
+    FileWatchRegistry registry(100ms);
+    int calls = 0;
+    registry.Subscribe(file, [&calls](const FileChange&) { ++calls; });
+
+    const auto t0 = FileWatchRegistry::Clock::now();
+    Check(registry.Scan(t0) == 0, "a missing file is not delivered");
+    WriteFileStamped(file, "new", 0);
+    registry.Scan(t0 + 10ms);
+    Check(registry.Scan(t0 + 200ms) == 1 && calls == 1, "the file is delivered once it appears");
+
+    std::filesystem::remove(file);
+    registry.Scan(t0 + 300ms);
+    Check(registry.Scan(t0 + 500ms) == 0, "removal is not delivered");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"watcher_reports_file_write", &WatcherReportsFileWrite},
+        {"watcher_times_out_when_idle", &WatcherTimesOutWhenIdle},
+        {"watcher_wake_interrupts_wait", &WatcherWakeInterruptsWait},
+        {"registry_subscribe_does_not_fire", &RegistrySubscribeDoesNotFire},
+        {"registry_debounces_write_burst", &RegistryDebouncesWriteBurst},
+        {"registry_skips_unchanged_content", &RegistrySkipsUnchangedContent},
+        {"registry_fans_out_to_all_subscribers", &RegistryFansOutToAllSubscribers},
+        {"registry_unsubscribe_stops_delivery", &RegistryUnsubscribeStopsDelivery},
+        {"registry_delivers_file_created_later", &RegistryDeliversFileCreatedLater},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
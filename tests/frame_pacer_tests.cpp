@@ -0,0 +1,427 @@
+#include "render/frame_pacer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+constexpr int64_t kRelaxStepNs = 1'000;
+
+// Time only moves when the pacer sleeps or spins, or when a test simulates frame work.
+class SimulatedClock final : public FramePacerClock {
+  public:
+    int64_t NowNs() override { return m_nowNs; }
+
+    void SleepUntilNs(int64_t deadlineNs) override {
+        ++sleeps;
+        const int64_t wakeNs = deadlineNs + (oversleep ? oversleep() : 0);
+        m_nowNs = (std::max)(m_nowNs, wakeNs);
+    }
+
+    void Relax() override {
+        ++relaxes;
+        m_nowNs += kRelaxStepNs;
+    }
+
+    void Advance(int64_t ns) { m_nowNs += ns; }
+
+    std::function<int64_t()> oversleep;
+    uint64_t sleeps = 0;
+    uint64_t relaxes = 0;
+
+  private:
+    int64_t m_nowNs = 1'000'000'000;
+};
+
+FramePacerSettings MakeSettings(int fps) {
+    FramePacerSettings settings;
+    settings.targetFps = fps;
+    return settings;
+}
+
+// The limiter this replaces: sleep the whole remaining time on the timer, then present whenever it wakes.
+struct LegacyLimiter {
+    int64_t lastFrameEndNs = 0;
+
+    int64_t Pace(SimulatedClock& clock, int fps) {
+        const int64_t targetNs = lastFrameEndNs + 1'000'000'000 / fps;
+        const int64_t nowNs = clock.NowNs();
+        if (nowNs < targetNs) {
+            clock.SleepUntilNs(targetNs);
+            lastFrameEndNs = targetNs;
+            return clock.NowNs() - targetNs;
+        }
+        lastFrameEndNs = nowNs;
+        return 0;
+    }
+};
+
+void GridHasNoDriftOverLongRuns() {
+    SimulatedClock clock;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int64_t> work(0, 5'000'000);
+    clock.oversleep = [&rng]() { return static_cast<int64_t>(rng() % 300'000); };
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(144);
+
+    const int64_t anchorNs = clock.NowNs();
+    // Ten minutes at 144 FPS, crossing several anchor folds.
+    const uint64_t frames = 144ull * 600ull;
+    bool exact = true;
+    for (uint64_t k = 1; k <= frames; ++k) {
+        const FramePacerFrameResult frame = pacer.Pace(settings);
+        const int64_t expectedNs = anchorNs + static_cast<int64_t>((k * 1'000'000'000ull) / 144ull);
+        if (frame.deadlineNs != expectedNs) {
+            Check(false, "deadline " + std::to_string(k) + " drifted by " + std::to_string(frame.deadlineNs - expectedNs) + " ns");
+            exact = false;
+            break;
+        }
+        clock.Advance(work(rng));
+    }
+    Check(exact, "every deadline should sit exactly on the grid");
+    Check(pacer.Stats().missedDeadlines == 0, "no deadline should be missed with 5 ms of work at 144 FPS");
+    Check(pacer.Stats().maxJitterNs < kRelaxStepNs, "presentation should land within one spin step of the deadline");
+}
+
+void LearnsTimerOversleep() {
+    SimulatedClock clock;
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<int64_t> oversleep(1'000'000, 1'400'000);
+    clock.oversleep = [&]() { return oversleep(rng); };
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(240);
+
+    for (int i = 0; i < 200; ++i) {
+        pacer.Pace(settings);
+        clock.Advance(500'000);
+    }
+    pacer.ResetStats();
+    for (int i = 0; i < 2000; ++i) {
+        pacer.Pace(settings);
+        clock.Advance(500'000);
+    }
+
+    const FramePacerStats& stats = pacer.Stats();
+    Check(stats.missedDeadlines == 0, "learned margin should absorb the timer's oversleep, missed " + std::to_string(stats.missedDeadlines));
+    Check(stats.maxJitterNs < kRelaxStepNs, "jitter should be one spin step at most, got " + std::to_string(stats.maxJitterNs));
+    Check(pacer.OversleepEstimateNs() >= 1'000'000 && pacer.OversleepEstimateNs() <= 1'400'000,
+          "oversleep estimate should land inside the simulated range, got " + std::to_string(pacer.OversleepEstimateNs()));
+    Check(pacer.SpinMarginNs() >= 1'400'000 && pacer.SpinMarginNs() <= 2'500'000,
+          "spin margin should cover the worst oversleep without spinning most of the frame, got " + std::to_string(pacer.SpinMarginNs()));
+    Check(stats.sleeps == 2000, "every frame with time to spare should sleep first");
+
+    SimulatedClock legacyClock;
+    std::mt19937 legacyRng(2);
+    legacyClock.oversleep = [&]() { return oversleep(legacyRng); };
+    LegacyLimiter legacy;
+    legacy.lastFrameEndNs = legacyClock.NowNs();
+    int64_t legacyJitterNs = 0;
+    for (int i = 0; i < 2000; ++i) {
+        legacyJitterNs += legacy.Pace(legacyClock, 240);
+        legacyClock.Advance(500'000);
+    }
+    Check(stats.MeanJitterNs() * 100 < legacyJitterNs / 2000, "adaptive pacing should cut mean jitter by two orders of magnitude");
+}
+
+void MarginShrinksWhenTimerImproves() {
+    SimulatedClock clock;
+    int64_t oversleepNs = 2'000'000;
+    clock.oversleep = [&oversleepNs]() { return oversleepNs; };
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(120);
+
+    for (int i = 0; i < 300; ++i) pacer.Pace(settings);
+    Check(pacer.SpinMarginNs() >= 2'000'000, "margin should cover a 2 ms oversleep");
+
+    oversleepNs = 100'000;
+    for (int i = 0; i < 1000; ++i) pacer.Pace(settings);
+    Check(pacer.SpinMarginNs() < 400'000, "margin should follow the timer down, got " + std::to_string(pacer.SpinMarginNs()));
+
+    pacer.ResetStats();
+    for (int i = 0; i < 100; ++i) pacer.Pace(settings);
+    Check(pacer.Stats().totalSpunNs / 100 < 400'000, "spinning per frame should drop with the margin");
+    Check(pacer.Stats().missedDeadlines == 0, "no deadline should be missed while the margin shrinks");
+}
+
+void LateWakeRaisesMarginQuickly() {
+    SimulatedClock clock;
+    int64_t oversleepNs = 100'000;
+    clock.oversleep = [&oversleepNs]() { return oversleepNs; };
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(60);
+    for (int i = 0; i < 200; ++i) pacer.Pace(settings);
+
+    oversleepNs = 3'000'000;
+    // The first late wakes present late; the margin has to catch up within a handful of frames.
+    for (int i = 0; i < 10; ++i) pacer.Pace(settings);
+    pacer.ResetStats();
+    for (int i = 0; i < 20; ++i) pacer.Pace(settings);
+    Check(pacer.Stats().maxJitterNs < kRelaxStepNs, "frames should be on time again, max jitter " + std::to_string(pacer.Stats().maxJitterNs));
+    Check(pacer.SpinMarginNs() >= 3'000'000, "margin should reach the new oversleep within a few frames, got " + std::to_string(pacer.SpinMarginNs()));
+}
+
+void OversizedMarginRecovers() {
+    SimulatedClock clock;
+    int64_t oversleepNs = 6'000'000;
+    clock.oversleep = [&oversleepNs]() { return oversleepNs; };
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(240);
+
+    // One pathological wake pushes the margin past the whole frame, so the next frames have nothing to sleep.
+    pacer.Pace(settings);
+    Check(pacer.SpinMarginNs() == settings.maxSpinMarginNs, "a 6 ms wake should push the margin to its cap");
+    oversleepNs = 200'000;
+    for (int i = 0; i < 200; ++i) {
+        pacer.Pace(settings);
+        clock.Advance(500'000);
+    }
+    pacer.ResetStats();
+    for (int i = 0; i < 100; ++i) {
+        pacer.Pace(settings);
+        clock.Advance(500'000);
+    }
+    Check(pacer.Stats().sleeps == 100, "the pacer should return to sleeping once the margin narrows");
+    Check(pacer.SpinMarginNs() < 1'000'000, "the margin should settle near the real oversleep, got " + std::to_string(pacer.SpinMarginNs()));
+}
+
+void ShortWaitsSpinWithoutSleeping() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    // 500 us frames are below the 1 ms sleep threshold.
+    const FramePacerSettings settings = MakeSettings(2000);
+    for (int i = 0; i < 500; ++i) {
+        pacer.Pace(settings);
+        clock.Advance(100'000);
+    }
+    Check(clock.sleeps == 0, "waits under the sleep threshold should never sleep");
+    Check(pacer.Stats().missedDeadlines == 0 && pacer.Stats().maxJitterNs < kRelaxStepNs, "spinning alone should hold the cadence");
+}
+
+void LateFrameRestartsGrid() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(100);
+    for (int i = 0; i < 10; ++i) pacer.Pace(settings);
+
+    clock.Advance(50'000'000);
+    const FramePacerFrameResult hitch = pacer.Pace(settings);
+    Check(hitch.missedDeadline, "a 50 ms frame should miss its deadline");
+    Check(hitch.presentNs == hitch.deadlineNs, "the grid should restart at the late frame");
+
+    const FramePacerFrameResult next = pacer.Pace(settings);
+    Check(!next.missedDeadline, "the frame after a hitch should be paced again");
+    Check(next.presentNs - hitch.presentNs >= 10'000'000, "no burst of catch-up frames after a hitch");
+}
+
+void SlightlyLateFrameKeepsGrid() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(100);
+    const FramePacerFrameResult first = pacer.Pace(settings);
+
+    clock.Advance(14'000'000);
+    const FramePacerFrameResult late = pacer.Pace(settings);
+    Check(late.missedDeadline, "a 14 ms frame should miss a 10 ms deadline");
+
+    const FramePacerFrameResult next = pacer.Pace(settings);
+    Check(next.deadlineNs == first.deadlineNs + 20'000'000, "a frame late by less than an interval should keep the grid");
+    Check(!next.missedDeadline, "the grid should absorb the late frame");
+}
+
+void AlignsPresentationWithCaptureCadence() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(120);
+    // OBS at 60 FPS, ticking at an arbitrary phase.
+    const int64_t captureIntervalNs = 1'000'000'000 / 60;
+    const int64_t capturePhaseNs = clock.NowNs() + 5'123'456;
+    auto cadenceAt = [&](int64_t nowNs) {
+        FramePacerCaptureCadence cadence;
+        cadence.intervalNs = captureIntervalNs;
+        cadence.lastCaptureNs = capturePhaseNs + ((nowNs - capturePhaseNs) / captureIntervalNs) * captureIntervalNs;
+        return cadence;
+    };
+
+    for (int i = 0; i < 400; ++i) pacer.Pace(settings, cadenceAt(clock.NowNs()));
+
+    const int64_t frameIntervalNs = 1'000'000'000 / 120;
+    int64_t worstErrorNs = 0;
+    for (int i = 0; i < 200; ++i) {
+        const FramePacerFrameResult frame = pacer.Pace(settings, cadenceAt(clock.NowNs()));
+        int64_t errorNs = (capturePhaseNs - FramePacer::kCaptureLeadNs - frame.presentNs) % frameIntervalNs;
+        if (errorNs < 0) errorNs += frameIntervalNs;
+        errorNs = (std::min)(errorNs, frameIntervalNs - errorNs);
+        worstErrorNs = (std::max)(worstErrorNs, errorNs);
+    }
+    Check(worstErrorNs < 20'000, "presentation should settle just ahead of each capture, off by " + std::to_string(worstErrorNs) + " ns");
+    Check(pacer.Stats().missedDeadlines == 0, "phase correction should never make a frame late");
+}
+
+void IgnoresUnrelatedCaptureCadence() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    const FramePacerSettings settings = MakeSettings(144);
+    FramePacerCaptureCadence cadence;
+    cadence.intervalNs = 1'000'000'000 / 100;
+    cadence.lastCaptureNs = clock.NowNs() + 3'000'000;
+
+    const int64_t anchorNs = clock.NowNs();
+    bool onGrid = true;
+    for (uint64_t k = 1; k <= 1000; ++k) {
+        const FramePacerFrameResult frame = pacer.Pace(settings, cadence);
+        onGrid = onGrid && frame.deadlineNs == anchorNs + static_cast<int64_t>((k * 1'000'000'000ull) / 144ull);
+    }
+    Check(onGrid, "a capture rate that is not a multiple of the frame rate should leave the grid alone");
+}
+
+void DisabledTargetDoesNotWait() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    const int64_t before = clock.NowNs();
+    const FramePacerFrameResult frame = pacer.Pace(MakeSettings(0));
+    Check(frame.presentNs == before && clock.NowNs() == before, "an FPS limit of 0 should not wait");
+    Check(clock.sleeps == 0 && clock.relaxes == 0, "an FPS limit of 0 should neither sleep nor spin");
+    Check(pacer.Stats().frames == 0, "unpaced frames should not count");
+}
+
+void FpsChangeRestartsGrid() {
+    SimulatedClock clock;
+    FramePacer pacer(clock);
+    for (int i = 0; i < 10; ++i) pacer.Pace(MakeSettings(60));
+    const int64_t changeNs = clock.NowNs();
+    const FramePacerFrameResult frame = pacer.Pace(MakeSettings(200));
+    Check(frame.deadlineNs == changeNs + 5'000'000, "a new target should start its grid from the current frame");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"grid_has_no_drift_over_long_runs", &GridHasNoDriftOverLongRuns},
+        {"learns_timer_oversleep", &LearnsTimerOversleep},
+        {"margin_shrinks_when_timer_improves", &MarginShrinksWhenTimerImproves},
+        {"late_wake_raises_margin_quickly", &LateWakeRaisesMarginQuickly},
+        {"oversized_margin_recovers", &OversizedMarginRecovers},
+        {"short_waits_spin_without_sleeping", &ShortWaitsSpinWithoutSleeping},
+        {"late_frame_restarts_grid", &LateFrameRestartsGrid},
+        {"slightly_late_frame_keeps_grid", &SlightlyLateFrameKeepsGrid},
+        {"aligns_presentation_with_capture_cadence", &AlignsPresentationWithCaptureCadence},
+        {"ignores_unrelated_capture_cadence", &IgnoresUnrelatedCaptureCadence},
+        {"disabled_target_does_not_wait", &DisabledTargetDoesNotWait},
+        {"fps_change_restarts_grid", &FpsChangeRestartsGrid},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// Simulated timers: a high-resolution waitable timer (~0.5 ms late, some noise) and a 1 ms-granularity one.
+int RunBenchmark() {
+    struct TimerModel {
+        const char* name;
+        int64_t minOversleepNs;
+        int64_t maxOversleepNs;
+    };
+    const TimerModel models[] = { { "high-res timer", 300'000, 700'000 }, { "1 ms timer", 0, 1'000'000 } };
+    const int fpsTargets[] = { 60, 144, 240 };
+    constexpr int kFrames = 20000;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const TimerModel& model : models) {
+        for (int fps : fpsTargets) {
+            std::mt19937 rng(9);
+            std::uniform_int_distribution<int64_t> oversleep(model.minOversleepNs, model.maxOversleepNs);
+            std::uniform_int_distribution<int64_t> work(500'000, 1'000'000'000 / fps / 2);
+
+            SimulatedClock legacyClock;
+            legacyClock.oversleep = [&]() { return oversleep(rng); };
+            LegacyLimiter legacy;
+            legacy.lastFrameEndNs = legacyClock.NowNs();
+            int64_t legacyJitterNs = 0;
+            int64_t legacyMaxJitterNs = 0;
+            for (int i = 0; i < kFrames; ++i) {
+                const int64_t jitterNs = legacy.Pace(legacyClock, fps);
+                legacyJitterNs += jitterNs;
+                legacyMaxJitterNs = (std::max)(legacyMaxJitterNs, jitterNs);
+                legacyClock.Advance(work(rng));
+            }
+
+            SimulatedClock clock;
+            clock.oversleep = [&]() { return oversleep(rng); };
+            FramePacer pacer(clock);
+            for (int i = 0; i < kFrames; ++i) {
+                pacer.Pace(MakeSettings(fps));
+                clock.Advance(work(rng));
+            }
+            const FramePacerStats& stats = pacer.Stats();
+            std::cout << model.name << " @ " << fps << " FPS: legacy mean/max jitter " << legacyJitterNs / kFrames / 1000.0 << "/"
+                      << legacyMaxJitterNs / 1000.0 << " us; adaptive " << stats.MeanJitterNs() / 1000.0 << "/" << stats.maxJitterNs / 1000.0
+                      << " us, spin " << stats.totalSpunNs / kFrames / 1000.0 << " us/frame, missed " << stats.missedDeadlines << '\n';
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
@@ -1,12 +1,17 @@
 #include "features/game_state_source.h"
+#include "features/game_state_watcher.h"
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -43,6 +48,50 @@ using game_state_source::DeriveStateFromStateOutputText;
 using game_state_source::EvaluateHermesAlive;
 using game_state_source::Select;
 
+using namespace std::chrono_literals;
+
+// Fresh directory under the system temp dir, removed on destruction.
+struct ScopedTempDir {
+    std::filesystem::path path;
+
+    explicit ScopedTempDir(const std::string& name) {
+        path = std::filesystem::temp_directory_path() /
+               ("toolscreen_" + name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(path);
+    }
+
+    ~ScopedTempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+};
+
+void WriteTextFile(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+void WriteAliveFile(const std::filesystem::path& path, uint64_t pid) {
+    const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    const auto bytes = MakeAliveBytes(pid, static_cast<uint64_t>(nowMs));
+    WriteTextFile(path, std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+}
+
+// Calls WaitAndUpdate() until it reports expected or the deadline passes.
+bool WaitForState(game_state_source::GameStateMonitor& monitor, const std::string& expected,
+                  std::chrono::milliseconds limit = 5000ms) {
+    const auto deadline = std::chrono::steady_clock::now() + limit;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::optional<std::string> state = monitor.WaitAndUpdate(100ms);
+        if (state && *state == expected) { return true; }
+    }
+    return false;
+}
+
+game_state_source::GameStateMonitorPaths MonitorPaths(const ScopedTempDir& dir) {
+    return { dir.path / "hermes" / "state.json", dir.path / "hermes" / "alive", dir.path / "wpstateout.txt" };
+}
+
 void StateOutputNormalizesUnpaused() {
     CheckOptEq(DeriveStateFromStateOutputText("inworld,unpaused"), std::string("inworld,cursor_grabbed"), "unpaused->grabbed");
 }
@@ -138,6 +187,90 @@ void AliveFutureSkewWithinThresholdTrue() {
     CheckTrue(EvaluateHermesAlive(bytes.data(), 1234, 100000), "1s future skew alive");
 }
 
+void MonitorReadsStateOutputChanges() {
+    ScopedTempDir dir("monitor_stateout");
+    const auto paths = MonitorPaths(dir);
+    WriteTextFile(paths.stateOutput, "inworld,unpaused");
+
+    game_state_source::GameStateMonitor monitor(paths);
+    CheckTrue(WaitForState(monitor, "inworld,cursor_grabbed"), "initial state read");
+    CheckTrue(monitor.ActiveSource() == GameStateSourceKind::StateOutput, "state output is the active source");
+
+    WriteTextFile(paths.stateOutput, "wall");
+    CheckTrue(WaitForState(monitor, "wall"), "changed state read");
+}
+
+void MonitorPrefersLiveHermes() {
+    ScopedTempDir dir("monitor_hermes");
+    const auto paths = MonitorPaths(dir);
+    std::filesystem::create_directories(paths.hermesState.parent_path());
+    WriteTextFile(paths.stateOutput, "wall");
+    WriteTextFile(paths.hermesState, R"({"world":{}})");
+    WriteAliveFile(paths.hermesAlive, 4242);
+
+    game_state_source::GameStateMonitorOptions options;
+    options.processId = 4242;
+    game_state_source::GameStateMonitor monitor(paths, options);
+    CheckTrue(WaitForState(monitor, "inworld,cursor_grabbed"), "hermes state read");
+    CheckTrue(monitor.ActiveSource() == GameStateSourceKind::Hermes, "hermes is the active source");
+
+    WriteTextFile(paths.hermesState, R"({"world":null})");
+    CheckTrue(WaitForState(monitor, "title"), "hermes change read");
+}
+
+void MonitorPicksUpStateOutputCreatedLater() {
+    ScopedTempDir dir("monitor_created");
+    const auto paths = MonitorPaths(dir);
+
+    // A source check interval far beyond the test's deadline: only a change notification can find the new file.
+    game_state_source::GameStateMonitorOptions options;
+    options.sourceCheckInterval = 60000ms;
+    game_state_source::GameStateMonitor monitor(paths, options);
+    CheckTrue(!monitor.WaitAndUpdate(50ms).has_value(), "nothing to report without a source");
+    CheckTrue(monitor.IsEventDriven(), "monitor uses change notifications");
+    CheckTrue(monitor.ActiveSource() == GameStateSourceKind::None, "no source yet");
+
+    WriteTextFile(paths.stateOutput, "title");
+    CheckTrue(WaitForState(monitor, "title"), "created file is read without waiting for a source check");
+    CheckTrue(monitor.ActiveSource() == GameStateSourceKind::StateOutput, "state output became active");
+}
+
+void PollingFallbackDetectsChanges() {
+    ScopedTempDir dir("monitor_polling");
+    const auto paths = MonitorPaths(dir);
+    WriteTextFile(paths.stateOutput, "title");
+
+    game_state_source::GameStateMonitorOptions options;
+    options.sourceCheckInterval = 60000ms;
+    options.createWatcher = [](const std::vector<std::filesystem::path>& files) {
+        return file_watch::CreatePollingDirectoryWatcher(files, 8ms);
+    };
+    game_state_source::GameStateMonitor monitor(paths, options);
+    CheckTrue(WaitForState(monitor, "title"), "initial state read");
+    CheckTrue(!monitor.IsEventDriven(), "polling watcher is not event driven");
+
+    WriteTextFile(paths.stateOutput, "inworld,paused");
+    CheckTrue(WaitForState(monitor, "inworld,cursor_free"), "polling picks up the change");
+}
+
+void MonitorIdleWakeupsAreBounded() {
+    ScopedTempDir dir("monitor_idle");
+    const auto paths = MonitorPaths(dir);
+    WriteTextFile(paths.stateOutput, "title");
+
+    game_state_source::GameStateMonitorOptions options;
+    options.sourceCheckInterval = 200ms;
+    game_state_source::GameStateMonitor monitor(paths, options);
+    CheckTrue(WaitForState(monitor, "title"), "initial state read");
+
+    const uint64_t before = monitor.WakeupCount();
+    const auto end = std::chrono::steady_clock::now() + 1000ms;
+    while (std::chrono::steady_clock::now() < end) { CheckTrue(!monitor.WaitAndUpdate(1000ms).has_value(), "idle file reports nothing"); }
+    const uint64_t wakeups = monitor.WakeupCount() - before;
+    // One wakeup per source check; the previous 8 ms sleep loop woke about 125 times in the same second.
+    CheckTrue(wakeups <= 10, "idle monitor wakes only for source checks (" + std::to_string(wakeups) + " wakeups)");
+}
+
 struct TestCase {
     const char* name;
     std::function<void()> run;
@@ -164,6 +297,11 @@ const std::vector<TestCase>& Registry() {
         {"alive_wrong_pid_false", &AliveWrongPidFalse},
         {"alive_stale_heartbeat_false", &AliveStaleHeartbeatFalse},
         {"alive_future_skew_within_threshold_true", &AliveFutureSkewWithinThresholdTrue},
+        {"monitor_reads_state_output_changes", &MonitorReadsStateOutputChanges},
+        {"monitor_prefers_live_hermes", &MonitorPrefersLiveHermes},
+        {"monitor_picks_up_state_output_created_later", &MonitorPicksUpStateOutputCreatedLater},
+        {"polling_fallback_detects_changes", &PollingFallbackDetectsChanges},
+        {"monitor_idle_wakeups_are_bounded", &MonitorIdleWakeupsAreBounded},
     };
     return cases;
 }
@@ -2119,4 +2119,202 @@ void RunConfigModeSourceHelpersTest(TestRunMode /*runMode*/ = TestRunMode::Autom
 
     Expect(!RenameModeSource(mode, ModeSourceType::Mirror, "NoSuchName", "Anything"),
            "RenameModeSource of a missing entry should return false.");
-}
\ No newline at end of file
+}
+Config LoadEmbeddedDefaultsForDiffTest() {
+    Config config;
+    Expect(LoadEmbeddedDefaultConfig(config), "LoadEmbeddedDefaultConfig should succeed for config diff fixtures.");
+    Expect(config.mirrors.size() >= 2 && !config.images.empty() && config.modes.size() >= 2 && !config.hotkeys.empty(),
+           "Config diff fixtures expect the embedded defaults to ship mirrors, images, modes and hotkeys.");
+    return config;
+}
+
+bool ContainsKey(const std::vector<std::string>& keys, const std::string& key) {
+    return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+void RunConfigDiffEmbeddedDefaultsMutationsTest(TestRunMode /*runMode*/ = TestRunMode::Automated) {
+    const Config base = LoadEmbeddedDefaultsForDiffTest();
+    if (base.mirrors.size() < 2 || base.images.empty() || base.modes.size() < 2 || base.hotkeys.empty()) { return; }
+
+    Expect(DiffConfigs(base, base).Empty(), "Diffing a config against itself should report no changes.");
+    Expect(DiffConfigSections(base, Config(base)) == 0, "Diffing a config against a copy should report no changes.");
+
+    {
+        Config edited = base;
+        edited.mirrors[1].colors.output.r += 0.25f;
+        const ConfigDiff diff = DiffConfigs(base, edited);
+        Expect(diff.changed == ConfigSectionBit(ConfigSection::Mirrors), "A mirror color edit should only change the mirrors section.");
+        const ConfigElementChanges& mirrors = diff.Elements(ConfigSection::Mirrors);
+        Expect(mirrors.modified.size() == 1 && mirrors.modified[0] == base.mirrors[1].name,
+               "A mirror color edit should report exactly the edited mirror as modified.");
+        Expect(!mirrors.StructureChanged(), "A mirror color edit should not be reported as a structural change.");
+        Expect(mirrors.Touches(base.mirrors[1].name) && !mirrors.Touches(base.mirrors[0].name),
+               "Touches should single out the edited mirror.");
+    }
+
+    {
+        Config edited = base;
+        ImageConfig image = base.images[0];
+        image.name = "Diff Added Image";
+        edited.images.push_back(image);
+        const ConfigDiff diff = DiffConfigs(base, edited);
+        Expect(diff.changed == ConfigSectionBit(ConfigSection::Images), "Adding an image should only change the images section.");
+        const ConfigElementChanges& images = diff.Elements(ConfigSection::Images);
+        Expect(images.added.size() == 1 && images.added[0] == "Diff Added Image" && images.removed.empty() && images.modified.empty(),
+               "Adding an image should report it as the only added image.");
+        Expect(images.StructureChanged(), "Adding an image should be a structural change.");
+    }
+
+    {
+        Config edited = base;
+        const std::string removedModeId = edited.modes.back().id;
+        edited.modes.pop_back();
+        const ConfigDiff diff = DiffConfigs(base, edited);
+        Expect(diff.changed == ConfigSectionBit(ConfigSection::Modes), "Removing a mode should only change the modes section.");
+        const ConfigElementChanges& modes = diff.Elements(ConfigSection::Modes);
+        Expect(modes.removed.size() == 1 && modes.removed[0] == removedModeId && modes.added.empty() && !modes.reordered,
+               "Removing the last mode should report it as removed without reordering the rest.");
+    }
+
+    {
+        Config edited = base;
+        const std::string oldName = edited.mirrors[0].name;
+        edited.mirrors[0].name = "Diff Renamed Mirror";
+        const ConfigElementChanges& mirrors = DiffConfigs(base, edited).Elements(ConfigSection::Mirrors);
+        Expect(ContainsKey(mirrors.added, "Diff Renamed Mirror") && ContainsKey(mirrors.removed, oldName) && mirrors.modified.empty(),
+               "Renaming a mirror should report the new name as added and the old one as removed.");
+    }
+
+    {
+        Config edited = base;
+        std::swap(edited.mirrors[0], edited.mirrors[1]);
+        const ConfigElementChanges& mirrors = DiffConfigs(base, edited).Elements(ConfigSection::Mirrors);
+        Expect(mirrors.reordered && mirrors.added.empty() && mirrors.removed.empty() && mirrors.modified.empty(),
+               "Swapping two mirrors should be reported as a pure reorder.");
+    }
+
+    {
+        Config edited = base;
+        edited.mirrors.push_back(edited.mirrors[0]);
+        edited.mirrors.back().fps += 1;
+        const ConfigElementChanges& mirrors = DiffConfigs(base, edited).Elements(ConfigSection::Mirrors);
+        Expect(mirrors.StructureChanged(), "A duplicated mirror name should force a structural change.");
+    }
+
+    {
+        Config edited = base;
+        edited.hotkeys.back().debounce += 50;
+        const ConfigDiff diff = DiffConfigs(base, edited);
+        Expect(diff.changed == ConfigSectionBit(ConfigSection::Hotkeys), "A hotkey debounce edit should only change the hotkeys section.");
+        const ConfigElementChanges& hotkeys = diff.Elements(ConfigSection::Hotkeys);
+        Expect(hotkeys.modified.size() == 1 && hotkeys.modified[0] == std::to_string(base.hotkeys.size() - 1),
+               "Hotkeys should be keyed by position.");
+    }
+
+    {
+        Config edited = base;
+        edited.mirrorGroups.push_back(MirrorGroupConfig{});
+        edited.mirrorGroups.back().name = "Diff Group";
+        edited.eyezoom.cloneWidth += 2;
+        edited.cursors.enabled = !edited.cursors.enabled;
+        edited.cursorTrail.opacity *= 0.5f;
+        edited.keyRebinds.enabled = !edited.keyRebinds.enabled;
+        edited.appearance.theme = "Diff Theme";
+        edited.ninjabrainOverlay.overlayScale += 0.1f;
+        edited.debug.showProfiler = !edited.debug.showProfiler;
+        edited.sensitivityHotkeys.push_back(SensitivityHotkeyConfig{});
+        edited.browserOverlays.push_back(BrowserOverlayConfig{});
+        edited.windowOverlays.push_back(WindowOverlayConfig{});
+        const ConfigSectionMask expected =
+            ConfigSectionBit(ConfigSection::MirrorGroups) | ConfigSectionBit(ConfigSection::EyeZoom) |
+            ConfigSectionBit(ConfigSection::Cursors) | ConfigSectionBit(ConfigSection::CursorTrail) |
+            ConfigSectionBit(ConfigSection::KeyRebinds) | ConfigSectionBit(ConfigSection::Appearance) |
+            ConfigSectionBit(ConfigSection::NinjabrainOverlay) | ConfigSectionBit(ConfigSection::Debug) |
+            ConfigSectionBit(ConfigSection::SensitivityHotkeys) | ConfigSectionBit(ConfigSection::BrowserOverlays) |
+            ConfigSectionBit(ConfigSection::WindowOverlays);
+        Expect(DiffConfigSections(base, edited) == expected, "Each section edit should be attributed to exactly its own section.");
+    }
+}
+
+void RunConfigDiffGeneralFieldsTest(TestRunMode /*runMode*/ = TestRunMode::Automated) {
+    const Config base = LoadEmbeddedDefaultsForDiffTest();
+
+    const std::vector<std::pair<const char*, std::function<void(Config&)>>> edits = {
+        { "configVersion", [](Config& c) { c.configVersion += 1; } },
+        { "defaultMode", [](Config& c) { c.defaultMode += "x"; } },
+        { "guiHotkey", [](Config& c) { c.guiHotkey.push_back(VK_F9); } },
+        { "borderlessHotkey", [](Config& c) { c.borderlessHotkey.push_back(VK_F9); } },
+        { "autoBorderless", [](Config& c) { c.autoBorderless = !c.autoBorderless; } },
+        { "imageOverlaysHotkey", [](Config& c) { c.imageOverlaysHotkey.push_back(VK_F9); } },
+        { "windowOverlaysHotkey", [](Config& c) { c.windowOverlaysHotkey.push_back(VK_F9); } },
+        { "ninjabrainOverlayHotkey", [](Config& c) { c.ninjabrainOverlayHotkey.push_back(VK_F9); } },
+        { "fontPath", [](Config& c) { c.fontPath += "x"; } },
+        { "lang", [](Config& c) { c.lang += "x"; } },
+        { "fpsLimit", [](Config& c) { c.fpsLimit += 1; } },
+        { "fpsLimitSleepThreshold", [](Config& c) { c.fpsLimitSleepThreshold += 1; } },
+        { "fpsLimitAlignToObsCapture", [](Config& c) { c.fpsLimitAlignToObsCapture = !c.fpsLimitAlignToObsCapture; } },
+        { "mirrorGammaMode", [](Config& c) {
+              c.mirrorGammaMode = c.mirrorGammaMode == MirrorGammaMode::AssumeLinear ? MirrorGammaMode::Auto : MirrorGammaMode::AssumeLinear;
+          } },
+        { "disableHookChaining", [](Config& c) { c.disableHookChaining = !c.disableHookChaining; } },
+        { "allowCursorEscape", [](Config& c) { c.allowCursorEscape = !c.allowCursorEscape; } },
+        { "confineCursor", [](Config& c) { c.confineCursor = !c.confineCursor; } },
+        { "mouseSensitivity", [](Config& c) { c.mouseSensitivity += 0.5f; } },
+        { "windowsMouseSpeed", [](Config& c) { c.windowsMouseSpeed += 1; } },
+        { "hideAnimationsInGame", [](Config& c) { c.hideAnimationsInGame = !c.hideAnimationsInGame; } },
+        { "captureFakeCursor", [](Config& c) { c.captureFakeCursor = !c.captureFakeCursor; } },
+        { "limitCaptureFramerate", [](Config& c) { c.limitCaptureFramerate = !c.limitCaptureFramerate; } },
+        { "obsFramerate", [](Config& c) { c.obsFramerate += 1; } },
+        { "useSystemKeyRepeat", [](Config& c) { c.useSystemKeyRepeat = !c.useSystemKeyRepeat; } },
+        { "keyRepeatStartDelay", [](Config& c) { c.keyRepeatStartDelay += 1; } },
+        { "keyRepeatDelay", [](Config& c) { c.keyRepeatDelay += 1; } },
+        { "basicModeEnabled", [](Config& c) { c.basicModeEnabled = !c.basicModeEnabled; } },
+        { "restoreWindowedModeOnFullscreenExit",
+          [](Config& c) { c.restoreWindowedModeOnFullscreenExit = !c.restoreWindowedModeOnFullscreenExit; } },
+        { "disableFullscreenPrompt", [](Config& c) { c.disableFullscreenPrompt = !c.disableFullscreenPrompt; } },
+        { "disableConfigurePrompt", [](Config& c) { c.disableConfigurePrompt = !c.disableConfigurePrompt; } },
+        { "startupIndicatorMode", [](Config& c) { c.startupIndicatorMode += 1; } },
+        { "startupIndicatorImagePath", [](Config& c) { c.startupIndicatorImagePath += "x"; } },
+    };
+
+    for (const auto& [field, edit] : edits) {
+        Config edited = base;
+        edit(edited);
+        Expect(DiffConfigSections(base, edited) == ConfigSectionBit(ConfigSection::General),
+               std::string("Editing Config::") + field + " should only change the general section.");
+    }
+}
+
+void RunConfigDiffPublishBumpsChangedSectionsTest(TestRunMode runMode = TestRunMode::Automated) {
+    DummyWindow window(kWindowWidth, kWindowHeight, runMode == TestRunMode::Visual);
+    const std::filesystem::path root = PrepareCaseDirectory("config_diff_publish_bumps_changed_sections");
+    ResetGlobalTestState(root);
+
+    Config config = LoadEmbeddedDefaultsForDiffTest();
+    if (config.mirrors.empty()) { return; }
+    PublishConfigSnapshot(config);
+
+    auto versions = []() {
+        std::array<uint64_t, kConfigSectionCount> out{};
+        for (size_t i = 0; i < kConfigSectionCount; ++i) { out[i] = GetConfigSectionVersion(static_cast<ConfigSection>(i)); }
+        return out;
+    };
+
+    const auto beforeUnchanged = versions();
+    PublishConfigSnapshot(config);
+    Expect(versions() == beforeUnchanged, "Republishing an identical config should not bump any section version.");
+
+    const uint64_t mirrorSectionsBefore = GetConfigSectionsVersion(ConfigSectionBit(ConfigSection::Mirrors) |
+                                                                   ConfigSectionBit(ConfigSection::Modes));
+    config.mirrors[0].opacity *= 0.5f;
+    PublishConfigSnapshot(config);
+    const auto afterMirrorEdit = versions();
+    for (size_t i = 0; i < kConfigSectionCount; ++i) {
+        const bool isMirrors = static_cast<ConfigSection>(i) == ConfigSection::Mirrors;
+        Expect(afterMirrorEdit[i] == beforeUnchanged[i] + (isMirrors ? 1 : 0),
+               "A mirror edit should bump the mirrors section version and leave section " + std::to_string(i) + " alone.");
+    }
+    Expect(GetConfigSectionsVersion(ConfigSectionBit(ConfigSection::Mirrors) | ConfigSectionBit(ConfigSection::Modes)) ==
+               mirrorSectionsBefore + 1,
+           "The combined version of a section mask should move when one of its sections changes.");
+}
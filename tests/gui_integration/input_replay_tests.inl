@@ -0,0 +1,134 @@
+struct ReplayedInputOutput {
+    std::vector<CapturedWindowMessage> forwardedMessages;
+    std::vector<std::pair<UINT, bool>> syntheticKeyEvents;
+};
+
+// Feeds a trace's window messages straight into SubclassedWndProc, the way the game's message loop delivered them
+// (the recorded stream already holds the WM_CHARs its TranslateMessage produced). Raw mouse packets are handled by
+// the raw input hook, not the chain, so they are skipped here.
+static ReplayedInputOutput ReplayInputTrace(HWND hwnd, ScopedSubclassedInputCapture& capture, const std::vector<InputTraceEvent>& events) {
+    capture.Clear();
+    ResetSyntheticRebindKeyEventsForTest();
+    for (const InputTraceEvent& event : events) {
+        if (event.kind != InputTraceEventKind::WindowMessage) { continue; }
+        (void)SubclassedWndProc(hwnd, event.message, static_cast<WPARAM>(event.wParam), static_cast<LPARAM>(event.lParam));
+    }
+
+    ReplayedInputOutput output;
+    output.forwardedMessages = capture.messages;
+    for (size_t i = 0; i < GetSyntheticRebindKeyEventCountForTest(); ++i) {
+        UINT scanCodeWithFlags = 0;
+        bool keyDown = false;
+        (void)GetSyntheticRebindKeyEventForTest(i, scanCodeWithFlags, keyDown);
+        output.syntheticKeyEvents.emplace_back(scanCodeWithFlags, keyDown);
+    }
+    return output;
+}
+
+static void ExpectSameReplayOutput(const ReplayedInputOutput& expected, const ReplayedInputOutput& actual, const std::string& label) {
+    Expect(actual.forwardedMessages.size() == expected.forwardedMessages.size(),
+           label + " forwarded " + std::to_string(actual.forwardedMessages.size()) + " messages, expected " +
+               std::to_string(expected.forwardedMessages.size()) + ".");
+    for (size_t i = 0; i < (std::min)(actual.forwardedMessages.size(), expected.forwardedMessages.size()); ++i) {
+        const CapturedWindowMessage& a = actual.forwardedMessages[i];
+        const CapturedWindowMessage& e = expected.forwardedMessages[i];
+        Expect(a.message == e.message && a.wParam == e.wParam && a.lParam == e.lParam,
+               label + " forwarded message " + std::to_string(i) + " differs from the recorded run.");
+    }
+    Expect(actual.syntheticKeyEvents == expected.syntheticKeyEvents, label + " synthetic rebind key events differ from the recorded run.");
+}
+
+void RunKeyRebindReplayRecordedTraceTest(TestRunMode runMode = TestRunMode::Automated) {
+    DummyWindow window(kWindowWidth, kWindowHeight, runMode == TestRunMode::Visual);
+    KeyRebind fullRebind = MakeEnabledRebind('A', 'B');
+    fullRebind.useCustomOutput = true;
+    fullRebind.customOutputVK = 'B';
+    PrepareRebindRuntimeCase("key_rebind_replay_recorded_trace", { fullRebind, MakeEnabledRebind('N', VK_LSHIFT) });
+    ScopedSubclassedInputCapture capture(window.hwnd());
+
+    ScopedKeyboardStateOverride keyboardState;
+    keyboardState.SetKeyDown(VK_SHIFT, false);
+    keyboardState.SetToggle(VK_CAPITAL, false);
+    keyboardState.Apply();
+
+    // A short session as the game window sees it: a rebound key with its character, a key rebound to a modifier
+    // (emitted as a synthetic key), an unrebound key and mouse traffic in between.
+    auto message = [](UINT msg, WPARAM wParam, LPARAM lParam) {
+        InputTraceEvent event;
+        event.message = msg;
+        event.wParam = static_cast<uint64_t>(wParam);
+        event.lParam = static_cast<int64_t>(lParam);
+        return event;
+    };
+    const std::vector<InputTraceEvent> script = {
+        message(WM_KEYDOWN, 'A', BuildTestKeyboardMessageLParam('A', true)),
+        message(WM_CHAR, 'a', BuildTestKeyboardMessageLParam('A', true)),
+        message(WM_MOUSEMOVE, 0, MAKELPARAM(40, 60)),
+        message(WM_KEYUP, 'A', BuildTestKeyboardMessageLParam('A', false)),
+        message(WM_KEYDOWN, 'N', BuildTestKeyboardMessageLParam('N', true)),
+        message(WM_MOUSEMOVE, 0, MAKELPARAM(41, 61)),
+        message(WM_KEYUP, 'N', BuildTestKeyboardMessageLParam('N', false)),
+        message(WM_KEYDOWN, 'C', BuildTestKeyboardMessageLParam('C', true)),
+        message(WM_CHAR, 'c', BuildTestKeyboardMessageLParam('C', true)),
+        message(WM_KEYUP, 'C', BuildTestKeyboardMessageLParam('C', false)),
+        message(WM_LBUTTONDOWN, MK_LBUTTON, MAKELPARAM(41, 61)),
+        message(WM_LBUTTONUP, 0, MAKELPARAM(41, 61)),
+    };
+
+    StartInputTraceRecording();
+    const ReplayedInputOutput live = ReplayInputTrace(window.hwnd(), capture, script);
+    const std::vector<InputTraceEvent> recorded = StopInputTraceRecording();
+
+    Expect(recorded.size() == script.size(), "Expected the recorder to capture every delivered message, got " +
+                                                 std::to_string(recorded.size()) + " of " + std::to_string(script.size()) + ".");
+    for (size_t i = 0; i < (std::min)(recorded.size(), script.size()); ++i) {
+        InputTraceEvent expected = script[i];
+        expected.timestampUs = recorded[i].timestampUs;
+        Expect(recorded[i] == expected, "Recorded event " + std::to_string(i) + " should match the delivered message.");
+        if (i > 0) { Expect(recorded[i].timestampUs >= recorded[i - 1].timestampUs, "Recorded timestamps should not decrease."); }
+    }
+
+    const auto forwardedKeyDown = [&live](WPARAM vk) {
+        return std::any_of(live.forwardedMessages.begin(), live.forwardedMessages.end(),
+                           [vk](const CapturedWindowMessage& m) { return m.message == WM_KEYDOWN && m.wParam == vk; });
+    };
+    Expect(forwardedKeyDown('B') && !forwardedKeyDown('A'), "Expected the recorded run to forward the A rebind as B.");
+    Expect(forwardedKeyDown('C'), "Expected the recorded run to forward the unrebound C key.");
+    const UINT lShiftScan = static_cast<UINT>(MapVirtualKeyW(VK_LSHIFT, MAPVK_VK_TO_VSC_EX));
+    const std::vector<std::pair<UINT, bool>> expectedSynthetic = { { lShiftScan, true }, { lShiftScan, false } };
+    Expect(live.syntheticKeyEvents == expectedSynthetic, "Expected the N rebind to emit an LShift press and release.");
+
+    const std::filesystem::path tracePath = PrepareCaseDirectory("key_rebind_replay_recorded_trace_file") / "input-trace.bin";
+    Expect(SaveInputTraceFile(tracePath, recorded), "Expected the recorded trace to save.");
+    std::vector<InputTraceEvent> loaded;
+    Expect(LoadInputTraceFile(tracePath, loaded), "Expected the saved trace to load.");
+    Expect(loaded == recorded, "Expected the loaded trace to equal the recorded one.");
+
+    // Replays the loaded trace repeatedly so the per-stage timings have enough samples to be worth printing.
+    constexpr int kReplayPasses = 200;
+    ResetInputStageTimings();
+    SetInputStageTimingEnabled(true);
+    for (int pass = 0; pass < kReplayPasses; ++pass) {
+        ExpectSameReplayOutput(live, ReplayInputTrace(window.hwnd(), capture, loaded), "Replay pass " + std::to_string(pass));
+    }
+    SetInputStageTimingEnabled(false);
+
+    const std::vector<InputStageStats> stages = GetInputStageTimings();
+    ResetInputStageTimings();
+    const auto findStage = [&stages](std::string_view name) -> const InputStageStats* {
+        for (const InputStageStats& stage : stages) {
+            if (stage.name == name) { return &stage; }
+        }
+        return nullptr;
+    };
+    Expect(!stages.empty() && stages.front().name == "ShiftHotkeyPolling", "Expected stage timings to start with the first stage of the chain.");
+    // Rebinds send their output back through the window procedure, so the chain can run more than once per message.
+    Expect(!stages.empty() && stages.front().calls >= static_cast<uint64_t>(kReplayPasses) * loaded.size(),
+           "Expected the first stage to run at least once per replayed message.");
+    const InputStageStats* keyRebinding = findStage("KeyRebinding");
+    Expect(keyRebinding != nullptr && keyRebinding->consumed > 0, "Expected the KeyRebinding stage to consume rebound keys.");
+    Expect(findStage("Hotkeys") != nullptr, "Expected the Hotkeys stage to be timed for key and button messages.");
+    Expect(findStage("ForwardToGame") != nullptr, "Expected forwarding to the game to be timed.");
+
+    std::cout << "Input replay: " << kReplayPasses << " passes of " << loaded.size() << " messages\n" << FormatInputStageReport(stages);
+}
@@ -38,7 +38,7 @@ void RunModeMirrorRenderScreenAnchorsTest(TestRunMode runMode = TestRunMode::Aut
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays);
 
             Expect(activeMirrors.size() == 4, "Expected all direct mirror sources to resolve for the screen-anchor test.");
@@ -135,7 +135,7 @@ void RunModeMirrorRenderViewportAnchorsTest(TestRunMode runMode = TestRunMode::A
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays);
 
             Expect(activeMirrors.size() == 2, "Expected both viewport-relative mirrors to resolve for the viewport-anchor test.");
@@ -250,7 +250,7 @@ void RunModeMirrorRenderScreenAnchorSizeMatrixTest(TestRunMode runMode = TestRun
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays);
 
             Expect(activeMirrors.size() == scenario.mirrors.size(),
@@ -372,7 +372,7 @@ void RunModeMirrorRenderViewportAnchorSizeMatrixTest(TestRunMode runMode = TestR
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays);
 
             Expect(activeMirrors.size() == scenario.mirrors.size(),
@@ -462,7 +462,7 @@ void RunModeMirrorRenderRawOutputDynamicBorderSizeTest(TestRunMode runMode = Tes
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays, geometry.fullW, geometry.fullH);
 
             Expect(activeMirrors.size() == 1,
@@ -555,7 +555,7 @@ void RunModeMirrorRenderLowAlphaVisibilityTest(TestRunMode runMode = TestRunMode
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays, geometry.fullW, geometry.fullH);
 
             Expect(activeMirrors.size() == 2,
@@ -655,7 +655,7 @@ void RunModeMirrorGroupRenderTest(TestRunMode runMode = TestRunMode::Automated)
             std::vector<ImageConfig> unusedImages;
             std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
             std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-            CollectActiveElementsForMode(g_config, kModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+            CollectActiveElementsForMode(g_config, kModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                                          unusedBrowserOverlays);
 
             Expect(activeMirrors.size() == 1, "Expected only enabled group mirrors to resolve for the mirror-group render test.");
@@ -694,6 +694,113 @@ void RunModeMirrorGroupRenderTest(TestRunMode runMode = TestRunMode::Automated)
     CleanupShaders();
 }
 
+void RunModeRenderPlanSteadyStateAllocationsTest(TestRunMode runMode = TestRunMode::Automated) {
+    DummyWindow window(kWindowWidth, kWindowHeight, runMode == TestRunMode::Visual);
+    if (!g_hasModernGL) { std::cout << "SKIP (no GL 3.3+)" << std::endl; return; }
+
+    const std::filesystem::path root = PrepareCaseDirectory("mode_render_plan_steady_state_allocations");
+    ResetGlobalTestState(root);
+
+    // Short ids keep the per-call request strings inside the small-string buffer.
+    constexpr char kModeId[] = "Plan Mode";
+    constexpr char kGroupName[] = "Plan Group";
+    constexpr int kWarmupFrames = 3;
+    constexpr int kMeasuredFrames = 30;
+
+    MirrorConfig directMirror = MakeMirrorRenderTestConfig("Direct", 18, 12, "topLeftScreen", 30, 40, 4.0f);
+    MirrorConfig groupedMirror = MakeMirrorRenderTestConfig("Grouped", 16, 16, "topLeftScreen", 0, 0, 4.0f);
+
+    MirrorGroupConfig group;
+    group.name = kGroupName;
+    group.output.x = 300;
+    group.output.y = 220;
+    group.output.relativeTo = "topLeftScreen";
+    group.mirrors = { { groupedMirror.name, true, 1.0f, 1.0f, 0, 0 } };
+
+    ModeConfig mode;
+    mode.id = kModeId;
+    mode.width = kWindowWidth;
+    mode.height = kWindowHeight;
+    mode.manualWidth = kWindowWidth;
+    mode.manualHeight = kWindowHeight;
+    mode.sources = { { ModeSourceType::Mirror, directMirror.name }, { ModeSourceType::MirrorGroup, kGroupName } };
+
+    g_config.defaultMode = kModeId;
+    g_config.mirrors = { directMirror, groupedMirror };
+    g_config.mirrorGroups = { group };
+    g_config.modes = { mode };
+    g_configLoaded.store(true, std::memory_order_release);
+
+    // Render plans are cached per published snapshot; an unpublished Config recompiles on every frame.
+    PublishConfigSnapshot();
+    const std::shared_ptr<const Config> publishedConfig = GetConfigSnapshot();
+    Expect(publishedConfig != nullptr, "Expected the mode render plan test to publish a config snapshot.");
+
+    InitializeMirrorRenderTestResources();
+
+    const SurfaceSize surface = GetWindowClientSize(window.hwnd());
+    ScopedTexture2D sourceTexture(surface.width, surface.height, MakeSolidRgbaPixels(surface.width, surface.height, 0, 255, 0));
+
+    auto renderFrame = [&](DummyWindow& targetWindow) {
+        return RenderModeOverlayFrame(targetWindow, *publishedConfig, publishedConfig->modes.front(), sourceTexture.id());
+    };
+
+    auto renderAndAssert = [&](DummyWindow& targetWindow) {
+        for (int frame = 0; frame < kWarmupFrames; ++frame) { renderFrame(targetWindow); }
+        if (runMode != TestRunMode::Automated) { return; }
+
+        Expect(targetWindow.PrepareRenderSurface(), "GUI integration test window closed unexpectedly.");
+        GLState state{};
+        SaveGLState(&state);
+        const int surfaceWidth = (std::max)(1, GetCachedWindowWidth());
+        const int surfaceHeight = (std::max)(1, GetCachedWindowHeight());
+        const ModeConfig& modeToRender = publishedConfig->modes.front();
+        const uint64_t compilesBefore = GetModeRenderPlanCompileCountForIntegrationTest();
+
+        uint64_t steadyStateAllocations = 0;
+        bool allFramesRendered = true;
+        {
+            ScopedAllocationCounter allocations;
+            for (int frame = 0; frame < kMeasuredFrames; ++frame) {
+                allFramesRendered = RenderModeOverlaysForIntegrationTest(*publishedConfig, modeToRender, state, surfaceWidth, surfaceHeight,
+                                                                         0, 0, surfaceWidth, surfaceHeight, false,
+                                                                         sourceTexture.id()) &&
+                                    allFramesRendered;
+            }
+            steadyStateAllocations = allocations.count();
+        }
+
+        Expect(allFramesRendered, "Expected every measured frame to produce mirror output.");
+        Expect(GetModeRenderPlanCompileCountForIntegrationTest() == compilesBefore,
+               "Expected steady-state frames to reuse the compiled mode render plan.");
+        Expect(steadyStateAllocations == 0, "Expected steady-state mode overlay frames to make no heap allocations, saw " +
+                                                std::to_string(steadyStateAllocations) + " over " +
+                                                std::to_string(kMeasuredFrames) + " frames.");
+
+        InvalidateConfigLookupCaches();
+        renderFrame(targetWindow);
+        Expect(GetModeRenderPlanCompileCountForIntegrationTest() > compilesBefore,
+               "Expected invalidating the config lookup caches to recompile the mode render plan.");
+
+        ExpectSolidColorRect(GetCachedMirrorRect(directMirror.name), surface.height, kExpectedMirrorRenderGreen,
+                             "Expected the direct mirror to keep rendering from the compiled plan.");
+        ExpectSolidColorRect(GetCachedMirrorRect(groupedMirror.name), surface.height, kExpectedMirrorRenderGreen,
+                             "Expected the grouped mirror to keep rendering from the compiled plan.");
+    };
+
+    if (runMode == TestRunMode::Visual) {
+        RunVisualLoop(window, "mode-render-plan-steady-state-allocations",
+                      [&](DummyWindow& visualWindow) { renderAndAssert(visualWindow); });
+    } else {
+        renderAndAssert(window);
+    }
+
+    CleanupBrowserOverlayCache();
+    CleanupWindowOverlayCache();
+    CleanupGPUResources();
+    CleanupShaders();
+}
+
 void RunModeMirrorGroupRelativePositionResolutionTest(TestRunMode runMode = TestRunMode::Automated) {
     (void)runMode;
 
@@ -735,14 +842,14 @@ void RunModeMirrorGroupRelativePositionResolutionTest(TestRunMode runMode = Test
     std::vector<ImageConfig> unusedSourceImages;
     std::vector<const WindowOverlayConfig*> unusedSourceWindowOverlays;
     std::vector<const BrowserOverlayConfig*> unusedSourceBrowserOverlays;
-    CollectActiveElementsForMode(g_config, kModeId, false, 0, sourceMirrors, unusedSourceImages, unusedSourceWindowOverlays,
+    CollectActiveElementsForMode(g_config, kModeId, false, sourceMirrors, unusedSourceImages, unusedSourceWindowOverlays,
                                  unusedSourceBrowserOverlays, 200, 100);
 
     std::vector<MirrorConfig> targetMirrors;
     std::vector<ImageConfig> unusedTargetImages;
     std::vector<const WindowOverlayConfig*> unusedTargetWindowOverlays;
     std::vector<const BrowserOverlayConfig*> unusedTargetBrowserOverlays;
-    CollectActiveElementsForMode(g_config, kModeId, false, 0, targetMirrors, unusedTargetImages, unusedTargetWindowOverlays,
+    CollectActiveElementsForMode(g_config, kModeId, false, targetMirrors, unusedTargetImages, unusedTargetWindowOverlays,
                                  unusedTargetBrowserOverlays, 400, 200);
 
     Expect(sourceMirrors.size() == 1,
@@ -910,7 +1017,7 @@ void RunModeMirrorGroupRelativePositionResolutionTest(TestRunMode runMode = Test
              std::vector<ImageConfig> unusedImages;
              std::vector<const WindowOverlayConfig*> unusedWindowOverlays;
              std::vector<const BrowserOverlayConfig*> unusedBrowserOverlays;
-             CollectActiveElementsForMode(g_config, kTargetModeId, false, 0, activeMirrors, unusedImages, unusedWindowOverlays,
+             CollectActiveElementsForMode(g_config, kTargetModeId, false, activeMirrors, unusedImages, unusedWindowOverlays,
                               unusedBrowserOverlays, surface.width, surface.height);
 
              Expect(activeMirrors.size() == 2,
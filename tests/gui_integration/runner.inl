@@ -91,6 +91,9 @@ const auto& GetTestCaseDefinitions() {
         {"config-load-key-rebind-shift-layer-caps-lock-defaulted", &RunConfigLoadKeyRebindShiftLayerCapsLockDefaultedTest},
         {"config-load-key-rebind-cursor-state-defaulted", &RunConfigLoadKeyRebindCursorStateDefaultedTest},
         {"config-publish-key-rebind-cannot-type-clears-typed-output", &RunConfigPublishKeyRebindCannotTypeClearsTypedOutputTest},
+        {"config-diff-embedded-defaults-mutations", &RunConfigDiffEmbeddedDefaultsMutationsTest},
+        {"config-diff-general-fields", &RunConfigDiffGeneralFieldsTest},
+        {"config-diff-publish-bumps-changed-sections", &RunConfigDiffPublishBumpsChangedSectionsTest},
         {"hotkey-runtime-specific-shift-release-matches-exact-keyup", &RunHotkeyRuntimeSpecificShiftReleaseMatchesExactKeyupTest},
         {"hotkey-runtime-exclusion-detects-low-level-suppressed-key", &RunHotkeyRuntimeExclusionDetectsLowLevelSuppressedKeyTest},
         {"hotkey-runtime-exclusion-detects-suppressed-ctrl-shift", &RunHotkeyRuntimeExclusionDetectsSuppressedCtrlShiftTest},
@@ -125,6 +128,7 @@ const auto& GetTestCaseDefinitions() {
         {"key-rebind-runtime-held-output-released-on-modifier-output-up", &RunKeyRebindRuntimeHeldOutputReleasedOnModifierOutputUpTest},
         {"key-rebind-runtime-held-output-released-on-gui-open", &RunKeyRebindRuntimeHeldOutputReleasedOnGuiOpenTest},
         {"key-rebind-runtime-cursor-state-priority-and-fallback", &RunKeyRebindRuntimeCursorStatePriorityAndFallbackTest},
+        {"key-rebind-replay-recorded-trace", &RunKeyRebindReplayRecordedTraceTest},
         {"key-rebind-gui-keyboard-layout-full-bind-and-trigger", &RunKeyRebindGuiKeyboardLayoutFullBindAndTriggerTest},
         {"key-rebind-gui-keyboard-layout-split-bind-and-trigger", &RunKeyRebindGuiKeyboardLayoutSplitBindAndTriggerTest},
         {"key-rebind-gui-text-override-pick-rejects-non-typable-key", &RunKeyRebindGuiTextOverridePickRejectsNonTypableKeyTest},
@@ -169,6 +173,7 @@ const auto& GetTestCaseDefinitions() {
         {"mode-mirror-render-raw-output-dynamic-border-size", &RunModeMirrorRenderRawOutputDynamicBorderSizeTest},
         {"mode-mirror-render-low-alpha-visibility", &RunModeMirrorRenderLowAlphaVisibilityTest},
         {"mode-mirror-group-render", &RunModeMirrorGroupRenderTest},
+        {"mode-render-plan-steady-state-allocations", &RunModeRenderPlanSteadyStateAllocationsTest},
         {"mode-mirror-group-relative-position-resolution", &RunModeMirrorGroupRelativePositionResolutionTest},
         {"mode-mirror-group-slide-unit-transition", &RunModeMirrorGroupSlideUnitTransitionTest},
         {"mode-window-overlay-render", &RunModeWindowOverlayRenderTest},
@@ -229,6 +234,7 @@ const auto& GetTestCaseDefinitions() {
         {"profile-case-insensitive-collisions", &RunProfileCaseInsensitiveCollisionTest},
         {"profile-recover-missing-metadata", &RunProfileRecoverMissingMetadataTest},
         {"profile-async-save-skip-deleted-profile", &RunProfileAsyncSaveSkipDeletedProfileTest},
+        {"config-save-coalesces-and-skips-unchanged-writes", &RunConfigSaveCoalescesAndSkipsUnchangedWritesTest},
         {"profile-switch-ninjabrain-async-stop", &RunProfileSwitchNinjabrainAsyncStopTest},
         {"profile-switch-ninjabrain-async-restart", &RunProfileSwitchNinjabrainAsyncRestartTest},
         {"profile-switch-invalid-default-mode-fallback", &RunProfileSwitchInvalidDefaultModeFallbackTest},
@@ -1226,6 +1226,62 @@ void RunProfileAsyncSaveSkipDeletedProfileTest(TestRunMode runMode = TestRunMode
     Expect(g_profilesConfig.profiles[0].name == "Other", "The remaining profile should be the fallback profile.");
 }
 
+void RunConfigSaveCoalescesAndSkipsUnchangedWritesTest(TestRunMode runMode = TestRunMode::Automated) {
+    (void)runMode;
+    ResetProfileTestState("config_save_coalesces_and_skips_unchanged_writes");
+    Expect(WaitForConfigSaveIdle(3000), "Persistence worker should start idle.");
+
+    const std::filesystem::path configPath = std::filesystem::path(g_toolscreenPath) / "config.toml";
+    auto makeJob = [&configPath](int fpsLimit) {
+        ConfigSaveJob job;
+        job.configPath = configPath.wstring();
+        job.sharedSnapshot = g_config;
+        job.sharedSnapshot.fpsLimit = fpsLimit;
+        return job;
+    };
+
+    const ConfigPersistenceStats before = GetConfigPersistenceStats();
+    for (int fpsLimit = 61; fpsLimit <= 65; ++fpsLimit) { QueueConfigSave(makeJob(fpsLimit)); }
+    Expect(WaitForConfigSaveIdle(3000), "Queued saves should finish within the timeout.");
+
+    const ConfigPersistenceStats afterBurst = GetConfigPersistenceStats();
+    Expect(afterBurst.savesRequested - before.savesRequested == 5, "Every queued save should be counted as requested.");
+    Expect(afterBurst.savesWritten - before.savesWritten < 5, "A burst of queued saves should be coalesced.");
+    Expect(afterBurst.savesCoalesced - before.savesCoalesced == 5 - (afterBurst.savesWritten - before.savesWritten),
+           "Every queued save should be either written or coalesced.");
+
+    const std::filesystem::path cachePath(GetConfigSnapshotCachePath(configPath.wstring()));
+    std::error_code cacheTimeError;
+    Expect(std::filesystem::exists(cachePath) &&
+               std::filesystem::last_write_time(cachePath, cacheTimeError) >= std::filesystem::last_write_time(configPath, cacheTimeError),
+           "Each written save should refresh the snapshot cache sidecar.");
+
+    Config onDisk;
+    Expect(LoadConfigFromTomlFile(configPath.wstring(), onDisk), "Saved config should be loadable.");
+    Expect(onDisk.fpsLimit == 65, "The latest queued save should win.");
+
+    std::error_code timeError;
+    const auto writeTimeBefore = std::filesystem::last_write_time(configPath, timeError);
+    QueueConfigSave(makeJob(65));
+    Expect(WaitForConfigSaveIdle(3000), "Unchanged save should finish within the timeout.");
+    const ConfigPersistenceStats afterUnchanged = GetConfigPersistenceStats();
+    Expect(afterUnchanged.filesUnchanged == afterBurst.filesUnchanged + 1, "Saving identical content should be skipped.");
+    Expect(afterUnchanged.filesWritten == afterBurst.filesWritten, "Saving identical content should not write the file.");
+    Expect(std::filesystem::last_write_time(configPath, timeError) == writeTimeBefore, "Skipped save should leave the file untouched.");
+
+    {
+        std::ofstream out(configPath, std::ios::binary | std::ios::app);
+        out << "\n# edited outside Toolscreen\n";
+    }
+    QueueConfigSave(makeJob(65));
+    Expect(WaitForConfigSaveIdle(3000), "Save after an external edit should finish within the timeout.");
+    Expect(GetConfigPersistenceStats().filesWritten == afterUnchanged.filesWritten + 1,
+           "A file edited outside Toolscreen should be rewritten even if the config is unchanged.");
+    std::ifstream in(configPath, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Expect(contents.find("edited outside Toolscreen") == std::string::npos, "The rewrite should replace the edited file.");
+}
+
 void RunProfileSwitchNinjabrainAsyncStopTest(TestRunMode runMode = TestRunMode::Automated) {
     (void)runMode;
     ResetProfileTestState("profile_switch_ninjabrain_async_stop");
@@ -4,7 +4,10 @@
 #include "common/mode_dimensions.h"
 #include "common/profiler.h"
 #include "common/utils.h"
+#include "config/config_diff.h"
 #include "config/config_migration.h"
+#include "config/config_persistence.h"
+#include "config/config_snapshot_cache.h"
 #include "config/config_toml.h"
 #include "features/browser_overlay.h"
 #include "features/ninjabrain_client.h"
@@ -23,13 +26,17 @@
 #include <Windows.h>
 
 #include <filesystem>
+#include <functional>
 #include <fstream>
 #include <iostream>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <cmath>
+#include <cstdlib>
+#include <new>
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <string>
 #include <string_view>
@@ -44,6 +51,23 @@ extern FILTERKEYS g_originalFilterKeys;
 extern std::atomic<bool> g_originalFilterKeysCaptured;
 bool GetEffectiveKeyRepeatTimings(int& outStartDelayMs, int& outRepeatDelayMs);
 
+// operator new calls made by the current thread while counting is enabled, so render-path cases can
+// assert that steady-state frames stay off the heap without seeing allocations from worker threads.
+namespace {
+thread_local bool t_countAllocations = false;
+thread_local uint64_t t_allocationCount = 0;
+} // namespace
+
+void* operator new(size_t size) {
+    if (t_countAllocations) { ++t_allocationCount; }
+    if (void* block = std::malloc(size == 0 ? 1 : size)) { return block; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 namespace {
 
 constexpr int kWindowWidth = 1600;
@@ -1380,6 +1404,20 @@ bool RenderModeOverlayFrame(DummyWindow& window, const Config& config, const Mod
     return rendered;
 }
 
+class ScopedAllocationCounter {
+public:
+    ScopedAllocationCounter() {
+        t_allocationCount = 0;
+        t_countAllocations = true;
+    }
+    ~ScopedAllocationCounter() { t_countAllocations = false; }
+
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    uint64_t count() const { return t_allocationCount; }
+};
+
 template <typename AssertFn>
 void RenderModeOverlayFrameToSimulatedSurface(DummyWindow& window, const Config& config, const ModeConfig& mode,
                                               const SimulatedOverlayGeometry& geometry, GLuint gameTextureId,
@@ -1602,6 +1640,7 @@ void PopulateRichConfigFixture() {
     g_config.fontPath = "C:\\Windows\\Fonts\\consola.ttf";
     g_config.fpsLimit = 144;
     g_config.fpsLimitSleepThreshold = 7;
+    g_config.fpsLimitAlignToObsCapture = true;
     g_config.mirrorGammaMode = MirrorGammaMode::AssumeLinear;
     g_config.disableHookChaining = true;
     g_config.allowCursorEscape = true;
@@ -2045,6 +2084,7 @@ void VerifyRichGlobalSettings() {
     Expect(g_config.defaultMode == kPrimaryModeId, "Expected default mode to roundtrip.");
     Expect(g_config.fpsLimit == 144, "Expected fps limit to roundtrip.");
     Expect(g_config.fpsLimitSleepThreshold == 7, "Expected fps sleep threshold to roundtrip.");
+    Expect(g_config.fpsLimitAlignToObsCapture, "Expected fps limit OBS alignment to roundtrip.");
     Expect(g_config.mirrorGammaMode == MirrorGammaMode::AssumeLinear, "Expected mirror gamma mode to roundtrip.");
     Expect(g_config.disableHookChaining, "Expected disableHookChaining to roundtrip.");
     Expect(g_config.allowCursorEscape, "Expected allowCursorEscape to roundtrip.");
@@ -2554,6 +2594,7 @@ void RunVisualLoop(DummyWindow& window, std::string_view testCaseName, RenderFra
 // The suite is split across tests/gui_integration/*.inl so new coverage does not accumulate in one monolithic file.
 #include "gui_integration/config_tests.inl"
 #include "gui_integration/rebind_tests.inl"
+#include "gui_integration/input_replay_tests.inl"
 #include "gui_integration/render_tests.inl"
 #include "gui_integration/ui_and_log_tests.inl"
 #include "gui_integration/runner.inl"
@@ -0,0 +1,504 @@
+#include "common/gzip_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+// Minimal RFC 1951/1952 decoder used as the reference for round-trips.
+class Inflater {
+  public:
+    Inflater(const std::vector<uint8_t>& src, size_t offset) : m_src(src), m_pos(offset) {}
+
+    bool Inflate(std::vector<uint8_t>& out) {
+        bool final = false;
+        while (!final) {
+            final = Bits(1) != 0;
+            const uint32_t type = Bits(2);
+            if (m_error) return false;
+            if (type == 0) {
+                if (!Stored(out)) return false;
+            } else if (type == 1) {
+                uint8_t lengths[320];
+                for (int i = 0; i < 144; i++) lengths[i] = 8;
+                for (int i = 144; i < 256; i++) lengths[i] = 9;
+                for (int i = 256; i < 280; i++) lengths[i] = 7;
+                for (int i = 280; i < 288; i++) lengths[i] = 8;
+                for (int i = 0; i < 30; i++) lengths[288 + i] = 5;
+                Huffman litLen;
+                Huffman dist;
+                if (!litLen.Build(lengths, 288) || !dist.Build(lengths + 288, 30)) return false;
+                if (!Codes(litLen, dist, out)) return false;
+            } else if (type == 2) {
+                if (!Dynamic(out)) return false;
+            } else {
+                return false;
+            }
+        }
+        m_bitCount = 0;
+        return !m_error;
+    }
+
+    size_t Position() const { return m_pos; }
+
+  private:
+    struct Huffman {
+        uint16_t counts[16] = {};
+        uint16_t symbols[320] = {};
+
+        bool Build(const uint8_t* lengths, int n) {
+            std::fill(std::begin(counts), std::end(counts), static_cast<uint16_t>(0));
+            for (int i = 0; i < n; i++) counts[lengths[i]]++;
+            if (counts[0] == n) return true;
+            int left = 1;
+            for (int len = 1; len < 16; len++) {
+                left <<= 1;
+                left -= counts[len];
+                if (left < 0) return false;
+            }
+            uint16_t offs[16] = {};
+            for (int len = 1; len < 15; len++) offs[len + 1] = static_cast<uint16_t>(offs[len] + counts[len]);
+            for (int i = 0; i < n; i++) {
+                if (lengths[i] != 0) symbols[offs[lengths[i]]++] = static_cast<uint16_t>(i);
+            }
+            return true;
+        }
+    };
+
+    uint32_t Bits(int need) {
+        uint32_t value = m_bitBuffer;
+        while (m_bitCount < need) {
+            if (m_pos >= m_src.size()) {
+                m_error = true;
+                return 0;
+            }
+            value |= static_cast<uint32_t>(m_src[m_pos++]) << m_bitCount;
+            m_bitCount += 8;
+        }
+        m_bitBuffer = value >> need;
+        m_bitCount -= need;
+        return value & ((1u << need) - 1u);
+    }
+
+    int Decode(const Huffman& h) {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int len = 1; len < 16; len++) {
+            code |= static_cast<int>(Bits(1));
+            if (m_error) return -1;
+            const int count = h.counts[len];
+            if (code - count < first) return h.symbols[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    bool Stored(std::vector<uint8_t>& out) {
+        m_bitBuffer = 0;
+        m_bitCount = 0;
+        if (m_pos + 4 > m_src.size()) return false;
+        const uint32_t len = m_src[m_pos] | (m_src[m_pos + 1] << 8);
+        const uint32_t nlen = m_src[m_pos + 2] | (m_src[m_pos + 3] << 8);
+        m_pos += 4;
+        if (len != (~nlen & 0xFFFFu) || m_pos + len > m_src.size()) return false;
+        out.insert(out.end(), m_src.begin() + static_cast<std::ptrdiff_t>(m_pos), m_src.begin() + static_cast<std::ptrdiff_t>(m_pos + len));
+        m_pos += len;
+        return true;
+    }
+
+    bool Codes(const Huffman& litLen, const Huffman& dist, std::vector<uint8_t>& out) {
+        static const uint16_t kLenBase[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                               31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const uint8_t kLenExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const uint16_t kDistBase[30] = { 1,    2,    3,    4,    5,    7,     9,     13,    17,  25,   33,   49,   65,   97,   129,
+                                                193,  257,  385,  513,  769,  1025,  1537,  2049,  3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const uint8_t kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        for (;;) {
+            const int symbol = Decode(litLen);
+            if (symbol < 0) return false;
+            if (symbol < 256) {
+                out.push_back(static_cast<uint8_t>(symbol));
+                continue;
+            }
+            if (symbol == 256) return true;
+            const int lenIndex = symbol - 257;
+            if (lenIndex >= 29) return false;
+            const size_t length = kLenBase[lenIndex] + Bits(kLenExtra[lenIndex]);
+            const int distSymbol = Decode(dist);
+            if (distSymbol < 0 || distSymbol >= 30) return false;
+            const size_t distance = kDistBase[distSymbol] + Bits(kDistExtra[distSymbol]);
+            if (m_error || distance > out.size()) return false;
+            const size_t from = out.size() - distance;
+            for (size_t i = 0; i < length; i++) out.push_back(out[from + i]);
+        }
+    }
+
+    bool Dynamic(std::vector<uint8_t>& out) {
+        static const uint8_t kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+        const int nlen = static_cast<int>(Bits(5)) + 257;
+        const int ndist = static_cast<int>(Bits(5)) + 1;
+        const int ncode = static_cast<int>(Bits(4)) + 4;
+        if (m_error || nlen > 286 || ndist > 30) return false;
+
+        uint8_t lengths[320] = {};
+        for (int i = 0; i < ncode; i++) lengths[kOrder[i]] = static_cast<uint8_t>(Bits(3));
+        Huffman lencode;
+        if (!lencode.Build(lengths, 19)) return false;
+
+        int index = 0;
+        while (index < nlen + ndist) {
+            int symbol = Decode(lencode);
+            if (symbol < 0) return false;
+            if (symbol < 16) {
+                lengths[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+            uint8_t len = 0;
+            int repeat = 0;
+            if (symbol == 16) {
+                if (index == 0) return false;
+                len = lengths[index - 1];
+                repeat = 3 + static_cast<int>(Bits(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(Bits(3));
+            } else {
+                repeat = 11 + static_cast<int>(Bits(7));
+            }
+            if (index + repeat > nlen + ndist) return false;
+            while (repeat-- > 0) lengths[index++] = len;
+        }
+        if (lengths[256] == 0) return false;
+
+        Huffman litLen;
+        Huffman dist;
+        if (!litLen.Build(lengths, nlen) || !dist.Build(lengths + nlen, ndist)) return false;
+        return Codes(litLen, dist, out);
+    }
+
+    const std::vector<uint8_t>& m_src;
+    size_t m_pos = 0;
+    uint32_t m_bitBuffer = 0;
+    int m_bitCount = 0;
+    bool m_error = false;
+};
+
+uint32_t ReadLE32(const std::vector<uint8_t>& data, size_t offset) {
+    return static_cast<uint32_t>(data[offset]) | (static_cast<uint32_t>(data[offset + 1]) << 8) |
+           (static_cast<uint32_t>(data[offset + 2]) << 16) | (static_cast<uint32_t>(data[offset + 3]) << 24);
+}
+
+// Decodes every concatenated member, verifying each member's CRC32 and ISIZE.
+bool GunzipAll(const std::vector<uint8_t>& gz, std::vector<uint8_t>& out, int* outMembers = nullptr) {
+    out.clear();
+    size_t pos = 0;
+    int members = 0;
+    while (pos < gz.size()) {
+        if (gz.size() - pos < 18 || gz[pos] != 0x1F || gz[pos + 1] != 0x8B || gz[pos + 2] != 0x08 || gz[pos + 3] != 0) return false;
+        std::vector<uint8_t> member;
+        Inflater inflater(gz, pos + 10);
+        if (!inflater.Inflate(member)) return false;
+        pos = inflater.Position();
+        if (pos + 8 > gz.size()) return false;
+        if (ReadLE32(gz, pos) != gzip_writer::Crc32(member.data(), member.size())) return false;
+        if (ReadLE32(gz, pos + 4) != static_cast<uint32_t>(member.size())) return false;
+        pos += 8;
+        out.insert(out.end(), member.begin(), member.end());
+        ++members;
+    }
+    if (outMembers) *outMembers = members;
+    return members > 0;
+}
+
+std::vector<uint8_t> CompressWithStream(const std::vector<uint8_t>& input, const gzip_writer::GzipOptions& options) {
+    std::vector<uint8_t> out;
+    size_t offset = 0;
+    const bool ok = gzip_writer::CompressStream(
+        [&](uint8_t* dst, size_t capacity, size_t& outRead) {
+            // Short reads exercise the chunk refill loop.
+            outRead = (std::min)((std::min)(capacity, input.size() - offset), static_cast<size_t>(70000));
+            if (outRead > 0) std::memcpy(dst, input.data() + offset, outRead);
+            offset += outRead;
+            return true;
+        },
+        [&](const uint8_t* data, size_t size) {
+            out.insert(out.end(), data, data + size);
+            return true;
+        },
+        options);
+    Check(ok, "CompressStream succeeds");
+    return out;
+}
+
+std::vector<uint8_t> MakeLogText(size_t bytes, uint32_t seed) {
+    static const char* kMessages[] = {
+        "[Performance] frame time 6.94ms (gpu 3.12ms)",
+        "[TextureOps] glBindTexture target=0x0DE1 id=",
+        "[WindowOverlay] captured frame for overlay 'ninb' ",
+        "Switching mode from Fullscreen to Thin",
+        "[Hotkey] matched binding F1 -> toggle EyeZoom",
+    };
+    std::mt19937 rng(seed);
+    std::string text;
+    text.reserve(bytes + 128);
+    int seconds = 0;
+    while (text.size() < bytes) {
+        seconds += static_cast<int>(rng() % 3);
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "[%02d:%02d:%02d.%03u] ", (seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60,
+                      static_cast<unsigned>(rng() % 1000));
+        text += stamp;
+        text += kMessages[rng() % std::size(kMessages)];
+        text += std::to_string(rng() % 4096);
+        text += "\n";
+    }
+    text.resize(bytes);
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::vector<uint8_t> MakeRandomBytes(size_t bytes, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(bytes);
+    for (uint8_t& b : data) b = static_cast<uint8_t>(rng());
+    return data;
+}
+
+void CheckRoundTrip(const std::vector<uint8_t>& input, const gzip_writer::GzipOptions& options, const std::string& label) {
+    std::vector<uint8_t> gz = CompressWithStream(input, options);
+    std::vector<uint8_t> decoded;
+    Check(GunzipAll(gz, decoded), label + ": output decodes");
+    Check(decoded == input, label + ": round-trip matches input");
+}
+
+void Crc32MatchesKnownVectors() {
+    const char* check = "123456789";
+    Check(gzip_writer::Crc32(reinterpret_cast<const uint8_t*>(check), 9) == 0xCBF43926u, "crc32 check value");
+    Check(gzip_writer::Crc32(nullptr, 0) == 0u, "crc32 of empty input");
+
+    std::vector<uint8_t> data = MakeRandomBytes(1000, 7);
+    const uint32_t whole = gzip_writer::Crc32(data.data(), data.size());
+    const uint32_t split = gzip_writer::Crc32(data.data() + 333, data.size() - 333, gzip_writer::Crc32(data.data(), 333));
+    Check(whole == split, "crc32 continues across calls");
+}
+
+void EmptyInputRoundTrips() {
+    gzip_writer::GzipOptions options;
+    options.workerThreads = 1;
+    CheckRoundTrip({}, options, "empty single-thread");
+    options.workerThreads = 3;
+    CheckRoundTrip({}, options, "empty multi-thread");
+}
+
+void SmallTextRoundTrips() {
+    const std::string text = "hello hello hello, toolscreen log archive";
+    gzip_writer::GzipOptions options;
+    options.workerThreads = 1;
+    CheckRoundTrip(std::vector<uint8_t>(text.begin(), text.end()), options, "small text");
+    CheckRoundTrip(std::vector<uint8_t>{ 'x' }, options, "single byte");
+    CheckRoundTrip(std::vector<uint8_t>{ 'a', 'b' }, options, "two bytes");
+}
+
+void LogTextCompressesWithDynamicBlocks() {
+    std::vector<uint8_t> input = MakeLogText(600 * 1024, 1);
+    gzip_writer::GzipOptions options;
+    options.workerThreads = 1;
+    std::vector<uint8_t> gz = CompressWithStream(input, options);
+    std::vector<uint8_t> decoded;
+    Check(GunzipAll(gz, decoded), "log text decodes");
+    Check(decoded == input, "log text round-trips");
+    Check(gz.size() * 4 < input.size(), "log text compresses at least 4:1");
+    Check(gz.size() > 10 && ((gz[10] >> 1) & 0x3) == 2, "first block uses dynamic Huffman codes");
+}
+
+void RandomBytesRoundTrip() {
+    std::vector<uint8_t> input = MakeRandomBytes(300 * 1024, 2);
+    gzip_writer::GzipOptions options;
+    options.workerThreads = 1;
+    std::vector<uint8_t> gz = CompressWithStream(input, options);
+    std::vector<uint8_t> decoded;
+    Check(GunzipAll(gz, decoded), "random bytes decode");
+    Check(decoded == input, "random bytes round-trip");
+    Check(gz.size() < input.size() + input.size() / 100 + 64, "incompressible input falls back to stored blocks");
+}
+
+void LongRunsRoundTrip() {
+    std::vector<uint8_t> input(200000, 'a');
+    for (size_t i = 50000; i < 60000; i++) input[i] = static_cast<uint8_t>(i % 7);
+    gzip_writer::GzipOptions options;
+    options.workerThreads = 1;
+    CheckRoundTrip(input, options, "long runs");
+
+    std::vector<uint8_t> periodic(100000);
+    for (size_t i = 0; i < periodic.size(); i++) periodic[i] = static_cast<uint8_t>((i * 31) % 32749 % 251);
+    CheckRoundTrip(periodic, options, "far matches");
+}
+
+void MultiMemberStreamRoundTrips() {
+    std::vector<uint8_t> input = MakeLogText(1024 * 1024 + 12345, 3);
+    gzip_writer::GzipOptions options;
+    options.chunkBytes = 128 * 1024;
+    options.workerThreads = 3;
+    std::vector<uint8_t> gz = CompressWithStream(input, options);
+    std::vector<uint8_t> decoded;
+    int members = 0;
+    Check(GunzipAll(gz, decoded, &members), "multi-member output decodes");
+    Check(decoded == input, "multi-member output round-trips in order");
+    Check(members == 9, "one member per chunk, got " + std::to_string(members));
+}
+
+void WorkerCountsProduceIdenticalOutput() {
+    std::vector<uint8_t> input = MakeLogText(700 * 1024, 4);
+    gzip_writer::GzipOptions options;
+    options.chunkBytes = 100 * 1024;
+    options.workerThreads = 1;
+    const std::vector<uint8_t> single = CompressWithStream(input, options);
+    options.workerThreads = 4;
+    const std::vector<uint8_t> pooled = CompressWithStream(input, options);
+    Check(single == pooled, "worker pool output is byte-identical to inline output");
+}
+
+void ReadAndWriteFailuresPropagate() {
+    std::vector<uint8_t> input = MakeLogText(300 * 1024, 5);
+    for (int workers : { 1, 3 }) {
+        gzip_writer::GzipOptions options;
+        options.chunkBytes = 64 * 1024;
+        options.workerThreads = workers;
+        size_t offset = 0;
+        const bool readFailed = !gzip_writer::CompressStream(
+            [&](uint8_t* dst, size_t capacity, size_t& outRead) {
+                if (offset >= 100 * 1024) return false;
+                outRead = (std::min)(capacity, input.size() - offset);
+                std::memcpy(dst, input.data() + offset, outRead);
+                offset += outRead;
+                return true;
+            },
+            [](const uint8_t*, size_t) { return true; }, options);
+        Check(readFailed, "read failure is reported");
+
+        offset = 0;
+        int writes = 0;
+        const bool writeFailed = !gzip_writer::CompressStream(
+            [&](uint8_t* dst, size_t capacity, size_t& outRead) {
+                outRead = (std::min)(capacity, input.size() - offset);
+                std::memcpy(dst, input.data() + offset, outRead);
+                offset += outRead;
+                return true;
+            },
+            [&](const uint8_t*, size_t) { return ++writes < 2; }, options);
+        Check(writeFailed, "write failure is reported");
+    }
+}
+
+int RunBenchmark(const char* path) {
+    std::vector<uint8_t> input;
+    if (path) {
+        std::ifstream in(path, std::ios::binary);
+        input.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    } else {
+        input = MakeLogText(64ull * 1024ull * 1024ull, 42);
+    }
+    if (input.empty()) {
+        std::cerr << "Benchmark input is empty\n";
+        return 2;
+    }
+
+    for (int workers : { 1, 2, gzip_writer::kMaxWorkerThreads }) {
+        gzip_writer::GzipOptions options;
+        options.workerThreads = workers;
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<uint8_t> gz = CompressWithStream(input, options);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double mb = static_cast<double>(input.size()) / (1024.0 * 1024.0);
+        std::cout << "workers=" << workers << " input=" << mb << " MiB time=" << seconds << " s throughput=" << (mb / seconds)
+                  << " MiB/s ratio=" << (static_cast<double>(input.size()) / static_cast<double>(gz.size())) << '\n';
+    }
+    return 0;
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"crc32_matches_known_vectors", &Crc32MatchesKnownVectors},
+        {"empty_input_round_trips", &EmptyInputRoundTrips},
+        {"small_text_round_trips", &SmallTextRoundTrips},
+        {"log_text_compresses_with_dynamic_blocks", &LogTextCompressesWithDynamicBlocks},
+        {"random_bytes_round_trip", &RandomBytesRoundTrip},
+        {"long_runs_round_trip", &LongRunsRoundTrip},
+        {"multi_member_stream_round_trips", &MultiMemberStreamRoundTrips},
+        {"worker_counts_produce_identical_output", &WorkerCountsProduceIdenticalOutput},
+        {"read_and_write_failures_propagate", &ReadAndWriteFailuresPropagate},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if ((argc == 2 || argc == 3) && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark(argc == 3 ? argv[2] : nullptr);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench [file]]\n";
+    return 2;
+}
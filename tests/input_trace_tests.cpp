@@ -0,0 +1,306 @@
+#include "hooks/input_trace.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+InputTraceEvent MakeMessage(uint64_t timestampUs, uint32_t message, uint64_t wParam, int64_t lParam) {
+    InputTraceEvent event;
+    event.timestampUs = timestampUs;
+    event.kind = InputTraceEventKind::WindowMessage;
+    event.message = message;
+    event.wParam = wParam;
+    event.lParam = lParam;
+    return event;
+}
+
+InputTraceEvent MakeRawMouse(uint64_t timestampUs, int32_t dx, int32_t dy, uint16_t buttonFlags, uint16_t flags) {
+    InputTraceEvent event;
+    event.timestampUs = timestampUs;
+    event.kind = InputTraceEventKind::RawMouse;
+    event.rawDx = dx;
+    event.rawDy = dy;
+    event.rawButtonFlags = buttonFlags;
+    event.rawFlags = flags;
+    return event;
+}
+
+std::vector<InputTraceEvent> MakeRandomTrace(uint32_t seed, size_t count) {
+    std::mt19937_64 rng(seed);
+    std::vector<InputTraceEvent> events;
+    uint64_t timestampUs = 0;
+    for (size_t i = 0; i < count; ++i) {
+        timestampUs += rng() % 20000;
+        if (rng() % 3 == 0) {
+            events.push_back(MakeRawMouse(timestampUs, static_cast<int32_t>(rng()), static_cast<int32_t>(rng() % 41) - 20,
+                                          static_cast<uint16_t>(rng()), static_cast<uint16_t>(rng() % 2)));
+        } else {
+            events.push_back(MakeMessage(timestampUs, static_cast<uint32_t>(rng()), rng(), static_cast<int64_t>(rng())));
+        }
+    }
+    return events;
+}
+
+void RoundTripsMessagesAndRawInput() {
+    std::vector<InputTraceEvent> events = {
+        MakeMessage(0, 0x0100, 0x41, 0x001E0001),
+        MakeMessage(7, 0x0101, 0x41, static_cast<int64_t>(0xFFFFFFFFC01E0001ull)),
+        MakeRawMouse(9, -3, 12, 0x0001, 0),
+        MakeMessage(9, 0x0200, 0, (std::numeric_limits<int64_t>::min)()),
+        MakeRawMouse(1'000'000, (std::numeric_limits<int32_t>::min)(), (std::numeric_limits<int32_t>::max)(), 0xFFFF, 0xFFFF),
+        MakeMessage(1'000'001, 0xFFFFFFFFu, (std::numeric_limits<uint64_t>::max)(), (std::numeric_limits<int64_t>::max)()),
+    };
+    const std::vector<uint8_t> encoded = EncodeInputTrace(events);
+    std::vector<InputTraceEvent> decoded;
+    Check(DecodeInputTrace(encoded.data(), encoded.size(), decoded), "trace should decode");
+    Check(decoded == events, "decoded events should equal the recorded ones");
+
+    const std::vector<InputTraceEvent> random = MakeRandomTrace(7, 5000);
+    const std::vector<uint8_t> randomEncoded = EncodeInputTrace(random);
+    Check(DecodeInputTrace(randomEncoded.data(), randomEncoded.size(), decoded), "random trace should decode");
+    Check(decoded == random, "random trace should round-trip");
+
+    std::vector<InputTraceEvent> empty;
+    const std::vector<uint8_t> emptyEncoded = EncodeInputTrace(empty);
+    Check(DecodeInputTrace(emptyEncoded.data(), emptyEncoded.size(), decoded) && decoded.empty(), "empty trace should round-trip");
+}
+
+void TypicalInputIsCompact() {
+    // Keyboard and mouse traffic as it arrives: small timestamp gaps, small VKs, lParams with a scan code.
+    std::vector<InputTraceEvent> events;
+    uint64_t timestampUs = 0;
+    for (int i = 0; i < 1000; ++i) {
+        timestampUs += 1000;
+        if (i % 4 == 0) {
+            events.push_back(MakeMessage(timestampUs, 0x0100, 0x41 + i % 26, 0x00100001 + (i % 26) * 0x10000));
+        } else {
+            events.push_back(MakeRawMouse(timestampUs, i % 7 - 3, i % 5 - 2, 0, 0));
+        }
+    }
+    const std::vector<uint8_t> encoded = EncodeInputTrace(events);
+    Check(encoded.size() < events.size() * 10, "typical events should take under 10 bytes each, got " + std::to_string(encoded.size()));
+}
+
+void RejectsMalformedTraces() {
+    const std::vector<uint8_t> encoded = EncodeInputTrace(MakeRandomTrace(11, 64));
+    std::vector<InputTraceEvent> decoded;
+
+    for (size_t length = 0; length < encoded.size(); ++length) {
+        if (DecodeInputTrace(encoded.data(), length, decoded)) {
+            Check(false, "truncated trace of " + std::to_string(length) + " bytes should be rejected");
+            break;
+        }
+        Check(decoded.empty(), "rejected trace should leave no events");
+    }
+
+    std::vector<uint8_t> trailing = encoded;
+    trailing.push_back(0);
+    Check(!DecodeInputTrace(trailing.data(), trailing.size(), decoded), "trailing bytes should be rejected");
+
+    std::vector<uint8_t> badMagic = encoded;
+    badMagic[0] = 'X';
+    Check(!DecodeInputTrace(badMagic.data(), badMagic.size(), decoded), "bad magic should be rejected");
+
+    std::vector<uint8_t> badVersion = encoded;
+    badVersion[4] = 99;
+    Check(!DecodeInputTrace(badVersion.data(), badVersion.size(), decoded), "unknown version should be rejected");
+
+    // Header, one event, delta 0, kind 7.
+    const std::vector<uint8_t> badKind = { 'T', 'S', 'I', 'T', 1, 1, 0, 7, 0, 0, 0 };
+    Check(!DecodeInputTrace(badKind.data(), badKind.size(), decoded), "unknown event kind should be rejected");
+
+    // A count far beyond what the payload could hold must not reserve memory for it.
+    const std::vector<uint8_t> hugeCount = { 'T', 'S', 'I', 'T', 1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F };
+    Check(!DecodeInputTrace(hugeCount.data(), hugeCount.size(), decoded), "implausible event count should be rejected");
+
+    // Raw dx of 2^31 does not fit the field.
+    const std::vector<uint8_t> overflow = { 'T', 'S', 'I', 'T', 1, 1, 0, 1, 0x80, 0x80, 0x80, 0x80, 0x10, 0, 0, 0 };
+    Check(!DecodeInputTrace(overflow.data(), overflow.size(), decoded), "out-of-range field should be rejected");
+
+    // Eleven-byte varint.
+    const std::vector<uint8_t> longVarint = { 'T', 'S', 'I', 'T', 1, 1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0, 0, 0, 0 };
+    Check(!DecodeInputTrace(longVarint.data(), longVarint.size(), decoded), "over-long varint should be rejected");
+
+    std::mt19937 rng(5);
+    for (int i = 0; i < 2000; ++i) {
+        std::vector<uint8_t> corrupted = encoded;
+        corrupted[rng() % corrupted.size()] ^= static_cast<uint8_t>(1u << (rng() % 8));
+        // Either outcome is fine; decoding must simply stay in bounds (checked under the sanitizers).
+        DecodeInputTrace(corrupted.data(), corrupted.size(), decoded);
+    }
+}
+
+void OutOfOrderTimestampsAreClamped() {
+    const std::vector<InputTraceEvent> events = { MakeMessage(100, 1, 0, 0), MakeRawMouse(90, 1, 1, 0, 0), MakeMessage(120, 2, 0, 0) };
+    const std::vector<uint8_t> encoded = EncodeInputTrace(events);
+    std::vector<InputTraceEvent> decoded;
+    Check(DecodeInputTrace(encoded.data(), encoded.size(), decoded) && decoded.size() == 3, "trace should decode");
+    if (decoded.size() != 3) return;
+    Check(decoded[0].timestampUs == 100 && decoded[1].timestampUs == 100 && decoded[2].timestampUs == 120,
+          "a late event should take the previous timestamp");
+}
+
+void FileRoundTrip() {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "toolscreen_input_trace_test.bin";
+    const std::vector<InputTraceEvent> events = MakeRandomTrace(23, 300);
+    Check(SaveInputTraceFile(path, events), "trace should save");
+    std::vector<InputTraceEvent> loaded;
+    Check(LoadInputTraceFile(path, loaded), "trace should load");
+    Check(loaded == events, "loaded trace should equal the saved one");
+    std::filesystem::remove(path);
+    Check(!LoadInputTraceFile(path, loaded) && loaded.empty(), "missing file should fail to load");
+}
+
+void RecorderCapturesInOrderWithinCap() {
+    InputTraceRecorder recorder;
+    recorder.Record(MakeMessage(0, 1, 0, 0));
+    Check(!recorder.IsRecording(), "recorder should start idle");
+
+    recorder.Start(3);
+    for (uint32_t i = 0; i < 5; ++i) recorder.Record(MakeMessage(0, i, i, 0));
+    Check(recorder.DroppedCount() == 2, "events past the cap should be counted as dropped");
+    const std::vector<InputTraceEvent> events = recorder.Stop();
+    Check(!recorder.IsRecording(), "recorder should stop");
+    Check(events.size() == 3, "recorder should keep the first maxEvents events");
+    for (size_t i = 0; i < events.size(); ++i) {
+        Check(events[i].message == i, "events should keep recording order");
+        if (i > 0) Check(events[i].timestampUs >= events[i - 1].timestampUs, "timestamps should not decrease");
+    }
+
+    recorder.Record(MakeMessage(0, 9, 0, 0));
+    recorder.Start(3);
+    Check(recorder.Stop().empty(), "events recorded while stopped should be discarded");
+}
+
+void RecorderAcceptsConcurrentWriters() {
+    InputTraceRecorder recorder;
+    recorder.Start();
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&recorder, t]() {
+            for (int i = 0; i < 1000; ++i) recorder.Record(MakeRawMouse(0, t, i, 0, 0));
+        });
+    }
+    for (std::thread& writer : writers) writer.join();
+    const std::vector<InputTraceEvent> events = recorder.Stop();
+    Check(events.size() == 4000, "every concurrent event should be recorded");
+    std::vector<int32_t> next(4, 0);
+    for (const InputTraceEvent& event : events) {
+        if (event.rawDx < 0 || event.rawDx >= 4) {
+            Check(false, "unexpected writer id");
+            return;
+        }
+        Check(event.rawDy == next[event.rawDx]++, "each writer's events should stay in order");
+    }
+}
+
+void StageTimingsKeepChainOrderAndPercentiles() {
+    InputStageTimings timings;
+    static const char kFirst[] = "First";
+    static const char kSecond[] = "Second";
+    for (int i = 0; i < 100; ++i) {
+        timings.Record(kFirst, i < 99 ? 100 : 5000, false);
+        if (i % 2 == 0) timings.Record(kSecond, 10, i == 0);
+    }
+    // Same name at another address is the same stage.
+    const std::string secondCopy = "Second";
+    timings.Record(secondCopy.c_str(), 10, false);
+
+    const std::vector<InputStageStats> stats = timings.Snapshot();
+    Check(stats.size() == 2, "two stages should be reported");
+    if (stats.size() != 2) return;
+    Check(stats[0].name == "First" && stats[1].name == "Second", "stages should be reported in first-seen order");
+    Check(stats[0].calls == 100 && stats[0].totalNs == 99 * 100 + 5000 && stats[0].maxNs == 5000, "first stage totals");
+    Check(stats[0].p50Ns >= 100 && stats[0].p50Ns < 200, "p50 should bound the common case, got " + std::to_string(stats[0].p50Ns));
+    Check(stats[0].p99Ns >= 100 && stats[0].p99Ns < 200, "p99 of 100 samples with one outlier should exclude it");
+    Check(stats[1].calls == 51 && stats[1].consumed == 1, "second stage calls and consumed count");
+
+    const std::string report = FormatInputStageReport(stats);
+    Check(report.find("First: calls=100") != std::string::npos, "report should list the first stage");
+    Check(report.find("total: ") != std::string::npos, "report should end with a total");
+
+    timings.Reset();
+    Check(timings.Snapshot().empty(), "reset should clear all stages");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"round_trips_messages_and_raw_input", &RoundTripsMessagesAndRawInput},
+        {"typical_input_is_compact", &TypicalInputIsCompact},
+        {"rejects_malformed_traces", &RejectsMalformedTraces},
+        {"out_of_order_timestamps_are_clamped", &OutOfOrderTimestampsAreClamped},
+        {"file_round_trip", &FileRoundTrip},
+        {"recorder_captures_in_order_within_cap", &RecorderCapturesInOrderWithinCap},
+        {"recorder_accepts_concurrent_writers", &RecorderAcceptsConcurrentWriters},
+        {"stage_timings_keep_chain_order_and_percentiles", &StageTimingsKeepChainOrderAndPercentiles},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
@@ -0,0 +1,312 @@
+#include "hooks/key_repeat_scheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+constexpr int64_t kMs = 1'000'000;
+
+// Plays the scheduler thread against a simulated clock: sleep to the next deadline, wake wakeLatency() late, collect.
+struct SimulatedRepeatDriver {
+    explicit SimulatedRepeatDriver(KeyRepeatScheduler& scheduler) : scheduler(scheduler) {}
+
+    KeyRepeatScheduler& scheduler;
+    int64_t nowNs = 0;
+    std::function<int64_t()> wakeLatency;
+    std::vector<KeyRepeatFire> fires;
+    uint64_t wakes = 0;
+
+    void RunUntil(int64_t endNs) {
+        for (;;) {
+            const std::optional<int64_t> deadline = scheduler.NextDeadlineNs();
+            if (!deadline) {
+                nowNs = (std::max)(nowNs, endNs);
+                return;
+            }
+            const int64_t wakeNs = (std::max)(nowNs, *deadline) + (wakeLatency ? wakeLatency() : 0);
+            if (wakeNs > endNs) {
+                nowNs = (std::max)(nowNs, endNs);
+                return;
+            }
+            nowNs = wakeNs;
+            ++wakes;
+            scheduler.Collect(nowNs, fires);
+        }
+    }
+};
+
+std::vector<KeyRepeatFire> FiresFor(const std::vector<KeyRepeatFire>& fires, uint32_t key) {
+    std::vector<KeyRepeatFire> result;
+    std::copy_if(fires.begin(), fires.end(), std::back_inserter(result), [key](const KeyRepeatFire& fire) { return fire.key == key; });
+    return result;
+}
+
+void FirstRepeatAfterStartDelayThenEveryInterval() {
+    KeyRepeatScheduler scheduler;
+    SimulatedRepeatDriver driver(scheduler);
+    driver.nowNs = 5 * kMs;
+    scheduler.Press('A', driver.nowNs, 250 * kMs, 33 * kMs);
+    driver.RunUntil(5 * kMs + 1000 * kMs);
+
+    Check(driver.fires.size() == 23, "a 1 s hold with 250/33 ms timings should repeat 23 times, got " + std::to_string(driver.fires.size()));
+    for (size_t i = 0; i < driver.fires.size(); ++i) {
+        const KeyRepeatFire& fire = driver.fires[i];
+        const int64_t expectedNs = 5 * kMs + 250 * kMs + static_cast<int64_t>(i) * 33 * kMs;
+        Check(fire.key == 'A' && fire.repeatIndex == i && fire.dueNs == expectedNs && fire.firedNs == expectedNs,
+              "repeat " + std::to_string(i) + " should fire exactly on its deadline");
+    }
+    Check(scheduler.Stats().maxLateNs == 0 && scheduler.Stats().skipped == 0, "an on-time driver should report no schedule error");
+}
+
+void LongHoldHasZeroDrift() {
+    KeyRepeatScheduler scheduler;
+    SimulatedRepeatDriver driver(scheduler);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int64_t> latency(0, 2 * kMs);
+    driver.wakeLatency = [&]() { return latency(rng); };
+
+    // 30 Hz has no whole-nanosecond interval (33'333'333.3 ns), the case where rounding would creep.
+    const int64_t intervalNs = 1'000'000'000 / 30;
+    const int64_t pressNs = 123 * kMs;
+    scheduler.Press('W', pressNs, 300 * kMs, intervalNs);
+    const int64_t holdNs = 3600ll * 1'000'000'000;
+    driver.RunUntil(pressNs + holdNs);
+
+    bool onGrid = true;
+    for (size_t i = 0; i < driver.fires.size(); ++i) {
+        const KeyRepeatFire& fire = driver.fires[i];
+        if (fire.repeatIndex != i || fire.dueNs != pressNs + 300 * kMs + static_cast<int64_t>(i) * intervalNs) {
+            Check(false, "repeat " + std::to_string(i) + " left the grid");
+            onGrid = false;
+            break;
+        }
+    }
+    const uint64_t expectedRepeats = static_cast<uint64_t>((holdNs - 300 * kMs) / intervalNs) + 1;
+    Check(onGrid, "every repeat should sit on press + startDelay + k * interval");
+    Check(driver.fires.size() == expectedRepeats || driver.fires.size() + 1 == expectedRepeats,
+          "an hour-long hold should not gain or lose repeats, got " + std::to_string(driver.fires.size()) + " of " +
+              std::to_string(expectedRepeats));
+    const KeyRepeatScheduleStats& stats = scheduler.Stats();
+    Check(stats.maxLateNs <= 2 * kMs && stats.skipped == 0, "wake latency should show up as bounded schedule error, not skips");
+    Check(stats.MeanAbsErrorNs() > kMs / 2 && stats.MeanAbsErrorNs() < 3 * kMs / 2,
+          "mean schedule error should match the mean wake latency, got " + std::to_string(stats.MeanAbsErrorNs()));
+
+    // Re-arming from the fire time, as the previous per-repeat timer did, carries every wake's latency forward.
+    uint64_t legacyRepeats = 0;
+    for (int64_t fireNs = pressNs + 300 * kMs + latency(rng); fireNs <= pressNs + holdNs; fireNs += intervalNs + latency(rng)) {
+        ++legacyRepeats;
+    }
+    Check(legacyRepeats + 1000 < expectedRepeats, "re-arming from fire time should lose over 30 s of repeats in an hour, lost " +
+                                                      std::to_string(expectedRepeats - legacyRepeats));
+}
+
+void ManyHeldKeysKeepTheirOwnCadence() {
+    KeyRepeatScheduler scheduler;
+    SimulatedRepeatDriver driver(scheduler);
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int64_t> latency(0, 300'000);
+    driver.wakeLatency = [&]() { return latency(rng); };
+
+    struct Held {
+        int64_t pressNs;
+        int64_t startDelayNs;
+        int64_t intervalNs;
+    };
+    std::map<uint32_t, Held> held;
+    for (uint32_t key = 0; key < 64; ++key) {
+        // Staggered presses on the driver's clock, each with its own timings.
+        driver.RunUntil(static_cast<int64_t>(key) * 7 * kMs + 1'234);
+        const Held timings{ driver.nowNs, (200 + static_cast<int64_t>(key % 5) * 25) * kMs, (10 + static_cast<int64_t>(key % 7) * 5) * kMs + 333 };
+        scheduler.Press(0x100 + key, timings.pressNs, timings.startDelayNs, timings.intervalNs);
+        held.emplace(0x100 + key, timings);
+    }
+    const int64_t endNs = 10'000 * kMs;
+    driver.RunUntil(endNs);
+
+    for (const auto& [key, timings] : held) {
+        const std::vector<KeyRepeatFire> fires = FiresFor(driver.fires, key);
+        const uint64_t expected = static_cast<uint64_t>((endNs - timings.pressNs - timings.startDelayNs) / timings.intervalNs) + 1;
+        bool exact = fires.size() + 1 >= expected && fires.size() <= expected;
+        for (size_t i = 0; exact && i < fires.size(); ++i) {
+            exact = fires[i].repeatIndex == i && fires[i].dueNs == timings.pressNs + timings.startDelayNs + static_cast<int64_t>(i) * timings.intervalNs;
+        }
+        Check(exact, "key " + std::to_string(key) + " should repeat on its own grid (" + std::to_string(fires.size()) + " of " +
+                         std::to_string(expected) + ")");
+    }
+    Check(std::is_sorted(driver.fires.begin(), driver.fires.end(),
+                         [](const KeyRepeatFire& a, const KeyRepeatFire& b) { return a.firedNs < b.firedNs; }),
+          "repeats should come out in time order");
+    Check(scheduler.Stats().maxLateNs <= 300'000 && scheduler.Stats().maxEarlyNs <= kMs, "schedule error should stay within latency and tolerance");
+    Check(scheduler.Stats().skipped == 0, "64 held keys should not cost a single repeat");
+}
+
+void CoalescesDeadlinesWithinTolerance() {
+    KeyRepeatScheduler scheduler;
+    SimulatedRepeatDriver driver(scheduler);
+    scheduler.Press('A', 0, 250 * kMs, 30 * kMs);
+    scheduler.Press('D', 400'000, 250 * kMs, 30 * kMs);
+    driver.RunUntil(1000 * kMs);
+
+    Check(FiresFor(driver.fires, 'A').size() == FiresFor(driver.fires, 'D').size(), "both keys should repeat equally often");
+    Check(driver.wakes * 2 == driver.fires.size(), "keys 0.4 ms apart should share every wake, " + std::to_string(driver.wakes) + " wakes for " +
+                                                          std::to_string(driver.fires.size()) + " repeats");
+    Check(scheduler.Stats().coalesced * 2 == driver.fires.size() && scheduler.Stats().maxEarlyNs == 400'000,
+          "the later key should fire 0.4 ms early on the shared wake");
+}
+
+void KeepsSeparateWakesBeyondTolerance() {
+    KeyRepeatScheduler scheduler;
+    SimulatedRepeatDriver driver(scheduler);
+    scheduler.Press('A', 0, 250 * kMs, 30 * kMs);
+    scheduler.Press('D', 3 * kMs, 250 * kMs, 30 * kMs);
+    driver.RunUntil(1000 * kMs);
+
+    Check(driver.wakes == driver.fires.size(), "keys 3 ms apart should each get their own wake");
+    Check(scheduler.Stats().coalesced == 0 && scheduler.Stats().maxEarlyNs == 0, "no repeat should fire early");
+}
+
+void ToleranceIsCappedAtHalfTheInterval() {
+    KeyRepeatSchedulerOptions options;
+    options.coalesceToleranceNs = 20 * kMs;
+    KeyRepeatScheduler scheduler(options);
+    SimulatedRepeatDriver driver(scheduler);
+    scheduler.Press('A', 0, 10 * kMs, 4 * kMs);
+    driver.RunUntil(10 * kMs + 40 * kMs);
+
+    Check(driver.fires.size() == 11, "a wide tolerance should not swallow repeats of a fast key, got " + std::to_string(driver.fires.size()));
+    Check(scheduler.Stats().skipped == 0 && scheduler.Stats().maxEarlyNs == 0, "a lone key should fire on its deadlines");
+}
+
+void LateCollectSkipsInsteadOfBursting() {
+    KeyRepeatScheduler scheduler;
+    scheduler.Press('A', 0, 100 * kMs, 10 * kMs);
+    std::vector<KeyRepeatFire> fires;
+    Check(scheduler.Collect(1000 * kMs + 3 * kMs, fires) == 1, "a stalled scheduler should fire once on wake");
+    Check(fires.size() == 1 && fires[0].dueNs == 100 * kMs && fires[0].repeatIndex == 0, "the overdue repeat should report its own deadline");
+    Check(scheduler.Stats().skipped == 90, "the stall should be reported as skipped repeats, got " + std::to_string(scheduler.Stats().skipped));
+    Check(scheduler.Stats().maxLateNs == 903 * kMs, "the stall should be reported as schedule error");
+    Check(scheduler.NextDeadlineNs() == 1010 * kMs, "the next repeat should stay on the original grid");
+}
+
+void ReleaseRekeyAndRestart() {
+    KeyRepeatScheduler scheduler;
+    std::vector<KeyRepeatFire> fires;
+    scheduler.Press('A', 0, 250 * kMs, 33 * kMs);
+    scheduler.Press('B', 10 * kMs, 250 * kMs, 33 * kMs);
+    Check(scheduler.ScheduledCount() == 2, "both keys should be scheduled");
+
+    Check(scheduler.Release('A') && !scheduler.IsScheduled('A'), "release should drop the key");
+    Check(!scheduler.Release('A'), "a second release should report nothing to drop");
+    Check(scheduler.NextDeadlineNs() == 260 * kMs, "the released key's deadline should be gone");
+
+    Check(scheduler.Rekey('B', 'C') && scheduler.IsScheduled('C') && !scheduler.IsScheduled('B'), "rekey should move the schedule");
+    Check(scheduler.NextDeadlineNs() == 260 * kMs, "rekey should keep the deadline");
+    scheduler.Collect(260 * kMs, fires);
+    Check(fires.size() == 1 && fires[0].key == 'C', "the repeat should fire under the new key");
+
+    Check(scheduler.RestartDelay('C', 270 * kMs), "restart should find the key");
+    Check(scheduler.NextDeadlineNs() == 520 * kMs, "restart should wait the full start delay again");
+    Check(!scheduler.RestartDelay('Z', 0), "restart of an unscheduled key should fail");
+
+    scheduler.Clear();
+    Check(scheduler.ScheduledCount() == 0 && !scheduler.NextDeadlineNs(), "clear should drop every key");
+    scheduler.Press('A', 5000 * kMs, 0, 33 * kMs);
+    Check(scheduler.NextDeadlineNs() == 5000 * kMs, "the wheel should be reusable after clear");
+}
+
+void WheelHandlesDeadlinesBeyondOneRevolution() {
+    KeyRepeatScheduler scheduler;
+    std::vector<KeyRepeatFire> fires;
+    // 1 ms ticks, 256 slots: a 1 s start delay wraps the wheel almost four times.
+    scheduler.Press('A', 0, 1000 * kMs, 50 * kMs);
+    scheduler.Press('B', 0, 10 * kMs, 50 * kMs);
+    Check(scheduler.NextDeadlineNs() == 10 * kMs, "the near deadline should come first");
+    scheduler.Release('B');
+    Check(scheduler.NextDeadlineNs() == 1000 * kMs, "a deadline several revolutions out should still be found");
+
+    // 744 ms shares the 1000 ms deadline's slot.
+    Check(scheduler.Collect(744 * kMs, fires) == 0, "a deadline in a later revolution should not fire early");
+    Check(scheduler.Collect(999 * kMs, fires) == 1 && fires.back().dueNs == 1000 * kMs, "it should fire once within tolerance");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"first_repeat_after_start_delay_then_every_interval", &FirstRepeatAfterStartDelayThenEveryInterval},
+        {"long_hold_has_zero_drift", &LongHoldHasZeroDrift},
+        {"many_held_keys_keep_their_own_cadence", &ManyHeldKeysKeepTheirOwnCadence},
+        {"coalesces_deadlines_within_tolerance", &CoalescesDeadlinesWithinTolerance},
+        {"keeps_separate_wakes_beyond_tolerance", &KeepsSeparateWakesBeyondTolerance},
+        {"tolerance_is_capped_at_half_the_interval", &ToleranceIsCappedAtHalfTheInterval},
+        {"late_collect_skips_instead_of_bursting", &LateCollectSkipsInsteadOfBursting},
+        {"release_rekey_and_restart", &ReleaseRekeyAndRestart},
+        {"wheel_handles_deadlines_beyond_one_revolution", &WheelHandlesDeadlinesBeyondOneRevolution},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}
@@ -0,0 +1,348 @@
+#include "common/log_pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+struct CapturingSink {
+    std::mutex mutex;
+    std::string text;
+    int batches = 0;
+    int attempts = 0;
+    bool accept = true;
+
+    log_pipeline::LogPipeline::Sink Bind() {
+        return [this](const char* data, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++attempts;
+            if (!accept) return false;
+            text.append(data, size);
+            ++batches;
+            return true;
+        };
+    }
+
+    std::vector<std::string> Lines() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line)) lines.push_back(line);
+        return lines;
+    }
+};
+
+std::string StripTimestamp(const std::string& line) { return line.size() >= 15 ? line.substr(15) : std::string(); }
+
+void SingleProducerPreservesOrder() {
+    CapturingSink sink;
+    log_pipeline::LogPipeline pipeline(sink.Bind());
+    for (int i = 0; i < 1000; i++) Check(pipeline.Submit("message " + std::to_string(i)), "submit succeeds");
+    Check(pipeline.Flush() == 1000, "flush drains every record");
+
+    const std::vector<std::string> lines = sink.Lines();
+    Check(lines.size() == 1000, "one line per record");
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (StripTimestamp(lines[i]) != "message " + std::to_string(i)) {
+            Check(false, "line " + std::to_string(i) + " out of order: " + lines[i]);
+            break;
+        }
+    }
+}
+
+void LinesUseTimestampPrefix() {
+    CapturingSink sink;
+    log_pipeline::LogPipeline pipeline(sink.Bind());
+    pipeline.Submit(1700000000123, "fixed");
+    pipeline.Submit("");
+    pipeline.Flush();
+
+    const std::vector<std::string> lines = sink.Lines();
+    const std::regex pattern(R"(^\[\d\d:\d\d:\d\d\.\d\d\d\] .*$)");
+    Check(lines.size() == 2, "two lines written");
+    for (const std::string& line : lines) Check(std::regex_match(line, pattern), "timestamp prefix: " + line);
+    Check(!lines.empty() && lines[0].substr(9, 4) == ".123", "milliseconds come from the record timestamp");
+    Check(lines.size() == 2 && lines[1].size() == 15, "empty message keeps only the prefix");
+}
+
+void LongMessagesSpanSlots() {
+    CapturingSink sink;
+    log_pipeline::LogPipeline pipeline(sink.Bind());
+    std::string longMessage;
+    for (int i = 0; i < 2000; i++) longMessage += static_cast<char>('a' + i % 26);
+    pipeline.Submit("before");
+    pipeline.Submit(longMessage);
+    pipeline.Submit("after");
+    pipeline.Flush();
+
+    const std::vector<std::string> lines = sink.Lines();
+    Check(lines.size() == 3, "three lines written");
+    Check(lines.size() == 3 && StripTimestamp(lines[1]) == longMessage, "long message survives intact");
+    Check(lines.size() == 3 && StripTimestamp(lines[2]) == "after", "record after long message is intact");
+}
+
+void OversizedMessagesAreTruncated() {
+    CapturingSink sink;
+    log_pipeline::LogPipeline pipeline(sink.Bind());
+    const std::string huge(1 << 20, 'x');
+    Check(pipeline.Submit(huge), "oversized submit succeeds");
+    pipeline.Flush();
+
+    const std::vector<std::string> lines = sink.Lines();
+    Check(pipeline.TruncatedCount() == 1, "truncation is counted");
+    Check(lines.size() == 2, "truncation notice plus the record");
+    Check(!lines.empty() && lines[0].find("Truncated 1 log message(s) to " + std::to_string(log_pipeline::kMaxRecordBytes) + " bytes") !=
+                                std::string::npos,
+          "truncation notice reports the limit: " + (lines.empty() ? std::string() : lines[0]));
+    Check(lines.size() == 2 && StripTimestamp(lines[1]) == huge.substr(0, log_pipeline::kMaxRecordBytes),
+          "oversized message is cut to the record limit");
+
+    pipeline.Submit(std::string(log_pipeline::kMaxRecordBytes, 'y'));
+    pipeline.Flush();
+    Check(pipeline.TruncatedCount() == 1 && sink.Lines().size() == 3, "a message at the limit is kept whole without a notice");
+}
+
+void FullRingDropsAndReports() {
+    CapturingSink sink;
+    log_pipeline::LogPipelineOptions options;
+    options.capacitySlots = 16;
+    log_pipeline::LogPipeline pipeline(sink.Bind(), options);
+
+    int accepted = 0;
+    for (int i = 0; i < 40; i++) accepted += pipeline.Submit("m" + std::to_string(i)) ? 1 : 0;
+    Check(accepted == 16, "ring accepts exactly its capacity, got " + std::to_string(accepted));
+    Check(pipeline.DroppedCount() == 24, "overflow is counted");
+
+    pipeline.Flush();
+    const std::vector<std::string> lines = sink.Lines();
+    Check(lines.size() == 17, "drop notice plus accepted records");
+    Check(!lines.empty() && lines[0].find("Dropped 24 log message(s)") != std::string::npos, "drop notice reports the count");
+
+    Check(pipeline.Submit("reuse"), "ring accepts records again after draining");
+}
+
+void RejectedBatchesAreRetained() {
+    CapturingSink sink;
+    sink.accept = false;
+    log_pipeline::LogPipeline pipeline(sink.Bind());
+    pipeline.Submit("early 1");
+    pipeline.Submit("early 2");
+    Check(pipeline.Flush() == 0, "nothing drained while the sink is not ready");
+
+    sink.accept = true;
+    pipeline.Submit("late");
+    Check(pipeline.Flush() == 3, "retained records drain once the sink is ready");
+    const std::vector<std::string> lines = sink.Lines();
+    Check(lines.size() == 3 && StripTimestamp(lines[0]) == "early 1", "retained records keep their order");
+}
+
+void WriterBacksOffWhileSinkRejects() {
+    CapturingSink sink;
+    sink.accept = false;
+    log_pipeline::LogPipelineOptions options;
+    options.idleInterval = std::chrono::milliseconds(100);
+    log_pipeline::LogPipeline pipeline(sink.Bind(), options);
+    pipeline.Start();
+    pipeline.Submit("pending");
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    int attempts = 0;
+    {
+        std::lock_guard<std::mutex> lock(sink.mutex);
+        attempts = sink.attempts;
+        sink.accept = true;
+    }
+    Check(attempts > 0 && attempts < 20, "writer retries a rejecting sink with a delay, attempts=" + std::to_string(attempts));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sink.Lines().empty() && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Check(sink.Lines().size() == 1, "retained record is written once the sink recovers");
+    pipeline.Stop();
+}
+
+void MultiProducerDeliversEveryMessage() {
+    CapturingSink sink;
+    log_pipeline::LogPipelineOptions options;
+    options.capacitySlots = 1024;
+    log_pipeline::LogPipeline pipeline(sink.Bind(), options);
+    pipeline.Start();
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 20000;
+    std::atomic<int> accepted{ 0 };
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; t++) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i < kPerThread; i++) {
+                std::string message = "t" + std::to_string(t) + " " + std::to_string(i);
+                if (i % 97 == 0) message.append(600, '.');
+                if (pipeline.Submit(message)) accepted.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& producer : producers) producer.join();
+    pipeline.Stop();
+
+    int records = 0;
+    std::vector<int> lastSeen(kThreads, -1);
+    bool ordered = true;
+    for (const std::string& line : sink.Lines()) {
+        const std::string body = StripTimestamp(line);
+        if (body.rfind("(Dropped", 0) == 0) continue;
+        records++;
+        const int thread = body[1] - '0';
+        const int index = std::stoi(body.substr(3));
+        if (thread < 0 || thread >= kThreads || index <= lastSeen[thread]) ordered = false;
+        if (thread >= 0 && thread < kThreads) lastSeen[thread] = index;
+    }
+    Check(records == accepted.load(), "every accepted record is written exactly once");
+    Check(static_cast<uint64_t>(accepted.load()) + pipeline.DroppedCount() == kThreads * kPerThread, "accepted + dropped == produced");
+    Check(ordered, "per-producer order is preserved");
+}
+
+void WriterWakesOnSubmit() {
+    CapturingSink sink;
+    log_pipeline::LogPipelineOptions options;
+    options.idleInterval = std::chrono::milliseconds(60000);
+    log_pipeline::LogPipeline pipeline(sink.Bind(), options);
+    std::atomic<int> idleRuns{ 0 };
+    pipeline.Start([&]() { idleRuns.fetch_add(1); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const int idleBefore = idleRuns.load();
+    pipeline.Submit("wake up");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sink.Lines().empty() && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Check(sink.Lines().size() == 1, "submit wakes the parked writer without waiting for the idle interval");
+    Check(idleRuns.load() > idleBefore, "idle task runs after the wake-up drain");
+
+    const int idleAfterSubmit = idleRuns.load();
+    pipeline.Wake();
+    const auto wakeDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (idleRuns.load() == idleAfterSubmit && std::chrono::steady_clock::now() < wakeDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Check(idleRuns.load() > idleAfterSubmit, "explicit wake runs the idle task");
+    pipeline.Stop();
+}
+
+int RunBenchmark() {
+    std::atomic<uint64_t> bytesWritten{ 0 };
+    log_pipeline::LogPipeline pipeline([&](const char*, size_t size) {
+        bytesWritten.fetch_add(size, std::memory_order_relaxed);
+        return true;
+    });
+    pipeline.Start();
+
+    const std::string message = "[Performance] frame 123456 render 6.94ms gpu 3.12ms mirrors 4 overlays 2 (texture 0x0DE1)";
+    for (int producers : { 1, 4 }) {
+        constexpr int kPerThread = 1000000;
+        const uint64_t droppedBefore = pipeline.DroppedCount();
+        std::atomic<int64_t> producerNs{ 0 };
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < producers; t++) {
+            threads.emplace_back([&]() {
+                const auto begin = std::chrono::steady_clock::now();
+                for (int i = 0; i < kPerThread; i++) pipeline.Submit(message);
+                producerNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        pipeline.Flush();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t dropped = pipeline.DroppedCount() - droppedBefore;
+        const uint64_t written = static_cast<uint64_t>(producers) * kPerThread - dropped;
+        std::cout << "producers=" << producers << " ns/call=" << (static_cast<double>(producerNs.load()) / (producers * kPerThread))
+                  << " lines/s=" << (static_cast<double>(written) / seconds) << " dropped=" << dropped << '\n';
+    }
+    pipeline.Stop();
+    return 0;
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"single_producer_preserves_order", &SingleProducerPreservesOrder},
+        {"lines_use_timestamp_prefix", &LinesUseTimestampPrefix},
+        {"long_messages_span_slots", &LongMessagesSpanSlots},
+        {"oversized_messages_are_truncated", &OversizedMessagesAreTruncated},
+        {"full_ring_drops_and_reports", &FullRingDropsAndReports},
+        {"rejected_batches_are_retained", &RejectedBatchesAreRetained},
+        {"writer_backs_off_while_sink_rejects", &WriterBacksOffWhileSinkRejects},
+        {"multi_producer_delivers_every_message", &MultiProducerDeliversEveryMessage},
+        {"writer_wakes_on_submit", &WriterWakesOnSubmit},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
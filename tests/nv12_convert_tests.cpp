@@ -0,0 +1,334 @@
+#include "common/nv12_convert.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+// The virtual camera's original per-block converter, kept verbatim as the bit-exact reference.
+// It only handles even dimensions.
+uint8_t LegacyClampToByte(int32_t val) {
+    if (val < 0) return 0;
+    if (val > 255) return 255;
+    return static_cast<uint8_t>(val);
+}
+
+void LegacyConvertRgbaToNv12(const uint8_t* rgba, uint8_t* nv12, uint32_t width, uint32_t height, bool bt709) {
+    const uint32_t yPlaneSize = width * height;
+    uint8_t* yPlane = nv12;
+    uint8_t* uvPlane = nv12 + yPlaneSize;
+    const uint32_t stride = width * 4;
+
+    const int32_t yR = bt709 ? 47 : 66;
+    const int32_t yG = bt709 ? 157 : 129;
+    const int32_t yB = bt709 ? 16 : 25;
+    const int32_t uR = bt709 ? -26 : -38;
+    const int32_t uG = bt709 ? -87 : -74;
+    const int32_t uB = 112;
+    const int32_t vR = 112;
+    const int32_t vG = bt709 ? -102 : -94;
+    const int32_t vB = bt709 ? -10 : -18;
+
+    for (uint32_t y = 0; y < height; y += 2) {
+        const uint8_t* srcRow0 = rgba + (height - 1 - y) * stride;
+        const uint8_t* srcRow1 = rgba + (height - 2 - y) * stride;
+        uint8_t* yRow0 = yPlane + y * width;
+        uint8_t* yRow1 = yPlane + (y + 1) * width;
+        uint8_t* uvRow = uvPlane + (y / 2) * width;
+
+        for (uint32_t x = 0; x < width; x += 2) {
+            const uint8_t* p00 = srcRow0 + x * 4;
+            const uint8_t* p10 = srcRow0 + (x + 1) * 4;
+            const uint8_t* p01 = srcRow1 + x * 4;
+            const uint8_t* p11 = srcRow1 + (x + 1) * 4;
+
+            int32_t y00 = ((yR * p00[0] + yG * p00[1] + yB * p00[2] + 128) >> 8) + 16;
+            int32_t y10 = ((yR * p10[0] + yG * p10[1] + yB * p10[2] + 128) >> 8) + 16;
+            int32_t y01 = ((yR * p01[0] + yG * p01[1] + yB * p01[2] + 128) >> 8) + 16;
+            int32_t y11 = ((yR * p11[0] + yG * p11[1] + yB * p11[2] + 128) >> 8) + 16;
+
+            yRow0[x] = LegacyClampToByte(y00);
+            yRow0[x + 1] = LegacyClampToByte(y10);
+            yRow1[x] = LegacyClampToByte(y01);
+            yRow1[x + 1] = LegacyClampToByte(y11);
+
+            int32_t avgR = (p00[0] + p10[0] + p01[0] + p11[0] + 2) >> 2;
+            int32_t avgG = (p00[1] + p10[1] + p01[1] + p11[1] + 2) >> 2;
+            int32_t avgB = (p00[2] + p10[2] + p01[2] + p11[2] + 2) >> 2;
+
+            int32_t u = ((uR * avgR + uG * avgG + uB * avgB + 128) >> 8) + 128;
+            int32_t v = ((vR * avgR + vG * avgG + vB * avgB + 128) >> 8) + 128;
+
+            uvRow[x] = LegacyClampToByte(u);
+            uvRow[x + 1] = LegacyClampToByte(v);
+        }
+    }
+}
+
+std::vector<uint8_t> RandomRgba(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+    for (auto& byte : rgba) byte = static_cast<uint8_t>(rng());
+    return rgba;
+}
+
+const SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2 };
+const Nv12ColorMatrix kAllMatrices[] = { Nv12ColorMatrix::Bt601, Nv12ColorMatrix::Bt709 };
+
+std::string Describe(SimdLevel kernel, Nv12ColorMatrix matrix, uint32_t width, uint32_t height) {
+    return std::string(GetSimdLevelName(kernel)) + (matrix == Nv12ColorMatrix::Bt709 ? " BT.709 " : " BT.601 ") +
+           std::to_string(width) + "x" + std::to_string(height);
+}
+
+std::vector<uint8_t> Convert(SimdLevel kernel, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height, Nv12ColorMatrix matrix) {
+    // Guard bytes past the frame catch any kernel writing beyond GetNv12FrameBytes.
+    std::vector<uint8_t> nv12(GetNv12FrameBytes(width, height) + 64u, 0xCD);
+    ConvertRgbaToNv12Rows(kernel, rgba.data(), nv12.data(), width, height, matrix, 0, (height + 1u) / 2u);
+    return nv12;
+}
+
+bool GuardIntact(const std::vector<uint8_t>& nv12, uint32_t width, uint32_t height) {
+    for (size_t i = GetNv12FrameBytes(width, height); i < nv12.size(); ++i) {
+        if (nv12[i] != 0xCD) return false;
+    }
+    return true;
+}
+
+void ReportsKernelSupport() {
+    Check(IsSimdLevelSupported(SimdLevel::Scalar), "scalar kernel is always available");
+    Check(IsSimdLevelSupported(GetBestSimdLevel()), "active kernel is supported");
+    if (IsSimdLevelSupported(SimdLevel::Avx2)) {
+        Check(GetBestSimdLevel() == SimdLevel::Avx2, "AVX2 is preferred when available");
+    }
+    std::cout << "  active kernel: " << GetSimdLevelName(GetBestSimdLevel()) << '\n';
+    Check(GetNv12FrameBytes(1920, 1080) == 1920u * 1080u * 3u / 2u, "even frame size");
+    Check(GetNv12FrameBytes(5, 3) == 15u + 6u * 2u, "odd frame size rounds the chroma plane up");
+}
+
+void KernelsMatchLegacyConverter() {
+    const uint32_t sizes[][2] = { { 2, 2 }, { 8, 2 }, { 16, 4 }, { 18, 6 }, { 30, 10 }, { 64, 36 }, { 1280, 720 }, { 854, 480 } };
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        const std::vector<uint8_t> rgba = RandomRgba(width, height, width * 131u + height);
+        for (Nv12ColorMatrix matrix : kAllMatrices) {
+            std::vector<uint8_t> expected(GetNv12FrameBytes(width, height));
+            LegacyConvertRgbaToNv12(rgba.data(), expected.data(), width, height, matrix == Nv12ColorMatrix::Bt709);
+            for (SimdLevel kernel : kAllLevels) {
+                if (!IsSimdLevelSupported(kernel)) continue;
+                const std::vector<uint8_t> actual = Convert(kernel, rgba, width, height, matrix);
+                Check(std::memcmp(actual.data(), expected.data(), expected.size()) == 0, Describe(kernel, matrix, width, height) + " matches legacy output");
+                Check(GuardIntact(actual, width, height), Describe(kernel, matrix, width, height) + " stays inside the frame");
+            }
+        }
+    }
+}
+
+void ExtremeColorsMatchLegacyConverter() {
+    // Saturated and mixed primaries push every intermediate to its range limit.
+    const uint8_t palette[][4] = { { 0, 0, 0, 0 },     { 255, 255, 255, 255 }, { 255, 0, 0, 255 }, { 0, 255, 0, 0 },
+                                   { 0, 0, 255, 255 }, { 255, 255, 0, 0 },     { 0, 255, 255, 255 }, { 255, 0, 255, 0 } };
+    const uint32_t width = 48;
+    const uint32_t height = 8;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4u);
+    std::mt19937 rng(7);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+        std::memcpy(&rgba[i * 4u], palette[rng() % 8u], 4);
+    }
+    for (Nv12ColorMatrix matrix : kAllMatrices) {
+        std::vector<uint8_t> expected(GetNv12FrameBytes(width, height));
+        LegacyConvertRgbaToNv12(rgba.data(), expected.data(), width, height, matrix == Nv12ColorMatrix::Bt709);
+        for (SimdLevel kernel : kAllLevels) {
+            if (!IsSimdLevelSupported(kernel)) continue;
+            const std::vector<uint8_t> actual = Convert(kernel, rgba, width, height, matrix);
+            Check(std::memcmp(actual.data(), expected.data(), expected.size()) == 0, Describe(kernel, matrix, width, height) + " extreme colors");
+        }
+    }
+}
+
+void OddDimensionsReplicateEdges() {
+    const uint32_t sizes[][2] = { { 1, 1 }, { 3, 1 }, { 1, 4 }, { 17, 9 }, { 33, 3 }, { 255, 7 } };
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        const uint32_t paddedWidth = width + (width & 1u);
+        const uint32_t paddedHeight = height + (height & 1u);
+        const std::vector<uint8_t> rgba = RandomRgba(width, height, width * 7u + height);
+
+        // Padding the image by repeating its last column and its top (last output) row gives an
+        // even frame whose legacy conversion defines the expected chroma for the odd one.
+        std::vector<uint8_t> padded(static_cast<size_t>(paddedWidth) * paddedHeight * 4u);
+        for (uint32_t outRow = 0; outRow < paddedHeight; ++outRow) {
+            const uint32_t srcOutRow = outRow < height ? outRow : height - 1u;
+            const uint8_t* src = rgba.data() + static_cast<size_t>(height - 1u - srcOutRow) * width * 4u;
+            uint8_t* dst = padded.data() + static_cast<size_t>(paddedHeight - 1u - outRow) * paddedWidth * 4u;
+            for (uint32_t x = 0; x < paddedWidth; ++x) {
+                std::memcpy(dst + x * 4u, src + (x < width ? x : width - 1u) * 4u, 4);
+            }
+        }
+
+        for (Nv12ColorMatrix matrix : kAllMatrices) {
+            std::vector<uint8_t> reference(GetNv12FrameBytes(paddedWidth, paddedHeight));
+            LegacyConvertRgbaToNv12(padded.data(), reference.data(), paddedWidth, paddedHeight, matrix == Nv12ColorMatrix::Bt709);
+            std::vector<uint8_t> expected(GetNv12FrameBytes(width, height));
+            for (uint32_t y = 0; y < height; ++y) {
+                std::memcpy(expected.data() + static_cast<size_t>(y) * width, reference.data() + static_cast<size_t>(y) * paddedWidth, width);
+            }
+            std::memcpy(expected.data() + static_cast<size_t>(width) * height, reference.data() + static_cast<size_t>(paddedWidth) * paddedHeight,
+                        static_cast<size_t>(paddedWidth) * (paddedHeight / 2u));
+
+            for (SimdLevel kernel : kAllLevels) {
+                if (!IsSimdLevelSupported(kernel)) continue;
+                const std::vector<uint8_t> actual = Convert(kernel, rgba, width, height, matrix);
+                Check(std::memcmp(actual.data(), expected.data(), expected.size()) == 0, Describe(kernel, matrix, width, height) + " odd edges");
+                Check(GuardIntact(actual, width, height), Describe(kernel, matrix, width, height) + " stays inside the frame");
+            }
+        }
+    }
+}
+
+void RowBandsComposeFullFrame() {
+    const uint32_t width = 200;
+    const uint32_t height = 75;
+    const std::vector<uint8_t> rgba = RandomRgba(width, height, 99);
+    for (SimdLevel kernel : kAllLevels) {
+        if (!IsSimdLevelSupported(kernel)) continue;
+        const std::vector<uint8_t> full = Convert(kernel, rgba, width, height, Nv12ColorMatrix::Bt709);
+
+        std::vector<uint8_t> banded(full.size(), 0xCD);
+        const uint32_t rowPairs = (height + 1u) / 2u;
+        const uint32_t bands[] = { 0, 5, 6, 19, rowPairs + 3u };
+        for (size_t i = 0; i + 1 < std::size(bands); ++i) {
+            ConvertRgbaToNv12Rows(kernel, rgba.data(), banded.data(), width, height, Nv12ColorMatrix::Bt709, bands[i], bands[i + 1]);
+        }
+        Check(banded == full, std::string(GetSimdLevelName(kernel)) + " banded conversion matches full frame");
+    }
+
+    std::vector<uint8_t> untouched(GetNv12FrameBytes(width, height), 0xAB);
+    ConvertRgbaToNv12Rows(SimdLevel::Scalar, rgba.data(), untouched.data(), width, height, Nv12ColorMatrix::Bt601, 10, 10);
+    Check(untouched == std::vector<uint8_t>(untouched.size(), 0xAB), "empty band writes nothing");
+}
+
+void DispatchMatchesScalar() {
+    const uint32_t width = 1920;
+    const uint32_t height = 1080;
+    const std::vector<uint8_t> rgba = RandomRgba(width, height, 1);
+    std::vector<uint8_t> dispatched(GetNv12FrameBytes(width, height));
+    ConvertRgbaToNv12(rgba.data(), dispatched.data(), width, height, Nv12ColorMatrix::Bt709);
+    std::vector<uint8_t> scalar = Convert(SimdLevel::Scalar, rgba, width, height, Nv12ColorMatrix::Bt709);
+    scalar.resize(dispatched.size());
+    Check(dispatched == scalar, "dispatched kernel matches scalar at 1920x1080");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"reports_kernel_support", &ReportsKernelSupport},
+        {"kernels_match_legacy_converter", &KernelsMatchLegacyConverter},
+        {"extreme_colors_match_legacy_converter", &ExtremeColorsMatchLegacyConverter},
+        {"odd_dimensions_replicate_edges", &OddDimensionsReplicateEdges},
+        {"row_bands_compose_full_frame", &RowBandsComposeFullFrame},
+        {"dispatch_matches_scalar", &DispatchMatchesScalar},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+template <typename Fn>
+double MeasureMsPerFrame(int iterations, Fn&& fn) {
+    fn();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int RunBenchmark() {
+    const uint32_t sizes[][2] = { { 1280, 720 }, { 1920, 1080 }, { 2560, 1440 } };
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& size : sizes) {
+        const uint32_t width = size[0];
+        const uint32_t height = size[1];
+        const std::vector<uint8_t> rgba = RandomRgba(width, height, 3);
+        std::vector<uint8_t> nv12(GetNv12FrameBytes(width, height));
+        const int iterations = 60;
+
+        const double legacyMs =
+            MeasureMsPerFrame(iterations, [&]() { LegacyConvertRgbaToNv12(rgba.data(), nv12.data(), width, height, true); });
+        std::cout << width << "x" << height << "  legacy  " << legacyMs << " ms/frame\n";
+        for (SimdLevel kernel : kAllLevels) {
+            if (!IsSimdLevelSupported(kernel)) continue;
+            const double ms = MeasureMsPerFrame(iterations, [&]() {
+                ConvertRgbaToNv12Rows(kernel, rgba.data(), nv12.data(), width, height, Nv12ColorMatrix::Bt709, 0, (height + 1u) / 2u);
+            });
+            std::cout << width << "x" << height << "  " << std::left << std::setw(7) << GetSimdLevelName(kernel) << std::right << " " << ms
+                      << " ms/frame (" << legacyMs / ms << "x)\n";
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
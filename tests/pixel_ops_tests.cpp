@@ -0,0 +1,366 @@
+#include "common/pixel_ops.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+struct FloatColorKey {
+    float r, g, b;
+    float sensitivity;
+};
+
+// The window overlay's original per-pixel float loop, kept as the reference implementation.
+void LegacyConvertColorKeyed(uint8_t* pixels, int totalPixels, const std::vector<FloatColorKey>& colorKeys) {
+    for (int i = 0; i < totalPixels; i++) {
+        unsigned char* pixel = &pixels[i * 4];
+        std::swap(pixel[0], pixel[2]);
+
+        float r = pixel[0] / 255.0f;
+        float g = pixel[1] / 255.0f;
+        float b = pixel[2] / 255.0f;
+
+        bool matchesAnyKey = false;
+        for (const auto& key : colorKeys) {
+            float dr = r - key.r;
+            float dg = g - key.g;
+            float db = b - key.b;
+            float distanceSq = dr * dr + dg * dg + db * db;
+            float sensitivitySq = key.sensitivity * key.sensitivity;
+
+            if (distanceSq <= sensitivitySq) {
+                matchesAnyKey = true;
+                break;
+            }
+        }
+
+        pixel[3] = matchesAnyKey ? 0 : 255;
+    }
+}
+
+void LegacyConvertOpaque(uint8_t* pixels, int totalPixels) {
+    for (int i = 0; i < totalPixels; i++) {
+        unsigned char* pixel = &pixels[i * 4];
+        std::swap(pixel[0], pixel[2]);
+        pixel[3] = 255;
+    }
+}
+
+const SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2 };
+
+ColorKeyMatcher BuildMatcher(const std::vector<FloatColorKey>& keys) {
+    ColorKeyMatcher matcher;
+    for (const FloatColorKey& key : keys) matcher.AddKey(key.r, key.g, key.b, key.sensitivity);
+    return matcher;
+}
+
+std::vector<uint8_t> RandomPixels(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> pixels(count * 4u);
+    for (auto& byte : pixels) byte = static_cast<uint8_t>(rng());
+    return pixels;
+}
+
+// The float reference and the fixed-point kernels may only disagree on pixels whose distance is
+// within one quantization step of a key's radius. Returns the number of disagreements that are
+// not explained by that.
+size_t CountUnexplainedMismatches(const std::vector<uint8_t>& source, const std::vector<uint8_t>& expected,
+                                  const std::vector<uint8_t>& actual, const std::vector<FloatColorKey>& keys, size_t& outMismatches) {
+    constexpr double kKeyStep = 0.5 / (255.0 * 64.0);
+    size_t unexplained = 0;
+    outMismatches = 0;
+    for (size_t i = 0; i < expected.size(); i += 4) {
+        if (std::memcmp(&expected[i], &actual[i], 3) != 0) {
+            ++unexplained;
+            continue;
+        }
+        if (expected[i + 3] == actual[i + 3]) continue;
+
+        ++outMismatches;
+        bool nearBoundary = false;
+        for (const FloatColorKey& key : keys) {
+            const double dr = source[i + 2] / 255.0 - key.r;
+            const double dg = source[i + 1] / 255.0 - key.g;
+            const double db = source[i + 0] / 255.0 - key.b;
+            const double distance = std::sqrt(dr * dr + dg * dg + db * db);
+            const double radius = std::fabs(static_cast<double>(key.sensitivity));
+            if (std::fabs(distance - radius) <= 2.0 * kKeyStep + 1e-6) nearBoundary = true;
+        }
+        if (!nearBoundary) ++unexplained;
+    }
+    return unexplained;
+}
+
+void OpaqueSwizzleMatchesLegacy() {
+    for (size_t count : { size_t{ 1 }, size_t{ 3 }, size_t{ 4 }, size_t{ 7 }, size_t{ 8 }, size_t{ 9 }, size_t{ 31 }, size_t{ 1000 } }) {
+        const std::vector<uint8_t> source = RandomPixels(count, static_cast<uint32_t>(count));
+        std::vector<uint8_t> expected = source;
+        LegacyConvertOpaque(expected.data(), static_cast<int>(count));
+        for (SimdLevel level : kAllLevels) {
+            if (!IsSimdLevelSupported(level)) continue;
+            std::vector<uint8_t> actual = source;
+            actual.resize(actual.size() + 32u, 0xCD);
+            ConvertBgraToRgbaOpaque(level, actual.data(), count);
+            Check(std::memcmp(actual.data(), expected.data(), expected.size()) == 0,
+                  std::string(GetSimdLevelName(level)) + " opaque swizzle of " + std::to_string(count) + " pixels");
+            Check(actual.back() == 0xCD, std::string(GetSimdLevelName(level)) + " stays inside the buffer");
+        }
+    }
+}
+
+void LevelsAgreeExactly() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int round = 0; round < 20; ++round) {
+        std::vector<FloatColorKey> keys;
+        const int keyCount = 1 + round % 8;
+        for (int k = 0; k < keyCount; ++k) keys.push_back({ unit(rng), unit(rng), unit(rng), unit(rng) * 0.3f });
+        const ColorKeyMatcher matcher = BuildMatcher(keys);
+
+        const size_t count = 1021;
+        const std::vector<uint8_t> source = RandomPixels(count, static_cast<uint32_t>(round));
+        std::vector<uint8_t> scalar = source;
+        ConvertBgraToRgbaColorKeyed(SimdLevel::Scalar, scalar.data(), count, matcher);
+        for (SimdLevel level : kAllLevels) {
+            if (!IsSimdLevelSupported(level)) continue;
+            std::vector<uint8_t> actual = source;
+            ConvertBgraToRgbaColorKeyed(level, actual.data(), count, matcher);
+            Check(actual == scalar, std::string(GetSimdLevelName(level)) + " matches scalar fixed point, round " + std::to_string(round));
+        }
+    }
+}
+
+void ColorKeyMatchesFloatReference() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t totalMismatches = 0;
+    size_t totalPixels = 0;
+    for (int round = 0; round < 40; ++round) {
+        std::vector<FloatColorKey> keys;
+        const int keyCount = 1 + round % 8;
+        for (int k = 0; k < keyCount; ++k) {
+            // Mix picker-style byte colors with arbitrary floats and both tiny and broad radii.
+            if (k % 2 == 0) {
+                keys.push_back({ static_cast<float>(rng() % 256) / 255.0f, static_cast<float>(rng() % 256) / 255.0f,
+                                 static_cast<float>(rng() % 256) / 255.0f, (k % 4 == 0) ? 0.001f : 0.05f });
+            } else {
+                keys.push_back({ unit(rng), unit(rng), unit(rng), unit(rng) * 0.5f });
+            }
+        }
+        const ColorKeyMatcher matcher = BuildMatcher(keys);
+
+        const size_t count = 4096;
+        std::vector<uint8_t> source = RandomPixels(count, static_cast<uint32_t>(1000 + round));
+        // Plant exact key colors so near-zero distances are exercised too.
+        for (size_t i = 0; i < count; i += 17) {
+            const FloatColorKey& key = keys[i % keys.size()];
+            source[i * 4 + 2] = static_cast<uint8_t>(std::lround(key.r * 255.0f));
+            source[i * 4 + 1] = static_cast<uint8_t>(std::lround(key.g * 255.0f));
+            source[i * 4 + 0] = static_cast<uint8_t>(std::lround(key.b * 255.0f));
+        }
+
+        std::vector<uint8_t> expected = source;
+        LegacyConvertColorKeyed(expected.data(), static_cast<int>(count), keys);
+        for (SimdLevel level : kAllLevels) {
+            if (!IsSimdLevelSupported(level)) continue;
+            std::vector<uint8_t> actual = source;
+            ConvertBgraToRgbaColorKeyed(level, actual.data(), count, matcher);
+            size_t mismatches = 0;
+            const size_t unexplained = CountUnexplainedMismatches(source, expected, actual, keys, mismatches);
+            Check(unexplained == 0, std::string(GetSimdLevelName(level)) + " round " + std::to_string(round) + " has " +
+                                        std::to_string(unexplained) + " mismatches away from a key boundary");
+            totalMismatches += mismatches;
+            totalPixels += count;
+        }
+    }
+    std::cout << "  boundary disagreements with float reference: " << totalMismatches << " of " << totalPixels << " pixels\n";
+    Check(totalMismatches * 1000u < totalPixels, "boundary disagreements stay below 0.1%");
+}
+
+void ExactKeyColorsAlwaysMatch() {
+    ColorKeyMatcher matcher;
+    matcher.AddKey(1.0f, 0.0f, 1.0f, 0.0f);
+    matcher.AddKey(12.0f / 255.0f, 200.0f / 255.0f, 33.0f / 255.0f, 0.001f);
+    Check(matcher.Matches(255, 0, 255), "zero sensitivity still keys the exact color");
+    Check(!matcher.Matches(254, 0, 255), "zero sensitivity rejects neighbors");
+    Check(matcher.Matches(12, 200, 33), "exact byte color matches");
+    Check(!matcher.Matches(12, 201, 33), "0.001 sensitivity is narrower than one byte step");
+
+    ColorKeyMatcher broad;
+    broad.AddKey(0.5f, 0.5f, 0.5f, 10.0f);
+    Check(broad.GetKeys()[0].maxDistanceSq == (std::numeric_limits<int32_t>::max)(), "huge sensitivity saturates the threshold");
+    Check(broad.Matches(0, 0, 0) && broad.Matches(255, 255, 255), "huge sensitivity keys everything");
+
+    ColorKeyMatcher outOfRange;
+    outOfRange.AddKey(-1.0f, 2.0f, 0.0f, 0.001f);
+    Check(outOfRange.Matches(0, 255, 0), "key channels are clamped to the displayable range");
+}
+
+void ManyKeysFallBackToScalar() {
+    std::vector<FloatColorKey> keys;
+    for (int k = 0; k < 24; ++k) keys.push_back({ k / 24.0f, 1.0f - k / 24.0f, 0.5f, 0.04f });
+    const ColorKeyMatcher matcher = BuildMatcher(keys);
+    const std::vector<uint8_t> source = RandomPixels(333, 77);
+    std::vector<uint8_t> scalar = source;
+    ConvertBgraToRgbaColorKeyed(SimdLevel::Scalar, scalar.data(), 333, matcher);
+    std::vector<uint8_t> dispatched = source;
+    ConvertBgraToRgbaColorKeyed(dispatched.data(), 333, matcher);
+    Check(dispatched == scalar, "24 keys give the same result through the dispatcher");
+
+    std::vector<uint8_t> noKeys = source;
+    ConvertBgraToRgbaColorKeyed(noKeys.data(), 333, ColorKeyMatcher{});
+    std::vector<uint8_t> opaque = source;
+    LegacyConvertOpaque(opaque.data(), 333);
+    Check(noKeys == opaque, "an empty key set is the opaque swizzle");
+}
+
+void FrameHashDetectsChanges() {
+    Check(HashFrameBytes("", 0) == 0xEF46DB3751D8E999ull, "empty input matches the XXH64 reference");
+    Check(HashFrameBytes("abc", 3) == 0x44BC2CF5AD770999ull, "short input matches the XXH64 reference");
+    const char* sentence = "Nobody inspects the spammish repetition";
+    Check(HashFrameBytes(sentence, std::strlen(sentence)) == 0xFBCEA83C8A378BF1ull, "striped input matches the XXH64 reference");
+
+    std::vector<uint8_t> frame = RandomPixels(641 * 3, 9);
+    const uint64_t baseline = HashFrameBytes(frame.data(), frame.size());
+    Check(HashFrameBytes(frame.data(), frame.size()) == baseline, "hash is deterministic");
+    for (size_t offset : { size_t{ 0 }, size_t{ 31 }, size_t{ 32 }, frame.size() / 2, frame.size() - 5, frame.size() - 1 }) {
+        frame[offset] ^= 0x01;
+        Check(HashFrameBytes(frame.data(), frame.size()) != baseline, "a single flipped bit changes the hash");
+        frame[offset] ^= 0x01;
+    }
+    Check(HashFrameBytes(frame.data(), frame.size() - 4) != baseline, "a shorter frame hashes differently");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"opaque_swizzle_matches_legacy", &OpaqueSwizzleMatchesLegacy},
+        {"levels_agree_exactly", &LevelsAgreeExactly},
+        {"color_key_matches_float_reference", &ColorKeyMatchesFloatReference},
+        {"exact_key_colors_always_match", &ExactKeyColorsAlwaysMatch},
+        {"many_keys_fall_back_to_scalar", &ManyKeysFallBackToScalar},
+        {"frame_hash_detects_changes", &FrameHashDetectsChanges},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+template <typename Fn>
+double MeasureMegapixelsPerSecond(size_t pixelCount, int iterations, Fn&& fn) {
+    fn();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(pixelCount) * iterations / seconds / 1e6;
+}
+
+int RunBenchmark() {
+    const size_t pixelCount = 1920u * 1080u;
+    const std::vector<uint8_t> source = RandomPixels(pixelCount, 1);
+    std::vector<uint8_t> work(source.size());
+    const int iterations = 30;
+    std::cout << std::fixed << std::setprecision(1) << "1920x1080 frame, throughput in Mpixel/s\n";
+
+    const double legacyOpaque = MeasureMegapixelsPerSecond(pixelCount, iterations, [&]() {
+        std::memcpy(work.data(), source.data(), source.size());
+        LegacyConvertOpaque(work.data(), static_cast<int>(pixelCount));
+    });
+    std::cout << "opaque    legacy  " << legacyOpaque << '\n';
+    for (SimdLevel level : kAllLevels) {
+        if (!IsSimdLevelSupported(level)) continue;
+        const double mps = MeasureMegapixelsPerSecond(pixelCount, iterations, [&]() {
+            std::memcpy(work.data(), source.data(), source.size());
+            ConvertBgraToRgbaOpaque(level, work.data(), pixelCount);
+        });
+        std::cout << "opaque    " << std::left << std::setw(7) << GetSimdLevelName(level) << std::right << " " << mps << '\n';
+    }
+
+    for (int keyCount : { 1, 4, 8 }) {
+        std::vector<FloatColorKey> keys;
+        for (int k = 0; k < keyCount; ++k) keys.push_back({ k / 8.0f, 0.25f, 1.0f - k / 8.0f, 0.05f });
+        const ColorKeyMatcher matcher = BuildMatcher(keys);
+        const double legacy = MeasureMegapixelsPerSecond(pixelCount, iterations, [&]() {
+            std::memcpy(work.data(), source.data(), source.size());
+            LegacyConvertColorKeyed(work.data(), static_cast<int>(pixelCount), keys);
+        });
+        std::cout << keyCount << " key(s)  legacy  " << legacy << '\n';
+        for (SimdLevel level : kAllLevels) {
+            if (!IsSimdLevelSupported(level)) continue;
+            const double mps = MeasureMegapixelsPerSecond(pixelCount, iterations, [&]() {
+                std::memcpy(work.data(), source.data(), source.size());
+                ConvertBgraToRgbaColorKeyed(level, work.data(), pixelCount, matcher);
+            });
+            std::cout << keyCount << " key(s)  " << std::left << std::setw(7) << GetSimdLevelName(level) << std::right << " " << mps << " ("
+                      << mps / legacy << "x)\n";
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
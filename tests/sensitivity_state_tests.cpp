@@ -0,0 +1,403 @@
+#include "hooks/sensitivity_state.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+SensitivityState MakeState(float x, float y) {
+    SensitivityInputs inputs;
+    inputs.globalSensitivity = 1.0f;
+    inputs.overrideActive = true;
+    inputs.overrideX = x;
+    inputs.overrideY = y;
+    return ComputeSensitivityState(inputs);
+}
+
+// The raw input hook's original float accumulator, kept as the reference implementation.
+struct LegacyAccumulator {
+    float xAccum = 0.0f;
+    float yAccum = 0.0f;
+    float lastSensitivityX = 1.0f;
+    float lastSensitivityY = 1.0f;
+    bool hasLastSensitivity = false;
+
+    void Apply(float sensitivityX, float sensitivityY, long& x, long& y) {
+        const bool sensitivityChanged = !hasLastSensitivity || (std::fabs(sensitivityX - lastSensitivityX) > 0.000001f) ||
+                                        (std::fabs(sensitivityY - lastSensitivityY) > 0.000001f);
+        if (sensitivityChanged) {
+            xAccum = 0.0f;
+            yAccum = 0.0f;
+            lastSensitivityX = sensitivityX;
+            lastSensitivityY = sensitivityY;
+            hasLastSensitivity = true;
+        }
+        const long rawX = x;
+        const long rawY = y;
+        if (rawX != 0 && xAccum != 0.0f && ((rawX > 0) != (xAccum > 0.0f))) { xAccum = 0.0f; }
+        if (rawY != 0 && yAccum != 0.0f && ((rawY > 0) != (yAccum > 0.0f))) { yAccum = 0.0f; }
+        if (sensitivityX != 1.0f || sensitivityY != 1.0f) {
+            xAccum += rawX * sensitivityX;
+            yAccum += rawY * sensitivityY;
+            const long outputX = static_cast<long>(std::round(xAccum));
+            const long outputY = static_cast<long>(std::round(yAccum));
+            xAccum -= static_cast<float>(outputX);
+            yAccum -= static_cast<float>(outputY);
+            x = outputX;
+            y = outputY;
+        } else {
+            xAccum = 0.0f;
+            yAccum = 0.0f;
+        }
+    }
+};
+
+void FractionalMovementCarriesBetweenPackets() {
+    const SensitivityState state = MakeState(0.3f, 0.3f);
+    SensitivityAccumulator accumulator;
+    int64_t totalX = 0;
+    int64_t totalY = 0;
+    for (int i = 0; i < 1000; ++i) {
+        int32_t dx = 1;
+        int32_t dy = 1;
+        accumulator.Apply(state, dx, dy);
+        totalX += dx;
+        totalY += dy;
+    }
+    Check(totalX == 300, "1000 one-count packets at 0.3 should produce 300 counts, got " + std::to_string(totalX));
+    Check(totalY == 300, "Y axis should match X, got " + std::to_string(totalY));
+}
+
+void MatchesIdealScaledSumWithinOneCount() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> delta(1, 40);
+    for (float sensitivity : { 0.05f, 0.37f, 0.5f, 1.25f, 2.0f, 3.7f }) {
+        const SensitivityState state = MakeState(sensitivity, sensitivity);
+        SensitivityAccumulator accumulator;
+        int64_t input = 0;
+        int64_t output = 0;
+        for (int i = 0; i < 20000; ++i) {
+            int32_t dx = delta(rng);
+            int32_t dy = 0;
+            input += dx;
+            accumulator.Apply(state, dx, dy);
+            output += dx;
+        }
+        const double ideal = static_cast<double>(input) * state.scaleX / SensitivityState::kOne;
+        Check(std::fabs(static_cast<double>(output) - ideal) <= 1.0,
+              "sensitivity " + std::to_string(sensitivity) + ": output " + std::to_string(output) + " drifted from ideal " + std::to_string(ideal));
+    }
+}
+
+void RoundingUpKeepsNegativeRemainder() {
+    // Rounding 0.6 up to 1 leaves -0.4. The float path this replaced mistook that for a direction reversal and
+    // dropped it, so small movements at 0.3 came out at 0.5.
+    const SensitivityState state = MakeState(0.3f, 0.3f);
+    SensitivityAccumulator accumulator;
+    LegacyAccumulator legacy;
+    long legacyTotal = 0;
+    int64_t total = 0;
+    for (int i = 0; i < 10; ++i) {
+        int32_t dx = 1;
+        int32_t dy = 0;
+        accumulator.Apply(state, dx, dy);
+        total += dx;
+        long lx = 1;
+        long ly = 0;
+        legacy.Apply(0.3f, 0.3f, lx, ly);
+        legacyTotal += lx;
+    }
+    Check(total == 3, "ten one-count packets at 0.3 should produce 3 counts, got " + std::to_string(total));
+    Check(legacyTotal == 5, "reference path should show the old drift, got " + std::to_string(legacyTotal));
+}
+
+void DirectionReversalDropsRemainder() {
+    const SensitivityState state = MakeState(0.4f, 1.0f);
+    SensitivityAccumulator accumulator;
+    int32_t dx = 1;
+    int32_t dy = 0;
+    accumulator.Apply(state, dx, dy);
+    Check(dx == 0, "0.4 should round to 0");
+    Check(accumulator.RemainderX() > 0, "positive remainder should be kept");
+
+    dx = -1;
+    dy = 0;
+    accumulator.Apply(state, dx, dy);
+    Check(dx == 0, "reversal should start from a clean remainder, got " + std::to_string(dx));
+    Check(accumulator.RemainderX() < 0, "remainder should now point in the new direction");
+
+    dx = 1;
+    dy = 0;
+    accumulator.Apply(state, dx, dy);
+    dx = 1;
+    dy = 0;
+    accumulator.Apply(state, dx, dy);
+    Check(dx == 1, "0.4 + 0.4 after reversing back should round up to 1, got " + std::to_string(dx));
+    Check(accumulator.RemainderX() < 0, "rounding up should leave a negative remainder");
+    dx = 1;
+    dy = 0;
+    accumulator.Apply(state, dx, dy);
+    Check(dx == 0 && accumulator.RemainderX() > 0, "-0.2 + 0.4 should round to 0 and keep 0.2, got " + std::to_string(dx));
+
+    dx = 0;
+    dy = 0;
+    const int64_t before = accumulator.RemainderX();
+    accumulator.Apply(state, dx, dy);
+    Check(accumulator.RemainderX() == before, "a zero delta should keep the remainder");
+}
+
+void StateChangeResetsRemainder() {
+    SensitivityAccumulator accumulator;
+    int32_t dx = 1;
+    int32_t dy = 1;
+    accumulator.Apply(MakeState(0.4f, 0.4f), dx, dy);
+    Check(accumulator.RemainderX() != 0, "remainder expected after a fractional packet");
+
+    dx = 1;
+    dy = 1;
+    accumulator.Apply(MakeState(0.45f, 0.45f), dx, dy);
+    Check(dx == 0 && dy == 0, "new multiplier should not inherit the old remainder");
+    Check(accumulator.RemainderX() == MakeState(0.45f, 0.45f).scaleX, "remainder should be just this packet's fraction");
+}
+
+void IdentityLeavesInputUnchanged() {
+    SensitivityAccumulator accumulator;
+    int32_t dx = 1;
+    int32_t dy = 1;
+    accumulator.Apply(MakeState(0.4f, 0.4f), dx, dy);
+
+    const SensitivityState identity;
+    Check(identity.IsIdentity(), "default state should be identity");
+    dx = 17;
+    dy = -5;
+    accumulator.Apply(identity, dx, dy);
+    Check(dx == 17 && dy == -5, "identity should pass movement through");
+    Check(accumulator.RemainderX() == 0 && accumulator.RemainderY() == 0, "identity should clear any remainder");
+}
+
+void OverrideTakesPrecedence() {
+    SensitivityInputs inputs;
+    inputs.globalSensitivity = 0.5f;
+    Check(ComputeSensitivityState(inputs).scaleX == SensitivityState::kOne / 2, "global sensitivity applies by default");
+
+    inputs.modeOverrideEnabled = true;
+    inputs.modeX = 2.0f;
+    inputs.modeY = 3.0f;
+    SensitivityState state = ComputeSensitivityState(inputs);
+    Check(state.scaleX == 2 * SensitivityState::kOne && state.scaleY == 3 * SensitivityState::kOne, "mode sensitivity wins over global");
+
+    inputs.overrideActive = true;
+    inputs.overrideX = 0.25f;
+    inputs.overrideY = 0.75f;
+    state = ComputeSensitivityState(inputs);
+    Check(state.scaleX == SensitivityState::kOne / 4 && state.scaleY == 3 * SensitivityState::kOne / 4, "temp override wins over mode");
+}
+
+void ClampsOutOfRangeSensitivity() {
+    Check(SensitivityToFixed(1.0e9f) == 1024 * SensitivityState::kOne, "huge sensitivity should clamp");
+    Check(SensitivityToFixed(std::nanf("")) == SensitivityState::kOne, "NaN should fall back to 1");
+    Check(SensitivityToFixed(INFINITY) == SensitivityState::kOne, "infinity should fall back to 1");
+
+    const SensitivityState state = MakeState(1024.0f, 1024.0f);
+    SensitivityAccumulator accumulator;
+    int32_t dx = (std::numeric_limits<int32_t>::max)();
+    int32_t dy = (std::numeric_limits<int32_t>::min)();
+    accumulator.Apply(state, dx, dy);
+    Check(dx == (std::numeric_limits<int32_t>::max)() && dy == (std::numeric_limits<int32_t>::min)(), "output should saturate");
+}
+
+void PublishedStateIsSeenByReader() {
+    const SensitivityState original = LoadSensitivityState();
+    std::atomic<bool> stop{ false };
+    std::atomic<int> torn{ 0 };
+    std::thread reader([&]() {
+        while (!stop.load(std::memory_order_acquire)) {
+            const SensitivityState state = LoadSensitivityState();
+            // Every published state has scaleY == 2 * scaleX or is the original.
+            if (!(state == original) && state.scaleY != 2 * state.scaleX) torn.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (int i = 1; i <= 20000; ++i) {
+        SensitivityState state;
+        state.scaleX = i;
+        state.scaleY = 2 * i;
+        PublishSensitivityState(state);
+    }
+    stop.store(true, std::memory_order_release);
+    reader.join();
+    Check(torn.load() == 0, "reader observed a torn state");
+    Check(LoadSensitivityState().scaleX == 20000, "last published state should be visible");
+    PublishSensitivityState(original);
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"fractional_movement_carries_between_packets", &FractionalMovementCarriesBetweenPackets},
+        {"matches_ideal_scaled_sum_within_one_count", &MatchesIdealScaledSumWithinOneCount},
+        {"rounding_up_keeps_negative_remainder", &RoundingUpKeepsNegativeRemainder},
+        {"direction_reversal_drops_remainder", &DirectionReversalDropsRemainder},
+        {"state_change_resets_remainder", &StateChangeResetsRemainder},
+        {"identity_leaves_input_unchanged", &IdentityLeavesInputUnchanged},
+        {"override_takes_precedence", &OverrideTakesPrecedence},
+        {"clamps_out_of_range_sensitivity", &ClampsOutOfRangeSensitivity},
+        {"published_state_is_seen_by_reader", &PublishedStateIsSeenByReader},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+// Stand-ins for what the hook used to do per packet: lock the override mutex, load the config snapshot and look the
+// current mode up by name.
+struct LegacyMode {
+    bool sensitivityOverrideEnabled = false;
+    float modeSensitivity = 1.0f;
+};
+
+struct LegacyConfig {
+    float mouseSensitivity = 1.0f;
+    std::map<std::string, LegacyMode> modes;
+};
+
+template <typename Fn>
+double MeasureNanosecondsPerPacket(int packets, Fn&& fn) {
+    fn(packets / 10);
+    const auto start = std::chrono::steady_clock::now();
+    fn(packets);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / packets;
+}
+
+int RunBenchmark() {
+    // One minute of an 8 kHz mouse.
+    const int packets = 8000 * 60;
+    std::vector<int32_t> deltas(4096);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int32_t> delta(-20, 20);
+    for (int32_t& d : deltas) d = delta(rng);
+
+    std::mutex overrideMutex;
+    bool overrideActive = false;
+    auto config = std::make_shared<LegacyConfig>();
+    config->mouseSensitivity = 1.0f;
+    for (int i = 0; i < 24; ++i) config->modes["Mode " + std::to_string(i)] = LegacyMode{ i % 2 == 0, 0.37f };
+    config->modes["Thin"] = LegacyMode{ true, 0.37f };
+    std::shared_ptr<const LegacyConfig> published = config;
+    const std::string currentModeId = "Thin";
+    volatile long sink = 0;
+
+    const double legacyNs = MeasureNanosecondsPerPacket(packets, [&](int count) {
+        LegacyAccumulator accumulator;
+        for (int i = 0; i < count; ++i) {
+            float sensitivity = 1.0f;
+            bool determined = false;
+            {
+                std::lock_guard<std::mutex> lock(overrideMutex);
+                determined = overrideActive;
+            }
+            if (!determined) {
+                std::string modeId = currentModeId;
+                auto snapshot = std::atomic_load(&published);
+                auto mode = snapshot->modes.find(modeId);
+                sensitivity = (mode != snapshot->modes.end() && mode->second.sensitivityOverrideEnabled) ? mode->second.modeSensitivity
+                                                                                                          : snapshot->mouseSensitivity;
+            }
+            long x = deltas[i & 4095];
+            long y = deltas[(i + 1) & 4095];
+            accumulator.Apply(sensitivity, sensitivity, x, y);
+            sink = sink + x + y;
+        }
+    });
+
+    PublishSensitivityState(MakeState(0.37f, 0.37f));
+    const double newNs = MeasureNanosecondsPerPacket(packets, [&](int count) {
+        SensitivityAccumulator accumulator;
+        for (int i = 0; i < count; ++i) {
+            const SensitivityState state = LoadSensitivityState();
+            int32_t x = deltas[i & 4095];
+            int32_t y = deltas[(i + 1) & 4095];
+            accumulator.Apply(state, x, y);
+            sink = sink + x + y;
+        }
+    });
+    PublishSensitivityState(SensitivityState{});
+
+    std::cout << std::fixed << std::setprecision(1) << packets << " packets (60 s at 8 kHz), ns per packet\n";
+    std::cout << "legacy       " << legacyNs << '\n';
+    std::cout << "precomputed  " << newNs << " (" << legacyNs / newNs << "x)\n";
+    std::cout << std::setprecision(4) << "input thread time per second at 8 kHz: legacy " << legacyNs * 8000 / 1e6 << " ms, precomputed "
+              << newNs * 8000 / 1e6 << " ms\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
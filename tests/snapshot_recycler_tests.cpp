@@ -0,0 +1,258 @@
+#include "common/snapshot_recycler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+// Stand-in for Config with the same shape: sections of elements that own strings and small vectors.
+struct FakeElement {
+    std::string id;
+    std::string relativeTo;
+    std::vector<std::string> references;
+    std::vector<unsigned long> keys;
+    int x = 0;
+    int y = 0;
+    float scale = 1.0f;
+};
+
+struct FakeConfig {
+    std::vector<FakeElement> mirrors;
+    std::vector<FakeElement> modes;
+    std::vector<FakeElement> hotkeys;
+    std::string defaultMode;
+    int generation = 0;
+};
+
+FakeConfig MakeConfig(int elementsPerSection) {
+    FakeConfig config;
+    config.defaultMode = "Fullscreen";
+    for (auto* section : { &config.mirrors, &config.modes, &config.hotkeys }) {
+        for (int i = 0; i < elementsPerSection; ++i) {
+            FakeElement element;
+            element.id = "Element number " + std::to_string(i) + " with a name past SSO";
+            element.relativeTo = "bottomRightScreen";
+            element.references = { "First referenced mirror name", "Second referenced mirror name" };
+            element.keys = { 0x11, 0x12, static_cast<unsigned long>(i) };
+            element.x = i;
+            section->push_back(std::move(element));
+        }
+    }
+    return config;
+}
+
+void ReleasedSnapshotIsReused() {
+    SnapshotRecycler<FakeConfig, 2> recycler;
+    FakeConfig config = MakeConfig(4);
+
+    std::shared_ptr<FakeConfig> first = recycler.AcquireCopyOf(config);
+    const FakeConfig* firstAddress = first.get();
+    first.reset();
+
+    config.generation = 7;
+    std::shared_ptr<FakeConfig> second = recycler.AcquireCopyOf(config);
+    Check(second.get() == firstAddress, "released snapshot storage is reused");
+    Check(second->generation == 7, "reused storage holds the new value");
+    Check(second->mirrors.size() == 4 && second->mirrors[3].id == config.mirrors[3].id, "sections are copied");
+    Check(recycler.ReusedCount() == 1 && recycler.AllocatedCount() == 1, "one allocation, one reuse");
+}
+
+void HeldSnapshotIsNeverOverwritten() {
+    SnapshotRecycler<FakeConfig, 2> recycler;
+    FakeConfig config = MakeConfig(2);
+
+    std::shared_ptr<const FakeConfig> held = recycler.AcquireCopyOf(config);
+    for (int i = 1; i <= 10; ++i) {
+        config.generation = i;
+        config.mirrors[0].id = "edit " + std::to_string(i);
+        std::shared_ptr<FakeConfig> next = recycler.AcquireCopyOf(config);
+        Check(next.get() != held.get(), "held snapshot is not handed out again");
+        Check(next->generation == i, "new snapshot holds the edit");
+    }
+    Check(held->generation == 0 && held->mirrors[0].id == MakeConfig(2).mirrors[0].id, "held snapshot is unchanged");
+}
+
+void AllocatesWhenEverySlotIsHeld() {
+    SnapshotRecycler<FakeConfig, 2> recycler;
+    FakeConfig config = MakeConfig(1);
+
+    std::vector<std::shared_ptr<const FakeConfig>> held;
+    for (int i = 0; i < 5; ++i) {
+        config.generation = i;
+        held.push_back(recycler.AcquireCopyOf(config));
+    }
+    Check(recycler.AllocatedCount() == 5 && recycler.ReusedCount() == 0, "every publish allocates while all are held");
+    for (int i = 0; i < 5; ++i) { Check(held[i]->generation == i, "evicted snapshots stay alive for their readers"); }
+}
+
+void SteadyStatePublishDoesNotAllocate() {
+    // Models the RCU publish loop: only the live snapshot (and the recycler) hold a reference between publishes.
+    SnapshotRecycler<FakeConfig> recycler;
+    FakeConfig config = MakeConfig(8);
+    std::shared_ptr<const FakeConfig> live;
+    for (int i = 0; i < 100; ++i) {
+        config.modes[3].x = i;
+        live = recycler.AcquireCopyOf(config);
+    }
+    Check(recycler.AllocatedCount() == 2, "two snapshots alternate in steady state");
+    Check(live->modes[3].x == 99, "live snapshot holds the last edit");
+}
+
+void ReadersSeeConsistentSnapshots() {
+    // Readers check that every field of a snapshot agrees with its generation while a writer keeps republishing.
+    SnapshotRecycler<FakeConfig> recycler;
+    FakeConfig config = MakeConfig(16);
+    auto stamp = [&config](int generation) {
+        config.generation = generation;
+        for (auto* section : { &config.mirrors, &config.modes, &config.hotkeys }) {
+            for (FakeElement& element : *section) {
+                element.y = generation;
+                element.relativeTo.assign(static_cast<size_t>(generation % 7) + 1, 'x');
+            }
+        }
+    };
+    stamp(0);
+    std::atomic<std::shared_ptr<const FakeConfig>> published(recycler.AcquireCopyOf(config));
+    std::atomic<bool> stop{ false };
+    std::atomic<int> torn{ 0 };
+
+    auto reader = [&]() {
+        while (!stop.load(std::memory_order_acquire)) {
+            std::shared_ptr<const FakeConfig> snapshot = published.load(std::memory_order_acquire);
+            const int generation = snapshot->generation;
+            for (int pass = 0; pass < 4; ++pass) {
+                for (const auto* section : { &snapshot->mirrors, &snapshot->modes, &snapshot->hotkeys }) {
+                    for (const FakeElement& element : *section) {
+                        if (element.y != generation || element.relativeTo.size() != static_cast<size_t>(generation % 7) + 1) {
+                            torn.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) readers.emplace_back(reader);
+    for (int generation = 1; generation <= 2000; ++generation) {
+        stamp(generation);
+        published.store(recycler.AcquireCopyOf(config), std::memory_order_release);
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto& thread : readers) thread.join();
+
+    Check(torn.load() == 0, "no reader observed a partially written snapshot");
+    Check(recycler.ReusedCount() > 0, "snapshots were recycled during the run");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"released_snapshot_is_reused", &ReleasedSnapshotIsReused},
+        {"held_snapshot_is_never_overwritten", &HeldSnapshotIsNeverOverwritten},
+        {"allocates_when_every_slot_is_held", &AllocatesWhenEverySlotIsHeld},
+        {"steady_state_publish_does_not_allocate", &SteadyStatePublishDoesNotAllocate},
+        {"readers_see_consistent_snapshots", &ReadersSeeConsistentSnapshots},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+template <typename Fn>
+double MeasureMicroseconds(int iterations, Fn&& fn) {
+    fn();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+// Publish cost after a single-field edit, fresh allocation vs. recycled storage, for growing config sizes.
+int RunBenchmark() {
+    std::cout << std::fixed << std::setprecision(2);
+    for (int elements : { 4, 16, 64, 256 }) {
+        FakeConfig config = MakeConfig(elements);
+        std::atomic<std::shared_ptr<const FakeConfig>> published;
+        int edit = 0;
+
+        const double freshUs = MeasureMicroseconds(2000, [&]() {
+            config.modes[0].x = ++edit;
+            published.store(std::make_shared<const FakeConfig>(config), std::memory_order_release);
+        });
+
+        SnapshotRecycler<FakeConfig> recycler;
+        const double recycledUs = MeasureMicroseconds(2000, [&]() {
+            config.modes[0].x = ++edit;
+            published.store(recycler.AcquireCopyOf(config), std::memory_order_release);
+        });
+
+        std::cout << 3 * elements << " elements: fresh " << freshUs << " us, recycled " << recycledUs << " us ("
+                  << freshUs / recycledUs << "x)\n";
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--bench") == 0) {
+        return RunBenchmark();
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list | --bench]\n";
+    return 2;
+}
@@ -0,0 +1,453 @@
+#include "common/video_media.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Live and peak operator-new bytes across the whole test binary, used to check that streaming
+// memory is bounded by the ring rather than by the clip length.
+namespace {
+std::atomic<int64_t> g_liveBytes{ 0 };
+std::atomic<int64_t> g_peakBytes{ 0 };
+
+void TrackAllocation(int64_t bytes) {
+    const int64_t live = g_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = g_peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+} // namespace
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size + sizeof(std::max_align_t));
+    if (!block) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    TrackAllocation(static_cast<int64_t>(size));
+    return static_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - sizeof(std::max_align_t);
+    TrackAllocation(-static_cast<int64_t>(*static_cast<size_t*>(block)));
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+namespace {
+
+int g_failures = 0;
+
+void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "  ASSERT FAILED: " << message << '\n';
+        ++g_failures;
+    }
+}
+
+class BitWriter {
+public:
+    void Put(uint32_t value, int bits) {
+        for (int i = bits - 1; i >= 0; --i) {
+            m_current = static_cast<uint8_t>((m_current << 1) | ((value >> i) & 1u));
+            if (++m_bitCount == 8) {
+                m_bytes.push_back(m_current);
+                m_current = 0;
+                m_bitCount = 0;
+            }
+        }
+    }
+
+    void PutCode(const char* bits) {
+        for (const char* bit = bits; *bit; ++bit) Put(*bit == '1' ? 1u : 0u, 1);
+    }
+
+    void StartCode(uint8_t code) {
+        Align();
+        Put(0x000001u, 24);
+        Put(code, 8);
+    }
+
+    void Align() {
+        while (m_bitCount != 0) Put(0, 1);
+    }
+
+    std::vector<uint8_t> Take() {
+        Align();
+        return std::move(m_bytes);
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint8_t m_current = 0;
+    int m_bitCount = 0;
+};
+
+constexpr int kFrameRateCode30 = 5;
+
+int LumaForFrame(int frameIndex) { return 16 + frameIndex; }
+
+// Intra-only MPEG-1 clip where every frame is a flat gray whose luma encodes the frame index.
+// Each macroblock carries only DC coefficients, which is all pl_mpeg needs to reproduce it.
+std::vector<std::vector<uint8_t>> EncodePictures(int width, int height, int frameCount) {
+    static const char* kLumaDcSize[] = { "100", "00", "01", "101", "110", "1110", "11110", "111110", "1111110" };
+    static const char* kChromaDcSize[] = { "00", "01", "10", "110", "1110", "11110", "111110", "1111110", "11111110" };
+    const auto putDc = [](BitWriter& writer, const char* const* sizeCodes, int diff) {
+        int size = 0;
+        for (int magnitude = diff < 0 ? -diff : diff; magnitude > 0; magnitude >>= 1) size++;
+        writer.PutCode(sizeCodes[size]);
+        if (size > 0) writer.Put(static_cast<uint32_t>(diff > 0 ? diff : diff + (1 << size) - 1), size);
+    };
+
+    const int mbWidth = (width + 15) / 16;
+    const int mbHeight = (height + 15) / 16;
+    std::vector<std::vector<uint8_t>> pictures;
+    for (int frame = 0; frame < frameCount; ++frame) {
+        BitWriter writer;
+        if (frame == 0) {
+            writer.StartCode(0xB3);
+            writer.Put(static_cast<uint32_t>(width), 12);
+            writer.Put(static_cast<uint32_t>(height), 12);
+            writer.Put(1, 4);
+            writer.Put(kFrameRateCode30, 4);
+            writer.Put(0x3FFFF, 18);
+            writer.Put(1, 1);
+            writer.Put(20, 10);
+            writer.Put(0, 3);
+
+            writer.StartCode(0xB8);
+            writer.Put(0, 1);  // drop frame
+            writer.Put(0, 11); // hours, minutes
+            writer.Put(1, 1);  // marker
+            writer.Put(0, 12); // seconds, pictures
+            writer.Put(1, 1);  // closed gop
+            writer.Put(0, 6);
+        }
+
+        writer.StartCode(0x00);
+        writer.Put(static_cast<uint32_t>(frame % 1024), 10);
+        writer.Put(1, 3); // intra
+        writer.Put(0xFFFF, 16);
+        writer.Put(0, 1); // extra_bit_picture
+
+        for (int row = 0; row < mbHeight; ++row) {
+            writer.StartCode(static_cast<uint8_t>(row + 1));
+            writer.Put(8, 5); // quantizer_scale
+            writer.Put(0, 1); // extra_bit_slice
+            for (int col = 0; col < mbWidth; ++col) {
+                writer.PutCode("1"); // address increment 1
+                writer.PutCode("1"); // intra, no quantizer change
+                for (int block = 0; block < 6; ++block) {
+                    const bool firstLuma = block == 0 && col == 0;
+                    if (block < 4) {
+                        putDc(writer, kLumaDcSize, firstLuma ? LumaForFrame(frame) - 128 : 0);
+                    } else {
+                        putDc(writer, kChromaDcSize, 0);
+                    }
+                    writer.PutCode("10"); // end of block
+                }
+            }
+        }
+        if (frame == frameCount - 1) writer.StartCode(0xB7);
+        pictures.push_back(writer.Take());
+    }
+    return pictures;
+}
+
+void PutTimestamp(BitWriter& writer, uint32_t prefix, uint64_t ticks) {
+    writer.Put(prefix, 4);
+    writer.Put(static_cast<uint32_t>((ticks >> 30) & 0x7), 3);
+    writer.Put(1, 1);
+    writer.Put(static_cast<uint32_t>((ticks >> 15) & 0x7FFF), 15);
+    writer.Put(1, 1);
+    writer.Put(static_cast<uint32_t>(ticks & 0x7FFF), 15);
+    writer.Put(1, 1);
+}
+
+// Wraps the pictures into a program stream: one pack and system header, then one PES packet
+// (carrying a PTS) per picture.
+std::vector<uint8_t> BuildProgramStream(int width, int height, int frameCount) {
+    BitWriter writer;
+    writer.StartCode(0xBA);
+    PutTimestamp(writer, 0x2, 0);
+    writer.Put(1, 1);
+    writer.Put(2000, 22);
+    writer.Put(1, 1);
+
+    writer.StartCode(0xBB);
+    writer.Put(9, 16);
+    writer.Put(1, 1);
+    writer.Put(2000, 22);
+    writer.Put(1, 1);
+    writer.Put(0, 6); // audio streams
+    writer.Put(0, 1);
+    writer.Put(0, 1);
+    writer.Put(0, 1);
+    writer.Put(0, 1);
+    writer.Put(1, 1);
+    writer.Put(1, 5); // video streams
+    writer.Put(0xFF, 8);
+    writer.Put(0xE0, 8);
+    writer.Put(0x3, 2);
+    writer.Put(1, 1);
+    writer.Put(46, 13);
+
+    const std::vector<std::vector<uint8_t>> pictures = EncodePictures(width, height, frameCount);
+    for (size_t i = 0; i < pictures.size(); ++i) {
+        const std::vector<uint8_t>& picture = pictures[i];
+        size_t offset = 0;
+        bool first = true;
+        while (offset < picture.size()) {
+            const size_t chunk = (std::min)(picture.size() - offset, static_cast<size_t>(2000));
+            writer.StartCode(0xE0);
+            writer.Put(static_cast<uint32_t>(chunk + (first ? 5 : 1)), 16);
+            if (first) {
+                PutTimestamp(writer, 0x2, static_cast<uint64_t>(i) * 3000u);
+            } else {
+                writer.Put(0x0F, 8);
+            }
+            for (size_t b = 0; b < chunk; ++b) writer.Put(picture[offset + b], 8);
+            offset += chunk;
+            first = false;
+        }
+    }
+
+    writer.StartCode(0xB9);
+    return writer.Take();
+}
+
+class TempClip {
+public:
+    TempClip(const std::string& name, int width, int height, int frameCount) {
+        m_path = (std::filesystem::temp_directory_path() / name).string();
+        const std::vector<uint8_t> bytes = BuildProgramStream(width, height, frameCount);
+        std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    ~TempClip() {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+    const std::string& Path() const { return m_path; }
+
+private:
+    std::string m_path;
+};
+
+constexpr int kClipWidth = 48;
+constexpr int kClipHeight = 32;
+constexpr int kClipFrames = 90;
+constexpr double kFrameDurationMs = 1000.0 / 30.0;
+
+// Waits for the decoder to catch up with the playhead; AcquireFrame never blocks.
+bool AcquireExactFrame(MpegVideoStream& stream, uint64_t sequence, MpegVideoStreamFrame& frame) {
+    const double playheadMs = (static_cast<double>(sequence) + 0.5) * kFrameDurationMs;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (stream.AcquireFrame(playheadMs, frame) && frame.sequence == sequence) return true;
+        if (stream.HasFailed()) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return false;
+}
+
+void GeneratedClipDecodesInOrder() {
+    TempClip clip("toolscreen_video_stream_order.mpg", kClipWidth, kClipHeight, kClipFrames);
+    CachedMpegVideoResult cached;
+    Check(DecodeCachedMpegVideoFile(clip.Path(), 64u * 1024u * 1024u, cached), "cached decode succeeds: " + cached.error);
+    Check(cached.frameCount == kClipFrames, "cached decode sees every frame, got " + std::to_string(cached.frameCount));
+    Check(cached.width == kClipWidth && cached.height == kClipHeight, "clip dimensions");
+
+    const size_t frameBytes = static_cast<size_t>(kClipWidth) * kClipHeight * 4u;
+    int previousRed = -1;
+    for (int i = 0; i < cached.frameCount; ++i) {
+        const int red = cached.rgbaFrames[static_cast<size_t>(i) * frameBytes];
+        if (red <= previousRed) {
+            Check(false, "frame " + std::to_string(i) + " is not brighter than the previous frame");
+            break;
+        }
+        previousRed = red;
+    }
+}
+
+void StreamMatchesCachedFramesAcrossLoops() {
+    TempClip clip("toolscreen_video_stream_loops.mpg", kClipWidth, kClipHeight, kClipFrames);
+    CachedMpegVideoResult cached;
+    Check(DecodeCachedMpegVideoFile(clip.Path(), 64u * 1024u * 1024u, cached), "cached decode succeeds");
+    if (cached.frameCount != kClipFrames) return;
+
+    MpegVideoStream stream;
+    MpegVideoStreamOptions options;
+    options.ringFrames = 4;
+    std::string error;
+    Check(stream.Open(clip.Path(), options, &error), "stream opens: " + error);
+    Check(stream.GetFrameRate() == 30.0, "frame rate comes from the sequence header");
+
+    const size_t frameBytes = stream.GetFrameBytes();
+    for (uint64_t sequence = 0; sequence < 3u * kClipFrames; ++sequence) {
+        MpegVideoStreamFrame frame;
+        if (!AcquireExactFrame(stream, sequence, frame)) {
+            Check(false, "frame " + std::to_string(sequence) + " was never delivered");
+            return;
+        }
+        const int expectedClipFrame = static_cast<int>(sequence % kClipFrames);
+        const int expectedLoop = static_cast<int>(sequence / kClipFrames);
+        if (frame.clipFrameIndex != expectedClipFrame || frame.loopIndex != expectedLoop ||
+            std::memcmp(frame.rgba, cached.rgbaFrames.data() + static_cast<size_t>(expectedClipFrame) * frameBytes, frameBytes) != 0) {
+            Check(false, "frame " + std::to_string(sequence) + " does not match cached frame " + std::to_string(expectedClipFrame) +
+                             " (got clip frame " + std::to_string(frame.clipFrameIndex) + ", loop " + std::to_string(frame.loopIndex) + ")");
+            return;
+        }
+    }
+    Check(stream.GetClipFrameCount() == kClipFrames, "clip length is known after the first loop");
+}
+
+void LoopTimingFollowsFrameRate() {
+    TempClip clip("toolscreen_video_stream_timing.mpg", kClipWidth, kClipHeight, kClipFrames);
+    MpegVideoStream stream;
+    MpegVideoStreamOptions options;
+    options.ringFrames = 6;
+    Check(stream.Open(clip.Path(), options), "stream opens");
+
+    MpegVideoStreamFrame frame;
+    Check(AcquireExactFrame(stream, 0, frame), "first frame");
+    Check(stream.AcquireFrame(-50.0, frame) && frame.sequence == 0, "negative playhead holds the first frame");
+
+    // Jumping ahead skips intermediate frames instead of replaying them.
+    Check(AcquireExactFrame(stream, 45, frame) && frame.clipFrameIndex == 45, "jump to the middle of the clip");
+
+    const double loopMs = kClipFrames * kFrameDurationMs;
+    const auto frameAt = [&](double playheadMs, MpegVideoStreamFrame& out) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        const uint64_t expected = static_cast<uint64_t>(playheadMs / kFrameDurationMs);
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (stream.AcquireFrame(playheadMs, out) && out.sequence == expected) return true;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return false;
+    };
+    Check(frameAt(loopMs - 1.0, frame) && frame.clipFrameIndex == kClipFrames - 1 && frame.loopIndex == 0, "last frame just before the loop point");
+    Check(frameAt(loopMs + 1.0, frame) && frame.clipFrameIndex == 0 && frame.loopIndex == 1, "first frame just after the loop point");
+    Check(frameAt(2.0 * loopMs + 10.0 * kFrameDurationMs + 1.0, frame) && frame.clipFrameIndex == 10 && frame.loopIndex == 2,
+          "second loop keeps the same cadence");
+
+    const uint64_t held = frame.sequence;
+    Check(stream.AcquireFrame(0.0, frame) && frame.sequence == held, "playhead moving backwards keeps the current frame");
+}
+
+void PeakMemoryIsBoundedByRing() {
+    constexpr int kLongClipFrames = 220;
+    TempClip clip("toolscreen_video_stream_memory.mpg", 160, 128, kLongClipFrames);
+    const size_t frameBytes = 160u * 128u * 4u;
+    const size_t clipBytes = frameBytes * kLongClipFrames;
+
+    int64_t baseline = g_liveBytes.load();
+    g_peakBytes.store(baseline);
+    {
+        CachedMpegVideoResult cached;
+        Check(DecodeCachedMpegVideoFile(clip.Path(), 256u * 1024u * 1024u, cached), "cached decode of the long clip");
+    }
+    const int64_t cachedPeak = g_peakBytes.load() - baseline;
+    Check(cachedPeak >= static_cast<int64_t>(clipBytes), "full decode holds the whole clip (" + std::to_string(cachedPeak) + " bytes)");
+
+    baseline = g_liveBytes.load();
+    g_peakBytes.store(baseline);
+    {
+        MpegVideoStream stream;
+        MpegVideoStreamOptions options;
+        options.ringFrames = 4;
+        Check(stream.Open(clip.Path(), options), "stream opens");
+        MpegVideoStreamFrame frame;
+        for (uint64_t sequence = 0; sequence < 2u * kLongClipFrames; sequence += 7) {
+            if (!AcquireExactFrame(stream, sequence, frame)) {
+                Check(false, "frame " + std::to_string(sequence) + " was never delivered");
+                break;
+            }
+        }
+        Check(stream.GetRingBytes() == 4 * frameBytes, "ring size");
+    }
+    const int64_t streamPeak = g_peakBytes.load() - baseline;
+    const int64_t bound = static_cast<int64_t>(5 * frameBytes + 64 * 1024);
+    Check(streamPeak <= bound, "streaming peak " + std::to_string(streamPeak) + " bytes stays under " + std::to_string(bound));
+}
+
+void OpenRejectsMissingFiles() {
+    MpegVideoStream stream;
+    std::string error;
+    Check(!stream.Open((std::filesystem::temp_directory_path() / "toolscreen_missing_clip.mpg").string(), {}, &error), "missing file");
+    Check(!error.empty(), "missing file reports an error");
+    MpegVideoStreamFrame frame;
+    Check(!stream.AcquireFrame(0.0, frame), "closed stream has no frames");
+}
+
+struct TestCase {
+    const char* name;
+    std::function<void()> run;
+};
+
+const std::vector<TestCase>& Registry() {
+    static const std::vector<TestCase> cases = {
+        {"generated_clip_decodes_in_order", &GeneratedClipDecodesInOrder},
+        {"stream_matches_cached_frames_across_loops", &StreamMatchesCachedFramesAcrossLoops},
+        {"loop_timing_follows_frame_rate", &LoopTimingFollowsFrameRate},
+        {"peak_memory_is_bounded_by_ring", &PeakMemoryIsBoundedByRing},
+        {"open_rejects_missing_files", &OpenRejectsMissingFiles},
+    };
+    return cases;
+}
+
+int RunNamed(const std::string& name) {
+    for (const auto& testCase : Registry()) {
+        if (name == testCase.name) {
+            g_failures = 0;
+            std::cout << "RUN " << name << '\n';
+            testCase.run();
+            if (g_failures == 0) {
+                std::cout << "PASS " << name << '\n';
+                return 0;
+            }
+            std::cerr << "FAIL " << name << " (" << g_failures << " assertion(s))\n";
+            return 1;
+        }
+    }
+    std::cerr << "Unknown test case: " << name << '\n';
+    return 2;
+}
+
+int RunAll() {
+    int failed = 0;
+    for (const auto& testCase : Registry()) {
+        if (RunNamed(testCase.name) != 0) ++failed;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1 || (argc == 2 && std::strcmp(argv[1], "--run-all") == 0)) {
+        return RunAll();
+    }
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& testCase : Registry()) std::cout << testCase.name << '\n';
+        return 0;
+    }
+    if (argc == 3 && std::strcmp(argv[1], "--run") == 0) {
+        return RunNamed(argv[2]);
+    }
+    std::cerr << "Usage: " << argv[0] << " [--run <case> | --run-all | --list]\n";
+    return 2;
+}